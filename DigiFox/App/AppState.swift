@@ -18,9 +18,11 @@ enum DigitalMode: Int, CaseIterable, Identifiable {
 @MainActor
 class AppState: ObservableObject {
     // MARK: - Shared State
-    @Published var rxMessages = [RxMessage]()
-    @Published var stations = [Station]()
-    @Published var waterfallData = [[Float]]()
+    /// Newest first, up to `listLimit` each, kept from `decodes` changes
+    @Published private(set) var ft8Messages = [RxMessage]()
+    @Published private(set) var js8Messages = [RxMessage]()
+    /// Senders heard, most recent first, while `decodes` holds a message of theirs
+    @Published private(set) var stations = [Station]()
     @Published var isReceiving = false
     @Published var isTransmitting = false
     @Published var statusText = "Ready"
@@ -49,19 +51,38 @@ class AppState: ObservableObject {
     @Published var cwLog = [String]()
     @Published var cwDecodedText = ""
     @Published var cwDecoding = false
+    /// RX audio is being written to an archive
+    @Published var isRecording = false
+
+    // MARK: - Decode Effort
+    /// Effort the decoders and the waterfall run at now
+    @Published private(set) var decodeEffort: DecodeEffort = .full
+    /// Why it is below the one chosen in Settings (nil = it is not)
+    @Published private(set) var effortNote: String?
 
     let settings = AppSettings()
     let audioEngine = AudioEngine()
+    /// Recent waterfall lines, written from the audio thread
+    let waterfall = WaterfallHistory()
     let catController = CATController()
     let morseKeyer = MorseKeyer()
     private var cwDecoder: GGMorseDecoder
     let trusdxAudio = TruSDXSerialAudio()
     private var trusdxPort: SerialPort?
+    /// (tr)uSDX RX audio at its own rate, for the CW decoder
+    private let trusdxRXRing = SampleRing(history: Int(TruSDXSerialAudio.rxSampleRate) * 30)
+    private var trusdxRXNext: UInt64 = 0
 
+    private let catFSK = CATFSKTransmitter()
     private let ft8Modulator = FT8Modulator()
     private let ft8Demodulator = FT8Demodulator()
     private let js8Modulator = JS8Modulator()
     private let js8Demodulator = JS8Demodulator()
+    private let effortGovernor = EffortGovernor()
+    /// Every FT8/JS8 decode of the session, bounded
+    let decodes = DecodeStore()
+    /// Rows in each message list
+    static let listLimit = 200
     private var cancellables = Set<AnyCancellable>()
     private var demodTask: Task<Void, Never>?
     private var usbScanTask: Task<Void, Never>?
@@ -69,12 +90,19 @@ class AppState: ObservableObject {
     private var rigPollTask: Task<Void, Never>?
 
     init() {
+        Tracing.install()
         // Pre-fill DX call/grid from settings
         dxCall = settings.callsign
         dxGrid = settings.grid
         // Initial CW decoder (ggmorse) at default rate
         cwDecoder = GGMorseDecoder(sampleRate: 12000)
         setupBindings()
+        // Just the saved rig's Hamlib backend, off the main thread; the
+        // whole model list is only read when the picker needs it
+        if settings.useHamlib && settings.radioProfile != .trusdx {
+            let model = settings.rigModel
+            Task.detached(priority: .utility) { HamlibRig.loadBackend(for: model) }
+        }
         #if targetEnvironment(simulator)
         ioKitAvailable = true
         #else
@@ -87,14 +115,33 @@ class AppState: ObservableObject {
 
     private func setupBindings() {
         audioEngine.$isTransmitting.assign(to: &$isTransmitting)
-        audioEngine.$spectrumData
-            .filter { !$0.isEmpty }
-            .receive(on: DispatchQueue.main)
-            .sink { [weak self] s in self?.addWaterfallRow(s) }
-            .store(in: &cancellables)
+        audioEngine.onSpectrumUpdate = { [waterfall] line in
+            waterfall.push(line, gainDb: SpectrumEngine.lineGainDb)
+        }
         $dxCall.sink { [weak self] _ in self?.updateTxMessages() }.store(in: &cancellables)
         $dxGrid.sink { [weak self] _ in self?.updateTxMessages() }.store(in: &cancellables)
         $dxReport.sink { [weak self] _ in self?.updateTxMessages() }.store(in: &cancellables)
+
+        decodes.onChange = { [weak self] change in self?.applyDecodes(change) }
+        effortGovernor.onChange = { [weak self] effort, note in self?.applyEffort(effort, note: note) }
+        effortGovernor.adaptive = settings.adaptiveEffort
+        effortGovernor.chosen = settings.decodeEffort
+        applyEffort(effortGovernor.effective, note: effortGovernor.reason)
+        // objectWillChange fires before the new value is stored
+        settings.objectWillChange.receive(on: RunLoop.main).sink { [weak self] _ in
+            guard let self else { return }
+            self.effortGovernor.adaptive = self.settings.adaptiveEffort
+            self.effortGovernor.chosen = self.settings.decodeEffort
+        }.store(in: &cancellables)
+    }
+
+    /// Run the decoders and the waterfall at `effort`. FT8 takes it at its
+    /// next decode without losing the slot's audio.
+    private func applyEffort(_ effort: DecodeEffort, note: String?) {
+        decodeEffort = effort
+        effortNote = note
+        ft8Demodulator.effort = effort.ft8
+        cwDecoder.searchStep = effort.cwSearchStep
     }
 
     // MARK: - FT8 TX Messages (WSJT-X style)
@@ -176,12 +223,17 @@ class AppState: ObservableObject {
                         try await port.write(freqCmd)
                     }
 
-                    // Wire RX audio to decoders (BEFORE starting stream to avoid race)
+                    // Wire RX audio to decoders (BEFORE starting stream to avoid race):
+                    // one polyphase pass to 12 kHz for FT8/JS8 and the waterfall, and
+                    // the audio as received for ggmorse, which takes it to 4 kHz itself.
+                    // Runs on the port's I/O queue, the rings' one producer
                     let upsampledRate = 12000.0
-                    trusdxAudio.onAudioReceived = { [weak self] samples in
-                        guard let self else { return }
-                        let upsampled = TruSDXSerialAudio.upsample(samples, to: upsampledRate)
-                        self.audioEngine.feedExternalSamples(upsampled, sampleRate: upsampledRate)
+                    let upsampler = StreamingResampler(from: TruSDXSerialAudio.rxSampleRate, to: upsampledRate)
+                    trusdxAudio.onAudioReceived = { [ring = trusdxRXRing, engine = audioEngine] received in
+                        if let base = received.baseAddress { ring?.write(base, count: received.count) }
+                        upsampler?.withProcessed(received) {
+                            engine.feedExternalSamples($0, sampleRate: upsampledRate)
+                        }
                     }
 
                     // Start audio streaming
@@ -213,6 +265,7 @@ class AppState: ObservableObject {
     func disconnectRig() {
         rigPollTask?.cancel(); rigPollTask = nil
         if isTruSDX {
+            catFSK.cancel()
             trusdxAudio.stopStreaming()
             trusdxAudio.detach()
             Task { await trusdxPort?.close() }
@@ -272,33 +325,45 @@ class AppState: ObservableObject {
         }
     }
 
-    /// Periodically poll rig for frequency and mode changes (every 500ms).
-    /// Syncs rig state back to the UI so dial display stays current.
+    /// Start the rig poller and sync its snapshot back to the UI so the
+    /// dial display stays current. The CAT reads run on the controller;
+    /// this side only loads the snapshot, so no serial latency reaches
+    /// the main thread.
     private func startRigPolling() {
         rigPollTask?.cancel()
+        let interval = max(settings.rigPollInterval, 0.1)
+        let snapshot = catController.snapshot
         rigPollTask = Task { [weak self] in
+            await self?.catController.startPolling(interval: interval)
+            var seen: UInt32 = 0
             while !Task.isCancelled {
-                try? await Task.sleep(nanoseconds: 500_000_000) // 500ms
-                guard let self, await self.catController.isConnected else { break }
-                do {
-                    let freq = try await self.catController.getFrequency()
-                    let mode = try await self.catController.getMode()
-                    await MainActor.run {
-                        self.settings.dialFrequency = Double(freq)
-                        self.radioState.frequency = freq
-                        self.radioState.mode = mode
-                        // Update selected band to match rig frequency
-                        if let band = BandPlan.band(for: Double(freq)) {
-                            self.settings.selectedBand = band.id
-                        }
-                    }
-                } catch {
+                try? await Task.sleep(nanoseconds: UInt64(interval * 1e9))
+                guard let self else { break }
+                guard let reading = snapshot.read(), reading.generation != seen else { continue }
+                seen = reading.generation
+                guard let freq = reading.frequency else {
                     // Polling failed — rig may have been disconnected
-                    await MainActor.run { self.radioState.isConnected = false; self.statusText = "Rig connection lost" }
+                    self.radioState.isConnected = false
+                    self.statusText = "Rig connection lost"
                     break
                 }
+                self.applyRigReading(reading, frequency: freq)
+            }
+        }
+    }
+
+    private func applyRigReading(_ reading: RigReading, frequency freq: UInt64) {
+        if radioState.frequency != freq {
+            settings.dialFrequency = Double(freq)
+            radioState.frequency = freq
+            // Update selected band to match rig frequency
+            if let band = BandPlan.band(for: Double(freq)) {
+                settings.selectedBand = band.id
             }
         }
+        if let mode = reading.mode, radioState.mode != mode { radioState.mode = mode }
+        if let ptt = reading.isTransmitting, radioState.isTransmitting != ptt { radioState.isTransmitting = ptt }
+        if radioState.strength != reading.strength { radioState.strength = reading.strength }
     }
 
     func setRigFrequency(_ hz: UInt64) {
@@ -319,6 +384,40 @@ class AppState: ObservableObject {
         }
     }
 
+    // MARK: - Recording
+
+    /// Record the RX audio at its current rate, with the dial frequency,
+    /// to a new file in Documents/Recordings.
+    func startRecording() {
+        guard audioEngine.recorder == nil else { return }
+        do {
+            let url = try AudioRecorder.newRecordingURL()
+            let source = isTruSDX ? "trusdx" : "digirig"
+            guard let recorder = AudioRecorder(url: url, sampleRate: audioEngine.effectiveSampleRate,
+                                               source: source, dial: {
+                UInt64(UserDefaults.standard.double(forKey: "dialFrequency"))
+            }) else {
+                statusText = "Cannot record to \(url.lastPathComponent)"
+                return
+            }
+            audioEngine.recorder = recorder
+            isRecording = true
+            statusText = "Recording \(url.lastPathComponent)"
+        } catch {
+            statusText = "Recording error: \(error.localizedDescription)"
+        }
+    }
+
+    func stopRecording() {
+        guard let recorder = audioEngine.recorder else { return }
+        audioEngine.recorder = nil
+        let ok = recorder.stop()
+        isRecording = false
+        statusText = ok
+            ? String(format: "Recorded %.0f s to %@", recorder.duration, recorder.url.lastPathComponent)
+            : "Recording incomplete: write failed"
+    }
+
     // MARK: - USB Monitoring
 
     func scanUSBDevices() {
@@ -378,15 +477,25 @@ class AppState: ObservableObject {
     // MARK: - FT8 Cycle
 
     private func startFT8Cycle() {
+        ft8Demodulator.start(ring: audioEngine.sampleRing, spectrum: audioEngine.spectrum)
+        // Builds the slot's waterfall as the audio arrives, off the audio thread
+        demodTask = Task.detached { [demodulator = ft8Demodulator] in
+            while !Task.isCancelled {
+                try? await Task.sleep(nanoseconds: 1_000_000_000)
+                demodulator.pump()
+            }
+        }
         cycleTask = Task { [weak self] in
             while !Task.isCancelled {
-                let now = Date()
-                let second = Calendar.current.component(.second, from: now)
-                let nano = Calendar.current.component(.nanosecond, from: now)
-                let currentPos = Double(second % 15) + Double(nano) / 1_000_000_000
-                let waitTime = 15.0 - currentPos + 0.5
+                let earlyTime = FT8Demodulator.earlyDecodeTime
+                if Self.ft8SlotPosition() < earlyTime {
+                    let earlyWait = earlyTime - Self.ft8SlotPosition()
+                    try? await Task.sleep(nanoseconds: UInt64(earlyWait * 1_000_000_000))
+                    await self?.runFT8Demodulation(early: true)
+                }
+                let waitTime = 15.0 - Self.ft8SlotPosition() + 0.5
                 try? await Task.sleep(nanoseconds: UInt64(waitTime * 1_000_000_000))
-                await self?.runFT8Demodulation()
+                await self?.runFT8Demodulation(early: false)
                 let secAfter = Calendar.current.component(.second, from: Date())
                 let isEvenSlot = (secAfter / 15) % 2 == 0
                 if self?.txEnabled == true && isEvenSlot == self?.txEven { await self?.transmitFT8() }
@@ -394,32 +503,45 @@ class AppState: ObservableObject {
         }
     }
 
-    private func runFT8Demodulation() {
-        let samples = audioEngine.getBufferedSamples()
-        guard samples.count > FT8Protocol.symbolSamples * FT8Protocol.symbolCount else { return }
+    /// Seconds since the start of the current 15 s slot.
+    private static func ft8SlotPosition() -> Double {
+        let now = Date()
+        let second = Calendar.current.component(.second, from: now)
+        let nano = Calendar.current.component(.nanosecond, from: now)
+        return Double(second % 15) + Double(nano) / 1_000_000_000
+    }
+
+    /// Early: frames nearly complete at `FT8Demodulator.earlyDecodeTime`.
+    /// Otherwise the rest of the slot that just ended.
+    private func runFT8Demodulation(early: Bool) {
         Task.detached { [weak self, demodulator = self.ft8Demodulator] in
-            let results = demodulator.demodulate(samples)
+            let start = DispatchTime.now().uptimeNanoseconds
+            let results = Tracing.interval("ft8.decodeSlot") {
+                early ? demodulator.decodeEarly() : demodulator.decodeSlot()
+            }
+            let seconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
             await MainActor.run {
-                for r in results {
-                    let msg = RxMessage(
-                        timestamp: Date(), frequency: r.frequency, snr: Int(r.snr),
+                if !early { self?.effortGovernor.slotDecoded(seconds: seconds) }
+                let ui = Tracing.signposter.beginInterval("ui.ft8Results", id: Tracing.signposter.makeSignpostID())
+                defer { Tracing.signposter.endInterval("ui.ft8Results", ui) }
+                guard let self else { return }
+                let now = Date()
+                let myCall = self.settings.callsign.uppercased()
+                self.decodes.append(results.map { r in
+                    RxMessage(
+                        timestamp: now, frequency: r.frequency, snr: Int(r.snr),
                         deltaTime: r.timeOffset, text: r.message.displayText,
                         mode: .ft8, ft8Message: r.message,
                         isCQ: r.message.type == .cq,
-                        isMyCall: r.message.to?.uppercased() == self?.settings.callsign.uppercased()
+                        isMyCall: r.message.to?.uppercased() == myCall
                     )
-                    self?.rxMessages.insert(msg, at: 0)
-                    if (self?.rxMessages.count ?? 0) > 200 { self?.rxMessages.removeLast() }
-                    if let call = r.message.from {
-                        self?.updateStation(callsign: call, grid: r.message.grid ?? "", frequency: r.frequency, snr: Int(r.snr))
-                    }
-                    if r.message.to?.uppercased() == self?.settings.callsign.uppercased() {
-                        self?.handleIncomingFT8QSO(r.message)
-                    }
+                })
+                for r in results where r.message.to?.uppercased() == myCall {
+                    self.handleIncomingFT8QSO(r.message)
                 }
             }
         }
-        audioEngine.clearBuffer()
+        if !early { audioEngine.clearBuffer() }
     }
 
     private func handleIncomingFT8QSO(_ msg: FT8Message) {
@@ -444,7 +566,21 @@ class AppState: ObservableObject {
         statusText = "Sending: \(msgText)"
         let ft8Msg = FT8MessagePack.parseText(msgText, myCall: settings.callsign, myGrid: settings.grid)
         ft8Modulator.baseFrequency = txFrequency
-        let samples = ft8Modulator.modulate(ft8Msg)
+
+        if isTruSDX, settings.trusdxCATFSK, let port = trusdxPort {
+            isTransmitting = true
+            let tones = ft8Modulator.tones(for: ft8Msg)
+            Task {
+                await transmitTruSDXFSK(tones: tones, audioFrequency: txFrequency,
+                                        spacing: FT8Protocol.toneSpacing,
+                                        symbolDuration: FT8Protocol.symbolDuration, port: port, tag: "FT8-TX")
+                isTransmitting = false
+                statusText = "Sent"
+                advanceFT8Sequence()
+            }
+            return
+        }
+        guard let source = ft8Modulator.source(for: ft8Msg) else { return }
 
         if isTruSDX, let port = trusdxPort {
             // TruSDX: send audio over serial (CAT streaming)
@@ -455,8 +591,8 @@ class AppState: ObservableObject {
                     try await port.write("MD2;")
                     print("[FT8-TX] TruSDX: keying TX (TX0;)")
                     try await port.write("TX0;")
-                    print("[FT8-TX] TruSDX: sending \(samples.count) audio samples")
-                    await trusdxAudio.sendAudio(samples, fromSampleRate: 12000)
+                    print("[FT8-TX] TruSDX: streaming \(source.remaining) audio samples")
+                    await trusdxAudio.sendAudio(source: source)
                     print("[FT8-TX] TruSDX: audio sent, going back to RX")
                     try await port.write("RX;")
                     print("[FT8-TX] TruSDX: TX complete")
@@ -471,7 +607,7 @@ class AppState: ObservableObject {
             }
         } else {
             if settings.useHamlib { Task { try? await catController.setMode("USB"); try? await catController.pttOn() } }
-            audioEngine.transmit(samples: samples) { [weak self] in
+            audioEngine.transmit(source: source) { [weak self] in
                 Task { @MainActor in
                     self?.statusText = "Sent"
                     if self?.settings.useHamlib == true { try? await self?.catController.pttOff() }
@@ -481,37 +617,59 @@ class AppState: ObservableObject {
         }
     }
 
+    /// (tr)uSDX TX as carrier FSK: CW tune at the first tone, one timed FA
+    /// per symbol from `catFSK`, then back to the dial frequency in USB RX.
+    /// The tones sit where the audio would put them, dial + audio offset.
+    private func transmitTruSDXFSK(tones: [Int], audioFrequency: Double, spacing: Double,
+                                   symbolDuration: Double, port: SerialPort, tag: String) async {
+        let dial = settings.dialFrequency
+        let carrier = dial + audioFrequency
+        trusdxAudio.stopStreaming()
+        do {
+            print("[\(tag)] TruSDX: CW tune, \(tones.count) symbols by FA from \(Int(carrier)) Hz")
+            try await port.write("MD3;")
+            try await port.write(String(format: "FA%011d;", Int((carrier + Double(tones.first ?? 0) * spacing).rounded())))
+            try await port.write("TX2;")
+            _ = await catFSK.transmit(tones: tones, carrier: carrier, spacing: spacing,
+                                      symbolDuration: symbolDuration, fd: port.rawFD)
+            try await port.write("RX;")
+            print("[\(tag)] TruSDX: TX complete")
+        } catch {
+            print("[\(tag)] TruSDX: ERROR: \(error)")
+            try? await port.write("RX;")
+        }
+        try? await port.write(String(format: "FA%011d;", Int(dial)))
+        try? await port.write("MD2;")
+        trusdxAudio.startStreaming()
+    }
+
     // MARK: - JS8 Cycle
 
+    /// Every JS8 speed is decoded from the same audio; each is due at the
+    /// end of its own cycle, so the loop only polls for due ones.
     private func startJS8DemodLoop() {
-        demodTask = Task { [weak self] in
+        js8Demodulator.start(ring: audioEngine.sampleRing)
+        // Takes the audio and decodes off the audio thread and the main actor
+        demodTask = Task.detached { [weak self, demodulator = js8Demodulator] in
             while !Task.isCancelled {
-                try? await Task.sleep(nanoseconds: UInt64((self?.settings.speed.txWindow ?? 15) * 1_000_000_000))
-                await self?.runJS8Demodulation()
+                try? await Task.sleep(nanoseconds: 250_000_000)
+                guard demodulator.pump() else { continue }
+                let results = demodulator.decodeDue()
+                await self?.showJS8Decodes(results)
             }
         }
     }
 
-    private func runJS8Demodulation() {
-        let samples = audioEngine.getBufferedSamples()
-        let speed = settings.speed
-        guard samples.count > speed.symbolSamples * JS8Protocol.symbolCount else { return }
-        Task.detached { [weak self, demodulator = self.js8Demodulator] in
-            let results = demodulator.demodulate(samples: samples, speed: speed)
-            await MainActor.run {
-                for r in results {
-                    let p = PackMessage.parseDirected(r.message)
-                    let msg = RxMessage(
-                        timestamp: Date(), frequency: r.frequency, snr: Int(r.snr),
-                        deltaTime: r.deltaTime, text: r.message,
-                        mode: .js8, js8Speed: speed, from: p.from, to: p.to
-                    )
-                    self?.rxMessages.insert(msg, at: 0)
-                    if (self?.rxMessages.count ?? 0) > 200 { self?.rxMessages.removeLast() }
-                    if let call = p.from { self?.updateStation(callsign: call, frequency: r.frequency, snr: Int(r.snr)) }
-                }
-            }
-        }
+    private func showJS8Decodes(_ results: [DemodResult]) {
+        let now = Date()
+        decodes.append(results.map { r in
+            let p = PackMessage.parseDirected(r.message)
+            return RxMessage(
+                timestamp: now, frequency: r.frequency, snr: Int(r.snr),
+                deltaTime: r.deltaTime, text: r.message,
+                mode: .js8, js8Speed: r.speed, from: p.from, to: p.to
+            )
+        })
         audioEngine.clearBuffer()
     }
 
@@ -521,7 +679,21 @@ class AppState: ObservableObject {
         }
         statusText = "Sending..."
         let msg = "\(settings.callsign): \(txMessage.text)"
-        let samples = js8Modulator.modulate(message: msg, frequency: txMessage.frequency, speed: settings.speed)
+
+        if isTruSDX, settings.trusdxCATFSK, let port = trusdxPort {
+            isTransmitting = true
+            let speed = settings.speed
+            let tones = js8Modulator.tones(for: msg)
+            Task {
+                await transmitTruSDXFSK(tones: tones, audioFrequency: txMessage.frequency,
+                                        spacing: JS8Protocol.toneSpacing(for: speed),
+                                        symbolDuration: JS8Protocol.symbolDuration(for: speed), port: port, tag: "JS8-TX")
+                isTransmitting = false
+                statusText = "Sent"
+            }
+            return
+        }
+        guard let source = js8Modulator.source(message: msg, frequency: txMessage.frequency, speed: settings.speed) else { return }
 
         if isTruSDX, let port = trusdxPort {
             // TruSDX: send audio over serial (CAT streaming)
@@ -532,8 +704,8 @@ class AppState: ObservableObject {
                     try await port.write("MD2;")
                     print("[JS8-TX] TruSDX: keying TX (TX0;)")
                     try await port.write("TX0;")
-                    print("[JS8-TX] TruSDX: sending \(samples.count) audio samples")
-                    await trusdxAudio.sendAudio(samples, fromSampleRate: 12000)
+                    print("[JS8-TX] TruSDX: streaming \(source.remaining) audio samples")
+                    await trusdxAudio.sendAudio(source: source)
                     print("[JS8-TX] TruSDX: audio sent, going back to RX")
                     try await port.write("RX;")
                     print("[JS8-TX] TruSDX: TX complete")
@@ -547,7 +719,7 @@ class AppState: ObservableObject {
             }
         } else {
             if settings.useHamlib { Task { try? await catController.pttOn() } }
-            audioEngine.transmit(samples: samples) { [weak self] in
+            audioEngine.transmit(source: source) { [weak self] in
                 Task { @MainActor in
                     self?.statusText = "Sent"
                     if self?.settings.useHamlib == true { try? await self?.catController.pttOff() }
@@ -559,6 +731,27 @@ class AppState: ObservableObject {
     // MARK: - CW / Morse
 
     @Published var cwKeying = false
+    /// AFSK CW message being played, for stop
+    private var cwToneSource: CWToneSource?
+
+    /// Rate the CW decoder is fed at: (tr)uSDX audio goes to ggmorse as
+    /// received, so it is resampled to ggmorse's 4 kHz in one pass rather
+    /// than after the 12 kHz upsampling as well
+    private var cwInputRate: Int {
+        isTruSDX ? Int(TruSDXSerialAudio.rxSampleRate) : Int(audioEngine.effectiveSampleRate)
+    }
+
+    /// Run `body` on the CW input that arrived since the last call, in place
+    private func withNewCWInput(_ body: (UnsafeBufferPointer<Float>) -> String) -> String {
+        if isTruSDX, let ring = trusdxRXRing {
+            let (text, end) = ring.withWindow(from: trusdxRXNext, body)
+            trusdxRXNext = end
+            return text
+        }
+        // Consuming the engine's buffer keeps samples that arrive meanwhile
+        // for the next round
+        return audioEngine.withBufferedSamples(consume: true, body)
+    }
 
     /// Update GGMorse decoder sample rate if needed
     private func ensureCWDecoderRate(_ sampleRate: Int) {
@@ -570,9 +763,11 @@ class AppState: ObservableObject {
     /// Start continuous CW decoding from audio input (using ggmorse)
     private func startCWDecodeLoop() {
         cwDecoding = true
-        let rate = Int(audioEngine.effectiveSampleRate)
+        let rate = cwInputRate
         ensureCWDecoderRate(rate)
+        cwDecoder.pitchSource = audioEngine.spectrum
         cwDecoder.reset()
+        if let ring = trusdxRXRing { trusdxRXNext = ring.written }
         print("[GGMorse] *** startCWDecodeLoop STARTED *** sampleRate=\(rate)")
         demodTask = Task { [weak self] in
             var loopCount = 0
@@ -580,26 +775,27 @@ class AppState: ObservableObject {
                 try? await Task.sleep(nanoseconds: 100_000_000) // 100ms chunks
                 guard let self else { print("[GGMorse] self is nil, exiting"); break }
                 // Adapt to sample rate changes
-                let currentRate = Int(self.audioEngine.effectiveSampleRate)
-                self.ensureCWDecoderRate(currentRate)
-                let samples = self.audioEngine.getBufferedSamples()
+                self.ensureCWDecoderRate(self.cwInputRate)
                 loopCount += 1
-                if loopCount <= 20 || loopCount % 10 == 0 {
-                    let rms = samples.isEmpty ? 0 : sqrt(samples.reduce(0) { $0 + $1 * $1 } / Float(samples.count))
-                    print("[GGMorse] #\(loopCount): \(samples.count) samples, rms=\(String(format: "%.4f", rms)), pitch=\(self.cwDecoder.pitch)Hz, wpm=\(self.cwDecoder.wpm)")
+                let verbose = loopCount <= 20 || loopCount % 10 == 0
+                let decoded = self.withNewCWInput { samples -> String in
+                    if verbose {
+                        let rms = samples.isEmpty ? 0 : sqrt(samples.reduce(0) { $0 + $1 * $1 } / Float(samples.count))
+                        print("[GGMorse] #\(loopCount): \(samples.count) samples, rms=\(String(format: "%.4f", rms)), pitch=\(self.cwDecoder.pitch)Hz, wpm=\(self.cwDecoder.wpm)")
+                    }
+                    return self.cwDecoder.process(samples: samples)
                 }
-                guard !samples.isEmpty else { continue }
-                let decoded = self.cwDecoder.process(samples: samples)
                 if !decoded.isEmpty {
                     print("[GGMorse] *** DECODED: '\(decoded)' *** pitch=\(self.cwDecoder.pitch)Hz wpm=\(self.cwDecoder.wpm)")
                     await MainActor.run {
+                        let ui = Tracing.signposter.beginInterval("ui.cwText", id: Tracing.signposter.makeSignpostID())
+                        defer { Tracing.signposter.endInterval("ui.cwText", ui) }
                         self.cwDecodedText += decoded
                         if self.cwDecodedText.count > 2000 {
                             self.cwDecodedText = String(self.cwDecodedText.suffix(1500))
                         }
                     }
                 }
-                self.audioEngine.clearBuffer()
             }
             print("[GGMorse] loop exited after \(loopCount) iterations")
         }
@@ -628,6 +824,11 @@ class AppState: ObservableObject {
         cwText = ""
         cwKeying = true
 
+        if settings.cwAudioKeying {
+            sendCWAudio(text: text, wpm: speed)
+            return
+        }
+
         if isTruSDX, let port = trusdxPort {
             // TruSDX: direct POSIX writes for zero-latency CW keying
             let fd = port.rawFD
@@ -681,7 +882,53 @@ class AppState: ObservableObject {
         }
     }
 
+    /// AFSK CW: the key timeline is rendered to a tone and played like a
+    /// digital-mode frame, with PTT (or TX0;) held for the message.
+    private func sendCWAudio(text: String, wpm: Int) {
+        guard let source = CWToneSource(text: text, wpm: wpm, pitch: settings.cwTonePitch) else {
+            cwKeying = false; return
+        }
+        cwToneSource = source
+        let finish: @MainActor () -> Void = { [weak self] in
+            guard let self else { return }
+            if self.cwToneSource === source { self.cwToneSource = nil }
+            self.cwKeying = false
+            self.statusText = "CW gesendet"
+        }
+        print("[CW-TX] audio keying \(text) @ \(wpm) WPM, \(String(format: "%.1f", source.duration)) s")
+
+        if isTruSDX, let port = trusdxPort {
+            Task {
+                do {
+                    try await port.write("MD2;")
+                    try await port.write("TX0;")
+                    await trusdxAudio.sendAudio(source: source)
+                    try await port.write("RX;")
+                } catch {
+                    print("[CW-TX] TruSDX: ERROR: \(error)")
+                }
+                finish()
+            }
+        } else {
+            Task {
+                try? await catController.pttOn()
+                audioEngine.transmit(source: source) { [weak self] in
+                    Task { @MainActor in
+                        try? await self?.catController.pttOff()
+                        finish()
+                    }
+                }
+            }
+        }
+    }
+
     func stopCW() {
+        if let source = cwToneSource {
+            // The TX path ends with the source and drops PTT itself
+            source.stop()
+            statusText = "CW gestoppt"
+            return
+        }
         morseKeyer.stop()
         if isTruSDX, let port = trusdxPort {
             // Direct POSIX write for immediate stop
@@ -703,17 +950,55 @@ class AppState: ObservableObject {
 
     // MARK: - Helpers
 
-    private func updateStation(callsign: String, grid: String = "", frequency: Double, snr: Int) {
-        if let i = stations.firstIndex(where: { $0.callsign == callsign }) {
-            stations[i].frequency = frequency; stations[i].snr = snr; stations[i].lastHeard = Date()
-            if !grid.isEmpty { stations[i].grid = grid }
-        } else {
-            stations.append(Station(callsign: callsign, grid: grid, frequency: frequency, snr: snr))
+    /// Bring the message lists and stations up to date with a batch of
+    /// decodes: new rows go on top, evicted ones come off the bottom, so
+    /// nothing is filtered or sorted again.
+    private func applyDecodes(_ change: DecodeStore.Change) {
+        let gone = Set(change.evicted.map(\.id))
+        var ft8 = [RxMessage](), js8 = [RxMessage]()
+        for msg in change.inserted.reversed() {
+            if msg.mode == .ft8 { ft8.append(msg) } else if msg.mode == .js8 { js8.append(msg) }
+        }
+        if !ft8.isEmpty || !gone.isEmpty { ft8Messages = Self.updated(ft8Messages, adding: ft8, dropping: gone) }
+        if !js8.isEmpty || !gone.isEmpty { js8Messages = Self.updated(js8Messages, adding: js8, dropping: gone) }
+
+        // Latest word from each sender, keeping a grid heard before
+        var heard = [String: Station]()
+        var order = [String]()
+        for msg in change.inserted.reversed() {
+            guard let call = msg.ft8Message?.from ?? msg.from else { continue }
+            if var station = heard[call] {
+                if station.grid.isEmpty, let grid = msg.ft8Message?.grid {
+                    station.grid = grid
+                    heard[call] = station
+                }
+                continue
+            }
+            var station = Station(callsign: call, grid: msg.ft8Message?.grid ?? "",
+                                  frequency: msg.frequency, snr: msg.snr)
+            station.lastHeard = msg.timestamp
+            heard[call] = station
+            order.append(call)
+        }
+        let evictedCalls = Set(change.evicted.compactMap { $0.ft8Message?.from ?? $0.from })
+        guard !heard.isEmpty || !evictedCalls.isEmpty else { return }
+        var rest = [Station]()
+        rest.reserveCapacity(stations.count)
+        for old in stations {
+            if var station = heard[old.callsign] {
+                if station.grid.isEmpty { station.grid = old.grid; heard[old.callsign] = station }
+            } else if !evictedCalls.contains(old.callsign) || decodes.contains(callsign: old.callsign) {
+                rest.append(old)
+            }
         }
+        stations = order.compactMap { heard[$0] } + rest
     }
 
-    private func addWaterfallRow(_ spectrum: [Float]) {
-        waterfallData.append(spectrum)
-        if waterfallData.count > 200 { waterfallData.removeFirst(waterfallData.count - 200) }
+    private static func updated(_ rows: [RxMessage], adding new: [RxMessage],
+                                dropping gone: Set<UUID>) -> [RxMessage] {
+        var rows = new + rows
+        while let last = rows.last, gone.contains(last.id) { rows.removeLast() }
+        if rows.count > listLimit { rows.removeLast(rows.count - listLimit) }
+        return rows
     }
 }
@@ -78,9 +78,10 @@ struct FT8MainView: View {
     var body: some View {
         NavigationStack {
             VStack(spacing: 0) {
-                WaterfallView(data: appState.waterfallData,
+                WaterfallView(history: appState.waterfall,
                              sampleRate: appState.audioEngine.effectiveSampleRate,
-                             loFreq: 0, hiFreq: 3000)
+                             loFreq: 0, hiFreq: 3000,
+                             framesPerSecond: appState.decodeEffort.waterfallFPS)
                     .frame(height: 120)
                 ClockView()
                 FT8FrequencyView()
@@ -106,9 +107,10 @@ struct JS8MainView: View {
     var body: some View {
         NavigationStack {
             VStack(spacing: 0) {
-                WaterfallView(data: appState.waterfallData,
+                WaterfallView(history: appState.waterfall,
                              sampleRate: appState.audioEngine.effectiveSampleRate,
-                             loFreq: 0, hiFreq: 3000)
+                             loFreq: 0, hiFreq: 3000,
+                             framesPerSecond: appState.decodeEffort.waterfallFPS)
                     .frame(height: 120)
                 JS8FrequencyView()
                 Divider()
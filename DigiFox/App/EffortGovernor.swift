@@ -0,0 +1,87 @@
+import Foundation
+import Combine
+
+/// Picks the decode effort to run at from the one chosen in Settings:
+/// a step down while the device is seriously hot (two when critical) or
+/// in Low Power Mode, and a step per FT8 slot decode that overran its
+/// budget. Each steps back up as it clears, the overruns one at a time
+/// after `recoverySlots` quick decodes, so a long session keeps decoding
+/// in time without staying degraded. Used on the main thread.
+final class EffortGovernor {
+
+    /// A slot decode taking longer leaves too little of the next slot
+    /// to reply in.
+    static let slotBudget: Double = 2.0
+    /// Quick slot decodes (under half the budget) before an overrun step
+    /// is taken back.
+    static let recoverySlots = 8
+
+    /// Effort chosen in Settings.
+    var chosen: DecodeEffort = .full { didSet { update() } }
+    /// Step down at all; off = always `chosen`.
+    var adaptive = true { didSet { update() } }
+
+    /// Effort to decode at now.
+    private(set) var effective: DecodeEffort = .full
+    /// Why `effective` is below `chosen` (nil = it is not).
+    private(set) var reason: String?
+    /// Called whenever `effective` or `reason` changes.
+    var onChange: ((DecodeEffort, String?) -> Void)?
+
+    private var lagSteps = 0
+    private var quickSlots = 0
+    private var cancellables = Set<AnyCancellable>()
+
+    init() {
+        let center = NotificationCenter.default
+        Publishers.Merge(center.publisher(for: ProcessInfo.thermalStateDidChangeNotification),
+                         center.publisher(for: .NSProcessInfoPowerStateDidChange))
+            .receive(on: DispatchQueue.main)
+            .sink { [weak self] _ in self?.update() }
+            .store(in: &cancellables)
+    }
+
+    /// Time the last FT8 slot decode took.
+    func slotDecoded(seconds: Double) {
+        if seconds > Self.slotBudget {
+            lagSteps = min(lagSteps + 1, DecodeEffort.allCases.count - 1)
+            quickSlots = 0
+        } else if lagSteps > 0 && seconds < Self.slotBudget / 2 {
+            quickSlots += 1
+            if quickSlots >= Self.recoverySlots {
+                lagSteps -= 1
+                quickSlots = 0
+            }
+        }
+        update()
+    }
+
+    private func update() {
+        var steps = 0
+        var why: String?
+        if adaptive {
+            let info = ProcessInfo.processInfo
+            switch info.thermalState {
+            case .serious:  steps = 1; why = "device hot"
+            case .critical: steps = 2; why = "device very hot"
+            default: break
+            }
+            if info.isLowPowerModeEnabled && steps < 1 {
+                steps = 1; why = "Low Power Mode"
+            }
+            if lagSteps > steps {
+                steps = lagSteps; why = "decodes running late"
+            }
+        }
+
+        let next = chosen.stepped(down: steps)
+        let note = next == chosen ? nil : why
+        guard next != effective || note != reason else { return }
+        if next != effective {
+            print("[Effort] \(effective.name) → \(next.name)\(note.map { " (\($0))" } ?? "")")
+        }
+        effective = next
+        reason = note
+        onChange?(next, note)
+    }
+}
@@ -0,0 +1,57 @@
+import Foundation
+
+/// Debug heap-allocation tracking on the audio thread (`alloc_tracker.h`).
+///
+/// Off unless the `DIGIFOX_TRACK_ALLOCS` environment variable is set in a
+/// DEBUG build. Each audio callback runs in `callback`, its parts in
+/// `stage`; `report()` tells which stages allocated and how often a
+/// callback did.
+enum AllocationTracker {
+
+    static let isEnabled: Bool = {
+        #if DEBUG
+        return ProcessInfo.processInfo.environment["DIGIFOX_TRACK_ALLOCS"] != nil
+            && alloc_tracker_install() == 0
+        #else
+        return false
+        #endif
+    }()
+
+    /// Run `body` as one callback, recording what it allocated.
+    @inline(__always)
+    static func callback<R>(_ body: () throws -> R) rethrows -> R {
+        guard isEnabled else { return try body() }
+        let before = alloc_tracker_thread_allocs()
+        defer { alloc_tracker_callback(alloc_tracker_thread_allocs() - before) }
+        return try body()
+    }
+
+    /// Run `body` with its allocations counted against `name`. Static
+    /// strings only: the tracker keeps the pointer.
+    @inline(__always)
+    static func stage<R>(_ name: StaticString, _ body: () throws -> R) rethrows -> R {
+        guard isEnabled else { return try body() }
+        let raw = UnsafeRawPointer(name.utf8Start).assumingMemoryBound(to: CChar.self)
+        let previous = alloc_tracker_stage(raw)
+        defer { _ = alloc_tracker_stage(previous) }
+        return try body()
+    }
+
+    /// Callback and per-stage counts so far, one line each.
+    static func report() -> String {
+        let stats = alloc_tracker_stats()
+        var lines = ["\(stats.callbacks) callbacks, \(stats.allocating) allocated: "
+                     + "\(stats.allocs) allocations, at most \(stats.max_per_callback) in one"]
+        var stages = [alloc_tracker_stage_t](repeating: alloc_tracker_stage_t(),
+                                             count: Int(ALLOC_TRACKER_MAX_STAGES))
+        let n = Int(alloc_tracker_stages(&stages, Int32(stages.count)))
+        for stage in stages.prefix(n) {
+            lines.append("  \(String(cString: stage.name)): \(stage.allocs)")
+        }
+        return lines.joined(separator: "\n")
+    }
+
+    static func reset() {
+        alloc_tracker_reset()
+    }
+}
@@ -6,22 +6,44 @@ import Combine
 class AudioEngine: ObservableObject {
     @Published var isRunning = false
     @Published var isTransmitting = false
-    @Published var spectrumData = [Float]()
     @Published var inputLevel: Float = 0
     @Published var usbAudioConnected = false
     /// Effective input sample rate (updated on start or when external source is set)
     @Published var effectiveSampleRate: Double = 12000
 
     private var engine = AVAudioEngine()
-    private let fftProcessor = FFTProcessor(size: 2048)
-    private var audioBuffer = [Float]()
+    /// The one STFT of the input; waterfall, FT8 and CW pitch read its rows
+    let spectrum = SpectrumEngine()
+    /// Last 30 s of input; the audio thread writes it without locking and
+    /// the decoders read it on their own threads. Index i is stream index
+    /// i in `spectrum`: both take every input block, from the start.
+    let sampleRing = SampleRing(history: 12000 * 30)
+    /// Ring index where the buffered samples start (after the last clear)
+    private var bufferStart: UInt64 = 0
     private let bufferLock = NSLock()
     private var routeChangeObserver: NSObjectProtocol?
-    private var externalFFTBuffer = [Float]()  // accumulator for external (TruSDX) samples
 
-    var onSpectrumUpdate: (([Float]) -> Void)?
+    /// Every waterfall line as it completes, on the audio thread, in
+    /// place (see `SpectrumEngine.forEachLine`)
+    var onSpectrumUpdate: ((UnsafeBufferPointer<Float>) -> Void)?
+    /// Gets every input block too while RX audio is being recorded
+    var recorder: AudioRecorder?
+    /// Input level and external sample rate, published once per frame
+    private var display: DisplayPublisher?
 
     init() {
+        display = DisplayPublisher { [weak self] slot, value in
+            guard let self else { return }
+            switch slot {
+            case .inputLevel:
+                self.inputLevel = Float(value)
+            case .sampleRate:
+                if self.effectiveSampleRate != value {
+                    print("[AudioEngine] external sampleRate changed: \(self.effectiveSampleRate) → \(value)")
+                    self.effectiveSampleRate = value
+                }
+            }
+        }
         setupRouteChangeNotification()
         updateUSBStatus()
     }
@@ -105,6 +127,7 @@ class AudioEngine: ObservableObject {
             let actualRate = format.sampleRate
             print("[AudioEngine] start: effective sampleRate=\(actualRate) (requested 12000)")
             DispatchQueue.main.async { self.effectiveSampleRate = actualRate }
+            spectrum?.sampleRate = actualRate
             inputNode.installTap(onBus: 0, bufferSize: 2048, format: format) { [weak self] buffer, _ in
                 self?.processInput(buffer)
             }
@@ -134,11 +157,21 @@ class AudioEngine: ObservableObject {
     func stop() {
         engine.inputNode.removeTap(onBus: 0)
         engine.stop()
+        if AllocationTracker.isEnabled {
+            print("[AudioEngine] allocations on the audio thread:\n\(AllocationTracker.report())")
+            AllocationTracker.reset()
+        }
         DispatchQueue.main.async { self.isRunning = false; self.isTransmitting = false }
     }
 
     func transmit(samples: [Float], completion: (() -> Void)? = nil) {
-        guard !samples.isEmpty else {
+        transmit(source: SampleArraySource(samples), completion: completion)
+    }
+
+    /// Play a TX source, pulling each block from it on the render thread.
+    /// `completion` runs on the main queue once the last sample has played.
+    func transmit(source: TXAudioSource, completion: (() -> Void)? = nil) {
+        guard source.remaining > 0 else {
             completion?()
             return
         }
@@ -157,101 +190,148 @@ class AudioEngine: ObservableObject {
             }
         }
 
-        DispatchQueue.main.async { self.isTransmitting = true }
-
-        guard let format = AVAudioFormat(standardFormatWithSampleRate: 12000.0, channels: 1) else {
-            DispatchQueue.main.async { self.isTransmitting = false }
-            completion?()
-            return
-        }
-        let count = AVAudioFrameCount(samples.count)
-        guard let buffer = AVAudioPCMBuffer(pcmFormat: format, frameCapacity: count) else {
-            DispatchQueue.main.async { self.isTransmitting = false }
+        guard let format = AVAudioFormat(standardFormatWithSampleRate: source.sampleRate, channels: 1) else {
             completion?()
             return
         }
-        buffer.frameLength = count
-        if let cd = buffer.floatChannelData?[0] {
-            for i in 0..<samples.count { cd[i] = samples[i] }
-        }
 
-        let player = AVAudioPlayerNode()
-        engine.attach(player)
-        engine.connect(player, to: engine.mainMixerNode, format: format)
-        player.scheduleBuffer(buffer) { [weak self] in
-            DispatchQueue.main.async {
-                self?.isTransmitting = false
-                self?.engine.detach(player)
-                completion?()
+        DispatchQueue.main.async { self.isTransmitting = true }
+
+        // The render block must not wait on the main queue: it only flags
+        // the end, once, and the tail still in the output is let play out.
+        let finished = OnceFlag()
+        let latency = AVAudioSession.sharedInstance().outputLatency
+            + AVAudioSession.sharedInstance().ioBufferDuration
+        var player: AVAudioSourceNode?
+        player = AVAudioSourceNode(format: format) { [weak self] isSilence, _, frameCount, bufferList in
+            let buffers = UnsafeMutableAudioBufferListPointer(bufferList)
+            guard let data = buffers[0].mData?.assumingMemoryBound(to: Float.self) else { return noErr }
+            let out = UnsafeMutableBufferPointer(start: data, count: Int(frameCount))
+            let n = source.render(into: out)
+            if n < out.count {
+                out.baseAddress!.advanced(by: n).initialize(repeating: 0, count: out.count - n)
             }
+            if n == 0 {
+                isSilence.pointee = true
+                if finished.set() {
+                    DispatchQueue.main.asyncAfter(deadline: .now() + latency) {
+                        self?.isTransmitting = false
+                        if let node = player { self?.engine.detach(node) }
+                        player = nil
+                        completion?()
+                    }
+                }
+            }
+            return noErr
         }
-        player.play()
+        guard let node = player else { return }
+        engine.attach(node)
+        engine.connect(node, to: engine.mainMixerNode, format: format)
     }
 
     private func processInput(_ buffer: AVAudioPCMBuffer) {
         guard let cd = buffer.floatChannelData?[0] else { return }
         let n = Int(buffer.frameLength)
-        var samples = [Float](repeating: 0, count: n)
-        for i in 0..<n { samples[i] = cd[i] }
+        let input = UnsafeBufferPointer(start: cd, count: n)
+
+        let tap = Tracing.signposter.beginInterval("audio.tap", id: Tracing.signposter.makeSignpostID())
+        defer { Tracing.signposter.endInterval("audio.tap", tap) }
+        AllocationTracker.callback {
+            var rms: Float = 0
+            vDSP_rmsqv(cd, 1, &rms, vDSP_Length(n))
+            AllocationTracker.stage("level") {
+                display?.store(.inputLevel, Double(rms))
+            }
 
-        var rms: Float = 0
-        vDSP_rmsqv(samples, 1, &rms, vDSP_Length(n))
-        let spectrum = fftProcessor.magnitudeSpectrum(samples)
+            analyze(input)
 
-        DispatchQueue.main.async { self.inputLevel = rms; self.spectrumData = spectrum }
-        onSpectrumUpdate?(spectrum)
+            AllocationTracker.stage("ring") { sampleRing?.write(cd, count: n) }
+        }
+    }
 
-        bufferLock.lock()
-        audioBuffer.append(contentsOf: samples)
-        let maxBuf = Int(12000.0 * 30)
-        if audioBuffer.count > maxBuf { audioBuffer.removeFirst(audioBuffer.count - maxBuf) }
-        bufferLock.unlock()
+    /// Run a block through the spectrum engine and hand on the waterfall
+    /// lines it completes. The stages are what `AllocationTracker`
+    /// attributes allocations to.
+    private func analyze(_ input: UnsafeBufferPointer<Float>) {
+        AllocationTracker.stage("spectrum") { spectrum?.feed(input) }
+        AllocationTracker.stage("waterfall") {
+            spectrum?.forEachLine { line in onSpectrumUpdate?(line) }
+        }
+        AllocationTracker.stage("recorder") { recorder?.append(input) }
     }
 
+    /// Samples since the last `clearBuffer()`, at most 30 s, as a copy.
     func getBufferedSamples() -> [Float] {
-        bufferLock.lock(); defer { bufferLock.unlock() }
-        return audioBuffer
+        withBufferedSamples { Array($0) }
+    }
+
+    /// Run `body` on the samples since the last `clearBuffer()` (at most
+    /// 30 s) in place, without copying. With `consume`, the buffer then
+    /// starts after them, so the next call sees only newer samples and
+    /// none that arrived meanwhile are lost.
+    func withBufferedSamples<R>(consume: Bool = false, _ body: (UnsafeBufferPointer<Float>) -> R) -> R {
+        guard let ring = sampleRing else { return body(UnsafeBufferPointer(start: nil, count: 0)) }
+        bufferLock.lock()
+        let start = bufferStart
+        bufferLock.unlock()
+
+        let (result, end) = ring.withWindow(from: start, body)
+
+        if consume {
+            bufferLock.lock()
+            if bufferStart == start { bufferStart = end }
+            bufferLock.unlock()
+        }
+        return result
     }
 
     func clearBuffer() {
-        bufferLock.lock(); audioBuffer.removeAll(); bufferLock.unlock()
+        guard let ring = sampleRing else { return }
+        bufferLock.lock(); bufferStart = ring.written; bufferLock.unlock()
     }
 
     /// Feed samples from an external source (e.g. TruSDX serial audio) into the buffer
     func feedExternalSamples(_ samples: [Float], sampleRate: Double) {
-        DispatchQueue.main.async {
-            if self.effectiveSampleRate != sampleRate {
-                print("[AudioEngine] external sampleRate changed: \(self.effectiveSampleRate) → \(sampleRate)")
-                self.effectiveSampleRate = sampleRate
-            }
-        }
+        samples.withUnsafeBufferPointer { feedExternalSamples($0, sampleRate: sampleRate) }
+    }
+
+    /// `feedExternalSamples` with the samples in place, e.g. a resampler's output.
+    func feedExternalSamples(_ samples: UnsafeBufferPointer<Float>, sampleRate: Double) {
+        if let spectrum, spectrum.sampleRate != sampleRate { spectrum.sampleRate = sampleRate }
+        display?.store(.sampleRate, sampleRate)
         processInput_external(samples)
     }
 
-    private func processInput_external(_ samples: [Float]) {
-        guard !samples.isEmpty else { return }
-
-        let rms = sqrt(samples.reduce(0) { $0 + $1 * $1 } / Float(samples.count))
-        DispatchQueue.main.async { self.inputLevel = rms }
-
-        // Accumulate samples for FFT; compute spectrum when we have enough
-        externalFFTBuffer.append(contentsOf: samples)
-        while externalFFTBuffer.count >= fftProcessor.size {
-            let chunk = Array(externalFFTBuffer.prefix(fftProcessor.size))
-            externalFFTBuffer.removeFirst(fftProcessor.size)
-            let spectrum = fftProcessor.magnitudeSpectrum(chunk)
-            if !spectrum.isEmpty {
-                DispatchQueue.main.async {
-                    self.spectrumData = spectrum
-                    self.onSpectrumUpdate?(spectrum)
-                }
+    private func processInput_external(_ samples: UnsafeBufferPointer<Float>) {
+        guard let base = samples.baseAddress, !samples.isEmpty else { return }
+
+        let tap = Tracing.signposter.beginInterval("audio.tap", id: Tracing.signposter.makeSignpostID())
+        defer { Tracing.signposter.endInterval("audio.tap", tap) }
+        AllocationTracker.callback {
+            var rms: Float = 0
+            vDSP_rmsqv(base, 1, &rms, vDSP_Length(samples.count))
+            AllocationTracker.stage("level") {
+                display?.store(.inputLevel, Double(rms))
             }
+
+            analyze(samples)
+
+            AllocationTracker.stage("ring") { sampleRing?.write(base, count: samples.count) }
         }
+    }
+}
 
-        bufferLock.lock()
-        audioBuffer.append(contentsOf: samples)
-        let maxBuf = Int(12000.0 * 30)
-        if audioBuffer.count > maxBuf { audioBuffer.removeFirst(audioBuffer.count - maxBuf) }
-        bufferLock.unlock()
+/// Set-once flag that tells the first setter apart from the rest.
+private final class OnceFlag {
+    private let lock = NSLock()
+    private var isSet = false
+
+    /// True for the call that sets it.
+    func set() -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        if isSet { return false }
+        isSet = true
+        return true
     }
 }
@@ -0,0 +1,99 @@
+import Foundation
+
+/// Records RX audio to a raw archive (`audio_archive.h`) for replay
+/// through the decoders off line, e.g. `ft8_bench -A` or `cw_bench -A`.
+///
+/// The audio thread only appends to a ring of its own; a utility-queue
+/// timer drains the ring into the file, so disk I/O never stalls the
+/// input. If the drain falls more than the ring behind, the lost samples
+/// become a gap in the recording's time line, not a shift.
+final class AudioRecorder {
+    let url: URL
+    let sampleRate: Double
+
+    private let writer: OpaquePointer
+    private let ring: SampleRing
+    private let dial: () -> UInt64
+    private let queue = DispatchQueue(label: "digifox.recorder", qos: .utility)
+    private var timer: DispatchSourceTimer?
+    private var drained: UInt64 = 0
+    private var samples: UInt64 = 0
+    private var closed = false
+
+    /// - Parameters:
+    ///   - dial: Current dial frequency in Hz, read on each drain
+    ///   - compact: 16-bit samples instead of float
+    init?(url: URL, sampleRate: Double, source: String, compact: Bool = true,
+          dial: @escaping () -> UInt64) {
+        let format = compact ? AUDIO_ARCHIVE_I16 : AUDIO_ARCHIVE_F32
+        guard let ring = SampleRing(history: Int(sampleRate) * 10),
+              let w = audio_archive_writer_open(url.path, sampleRate, format, 0,
+                                                Date().timeIntervalSince1970, source) else { return nil }
+        self.url = url
+        self.sampleRate = sampleRate
+        self.writer = w
+        self.ring = ring
+        self.dial = dial
+
+        let t = DispatchSource.makeTimerSource(queue: queue)
+        t.schedule(deadline: .now() + 0.5, repeating: 0.5)
+        t.setEventHandler { [weak self] in self?.drain() }
+        t.resume()
+        timer = t
+    }
+
+    deinit {
+        timer?.cancel()
+        if !closed { audio_archive_writer_close(writer) }
+    }
+
+    /// Audio thread: append an input block.
+    func append(_ input: UnsafeBufferPointer<Float>) {
+        guard let base = input.baseAddress else { return }
+        ring.write(base, count: input.count)
+    }
+
+    /// Seconds written to the file so far.
+    var duration: Double {
+        queue.sync { Double(samples) / sampleRate }
+    }
+
+    /// Write what is buffered and close the file. Returns false if any
+    /// write failed.
+    @discardableResult
+    func stop() -> Bool {
+        timer?.cancel()
+        timer = nil
+        return queue.sync {
+            guard !closed else { return true }
+            drain()
+            closed = true
+            return audio_archive_writer_close(writer) == 0
+        }
+    }
+
+    /// On `queue`: everything appended since the last drain.
+    private func drain() {
+        guard !closed else { return }
+        let hz = dial()
+        let (_, end) = ring.withIndexedWindow(from: drained) { buf, first in
+            guard let base = buf.baseAddress, buf.count > 0 else { return }
+            _ = audio_archive_write(writer, base, Int32(buf.count), first, hz)
+        }
+        drained = end
+        samples = audio_archive_writer_samples(writer)
+    }
+
+    /// A new file in Documents/Recordings named for the current time.
+    static func newRecordingURL() throws -> URL {
+        let docs = try FileManager.default.url(for: .documentDirectory, in: .userDomainMask,
+                                               appropriateFor: nil, create: true)
+        let dir = docs.appendingPathComponent("Recordings", isDirectory: true)
+        try FileManager.default.createDirectory(at: dir, withIntermediateDirectories: true)
+        let f = DateFormatter()
+        f.locale = Locale(identifier: "en_US_POSIX")
+        f.timeZone = TimeZone(identifier: "UTC")
+        f.dateFormat = "yyyyMMdd'T'HHmmss'Z'"
+        return dir.appendingPathComponent("\(f.string(from: Date())).dfxa")
+    }
+}
@@ -0,0 +1,63 @@
+import Foundation
+import QuartzCore
+
+/// Audio-side values for SwiftUI, coalesced to the display refresh
+/// (`ui_latch.h`).
+///
+/// The audio threads `store` as often as they produce a value, without
+/// locking or queueing anything; a display link on the main thread takes
+/// the values that changed since the last frame and hands each to
+/// `flush` once. However fast buffers arrive, the main queue sees at most
+/// one update per slot per frame.
+final class DisplayPublisher {
+
+    /// Values that go through the latch.
+    enum Slot: Int32 {
+        case inputLevel
+        case sampleRate
+    }
+
+    private let latch: OpaquePointer
+    private let flush: (Slot, Double) -> Void
+    private var link: CADisplayLink?
+    private var values = [Double](repeating: 0, count: Int(UI_LATCH_SLOTS))
+
+    /// `flush` runs on the main thread with each changed slot's latest value.
+    init?(framesPerSecond: Float = 30, flush: @escaping (Slot, Double) -> Void) {
+        guard let l = ui_latch_create() else { return nil }
+        self.latch = l
+        self.flush = flush
+
+        let link = CADisplayLink(target: Target(self), selector: #selector(Target.tick))
+        link.preferredFrameRateRange = CAFrameRateRange(minimum: 10, maximum: framesPerSecond,
+                                                        preferred: framesPerSecond)
+        link.add(to: .main, forMode: .common)
+        self.link = link
+    }
+
+    deinit {
+        link?.invalidate()
+        ui_latch_destroy(latch)
+    }
+
+    /// Any thread, including the audio callback: the latest value of `slot`.
+    func store(_ slot: Slot, _ value: Double) {
+        ui_latch_store(latch, slot.rawValue, value)
+    }
+
+    private func tick() {
+        let mask = values.withUnsafeMutableBufferPointer { ui_latch_take(latch, $0.baseAddress!) }
+        guard mask != 0 else { return }
+        for i in 0..<Int(UI_LATCH_SLOTS) where mask & (1 << UInt32(i)) != 0 {
+            if let slot = Slot(rawValue: Int32(i)) { flush(slot, values[i]) }
+        }
+    }
+
+    /// The display link retains its target; this keeps it from retaining
+    /// the publisher.
+    private final class Target: NSObject {
+        weak var owner: DisplayPublisher?
+        init(_ owner: DisplayPublisher) { self.owner = owner }
+        @objc func tick() { owner?.tick() }
+    }
+}
@@ -0,0 +1,61 @@
+import Foundation
+
+/// Lock-free audio history with zero-copy windows (`sample_ring.h`).
+///
+/// One producer appends without ever waiting; the oldest samples are
+/// overwritten once `history` is exceeded. Readers get spans of the
+/// recent history as pointers straight into the ring.
+final class SampleRing {
+
+    /// Samples kept for readers.
+    let history: Int
+
+    private let ring: OpaquePointer
+
+    init?(history: Int) {
+        guard let r = sample_ring_create(Int32(history)) else { return nil }
+        self.ring = r
+        self.history = history
+    }
+
+    deinit {
+        sample_ring_destroy(ring)
+    }
+
+    /// Index one past the newest sample.
+    var written: UInt64 { sample_ring_written(ring) }
+
+    /// Producer: append samples, overwriting the oldest.
+    func write(_ samples: UnsafePointer<Float>, count: Int) {
+        sample_ring_write(ring, samples, Int32(count))
+    }
+
+    func write(_ samples: [Float]) {
+        samples.withUnsafeBufferPointer { buf in
+            if let base = buf.baseAddress { write(base, count: buf.count) }
+        }
+    }
+
+    /// Run `body` on the samples from index `start` (clamped to the
+    /// history) up to the newest, in place. Returns the body's result
+    /// and the index one past the last sample it saw.
+    func withWindow<R>(from start: UInt64, _ body: (UnsafeBufferPointer<Float>) -> R) -> (R, UInt64) {
+        withIndexedWindow(from: start) { buf, _ in body(buf) }
+    }
+
+    /// `withWindow`, with the index of the window's first sample passed
+    /// to `body`: later than `start` when the history no longer has it.
+    func withIndexedWindow<R>(from start: UInt64,
+                              _ body: (UnsafeBufferPointer<Float>, UInt64) -> R) -> (R, UInt64) {
+        let end = written
+        let first = min(max(start, end > UInt64(history) ? end - UInt64(history) : 0), end)
+        let n = Int(end - first)
+        let base = sample_ring_window(ring, first, Int32(n))
+        return (body(UnsafeBufferPointer(start: base, count: base == nil ? 0 : n), first), end)
+    }
+
+    /// Drop all samples. Only safe while the producer is not writing.
+    func reset() {
+        sample_ring_reset(ring)
+    }
+}
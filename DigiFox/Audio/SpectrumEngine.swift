@@ -0,0 +1,79 @@
+import Foundation
+
+/// One STFT of the receive audio, shared by the waterfall, the FT8
+/// decoder and CW pitch detection (`spectrum_engine.h`).
+///
+/// `AudioEngine` feeds every input block on the audio thread. The FT8
+/// decoder copies its rows as waterfall windows, `forEachLine()`
+/// averages them for display, and ggmorse asks it for pitch peaks from
+/// the CW loop; readers never lock.
+final class SpectrumEngine {
+
+    /// Time one waterfall line covers, about one tap buffer as before.
+    static let lineDuration: Double = 0.16
+
+    /// Bins averaged into one waterfall cell (6.25 Hz at 12 kHz).
+    static let binsPerCell = 2
+
+    /// Recent audio the CW pitch is taken from: the newest half of
+    /// ggmorse's 3 s analysis window, as its own STFFT used.
+    static let pitchSpan: Float = 1.5
+
+    /// Native engine, for the decoders that read its rows.
+    let native: OpaquePointer
+
+    /// Input sample rate the bins refer to.
+    var sampleRate: Double {
+        get { Double(spectrum_engine_sample_rate(native)) }
+        set { spectrum_engine_set_sample_rate(native, Int32(newValue.rounded())) }
+    }
+
+    // Waterfall reader state (audio thread only)
+    private var nextRow: UInt64 = 0
+    private var lineBuffer: [Float]
+    private let cells: Int
+
+    init?(sampleRate: Double = 12000) {
+        var cfg = spectrum_engine_config_t()
+        spectrum_engine_config_init(&cfg)
+        cfg.sample_rate = Int32(sampleRate.rounded())
+        guard let eng = spectrum_engine_create(&cfg) else { return nil }
+        native = eng
+        cells = Int(spectrum_engine_bins(eng)) / Self.binsPerCell
+        lineBuffer = [Float](repeating: 0, count: cells * 8)
+    }
+
+    deinit {
+        spectrum_engine_destroy(native)
+    }
+
+    /// Stream index the next block starts at.
+    var samples: UInt64 { spectrum_engine_samples(native) }
+
+    /// Producer: transform a block of input.
+    func feed(_ samples: UnsafeBufferPointer<Float>) {
+        guard let base = samples.baseAddress, !samples.isEmpty else { return }
+        spectrum_engine_feed(native, base, Int32(samples.count))
+    }
+
+    /// Added to the lines' dB so white noise sits at the level of an
+    /// |X|²/N spectrum, where the views' fixed scale is set.
+    static let lineGainDb: Float = 6.02
+
+    /// Hand `body` each waterfall line completed since the last call,
+    /// oldest first, in place: dB from DC up to Nyquist, `lineGainDb`
+    /// below the display level. Allocates nothing; the pointer is only
+    /// valid inside `body`.
+    func forEachLine(_ body: (UnsafeBufferPointer<Float>) -> Void) {
+        let hop = Double(spectrum_engine_hop(native))
+        let rowsPerLine = max(1, Int((Self.lineDuration * sampleRate / hop).rounded()))
+        let maxLines = lineBuffer.count / cells
+        lineBuffer.withUnsafeMutableBufferPointer { buf in
+            let n = Int(spectrum_engine_view(native, &nextRow, Int32(rowsPerLine), Int32(Self.binsPerCell),
+                                             buf.baseAddress, Int32(maxLines)))
+            for k in 0..<n {
+                body(UnsafeBufferPointer(rebasing: buf[(k * cells)..<((k + 1) * cells)]))
+            }
+        }
+    }
+}
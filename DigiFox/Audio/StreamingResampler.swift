@@ -0,0 +1,68 @@
+import Foundation
+
+/// Rational polyphase rate converter over a stream of blocks
+/// (`polyphase_resampler.h`).
+///
+/// History and phase carry over between calls, so a signal converted
+/// block by block is the same as converted whole. Used on both sides of
+/// the (tr)uSDX link: RX 7825 → 12000 Hz for the decoders, TX codec rate
+/// → 11520 Hz for the US blocks.
+final class StreamingResampler {
+    /// Input samples per output sample.
+    let step: Double
+
+    private let native: OpaquePointer
+    private var scratch = [Float]()
+
+    /// Nil if the two rates are not a ratio of the resampler's phases.
+    init?(from sourceRate: Double, to targetRate: Double) {
+        guard let r = polyphase_resampler_create(sourceRate, targetRate, 0) else { return nil }
+        native = r
+        step = sourceRate / targetRate
+    }
+
+    deinit {
+        polyphase_resampler_destroy(native)
+    }
+
+    /// Convert one block, appending to `output`.
+    func process(_ input: UnsafeBufferPointer<Float>, into output: inout [Float]) {
+        guard let base = input.baseAddress, !input.isEmpty else { return }
+        let capacity = Int(polyphase_resampler_max_output(native, Int32(input.count)))
+        if scratch.count < capacity { scratch = [Float](repeating: 0, count: capacity) }
+        let n = scratch.withUnsafeMutableBufferPointer { buf in
+            Int(polyphase_resampler_process(native, base, Int32(input.count), buf.baseAddress))
+        }
+        output.append(contentsOf: scratch[0..<n])
+    }
+
+    /// Convert one block and run `body` on the result in place; it is
+    /// only valid during the call and is reused by the next block.
+    func withProcessed<R>(_ input: UnsafeBufferPointer<Float>,
+                          _ body: (UnsafeBufferPointer<Float>) -> R) -> R {
+        guard let base = input.baseAddress, !input.isEmpty else {
+            return body(UnsafeBufferPointer(start: nil, count: 0))
+        }
+        let capacity = Int(polyphase_resampler_max_output(native, Int32(input.count)))
+        if scratch.count < capacity { scratch = [Float](repeating: 0, count: capacity) }
+        return scratch.withUnsafeMutableBufferPointer { buf in
+            let n = Int(polyphase_resampler_process(native, base, Int32(input.count), buf.baseAddress))
+            return body(UnsafeBufferPointer(start: buf.baseAddress, count: n))
+        }
+    }
+
+    /// Convert one block.
+    func process(_ input: [Float]) -> [Float] {
+        let capacity = Int(polyphase_resampler_max_output(native, Int32(input.count)))
+        return [Float](unsafeUninitializedCapacity: capacity) { buf, count in
+            count = input.withUnsafeBufferPointer { src in
+                Int(polyphase_resampler_process(native, src.baseAddress, Int32(src.count), buf.baseAddress))
+            }
+        }
+    }
+
+    /// Start a new stream.
+    func reset() {
+        polyphase_resampler_reset(native)
+    }
+}
@@ -0,0 +1,53 @@
+import Foundation
+
+/// Pull-based TX audio: the output asks for the next block when it needs it.
+///
+/// A modulator hands one out per transmission (e.g.
+/// `FT8Modulator.source(for:)`), backed by its native synthesizer, so
+/// keying starts at once with constant memory instead of a whole frame
+/// being synthesized and resampled up front. `AudioEngine.transmit(source:)`
+/// pulls from the render thread, `TruSDXSerialAudio.sendAudio(source:)`
+/// one serial block at a time.
+protocol TXAudioSource: AnyObject {
+    /// Rate the samples are rendered at (Hz).
+    var sampleRate: Double { get }
+
+    /// Samples not rendered yet.
+    var remaining: Int { get }
+
+    /// Render the next block; returns the samples written, 0 once done.
+    func render(into buffer: UnsafeMutableBufferPointer<Float>) -> Int
+}
+
+extension ToneSynthesizer: TXAudioSource {}
+
+/// Already synthesized audio, played out as a source.
+final class SampleArraySource: TXAudioSource {
+    let sampleRate: Double
+    private let samples: [Float]
+    private var position = 0
+    private let lock = NSLock()
+
+    init(_ samples: [Float], sampleRate: Double = 12000) {
+        self.samples = samples
+        self.sampleRate = sampleRate
+    }
+
+    var remaining: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return samples.count - position
+    }
+
+    func render(into buffer: UnsafeMutableBufferPointer<Float>) -> Int {
+        lock.lock()
+        defer { lock.unlock() }
+        let n = min(buffer.count, samples.count - position)
+        guard n > 0, let out = buffer.baseAddress else { return 0 }
+        samples.withUnsafeBufferPointer { src in
+            out.initialize(from: src.baseAddress! + position, count: n)
+        }
+        position += n
+        return n
+    }
+}
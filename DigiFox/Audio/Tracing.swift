@@ -0,0 +1,21 @@
+import os
+
+/// Signposts for the receive pipeline, on the com.digifox.app "Decode"
+/// log: the audio tap, decode passes and UI updates from here, and the
+/// decoder cores' own stages (`trace.h`) once `install()` has run. In
+/// Instruments, add os_signpost with that subsystem to see them.
+enum Tracing {
+
+    static let signposter = OSSignposter(subsystem: "com.digifox.app", category: "Decode")
+
+    /// Route the C/C++ cores' intervals to os_signpost.
+    static func install() {
+        _ = trace_signpost_install()
+    }
+
+    /// Run `body` as one interval named `name`.
+    @inline(__always)
+    static func interval<R>(_ name: StaticString, _ body: () throws -> R) rethrows -> R {
+        try signposter.withIntervalSignpost(name, id: signposter.makeSignpostID(), around: body)
+    }
+}
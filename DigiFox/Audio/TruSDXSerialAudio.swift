@@ -1,4 +1,5 @@
 import Foundation
+import Accelerate
 import Combine
 import QuartzCore
 
@@ -39,6 +40,10 @@ import QuartzCore
 ///   State 1 (semicolon): 'U' → state 2; else start new CAT, state 0
 ///   State 2 (semicolonU):'S' → state 3 (audio); else forward "U"+byte as CAT, state 0
 ///   State 3 (audio):     ';' → state 1; else decode as audio sample
+///
+/// The state machine runs natively (`trusdx_demux.h`), a whole run of
+/// audio or CAT bytes at a time: audio runs are converted straight into
+/// the result buffer, CAT responses come back as slices of a text buffer.
 struct TruSDXDemuxer {
 
     struct Result {
@@ -46,67 +51,76 @@ struct TruSDXDemuxer {
         var catResponses: [String]
     }
 
-    private enum State {
-        case cat
-        case semicolon
-        case semicolonU
-        case audio
-    }
+    private var native = trusdx_demux_t()
+    private var catText = [CChar](repeating: 0, count: 4 * (Int(TRUSDX_CAT_MAX) + 1))
+    private var catSlices = [trusdx_slice_t](repeating: trusdx_slice_t(), count: 16)
 
-    private var state: State = .cat
-    private var catBuffer = ""
+    init() {
+        trusdx_demux_reset(&native)
+    }
 
     /// Process incoming bytes and return demuxed audio samples and CAT responses.
     mutating func process(_ data: Data) -> Result {
-        var audio = [Float]()
-        var cat = [String]()
-
-        for byte in data {
-            switch state {
-            case .cat:
-                if byte == 0x3B { // ';'
-                    if !catBuffer.isEmpty {
-                        cat.append(catBuffer + ";")
-                        catBuffer = ""
-                    }
-                    state = .semicolon
-                } else {
-                    catBuffer.append(Character(UnicodeScalar(byte)))
-                }
+        data.withUnsafeBytes { process($0.bindMemory(to: UInt8.self)) }
+    }
 
-            case .semicolon:
-                if byte == UInt8(ascii: "U") {
-                    state = .semicolonU
-                } else {
-                    catBuffer.append(Character(UnicodeScalar(byte)))
-                    state = .cat
-                }
+    /// Process bytes in place, e.g. straight from the serial read ring.
+    mutating func process(_ data: UnsafeBufferPointer<UInt8>) -> Result {
+        var cat = [String]()
+        // At most one sample per byte, converted in place
+        let audio = [Float](unsafeUninitializedCapacity: data.count) { buf, count in
+            count = demux(data, audio: buf.baseAddress, bytes: nil, capacity: data.count, cat: &cat)
+        }
+        return Result(audioSamples: audio, catResponses: cat)
+    }
 
-            case .semicolonU:
-                if byte == UInt8(ascii: "S") {
-                    state = .audio
-                } else {
-                    catBuffer.append("U")
-                    catBuffer.append(Character(UnicodeScalar(byte)))
-                    state = .cat
-                }
+    /// Process incoming bytes, handing each read's audio bytes to `audio`
+    /// unconverted (the buffer is only valid during the call), e.g.
+    /// straight into `GGMorseDecoder.process(bytes:)`.
+    /// - Returns: CAT responses
+    mutating func processBytes(_ data: Data, audio: (UnsafeBufferPointer<UInt8>) -> Void) -> [String] {
+        var cat = [String]()
+        let bytes = UnsafeMutablePointer<UInt8>.allocate(capacity: max(1, data.count))
+        defer { bytes.deallocate() }
+        let n = data.withUnsafeBytes {
+            demux($0.bindMemory(to: UInt8.self), audio: nil, bytes: bytes, capacity: data.count, cat: &cat)
+        }
+        if n > 0 { audio(UnsafeBufferPointer(start: bytes, count: n)) }
+        return cat
+    }
 
-            case .audio:
-                if byte == 0x3B { // ';'
-                    state = .semicolon
-                } else {
-                    audio.append(Self.byteToSample(byte))
+    /// Run `data` through the native demuxer into `audio` and/or `bytes`;
+    /// returns the samples written and appends the CAT responses to `cat`.
+    private mutating func demux(_ data: UnsafeBufferPointer<UInt8>, audio: UnsafeMutablePointer<Float>?,
+                                bytes: UnsafeMutablePointer<UInt8>?, capacity: Int,
+                                cat: inout [String]) -> Int {
+        guard let base = data.baseAddress else { return 0 }
+        var total = 0
+        catText.withUnsafeMutableBufferPointer { text in
+            catSlices.withUnsafeMutableBufferPointer { slices in
+                var done = 0
+                while done < data.count {
+                    var out = trusdx_demux_out_t(
+                        audio: audio.map { $0 + total }, audio_u8: bytes.map { $0 + total },
+                        audio_cap: Int32(capacity - total), n_audio: 0,
+                        cat_text: text.baseAddress, cat_text_cap: Int32(text.count),
+                        cat: slices.baseAddress, cat_cap: Int32(slices.count), n_cat: 0)
+                    done += Int(trusdx_demux_process(&native, base + done, Int32(data.count - done), &out))
+                    total += Int(out.n_audio)
+                    for k in 0..<Int(out.n_cat) {
+                        let slice = UnsafeRawBufferPointer(start: text.baseAddress! + Int(slices[k].offset),
+                                                           count: Int(slices[k].length))
+                        cat.append(String(slice.map { Character(UnicodeScalar($0)) }))
+                    }
                 }
             }
         }
-
-        return Result(audioSamples: audio, catResponses: cat)
+        return total
     }
 
     /// Reset the demuxer state
     mutating func reset() {
-        state = .cat
-        catBuffer = ""
+        trusdx_demux_reset(&native)
     }
 
     /// Convert 8-bit unsigned PCM to float (-1.0 ... 1.0)
@@ -129,7 +143,8 @@ struct TruSDXDemuxer {
 ///
 /// Reference: https://dl2man.de/5-trusdx-details/
 ///
-/// RX flow: TruSDX sends ;US<audio>; blocks → demux → upsample 7825→12000 Hz → codec
+/// RX flow: TruSDX sends ;US<audio>; blocks → demux → polyphase 7825→12000 Hz → FT8/JS8,
+///          and at 7825 Hz straight to ggmorse, which resamples once to its 4 kHz
 /// TX flow: codec → downsample 12000→11520 Hz → encode U8 → ;US<audio>; → TruSDX
 class TruSDXSerialAudio: ObservableObject {
 
@@ -148,12 +163,23 @@ class TruSDXSerialAudio: ObservableObject {
     @Published var state: AudioState = .idle
     @Published var inputLevel: Float = 0
 
-    var onAudioReceived: (([Float]) -> Void)?
+    /// Each read's audio at the RX rate, on the port's I/O queue, in place
+    var onAudioReceived: ((UnsafeBufferPointer<Float>) -> Void)?
+    /// On the main queue
     var onCATResponse: ((String) -> Void)?
 
     private var serialPort: SerialPort?
     private var demuxer = TruSDXDemuxer()
-    private var readTask: Task<Void, Never>?
+    /// Sends UA1; and starts the port's read stream; set while streaming
+    private var streamTask: Task<Void, Never>?
+    /// Input level, published once per frame rather than per read
+    private var display: DisplayPublisher?
+
+    init() {
+        display = DisplayPublisher { [weak self] slot, value in
+            if slot == .inputLevel { self?.inputLevel = Float(value) }
+        }
+    }
 
     func attach(to port: SerialPort) {
         self.serialPort = port
@@ -168,51 +194,31 @@ class TruSDXSerialAudio: ObservableObject {
         state = .streaming
         demuxer.reset()
         print("[TruSDX-Audio] startStreaming: sending UA1;")
-        readTask = Task { [weak self] in
+        streamTask = Task { [weak self] in
             do {
                 try await port.write("UA1;")
                 print("[TruSDX-Audio] startStreaming: UA1; sent OK")
+                guard !Task.isCancelled else { return }
+                // Bytes are demuxed on the port's I/O queue as they arrive
+                try await port.startReadStream { bytes in
+                    self?.handleBytes(bytes)
+                }
             } catch {
-                print("[TruSDX-Audio] startStreaming: UA1; FAILED: \(error)")
+                print("[TruSDX-Audio] startStreaming: FAILED: \(error)")
                 await MainActor.run { self?.state = .error("Failed to start streaming: \(error.localizedDescription)") }
-                return
             }
-            var totalSamples = 0
-            var totalReads = 0
-            while !Task.isCancelled {
-                guard let self else { break }
-                let isOpen = await port.isOpen
-                guard isOpen else {
-                    print("[TruSDX-Audio] readLoop: port closed, stopping")
-                    break
-                }
-                do {
-                    let data = try await port.read(maxLength: 1024)
-                    if !data.isEmpty {
-                        totalReads += 1
-                        let beforeSamples = totalSamples
-                        self.handleData(data)
-                        // Count samples from demuxer (approximate via data size)
-                        if totalReads % 500 == 0 {
-                            print("[TruSDX-Audio] readLoop: \(totalReads) reads, \(data.count) bytes last read")
-                        }
-                    }
-                } catch {
-                    print("[TruSDX-Audio] readLoop: read error: \(error)")
-                    break
-                }
-                try? await Task.sleep(nanoseconds: 1_000_000) // 1ms
-            }
-            print("[TruSDX-Audio] readLoop: ended after \(totalReads) reads")
         }
     }
 
     func stopStreaming() {
         print("[TruSDX-Audio] stopStreaming")
-        readTask?.cancel()
-        readTask = nil
+        streamTask?.cancel()
+        streamTask = nil
         guard let port = serialPort else { return }
-        Task { try? await port.write("UA0;") }
+        Task {
+            await port.stopReadStream()
+            try? await port.write("UA0;")
+        }
         state = .idle
         demuxer.reset()
     }
@@ -220,32 +226,56 @@ class TruSDXSerialAudio: ObservableObject {
     /// Send TX audio: downsample to TX rate, encode as US blocks.
     /// Awaitable — returns only after all audio has been sent.
     func sendAudio(_ samples: [Float], fromSampleRate: Double = 12000) async {
+        await sendAudio(source: SampleArraySource(samples, sampleRate: fromSampleRate))
+    }
+
+    /// Send TX audio pulled from `source` one US block at a time, resampled
+    /// to the TX rate as it goes. Awaitable — returns once the source is done.
+    func sendAudio(source: TXAudioSource) async {
         guard let port = serialPort else {
             print("[TruSDX-Audio] sendAudio: no serial port attached")
             return
         }
-        let downsampled = Self.downsample(samples, from: fromSampleRate, to: Self.txSampleRate)
-        print("[TruSDX-Audio] sendAudio: \(samples.count) samples @ \(fromSampleRate)Hz → \(downsampled.count) samples @ \(Self.txSampleRate)Hz")
+        guard let resampler = StreamingResampler(from: source.sampleRate, to: Self.txSampleRate) else {
+            print("[TruSDX-Audio] sendAudio: cannot resample \(source.sampleRate)Hz → \(Self.txSampleRate)Hz")
+            return
+        }
+        print("[TruSDX-Audio] sendAudio: \(source.remaining) samples @ \(source.sampleRate)Hz → \(Self.txSampleRate)Hz")
 
-        // Pause read loop during TX to avoid actor contention
-        let wasStreaming = readTask != nil
+        // Pause the read stream during TX
+        let wasStreaming = streamTask != nil
         if wasStreaming {
-            print("[TruSDX-Audio] sendAudio: pausing readTask for TX")
-            readTask?.cancel()
-            readTask = nil
+            print("[TruSDX-Audio] sendAudio: pausing read stream for TX")
+            streamTask?.cancel()
+            streamTask = nil
+            await port.stopReadStream()
         }
 
         let chunkSize = 128
+        var input = [Float](repeating: 0, count: Int((Double(chunkSize) * resampler.step).rounded(.up)))
+        var pending = [Float]()
+        pending.reserveCapacity(2 * chunkSize)
         var chunksSent = 0
-        var offset = 0
+        var sourceDone = false
         let txStart = CACurrentMediaTime()
 
-        while offset < downsampled.count {
-            let end = min(offset + chunkSize, downsampled.count)
+        while true {
+            // Pull until a full block is ready, or the source runs out
+            while !sourceDone && pending.count < chunkSize {
+                let n = input.withUnsafeMutableBufferPointer { source.render(into: $0) }
+                if n == 0 { sourceDone = true; break }
+                input.withUnsafeBufferPointer { buf in
+                    resampler.process(UnsafeBufferPointer(rebasing: buf[0..<n]), into: &pending)
+                }
+            }
+            let count = min(chunkSize, pending.count)
+            guard count > 0 else { break }
+
             var payload = Data([0x3B, UInt8(ascii: "U"), UInt8(ascii: "S")]) // ;US prefix
-            for i in offset..<end {
-                payload.append(TruSDXDemuxer.sampleToByte(downsampled[i]))
+            for i in 0..<count {
+                payload.append(TruSDXDemuxer.sampleToByte(pending[i]))
             }
+            pending.removeFirst(count)
             do {
                 try await port.write(payload)
             } catch {
@@ -253,10 +283,8 @@ class TruSDXSerialAudio: ObservableObject {
                 break
             }
             chunksSent += 1
-            let samplesInChunk = end - offset
-            offset = end
             // Pace to match TX sample rate
-            let sleepNs = UInt64(Double(samplesInChunk) / Self.txSampleRate * 1_000_000_000)
+            let sleepNs = UInt64(Double(count) / Self.txSampleRate * 1_000_000_000)
             try? await Task.sleep(nanoseconds: sleepNs)
         }
 
@@ -265,7 +293,7 @@ class TruSDXSerialAudio: ObservableObject {
 
         // Resume read loop after TX
         if wasStreaming {
-            print("[TruSDX-Audio] sendAudio: resuming readTask after TX")
+            print("[TruSDX-Audio] sendAudio: resuming read stream after TX")
             startStreaming()
         }
     }
@@ -276,61 +304,23 @@ class TruSDXSerialAudio: ObservableObject {
         state = .idle
     }
 
-    private func handleData(_ data: Data) {
-        let result = demuxer.process(data)
+    /// Called on the serial port's I/O queue with bytes still in its ring.
+    private func handleBytes(_ bytes: UnsafeBufferPointer<UInt8>) {
+        let result = demuxer.process(bytes)
 
-        if !result.audioSamples.isEmpty {
-            let rms = sqrt(result.audioSamples.reduce(0) { $0 + $1 * $1 } / Float(result.audioSamples.count))
-            DispatchQueue.main.async {
-                self.inputLevel = rms
-                self.onAudioReceived?(result.audioSamples)
-            }
+        result.audioSamples.withUnsafeBufferPointer { audio in
+            guard let base = audio.baseAddress, !audio.isEmpty else { return }
+            var rms: Float = 0
+            vDSP_rmsqv(base, 1, &rms, vDSP_Length(audio.count))
+            display?.store(.inputLevel, Double(rms))
+            onAudioReceived?(audio)
         }
 
-        for response in result.catResponses {
+        // Only CAT goes through main: it is rare, and its handlers touch UI state
+        if !result.catResponses.isEmpty {
             DispatchQueue.main.async {
-                self.onCATResponse?(response)
-            }
-        }
-    }
-
-    // MARK: - Resampling
-
-    /// Upsample RX audio from TruSDX rate (7825 Hz) to codec rate (e.g. 12000 Hz)
-    static func upsample(_ samples: [Float], from sourceSR: Double = rxSampleRate, to targetSR: Double) -> [Float] {
-        let ratio = targetSR / sourceSR
-        let outputCount = Int(Double(samples.count) * ratio)
-        guard outputCount > 0 else { return [] }
-        var output = [Float](repeating: 0, count: outputCount)
-        for i in 0..<outputCount {
-            let srcIndex = Double(i) / ratio
-            let idx = Int(srcIndex)
-            let frac = Float(srcIndex - Double(idx))
-            if idx + 1 < samples.count {
-                output[i] = samples[idx] * (1.0 - frac) + samples[idx + 1] * frac
-            } else if idx < samples.count {
-                output[i] = samples[idx]
-            }
-        }
-        return output
-    }
-
-    /// Downsample TX audio from codec rate (e.g. 12000 Hz) to TruSDX TX rate (11520 Hz)
-    static func downsample(_ samples: [Float], from sourceSR: Double, to targetSR: Double = txSampleRate) -> [Float] {
-        let ratio = sourceSR / targetSR
-        let outputCount = Int(Double(samples.count) / ratio)
-        guard outputCount > 0 else { return [] }
-        var output = [Float](repeating: 0, count: outputCount)
-        for i in 0..<outputCount {
-            let srcIndex = Double(i) * ratio
-            let idx = Int(srcIndex)
-            let frac = Float(srcIndex - Double(idx))
-            if idx + 1 < samples.count {
-                output[i] = samples[idx] * (1.0 - frac) + samples[idx + 1] * frac
-            } else if idx < samples.count {
-                output[i] = samples[idx]
+                for response in result.catResponses { self.onCATResponse?(response) }
             }
         }
-        return output
     }
 }
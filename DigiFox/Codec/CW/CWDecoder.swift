@@ -10,6 +10,7 @@ import Foundation
 /// Processes audio samples and returns decoded CW text.
 final class CWDecoder {
     private var decoder: OpaquePointer?
+    private var cfg = cw_config_t()
     private let outputBuffer = UnsafeMutablePointer<CChar>.allocate(capacity: 1024)
 
     /// Current estimated WPM
@@ -20,7 +21,6 @@ final class CWDecoder {
 
     /// Create a CW decoder with given parameters
     init(sampleRate: Int = 48000, centerFreq: Float = 700.0, bandwidth: Float = 400.0, initialWPM: Float = 20.0) {
-        var cfg = cw_config_t()
         cw_config_init(&cfg)
         cfg.sample_rate = Int32(sampleRate)
         cfg.center_freq = centerFreq
@@ -43,11 +43,13 @@ final class CWDecoder {
     /// Process audio samples and return decoded text (if any).
     /// Audio should be mono float samples in [-1, 1] range.
     func process(samples: [Float]) -> String {
-        guard let dec = decoder, !samples.isEmpty else { return "" }
-        let n = samples.withUnsafeBufferPointer { buf -> Int32 in
-            cw_decoder_process(dec, buf.baseAddress, Int32(samples.count),
-                               outputBuffer, 1024)
-        }
+        samples.withUnsafeBufferPointer { process(samples: $0) }
+    }
+
+    /// Process audio samples in place, e.g. a window of `AudioEngine`'s buffer.
+    func process(samples: UnsafeBufferPointer<Float>) -> String {
+        guard let dec = decoder, let base = samples.baseAddress, !samples.isEmpty else { return "" }
+        let n = cw_decoder_process(dec, base, Int32(samples.count), outputBuffer, 1024)
         guard n > 0 else { return "" }
         return String(bytes: UnsafeBufferPointer(start: outputBuffer, count: Int(n))
                         .map { UInt8(bitPattern: $0) }, encoding: .ascii) ?? ""
@@ -62,6 +64,14 @@ final class CWDecoder {
                         .map { UInt8(bitPattern: $0) }, encoding: .ascii) ?? ""
     }
 
+    /// Move to another tone in place, keeping the learned speed
+    func retune(centerFreq: Float, bandwidth: Float? = nil) {
+        guard let dec = decoder else { return }
+        cfg.center_freq = centerFreq
+        if let bw = bandwidth { cfg.bandwidth = bw }
+        cw_decoder_reconfigure(dec, &cfg)
+    }
+
     /// Reset decoder state for reuse
     func reset() {
         guard let dec = decoder else { return }
@@ -0,0 +1,46 @@
+import Foundation
+
+/// CW as audio: MorseKeyer's key timeline rendered to a shaped tone
+/// (`cw_tone.h`), for AFSK CW with PTT held over the whole message.
+///
+/// Every key edge lands on a precomputed sample, so the output's clock
+/// does all the timing: nothing spins or sleeps between elements, and
+/// the keying is as even as the audio. Played through the same paths as
+/// the digital modes, `AudioEngine.transmit(source:)` or
+/// `TruSDXSerialAudio.sendAudio(source:)`.
+final class CWToneSource: TXAudioSource {
+    let sampleRate: Double
+
+    private let tone: OpaquePointer
+
+    /// Nil if `text` has nothing to key.
+    init?(text: String, wpm: Int, pitch: Double, amplitude: Double = 0.5, sampleRate: Double = 12000) {
+        let edges = MorseKeyer.events(text: text, wpm: wpm).map(\.0)
+        guard !edges.isEmpty, let t = edges.withUnsafeBufferPointer({ buf in
+            cw_tone_create(buf.baseAddress, Int32(buf.count), sampleRate, pitch, 0.005, Float(amplitude))
+        }) else { return nil }
+        tone = t
+        self.sampleRate = sampleRate
+    }
+
+    deinit {
+        cw_tone_destroy(tone)
+    }
+
+    /// Seconds the message takes.
+    var duration: Double { Double(cw_tone_length(tone)) / sampleRate }
+
+    var remaining: Int { Int(cw_tone_remaining(tone)) }
+
+    func render(into buffer: UnsafeMutableBufferPointer<Float>) -> Int {
+        guard let base = buffer.baseAddress else { return 0 }
+        return Int(cw_tone_render(tone, base, Int32(buffer.count)))
+    }
+
+    /// End the message: the next block fades out from wherever the key
+    /// is over one ramp. Only sets a flag, so the render thread never
+    /// waits on the caller.
+    func stop() {
+        cw_tone_stop(tone)
+    }
+}
@@ -5,7 +5,12 @@ import Foundation
 final class GGMorseDecoder {
     private var instance: OpaquePointer?
     private let outputBuffer = UnsafeMutablePointer<CChar>.allocate(capacity: 2048)
+    private static let eventCapacity = 256
+    private let eventBuffer = UnsafeMutablePointer<ggmorse_wrapper_char_event>.allocate(capacity: eventCapacity)
     private(set) var sampleRate: Float
+    private var pitchHz: Float = -1
+    private var pitchRange: ClosedRange<Float> = 200...1200
+    private var fixedWPM: Float = -1
 
     /// Estimated pitch frequency in Hz (auto-detected)
     var pitch: Float {
@@ -19,9 +24,63 @@ final class GGMorseDecoder {
         return ggmorse_wrapper_get_speed(inst)
     }
 
+    /// Threads for the per-frame speed/level search (1 = on the calling thread)
+    var searchThreads: Int = 1 {
+        didSet {
+            guard let inst = instance else { return }
+            ggmorse_wrapper_set_search_threads(inst, Int32(searchThreads))
+        }
+    }
+
+    /// Spacing of the fine speed/level search around the last estimate:
+    /// 1 = every point, 2 = every other one (less work per frame, a little
+    /// less robust on weak or drifting signals)
+    var searchStep: Int = 1 {
+        didSet {
+            guard let inst = instance else { return }
+            ggmorse_wrapper_set_search_step(inst, Int32(searchStep))
+        }
+    }
+
+    /// Idle on dead air: no detector or search until a tone stands out
+    var squelch: Bool = true {
+        didSet {
+            guard let inst = instance else { return }
+            ggmorse_wrapper_set_squelch(inst, squelch ? 1 : 0)
+        }
+    }
+
+    /// Audio the speed search looks at, 1-3 s: a short window suits fast
+    /// contest CW (less delay and memory), the full one QRS. Setting it
+    /// starts decoding over.
+    var window: Float = 3 {
+        didSet { applyWindow() }
+    }
+
+    /// Rate the audio is analysed at, 2000-8000 Hz; pitches up to half of
+    /// it are decoded. Setting it starts decoding over.
+    var analysisRate: Float = 4000 {
+        didSet { applyWindow() }
+    }
+
+    /// Keep the histories as 16-bit half floats: half the memory per
+    /// channel at 11 significant bits. Setting it starts decoding over.
+    var halfPrecisionHistory: Bool = false {
+        didSet {
+            guard let inst = instance else { return }
+            ggmorse_wrapper_set_half_history(inst, halfPrecisionHistory ? 1 : 0)
+        }
+    }
+
+    /// Shared spectrum to take the pitch from instead of ggmorse's own
+    /// STFFT, which is then skipped (nil = the STFFT)
+    var pitchSource: SpectrumEngine? {
+        didSet { applyPitchSource() }
+    }
+
     /// Create a ggmorse decoder.
     /// - Parameters:
-    ///   - sampleRate: Audio sample rate (e.g. 12000 for TruSDX, 48000 for USB)
+    ///   - sampleRate: Audio sample rate (e.g. 7825 for TruSDX, 48000 for USB)
     ///   - samplesPerFrame: Processing frame size (default 128)
     init(sampleRate: Float = 12000, samplesPerFrame: Int = 128) {
         self.sampleRate = sampleRate
@@ -32,21 +91,92 @@ final class GGMorseDecoder {
     deinit {
         if let inst = instance { ggmorse_wrapper_destroy(inst) }
         outputBuffer.deallocate()
+        eventBuffer.deallocate()
     }
 
     /// Process audio samples and return decoded CW text (if any).
     /// - Parameter samples: Mono float samples in [-1, 1]
     /// - Returns: Decoded text string (empty if nothing decoded yet)
     func process(samples: [Float]) -> String {
-        guard let inst = instance, !samples.isEmpty else { return "" }
-        let n = samples.withUnsafeBufferPointer { buf -> Int32 in
-            ggmorse_wrapper_process(inst, buf.baseAddress, Int32(samples.count),
-                                    outputBuffer, 2048)
-        }
+        samples.withUnsafeBufferPointer { process(samples: $0) }
+    }
+
+    /// Process audio samples in place, e.g. a window of `AudioEngine`'s buffer.
+    func process(samples: UnsafeBufferPointer<Float>) -> String {
+        guard let inst = instance, let base = samples.baseAddress, !samples.isEmpty else { return "" }
+        let n = ggmorse_wrapper_process_push(inst, base, Int32(samples.count), outputBuffer, 2048)
         guard n > 0 else { return "" }
         return String(cString: outputBuffer)
     }
 
+    /// Process unsigned 8-bit PCM (128 = silence) without converting it first,
+    /// e.g. TruSDX serial audio at its own rate (see `updateSampleRate`).
+    /// - Parameter bytes: U8 samples
+    /// - Returns: Decoded text string (empty if nothing decoded yet)
+    func process(bytes: UnsafeBufferPointer<UInt8>) -> String {
+        guard let inst = instance, let base = bytes.baseAddress, !bytes.isEmpty else { return "" }
+        let n = ggmorse_wrapper_process_push_u8(inst, base, Int32(bytes.count), outputBuffer, 2048)
+        guard n > 0 else { return "" }
+        return String(cString: outputBuffer)
+    }
+
+    /// Process audio samples and get the decoded characters as records (character,
+    /// input sample, speed, pitch, confidence) instead of text, e.g. to place them
+    /// on the waterfall. Nothing is formatted or allocated: the records live in
+    /// the decoder and are overwritten by the next call.
+    func processEvents(samples: UnsafeBufferPointer<Float>) -> UnsafeBufferPointer<ggmorse_wrapper_char_event> {
+        guard let inst = instance, let base = samples.baseAddress, !samples.isEmpty else {
+            return UnsafeBufferPointer(start: eventBuffer, count: 0)
+        }
+        let n = ggmorse_wrapper_process_events(inst, base, Int32(samples.count),
+                                               eventBuffer, Int32(Self.eventCapacity))
+        return UnsafeBufferPointer(start: eventBuffer, count: Int(n))
+    }
+
+    /// `processEvents(samples:)` for unsigned 8-bit PCM, as `process(bytes:)`.
+    func processEvents(bytes: UnsafeBufferPointer<UInt8>) -> UnsafeBufferPointer<ggmorse_wrapper_char_event> {
+        guard let inst = instance, let base = bytes.baseAddress, !bytes.isEmpty else {
+            return UnsafeBufferPointer(start: eventBuffer, count: 0)
+        }
+        let n = ggmorse_wrapper_process_events_u8(inst, base, Int32(bytes.count),
+                                                  eventBuffer, Int32(Self.eventCapacity))
+        return UnsafeBufferPointer(start: eventBuffer, count: Int(n))
+    }
+
+    /// Decode a whole recording at `sampleRate` (e.g. one from `AudioRecorder`)
+    /// on several cores, with this decoder's pitch, speed and squelch settings.
+    /// The live decoding state is not touched; call it off the audio thread.
+    /// - Parameters:
+    ///   - samples: The recording, mono float samples in [-1, 1]
+    ///   - threads: Threads to use, 0 for one per core
+    /// - Returns: The decoded text
+    func decodeBatch(samples: UnsafeBufferPointer<Float>, threads: Int = 0) -> String {
+        guard let inst = instance, let base = samples.baseAddress, !samples.isEmpty else { return "" }
+        // a character takes at least 4 dits: 80 ms at 60 WPM
+        let capacity = Int(Double(samples.count) / Double(sampleRate) / 0.08) + 64
+        var text = [CChar](repeating: 0, count: capacity)
+        let n = text.withUnsafeMutableBufferPointer { buf in
+            ggmorse_wrapper_decode_batch(inst, base, Int64(samples.count), Int32(threads),
+                                         buf.baseAddress, Int32(capacity))
+        }
+        guard n > 0 else { return "" }
+        return String(cString: text)
+    }
+
+    /// Spectrogram rows (power, 0-2000 Hz) produced since row `seq`, oldest first
+    /// (none while a `pitchSource` stands in for the STFFT).
+    /// `seq` is advanced past the returned rows, so a waterfall only pulls new ones.
+    func spectrogramRows(since seq: inout Int64, maxRows: Int = 64) -> [[Float]] {
+        guard let inst = instance, maxRows > 0 else { return [] }
+        let nBins = Int(ggmorse_wrapper_get_spectrogram_bins(inst))
+        guard nBins > 0 else { return [] }
+        var flat = [Float](repeating: 0, count: nBins * maxRows)
+        let n = Int(flat.withUnsafeMutableBufferPointer { buf in
+            ggmorse_wrapper_get_spectrogram_rows(inst, &seq, buf.baseAddress, Int32(maxRows))
+        })
+        return (0..<n).map { Array(flat[$0 * nBins ..< ($0 + 1) * nBins]) }
+    }
+
     /// Reset decoder state (e.g. when switching bands)
     func reset() {
         guard let inst = instance else { return }
@@ -54,12 +184,66 @@ final class GGMorseDecoder {
         print("[GGMorse] reset")
     }
 
-    /// Recreate decoder with new sample rate
+    /// Retune without recreating the decoder: the learned speed and the audio
+    /// history are kept, so click-tuning across a pileup decodes at once.
+    /// - Parameters:
+    ///   - pitch: Tone to decode in Hz, nil to auto-detect
+    ///   - range: Band searched for pitches (up to 2000 Hz)
+    ///   - wpm: Fixed speed, nil to auto-detect
+    /// - Returns: false for a bad range (nothing changed)
+    @discardableResult
+    func retune(pitch: Float? = nil, range: ClosedRange<Float> = 200...1200, wpm: Float? = nil) -> Bool {
+        guard let inst = instance else { return false }
+        pitchHz = pitch ?? -1
+        pitchRange = range
+        fixedWPM = wpm ?? -1
+        return ggmorse_wrapper_retune(inst, pitchHz, range.lowerBound, range.upperBound, fixedWPM) == 0
+    }
+
+    /// Recreate decoder with new sample rate (the resampler is built for it)
     func updateSampleRate(_ newRate: Float) {
         guard newRate != sampleRate, newRate > 0 else { return }
         print("[GGMorse] rate change: \(sampleRate) → \(newRate)")
         if let inst = instance { ggmorse_wrapper_destroy(inst) }
         sampleRate = newRate
         instance = ggmorse_wrapper_create(newRate, 128)
+        if let inst = instance, searchThreads > 1 {
+            ggmorse_wrapper_set_search_threads(inst, Int32(searchThreads))
+        }
+        if let inst = instance, searchStep != 1 {
+            ggmorse_wrapper_set_search_step(inst, Int32(searchStep))
+        }
+        if let inst = instance, !squelch {
+            ggmorse_wrapper_set_squelch(inst, 0)
+        }
+        if let inst = instance, pitchHz > 0 || fixedWPM > 0 || pitchRange != 200...1200 {
+            ggmorse_wrapper_retune(inst, pitchHz, pitchRange.lowerBound, pitchRange.upperBound, fixedWPM)
+        }
+        if let inst = instance, halfPrecisionHistory {
+            ggmorse_wrapper_set_half_history(inst, 1)
+        }
+        if window != 3 || analysisRate != 4000 {
+            applyWindow()
+        }
+        applyPitchSource()
+    }
+
+    private func applyWindow() {
+        guard let inst = instance else { return }
+        if ggmorse_wrapper_set_window(inst, window, analysisRate) != 0 {
+            print("[GGMorse] window \(window) s at \(analysisRate) Hz rejected")
+        }
+    }
+
+    private func applyPitchSource() {
+        guard let inst = instance else { return }
+        guard let source = pitchSource else {
+            ggmorse_wrapper_set_pitch_source(inst, nil, nil)
+            return
+        }
+        ggmorse_wrapper_set_pitch_source(inst, { engine, fMin, fMax, spacing, dst, nTaken, n in
+            spectrum_engine_peaks(OpaquePointer(engine), SpectrumEngine.pitchSpan,
+                                  fMin, fMax, spacing, dst, nTaken, n)
+        }, UnsafeMutableRawPointer(source.native))
     }
 }
@@ -0,0 +1,210 @@
+/**
+ * alloc_tracker.c — Default-zone malloc hooks with per-thread stage attribution
+ */
+
+#include "alloc_tracker.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+
+#if defined(__APPLE__) && defined(DEBUG)
+#define ALLOC_TRACKER_HOOKS 1
+#include <mach/mach.h>
+#include <malloc/malloc.h>
+#endif
+
+/*
+ * Per-thread state lives in pthread keys, not _Thread_local: Darwin
+ * allocates a thread's TLV block on first use, through the very malloc
+ * being hooked.
+ */
+static pthread_once_t s_once = PTHREAD_ONCE_INIT;
+static pthread_key_t  s_stage_key;
+static pthread_key_t  s_count_key;
+
+static _Atomic(const char *) s_names[ALLOC_TRACKER_MAX_STAGES];
+static atomic_long           s_counts[ALLOC_TRACKER_MAX_STAGES];
+
+static atomic_long s_callbacks;
+static atomic_long s_allocating;
+static atomic_long s_callback_allocs;
+static atomic_long s_max_per_callback;
+
+static void make_keys(void)
+{
+    pthread_key_create(&s_stage_key, NULL);
+    pthread_key_create(&s_count_key, NULL);
+}
+
+#ifdef ALLOC_TRACKER_HOOKS
+
+/* Count one allocation if this thread is in a stage */
+static void note(void)
+{
+    const char *stage = (const char *)pthread_getspecific(s_stage_key);
+    if (!stage) return;
+
+    uintptr_t n = (uintptr_t)pthread_getspecific(s_count_key);
+    pthread_setspecific(s_count_key, (const void *)(n + 1));
+
+    for (int k = 0; k < ALLOC_TRACKER_MAX_STAGES; k++) {
+        const char *name = atomic_load_explicit(&s_names[k], memory_order_acquire);
+        if (!name) {
+            const char *expected = NULL;
+            if (!atomic_compare_exchange_strong_explicit(&s_names[k], &expected, stage,
+                                                         memory_order_acq_rel,
+                                                         memory_order_acquire) &&
+                expected != stage) continue;
+            name = stage;
+        }
+        if (name == stage) {
+            atomic_fetch_add_explicit(&s_counts[k], 1, memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+static void *(*s_malloc)(malloc_zone_t *, size_t);
+static void *(*s_calloc)(malloc_zone_t *, size_t, size_t);
+static void *(*s_realloc)(malloc_zone_t *, void *, size_t);
+static void *(*s_memalign)(malloc_zone_t *, size_t, size_t);
+
+static void *hook_malloc(malloc_zone_t *zone, size_t size)
+{
+    note();
+    return s_malloc(zone, size);
+}
+
+static void *hook_calloc(malloc_zone_t *zone, size_t n, size_t size)
+{
+    note();
+    return s_calloc(zone, n, size);
+}
+
+static void *hook_realloc(malloc_zone_t *zone, void *p, size_t size)
+{
+    note();
+    return s_realloc(zone, p, size);
+}
+
+static void *hook_memalign(malloc_zone_t *zone, size_t alignment, size_t size)
+{
+    note();
+    return s_memalign(zone, alignment, size);
+}
+
+static int s_installed = -1;
+
+static void install(void)
+{
+    pthread_once(&s_once, make_keys);
+
+    malloc_zone_t *zone = malloc_default_zone();
+    if (!zone) return;
+
+    /* The zone's function table sits on a read-only page */
+    vm_address_t page = (vm_address_t)zone & ~(vm_address_t)(vm_page_size - 1);
+    vm_size_t span = (vm_address_t)(zone + 1) - page;
+    if (vm_protect(mach_task_self(), page, span, 0, VM_PROT_READ | VM_PROT_WRITE) != KERN_SUCCESS)
+        return;
+
+    s_malloc = zone->malloc;
+    s_calloc = zone->calloc;
+    s_realloc = zone->realloc;
+    zone->malloc = hook_malloc;
+    zone->calloc = hook_calloc;
+    zone->realloc = hook_realloc;
+    if (zone->version >= 5 && zone->memalign) {
+        s_memalign = zone->memalign;
+        zone->memalign = hook_memalign;
+    }
+
+    vm_protect(mach_task_self(), page, span, 0, VM_PROT_READ);
+    s_installed = 0;
+}
+
+int alloc_tracker_install(void)
+{
+    static pthread_once_t once = PTHREAD_ONCE_INIT;
+    pthread_once(&once, install);
+    return s_installed;
+}
+
+#else
+
+int alloc_tracker_install(void)
+{
+    return -1;
+}
+
+#endif /* ALLOC_TRACKER_HOOKS */
+
+const char *alloc_tracker_stage(const char *stage)
+{
+    pthread_once(&s_once, make_keys);
+    const char *prev = (const char *)pthread_getspecific(s_stage_key);
+    pthread_setspecific(s_stage_key, stage);
+    return prev;
+}
+
+long alloc_tracker_thread_allocs(void)
+{
+    pthread_once(&s_once, make_keys);
+    return (long)(uintptr_t)pthread_getspecific(s_count_key);
+}
+
+void alloc_tracker_callback(long allocs)
+{
+    atomic_fetch_add_explicit(&s_callbacks, 1, memory_order_relaxed);
+    if (allocs <= 0) return;
+    atomic_fetch_add_explicit(&s_allocating, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&s_callback_allocs, allocs, memory_order_relaxed);
+    long max = atomic_load_explicit(&s_max_per_callback, memory_order_relaxed);
+    while (allocs > max &&
+           !atomic_compare_exchange_weak_explicit(&s_max_per_callback, &max, allocs,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+alloc_tracker_stats_t alloc_tracker_stats(void)
+{
+    alloc_tracker_stats_t s;
+    s.callbacks = atomic_load_explicit(&s_callbacks, memory_order_relaxed);
+    s.allocating = atomic_load_explicit(&s_allocating, memory_order_relaxed);
+    s.allocs = atomic_load_explicit(&s_callback_allocs, memory_order_relaxed);
+    s.max_per_callback = atomic_load_explicit(&s_max_per_callback, memory_order_relaxed);
+    return s;
+}
+
+int alloc_tracker_stages(alloc_tracker_stage_t *out, int max)
+{
+    alloc_tracker_stage_t all[ALLOC_TRACKER_MAX_STAGES];
+    int total = 0;
+    for (int k = 0; k < ALLOC_TRACKER_MAX_STAGES; k++) {
+        const char *name = atomic_load_explicit(&s_names[k], memory_order_acquire);
+        long count = atomic_load_explicit(&s_counts[k], memory_order_relaxed);
+        if (name && count > 0) all[total++] = (alloc_tracker_stage_t){ name, count };
+    }
+
+    /* The largest max, by selection */
+    int n = total < max ? total : max;
+    for (int i = 0; i < n; i++) {
+        int best = i;
+        for (int j = i + 1; j < total; j++)
+            if (all[j].allocs > all[best].allocs) best = j;
+        alloc_tracker_stage_t t = all[i]; all[i] = all[best]; all[best] = t;
+        out[i] = all[i];
+    }
+    return n;
+}
+
+void alloc_tracker_reset(void)
+{
+    for (int k = 0; k < ALLOC_TRACKER_MAX_STAGES; k++)
+        atomic_store_explicit(&s_counts[k], 0, memory_order_relaxed);
+    atomic_store_explicit(&s_callbacks, 0, memory_order_relaxed);
+    atomic_store_explicit(&s_allocating, 0, memory_order_relaxed);
+    atomic_store_explicit(&s_callback_allocs, 0, memory_order_relaxed);
+    atomic_store_explicit(&s_max_per_callback, 0, memory_order_relaxed);
+}
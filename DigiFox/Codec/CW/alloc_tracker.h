@@ -0,0 +1,76 @@
+/**
+ * alloc_tracker.h — Debug heap-allocation tracking for the audio thread
+ *
+ * alloc_tracker_install() hooks malloc, calloc, realloc and memalign in
+ * the default malloc zone, which Swift objects, arrays and closures go
+ * through as well as C. A thread counts its allocations only while it
+ * names a stage (alloc_tracker_stage()), so the audio thread can bracket
+ * each part of its callback (spectrum, decoder feeds, recorder) and the
+ * rest of the app costs one thread-specific load per allocation.
+ *
+ * The counts are per stage, for the whole app, and per thread, read
+ * before and after a callback to get what it allocated; the callback
+ * tally keeps how many callbacks allocated at all and the most one did.
+ * A real-time callback should allocate nothing once warmed up.
+ *
+ * Only in DEBUG builds on Apple platforms; elsewhere install fails and
+ * the rest are no-ops (the host benches count through their own
+ * wrappers, Codec/regress/alloc_count.h).
+ */
+
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ALLOC_TRACKER_MAX_STAGES  16
+
+typedef struct {
+    const char *name;
+    long        allocs;
+} alloc_tracker_stage_t;
+
+typedef struct {
+    long callbacks;
+    long allocating;            /* Callbacks that allocated */
+    long allocs;                /* In all callbacks */
+    long max_per_callback;
+} alloc_tracker_stats_t;
+
+/**
+ * Hook the default malloc zone. Idempotent.
+ * @return 0 on success, -1 where not available
+ */
+int alloc_tracker_install(void);
+
+/**
+ * Name the stage this thread is in: a string that lives for the rest
+ * of the run (a literal), or NULL to stop counting.
+ * @return The previous one, to restore
+ */
+const char *alloc_tracker_stage(const char *stage);
+
+/* Allocations this thread has made in stages */
+long alloc_tracker_thread_allocs(void);
+
+/* Record one callback that made `allocs` allocations */
+void alloc_tracker_callback(long allocs);
+
+alloc_tracker_stats_t alloc_tracker_stats(void);
+
+/**
+ * Stages that have allocated, most allocations first.
+ * @return Stages written
+ */
+int alloc_tracker_stages(alloc_tracker_stage_t *out, int max);
+
+/* Zero all counts; the hooks stay installed */
+void alloc_tracker_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ALLOC_TRACKER_H */
@@ -0,0 +1,323 @@
+/**
+ * audio_archive.c — Fixed-stride framed recordings, written whole-frame, read by mmap
+ */
+
+#include "audio_archive.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+_Static_assert(sizeof(audio_archive_header_t) == 64, "archive header is 64 bytes");
+_Static_assert(sizeof(audio_archive_frame_t) == 32, "frame header is 32 bytes");
+
+static int bytes_per_sample(uint32_t format)
+{
+    switch (format) {
+    case AUDIO_ARCHIVE_F32: return 4;
+    case AUDIO_ARCHIVE_I16: return 2;
+    default:                return 0;
+    }
+}
+
+static uint32_t frame_stride(uint32_t format, uint32_t frame_samples)
+{
+    size_t bytes = sizeof(audio_archive_frame_t) + (size_t)frame_samples * bytes_per_sample(format);
+    return (uint32_t)((bytes + 15) & ~(size_t)15);
+}
+
+static int write_all(int fd, const void *buf, size_t n)
+{
+    const char *p = (const char *)buf;
+    while (n > 0) {
+        ssize_t w = write(fd, p, n);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        p += w;
+        n -= (size_t)w;
+    }
+    return 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* Writer                                                              */
+/* ------------------------------------------------------------------ */
+
+struct audio_archive_writer_t {
+    int      fd;
+    audio_archive_header_t header;
+    uint8_t *frame;              /* One stride: header + samples */
+    int      filled;             /* Samples in frame */
+    uint64_t next_index;         /* Stream index after the last sample */
+    uint64_t samples;
+    int      failed;
+};
+
+static audio_archive_frame_t *cur_frame(audio_archive_writer_t *w)
+{
+    return (audio_archive_frame_t *)w->frame;
+}
+
+static int flush_frame(audio_archive_writer_t *w)
+{
+    if (w->filled == 0) return 0;
+    cur_frame(w)->samples = (uint32_t)w->filled;
+    size_t used = sizeof(audio_archive_frame_t) +
+                  (size_t)w->filled * bytes_per_sample(w->header.format);
+    memset(w->frame + used, 0, w->header.frame_bytes - used);
+    w->filled = 0;
+    if (write_all(w->fd, w->frame, w->header.frame_bytes) != 0) {
+        w->failed = 1;
+        return -1;
+    }
+    return 0;
+}
+
+audio_archive_writer_t *audio_archive_writer_open(const char *path, double sample_rate,
+                                                  audio_archive_format_t format,
+                                                  int frame_samples, double start_utc,
+                                                  const char *source)
+{
+    if (!path || !(sample_rate > 0.0) || bytes_per_sample(format) == 0) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if (frame_samples <= 0) frame_samples = AUDIO_ARCHIVE_FRAME_SAMPLES;
+
+    audio_archive_writer_t *w = (audio_archive_writer_t *)calloc(1, sizeof(audio_archive_writer_t));
+    if (!w) return NULL;
+
+    audio_archive_header_t *h = &w->header;
+    memcpy(h->magic, AUDIO_ARCHIVE_MAGIC, 4);
+    h->version = AUDIO_ARCHIVE_VERSION;
+    h->format = (uint32_t)format;
+    h->frame_samples = (uint32_t)frame_samples;
+    h->sample_rate = sample_rate;
+    h->start_utc = start_utc;
+    h->header_bytes = sizeof(audio_archive_header_t);
+    h->frame_bytes = frame_stride(h->format, h->frame_samples);
+    if (source) strncpy(h->source, source, sizeof(h->source) - 1);
+
+    w->frame = (uint8_t *)calloc(1, h->frame_bytes);
+    w->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (!w->frame || w->fd < 0 || write_all(w->fd, h, sizeof(*h)) != 0) {
+        int err = errno;
+        if (w->fd >= 0) close(w->fd);
+        free(w->frame);
+        free(w);
+        errno = err;
+        return NULL;
+    }
+    return w;
+}
+
+int audio_archive_write(audio_archive_writer_t *w, const float *x, int n,
+                        uint64_t first_sample, uint64_t dial_hz)
+{
+    if (w->failed) return -1;
+    if (w->filled > 0 && (first_sample != w->next_index || dial_hz != cur_frame(w)->dial_hz)) {
+        if (flush_frame(w) != 0) return -1;
+    }
+
+    const int cap = (int)w->header.frame_samples;
+    uint64_t index = first_sample;
+    while (n > 0) {
+        if (w->filled == 0) {
+            audio_archive_frame_t *f = cur_frame(w);
+            f->magic = AUDIO_ARCHIVE_FRAME_MAGIC;
+            f->samples = 0;
+            f->first_sample = index;
+            f->utc = w->header.start_utc + (double)index / w->header.sample_rate;
+            f->dial_hz = dial_hz;
+        }
+
+        int k = cap - w->filled;
+        if (k > n) k = n;
+        uint8_t *data = w->frame + sizeof(audio_archive_frame_t);
+        if (w->header.format == AUDIO_ARCHIVE_F32) {
+            memcpy((float *)data + w->filled, x, (size_t)k * sizeof(float));
+        } else {
+            int16_t *d = (int16_t *)data + w->filled;
+            for (int i = 0; i < k; i++) {
+                float v = x[i] * 32767.0f;
+                if (v > 32767.0f) v = 32767.0f;
+                if (v < -32767.0f) v = -32767.0f;
+                d[i] = (int16_t)lrintf(v);
+            }
+        }
+        w->filled += k;
+        x += k;
+        n -= k;
+        index += (uint64_t)k;
+        w->samples += (uint64_t)k;
+        if (w->filled == cap && flush_frame(w) != 0) return -1;
+    }
+    w->next_index = index;
+    return 0;
+}
+
+uint64_t audio_archive_writer_samples(const audio_archive_writer_t *w)
+{
+    return w->samples;
+}
+
+int audio_archive_writer_close(audio_archive_writer_t *w)
+{
+    if (!w) return 0;
+    int result = (w->failed || flush_frame(w) != 0) ? -1 : 0;
+    if (close(w->fd) != 0) result = -1;
+    free(w->frame);
+    free(w);
+    return result;
+}
+
+/* ------------------------------------------------------------------ */
+/* Reader                                                              */
+/* ------------------------------------------------------------------ */
+
+struct audio_archive_t {
+    const uint8_t *base;
+    size_t   size;
+    const audio_archive_header_t *header;
+    int      frames;
+    int      bps;
+};
+
+audio_archive_t *audio_archive_open(const char *path)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(audio_archive_header_t)) {
+        close(fd);
+        return NULL;
+    }
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return NULL;
+
+    const audio_archive_header_t *h = (const audio_archive_header_t *)map;
+    int bps = bytes_per_sample(h->format);
+    if (memcmp(h->magic, AUDIO_ARCHIVE_MAGIC, 4) != 0 || h->version != AUDIO_ARCHIVE_VERSION ||
+        bps == 0 || h->frame_samples == 0 || !(h->sample_rate > 0.0) ||
+        h->header_bytes < sizeof(*h) || h->frame_bytes != frame_stride(h->format, h->frame_samples)) {
+        munmap(map, (size_t)st.st_size);
+        return NULL;
+    }
+
+    audio_archive_t *a = (audio_archive_t *)calloc(1, sizeof(audio_archive_t));
+    if (!a) {
+        munmap(map, (size_t)st.st_size);
+        return NULL;
+    }
+    a->base = (const uint8_t *)map;
+    a->size = (size_t)st.st_size;
+    a->header = h;
+    a->bps = bps;
+    size_t body = a->size > h->header_bytes ? a->size - h->header_bytes : 0;
+    a->frames = (int)(body / h->frame_bytes);
+
+    /* Stop at the first frame that is not one (a torn write) */
+    for (int k = 0; k < a->frames; k++) {
+        const audio_archive_frame_t *f = audio_archive_frame(a, k);
+        if (f->magic != AUDIO_ARCHIVE_FRAME_MAGIC || f->samples > h->frame_samples) {
+            a->frames = k;
+            break;
+        }
+    }
+    madvise(map, a->size, MADV_SEQUENTIAL);
+    return a;
+}
+
+const audio_archive_header_t *audio_archive_header(const audio_archive_t *a)
+{
+    return a->header;
+}
+
+int audio_archive_frames(const audio_archive_t *a)
+{
+    return a->frames;
+}
+
+const audio_archive_frame_t *audio_archive_frame(const audio_archive_t *a, int k)
+{
+    return (const audio_archive_frame_t *)(a->base + a->header->header_bytes +
+                                           (size_t)k * a->header->frame_bytes);
+}
+
+const void *audio_archive_frame_data(const audio_archive_t *a, int k)
+{
+    return (const uint8_t *)audio_archive_frame(a, k) + sizeof(audio_archive_frame_t);
+}
+
+uint64_t audio_archive_end(const audio_archive_t *a)
+{
+    if (a->frames == 0) return 0;
+    const audio_archive_frame_t *f = audio_archive_frame(a, a->frames - 1);
+    return f->first_sample + f->samples;
+}
+
+uint64_t audio_archive_index_at(const audio_archive_t *a, double utc)
+{
+    double t = (utc - a->header->start_utc) * a->header->sample_rate;
+    return t > 0.0 ? (uint64_t)llround(t) : 0;
+}
+
+/* First frame that ends after index */
+static int frame_for(const audio_archive_t *a, uint64_t index)
+{
+    int lo = 0, hi = a->frames;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        const audio_archive_frame_t *f = audio_archive_frame(a, mid);
+        if (f->first_sample + f->samples <= index) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+int audio_archive_read(const audio_archive_t *a, uint64_t first, float *out, int n,
+                       uint64_t *dial_hz)
+{
+    memset(out, 0, (size_t)n * sizeof(float));
+    if (dial_hz) *dial_hz = 0;
+
+    const uint64_t end = first + (uint64_t)n;
+    int copied = 0;
+    for (int k = frame_for(a, first); k < a->frames; k++) {
+        const audio_archive_frame_t *f = audio_archive_frame(a, k);
+        if (f->first_sample >= end) break;
+
+        uint64_t from = f->first_sample > first ? f->first_sample : first;
+        uint64_t to = f->first_sample + f->samples < end ? f->first_sample + f->samples : end;
+        if (to <= from) continue;
+        if (dial_hz && copied == 0) *dial_hz = f->dial_hz;
+
+        int count = (int)(to - from);
+        size_t src = (size_t)(from - f->first_sample);
+        float *dst = out + (from - first);
+        const void *data = audio_archive_frame_data(a, k);
+        if (a->header->format == AUDIO_ARCHIVE_F32) {
+            memcpy(dst, (const float *)data + src, (size_t)count * sizeof(float));
+        } else {
+            const int16_t *s = (const int16_t *)data + src;
+            for (int i = 0; i < count; i++) dst[i] = (float)s[i] * (1.0f / 32767.0f);
+        }
+        copied += count;
+    }
+    return copied;
+}
+
+void audio_archive_close(audio_archive_t *a)
+{
+    if (!a) return;
+    munmap((void *)a->base, a->size);
+    free(a);
+}
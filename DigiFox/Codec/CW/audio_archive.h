@@ -0,0 +1,152 @@
+/**
+ * audio_archive.h — Raw RX audio recordings for offline replay
+ *
+ * The app records what the decoders heard, with when and on which dial
+ * frequency, so a band opening can be replayed through the CW, ggmorse
+ * and FT8 decoders later, faster than real time, for tuning and
+ * regression runs (see the -A option of the benches).
+ *
+ * File layout (host byte order, every part 16-byte aligned):
+ *
+ *   audio_archive_header_t                        64 bytes
+ *   frame 0: audio_archive_frame_t + samples      frame_bytes
+ *   frame 1: ...
+ *
+ * Every frame has the same stride, room for frame_samples samples, so
+ * frame k is at header_bytes + k · frame_bytes and the file can be
+ * mmapped and indexed directly; the last frame of a recording may hold
+ * fewer. Each frame carries the stream index and UTC of its first
+ * sample and the dial frequency, so FT8 slots are found from the UTC and
+ * a gap in the input (a stalled audio thread, a paused recording) is a
+ * jump in the index rather than a shift of everything after it. A new
+ * frame starts whenever the dial or the time line changes.
+ *
+ * Samples are 32-bit float, or 16-bit int (scaled by 32767, clipped)
+ * for half the size.
+ */
+
+#ifndef AUDIO_ARCHIVE_H
+#define AUDIO_ARCHIVE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AUDIO_ARCHIVE_MAGIC          "DFXA"
+#define AUDIO_ARCHIVE_VERSION        1
+#define AUDIO_ARCHIVE_FRAME_MAGIC    0x454D5246u     /* "FRME" */
+#define AUDIO_ARCHIVE_FRAME_SAMPLES  4096            /* Default */
+
+typedef enum {
+    AUDIO_ARCHIVE_F32 = 1,
+    AUDIO_ARCHIVE_I16 = 2,
+} audio_archive_format_t;
+
+typedef struct {
+    char     magic[4];          /* AUDIO_ARCHIVE_MAGIC */
+    uint32_t version;
+    uint32_t format;            /* audio_archive_format_t */
+    uint32_t frame_samples;     /* Sample capacity of every frame */
+    double   sample_rate;
+    double   start_utc;         /* Unix seconds of stream index 0 */
+    uint32_t header_bytes;
+    uint32_t frame_bytes;       /* Stride, header included */
+    char     source[24];        /* NUL-terminated, e.g. "digirig" */
+} audio_archive_header_t;
+
+typedef struct {
+    uint32_t magic;             /* AUDIO_ARCHIVE_FRAME_MAGIC */
+    uint32_t samples;           /* Valid samples in this frame */
+    uint64_t first_sample;      /* Stream index of the first */
+    double   utc;               /* Unix seconds of the first */
+    uint64_t dial_hz;           /* Rig dial frequency, 0 = unknown */
+} audio_archive_frame_t;
+
+/* ------------------------------------------------------------------ */
+/* Writer                                                              */
+/* ------------------------------------------------------------------ */
+
+typedef struct audio_archive_writer_t audio_archive_writer_t;
+
+/**
+ * Create (truncate) path and write the header.
+ *
+ * @param frame_samples  <= 0 for AUDIO_ARCHIVE_FRAME_SAMPLES
+ * @param source         Optional label
+ * @return NULL on bad arguments or I/O failure (errno set)
+ */
+audio_archive_writer_t *audio_archive_writer_open(const char *path, double sample_rate,
+                                                  audio_archive_format_t format,
+                                                  int frame_samples, double start_utc,
+                                                  const char *source);
+
+/**
+ * Append samples. Only whole frames reach the file; the one being
+ * filled is kept in memory until it is full or the writer closes.
+ *
+ * @param first_sample  Stream index of x[0]; anything but the index
+ *                      after the previous call starts a new frame
+ * @param dial_hz       Dial frequency; a change starts a new frame
+ * @return 0, or -1 on a write error (errno set)
+ */
+int audio_archive_write(audio_archive_writer_t *w, const float *x, int n,
+                        uint64_t first_sample, uint64_t dial_hz);
+
+/* Samples appended so far */
+uint64_t audio_archive_writer_samples(const audio_archive_writer_t *w);
+
+/**
+ * Write the partial frame, close the file and free the writer.
+ * @return 0, or -1 if a write or the close failed
+ */
+int audio_archive_writer_close(audio_archive_writer_t *w);
+
+/* ------------------------------------------------------------------ */
+/* Reader                                                              */
+/* ------------------------------------------------------------------ */
+
+typedef struct audio_archive_t audio_archive_t;
+
+/**
+ * Map a recording read-only. A truncated last frame (a recording cut
+ * off mid-write) is left out.
+ * @return NULL if the file cannot be mapped or is not an archive
+ */
+audio_archive_t *audio_archive_open(const char *path);
+
+const audio_archive_header_t *audio_archive_header(const audio_archive_t *a);
+
+/* Frames in the file */
+int audio_archive_frames(const audio_archive_t *a);
+
+/* Frame k's header; its samples follow it (format per the header) */
+const audio_archive_frame_t *audio_archive_frame(const audio_archive_t *a, int k);
+const void *audio_archive_frame_data(const audio_archive_t *a, int k);
+
+/* Stream index one past the last recorded sample */
+uint64_t audio_archive_end(const audio_archive_t *a);
+
+/* Stream index of the sample at a UTC time (may be past the end) */
+uint64_t audio_archive_index_at(const audio_archive_t *a, double utc);
+
+/**
+ * Copy stream indices [first, first + n) out as float. Samples that
+ * were not recorded (gaps, past the end) read as 0.
+ *
+ * @param dial_hz  Optional: dial frequency of the first recorded sample
+ *                 in the range, 0 if none
+ * @return Recorded samples in the range
+ */
+int audio_archive_read(const audio_archive_t *a, uint64_t first, float *out, int n,
+                       uint64_t *dial_hz);
+
+/* Unmap */
+void audio_archive_close(audio_archive_t *a);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUDIO_ARCHIVE_H */
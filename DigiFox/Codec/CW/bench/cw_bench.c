@@ -0,0 +1,828 @@
+/**
+ * cw_bench.c — Standalone benchmark for the C CW decoder core
+ *
+ * Synthesizes keyed CW (raised-cosine keying, white Gaussian noise at a
+ * given SNR in 2500 Hz) and times it through:
+ *
+ *   single   cw_decoder_process() in fixed-size blocks
+ *   q15      cw_decoder_process_s16() on the audio as int16, through the
+ *            fixed-point front end (CW_FILTER_Q15, with -q)
+ *   multi    cw_decode_multi() over N channels (same audio per channel)
+ *   skim-N   cw_skimmer_t on N signals at once (-k), found from spectrum
+ *            rows the bench computes outside the timing
+ *   ggmorse  ggmorse_wrapper_process_push() (when built with CW_BENCH_GGMORSE)
+ *   batch-N  ggmorse_wrapper_decode_batch() over the whole audio on
+ *            N = -B threads
+ *
+ * For every sample rate it reports channel-samples per second, real-time
+ * factor (audio seconds decoded per wall second, all channels), the
+ * per-stage cost from cw_stats_t and the character error rate of the
+ * decoded text. Each measurement is the best of -n repeats.
+ *
+ * With -A the audio is a recording (audio_archive.h) instead, replayed
+ * at its own rate; the decoded text is printed, and the CER is against
+ * -R text if given.
+ *
+ * Not part of the app target; see bench/Makefile.
+ */
+
+#include "audio_archive.h"
+#include "cw_decoder.h"
+#include "morse_table.h"
+#include "bench_synth.h"
+#ifdef CW_BENCH_GGMORSE
+#include "ggmorse_c_api.h"
+#endif
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define BENCH_MAX_RATES     8
+#define BENCH_MAX_CHANNELS  8
+#define BENCH_TEXT_LEN      8192
+#define BENCH_RAMP_S        0.005     /* Keying edge (raised cosine) */
+
+static const char *BENCH_MESSAGE =
+    "CQ CQ DE DL1ABC DL1ABC K DL1ABC DE W1AW GM UR RST 599 599 NAME JOHN "
+    "QTH BOSTON HW CPY 73 ";
+
+typedef struct {
+    float  wpm;
+    float  snr_db;
+    float  tone_hz;
+    double seconds;
+    int    block;
+    int    repeats;
+    int    envelope_mode;
+    int    timing_mode;
+    int    use_hmm;
+    int    detection_rate;
+    int    ggmorse;
+    int    no_squelch;
+    float  gm_window;           /* -W: ggmorse analysis window, s */
+    int    gm_step;             /* -G: ggmorse fine search step */
+    int    gm_half;             /* -F: ggmorse half-precision histories */
+    int    batch_threads;       /* -B: also decode ggmorse in batch */
+    int    skim_signals;        /* -k: also skim this many signals */
+    int    dead_air;
+    int    q15;
+    const char *archive;        /* Replay this recording instead */
+    const char *reference;      /* Its expected text, for the CER */
+
+    double rates[BENCH_MAX_RATES];
+    int    n_rates;
+    int    channels[BENCH_MAX_CHANNELS];
+    int    n_channels;
+} bench_opts_t;
+
+/* ------------------------------------------------------------------ */
+/* Signal synthesis                                                    */
+/* ------------------------------------------------------------------ */
+
+/* Character → pattern, recovered from the decoder's own table */
+static char s_patterns[128][8];
+
+static void build_patterns(void)
+{
+    char pat[8];
+    for (int len = 1; len <= 6; len++) {
+        for (int bits = 0; bits < (1 << len); bits++) {
+            for (int i = 0; i < len; i++) pat[i] = (bits >> i) & 1 ? '-' : '.';
+            pat[len] = '\0';
+            char ch = morse_lookup(pat);
+            if (ch != '?' && ch > ' ' && (unsigned char)ch < 128 && !s_patterns[(int)ch][0]) {
+                memcpy(s_patterns[(int)ch], pat, (size_t)len + 1);
+            }
+        }
+    }
+}
+
+/* Key-down intervals in dit units for text; returns the total length */
+static int key_text(const char *text, int *on, int *off, int max)
+{
+    int n = 0, t = 0;
+    for (const char *c = text; *c && n < max; c++) {
+        if (*c == ' ') {
+            t += 4;                         /* Word gap 7 = 3 + 4 */
+            continue;
+        }
+        const char *p = s_patterns[(int)(*c & 0x7f)];
+        for (; *p && n < max; p++) {
+            int len = (*p == '.') ? 1 : 3;
+            on[n] = t;
+            off[n] = t + len;
+            n++;
+            t += len + 1;
+        }
+        t += 2;                             /* Char gap 3 = 1 + 2 */
+    }
+    return n;
+}
+
+/*
+ * Repeat BENCH_MESSAGE until `seconds` of keying, then synthesize it.
+ * text receives the exact characters sent. With -z nothing is keyed:
+ * `seconds` of noise alone, text empty.
+ */
+static float *synth(const bench_opts_t *o, double fs, int *n_out, char *text)
+{
+    text[0] = '\0';
+    size_t msg = strlen(BENCH_MESSAGE);
+    double dit_s = 1.2 / o->wpm;
+    /* PARIS = 50 dits per word, ~6 characters incl. the space */
+    size_t want = (size_t)(o->seconds / (dit_s * 50.0) * 6.0);
+    size_t len = 0;
+    while (!o->dead_air && len + msg < BENCH_TEXT_LEN && len < want) {
+        memcpy(text + len, BENCH_MESSAGE, msg + 1);
+        len += msg;
+    }
+
+    int max_el = (int)len * 6;
+    int *on = (int *)malloc(sizeof(int) * (size_t)max_el);
+    int *off = (int *)malloc(sizeof(int) * (size_t)max_el);
+    int n_el = key_text(text, on, off, max_el);
+    int dits = n_el ? off[n_el - 1] + 7 : 7;
+
+    double dit = dit_s * fs;
+    int lead = (int)(0.5 * fs);
+    int n = o->dead_air ? (int)(o->seconds * fs) : lead + (int)(dits * dit) + (int)fs;
+    float *x = (float *)calloc((size_t)n, sizeof(float));
+
+    /* Tone at amplitude 0.5, keyed with raised-cosine edges */
+    double ramp = BENCH_RAMP_S * fs;
+    double w = 2.0 * M_PI * o->tone_hz / fs;
+    for (int e = 0; e < n_el; e++) {
+        int a = lead + (int)(on[e] * dit);
+        int b = lead + (int)(off[e] * dit);
+        for (int i = a; i < b && i < n; i++) {
+            double g = 1.0;
+            if (i - a < ramp) g = 0.5 - 0.5 * cos(M_PI * (i - a) / ramp);
+            if (b - i < ramp) g = 0.5 - 0.5 * cos(M_PI * (b - i) / ramp);
+            x[i] = (float)(0.5 * g * sin(w * i));
+        }
+    }
+
+    bench_add_noise(x, n, fs, 0.125, o->snr_db);
+
+    free(on);
+    free(off);
+    *n_out = n;
+    return x;
+}
+
+/* ------------------------------------------------------------------ */
+/* Scoring / timing                                                    */
+/* ------------------------------------------------------------------ */
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+/* Upper-case, collapse whitespace, trim */
+static void normalize(const char *in, char *out, size_t out_len)
+{
+    size_t j = 0;
+    int space = 1;
+    for (const char *c = in; *c && j + 1 < out_len; c++) {
+        char ch = *c;
+        if (ch >= 'a' && ch <= 'z') ch = (char)(ch - 'a' + 'A');
+        if (ch == ' ' || ch == '\n' || ch == '\t') {
+            if (!space) out[j++] = ' ';
+            space = 1;
+        } else {
+            out[j++] = ch;
+            space = 0;
+        }
+    }
+    while (j > 0 && out[j - 1] == ' ') j--;
+    out[j] = '\0';
+}
+
+/* Character error rate: Levenshtein distance / reference length */
+static double char_error_rate(const char *ref_raw, const char *hyp_raw)
+{
+    static char ref[BENCH_TEXT_LEN], hyp[BENCH_TEXT_LEN];
+    normalize(ref_raw, ref, sizeof(ref));
+    normalize(hyp_raw, hyp, sizeof(hyp));
+    int n = (int)strlen(ref), m = (int)strlen(hyp);
+    if (n == 0) return m ? 1.0 : 0.0;
+
+    int *prev = (int *)malloc(sizeof(int) * (size_t)(m + 1));
+    int *cur = (int *)malloc(sizeof(int) * (size_t)(m + 1));
+    for (int j = 0; j <= m; j++) prev[j] = j;
+    for (int i = 1; i <= n; i++) {
+        cur[0] = i;
+        for (int j = 1; j <= m; j++) {
+            int d = prev[j - 1] + (ref[i - 1] != hyp[j - 1]);
+            if (prev[j] + 1 < d) d = prev[j] + 1;
+            if (cur[j - 1] + 1 < d) d = cur[j - 1] + 1;
+            cur[j] = d;
+        }
+        int *t = prev; prev = cur; cur = t;
+    }
+    double cer = (double)prev[m] / (double)n;
+    free(prev);
+    free(cur);
+    return cer;
+}
+
+typedef struct {
+    double wall_s;              /* Best of the repeats */
+    double cer;                 /* NAN without a reference */
+    const char *text;           /* Decoded, single and ggmorse paths */
+    cw_stats_t stats;           /* Channel 0, from the fastest repeat */
+    int has_stats;
+} bench_result_t;
+
+static void print_result(const char *path, double fs, int n_ch, int n,
+                         const bench_result_t *r)
+{
+    double audio_s = (double)n / fs;
+    double msps = (double)n * n_ch / r->wall_s * 1e-6;
+    double rtf = audio_s * n_ch / r->wall_s;
+    printf("%8.1f  %-8s %4d  %9.2f  %10.0f", fs, path, n_ch, msps, rtf);
+    if (r->has_stats && r->stats.samples > 0) {
+        double s = 1.0 / (double)r->stats.samples;
+        printf("  %7.2f %7.2f %7.3f %7.3f",
+               r->stats.bandpass_ns * s, r->stats.envelope_ns * s,
+               r->stats.timing_ns * s, r->stats.pattern_ns * s);
+    } else {
+        printf("  %7s %7s %7s %7s", "-", "-", "-", "-");
+    }
+    if (isnan(r->cer)) printf("  %6s\n", "-");
+    else printf("  %5.1f%%\n", 100.0 * r->cer);
+}
+
+/* ------------------------------------------------------------------ */
+/* Paths                                                               */
+/* ------------------------------------------------------------------ */
+
+static void make_config(const bench_opts_t *o, double fs, cw_config_t *cfg)
+{
+    cw_config_init(cfg);
+    cfg->sample_rate = (int)fs;       /* 7812.5 Hz runs as 7812 */
+    cfg->center_freq = o->tone_hz;
+    cfg->envelope_mode = (cw_envelope_mode_t)o->envelope_mode;
+    cfg->timing_mode = (cw_timing_mode_t)o->timing_mode;
+    cfg->use_hmm = o->use_hmm;
+    cfg->detection_rate = o->detection_rate;
+    cfg->initial_wpm = o->wpm;
+    cfg->min_word_length = 1;
+    cfg->collect_stats = 1;
+}
+
+/* x16, if given, is x as int16 and goes through the Q15 front end */
+static int bench_single(const bench_opts_t *o, double fs, const float *x,
+                        const int16_t *x16, int n, const char *ref, bench_result_t *r)
+{
+    cw_config_t cfg;
+    make_config(o, fs, &cfg);
+    if (x16) cfg.filter_precision = CW_FILTER_Q15;
+    static char text[BENCH_TEXT_LEN];
+
+    r->wall_s = 1e30;
+    for (int rep = 0; rep < o->repeats; rep++) {
+        cw_decoder_t *dec = cw_decoder_create(&cfg);
+        if (!dec) return -1;
+        int w = 0;
+        double t0 = now_s();
+        for (int i = 0; i < n; i += o->block) {
+            int len = n - i < o->block ? n - i : o->block;
+            w += x16 ? cw_decoder_process_s16(dec, x16 + i, len, text + w, BENCH_TEXT_LEN - 1 - w)
+                     : cw_decoder_process(dec, x + i, len, text + w, BENCH_TEXT_LEN - 1 - w);
+        }
+        w += cw_decoder_finalize(dec, text + w, BENCH_TEXT_LEN - 1 - w);
+        double dt = now_s() - t0;
+        text[w] = '\0';
+        if (dt < r->wall_s) {
+            r->wall_s = dt;
+            cw_decoder_get_stats(dec, &r->stats);
+            r->has_stats = 1;
+        }
+        cw_decoder_destroy(dec);
+    }
+    r->cer = ref ? char_error_rate(ref, text) : NAN;
+    r->text = text;
+    return 0;
+}
+
+static int bench_multi(const bench_opts_t *o, double fs, const float *x, int n,
+                       int n_ch, const char *ref, bench_result_t *r)
+{
+    cw_config_t *cfgs = (cw_config_t *)calloc((size_t)n_ch, sizeof(cw_config_t));
+    const float **audio = (const float **)calloc((size_t)n_ch, sizeof(float *));
+    char **outs = (char **)calloc((size_t)n_ch, sizeof(char *));
+    char *text = (char *)calloc((size_t)n_ch, BENCH_TEXT_LEN);
+    if (!cfgs || !audio || !outs || !text) {
+        free(cfgs); free(audio); free(outs); free(text);
+        return -1;
+    }
+    for (int ch = 0; ch < n_ch; ch++) {
+        make_config(o, fs, &cfgs[ch]);
+        audio[ch] = x;
+        outs[ch] = text + (size_t)ch * BENCH_TEXT_LEN;
+    }
+
+    /* Batch call for the throughput figure */
+    r->wall_s = 1e30;
+    for (int rep = 0; rep < o->repeats; rep++) {
+        double t0 = now_s();
+        cw_decode_multi(cfgs, n_ch, audio, n, outs, BENCH_TEXT_LEN);
+        double dt = now_s() - t0;
+        if (dt < r->wall_s) r->wall_s = dt;
+    }
+    r->cer = ref ? char_error_rate(ref, outs[0]) : NAN;
+
+    /* Streaming engine once more for the per-stage split of channel 0 */
+    cw_multi_decoder_t *md = cw_multi_decoder_create(cfgs, n_ch);
+    int *counts = (int *)calloc((size_t)n_ch, sizeof(int));
+    if (md && counts) {
+        for (int i = 0; i < n; i += o->block) {
+            int len = n - i < o->block ? n - i : o->block;
+            for (int ch = 0; ch < n_ch; ch++) audio[ch] = x + i;
+            cw_multi_decoder_process(md, audio, len, outs, counts, BENCH_TEXT_LEN);
+        }
+        r->has_stats = (cw_multi_decoder_get_stats(md, 0, &r->stats) == 0);
+    }
+    cw_multi_decoder_destroy(md);
+    free(counts);
+    free(cfgs);
+    free(audio);
+    free(outs);
+    free(text);
+    return 0;
+}
+
+/*
+ * The skimmer gets n_sig signals 150 Hz apart (closer when they would
+ * leave 250-1150 Hz) around the tone, each at its own speed, one noise
+ * at the SNR of each. Its spectrum rows (6.25 Hz bins, Hann windows
+ * every half window) are computed beforehand, standing in for the
+ * app's shared spectrum. The CER averages the signals, each scored on
+ * the text of the slots that followed it.
+ */
+#define SKIM_MAX_SIGNALS 8
+
+static int bench_skimmer(const bench_opts_t *o, double fs, int n_sig, bench_result_t *r,
+                         int *n_out, int *found, int *spurious)
+{
+    if (n_sig > SKIM_MAX_SIGNALS) n_sig = SKIM_MAX_SIGNALS;
+    double spacing = fmin(150.0, 900.0 / n_sig);
+    float tones[SKIM_MAX_SIGNALS];
+    char *refs = (char *)calloc((size_t)n_sig, BENCH_TEXT_LEN);
+    char *texts = (char *)calloc((size_t)n_sig, BENCH_TEXT_LEN);
+    int lens[SKIM_MAX_SIGNALS] = { 0 };
+    if (!refs || !texts) {
+        free(refs); free(texts);
+        return -1;
+    }
+
+    /* Clean signals summed, then one noise */
+    float *x = NULL;
+    int n = 0;
+    for (int k = 0; k < n_sig; k++) {
+        bench_opts_t so = *o;
+        so.tone_hz = (float)(o->tone_hz + (k - 0.5 * (n_sig - 1)) * spacing);
+        so.wpm = o->wpm * (1.0f + 0.15f * (float)(k % 3));
+        so.snr_db = 300.0f;
+        so.dead_air = 0;
+        tones[k] = so.tone_hz;
+        int nk;
+        float *xk = synth(&so, fs, &nk, refs + (size_t)k * BENCH_TEXT_LEN);
+        if (!x) {
+            x = xk;
+            n = nk;
+            continue;
+        }
+        if (nk > n) {
+            float *t = x; x = xk; xk = t;
+            int tn = n; n = nk; nk = tn;
+        }
+        for (int i = 0; i < nk; i++) x[i] += xk[i];
+        free(xk);
+    }
+    bench_add_noise(x, n, fs, 0.125, o->snr_db);
+
+    int win = (int)lround(fs / 6.25), hop = win / 2;
+    int b1 = (int)(1250.0 / 6.25);
+    int n_rows = n >= win ? (n - win) / hop + 1 : 0;
+    float *rows = (float *)calloc((size_t)n_rows * (size_t)(b1 + 1), sizeof(float));
+    float *hann = (float *)malloc(sizeof(float) * (size_t)win);
+    if (!rows || !hann) {
+        free(refs); free(texts); free(x); free(rows); free(hann);
+        return -1;
+    }
+    for (int i = 0; i < win; i++) hann[i] = (float)(0.5 - 0.5 * cos(2.0 * M_PI * i / win));
+    for (int k = 0; k < n_rows; k++) {
+        const float *w = x + (size_t)k * hop;
+        for (int b = (int)(150.0 / 6.25); b <= b1; b++) {
+            double c = 2.0 * cos(2.0 * M_PI * b / win), s1 = 0.0, s2 = 0.0;
+            for (int i = 0; i < win; i++) {
+                double s0 = hann[i] * w[i] + c * s1 - s2;
+                s2 = s1;
+                s1 = s0;
+            }
+            rows[(size_t)k * (b1 + 1) + b] = (float)(s1 * s1 + s2 * s2 - c * s1 * s2);
+        }
+    }
+
+    cw_skimmer_config_t cfg;
+    cw_skimmer_config_init(&cfg);
+    make_config(o, fs, &cfg.decoder);
+    cfg.max_signals = SKIM_MAX_SIGNALS;
+    cfg.bin_hz = (float)(fs / win);
+    cfg.row_s = (float)(hop / fs);
+    cfg.f_min = 250.0f;
+    cfg.f_max = 1150.0f;
+    cfg.min_spacing = (float)(0.6 * spacing);
+    cfg.decoder.bandwidth = (float)fmin(cfg.decoder.bandwidth, 0.5 * spacing);
+
+    char *outs[SKIM_MAX_SIGNALS];
+    int counts[SKIM_MAX_SIGNALS];
+    static char slot_text[SKIM_MAX_SIGNALS][BENCH_TEXT_LEN];
+    for (int i = 0; i < SKIM_MAX_SIGNALS; i++) outs[i] = slot_text[i];
+
+    r->wall_s = 1e30;
+    for (int rep = 0; rep < o->repeats; rep++) {
+        cw_skimmer_t *sk = cw_skimmer_create(&cfg);
+        if (!sk) break;
+        int slot_tone[SKIM_MAX_SIGNALS];
+        uint32_t seen[64];
+        for (int s = 0; s < SKIM_MAX_SIGNALS; s++) slot_tone[s] = -1;
+        int n_seen = 0, n_spurious = 0;
+        memset(lens, 0, sizeof(lens));
+
+        int row = 0;
+        double busy = 0.0;
+        for (int i = 0; i < n; i += o->block) {
+            int len = n - i < o->block ? n - i : o->block;
+            double t0 = now_s();
+            for (; row < n_rows && (size_t)row * hop + win <= (size_t)(i + len); row++) {
+                cw_skimmer_feed_row(sk, rows + (size_t)row * (b1 + 1), b1 + 1);
+            }
+            cw_skimmer_process(sk, x + i, len, outs, counts, BENCH_TEXT_LEN);
+            busy += now_s() - t0;
+
+            /* Text to the nearest tone, bookkeeping outside the timing */
+            for (int s = 0; s < SKIM_MAX_SIGNALS; s++) {
+                cw_skimmer_signal_t sig;
+                cw_skimmer_get_signal(sk, s, &sig);
+                if (sig.active) {
+                    int best = 0;
+                    for (int k = 1; k < n_sig; k++) {
+                        if (fabsf(tones[k] - sig.freq) < fabsf(tones[best] - sig.freq)) best = k;
+                    }
+                    int known = 0;
+                    for (int j = 0; j < n_seen && !known; j++) known = seen[j] == sig.id;
+                    if (!known && n_seen < 64) {
+                        seen[n_seen++] = sig.id;
+                        n_spurious += fabsf(tones[best] - sig.freq) > 0.25 * spacing;
+                    }
+                    slot_tone[s] = fabsf(tones[best] - sig.freq) <= 0.25 * spacing ? best : -1;
+                }
+                int k = slot_tone[s];
+                if (counts[s] > 0 && k >= 0 && lens[k] + counts[s] < BENCH_TEXT_LEN) {
+                    memcpy(texts + (size_t)k * BENCH_TEXT_LEN + lens[k], outs[s], (size_t)counts[s]);
+                    lens[k] += counts[s];
+                }
+            }
+        }
+        if (busy < r->wall_s) r->wall_s = busy;
+        *found = n_seen - n_spurious;
+        *spurious = n_spurious;
+        cw_skimmer_destroy(sk);
+    }
+
+    double cer = 0.0;
+    for (int k = 0; k < n_sig; k++) {
+        texts[(size_t)k * BENCH_TEXT_LEN + lens[k]] = '\0';
+        cer += char_error_rate(refs + (size_t)k * BENCH_TEXT_LEN, texts + (size_t)k * BENCH_TEXT_LEN);
+    }
+    r->cer = cer / n_sig;
+    r->has_stats = 0;
+    *n_out = n;
+
+    free(refs); free(texts); free(x); free(rows); free(hann);
+    return r->wall_s < 1e30 ? 0 : -1;
+}
+
+#ifdef CW_BENCH_GGMORSE
+/*
+ * ggmorse takes the blocks through the push entry point, which keeps a
+ * partial frame for the next call.
+ */
+static int bench_ggmorse(const bench_opts_t *o, double fs, const float *x, int n,
+                         const char *ref, bench_result_t *r)
+{
+    static char text[BENCH_TEXT_LEN];
+    int block = o->block;
+
+    r->wall_s = 1e30;
+    for (int rep = 0; rep < o->repeats; rep++) {
+        ggmorse_wrapper *gm = ggmorse_wrapper_create((float)fs, 0);
+        if (!gm) break;
+        if (o->no_squelch) ggmorse_wrapper_set_squelch(gm, 0);
+        if (o->gm_half) ggmorse_wrapper_set_half_history(gm, 1);
+        if (o->gm_window > 0) ggmorse_wrapper_set_window(gm, o->gm_window, 0);
+        if (o->gm_step > 1) ggmorse_wrapper_set_search_step(gm, o->gm_step);
+        int w = 0;
+        double t0 = now_s();
+        for (int i = 0; i < n; i += block) {
+            int len = n - i < block ? n - i : block;
+            w += ggmorse_wrapper_process_push(gm, x + i, len, text + w, BENCH_TEXT_LEN - 1 - w);
+        }
+        double dt = now_s() - t0;
+        text[w] = '\0';
+        if (dt < r->wall_s) r->wall_s = dt;
+        ggmorse_wrapper_destroy(gm);
+    }
+
+    if (r->wall_s >= 1e30) return -1;
+    r->cer = ref ? char_error_rate(ref, text) : NAN;
+    r->text = text;
+    r->has_stats = 0;
+    return 0;
+}
+
+static const char *batch_label(const bench_opts_t *o)
+{
+    static char label[16];
+    snprintf(label, sizeof(label), "batch-%d", o->batch_threads);
+    return label;
+}
+
+/* The whole audio in one ggmorse_wrapper_decode_batch() call */
+static int bench_ggmorse_batch(const bench_opts_t *o, double fs, const float *x, int n,
+                               const char *ref, bench_result_t *r)
+{
+    static char text[BENCH_TEXT_LEN];
+
+    r->wall_s = 1e30;
+    for (int rep = 0; rep < o->repeats; rep++) {
+        ggmorse_wrapper *gm = ggmorse_wrapper_create((float)fs, 0);
+        if (!gm) break;
+        if (o->no_squelch) ggmorse_wrapper_set_squelch(gm, 0);
+        if (o->gm_half) ggmorse_wrapper_set_half_history(gm, 1);
+        if (o->gm_window > 0) ggmorse_wrapper_set_window(gm, o->gm_window, 0);
+        if (o->gm_step > 1) ggmorse_wrapper_set_search_step(gm, o->gm_step);
+        double t0 = now_s();
+        ggmorse_wrapper_decode_batch(gm, x, n, o->batch_threads, text, BENCH_TEXT_LEN);
+        double dt = now_s() - t0;
+        if (dt < r->wall_s) r->wall_s = dt;
+        ggmorse_wrapper_destroy(gm);
+    }
+
+    if (r->wall_s >= 1e30) return -1;
+    r->cer = ref ? char_error_rate(ref, text) : NAN;
+    r->text = text;
+    r->has_stats = 0;
+    return 0;
+}
+#endif
+
+/* ------------------------------------------------------------------ */
+/* Replay                                                              */
+/* ------------------------------------------------------------------ */
+
+/* The recording's audio from its first sample, gaps as silence */
+static float *load_archive(const bench_opts_t *o, double *fs, int *n_out)
+{
+    audio_archive_t *a = audio_archive_open(o->archive);
+    if (!a) {
+        fprintf(stderr, "%s: not a recording\n", o->archive);
+        return NULL;
+    }
+    const audio_archive_header_t *h = audio_archive_header(a);
+    uint64_t first = audio_archive_frames(a) > 0 ? audio_archive_frame(a, 0)->first_sample : 0;
+    uint64_t n = audio_archive_end(a) - first;
+
+    float *x = (float *)malloc((size_t)(n ? n : 1) * sizeof(float));
+    if (x) {
+        uint64_t dial;
+        audio_archive_read(a, first, x, (int)n, &dial);
+        printf("%s: %s, %.1f Hz, %.1f s, %d frames, dial %llu Hz\n", o->archive,
+               h->format == AUDIO_ARCHIVE_I16 ? "int16" : "float", h->sample_rate,
+               (double)n / h->sample_rate, audio_archive_frames(a), (unsigned long long)dial);
+    }
+    *fs = h->sample_rate;
+    *n_out = (int)n;
+    audio_archive_close(a);
+    return x;
+}
+
+static int replay(const bench_opts_t *o)
+{
+    double fs;
+    int n;
+    float *x = load_archive(o, &fs, &n);
+    if (!x) return 1;
+    const char *ref = o->reference;
+
+    printf("%8s  %-8s %4s  %9s  %10s  %7s %7s %7s %7s  %6s\n",
+           "rate", "path", "ch", "Msamp/s", "x realtime",
+           "front", "env", "timing", "pattern", "CER");
+    bench_result_t single, gm, batch;
+    memset(&single, 0, sizeof(single));
+    memset(&gm, 0, sizeof(gm));
+    memset(&batch, 0, sizeof(batch));
+    if (bench_single(o, fs, x, NULL, n, ref, &single) == 0) print_result("single", fs, 1, n, &single);
+#ifdef CW_BENCH_GGMORSE
+    if (o->ggmorse && bench_ggmorse(o, fs, x, n, ref, &gm) == 0) print_result("ggmorse", fs, 1, n, &gm);
+    if (o->batch_threads && bench_ggmorse_batch(o, fs, x, n, ref, &batch) == 0) {
+        print_result(batch_label(o), fs, 1, n, &batch);
+    }
+#endif
+    if (single.text) printf("single:  %s\n", single.text);
+    if (gm.text) printf("ggmorse: %s\n", gm.text);
+    if (batch.text) printf("batch:   %s\n", batch.text);
+    free(x);
+    return 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* Main                                                                */
+/* ------------------------------------------------------------------ */
+
+static int parse_list_d(const char *s, double *out, int max)
+{
+    int n = 0;
+    while (*s && n < max) {
+        char *end;
+        double v = strtod(s, &end);
+        if (end == s) break;
+        out[n++] = v;
+        s = (*end == ',') ? end + 1 : end;
+    }
+    return n;
+}
+
+static int parse_list_i(const char *s, int *out, int max)
+{
+    double v[BENCH_MAX_CHANNELS];
+    int n = parse_list_d(s, v, max < BENCH_MAX_CHANNELS ? max : BENCH_MAX_CHANNELS);
+    for (int i = 0; i < n; i++) out[i] = (int)v[i];
+    return n;
+}
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr,
+        "usage: %s [options]\n"
+        "  -w wpm        keying speed (20)\n"
+        "  -s snr_db     SNR in 2500 Hz (10)\n"
+        "  -f tone_hz    tone frequency (700)\n"
+        "  -t seconds    audio length per run (60)\n"
+        "  -r rates      sample rates, comma list (6250,7812.5,12000,48000)\n"
+        "  -c channels   channel counts for cw_decode_multi (1,4,16)\n"
+        "  -b block      samples per process call (512)\n"
+        "  -n repeats    best-of count (3)\n"
+        "  -e mode       envelope: 0 iir, 1 multipass, 2 quadrature, 3 sdft (1)\n"
+        "  -m mode       timing: 0 ema, 1 kalman (1)\n"
+        "  -H            classify through the duration HMM\n"
+        "  -d rate       detection rate in Hz (0 = sample rate)\n"
+        "  -q            also run the Q15 fixed-point path\n"
+        "  -g            also run ggmorse (needs a GGMORSE=1 build)\n"
+        "  -S            ggmorse without its squelch\n"
+        "  -W seconds    ggmorse analysis window, 1-3 (3)\n"
+        "  -G step       ggmorse fine search step, 1-2 (1)\n"
+        "  -F            ggmorse histories in half precision\n"
+        "  -B threads    also decode ggmorse in batch on this many threads\n"
+        "  -k signals    also skim this many signals at once (up to 8)\n"
+        "  -z            dead air: noise only, nothing keyed\n"
+        "  -A file       replay a recording (.dfxa) instead of synthesizing\n"
+        "  -R text       expected text of the recording, for the CER\n",
+        argv0);
+}
+
+int main(int argc, char **argv)
+{
+    bench_opts_t o = {
+        .wpm = 20.0f, .snr_db = 10.0f, .tone_hz = 700.0f, .seconds = 60.0,
+        .block = 512, .repeats = 3, .envelope_mode = CW_ENVELOPE_MULTIPASS,
+        .timing_mode = CW_TIMING_KALMAN,
+        .rates = { 6250.0, 7812.5, 12000.0, 48000.0 }, .n_rates = 4,
+        .channels = { 1, 4, 16 }, .n_channels = 3,
+    };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "w:s:f:t:r:c:b:n:e:m:Hd:qgSW:G:FB:k:zA:R:h")) != -1) {
+        switch (opt) {
+        case 'w': o.wpm = (float)atof(optarg); break;
+        case 's': o.snr_db = (float)atof(optarg); break;
+        case 'f': o.tone_hz = (float)atof(optarg); break;
+        case 't': o.seconds = atof(optarg); break;
+        case 'r': o.n_rates = parse_list_d(optarg, o.rates, BENCH_MAX_RATES); break;
+        case 'c': o.n_channels = parse_list_i(optarg, o.channels, BENCH_MAX_CHANNELS); break;
+        case 'b': o.block = atoi(optarg); break;
+        case 'n': o.repeats = atoi(optarg); break;
+        case 'e': o.envelope_mode = atoi(optarg); break;
+        case 'm': o.timing_mode = atoi(optarg); break;
+        case 'H': o.use_hmm = 1; break;
+        case 'd': o.detection_rate = atoi(optarg); break;
+        case 'q': o.q15 = 1; break;
+        case 'g': o.ggmorse = 1; break;
+        case 'S': o.no_squelch = 1; break;
+        case 'W': o.gm_window = (float)atof(optarg); break;
+        case 'G': o.gm_step = atoi(optarg); break;
+        case 'F': o.gm_half = 1; break;
+        case 'B': o.batch_threads = atoi(optarg); break;
+        case 'k': o.skim_signals = atoi(optarg); break;
+        case 'z': o.dead_air = 1; break;
+        case 'A': o.archive = optarg; break;
+        case 'R': o.reference = optarg; break;
+        default: usage(argv[0]); return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (o.wpm <= 0.0f || o.seconds <= 0.0 || o.block <= 0 || o.repeats <= 0 ||
+        o.n_rates <= 0) {
+        usage(argv[0]);
+        return 2;
+    }
+#ifndef CW_BENCH_GGMORSE
+    if (o.ggmorse || o.batch_threads) {
+        fprintf(stderr, "ggmorse not built in (make GGMORSE=1)\n");
+        o.ggmorse = 0;
+        o.batch_threads = 0;
+    }
+#endif
+
+    build_patterns();
+    if (o.archive) return replay(&o);
+    printf("CW decoder benchmark: %.0f WPM, SNR %.1f dB, tone %.0f Hz, %.0f s, "
+           "block %d, best of %d\n",
+           o.wpm, o.snr_db, o.tone_hz, o.seconds, o.block, o.repeats);
+    printf("%8s  %-8s %4s  %9s  %10s  %7s %7s %7s %7s  %6s\n",
+           "rate", "path", "ch", "Msamp/s", "x realtime",
+           "front", "env", "timing", "pattern", "CER");
+    printf("%49s(ns per sample per channel)\n", "");
+
+    static char ref[BENCH_TEXT_LEN];
+    for (int ri = 0; ri < o.n_rates; ri++) {
+        double fs = o.rates[ri];
+        int n;
+        float *x = synth(&o, fs, &n, ref);
+        if (!x) return 1;
+
+        bench_result_t r;
+        memset(&r, 0, sizeof(r));
+        if (bench_single(&o, fs, x, NULL, n, ref, &r) == 0) print_result("single", fs, 1, n, &r);
+
+        if (o.q15) {
+            int16_t *x16 = (int16_t *)malloc((size_t)n * sizeof(int16_t));
+            if (!x16) return 1;
+            /* Scaled to fit, as an int16 source would deliver it */
+            float peak = 1.0f;
+            for (int i = 0; i < n; i++) peak = fmaxf(peak, fabsf(x[i]));
+            for (int i = 0; i < n; i++) x16[i] = (int16_t)lrintf(x[i] * (32767.0f / peak));
+            memset(&r, 0, sizeof(r));
+            if (bench_single(&o, fs, x, x16, n, ref, &r) == 0) print_result("q15", fs, 1, n, &r);
+            free(x16);
+        }
+
+        for (int ci = 0; ci < o.n_channels; ci++) {
+            memset(&r, 0, sizeof(r));
+            if (o.channels[ci] > 0 &&
+                bench_multi(&o, fs, x, n, o.channels[ci], ref, &r) == 0) {
+                print_result("multi", fs, o.channels[ci], n, &r);
+            }
+        }
+
+        if (o.skim_signals > 0) {
+            int n_skim, found = 0, spurious = 0;
+            char label[16];
+            memset(&r, 0, sizeof(r));
+            if (bench_skimmer(&o, fs, o.skim_signals, &r, &n_skim, &found, &spurious) == 0) {
+                int n_sig = o.skim_signals < SKIM_MAX_SIGNALS ? o.skim_signals : SKIM_MAX_SIGNALS;
+                snprintf(label, sizeof(label), "skim-%d", n_sig);
+                print_result(label, fs, n_sig, n_skim, &r);
+                printf("%49s(%d signals found, %d spurious)\n", "", found, spurious);
+            }
+        }
+
+#ifdef CW_BENCH_GGMORSE
+        if (o.ggmorse) {
+            memset(&r, 0, sizeof(r));
+            if (bench_ggmorse(&o, fs, x, n, ref, &r) == 0) print_result("ggmorse", fs, 1, n, &r);
+        }
+        if (o.batch_threads) {
+            memset(&r, 0, sizeof(r));
+            if (bench_ggmorse_batch(&o, fs, x, n, ref, &r) == 0) {
+                print_result(batch_label(&o), fs, 1, n, &r);
+            }
+        }
+#endif
+        free(x);
+    }
+    return 0;
+}
@@ -0,0 +1,261 @@
+/**
+ * channel_bank.c — Shared-input quadrature filter bank
+ *
+ * Same output definition as quadrature.c, per channel c:
+ *
+ *   y_c = e^{-j w_c n0} · sum_k p[k] e^{-j w k} h[k]
+ *
+ * FFT path: w is the nearest bin 2·pi·m/M, so one M-point FFT of p[k]·h[k]
+ * serves every channel. The window is at least 8 output samples long, so
+ * bins are at most out_rate / 16 from the tone — well inside the
+ * prototype passband (out_rate / 4). The leading phasor uses w_c itself,
+ * which also shifts that residual offset to 0 Hz.
+ *
+ * Direct path: w = w_c with per-channel modulated taps (bit-identical to
+ * quadrature_process()).
+ */
+
+#include "channel_bank.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* Re-normalize the low-rate phasors this often (outputs) */
+#define BANK_RENORM_INTERVAL 1024
+
+/* ------------------------------------------------------------------ */
+/* Radix-2 FFT (in-place, input in bit-reversed order)                 */
+/* ------------------------------------------------------------------ */
+
+static void fft_radix2(float *re, float *im, int n,
+                       const float *tw_re, const float *tw_im)
+{
+    for (int len = 2; len <= n; len <<= 1) {
+        int half = len >> 1;
+        int step = n / len;
+        for (int i = 0; i < n; i += len) {
+            for (int j = 0; j < half; j++) {
+                float wr = tw_re[j * step];
+                float wi = tw_im[j * step];
+                int a = i + j;
+                int b = a + half;
+                float xr = re[b] * wr - im[b] * wi;
+                float xi = re[b] * wi + im[b] * wr;
+                re[b] = re[a] - xr;
+                im[b] = im[a] - xi;
+                re[a] += xr;
+                im[a] += xi;
+            }
+        }
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Init / free                                                         */
+/* ------------------------------------------------------------------ */
+
+int channel_bank_init(channel_bank_t *b, int sample_rate, int factor,
+                      const float *freqs, int n_ch, float bandwidth, int max_in)
+{
+    memset(b, 0, sizeof(*b));
+    if (n_ch <= 0) return -1;
+    if (factor < 2) factor = 2;
+
+    b->n_ch = n_ch;
+    decimator_init(&b->dec, factor);
+    int nt = b->dec.n_taps;
+    factor = b->dec.factor;
+
+    int m = 1, log2m = 0;
+    while (m < nt) { m <<= 1; log2m++; }
+    b->fft_size = m;
+
+    /* Multiply-adds per output step */
+    long cost_direct = (long)n_ch * 2 * nt;
+    long cost_fft = nt + 3L * m * log2m + n_ch;
+    b->use_fft = (cost_fft < cost_direct);
+
+    b->stride = max_in / factor + 1;
+
+    b->rot_re  = (float *)calloc((size_t)n_ch, sizeof(float));
+    b->rot_im  = (float *)calloc((size_t)n_ch, sizeof(float));
+    b->step_re = (float *)calloc((size_t)n_ch, sizeof(float));
+    b->step_im = (float *)calloc((size_t)n_ch, sizeof(float));
+    b->lpf_i = (iir_filter_t *)calloc((size_t)n_ch, sizeof(iir_filter_t));
+    b->lpf_q = (iir_filter_t *)calloc((size_t)n_ch, sizeof(iir_filter_t));
+    b->bb_i = (float *)calloc((size_t)n_ch * b->stride, sizeof(float));
+    b->bb_q = (float *)calloc((size_t)n_ch * b->stride, sizeof(float));
+    if (!b->rot_re || !b->rot_im || !b->step_re || !b->step_im ||
+        !b->lpf_i || !b->lpf_q || !b->bb_i || !b->bb_q) {
+        channel_bank_free(b);
+        return -1;
+    }
+
+    if (b->use_fft) {
+        b->tw_re  = (float *)calloc((size_t)m / 2, sizeof(float));
+        b->tw_im  = (float *)calloc((size_t)m / 2, sizeof(float));
+        b->bitrev = (int *)calloc((size_t)m, sizeof(int));
+        b->blk_re = (float *)calloc((size_t)m, sizeof(float));
+        b->blk_im = (float *)calloc((size_t)m, sizeof(float));
+        b->bin    = (int *)calloc((size_t)n_ch, sizeof(int));
+        if (!b->tw_re || !b->tw_im || !b->bitrev || !b->blk_re ||
+            !b->blk_im || !b->bin) {
+            channel_bank_free(b);
+            return -1;
+        }
+        for (int j = 0; j < m / 2; j++) {
+            b->tw_re[j] = (float)cos(2.0 * M_PI * j / m);
+            b->tw_im[j] = (float)-sin(2.0 * M_PI * j / m);
+        }
+        for (int k = 0; k < m; k++) {
+            int r = 0;
+            for (int bit = 0; bit < log2m; bit++) {
+                if (k & (1 << bit)) r |= 1 << (log2m - 1 - bit);
+            }
+            b->bitrev[k] = r;
+        }
+    } else {
+        b->taps_i = (float *)calloc((size_t)n_ch * nt, sizeof(float));
+        b->taps_q = (float *)calloc((size_t)n_ch * nt, sizeof(float));
+        if (!b->taps_i || !b->taps_q) {
+            channel_bank_free(b);
+            return -1;
+        }
+    }
+
+    float rate = (float)sample_rate / (float)factor;
+    float cutoff = bandwidth > 0.0f ? 0.5f * bandwidth : 50.0f;
+    if (cutoff > 0.45f * rate) cutoff = 0.45f * rate;
+
+    for (int c = 0; c < n_ch; c++) {
+        double w = 2.0 * M_PI * (double)freqs[c] / (double)sample_rate;
+
+        if (b->use_fft) {
+            int bin = (int)floor(w / (2.0 * M_PI) * m + 0.5);
+            if (bin < 0) bin = 0;
+            if (bin > m / 2) bin = m / 2;
+            b->bin[c] = bin;
+        } else {
+            for (int k = 0; k < nt; k++) {
+                b->taps_i[c * nt + k] = (float)((double)b->dec.taps[k] * cos(w * k));
+                b->taps_q[c * nt + k] = (float)(-(double)b->dec.taps[k] * sin(w * k));
+            }
+        }
+
+        b->step_re[c] = (float)cos(w * factor);
+        b->step_im[c] = (float)-sin(w * factor);
+        b->rot_re[c] = 1.0f;
+
+        iir_design_lowpass(&b->lpf_i[c], 2, cutoff, rate);
+        iir_design_lowpass(&b->lpf_q[c], 2, cutoff, rate);
+    }
+    return 0;
+}
+
+void channel_bank_free(channel_bank_t *b)
+{
+    free(b->tw_re);
+    free(b->tw_im);
+    free(b->bitrev);
+    free(b->blk_re);
+    free(b->blk_im);
+    free(b->bin);
+    free(b->taps_i);
+    free(b->taps_q);
+    free(b->rot_re);
+    free(b->rot_im);
+    free(b->step_re);
+    free(b->step_im);
+    free(b->lpf_i);
+    free(b->lpf_q);
+    free(b->bb_i);
+    free(b->bb_q);
+    memset(b, 0, sizeof(*b));
+}
+
+/* ------------------------------------------------------------------ */
+/* Process                                                             */
+/* ------------------------------------------------------------------ */
+
+/* Apply channel c's leading phasor to z and advance it */
+static inline void rotate_store(channel_bank_t *b, int c, int j, float zi, float zq)
+{
+    float rr = b->rot_re[c], ri = b->rot_im[c];
+    b->bb_i[c * b->stride + j] = rr * zi - ri * zq;
+    b->bb_q[c * b->stride + j] = rr * zq + ri * zi;
+    b->rot_re[c] = rr * b->step_re[c] - ri * b->step_im[c];
+    b->rot_im[c] = rr * b->step_im[c] + ri * b->step_re[c];
+}
+
+int channel_bank_process(channel_bank_t *b, const float *in, int n,
+                         float *out, int out_stride)
+{
+    decimator_t *d = &b->dec;
+    int nt = d->n_taps;
+    int m = 0;
+
+    for (int i = 0; i < n; i++) {
+        const float *h = decimator_push(d, in[i]);
+        if (!h) continue;
+
+        if (b->use_fft) {
+            /* Window once, one FFT for every channel */
+            int size = b->fft_size;
+            memset(b->blk_re, 0, (size_t)size * sizeof(float));
+            memset(b->blk_im, 0, (size_t)size * sizeof(float));
+            for (int k = 0; k < nt; k++) {
+                b->blk_re[b->bitrev[k]] = d->taps[k] * h[k];
+            }
+            fft_radix2(b->blk_re, b->blk_im, size, b->tw_re, b->tw_im);
+            for (int c = 0; c < b->n_ch; c++) {
+                rotate_store(b, c, m, b->blk_re[b->bin[c]], b->blk_im[b->bin[c]]);
+            }
+        } else {
+            for (int c = 0; c < b->n_ch; c++) {
+                float zi = decimator_dot(b->taps_i + c * nt, h, nt);
+                float zq = decimator_dot(b->taps_q + c * nt, h, nt);
+                rotate_store(b, c, m, zi, zq);
+            }
+        }
+
+        if (++b->n_out == BANK_RENORM_INTERVAL) {
+            for (int c = 0; c < b->n_ch; c++) {
+                float g = 1.0f / sqrtf(b->rot_re[c] * b->rot_re[c] +
+                                       b->rot_im[c] * b->rot_im[c]);
+                b->rot_re[c] *= g;
+                b->rot_im[c] *= g;
+            }
+            b->n_out = 0;
+        }
+        m++;
+    }
+
+    /* Channel filter + magnitude */
+    for (int c = 0; c < b->n_ch; c++) {
+        float *bi = b->bb_i + c * b->stride;
+        float *bq = b->bb_q + c * b->stride;
+        float *y = out + c * out_stride;
+        iir_filter_process(&b->lpf_i[c], bi, m);
+        iir_filter_process(&b->lpf_q[c], bq, m);
+        for (int j = 0; j < m; j++) {
+            y[j] = sqrtf(bi[j] * bi[j] + bq[j] * bq[j]);
+        }
+    }
+    return m;
+}
+
+void channel_bank_reset(channel_bank_t *b)
+{
+    decimator_reset(&b->dec);
+    b->n_out = 0;
+    for (int c = 0; c < b->n_ch; c++) {
+        b->rot_re[c] = 1.0f;
+        b->rot_im[c] = 0.0f;
+        iir_filter_reset(&b->lpf_i[c]);
+        iir_filter_reset(&b->lpf_q[c]);
+    }
+}
@@ -0,0 +1,88 @@
+/**
+ * channel_bank.h — Shared-input quadrature filter bank
+ *
+ * Splits one audio stream into N baseband channels at arbitrary center
+ * frequencies (same front end as quadrature.h, one input ring for all).
+ *
+ * Each output step windows the shared ring with the prototype lowpass
+ * once. Channels are then taken either from an FFT of the windowed block
+ * (nearest bin, cost independent of N) or from per-channel modulated
+ * taps (2 · n_taps per channel), whichever is cheaper for N. The residual
+ * offset from the bin center and the channel phase are removed at the
+ * decimated rate, followed by the ±bandwidth/2 channel lowpass.
+ *
+ * All memory is allocated in channel_bank_init().
+ */
+
+#ifndef CHANNEL_BANK_H
+#define CHANNEL_BANK_H
+
+#include "decimator.h"
+#include "iir_filter.h"
+
+typedef struct {
+    int n_ch;
+    int use_fft;              /* FFT bins vs. per-channel taps */
+
+    /* Shared input ring + prototype taps */
+    decimator_t dec;
+
+    /* FFT path: size, twiddles, bit reversal, work block, bin per channel */
+    int    fft_size;
+    float *tw_re, *tw_im;     /* fft_size / 2 */
+    int   *bitrev;            /* fft_size */
+    float *blk_re, *blk_im;   /* fft_size */
+    int   *bin;               /* n_ch */
+
+    /* Direct path: n_ch * n_taps modulated taps */
+    float *taps_i, *taps_q;
+
+    /* Per-channel low-rate phasor */
+    float *rot_re, *rot_im;
+    float *step_re, *step_im;
+    int    n_out;
+
+    /* Per-channel ±bandwidth/2 lowpass */
+    iir_filter_t *lpf_i, *lpf_q;
+
+    /* Baseband staging, n_ch * stride each */
+    int    stride;
+    float *bb_i, *bb_q;
+} channel_bank_t;
+
+/**
+ * Initialize the bank.
+ *
+ * @param b            Output struct
+ * @param sample_rate  Input sample rate in Hz
+ * @param factor       Decimation factor (>= 2)
+ * @param freqs        Center frequency per channel in Hz
+ * @param n_ch         Number of channels
+ * @param bandwidth    Channel width in Hz
+ * @param max_in       Largest input block passed to process()
+ * @return 0 on success, -1 on allocation failure (b is then freed)
+ */
+int channel_bank_init(channel_bank_t *b, int sample_rate, int factor,
+                      const float *freqs, int n_ch, float bandwidth, int max_in);
+
+/**
+ * Run one input block through the bank.
+ * Channel c's magnitudes are written to out[c * out_stride + j].
+ *
+ * @param n  Input samples (<= max_in)
+ * @return Output samples per channel
+ */
+int channel_bank_process(channel_bank_t *b, const float *in, int n,
+                         float *out, int out_stride);
+
+/**
+ * Reset bank state.
+ */
+void channel_bank_reset(channel_bank_t *b);
+
+/**
+ * Free bank memory.
+ */
+void channel_bank_free(channel_bank_t *b);
+
+#endif /* CHANNEL_BANK_H */
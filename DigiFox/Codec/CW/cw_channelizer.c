@@ -0,0 +1,132 @@
+/**
+ * cw_channelizer.c — Many CW tones from one audio stream
+ *
+ * One channel_bank_t replaces the per-channel quadrature front ends: the
+ * shared input ring is windowed once per output step and every channel
+ * is read from it. The resulting per-channel magnitudes are handed to
+ * the lane-parallel multi-channel engine (cw_multi.c), which runs the
+ * envelope, timing, pattern and output stages exactly as for
+ * cw_multi_decoder_process() with CW_ENVELOPE_QUADRATURE channels.
+ */
+
+#include "cw_decoder.h"
+#include "cw_multi.h"
+#include "channel_bank.h"
+#include <stdlib.h>
+
+struct cw_channelizer_t {
+    cw_multi_decoder_t *md;
+    channel_bank_t bank;
+    float *front;              /* n_ch * CW_MULTI_BLOCK magnitudes */
+    const float **audio;       /* n_ch pointers, all to the shared block */
+};
+
+/* ------------------------------------------------------------------ */
+/* Create / destroy                                                    */
+/* ------------------------------------------------------------------ */
+
+cw_channelizer_t *cw_channelizer_create(const cw_config_t *cfg,
+                                        const float *center_freqs, int n_ch)
+{
+    if (!cfg || !center_freqs || n_ch <= 0) return NULL;
+
+    cw_channelizer_t *cz = (cw_channelizer_t *)calloc(1, sizeof(cw_channelizer_t));
+    if (!cz) return NULL;
+
+    cw_config_t *cfgs = (cw_config_t *)calloc((size_t)n_ch, sizeof(cw_config_t));
+    if (!cfgs) {
+        free(cz);
+        return NULL;
+    }
+    for (int ch = 0; ch < n_ch; ch++) {
+        cfgs[ch] = *cfg;
+        cfgs[ch].center_freq = center_freqs[ch];
+        cfgs[ch].envelope_mode = CW_ENVELOPE_QUADRATURE;
+    }
+    cz->md = cw_multi_decoder_create(cfgs, n_ch);
+    free(cfgs);
+    if (!cz->md) {
+        free(cz);
+        return NULL;
+    }
+
+    /* Every channel shares the decimation factor, so any one will do */
+    int factor = cz->md->chans[0]->quad->dec.factor;
+    if (channel_bank_init(&cz->bank, cfg->sample_rate, factor, center_freqs,
+                          n_ch, cfg->bandwidth, CW_MULTI_BLOCK) != 0) {
+        cw_multi_decoder_destroy(cz->md);
+        free(cz);
+        return NULL;
+    }
+
+    cz->front = (float *)calloc((size_t)n_ch * CW_MULTI_BLOCK, sizeof(float));
+    cz->audio = (const float **)calloc((size_t)n_ch, sizeof(const float *));
+    if (!cz->front || !cz->audio) {
+        cw_channelizer_destroy(cz);
+        return NULL;
+    }
+    return cz;
+}
+
+void cw_channelizer_destroy(cw_channelizer_t *cz)
+{
+    if (!cz) return;
+    cw_multi_decoder_destroy(cz->md);
+    channel_bank_free(&cz->bank);
+    free(cz->front);
+    free(cz->audio);
+    free(cz);
+}
+
+/* ------------------------------------------------------------------ */
+/* Process                                                             */
+/* ------------------------------------------------------------------ */
+
+int cw_channelizer_process(cw_channelizer_t *cz, const float *audio, int n,
+                           char **out_bufs, int *out_counts, int out_len)
+{
+    if (!cz || !audio || !out_bufs || !out_counts) return -1;
+
+    cw_multi_decoder_t *md = cz->md;
+    for (int ch = 0; ch < md->n_ch; ch++) out_counts[ch] = 0;
+    if (n <= 0 || out_len <= 0) return 0;
+
+    /* Channels read the bank output, not audio[] (kept for the block API) */
+    for (int ch = 0; ch < md->n_ch; ch++) cz->audio[ch] = audio;
+
+    for (int offset = 0; offset < n; offset += CW_MULTI_BLOCK) {
+        int len = n - offset;
+        if (len > CW_MULTI_BLOCK) len = CW_MULTI_BLOCK;
+
+        md->front_len = channel_bank_process(&cz->bank, audio + offset, len,
+                                             cz->front, CW_MULTI_BLOCK);
+        md->front = cz->front;
+        cw_multi_process_block(md, cz->audio, offset, len,
+                               out_bufs, out_counts, out_len);
+        md->front = NULL;
+    }
+    return 0;
+}
+
+int cw_channelizer_finalize(cw_channelizer_t *cz,
+                            char **out_bufs, int *out_counts, int out_len)
+{
+    if (!cz) return -1;
+    return cw_multi_decoder_finalize(cz->md, out_bufs, out_counts, out_len);
+}
+
+/* ------------------------------------------------------------------ */
+/* Accessors                                                           */
+/* ------------------------------------------------------------------ */
+
+float cw_channelizer_get_wpm(const cw_channelizer_t *cz, int ch)
+{
+    return cz ? cw_multi_decoder_get_wpm(cz->md, ch) : 0.0f;
+}
+
+void cw_channelizer_reset(cw_channelizer_t *cz)
+{
+    if (!cz) return;
+    cw_multi_decoder_reset(cz->md);
+    channel_bank_reset(&cz->bank);
+}
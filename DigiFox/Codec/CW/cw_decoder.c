@@ -4,39 +4,18 @@
  * No heap allocation during process() — all state pre-allocated in create().
  */
 
-#include "cw_decoder.h"
-#include "iir_filter.h"
-#include "envelope.h"
+#include "cw_decoder_internal.h"
+#include "cw_multi.h"
 #include "morse_table.h"
-#include "timing.h"
-#include "output_filter.h"
+#include "simd_detect.h"
+#include "trace.h"
 
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
-/* Maximum pattern length (longest Morse character has 7 elements) */
-#define MAX_PATTERN 16
-
-struct cw_decoder_t {
-    cw_config_t cfg;
-
-    /* Bandpass filter (optional — applied if bandwidth > 0) */
-    iir_filter_t bandpass;
-    int use_bandpass;
-
-    /* Envelope detector */
-    envelope_t envelope;
-
-    /* Timing classifier */
-    timing_t timing;
-
-    /* Pattern decoder state */
-    char pattern[MAX_PATTERN];
-    int  pattern_len;
-
-    /* Output filter */
-    output_filter_t output;
-};
+/* Lowest envelope/timing rate accepted for cfg->detection_rate */
+#define CW_MIN_DETECTION_RATE 2000
 
 /* ------------------------------------------------------------------ */
 /* Config init                                                         */
@@ -61,21 +40,72 @@ void cw_config_init(cw_config_t *cfg)
     cfg->use_hmm           = 0;
     cfg->min_word_length   = 2;
     cfg->multipass_passes  = 3;
+    cfg->detection_rate    = 0;
+    cfg->filter_precision  = CW_FILTER_FLOAT;
+    cfg->collect_stats     = 0;
 }
 
-/* ------------------------------------------------------------------ */
-/* Create / destroy                                                    */
-/* ------------------------------------------------------------------ */
+static cw_pipeline_fn select_pipeline(const cw_decoder_t *dec);
 
-cw_decoder_t *cw_decoder_create(const cw_config_t *cfg)
+/* Front end the configuration selects */
+static int cfg_quadrature(const cw_config_t *cfg)
+{
+    return cfg->envelope_mode == CW_ENVELOPE_QUADRATURE;
+}
+
+static int cfg_sdft(const cw_config_t *cfg)
 {
-    cw_decoder_t *dec = (cw_decoder_t *)calloc(1, sizeof(cw_decoder_t));
-    if (!dec) return NULL;
+    return cfg->envelope_mode == CW_ENVELOPE_SDFT;
+}
 
-    dec->cfg = *cfg;
+static int cfg_q15(const cw_config_t *cfg)
+{
+    return cfg->filter_precision == CW_FILTER_Q15 &&
+           !cfg_quadrature(cfg) && !cfg_sdft(cfg);
+}
+
+static envelope_mode_t cfg_envelope_mode(const cw_config_t *cfg)
+{
+    /* Quadrature magnitude is smoothed by the IIR lowpass; the
+     * sliding-DFT window already is the smoothing */
+    if (cfg_sdft(cfg)) return ENV_MODE_NONE;
+    return cfg->envelope_mode == CW_ENVELOPE_MULTIPASS ? ENV_MODE_MULTIPASS : ENV_MODE_IIR;
+}
+
+/*
+ * Decimation from sample_rate to the envelope/timing rate, clamped as the
+ * front end will (quadrature_init(), decimator_init()), so the block can
+ * be laid out before anything is built.
+ */
+static int detection_factor(const cw_config_t *cfg)
+{
+    int factor = 1;
+    int rate = cfg->detection_rate;
+    if ((cfg_quadrature(cfg) || cfg_sdft(cfg) || cfg_q15(cfg)) && rate <= 0) {
+        rate = CW_MIN_DETECTION_RATE;
+    }
+    if (rate > 0 && rate < cfg->sample_rate) {
+        /* Below ~2 kHz the multipass window hits its 5-sample floor and rings */
+        if (rate < CW_MIN_DETECTION_RATE) rate = CW_MIN_DETECTION_RATE;
+        factor = cfg->sample_rate / rate;
+    }
+    if (cfg_sdft(cfg)) return factor;
+    if (cfg_quadrature(cfg) && factor < 2) factor = 2;
+    return factor > DECIM_MAX_FACTOR ? DECIM_MAX_FACTOR : factor;
+}
+
+/*
+ * Design the tone filter for dec->cfg's center_freq and bandwidth: the
+ * bandpass (and its Q15 copy), or the quadrature / sliding-DFT front end,
+ * which also decimate by factor. Filter state starts from zero.
+ */
+static void design_front_end(cw_decoder_t *dec, int factor)
+{
+    const cw_config_t *cfg = &dec->cfg;
 
     /* Bandpass filter (only if bandwidth > 0) */
-    if (cfg->bandwidth > 0.0f) {
+    dec->use_bandpass = 0;
+    if (!dec->use_quadrature && !dec->use_sdft && cfg->bandwidth > 0.0f) {
         float low = cfg->center_freq - cfg->bandwidth / 2.0f;
         float high = cfg->center_freq + cfg->bandwidth / 2.0f;
         if (low < 1.0f) low = 1.0f;
@@ -83,33 +113,245 @@ cw_decoder_t *cw_decoder_create(const cw_config_t *cfg)
         if (high >= nyquist) high = nyquist - 1.0f;
         if (low < high) {
             iir_design_bandpass(&dec->bandpass, 2, low, high, (float)cfg->sample_rate);
+            if (cfg->filter_precision == CW_FILTER_DOUBLE) {
+                iir_filter_set_precision(&dec->bandpass, IIR_PRECISION_DOUBLE);
+            }
             dec->use_bandpass = 1;
         }
     }
 
+    if (dec->use_quadrature) {
+        /* Mix + decimate in one step; the I/Q lowpass sets the bandwidth */
+        quadrature_init(dec->quad, cfg->sample_rate, factor,
+                        cfg->center_freq, cfg->bandwidth);
+    } else if (dec->use_sdft) {
+        /* Bin window sets the bandwidth; magnitudes are taken every factor */
+        sdft_init(dec->sdft, cfg->sample_rate, factor,
+                  cfg->center_freq, cfg->bandwidth);
+    }
+
+    if (dec->use_q15) {
+        /* Same filters in fixed point; the decimator undoes the bandpass
+         * scaling so the envelope sees the float pipeline's levels */
+        float scale = 1.0f;
+        if (dec->use_bandpass) {
+            q15_iir_init(dec->bandpass_q15, &dec->bandpass);
+            scale = 1.0f / dec->bandpass_q15->gain;
+        } else {
+            /* No sections pass the audio through, also when a
+             * reconfigure has just dropped the bandpass */
+            memset(dec->bandpass_q15, 0, sizeof(*dec->bandpass_q15));
+            dec->bandpass_q15->gain = 1.0f;
+        }
+        q15_decimator_init(dec->decimator_q15, factor, scale);
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Layout                                                              */
+/* ------------------------------------------------------------------ */
+
+#define CW_ALIGN_UP(n) (((n) + (size_t)CW_DECODER_ALIGN - 1) & ~((size_t)CW_DECODER_ALIGN - 1))
+
+/* Offsets of the optional parts in a decoder's block (0 = not there) */
+typedef struct {
+    size_t quad, sdft, bandpass_q15, decimator_q15;
+    size_t hist;              /* Multipass history */
+    size_t scratch;
+    size_t size;
+} cw_layout_t;
+
+/* malloc() rounded up to CW_DECODER_ALIGN; *block is what to free() */
+static void *alloc_aligned(size_t bytes, void **block)
+{
+    *block = malloc(bytes + CW_DECODER_ALIGN - 1);
+    if (!*block) return NULL;
+    return (void *)CW_ALIGN_UP((uintptr_t)*block);
+}
+
+static size_t layout_take(size_t *at, size_t bytes)
+{
+    size_t off = *at;
+    *at = CW_ALIGN_UP(off + bytes);
+    return off;
+}
+
+static void decoder_layout(const cw_config_t *cfg, int own_scratch, cw_layout_t *l)
+{
+    memset(l, 0, sizeof(*l));
+    size_t at = CW_ALIGN_UP(sizeof(cw_decoder_t));
+
+    if (cfg_quadrature(cfg)) l->quad = layout_take(&at, sizeof(quadrature_t));
+    if (cfg_sdft(cfg)) l->sdft = layout_take(&at, sizeof(sdft_t));
+    if (cfg_q15(cfg)) {
+        l->bandpass_q15 = layout_take(&at, sizeof(q15_iir_t));
+        l->decimator_q15 = layout_take(&at, sizeof(q15_decimator_t));
+    }
+
+    int detect_rate = cfg->sample_rate / detection_factor(cfg);
+    size_t hist = envelope_mem_size(detect_rate, cfg->envelope_window_s,
+                                    cfg_envelope_mode(cfg), cfg->multipass_passes);
+    if (hist) l->hist = layout_take(&at, hist);
+
+    if (own_scratch) l->scratch = layout_take(&at, sizeof(cw_scratch_t));
+    l->size = at;
+}
+
+size_t cw_decoder_size(const cw_config_t *cfg)
+{
+    cw_layout_t l;
+    decoder_layout(cfg, 1, &l);
+    return l.size;
+}
+
+size_t cw_decoder_size_shared(const cw_config_t *cfg)
+{
+    cw_layout_t l;
+    decoder_layout(cfg, 0, &l);
+    return l.size;
+}
+
+/* ------------------------------------------------------------------ */
+/* Create / destroy                                                    */
+/* ------------------------------------------------------------------ */
+
+cw_decoder_t *cw_decoder_init_shared(void *mem, const cw_config_t *cfg,
+                                     cw_scratch_t *shared)
+{
+    cw_init_simd();
+
+    cw_layout_t l;
+    decoder_layout(cfg, shared == NULL, &l);
+    memset(mem, 0, l.size);
+
+    char *base = (char *)mem;
+    cw_decoder_t *dec = (cw_decoder_t *)mem;
+    dec->cfg = *cfg;
+    dec->scratch = shared ? shared : (cw_scratch_t *)(base + l.scratch);
+    if (l.quad) dec->quad = (quadrature_t *)(base + l.quad);
+    if (l.sdft) dec->sdft = (sdft_t *)(base + l.sdft);
+    if (l.bandpass_q15) {
+        dec->bandpass_q15 = (q15_iir_t *)(base + l.bandpass_q15);
+        dec->decimator_q15 = (q15_decimator_t *)(base + l.decimator_q15);
+    }
+
+    dec->use_quadrature = cfg_quadrature(cfg);
+    dec->use_sdft = cfg_sdft(cfg);
+    dec->use_q15 = cfg_q15(cfg);
+
+    /* Tone filter; envelope and timing run at sample_rate / factor */
+    int factor = detection_factor(cfg);
+    design_front_end(dec, factor);
+    dec->detect_rate = cfg->sample_rate / factor;
+
+    /* The quadrature / sliding-DFT front ends decimate themselves */
+    decimator_init(&dec->decimator, dec->use_quadrature || dec->use_sdft ? 1 : factor);
+    dec->use_decimator = (dec->decimator.factor > 1);
+
     /* Envelope detector */
-    envelope_mode_t emode = (cfg->envelope_mode == CW_ENVELOPE_MULTIPASS)
-                            ? ENV_MODE_MULTIPASS : ENV_MODE_IIR;
-    envelope_init(&dec->envelope, cfg->sample_rate, cfg->envelope_window_s,
-                  cfg->threshold_on, cfg->threshold_off,
-                  emode, cfg->multipass_passes);
+    envelope_init_in(&dec->envelope, l.hist ? base + l.hist : NULL,
+                     dec->detect_rate, cfg->envelope_window_s,
+                     cfg->threshold_on, cfg->threshold_off,
+                     cfg_envelope_mode(cfg), cfg->multipass_passes);
 
     /* Timing classifier */
     timing_mode_t tmode = (cfg->timing_mode == CW_TIMING_KALMAN)
                           ? TIMING_MODE_KALMAN : TIMING_MODE_EMA;
-    timing_init(&dec->timing, tmode, cfg->sample_rate,
+    timing_init(&dec->timing, tmode, dec->detect_rate,
                 cfg->initial_wpm, cfg->min_wpm, cfg->max_wpm,
                 cfg->min_element_ratio, cfg->min_element_s);
+    if (cfg->use_hmm) timing_set_hmm(&dec->timing, 1);
 
     /* Output filter */
     output_filter_init(&dec->output, cfg->min_word_length);
+    dec->pattern = MORSE_CODE_EMPTY;
+
+    dec->pipeline = select_pipeline(dec);
+
+    return dec;
+}
 
+cw_decoder_t *cw_decoder_init_in(void *mem, const cw_config_t *cfg)
+{
+    if (!mem || !cfg || ((uintptr_t)mem & (CW_DECODER_ALIGN - 1))) return NULL;
+    return cw_decoder_init_shared(mem, cfg, NULL);
+}
+
+cw_decoder_t *cw_decoder_create(const cw_config_t *cfg)
+{
+    void *block;
+    void *mem = alloc_aligned(cw_decoder_size(cfg), &block);
+    if (!mem) return NULL;
+
+    cw_decoder_t *dec = cw_decoder_init_in(mem, cfg);
+    dec->block = block;
     return dec;
 }
 
 void cw_decoder_destroy(cw_decoder_t *dec)
 {
-    free(dec);
+    if (!dec) return;
+    envelope_free(&dec->envelope);
+    free(dec->block);
+}
+
+/* ------------------------------------------------------------------ */
+/* Pool                                                                */
+/* ------------------------------------------------------------------ */
+
+struct cw_decoder_pool_t {
+    int n;
+    size_t bytes;             /* Whole slab */
+    cw_decoder_t **decs;      /* Into the slab */
+    void *slab;               /* Aligned */
+    void *block;              /* As allocated */
+};
+
+cw_decoder_pool_t *cw_decoder_pool_create(const cw_config_t *cfgs, int n)
+{
+    if (!cfgs || n <= 0) return NULL;
+
+    cw_decoder_pool_t *pool = (cw_decoder_pool_t *)calloc(1, sizeof(cw_decoder_pool_t));
+    if (!pool) return NULL;
+    pool->n = n;
+    pool->decs = (cw_decoder_t **)calloc((size_t)n, sizeof(cw_decoder_t *));
+
+    /* Decoders back to back, one scratch at the end */
+    size_t bytes = 0;
+    for (int i = 0; i < n; i++) bytes += cw_decoder_size_shared(&cfgs[i]);
+    pool->bytes = bytes + CW_ALIGN_UP(sizeof(cw_scratch_t));
+    if (pool->decs) pool->slab = alloc_aligned(pool->bytes, &pool->block);
+    if (!pool->slab) {
+        cw_decoder_pool_destroy(pool);
+        return NULL;
+    }
+
+    char *at = (char *)pool->slab;
+    cw_scratch_t *scratch = (cw_scratch_t *)(at + bytes);
+    for (int i = 0; i < n; i++) {
+        pool->decs[i] = cw_decoder_init_shared(at, &cfgs[i], scratch);
+        at += cw_decoder_size_shared(&cfgs[i]);
+    }
+    return pool;
+}
+
+cw_decoder_t *cw_decoder_pool_get(cw_decoder_pool_t *pool, int i)
+{
+    if (!pool || i < 0 || i >= pool->n) return NULL;
+    return pool->decs[i];
+}
+
+size_t cw_decoder_pool_bytes(const cw_decoder_pool_t *pool)
+{
+    return pool ? pool->bytes : 0;
+}
+
+void cw_decoder_pool_destroy(cw_decoder_pool_t *pool)
+{
+    if (!pool) return;
+    free(pool->block);
+    free(pool->decs);
+    free(pool);
 }
 
 /* ------------------------------------------------------------------ */
@@ -120,7 +362,8 @@ static int pattern_feed(cw_decoder_t *dec, int elem, char *out, int out_len)
 {
     if (elem == ELEM_DIT || elem == ELEM_DAH) {
         if (dec->pattern_len < MAX_PATTERN - 1) {
-            dec->pattern[dec->pattern_len++] = (char)elem;
+            dec->pattern = morse_code_push(dec->pattern, elem == ELEM_DAH);
+            dec->pattern_len++;
         }
         return 0;
     }
@@ -129,9 +372,9 @@ static int pattern_feed(cw_decoder_t *dec, int elem, char *out, int out_len)
 
     if (elem == ELEM_CHAR || elem == ELEM_WORD) {
         if (dec->pattern_len > 0) {
-            dec->pattern[dec->pattern_len] = '\0';
-            int n = morse_lookup_merged(dec->pattern, out + written, out_len - written);
+            int n = morse_lookup_merged_code(dec->pattern, out + written, out_len - written);
             written += n;
+            dec->pattern = MORSE_CODE_EMPTY;
             dec->pattern_len = 0;
         }
         if (elem == ELEM_WORD && written < out_len) {
@@ -142,11 +385,19 @@ static int pattern_feed(cw_decoder_t *dec, int elem, char *out, int out_len)
     return written;
 }
 
+int cw_decoder_feed_element(cw_decoder_t *dec, int elem, char *out, int out_len)
+{
+    char pat_out[4];
+    int pat_n = pattern_feed(dec, elem, pat_out, sizeof(pat_out));
+    if (pat_n <= 0) return 0;
+    return output_filter_feed(&dec->output, pat_out, pat_n, out, out_len);
+}
+
 static int pattern_flush(cw_decoder_t *dec, char *out, int out_len)
 {
     if (dec->pattern_len <= 0) return 0;
-    dec->pattern[dec->pattern_len] = '\0';
-    int n = morse_lookup_merged(dec->pattern, out, out_len);
+    int n = morse_lookup_merged_code(dec->pattern, out, out_len);
+    dec->pattern = MORSE_CODE_EMPTY;
     dec->pattern_len = 0;
     return n;
 }
@@ -155,71 +406,329 @@ static int pattern_flush(cw_decoder_t *dec, char *out, int out_len)
 /* Process                                                             */
 /* ------------------------------------------------------------------ */
 
+/*
+ * Step 1 front ends. Each reads chunk samples from in, leaves the
+ * detection-rate signal in work (in == work runs in place) and returns
+ * its length.
+ */
+static inline int front_quadrature(cw_decoder_t *dec, const cw_kernels_t *k,
+                                   const float *in, float *work, int chunk)
+{
+    (void)k;
+    /* I/Q mix → lowpass → decimate → magnitude */
+    return quadrature_process(dec->quad, in, chunk, work);
+}
+
+static inline int front_sdft(cw_decoder_t *dec, const cw_kernels_t *k,
+                             const float *in, float *work, int chunk)
+{
+    (void)k;
+    /* Tone bin magnitude + neighbour-bin noise floor */
+    int m = sdft_process(dec->sdft, in, chunk, work);
+    dec->envelope.noise_level = dec->sdft->noise;
+    return m;
+}
+
+static inline int front_filter(cw_decoder_t *dec, const cw_kernels_t *k,
+                               const float *in, float *work, int chunk)
+{
+    if (work != in) memcpy(work, in, chunk * sizeof(float));
+
+    /* Bandpass filter */
+    if (dec->use_bandpass) {
+        k->biquad_cascade(&dec->bandpass, work, chunk);
+    }
+
+    /* Rectify + decimate to the detection rate */
+    if (dec->use_decimator) {
+        k->rectify(work, work, chunk);
+        return decimator_process(&dec->decimator, work, chunk, work);
+    }
+    return chunk;
+}
+
+/* front_filter() with both the bandpass and the decimator in use */
+static inline int front_bandpass_decimate(cw_decoder_t *dec, const cw_kernels_t *k,
+                                          const float *in, float *work, int chunk)
+{
+    if (work != in) memcpy(work, in, chunk * sizeof(float));
+    k->biquad_cascade(&dec->bandpass, work, chunk);
+    k->rectify(work, work, chunk);
+    return decimator_process(&dec->decimator, work, chunk, work);
+}
+
+/*
+ * Fixed point up to the detection rate: int16 from dec->s16_in (in is
+ * unused) → Q15 bandpass → saturating rectify → decimate to float.
+ */
+static inline int front_q15(cw_decoder_t *dec, const cw_kernels_t *k,
+                            const float *in, float *work, int chunk)
+{
+    (void)in;
+    int16_t *x = dec->scratch->work_s16;
+    q15_iir_process(dec->bandpass_q15, dec->s16_in, x, chunk);
+    k->rectify_s16(x, x, chunk);
+    return q15_decimator_process(dec->decimator_q15, x, chunk, work, k->dot_s16);
+}
+
+/*
+ * Decode one chunk (<= CW_DECODER_CHUNK samples). One instance per
+ * front end and timing mode, picked in cw_decoder_create(), so the
+ * configuration is resolved once rather than tested on every chunk and
+ * every transition.
+ */
+#define CW_DEFINE_PIPELINE(name, front, timing_runs)                           \
+static int name(cw_decoder_t *dec, const float *in, float *work,               \
+                int chunk, char *out, int out_len)                             \
+{                                                                              \
+    const cw_kernels_t *k = cw_get_kernels();                                  \
+    cw_stats_t *st = &dec->stats;                                              \
+    int timed = dec->cfg.collect_stats;                                        \
+    int *runs = dec->scratch->runs;                                            \
+    int written = 0;                                                           \
+    uint64_t t0 = timed ? cw_clock_ns() : 0;                                   \
+                                                                               \
+    /* Step 1: Front end → detection-rate signal */                            \
+    int m = front(dec, k, in, work, chunk);                                    \
+    uint64_t t1 = timed ? cw_clock_ns() : 0;                                   \
+                                                                               \
+    /* Step 2: Envelope detection → on/off runs */                             \
+    int n_runs = envelope_process_runs(&dec->envelope, work, runs, m);         \
+    uint64_t t2 = timed ? cw_clock_ns() : 0;                                   \
+                                                                               \
+    /* Step 3: Timing, once per transition (elements overwrite runs) */        \
+    int n_elems = timing_runs(&dec->timing, runs, n_runs, runs);               \
+    uint64_t t3 = timed ? cw_clock_ns() : 0;                                   \
+                                                                               \
+    /* Step 4: Pattern → Output filter */                                      \
+    dec->output.stamp = dec->sample_pos + chunk;                               \
+    for (int i = 0; i < n_elems && written < out_len; i++) {                   \
+        written += cw_decoder_feed_element(dec, runs[i], out + written,        \
+                                           out_len - written);                 \
+    }                                                                          \
+                                                                               \
+    st->samples += (uint64_t)chunk;                                            \
+    dec->sample_pos += chunk;                                                  \
+    st->elements += (uint64_t)n_elems;                                         \
+    if (timed) {                                                               \
+        st->bandpass_ns += t1 - t0;                                            \
+        st->envelope_ns += t2 - t1;                                            \
+        st->timing_ns += t3 - t2;                                              \
+        st->pattern_ns += cw_clock_ns() - t3;                                  \
+    }                                                                          \
+    return written;                                                            \
+}
+
+CW_DEFINE_PIPELINE(pipeline_quadrature_kalman, front_quadrature, timing_process_runs_kalman)
+CW_DEFINE_PIPELINE(pipeline_quadrature_ema,    front_quadrature, timing_process_runs_ema)
+CW_DEFINE_PIPELINE(pipeline_sdft_kalman,       front_sdft,       timing_process_runs_kalman)
+CW_DEFINE_PIPELINE(pipeline_sdft_ema,          front_sdft,       timing_process_runs_ema)
+CW_DEFINE_PIPELINE(pipeline_bpdec_kalman,      front_bandpass_decimate, timing_process_runs_kalman)
+CW_DEFINE_PIPELINE(pipeline_bpdec_ema,         front_bandpass_decimate, timing_process_runs_ema)
+CW_DEFINE_PIPELINE(pipeline_q15_kalman,        front_q15,        timing_process_runs_kalman)
+CW_DEFINE_PIPELINE(pipeline_q15_ema,           front_q15,        timing_process_runs_ema)
+CW_DEFINE_PIPELINE(pipeline_filter_kalman,     front_filter,     timing_process_runs_kalman)
+CW_DEFINE_PIPELINE(pipeline_filter_ema,        front_filter,     timing_process_runs_ema)
+CW_DEFINE_PIPELINE(pipeline_quadrature_hmm,    front_quadrature, timing_process_runs_hmm)
+CW_DEFINE_PIPELINE(pipeline_sdft_hmm,          front_sdft,       timing_process_runs_hmm)
+CW_DEFINE_PIPELINE(pipeline_bpdec_hmm,         front_bandpass_decimate, timing_process_runs_hmm)
+CW_DEFINE_PIPELINE(pipeline_q15_hmm,           front_q15,        timing_process_runs_hmm)
+CW_DEFINE_PIPELINE(pipeline_filter_hmm,        front_filter,     timing_process_runs_hmm)
+
+static cw_pipeline_fn select_pipeline(const cw_decoder_t *dec)
+{
+    int kalman = (dec->timing.mode == TIMING_MODE_KALMAN);
+    if (dec->timing.use_hmm) {
+        /* The HMM serves both timing modes */
+        if (dec->use_quadrature) return pipeline_quadrature_hmm;
+        if (dec->use_sdft) return pipeline_sdft_hmm;
+        if (dec->use_q15) return pipeline_q15_hmm;
+        if (dec->use_bandpass && dec->use_decimator) return pipeline_bpdec_hmm;
+        return pipeline_filter_hmm;
+    }
+    if (dec->use_quadrature) {
+        return kalman ? pipeline_quadrature_kalman : pipeline_quadrature_ema;
+    }
+    if (dec->use_sdft) {
+        return kalman ? pipeline_sdft_kalman : pipeline_sdft_ema;
+    }
+    if (dec->use_q15) {
+        return kalman ? pipeline_q15_kalman : pipeline_q15_ema;
+    }
+    if (dec->use_bandpass && dec->use_decimator) {
+        return kalman ? pipeline_bpdec_kalman : pipeline_bpdec_ema;
+    }
+    return kalman ? pipeline_filter_kalman : pipeline_filter_ema;
+}
+
 int cw_decoder_process(cw_decoder_t *dec, const float *audio, int n,
                        char *out, int out_len)
 {
     if (n <= 0 || out_len <= 0) return 0;
 
-    /* Work buffer for audio (to avoid modifying input) */
-    /* Process in 4096-sample segments to limit stack usage */
+    const cw_kernels_t *k = cw_get_kernels();
     int total_written = 0;
     int processed = 0;
 
+    TRACE_BEGIN(TRACE_CW_PROCESS);
+
+    /* Process in CW_DECODER_CHUNK segments through the decoder's scratch */
     while (processed < n && total_written < out_len) {
         int chunk = n - processed;
-        if (chunk > 4096) chunk = 4096;
+        if (chunk > CW_DECODER_CHUNK) chunk = CW_DECODER_CHUNK;
 
-        float work[4096];
-        int on_off[4096];
+        if (dec->use_q15) {
+            k->float_to_s16(audio + processed, dec->scratch->work_s16, chunk);
+            dec->s16_in = dec->scratch->work_s16;
+        }
+        total_written += dec->pipeline(dec, audio + processed, dec->scratch->work, chunk,
+                                       out + total_written, out_len - total_written);
+        processed += chunk;
+    }
 
-        memcpy(work, audio + processed, chunk * sizeof(float));
+    TRACE_END(TRACE_CW_PROCESS);
+    return total_written;
+}
 
-        /* Step 1: Bandpass filter */
-        if (dec->use_bandpass) {
-            iir_filter_process(&dec->bandpass, work, chunk);
-        }
+int cw_decoder_process_inplace(cw_decoder_t *dec, float *audio, int n,
+                               char *out, int out_len)
+{
+    if (n <= 0 || out_len <= 0) return 0;
 
-        /* Step 2: Envelope detection → on/off */
-        envelope_process(&dec->envelope, work, on_off, chunk);
-
-        /* Step 3-4: Timing → Pattern → Output filter, sample by sample */
-        for (int i = 0; i < chunk && total_written < out_len; i++) {
-            int elem = timing_process_sample(&dec->timing, on_off[i]);
-            if (elem != ELEM_NONE) {
-                /* Pattern decoder */
-                char pat_out[4];
-                int pat_n = pattern_feed(dec, elem, pat_out, sizeof(pat_out));
-
-                /* Output filter */
-                if (pat_n > 0) {
-                    int filt_n = output_filter_feed(&dec->output,
-                                                    pat_out, pat_n,
-                                                    out + total_written,
-                                                    out_len - total_written);
-                    total_written += filt_n;
-                }
-            }
+    const cw_kernels_t *k = cw_get_kernels();
+    int total_written = 0;
+    int processed = 0;
+
+    TRACE_BEGIN(TRACE_CW_PROCESS);
+
+    while (processed < n && total_written < out_len) {
+        int chunk = n - processed;
+        if (chunk > CW_DECODER_CHUNK) chunk = CW_DECODER_CHUNK;
+
+        float *x = audio + processed;
+        if (dec->use_q15) {
+            k->float_to_s16(x, dec->scratch->work_s16, chunk);
+            dec->s16_in = dec->scratch->work_s16;
         }
+        total_written += dec->pipeline(dec, x, x, chunk,
+                                       out + total_written, out_len - total_written);
+        processed += chunk;
+    }
+
+    TRACE_END(TRACE_CW_PROCESS);
+    return total_written;
+}
+
+int cw_decoder_process_s16(cw_decoder_t *dec, const int16_t *audio, int n,
+                           char *out, int out_len)
+{
+    if (n <= 0 || out_len <= 0) return 0;
 
+    const cw_kernels_t *k = cw_get_kernels();
+    int total_written = 0;
+    int processed = 0;
+
+    TRACE_BEGIN(TRACE_CW_PROCESS);
+
+    while (processed < n && total_written < out_len) {
+        int chunk = n - processed;
+        if (chunk > CW_DECODER_CHUNK) chunk = CW_DECODER_CHUNK;
+
+        /* Fixed point reads the samples as they are; float converts first */
+        const float *in = dec->scratch->work;
+        if (dec->use_q15) {
+            dec->s16_in = audio + processed;
+        } else {
+            k->s16_to_float(audio + processed, dec->scratch->work, chunk);
+        }
+        total_written += dec->pipeline(dec, in, dec->scratch->work, chunk,
+                                       out + total_written, out_len - total_written);
         processed += chunk;
     }
 
+    TRACE_END(TRACE_CW_PROCESS);
     return total_written;
 }
 
+/* Text a chunk can produce: a held word, with room for a merged pattern */
+#define CW_EVENT_TEXT (OUTPUT_FILTER_MAX_WORD + 16)
+
+/* Stamp the text just decoded with the decoder's state and where the
+ * output filter says each character came out */
+static int text_to_events(const cw_decoder_t *dec, const char *text,
+                          const int64_t *stamps, int n, cw_event_t *events)
+{
+    const float wpm = cw_decoder_get_wpm(dec);
+    const float fit = timing_get_fit(&dec->timing);
+    for (int i = 0; i < n; i++) {
+        cw_event_t *e = &events[i];
+        e->sample = stamps[i];
+        e->wpm = wpm;
+        e->pitch_hz = dec->cfg.center_freq;
+        e->confidence = text[i] == '?' ? 0.0f : fit;
+        e->character = text[i];
+    }
+    return n;
+}
+
+int cw_decoder_process_events(cw_decoder_t *dec, const float *audio, int n,
+                              cw_event_t *events, int max_events)
+{
+    if (n <= 0 || max_events <= 0) return 0;
+
+    const cw_kernels_t *k = cw_get_kernels();
+    char text[CW_EVENT_TEXT];
+    int64_t stamps[CW_EVENT_TEXT];
+    int count = 0;
+    int processed = 0;
+
+    TRACE_BEGIN(TRACE_CW_PROCESS);
+
+    while (processed < n && count < max_events) {
+        int chunk = n - processed;
+        if (chunk > CW_DECODER_CHUNK) chunk = CW_DECODER_CHUNK;
+        int room = max_events - count;
+        if (room > CW_EVENT_TEXT) room = CW_EVENT_TEXT;
+
+        if (dec->use_q15) {
+            k->float_to_s16(audio + processed, dec->scratch->work_s16, chunk);
+            dec->s16_in = dec->scratch->work_s16;
+        }
+        dec->output.stamps_out = stamps;
+        int m = dec->pipeline(dec, audio + processed, dec->scratch->work, chunk,
+                              text, room);
+        count += text_to_events(dec, text, stamps, m, events + count);
+        processed += chunk;
+    }
+    dec->output.stamps_out = NULL;
+
+    TRACE_END(TRACE_CW_PROCESS);
+    return count;
+}
+
+int cw_decoder_finalize_events(cw_decoder_t *dec, cw_event_t *events, int max_events)
+{
+    if (max_events <= 0) return 0;
+
+    char text[CW_EVENT_TEXT];
+    int64_t stamps[CW_EVENT_TEXT];
+    int room = max_events < CW_EVENT_TEXT ? max_events : CW_EVENT_TEXT;
+
+    dec->output.stamp = dec->sample_pos;
+    dec->output.stamps_out = stamps;
+    int m = cw_decoder_finalize(dec, text, room);
+    dec->output.stamps_out = NULL;
+    return text_to_events(dec, text, stamps, m, events);
+}
+
 int cw_decoder_finalize(cw_decoder_t *dec, char *out, int out_len)
 {
     int written = 0;
 
-    /* Finalize timing (emit pending element) */
-    int elem = timing_finalize(&dec->timing);
-    if (elem != ELEM_NONE) {
-        char pat_out[4];
-        int pat_n = pattern_feed(dec, elem, pat_out, sizeof(pat_out));
-        if (pat_n > 0) {
-            written += output_filter_feed(&dec->output, pat_out, pat_n,
-                                          out + written, out_len - written);
-        }
+    /* Finalize timing (emit pending elements) */
+    int elem;
+    while ((elem = timing_finalize(&dec->timing)) != ELEM_NONE) {
+        written += cw_decoder_feed_element(dec, elem, out + written, out_len - written);
     }
 
     /* Flush pattern decoder */
@@ -238,6 +747,25 @@ int cw_decoder_finalize(cw_decoder_t *dec, char *out, int out_len)
     return written;
 }
 
+uint64_t cw_clock_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+int cw_decoder_get_stats(const cw_decoder_t *dec, cw_stats_t *stats)
+{
+    if (!dec || !stats) return -1;
+    *stats = dec->stats;
+    return 0;
+}
+
+void cw_decoder_reset_stats(cw_decoder_t *dec)
+{
+    memset(&dec->stats, 0, sizeof(dec->stats));
+}
+
 float cw_decoder_get_wpm(const cw_decoder_t *dec)
 {
     return timing_get_wpm(&dec->timing);
@@ -248,10 +776,56 @@ void cw_decoder_reset(cw_decoder_t *dec)
     if (dec->use_bandpass) {
         iir_filter_reset(&dec->bandpass);
     }
+    if (dec->use_quadrature) {
+        quadrature_reset(dec->quad);
+    }
+    if (dec->use_sdft) {
+        sdft_reset(dec->sdft);
+    }
+    if (dec->use_q15) {
+        q15_iir_reset(dec->bandpass_q15);
+        q15_decimator_reset(dec->decimator_q15);
+    }
+    decimator_reset(&dec->decimator);
     envelope_reset(&dec->envelope);
     timing_reset(&dec->timing, dec->cfg.initial_wpm);
+    dec->pattern = MORSE_CODE_EMPTY;
     dec->pattern_len = 0;
     output_filter_reset(&dec->output);
+    dec->sample_pos = 0;
+}
+
+int cw_decoder_reconfigure(cw_decoder_t *dec, const cw_config_t *cfg)
+{
+    if (!dec || !cfg) return -1;
+
+    /* These size the buffers or pick the stages: a new decoder's job */
+    const cw_config_t *cur = &dec->cfg;
+    if (cfg->sample_rate != cur->sample_rate ||
+        cfg->timing_mode != cur->timing_mode ||
+        cfg->envelope_mode != cur->envelope_mode ||
+        cfg->envelope_window_s != cur->envelope_window_s ||
+        cfg->multipass_passes != cur->multipass_passes ||
+        cfg->use_hmm != cur->use_hmm ||
+        cfg->detection_rate != cur->detection_rate ||
+        cfg->filter_precision != cur->filter_precision) {
+        return -1;
+    }
+
+    dec->cfg = *cfg;
+    design_front_end(dec, detection_factor(cfg));
+
+    /* The envelope's smoothing, peak and on/off state carry over */
+    dec->envelope.threshold_on = cfg->threshold_on;
+    dec->envelope.threshold_off = cfg->threshold_off;
+
+    /* So do the speed estimate, the pattern and the output warmup */
+    timing_set_limits(&dec->timing, cfg->min_wpm, cfg->max_wpm,
+                      cfg->min_element_ratio, cfg->min_element_s);
+    dec->output.min_word_length = cfg->min_word_length;
+
+    dec->pipeline = select_pipeline(dec);
+    return 0;
 }
 
 /* ------------------------------------------------------------------ */
@@ -262,17 +836,26 @@ int cw_decode_multi(const cw_config_t *cfgs, int n_ch,
                     const float **audio, int n,
                     char **out_bufs, int out_len)
 {
-    /* Simple sequential implementation.
-     * SIMD-parallel version in Phase D. */
-    for (int ch = 0; ch < n_ch; ch++) {
-        cw_decoder_t *dec = cw_decoder_create(&cfgs[ch]);
-        if (!dec) return -1;
+    if (n_ch <= 0 || out_len <= 0) return -1;
+
+    /* Lane-parallel decoder: channels stepped 4 or 8 at a time */
+    cw_multi_decoder_t *md = cw_multi_decoder_create(cfgs, n_ch);
+    int *written = (int *)calloc((size_t)n_ch, sizeof(int));
+    if (!md || !written) {
+        cw_multi_decoder_destroy(md);
+        free(written);
+        return -1;
+    }
 
-        int wrote = cw_decoder_process(dec, audio[ch], n, out_bufs[ch], out_len);
-        wrote += cw_decoder_finalize(dec, out_bufs[ch] + wrote, out_len - wrote);
-        out_bufs[ch][wrote < out_len ? wrote : out_len - 1] = '\0';
+    cw_multi_decoder_process(md, audio, n, out_bufs, written, out_len);
 
-        cw_decoder_destroy(dec);
+    for (int ch = 0; ch < n_ch; ch++) {
+        int wrote = written[ch];
+        wrote += cw_decoder_finalize(md->chans[ch], out_bufs[ch] + wrote, out_len - wrote);
+        out_bufs[ch][wrote < out_len ? wrote : out_len - 1] = '\0';
     }
+
+    free(written);
+    cw_multi_decoder_destroy(md);
     return 0;
 }
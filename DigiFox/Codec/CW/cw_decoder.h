@@ -1,8 +1,10 @@
 /**
  * cw_decoder.h — Public C API for CW Decoder Core
  *
- * Single-header interface for consumers. Provides single-channel
- * and multi-channel batch decoding of CW (Morse code) audio.
+ * Single-header interface for consumers. Provides single-channel,
+ * multi-channel streaming, shared-input channelizer, skimmer (a decoder
+ * per signal found in the band), queued (audio callback → worker
+ * thread) and multi-channel batch decoding of CW (Morse code) audio.
  *
  * Usage:
  *   cw_config_t cfg;
@@ -20,6 +22,9 @@
 #ifndef CW_DECODER_H
 #define CW_DECODER_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -27,6 +32,24 @@ extern "C" {
 /* Opaque decoder handle */
 typedef struct cw_decoder_t cw_decoder_t;
 
+/* Opaque multi-channel decoder handle */
+typedef struct cw_multi_decoder_t cw_multi_decoder_t;
+
+/* Opaque shared-input channelizer handle */
+typedef struct cw_channelizer_t cw_channelizer_t;
+
+/* Opaque queued-decoding handle */
+typedef struct cw_stream_t cw_stream_t;
+
+/* Opaque decoder pool handle */
+typedef struct cw_decoder_pool_t cw_decoder_pool_t;
+
+/* Opaque skimmer handle */
+typedef struct cw_skimmer_t cw_skimmer_t;
+
+/* Alignment of caller memory for cw_decoder_init_in() (a cache line) */
+#define CW_DECODER_ALIGN 64
+
 /* Timing mode selection */
 typedef enum {
     CW_TIMING_EMA    = 0,   /* Exponential moving average (simple) */
@@ -37,8 +60,19 @@ typedef enum {
 typedef enum {
     CW_ENVELOPE_IIR       = 0,   /* Butterworth lowpass */
     CW_ENVELOPE_MULTIPASS = 1,   /* Cascaded moving average (default) */
+    CW_ENVELOPE_QUADRATURE = 2,  /* I/Q mix to baseband + magnitude (decimated) */
+    CW_ENVELOPE_SDFT      = 3,   /* Sliding DFT at center_freq + noise-floor bins (decimated) */
 } cw_envelope_mode_t;
 
+/* Bandpass arithmetic selection */
+typedef enum {
+    CW_FILTER_FLOAT  = 0,   /* float sections, SIMD kernels (default) */
+    CW_FILTER_DOUBLE = 1,   /* double sections: narrow bandwidth / long runs */
+    CW_FILTER_Q15    = 2,   /* fixed-point front end (q15.h): int16 sources,
+                               low-power monitoring; detection_rate
+                               defaults to 2000 */
+} cw_filter_precision_t;
+
 /* Configuration struct — all fields have sensible defaults via cw_config_init() */
 typedef struct cw_config_t {
     int   sample_rate;       /* Audio sample rate in Hz (default: 48000) */
@@ -63,20 +97,110 @@ typedef struct cw_config_t {
     int   min_word_length;   /* Output filter: minimum word length (default: 2) */
 
     int   multipass_passes;  /* Number of moving-average passes (default: 3) */
+
+    int   detection_rate;    /* Envelope/timing rate in Hz after decimation,
+                                min 2000 (0 = sample_rate, default: 0) */
+
+    cw_filter_precision_t filter_precision;  /* Default: CW_FILTER_FLOAT */
+
+    int   collect_stats;     /* Time each stage into cw_stats_t (default: 0) */
 } cw_config_t;
 
+/*
+ * Cumulative decoder statistics. Sample and element counts are always
+ * kept; the per-stage times only with cfg.collect_stats (monotonic
+ * clock, read once per stage per 4096-sample chunk).
+ */
+typedef struct {
+    uint64_t samples;        /* Audio samples processed */
+    uint64_t elements;       /* Timing elements emitted (dit, dah, char/word gap) */
+
+    uint64_t bandpass_ns;    /* Front end: bandpass / quadrature / sliding DFT + decimation */
+    uint64_t envelope_ns;    /* Envelope, hysteresis and on/off runs */
+    uint64_t timing_ns;      /* Element classification */
+    uint64_t pattern_ns;     /* Morse pattern lookup + output filter */
+} cw_stats_t;
+
+/*
+ * A decoded character with its place in the audio, for aligning text
+ * with a waterfall or a log (cw_decoder_process_events()).
+ */
+typedef struct {
+    int64_t sample;          /* Input samples decoded when it came out, since
+                                create/reset: the end of the block (at most
+                                4096 samples) holding the gap that completed
+                                it; for ' ', the gap that ended the word */
+    float   wpm;             /* Speed estimate */
+    float   pitch_hz;        /* Tone decoded (cfg.center_freq) */
+    float   confidence;      /* 0..1: timing_get_fit() of recent marks, 0 for '?' */
+    char    character;       /* ' ' for a word gap */
+} cw_event_t;
+
+/* Skimmer configuration — defaults via cw_skimmer_config_init() */
+typedef struct {
+    cw_config_t decoder;     /* Template for every signal's decoder, center_freq
+                                set per signal (defaults: cw_config_init()) */
+    int   max_signals;       /* Decoders in the pool (default: 16) */
+
+    float bin_hz;            /* Spacing of the fed spectrum bins (default: 3.125,
+                                the spectrum engine's at 12 kHz) */
+    float row_s;             /* Time between fed rows (default: 0.04) */
+
+    float f_min;             /* Band searched for signals in Hz (default: 200) */
+    float f_max;             /*   (default: 1200) */
+    float min_spacing;       /* Closest two signals in Hz (default: 50) */
+
+    float average_s;         /* Smoothing of the spectrum over keying (default: 0.5) */
+    float snr_on_db;         /* Peak over the noise floor to be found (default: 10) */
+    float snr_off_db;        /* Level a signal is kept down to (default: 6) */
+    float spawn_s;           /* Found this long before it gets a decoder (default: 0.4) */
+    float retire_s;          /* Gone this long before its decoder is freed (default: 5) */
+} cw_skimmer_config_t;
+
+/* One skimmer slot */
+typedef struct {
+    int      active;         /* Has a signal (and its decoder) */
+    uint32_t id;             /* New for every signal, never 0 */
+    float    freq;           /* Tracked tone frequency in Hz */
+    float    snr_db;         /* Smoothed peak over the noise floor */
+    float    wpm;            /* Decoder's speed estimate */
+    double   age_s;          /* Since the decoder was assigned */
+} cw_skimmer_signal_t;
+
 /**
  * Initialize config with default values.
  * Always call this before modifying individual fields.
  */
 void cw_config_init(cw_config_t *cfg);
 
+/**
+ * Initialize skimmer config with default values (decoder at 48 kHz,
+ * as cw_config_init(); set decoder.sample_rate).
+ */
+void cw_skimmer_config_init(cw_skimmer_config_t *cfg);
+
 /**
  * Create a decoder instance.
  * Returns NULL on allocation failure.
  */
 cw_decoder_t *cw_decoder_create(const cw_config_t *cfg);
 
+/**
+ * Bytes a decoder for cfg takes: the state its front end, envelope and
+ * timing need (nothing for the front ends it does not use) plus its
+ * processing scratch.
+ */
+size_t cw_decoder_size(const cw_config_t *cfg);
+
+/**
+ * Create a decoder in caller memory: cw_decoder_size(cfg) bytes at mem,
+ * aligned to CW_DECODER_ALIGN, kept until the decoder is done with. No
+ * allocation; cw_decoder_destroy() releases nothing, free mem instead.
+ *
+ * @return The decoder (at mem), or NULL if mem is NULL or misaligned
+ */
+cw_decoder_t *cw_decoder_init_in(void *mem, const cw_config_t *cfg);
+
 /**
  * Process an audio chunk and decode CW.
  *
@@ -90,6 +214,48 @@ cw_decoder_t *cw_decoder_create(const cw_config_t *cfg);
 int cw_decoder_process(cw_decoder_t *dec, const float *audio, int n,
                        char *out, int out_len);
 
+/**
+ * Same as cw_decoder_process(), but filters the caller's buffer in place
+ * instead of copying it — audio is overwritten with intermediate data.
+ * Uses no stack buffers; for audio threads with small stacks.
+ *
+ * @param dec      Decoder handle
+ * @param audio    Audio samples (mono, float, range [-1, 1]); clobbered
+ * @param n        Number of samples
+ * @param out      Output buffer for decoded ASCII text
+ * @param out_len  Size of output buffer
+ * @return         Number of characters written to out (not null-terminated)
+ */
+int cw_decoder_process_inplace(cw_decoder_t *dec, float *audio, int n,
+                               char *out, int out_len);
+
+/**
+ * Same as cw_decoder_process(), for int16 audio (full scale = 1.0). With
+ * CW_FILTER_Q15 the samples go through the fixed-point front end as they
+ * are; otherwise each chunk is converted to float first.
+ *
+ * @param dec      Decoder handle
+ * @param audio    Audio samples (mono, int16)
+ * @param n        Number of samples
+ * @param out      Output buffer for decoded ASCII text
+ * @param out_len  Size of output buffer
+ * @return         Number of characters written to out (not null-terminated)
+ */
+int cw_decoder_process_s16(cw_decoder_t *dec, const int16_t *audio, int n,
+                           char *out, int out_len);
+
+/**
+ * Same as cw_decoder_process(), returning the characters as records in
+ * the caller's array instead of text: no formatting, and each is placed
+ * in the audio. Stops early, like process(), once the array is full.
+ *
+ * @param events      Output records
+ * @param max_events  Size of events
+ * @return            Number of records written
+ */
+int cw_decoder_process_events(cw_decoder_t *dec, const float *audio, int n,
+                              cw_event_t *events, int max_events);
+
 /**
  * Finalize decoding — flush remaining buffered text.
  * Call when no more audio data is expected.
@@ -98,24 +264,347 @@ int cw_decoder_process(cw_decoder_t *dec, const float *audio, int n,
  */
 int cw_decoder_finalize(cw_decoder_t *dec, char *out, int out_len);
 
+/**
+ * cw_decoder_finalize() as records, stamped at the end of the audio.
+ */
+int cw_decoder_finalize_events(cw_decoder_t *dec, cw_event_t *events, int max_events);
+
 /**
  * Get current estimated WPM.
  */
 float cw_decoder_get_wpm(const cw_decoder_t *dec);
 
 /**
- * Reset decoder state for reuse (same config).
+ * Reset decoder state for reuse (same config). Statistics are kept.
  */
 void cw_decoder_reset(cw_decoder_t *dec);
 
+/**
+ * Retune in place: redesign the tone filter for cfg's center_freq and
+ * bandwidth and take its thresholds, WPM bounds, noise-reject limits and
+ * min_word_length, without reallocating. The speed estimate, pattern,
+ * envelope and output-filter warmup carry over (initial_wpm only matters
+ * to the next reset). Not from another thread while processing.
+ *
+ * @return 0 on success, -1 if cfg differs in what the decoder is built
+ *         around (sample_rate, timing/envelope mode, envelope window,
+ *         multipass passes, use_hmm, detection_rate, filter_precision);
+ *         the decoder is then unchanged
+ */
+int cw_decoder_reconfigure(cw_decoder_t *dec, const cw_config_t *cfg);
+
+/**
+ * Copy the decoder's cumulative statistics.
+ *
+ * @return 0 on success, -1 on NULL arguments
+ */
+int cw_decoder_get_stats(const cw_decoder_t *dec, cw_stats_t *stats);
+
+/**
+ * Zero the decoder's statistics.
+ */
+void cw_decoder_reset_stats(cw_decoder_t *dec);
+
 /**
  * Destroy decoder and free all resources.
  */
 void cw_decoder_destroy(cw_decoder_t *dec);
 
+/**
+ * Create n decoders in one cache-line-aligned slab, back to back, for
+ * skimmers running many channels on one thread. The decoders share one
+ * processing scratch instead of one each, so a pool's working set is the
+ * per-channel state alone: call the decoders of a pool from one thread
+ * at a time. Use them with the cw_decoder_* calls; cw_decoder_destroy()
+ * on one releases nothing.
+ *
+ * @param cfgs  Array of n configs (one per decoder, copied)
+ * @param n     Number of decoders
+ * @return      Handle, or NULL on allocation failure / n <= 0
+ */
+cw_decoder_pool_t *cw_decoder_pool_create(const cw_config_t *cfgs, int n);
+
+/**
+ * Decoder i of the pool (NULL if out of range).
+ */
+cw_decoder_t *cw_decoder_pool_get(cw_decoder_pool_t *pool, int i);
+
+/**
+ * Size of the pool's slab in bytes.
+ */
+size_t cw_decoder_pool_bytes(const cw_decoder_pool_t *pool);
+
+/**
+ * Destroy the pool and all its decoders.
+ */
+void cw_decoder_pool_destroy(cw_decoder_pool_t *pool);
+
+/**
+ * Create a multi-channel decoder for streaming use.
+ * All per-channel state is allocated here; process() does no heap traffic.
+ *
+ * @param cfgs  Array of N configs (one per channel, copied)
+ * @param n_ch  Number of channels
+ * @return      Handle, or NULL on allocation failure / n_ch <= 0
+ */
+cw_multi_decoder_t *cw_multi_decoder_create(const cw_config_t *cfgs, int n_ch);
+
+/**
+ * Process one audio chunk for every channel.
+ *
+ * @param md          Multi-channel decoder handle
+ * @param audio       Array of N float pointers (one per channel)
+ * @param n           Number of samples per channel in this chunk
+ * @param out_bufs    Array of N output buffers for decoded ASCII text
+ * @param out_counts  Array of N ints: characters written per channel
+ *                    (not null-terminated)
+ * @param out_len     Size of each output buffer
+ * @return            0 on success, -1 on error
+ */
+int cw_multi_decoder_process(cw_multi_decoder_t *md,
+                             const float **audio, int n,
+                             char **out_bufs, int *out_counts, int out_len);
+
+/**
+ * Spread the lane groups of each block over n workers on the shared
+ * scheduler (task_sched.h), at real-time priority so they run ahead of
+ * slot-end FT8/JS8 work. n is capped at the number of groups; 1 (the
+ * default) runs them on the calling thread. Allocates, so call it
+ * outside the audio path. Text is the same for any n.
+ *
+ * @return 0 on success, -1 on error (n < 1 or allocation failure)
+ */
+int cw_multi_decoder_set_threads(cw_multi_decoder_t *md, int n);
+
+/**
+ * Finalize all channels — flush remaining buffered text.
+ *
+ * @return 0 on success, -1 on error (out_counts as in process())
+ */
+int cw_multi_decoder_finalize(cw_multi_decoder_t *md,
+                              char **out_bufs, int *out_counts, int out_len);
+
+/**
+ * Get current estimated WPM of one channel.
+ */
+float cw_multi_decoder_get_wpm(const cw_multi_decoder_t *md, int ch);
+
+/**
+ * Copy one channel's cumulative statistics. Lane-parallel stages
+ * (bandpass, envelope) are timed per lane group and split evenly over
+ * the group's channels.
+ *
+ * @return 0 on success, -1 on bad arguments
+ */
+int cw_multi_decoder_get_stats(const cw_multi_decoder_t *md, int ch,
+                               cw_stats_t *stats);
+
+/**
+ * Get number of channels.
+ */
+int cw_multi_decoder_channels(const cw_multi_decoder_t *md);
+
+/**
+ * Reset all channels for reuse (same configs).
+ */
+void cw_multi_decoder_reset(cw_multi_decoder_t *md);
+
+/**
+ * Destroy multi-channel decoder and free all resources.
+ */
+void cw_multi_decoder_destroy(cw_multi_decoder_t *md);
+
+/**
+ * Create a channelizer: many CW tones decoded from one audio stream.
+ * The band is split once per block by a shared quadrature filter bank
+ * (FFT bins when that is cheaper than per-channel taps), then each
+ * channel runs its own envelope / timing / output stages.
+ *
+ * @param cfg           Shared config (center_freq and envelope_mode are
+ *                      ignored; bandwidth is the per-channel width)
+ * @param center_freqs  Tone frequency per channel in Hz
+ * @param n_ch          Number of channels
+ * @return              Handle, or NULL on allocation failure / n_ch <= 0
+ */
+cw_channelizer_t *cw_channelizer_create(const cw_config_t *cfg,
+                                        const float *center_freqs, int n_ch);
+
+/**
+ * Process one chunk of the shared audio stream.
+ *
+ * @param cz          Channelizer handle
+ * @param audio       Audio samples (mono, float)
+ * @param n           Number of samples
+ * @param out_bufs    Array of N output buffers for decoded ASCII text
+ * @param out_counts  Array of N ints: characters written per channel
+ * @param out_len     Size of each output buffer
+ * @return            0 on success, -1 on error
+ */
+int cw_channelizer_process(cw_channelizer_t *cz, const float *audio, int n,
+                           char **out_bufs, int *out_counts, int out_len);
+
+/**
+ * Finalize all channels — flush remaining buffered text.
+ */
+int cw_channelizer_finalize(cw_channelizer_t *cz,
+                            char **out_bufs, int *out_counts, int out_len);
+
+/**
+ * Get current estimated WPM of one channel.
+ */
+float cw_channelizer_get_wpm(const cw_channelizer_t *cz, int ch);
+
+/**
+ * Reset all channels for reuse (same config and frequencies).
+ */
+void cw_channelizer_reset(cw_channelizer_t *cz);
+
+/**
+ * Destroy channelizer and free all resources.
+ */
+void cw_channelizer_destroy(cw_channelizer_t *cz);
+
+/**
+ * Create a skimmer: every CW signal that persists in the band gets a
+ * decoder of its own from a pool made here, and gives it back once it
+ * has gone, so the cost follows the signals on the air rather than the
+ * width of the band. Signals are found in power spectrum rows the
+ * caller already has (the shared spectrum engine, ggmorse's STFFT),
+ * smoothed over the keying and held to the noise floor with hysteresis
+ * on both level and time. Feed rows and audio from one thread; neither
+ * allocates.
+ *
+ * @return Handle, or NULL on a bad config / allocation failure
+ */
+cw_skimmer_t *cw_skimmer_create(const cw_skimmer_config_t *cfg);
+
+/**
+ * Feed one power spectrum row: n bins from DC, cfg.bin_hz apart (only
+ * the band is read). Finds, follows, assigns and retires signals.
+ *
+ * @return Active signals, or -1 on bad arguments
+ */
+int cw_skimmer_feed_row(cw_skimmer_t *sk, const float *power, int n);
+
+/**
+ * Decode one chunk of audio on every active slot. A slot retired since
+ * the last call has its buffered text flushed into its buffer here and
+ * is then free; a slot assigned since starts with this chunk.
+ *
+ * @param out_bufs    cfg.max_signals output buffers, one per slot
+ * @param out_counts  cfg.max_signals ints: characters written per slot
+ *                    (not null-terminated)
+ * @param out_len     Size of each output buffer
+ * @return            0 on success, -1 on error
+ */
+int cw_skimmer_process(cw_skimmer_t *sk, const float *audio, int n,
+                       char **out_bufs, int *out_counts, int out_len);
+
+/**
+ * Copy slot i's state (inactive slots have active = 0).
+ *
+ * @return 0 on success, -1 if i is out of range
+ */
+int cw_skimmer_get_signal(const cw_skimmer_t *sk, int i, cw_skimmer_signal_t *sig);
+
+/**
+ * Number of slots (cfg.max_signals).
+ */
+int cw_skimmer_slots(const cw_skimmer_t *sk);
+
+/**
+ * Forget every signal and free every slot (text still buffered is dropped).
+ */
+void cw_skimmer_reset(cw_skimmer_t *sk);
+
+/**
+ * Destroy skimmer, its decoders and free all resources.
+ */
+void cw_skimmer_destroy(cw_skimmer_t *sk);
+
+/**
+ * Create a decoding queue around an existing decoder.
+ *
+ * Three roles, each on at most one thread at a time:
+ *   producer  cw_stream_push() — real-time safe (no locks, allocation
+ *             or system calls), e.g. the audio engine tap
+ *   worker    cw_stream_pump(), or the thread from cw_stream_start()
+ *   reader    cw_stream_read()
+ * The decoder must not be used directly while the stream exists, and
+ * outlives it (cw_stream_destroy() does not destroy it).
+ *
+ * @param dec             Decoder driven by the worker
+ * @param audio_capacity  Queued samples before push() drops (0 = 65536)
+ * @param text_capacity   Queued characters before decode drops (0 = 1024)
+ * @return                Handle, or NULL on allocation failure / dec NULL
+ */
+cw_stream_t *cw_stream_create(cw_decoder_t *dec, int audio_capacity,
+                              int text_capacity);
+
+/**
+ * Producer: queue audio for decoding. Never blocks; samples that do not
+ * fit are dropped and counted (cw_stream_dropped_samples()).
+ *
+ * @return Number of samples queued
+ */
+int cw_stream_push(cw_stream_t *s, const float *audio, int n);
+
+/**
+ * Worker: decode everything queued so far and queue the text.
+ * Not to be called while the built-in worker is running.
+ *
+ * @return Number of samples decoded
+ */
+int cw_stream_pump(cw_stream_t *s);
+
+/**
+ * Start / stop the built-in worker thread, which pumps the queue and
+ * sleeps briefly whenever it is empty. stop() joins the thread; audio
+ * still queued stays queued.
+ *
+ * @return 0 on success, -1 if the thread could not be created
+ */
+int cw_stream_start(cw_stream_t *s);
+void cw_stream_stop(cw_stream_t *s);
+
+/**
+ * Decode the remaining queued audio and flush the decoder's buffered
+ * text into the text queue. Call after cw_stream_stop().
+ *
+ * @return 0 on success, -1 if the built-in worker is running
+ */
+int cw_stream_finalize(cw_stream_t *s);
+
+/**
+ * Reader: take decoded text (not null-terminated).
+ *
+ * @return Number of characters written to out
+ */
+int cw_stream_read(cw_stream_t *s, char *out, int out_len);
+
+/**
+ * Samples dropped by push() / characters dropped on a full text queue
+ * since creation or the last reset.
+ */
+unsigned long cw_stream_dropped_samples(const cw_stream_t *s);
+unsigned long cw_stream_dropped_chars(const cw_stream_t *s);
+
+/**
+ * Empty both queues and reset the decoder. Ignored while the built-in
+ * worker is running; the producer and reader must be idle.
+ */
+void cw_stream_reset(cw_stream_t *s);
+
+/**
+ * Stop the worker (if running) and free the queues.
+ */
+void cw_stream_destroy(cw_stream_t *s);
+
 /**
  * Multi-channel batch API.
  * Decodes N channels in parallel (same audio length per channel).
+ * Bandpass and envelope stages run 4 (SSE2/NEON) or 8 (AVX2)
+ * channels per instruction.
  *
  * @param cfgs      Array of N configs (one per channel)
  * @param n_ch      Number of channels
@@ -0,0 +1,126 @@
+/**
+ * cw_decoder_internal.h — Decoder struct shared by the single- and
+ * multi-channel pipelines. Not part of the public API.
+ */
+
+#ifndef CW_DECODER_INTERNAL_H
+#define CW_DECODER_INTERNAL_H
+
+#include "cw_decoder.h"
+#include "iir_filter.h"
+#include "decimator.h"
+#include "q15.h"
+#include "quadrature.h"
+#include "sdft.h"
+#include "envelope.h"
+#include "timing.h"
+#include "output_filter.h"
+#include "morse_table.h"
+
+/* Maximum pattern length + 1 (longest Morse character has 7 elements;
+ * longer patterns are kept for the merged split lookup) */
+#define MAX_PATTERN 16
+
+/* Samples per processing step (size of the decoder's scratch buffers) */
+#define CW_DECODER_CHUNK 4096
+
+/*
+ * One chunk through front end → envelope → timing → pattern (see
+ * cw_decoder.c). in == work runs in place.
+ */
+typedef int (*cw_pipeline_fn)(cw_decoder_t *dec, const float *in, float *work,
+                              int chunk, char *out, int out_len);
+
+/* Scratch for cw_decoder_process(): filtered chunk (float, int16), runs.
+ * Shared by the decoders of a pool, so only in use during a call. */
+typedef struct {
+    float   work[CW_DECODER_CHUNK];
+    int     runs[CW_DECODER_CHUNK];
+    int16_t work_s16[CW_DECODER_CHUNK];
+} cw_scratch_t;
+
+/*
+ * The struct holds what every configuration uses. The front end in use,
+ * the multipass history and (unless shared) the scratch follow it in the
+ * same block, each on its own cache line, sized for the configuration
+ * (cw_decoder_size()); the pointers of unused parts are NULL.
+ */
+struct cw_decoder_t {
+    cw_config_t cfg;
+    void *block;              /* Allocated by cw_decoder_create(), else NULL */
+
+    /* Chunk pipeline specialized for this configuration */
+    cw_pipeline_fn pipeline;
+
+    /* Bandpass filter (optional — applied if bandwidth > 0) */
+    iir_filter_t bandpass;
+    int use_bandpass;
+
+    /* Quadrature front end (CW_ENVELOPE_QUADRATURE — replaces bandpass) */
+    quadrature_t *quad;
+    int use_quadrature;
+
+    /* Sliding-DFT tone detector (CW_ENVELOPE_SDFT — replaces bandpass and
+     * envelope smoothing, supplies the envelope noise floor) */
+    sdft_t *sdft;
+    int use_sdft;
+
+    /* Decimator after rectification (optional — if detection_rate is set) */
+    decimator_t decimator;
+    int use_decimator;
+    int detect_rate;          /* Envelope/timing rate: sample_rate / factor */
+
+    /* Fixed-point bandpass + decimator (CW_FILTER_Q15; the float ones
+     * above stay designed for the multi-channel lanes) */
+    q15_iir_t *bandpass_q15;
+    q15_decimator_t *decimator_q15;
+    int use_q15;
+    const int16_t *s16_in;    /* Chunk being decoded, for the Q15 front end */
+
+    /* Envelope detector */
+    envelope_t envelope;
+
+    /* Timing classifier */
+    timing_t timing;
+
+    /* Pattern decoder state */
+    morse_code_t pattern;     /* Binary pattern (morse_table.h) */
+    int  pattern_len;
+
+    /* Output filter */
+    output_filter_t output;
+
+    /* Cumulative statistics (see cw_decoder_get_stats()) */
+    cw_stats_t stats;
+
+    /* Input samples decoded since create/reset, stamped on events */
+    int64_t sample_pos;
+
+    cw_scratch_t *scratch;
+};
+
+/**
+ * cw_decoder_init_in() with the scratch at shared (NULL: in the block);
+ * cw_decoder_size() less the scratch then suffices.
+ */
+cw_decoder_t *cw_decoder_init_shared(void *mem, const cw_config_t *cfg,
+                                     cw_scratch_t *shared);
+
+/**
+ * Bytes for a decoder whose scratch is elsewhere (cw_decoder_init_shared()).
+ */
+size_t cw_decoder_size_shared(const cw_config_t *cfg);
+
+/**
+ * Feed one timing element through pattern decoder and output filter.
+ *
+ * @return Number of characters written to out
+ */
+int cw_decoder_feed_element(cw_decoder_t *dec, int elem, char *out, int out_len);
+
+/**
+ * Monotonic clock in nanoseconds (stage timing for cw_stats_t).
+ */
+uint64_t cw_clock_ns(void);
+
+#endif /* CW_DECODER_INTERNAL_H */
@@ -0,0 +1,441 @@
+/**
+ * cw_multi.c — Lane-parallel multi-channel CW decoder
+ *
+ * Bandpass → Envelope run 4/8 channels per instruction on interleaved
+ * buffers, as do the Kalman updates of Timing; the rest of Timing →
+ * Morse → Output run per channel.
+ *
+ * No heap allocation during process() — all state pre-allocated in create().
+ * With several workers the groups of a block are claimed by tasks on the
+ * shared scheduler at real-time priority, each with its own scratch.
+ */
+
+#include "cw_multi.h"
+#include "task_sched.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* ------------------------------------------------------------------ */
+/* Group assignment                                                    */
+/* ------------------------------------------------------------------ */
+
+/* Double-precision bandpass channels run their own filter, not the lane bank */
+static int bandpass_double(const cw_decoder_t *dec)
+{
+    return dec->use_bandpass && dec->bandpass.precision == IIR_PRECISION_DOUBLE;
+}
+
+/* Channels can share a group when decimation and envelope smoothing match */
+static int envelope_compatible(const cw_decoder_t *da, const cw_decoder_t *db)
+{
+    const envelope_t *a = &da->envelope;
+    const envelope_t *b = &db->envelope;
+    if (da->use_quadrature != db->use_quadrature) return 0;
+    if (da->use_quadrature && da->quad->dec.factor != db->quad->dec.factor) return 0;
+    if (da->use_sdft != db->use_sdft) return 0;
+    if (da->use_sdft && da->sdft->factor != db->sdft->factor) return 0;
+    if (da->decimator.factor != db->decimator.factor) return 0;
+    if (bandpass_double(da) != bandpass_double(db)) return 0;
+    if (a->mode != b->mode) return 0;
+    if (a->mode == ENV_MODE_MULTIPASS) {
+        return a->mpf.n_passes == b->mpf.n_passes &&
+               a->mpf.window_size == b->mpf.window_size;
+    }
+    return 1;
+}
+
+static void group_add_channel(cw_multi_decoder_t *md, cw_lane_group_t *g, int ch)
+{
+    cw_decoder_t *dec = md->chans[ch];
+    int lane = g->n_lanes++;
+
+    g->ch[lane] = ch;
+    if (dec->use_bandpass) {
+        iir_lanes_set(&g->bandpass, lane, &dec->bandpass);
+        g->use_bandpass = 1;
+        g->bandpass_double = bandpass_double(dec);
+    }
+    envelope_lanes_set(&g->envelope, lane, &dec->envelope);
+}
+
+static int assign_groups(cw_multi_decoder_t *md)
+{
+    for (int ch = 0; ch < md->n_ch; ch++) {
+        const cw_decoder_t *dec = md->chans[ch];
+        cw_lane_group_t *g = NULL;
+
+        for (int k = 0; k < md->n_groups; k++) {
+            cw_lane_group_t *cand = &md->groups[k];
+            if (cand->n_lanes < md->width &&
+                envelope_compatible(md->chans[cand->ch[0]], dec)) {
+                g = cand;
+                break;
+            }
+        }
+
+        if (!g) {
+            g = &md->groups[md->n_groups++];
+            memset(g, 0, sizeof(*g));
+            iir_lanes_init(&g->bandpass, md->width);
+            decimator_lanes_init(&g->decimator, dec->decimator.factor, md->width);
+            g->use_decimator = dec->use_decimator;
+            g->use_quadrature = dec->use_quadrature;
+            g->use_sdft = dec->use_sdft;
+            if (envelope_lanes_init(&g->envelope, &dec->envelope, md->width) != 0) {
+                return -1;
+            }
+        }
+
+        group_add_channel(md, g, ch);
+    }
+    return 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* Create / destroy                                                    */
+/* ------------------------------------------------------------------ */
+
+static void scratch_free(cw_multi_scratch_t *sc)
+{
+    free(sc->work);
+    free(sc->on_off);
+    free(sc->runs);
+    free(sc->lane_buf);
+}
+
+static int scratch_alloc(cw_multi_scratch_t *sc, int width)
+{
+    sc->work   = (float *)calloc((size_t)CW_MULTI_BLOCK * width, sizeof(float));
+    sc->on_off = (int *)calloc((size_t)CW_MULTI_BLOCK * width, sizeof(int));
+    sc->runs   = (int *)calloc((size_t)CW_MULTI_BLOCK * width, sizeof(int));
+    sc->lane_buf = (float *)calloc(CW_MULTI_BLOCK, sizeof(float));
+    if (!sc->work || !sc->on_off || !sc->runs || !sc->lane_buf) {
+        scratch_free(sc);
+        return -1;
+    }
+    kalman_lanes_init(&sc->kalman, width);
+    return 0;
+}
+
+cw_multi_decoder_t *cw_multi_decoder_create(const cw_config_t *cfgs, int n_ch)
+{
+    if (n_ch <= 0) return NULL;
+
+    cw_multi_decoder_t *md = (cw_multi_decoder_t *)calloc(1, sizeof(cw_multi_decoder_t));
+    if (!md) return NULL;
+
+    md->width = cw_get_kernels()->lane_width;
+    md->n_ch = n_ch;
+
+    md->chans  = (cw_decoder_t **)calloc((size_t)n_ch, sizeof(cw_decoder_t *));
+    md->groups = (cw_lane_group_t *)calloc((size_t)n_ch, sizeof(cw_lane_group_t));
+    md->scratch = (cw_multi_scratch_t *)calloc(1, sizeof(cw_multi_scratch_t));
+    if (!md->chans || !md->groups || !md->scratch ||
+        scratch_alloc(&md->scratch[0], md->width) != 0) {
+        cw_multi_decoder_destroy(md);
+        return NULL;
+    }
+    md->n_workers = 1;
+
+    /* Per-channel state packed in one slab */
+    md->pool = cw_decoder_pool_create(cfgs, n_ch);
+    if (!md->pool) {
+        cw_multi_decoder_destroy(md);
+        return NULL;
+    }
+    for (int ch = 0; ch < n_ch; ch++) md->chans[ch] = cw_decoder_pool_get(md->pool, ch);
+
+    if (assign_groups(md) != 0) {
+        cw_multi_decoder_destroy(md);
+        return NULL;
+    }
+
+    /* Worst case is one group per channel — give back the unused tail */
+    cw_lane_group_t *groups = (cw_lane_group_t *)realloc(
+        md->groups, (size_t)md->n_groups * sizeof(cw_lane_group_t));
+    if (groups) md->groups = groups;
+
+    return md;
+}
+
+void cw_multi_decoder_destroy(cw_multi_decoder_t *md)
+{
+    if (!md) return;
+    cw_decoder_pool_destroy(md->pool);
+    free(md->chans);
+    if (md->groups) {
+        for (int k = 0; k < md->n_groups; k++) {
+            envelope_lanes_free(&md->groups[k].envelope);
+        }
+    }
+    free(md->groups);
+    if (md->scratch) {
+        for (int k = 0; k < md->n_workers; k++) scratch_free(&md->scratch[k]);
+    }
+    free(md->scratch);
+    free(md);
+}
+
+int cw_multi_decoder_set_threads(cw_multi_decoder_t *md, int n)
+{
+    if (!md || n < 1) return -1;
+    if (n > md->n_groups) n = md->n_groups;
+    if (n == md->n_workers) return 0;
+
+    cw_multi_scratch_t *scratch = (cw_multi_scratch_t *)calloc((size_t)n,
+                                                               sizeof(cw_multi_scratch_t));
+    if (!scratch) return -1;
+    for (int k = 0; k < n; k++) {
+        if (k < md->n_workers) {
+            scratch[k] = md->scratch[k];
+        } else if (scratch_alloc(&scratch[k], md->width) != 0) {
+            for (int j = md->n_workers; j < k; j++) scratch_free(&scratch[j]);
+            free(scratch);
+            return -1;
+        }
+    }
+    for (int k = n; k < md->n_workers; k++) scratch_free(&md->scratch[k]);
+    free(md->scratch);
+    md->scratch = scratch;
+    md->n_workers = n;
+    return 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* Process                                                             */
+/* ------------------------------------------------------------------ */
+
+static void group_process(cw_multi_decoder_t *md, cw_lane_group_t *g,
+                          cw_multi_scratch_t *sc,
+                          const float **audio, int offset, int len,
+                          char **out_bufs, int *written, int out_len)
+{
+    int w = md->width;
+    float *work = sc->work;
+    int *on_off = sc->on_off;
+    int in_len = len;
+    int timed = 0;
+    for (int l = 0; l < g->n_lanes; l++) timed |= md->chans[g->ch[l]]->cfg.collect_stats;
+    uint64_t t0 = timed ? cw_clock_ns() : 0;
+
+    if (md->front) {
+        /* Step 1: Shared front end already ran — interleave its output */
+        len = md->front_len;
+        memset(work, 0, (size_t)len * w * sizeof(float));
+        for (int l = 0; l < g->n_lanes; l++) {
+            const float *src = md->front + (size_t)g->ch[l] * CW_MULTI_BLOCK;
+            for (int i = 0; i < len; i++) work[i * w + l] = src[i];
+        }
+    } else if (g->use_quadrature) {
+        /* Step 1: Quadrature front end per channel, interleave magnitudes */
+        int m = 0;
+        memset(work, 0, (size_t)len * w * sizeof(float));
+        for (int l = 0; l < g->n_lanes; l++) {
+            cw_decoder_t *dec = md->chans[g->ch[l]];
+            m = quadrature_process(dec->quad, audio[g->ch[l]] + offset, len,
+                                   sc->lane_buf);
+            for (int i = 0; i < m; i++) work[i * w + l] = sc->lane_buf[i];
+        }
+        len = m;
+    } else if (g->use_sdft) {
+        /* Step 1: Sliding DFT per channel, interleave magnitudes */
+        int m = 0;
+        memset(work, 0, (size_t)len * w * sizeof(float));
+        for (int l = 0; l < g->n_lanes; l++) {
+            cw_decoder_t *dec = md->chans[g->ch[l]];
+            m = sdft_process(dec->sdft, audio[g->ch[l]] + offset, len,
+                             sc->lane_buf);
+            for (int i = 0; i < m; i++) work[i * w + l] = sc->lane_buf[i];
+            g->envelope.noise_level[l] = dec->sdft->noise;
+        }
+        len = m;
+    } else {
+        if (g->bandpass_double) {
+            /* Step 1: Double-precision bandpass per channel, interleave */
+            memset(work, 0, (size_t)len * w * sizeof(float));
+            for (int l = 0; l < g->n_lanes; l++) {
+                cw_decoder_t *dec = md->chans[g->ch[l]];
+                memcpy(sc->lane_buf, audio[g->ch[l]] + offset, (size_t)len * sizeof(float));
+                iir_filter_process(&dec->bandpass, sc->lane_buf, len);
+                for (int i = 0; i < len; i++) work[i * w + l] = sc->lane_buf[i];
+            }
+        } else {
+            /* Interleave: work[i * w + lane] */
+            for (int i = 0; i < len; i++) {
+                float *dst = work + i * w;
+                int l = 0;
+                for (; l < g->n_lanes; l++) dst[l] = audio[g->ch[l]][offset + i];
+                for (; l < w; l++) dst[l] = 0.0f;
+            }
+
+            /* Step 1: Bandpass filter (all lanes at once) */
+            if (g->use_bandpass) {
+                iir_lanes_process(&g->bandpass, work, len);
+            }
+        }
+
+        /* Step 1b: Rectify + decimate to the detection rate */
+        if (g->use_decimator) {
+            cw_get_kernels()->rectify(work, work, len * w);
+            len = decimator_lanes_process(&g->decimator, work, len, work);
+        }
+    }
+
+    uint64_t t1 = timed ? cw_clock_ns() : 0;
+
+    /* Step 2: Envelope detection → on/off (all lanes at once) */
+    envelope_lanes_process(&g->envelope, work, on_off, len);
+
+    /* Step 3: On/off runs per channel */
+    int *lane_runs[IIR_MAX_LANES], n_runs[IIR_MAX_LANES], n_elems[IIR_MAX_LANES];
+    for (int l = 0; l < g->n_lanes; l++) {
+        lane_runs[l] = sc->runs + (size_t)l * CW_MULTI_BLOCK;
+        n_runs[l] = envelope_lanes_runs(on_off, len, w, l, lane_runs[l]);
+    }
+    uint64_t t3 = timed ? cw_clock_ns() : 0;
+
+    /* Step 4: Timing (per transition); Kalman channels share the lane bank */
+    timing_t *bank[IIR_MAX_LANES];
+    int *bank_runs[IIR_MAX_LANES], bank_n[IIR_MAX_LANES], bank_lane[IIR_MAX_LANES];
+    int n_bank = 0;
+    for (int l = 0; l < g->n_lanes; l++) {
+        timing_t *t = &md->chans[g->ch[l]]->timing;
+        if (t->mode == TIMING_MODE_KALMAN && !t->use_hmm) {
+            bank[n_bank] = t;
+            bank_runs[n_bank] = lane_runs[l];
+            bank_n[n_bank] = n_runs[l];
+            bank_lane[n_bank++] = l;
+        } else {
+            n_elems[l] = timing_process_runs(t, lane_runs[l], n_runs[l], lane_runs[l]);
+        }
+    }
+    if (n_bank > 0) {
+        int bank_elems[IIR_MAX_LANES];
+        timing_process_runs_lanes(bank, n_bank, &sc->kalman, bank_runs, bank_n, bank_elems);
+        for (int b = 0; b < n_bank; b++) n_elems[bank_lane[b]] = bank_elems[b];
+    }
+    uint64_t t4 = timed ? cw_clock_ns() : 0;
+
+    /* Step 5: Pattern → Output filter, per channel */
+    for (int l = 0; l < g->n_lanes; l++) {
+        int ch = g->ch[l];
+        cw_decoder_t *dec = md->chans[ch];
+        char *out = out_bufs[ch];
+        int pos = written[ch];
+        const int *elems = lane_runs[l];
+
+        cw_stats_t *st = &dec->stats;
+        uint64_t r0 = timed ? cw_clock_ns() : 0;
+
+        dec->output.stamp = dec->sample_pos + in_len;
+        for (int i = 0; i < n_elems[l] && pos < out_len; i++) {
+            pos += cw_decoder_feed_element(dec, elems[i], out + pos, out_len - pos);
+        }
+        written[ch] = pos;
+
+        st->samples += (uint64_t)in_len;
+        dec->sample_pos += in_len;
+        st->elements += (uint64_t)n_elems[l];
+        if (timed && dec->cfg.collect_stats) {
+            /* Group stages are shared evenly by the group's channels */
+            st->bandpass_ns += (t1 - t0) / (uint64_t)g->n_lanes;
+            st->envelope_ns += (t3 - t1) / (uint64_t)g->n_lanes;
+            st->timing_ns += (t4 - t3) / (uint64_t)g->n_lanes;
+            st->pattern_ns += cw_clock_ns() - r0;
+        }
+    }
+}
+
+int cw_multi_decoder_process(cw_multi_decoder_t *md,
+                             const float **audio, int n,
+                             char **out_bufs, int *out_counts, int out_len)
+{
+    if (!md || !audio || !out_bufs || !out_counts) return -1;
+
+    for (int ch = 0; ch < md->n_ch; ch++) out_counts[ch] = 0;
+    if (n <= 0 || out_len <= 0) return 0;
+
+    for (int offset = 0; offset < n; offset += CW_MULTI_BLOCK) {
+        int len = n - offset;
+        if (len > CW_MULTI_BLOCK) len = CW_MULTI_BLOCK;
+
+        cw_multi_process_block(md, audio, offset, len, out_bufs, out_counts, out_len);
+    }
+    return 0;
+}
+
+/* Groups touch disjoint channels, so workers only share the counter */
+static void block_stage(void *ctx, int worker)
+{
+    cw_multi_decoder_t *md = (cw_multi_decoder_t *)ctx;
+    const cw_multi_block_t *b = &md->block;
+
+    for (int k; (k = atomic_fetch_add_explicit(&md->next_group, 1,
+                                               memory_order_relaxed)) < md->n_groups; ) {
+        group_process(md, &md->groups[k], &md->scratch[worker], b->audio, b->offset,
+                      b->len, b->out_bufs, b->written, b->out_len);
+    }
+}
+
+void cw_multi_process_block(cw_multi_decoder_t *md, const float **audio,
+                            int offset, int len,
+                            char **out_bufs, int *written, int out_len)
+{
+    if (md->n_workers == 1) {
+        for (int k = 0; k < md->n_groups; k++) {
+            group_process(md, &md->groups[k], &md->scratch[0], audio, offset, len,
+                          out_bufs, written, out_len);
+        }
+        return;
+    }
+
+    md->block = (cw_multi_block_t){ audio, offset, len, out_bufs, written, out_len };
+    atomic_store_explicit(&md->next_group, 0, memory_order_relaxed);
+    task_sched_parallel(task_sched_shared(), TASK_PRIO_REALTIME, md->n_workers,
+                        block_stage, md);
+}
+
+int cw_multi_decoder_finalize(cw_multi_decoder_t *md,
+                              char **out_bufs, int *out_counts, int out_len)
+{
+    if (!md || !out_bufs || !out_counts) return -1;
+
+    for (int ch = 0; ch < md->n_ch; ch++) {
+        out_counts[ch] = (out_len > 0)
+                       ? cw_decoder_finalize(md->chans[ch], out_bufs[ch], out_len)
+                       : 0;
+    }
+    return 0;
+}
+
+float cw_multi_decoder_get_wpm(const cw_multi_decoder_t *md, int ch)
+{
+    if (!md || ch < 0 || ch >= md->n_ch) return 0.0f;
+    return cw_decoder_get_wpm(md->chans[ch]);
+}
+
+int cw_multi_decoder_get_stats(const cw_multi_decoder_t *md, int ch,
+                               cw_stats_t *stats)
+{
+    if (!md || ch < 0 || ch >= md->n_ch) return -1;
+    return cw_decoder_get_stats(md->chans[ch], stats);
+}
+
+int cw_multi_decoder_channels(const cw_multi_decoder_t *md)
+{
+    return md ? md->n_ch : 0;
+}
+
+void cw_multi_decoder_reset(cw_multi_decoder_t *md)
+{
+    for (int ch = 0; ch < md->n_ch; ch++) {
+        cw_decoder_reset(md->chans[ch]);
+    }
+    for (int k = 0; k < md->n_groups; k++) {
+        cw_lane_group_t *g = &md->groups[k];
+        iir_lanes_reset(&g->bandpass);
+        decimator_lanes_reset(&g->decimator);
+        envelope_lanes_reset(&g->envelope);
+    }
+}
@@ -0,0 +1,102 @@
+/**
+ * cw_multi.h — Lane-parallel multi-channel CW engine (internal)
+ *
+ * Channels are packed into lane groups of 4 (SSE2/NEON) or 8 (AVX2).
+ * Bandpass and envelope state of a group is kept in struct-of-arrays
+ * form so one vector instruction advances every channel in the group;
+ * timing, pattern and output stages run per channel on the resulting
+ * on/off stream.
+ *
+ * Public API: cw_multi_decoder_*() in cw_decoder.h.
+ */
+
+#ifndef CW_MULTI_H
+#define CW_MULTI_H
+
+#include "cw_decoder_internal.h"
+#include "simd_detect.h"
+
+#include <stdatomic.h>
+
+/* Samples per lane processed per step (same chunking as cw_decoder_process) */
+#define CW_MULTI_BLOCK 4096
+
+/* Buffers one worker runs a group through */
+typedef struct {
+    /* Interleaved work buffers, CW_MULTI_BLOCK * width each */
+    float *work;
+    int   *on_off;
+
+    /* On/off runs / elements, CW_MULTI_BLOCK per lane */
+    int   *runs;
+
+    /* Kalman timing of the group's Kalman-mode channels, lane-parallel */
+    kalman_lanes_t kalman;
+
+    /* One lane's front-end output (quadrature / sdft groups), CW_MULTI_BLOCK */
+    float *lane_buf;
+} cw_multi_scratch_t;
+
+/* Arguments of cw_multi_process_block(), for the workers */
+typedef struct {
+    const float **audio;
+    int offset;
+    int len;
+    char **out_bufs;
+    int *written;
+    int out_len;
+} cw_multi_block_t;
+
+/* Channels sharing one set of SIMD registers */
+typedef struct {
+    int n_lanes;                   /* Active lanes (<= width) */
+    int ch[IIR_MAX_LANES];         /* Channel index per lane */
+
+    int use_quadrature;            /* Per-channel quadrature front end */
+    int use_sdft;                  /* Per-channel sliding-DFT front end */
+    int use_bandpass;
+    int bandpass_double;           /* Per-channel double-precision bandpass */
+    iir_lanes_t bandpass;
+    int use_decimator;
+    decimator_lanes_t decimator;
+    envelope_lanes_t envelope;
+} cw_lane_group_t;
+
+struct cw_multi_decoder_t {
+    int n_ch;
+    int width;                     /* Lane stride: 4 or 8 (kernel lane width) */
+
+    /* Per-channel timing / pattern / output state, in one pool */
+    cw_decoder_pool_t *pool;
+    cw_decoder_t **chans;
+
+    int n_groups;
+    cw_lane_group_t *groups;
+
+    /* One scratch set per worker (cw_multi_decoder_set_threads) */
+    int n_workers;
+    cw_multi_scratch_t *scratch;
+
+    /* Block being spread over the workers, and the next group to claim */
+    cw_multi_block_t block;
+    atomic_int next_group;
+
+    /*
+     * Precomputed front-end output for the current block (channelizer):
+     * channel ch's magnitudes at front[ch * CW_MULTI_BLOCK], front_len
+     * each. NULL when each channel runs its own front end.
+     */
+    const float *front;
+    int front_len;
+};
+
+/**
+ * Run one block (len <= CW_MULTI_BLOCK samples at offset) through every
+ * group, spread over the workers; written[ch] is advanced by the
+ * characters produced.
+ */
+void cw_multi_process_block(cw_multi_decoder_t *md, const float **audio,
+                            int offset, int len,
+                            char **out_bufs, int *written, int out_len);
+
+#endif /* CW_MULTI_H */
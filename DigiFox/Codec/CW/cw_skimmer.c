@@ -0,0 +1,413 @@
+/**
+ * cw_skimmer.c — A decoder for every CW signal in the band
+ *
+ * Each fed spectrum row is averaged per bin (one pole over average_s,
+ * which bridges the key-up gaps) and the noise floor is the median of
+ * the averaged band. Local maxima snr_on_db over the floor, strongest
+ * first and min_spacing apart, are the row's peaks.
+ *
+ * A peak no signal claims starts a candidate; a candidate seen in every
+ * row for spawn_s takes a free decoder from the pool, retuned in place
+ * to its frequency and reset. A signal follows the nearest peak within
+ * half the spacing and stays on while its bin holds snr_off_db over the
+ * floor, peak or not; after retire_s below it the next process() call
+ * flushes its decoder and frees the slot. A signal drifting more than a
+ * quarter of the bandwidth retunes its decoder in place, keeping the
+ * speed estimate.
+ */
+
+#include "cw_decoder.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum { SLOT_FREE, SLOT_ACTIVE, SLOT_RETIRED };
+
+typedef struct {
+    int      state;
+    uint32_t id;
+    float    freq;
+    float    tuned;            /* The decoder's center_freq */
+    float    snr_db;
+    int      rows_off;         /* Rows below snr_off_db in a row */
+    uint64_t samples;          /* Decoded since assigned */
+} skim_slot_t;
+
+typedef struct {
+    float freq;
+    int   rows;                /* Rows seen in a row, 0 = unused */
+} skim_cand_t;
+
+typedef struct {
+    float freq;
+    float power;
+    int   taken;
+} skim_peak_t;
+
+struct cw_skimmer_t {
+    cw_skimmer_config_t cfg;
+    cw_decoder_pool_t *pool;
+
+    skim_slot_t *slots;        /* max_signals */
+    skim_cand_t *cands;        /* n_cands */
+    int n_cands;
+    uint32_t next_id;
+
+    /* Band bins b0 .. b1 of the averaged spectrum */
+    int    b0, b1;
+    float *avg;                /* b1 + 1, from DC */
+    float *sorted;             /* Band, median scratch */
+    skim_peak_t *peaks;        /* Band */
+    int    primed;
+
+    float alpha;               /* Row averaging */
+    float on_ratio, off_ratio; /* Power over the floor */
+    int   spawn_rows, retire_rows;
+};
+
+void cw_skimmer_config_init(cw_skimmer_config_t *cfg)
+{
+    memset(cfg, 0, sizeof(*cfg));
+    cw_config_init(&cfg->decoder);
+    cfg->max_signals = 16;
+    cfg->bin_hz      = 3.125f;
+    cfg->row_s       = 0.04f;
+    cfg->f_min       = 200.0f;
+    cfg->f_max       = 1200.0f;
+    cfg->min_spacing = 50.0f;
+    cfg->average_s   = 0.5f;
+    cfg->snr_on_db   = 10.0f;
+    cfg->snr_off_db  = 6.0f;
+    cfg->spawn_s     = 0.4f;
+    cfg->retire_s    = 5.0f;
+}
+
+/* ------------------------------------------------------------------ */
+/* Create / destroy                                                    */
+/* ------------------------------------------------------------------ */
+
+cw_skimmer_t *cw_skimmer_create(const cw_skimmer_config_t *cfg)
+{
+    if (!cfg || cfg->max_signals <= 0 || cfg->bin_hz <= 0.0f || cfg->row_s <= 0.0f ||
+        cfg->f_min < 0.0f || cfg->f_max <= cfg->f_min || cfg->min_spacing <= 0.0f ||
+        cfg->f_max >= 0.5f * (float)cfg->decoder.sample_rate) {
+        return NULL;
+    }
+
+    int b0 = (int)ceilf(cfg->f_min / cfg->bin_hz);
+    int b1 = (int)floorf(cfg->f_max / cfg->bin_hz);
+    if (b0 < 1) b0 = 1;
+    if (b1 - b0 < 2) return NULL;
+
+    cw_skimmer_t *sk = (cw_skimmer_t *)calloc(1, sizeof(cw_skimmer_t));
+    if (!sk) return NULL;
+    sk->cfg = *cfg;
+    sk->b0 = b0;
+    sk->b1 = b1;
+
+    /* Enough candidates for every peak the band can hold */
+    int n_band = b1 - b0 + 1;
+    sk->n_cands = (int)((cfg->f_max - cfg->f_min) / cfg->min_spacing) + 1;
+
+    cw_config_t *cfgs = (cw_config_t *)calloc((size_t)cfg->max_signals, sizeof(cw_config_t));
+    if (cfgs) {
+        for (int i = 0; i < cfg->max_signals; i++) cfgs[i] = cfg->decoder;
+        sk->pool = cw_decoder_pool_create(cfgs, cfg->max_signals);
+        free(cfgs);
+    }
+    sk->slots = (skim_slot_t *)calloc((size_t)cfg->max_signals, sizeof(skim_slot_t));
+    sk->cands = (skim_cand_t *)calloc((size_t)sk->n_cands, sizeof(skim_cand_t));
+    sk->avg = (float *)calloc((size_t)b1 + 1, sizeof(float));
+    sk->sorted = (float *)calloc((size_t)n_band, sizeof(float));
+    sk->peaks = (skim_peak_t *)calloc((size_t)n_band, sizeof(skim_peak_t));
+    if (!sk->pool || !sk->slots || !sk->cands || !sk->avg || !sk->sorted || !sk->peaks) {
+        cw_skimmer_destroy(sk);
+        return NULL;
+    }
+
+    sk->alpha = cfg->average_s > cfg->row_s ? 1.0f - expf(-cfg->row_s / cfg->average_s) : 1.0f;
+    sk->on_ratio = powf(10.0f, 0.1f * cfg->snr_on_db);
+    sk->off_ratio = powf(10.0f, 0.1f * cfg->snr_off_db);
+    sk->spawn_rows = (int)ceilf(cfg->spawn_s / cfg->row_s);
+    sk->retire_rows = (int)ceilf(cfg->retire_s / cfg->row_s);
+    if (sk->spawn_rows < 1) sk->spawn_rows = 1;
+    if (sk->retire_rows < 1) sk->retire_rows = 1;
+    return sk;
+}
+
+void cw_skimmer_reset(cw_skimmer_t *sk)
+{
+    if (!sk) return;
+    memset(sk->slots, 0, sizeof(skim_slot_t) * (size_t)sk->cfg.max_signals);
+    memset(sk->cands, 0, sizeof(skim_cand_t) * (size_t)sk->n_cands);
+    sk->primed = 0;
+}
+
+void cw_skimmer_destroy(cw_skimmer_t *sk)
+{
+    if (!sk) return;
+    cw_decoder_pool_destroy(sk->pool);
+    free(sk->slots);
+    free(sk->cands);
+    free(sk->avg);
+    free(sk->sorted);
+    free(sk->peaks);
+    free(sk);
+}
+
+/* ------------------------------------------------------------------ */
+/* Detection                                                           */
+/* ------------------------------------------------------------------ */
+
+/* k-th smallest of x[0..n), reordering x (Hoare's selection) */
+static float select_kth(float *x, int n, int k)
+{
+    int lo = 0, hi = n - 1;
+    while (lo < hi) {
+        float pivot = x[(lo + hi) / 2];
+        int i = lo, j = hi;
+        while (i <= j) {
+            while (x[i] < pivot) i++;
+            while (x[j] > pivot) j--;
+            if (i <= j) {
+                float t = x[i]; x[i] = x[j]; x[j] = t;
+                i++;
+                j--;
+            }
+        }
+        if (k <= j) hi = j;
+        else if (k >= i) lo = i;
+        else break;
+    }
+    return x[k];
+}
+
+static int peak_cmp(const void *a, const void *b)
+{
+    float pa = ((const skim_peak_t *)a)->power, pb = ((const skim_peak_t *)b)->power;
+    return (pa < pb) - (pa > pb);
+}
+
+/* Peaks over the floor, strongest first, min_spacing apart */
+static int find_peaks(cw_skimmer_t *sk, float floor_power)
+{
+    const float *a = sk->avg;
+    float thresh = floor_power * sk->on_ratio;
+    int n = 0;
+    for (int b = sk->b0 + 1; b < sk->b1; b++) {
+        if (a[b] <= thresh || a[b] <= a[b - 1] || a[b] < a[b + 1]) continue;
+        /* Parabolic interpolation between the neighbours */
+        float den = a[b - 1] - 2.0f * a[b] + a[b + 1];
+        float d = den < 0.0f ? 0.5f * (a[b - 1] - a[b + 1]) / den : 0.0f;
+        sk->peaks[n].freq = ((float)b + d) * sk->cfg.bin_hz;
+        sk->peaks[n].power = a[b];
+        sk->peaks[n].taken = 0;
+        n++;
+    }
+    qsort(sk->peaks, (size_t)n, sizeof(skim_peak_t), peak_cmp);
+
+    int kept = 0;
+    for (int i = 0; i < n; i++) {
+        int clear = 1;
+        for (int j = 0; j < kept && clear; j++) {
+            clear = fabsf(sk->peaks[i].freq - sk->peaks[j].freq) >= sk->cfg.min_spacing;
+        }
+        if (clear) sk->peaks[kept++] = sk->peaks[i];
+    }
+    return kept;
+}
+
+/* Nearest untaken peak within half the spacing of f, or -1 */
+static int claim_peak(cw_skimmer_t *sk, int n_peaks, float f)
+{
+    int best = -1;
+    float best_d = 0.5f * sk->cfg.min_spacing;
+    for (int i = 0; i < n_peaks; i++) {
+        float d = fabsf(sk->peaks[i].freq - f);
+        if (!sk->peaks[i].taken && d <= best_d) {
+            best = i;
+            best_d = d;
+        }
+    }
+    if (best >= 0) sk->peaks[best].taken = 1;
+    return best;
+}
+
+static float to_db(float ratio)
+{
+    return 10.0f * log10f(ratio > 1e-12f ? ratio : 1e-12f);
+}
+
+/* Give a free decoder to a signal at f; -1 if the pool is in use */
+static int assign_slot(cw_skimmer_t *sk, float f, float snr_db)
+{
+    for (int i = 0; i < sk->cfg.max_signals; i++) {
+        skim_slot_t *s = &sk->slots[i];
+        if (s->state != SLOT_FREE) continue;
+
+        cw_decoder_t *dec = cw_decoder_pool_get(sk->pool, i);
+        cw_config_t cfg = sk->cfg.decoder;
+        cfg.center_freq = f;
+        if (cw_decoder_reconfigure(dec, &cfg) != 0) return -1;
+        cw_decoder_reset(dec);
+
+        if (++sk->next_id == 0) sk->next_id = 1;
+        s->state = SLOT_ACTIVE;
+        s->id = sk->next_id;
+        s->freq = f;
+        s->tuned = f;
+        s->snr_db = snr_db;
+        s->rows_off = 0;
+        s->samples = 0;
+        return i;
+    }
+    return -1;
+}
+
+int cw_skimmer_feed_row(cw_skimmer_t *sk, const float *power, int n)
+{
+    if (!sk || !power || n <= sk->b1) return -1;
+    const cw_skimmer_config_t *cfg = &sk->cfg;
+
+    float *a = sk->avg;
+    int b0 = sk->b0, b1 = sk->b1, n_band = b1 - b0 + 1;
+    if (!sk->primed) {
+        memcpy(a + b0, power + b0, sizeof(float) * (size_t)n_band);
+        sk->primed = 1;
+    } else {
+        for (int b = b0; b <= b1; b++) a[b] += sk->alpha * (power[b] - a[b]);
+    }
+
+    memcpy(sk->sorted, a + b0, sizeof(float) * (size_t)n_band);
+    float floor_power = select_kth(sk->sorted, n_band, n_band / 2);
+    if (floor_power < 1e-20f) floor_power = 1e-20f;
+
+    int n_peaks = find_peaks(sk, floor_power);
+
+    /* Signals: follow their peak, or hold on at the off level */
+    float drift = 0.25f * cfg->decoder.bandwidth;
+    for (int i = 0; i < cfg->max_signals; i++) {
+        skim_slot_t *s = &sk->slots[i];
+        if (s->state != SLOT_ACTIVE) continue;
+
+        int p = claim_peak(sk, n_peaks, s->freq);
+        float level;
+        if (p >= 0) {
+            s->freq += 0.5f * (sk->peaks[p].freq - s->freq);
+            level = sk->peaks[p].power;
+        } else {
+            int b = (int)lroundf(s->freq / cfg->bin_hz);
+            level = a[b < b0 ? b0 : b > b1 ? b1 : b];
+        }
+        float ratio = level / floor_power;
+        s->snr_db += 0.25f * (to_db(ratio) - s->snr_db);
+
+        if (p >= 0 || ratio > sk->off_ratio) {
+            s->rows_off = 0;
+        } else if (++s->rows_off >= sk->retire_rows) {
+            s->state = SLOT_RETIRED;
+            continue;
+        }
+
+        if (fabsf(s->freq - s->tuned) > drift) {
+            cw_config_t dcfg = cfg->decoder;
+            dcfg.center_freq = s->freq;
+            if (cw_decoder_reconfigure(cw_decoder_pool_get(sk->pool, i), &dcfg) == 0) {
+                s->tuned = s->freq;
+            }
+        }
+    }
+
+    /* Candidates: seen again, or dropped; promoted once seen long enough */
+    for (int c = 0; c < sk->n_cands; c++) {
+        skim_cand_t *cd = &sk->cands[c];
+        if (!cd->rows) continue;
+
+        int p = claim_peak(sk, n_peaks, cd->freq);
+        if (p < 0) {
+            cd->rows = 0;
+            continue;
+        }
+        cd->freq += 0.5f * (sk->peaks[p].freq - cd->freq);
+        if (++cd->rows >= sk->spawn_rows &&
+            assign_slot(sk, cd->freq, to_db(sk->peaks[p].power / floor_power)) >= 0) {
+            cd->rows = 0;
+        }
+    }
+
+    /* Peaks nobody claimed start candidates, clear of every signal */
+    for (int i = 0, c = 0; i < n_peaks; i++) {
+        if (sk->peaks[i].taken) continue;
+        float f = sk->peaks[i].freq;
+
+        int clear = 1;
+        for (int j = 0; j < cfg->max_signals && clear; j++) {
+            clear = sk->slots[j].state != SLOT_ACTIVE ||
+                    fabsf(sk->slots[j].freq - f) >= cfg->min_spacing;
+        }
+        if (!clear) continue;
+
+        while (c < sk->n_cands && sk->cands[c].rows) c++;
+        if (c == sk->n_cands) break;
+        sk->cands[c].freq = f;
+        sk->cands[c].rows = 1;
+        if (sk->spawn_rows <= 1 &&
+            assign_slot(sk, f, to_db(sk->peaks[i].power / floor_power)) >= 0) {
+            sk->cands[c].rows = 0;
+        }
+    }
+
+    int active = 0;
+    for (int i = 0; i < cfg->max_signals; i++) active += sk->slots[i].state == SLOT_ACTIVE;
+    return active;
+}
+
+/* ------------------------------------------------------------------ */
+/* Decoding                                                            */
+/* ------------------------------------------------------------------ */
+
+int cw_skimmer_process(cw_skimmer_t *sk, const float *audio, int n,
+                       char **out_bufs, int *out_counts, int out_len)
+{
+    if (!sk || !audio || n < 0 || !out_bufs || !out_counts) return -1;
+
+    for (int i = 0; i < sk->cfg.max_signals; i++) {
+        skim_slot_t *s = &sk->slots[i];
+        cw_decoder_t *dec = cw_decoder_pool_get(sk->pool, i);
+        out_counts[i] = 0;
+
+        if (s->state == SLOT_RETIRED) {
+            out_counts[i] = cw_decoder_finalize(dec, out_bufs[i], out_len);
+            s->state = SLOT_FREE;
+        } else if (s->state == SLOT_ACTIVE) {
+            int w = cw_decoder_process(dec, audio, n, out_bufs[i], out_len);
+            if (w < 0) return -1;
+            out_counts[i] = w;
+            s->samples += (uint64_t)n;
+        }
+    }
+    return 0;
+}
+
+int cw_skimmer_get_signal(const cw_skimmer_t *sk, int i, cw_skimmer_signal_t *sig)
+{
+    if (!sk || !sig || i < 0 || i >= sk->cfg.max_signals) return -1;
+
+    const skim_slot_t *s = &sk->slots[i];
+    memset(sig, 0, sizeof(*sig));
+    if (s->state != SLOT_ACTIVE) return 0;
+
+    sig->active = 1;
+    sig->id = s->id;
+    sig->freq = s->freq;
+    sig->snr_db = s->snr_db;
+    sig->wpm = cw_decoder_get_wpm(cw_decoder_pool_get(sk->pool, i));
+    sig->age_s = (double)s->samples / (double)sk->cfg.decoder.sample_rate;
+    return 0;
+}
+
+int cw_skimmer_slots(const cw_skimmer_t *sk)
+{
+    return sk ? sk->cfg.max_signals : 0;
+}
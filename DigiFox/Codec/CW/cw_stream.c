@@ -0,0 +1,194 @@
+/**
+ * cw_stream.c — Queued decoding: audio callback → worker → text reader
+ *
+ * Two spsc_ring_t queues around one decoder. The audio thread only
+ * copies samples into the first ring; the worker (cw_stream_pump(), or
+ * the built-in thread from cw_stream_start()) drains it in blocks,
+ * decodes in place and appends the text to the second ring, which the
+ * UI side empties with cw_stream_read().
+ */
+
+#include "cw_decoder.h"
+#include "spsc_ring.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Samples decoded per worker step */
+#define CW_STREAM_BLOCK 4096
+
+/* Text per block: a character takes well over 16 samples at any rate */
+#define CW_STREAM_TEXT_BLOCK (CW_STREAM_BLOCK / 16)
+
+/* Default queue sizes (cw_stream_create() with capacity 0) */
+#define CW_STREAM_DEFAULT_AUDIO 65536
+#define CW_STREAM_DEFAULT_TEXT  1024
+
+/* Built-in worker's sleep when the audio queue is empty */
+#define CW_STREAM_IDLE_NS 2000000L
+
+struct cw_stream_t {
+    cw_decoder_t *dec;
+
+    spsc_ring_t audio;             /* float: audio thread → worker */
+    spsc_ring_t text;              /* char: worker → reader */
+
+    _Atomic unsigned long audio_dropped;
+    _Atomic unsigned long text_dropped;
+
+    /* Built-in worker */
+    pthread_t thread;
+    int thread_started;
+    _Atomic int running;
+
+    /* Worker scratch */
+    float block[CW_STREAM_BLOCK];
+    char  chars[CW_STREAM_TEXT_BLOCK];
+};
+
+/* ------------------------------------------------------------------ */
+/* Create / destroy                                                    */
+/* ------------------------------------------------------------------ */
+
+cw_stream_t *cw_stream_create(cw_decoder_t *dec, int audio_capacity,
+                              int text_capacity)
+{
+    if (!dec) return NULL;
+    if (audio_capacity <= 0) audio_capacity = CW_STREAM_DEFAULT_AUDIO;
+    if (text_capacity <= 0) text_capacity = CW_STREAM_DEFAULT_TEXT;
+
+    cw_stream_t *s = (cw_stream_t *)calloc(1, sizeof(cw_stream_t));
+    if (!s) return NULL;
+    s->dec = dec;
+
+    if (spsc_ring_init(&s->audio, sizeof(float), (size_t)audio_capacity) != 0 ||
+        spsc_ring_init(&s->text, sizeof(char), (size_t)text_capacity) != 0) {
+        cw_stream_destroy(s);
+        return NULL;
+    }
+    atomic_init(&s->audio_dropped, 0);
+    atomic_init(&s->text_dropped, 0);
+    atomic_init(&s->running, 0);
+    return s;
+}
+
+void cw_stream_destroy(cw_stream_t *s)
+{
+    if (!s) return;
+    cw_stream_stop(s);
+    spsc_ring_free(&s->audio);
+    spsc_ring_free(&s->text);
+    free(s);
+}
+
+/* ------------------------------------------------------------------ */
+/* Producer / worker / reader                                          */
+/* ------------------------------------------------------------------ */
+
+int cw_stream_push(cw_stream_t *s, const float *audio, int n)
+{
+    if (n <= 0) return 0;
+    size_t pushed = spsc_ring_push(&s->audio, audio, (size_t)n);
+    if (pushed < (size_t)n) {
+        atomic_fetch_add_explicit(&s->audio_dropped, (unsigned long)n - pushed,
+                                  memory_order_relaxed);
+    }
+    return (int)pushed;
+}
+
+/* Queue decoded text for the reader */
+static void queue_text(cw_stream_t *s, const char *text, int n)
+{
+    if (n <= 0) return;
+    size_t pushed = spsc_ring_push(&s->text, text, (size_t)n);
+    if (pushed < (size_t)n) {
+        atomic_fetch_add_explicit(&s->text_dropped, (unsigned long)n - pushed,
+                                  memory_order_relaxed);
+    }
+}
+
+int cw_stream_pump(cw_stream_t *s)
+{
+    int samples = 0;
+    for (;;) {
+        int n = (int)spsc_ring_pop(&s->audio, s->block, CW_STREAM_BLOCK);
+        if (n == 0) break;
+        int w = cw_decoder_process_inplace(s->dec, s->block, n,
+                                           s->chars, CW_STREAM_TEXT_BLOCK);
+        queue_text(s, s->chars, w);
+        samples += n;
+    }
+    return samples;
+}
+
+int cw_stream_finalize(cw_stream_t *s)
+{
+    if (atomic_load(&s->running)) return -1;
+    cw_stream_pump(s);
+    int w = cw_decoder_finalize(s->dec, s->chars, CW_STREAM_TEXT_BLOCK);
+    queue_text(s, s->chars, w);
+    return 0;
+}
+
+int cw_stream_read(cw_stream_t *s, char *out, int out_len)
+{
+    if (out_len <= 0) return 0;
+    return (int)spsc_ring_pop(&s->text, out, (size_t)out_len);
+}
+
+unsigned long cw_stream_dropped_samples(const cw_stream_t *s)
+{
+    return atomic_load_explicit(&s->audio_dropped, memory_order_relaxed);
+}
+
+unsigned long cw_stream_dropped_chars(const cw_stream_t *s)
+{
+    return atomic_load_explicit(&s->text_dropped, memory_order_relaxed);
+}
+
+/* ------------------------------------------------------------------ */
+/* Built-in worker thread                                              */
+/* ------------------------------------------------------------------ */
+
+static void *worker_main(void *arg)
+{
+    cw_stream_t *s = (cw_stream_t *)arg;
+    const struct timespec idle = { 0, CW_STREAM_IDLE_NS };
+
+    while (atomic_load_explicit(&s->running, memory_order_acquire)) {
+        if (cw_stream_pump(s) == 0) nanosleep(&idle, NULL);
+    }
+    return NULL;
+}
+
+int cw_stream_start(cw_stream_t *s)
+{
+    if (s->thread_started) return 0;
+    atomic_store(&s->running, 1);
+    if (pthread_create(&s->thread, NULL, worker_main, s) != 0) {
+        atomic_store(&s->running, 0);
+        return -1;
+    }
+    s->thread_started = 1;
+    return 0;
+}
+
+void cw_stream_stop(cw_stream_t *s)
+{
+    if (!s->thread_started) return;
+    atomic_store_explicit(&s->running, 0, memory_order_release);
+    pthread_join(s->thread, NULL);
+    s->thread_started = 0;
+}
+
+void cw_stream_reset(cw_stream_t *s)
+{
+    if (s->thread_started) return;
+    spsc_ring_reset(&s->audio);
+    spsc_ring_reset(&s->text);
+    atomic_store(&s->audio_dropped, 0);
+    atomic_store(&s->text_dropped, 0);
+    cw_decoder_reset(s->dec);
+}
@@ -0,0 +1,163 @@
+/**
+ * cw_tone.c — Sample-indexed key timeline, raised-cosine edges, rotator carrier
+ */
+
+#include "cw_tone.h"
+
+#include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#define CW_TONE_DEFAULT_RAMP_S  0.005
+
+struct cw_tone_t {
+    int     n_edges;
+    int    *edge;          /* Ramp start of each edge, in samples */
+    int     ramp;          /* Samples per ramp */
+    float  *shape;         /* ramp samples rising 0 → 1 */
+    int     length;
+    float   amplitude;
+
+    /* Render state */
+    int     pos;
+    int     end;           /* length, or the end of the release after a stop */
+    int     next;          /* First edge whose ramp is not over */
+    int     release;       /* Sample the stop's fall starts at, -1 = none */
+    float   release_from;  /* Envelope there */
+    atomic_int stop;       /* Set by cw_tone_stop(), taken up by the renderer */
+    double  re, im;        /* Carrier phasor */
+    double  rot_re, rot_im;
+};
+
+cw_tone_t *cw_tone_create(const double *edges, int n, double sample_rate, double pitch_hz,
+                          double ramp_s, float amplitude)
+{
+    if (!edges || n <= 0 || (n & 1) || !(sample_rate > 0.0) || !(pitch_hz > 0.0)) return NULL;
+    if (ramp_s <= 0.0) ramp_s = CW_TONE_DEFAULT_RAMP_S;
+
+    cw_tone_t *t = (cw_tone_t *)calloc(1, sizeof(cw_tone_t));
+    if (!t) return NULL;
+    t->n_edges = n;
+    t->ramp = (int)lround(ramp_s * sample_rate);
+    if (t->ramp < 1) t->ramp = 1;
+    t->edge = (int *)malloc((size_t)n * sizeof(int));
+    t->shape = (float *)malloc((size_t)t->ramp * sizeof(float));
+    if (!t->edge || !t->shape) {
+        cw_tone_destroy(t);
+        return NULL;
+    }
+
+    /* Ramps are centred on the edges; the timeline starts half a ramp
+       in so the first one begins at sample 0 */
+    for (int k = 0; k < n; k++) {
+        int e = (int)lround(edges[k] * sample_rate);
+        if (k > 0 && e < t->edge[k - 1] + t->ramp) e = t->edge[k - 1] + t->ramp;
+        t->edge[k] = e;
+    }
+    int shift = t->edge[0];
+    for (int k = 0; k < n; k++) t->edge[k] -= shift;
+
+    for (int i = 0; i < t->ramp; i++)
+        t->shape[i] = (float)(0.5 - 0.5 * cos(M_PI * (i + 0.5) / t->ramp));
+
+    t->length = t->edge[n - 1] + t->ramp;
+    t->amplitude = amplitude;
+    double w = 2.0 * M_PI * pitch_hz / sample_rate;
+    t->rot_re = cos(w);
+    t->rot_im = sin(w);
+    cw_tone_rewind(t);
+    return t;
+}
+
+int cw_tone_length(const cw_tone_t *t)
+{
+    return t->length;
+}
+
+int cw_tone_remaining(const cw_tone_t *t)
+{
+    if (t->release < 0 && atomic_load_explicit(&t->stop, memory_order_relaxed))
+        return 0;
+    return t->end - t->pos;
+}
+
+void cw_tone_rewind(cw_tone_t *t)
+{
+    t->pos = 0;
+    t->end = t->length;
+    t->next = 0;
+    t->release = -1;
+    atomic_store_explicit(&t->stop, 0, memory_order_relaxed);
+    t->re = 1.0;
+    t->im = 0.0;
+}
+
+void cw_tone_stop(cw_tone_t *t)
+{
+    atomic_store_explicit(&t->stop, 1, memory_order_relaxed);
+}
+
+/* Envelope of the timeline at pos; advances *next past finished ramps */
+static inline float timeline_env(const cw_tone_t *t, int pos, int *next)
+{
+    int k = *next;
+    while (k < t->n_edges && pos >= t->edge[k] + t->ramp) k++;
+    *next = k;
+    if (k < t->n_edges && pos >= t->edge[k]) {
+        float s = t->shape[pos - t->edge[k]];
+        return (k & 1) ? 1.0f - s : s;            /* Even edges key down */
+    }
+    return (k & 1) ? 1.0f : 0.0f;                 /* Between edges: down after an odd count */
+}
+
+/* Fall from wherever the envelope is now over one ramp, then end */
+static void begin_release(cw_tone_t *t)
+{
+    int next = t->next;
+    float env = t->pos < t->length ? timeline_env(t, t->pos, &next) : 0.0f;
+    t->release = t->pos;
+    t->release_from = env;
+    t->end = env > 0.0f ? t->pos + t->ramp : t->pos;
+}
+
+int cw_tone_render(cw_tone_t *t, float *out, int n)
+{
+    if (t->release < 0 && atomic_load_explicit(&t->stop, memory_order_relaxed))
+        begin_release(t);
+
+    int todo = t->end - t->pos;
+    if (n > todo) n = todo;
+    if (n <= 0) return 0;
+
+    double re = t->re, im = t->im;
+    const double cr = t->rot_re, ci = t->rot_im;
+    const float a = t->amplitude;
+    const int rel = t->release;
+    int pos = t->pos, next = t->next;
+
+    for (int i = 0; i < n; i++, pos++) {
+        float env = rel < 0 ? timeline_env(t, pos, &next)
+                            : t->release_from * (1.0f - t->shape[pos - rel]);
+
+        out[i] = a * env * (float)im;
+        double r = re * cr - im * ci;
+        im = re * ci + im * cr;
+        re = r;
+    }
+
+    /* Keep the phasor on the unit circle */
+    double g = 1.0 / sqrt(re * re + im * im);
+    t->re = re * g;
+    t->im = im * g;
+    t->pos = pos;
+    t->next = next;
+    return n;
+}
+
+void cw_tone_destroy(cw_tone_t *t)
+{
+    if (!t) return;
+    free(t->edge);
+    free(t->shape);
+    free(t);
+}
@@ -0,0 +1,73 @@
+/**
+ * cw_tone.h — Shaped CW tone rendered from a key timeline
+ *
+ * Turns MorseKeyer's key-down / key-up schedule into audio for AFSK CW:
+ * the rig transmits SSB with PTT held, and the keying is in the tone
+ * itself. Each edge is converted to a sample index once, at create, so
+ * the timing is exactly as scheduled whatever the output's buffer size
+ * or the scheduler does; the audio clock does the waiting, and no
+ * thread runs between elements.
+ *
+ * Every edge is a raised-cosine ramp centred on the edge time, so an
+ * element measures its nominal length at half amplitude and the
+ * spectrum stays narrow (5 ms ramps: a few tens of Hz at -40 dB). The
+ * timeline starts half a ramp late so the first element rises from
+ * silence. The carrier is a complex rotator renormalized per block:
+ * no sin()/cos() per sample, and the phase is continuous across edges.
+ *
+ * Audio is rendered in blocks of any size; cw_tone_render() does no
+ * allocation. cw_tone_stop() may be called from any thread while
+ * another renders: the renderer takes it up at its next block and falls
+ * from the current level over one ramp, so a stop never clicks.
+ */
+
+#ifndef CW_TONE_H
+#define CW_TONE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Opaque tone handle */
+typedef struct cw_tone_t cw_tone_t;
+
+/**
+ * Create a tone for a timeline.
+ *
+ * @param edges      Key edge times in seconds, ascending, alternating
+ *                   down, up, down, ... starting with down; n even
+ * @param pitch_hz   Tone frequency
+ * @param ramp_s     Rise / fall time of each edge (<= 0 = 5 ms)
+ * @param amplitude  Peak level, 0..1
+ * @return NULL on bad arguments or allocation failure
+ */
+cw_tone_t *cw_tone_create(const double *edges, int n, double sample_rate, double pitch_hz,
+                          double ramp_s, float amplitude);
+
+/* Total samples, from the first ramp to the end of the last one */
+int cw_tone_length(const cw_tone_t *t);
+
+/* Samples not rendered yet: 0 while a stop waits for the renderer, then its release */
+int cw_tone_remaining(const cw_tone_t *t);
+
+/**
+ * Render the next block.
+ *
+ * @return Samples written, 0 once the timeline is done
+ */
+int cw_tone_render(cw_tone_t *t, float *out, int n);
+
+/* End the message: the next block releases over one ramp, then rendering stops */
+void cw_tone_stop(cw_tone_t *t);
+
+/* Rewind to the start */
+void cw_tone_rewind(cw_tone_t *t);
+
+/* Destroy tone */
+void cw_tone_destroy(cw_tone_t *t);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CW_TONE_H */
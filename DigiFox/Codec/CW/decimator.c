@@ -0,0 +1,169 @@
+/**
+ * decimator.c — Polyphase FIR decimator
+ *
+ * Blackman-windowed sinc, cutoff at a quarter of the output rate. What
+ * leaks through the transition band folds above the envelope bandwidth
+ * and is removed by the envelope lowpass that follows.
+ */
+
+#include "decimator.h"
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static int design_taps(float *taps, int factor)
+{
+    int n = factor * DECIM_TAPS_PER_PHASE;
+    if (factor <= 1) {
+        taps[0] = 1.0f;
+        return 1;
+    }
+
+    double fc = 0.25 / (double)factor;       /* cycles per input sample */
+    double mid = 0.5 * (double)(n - 1);
+    double sum = 0.0;
+
+    for (int k = 0; k < n; k++) {
+        double t = (double)k - mid;
+        double x = 2.0 * M_PI * fc * t;
+        double s = (t == 0.0) ? 1.0 : sin(x) / x;
+        double w = 0.42 - 0.5 * cos(2.0 * M_PI * k / (n - 1))
+                        + 0.08 * cos(4.0 * M_PI * k / (n - 1));
+        taps[k] = (float)(s * w);
+        sum += s * w;
+    }
+
+    /* Unity DC gain */
+    for (int k = 0; k < n; k++) {
+        taps[k] = (float)((double)taps[k] / sum);
+    }
+    return n;
+}
+
+static int clamp_factor(int factor)
+{
+    if (factor < 1) return 1;
+    if (factor > DECIM_MAX_FACTOR) return DECIM_MAX_FACTOR;
+    return factor;
+}
+
+/*
+ * n is a multiple of DECIM_TAPS_PER_PHASE: eight independent partial sums
+ * keep the loop free of a serial dependency and let it auto-vectorize.
+ */
+float decimator_dot(const float *taps, const float *h, int n)
+{
+    float acc[DECIM_TAPS_PER_PHASE] = {0};
+    for (int k = 0; k < n; k += DECIM_TAPS_PER_PHASE) {
+        for (int j = 0; j < DECIM_TAPS_PER_PHASE; j++) {
+            acc[j] += taps[k + j] * h[k + j];
+        }
+    }
+    float sum = 0.0f;
+    for (int j = 0; j < DECIM_TAPS_PER_PHASE; j++) sum += acc[j];
+    return sum;
+}
+
+/* ------------------------------------------------------------------ */
+/* Single channel                                                      */
+/* ------------------------------------------------------------------ */
+
+void decimator_init(decimator_t *d, int factor)
+{
+    memset(d, 0, sizeof(*d));
+    d->factor = clamp_factor(factor);
+    d->n_taps = design_taps(d->taps, d->factor);
+}
+
+int decimator_process(decimator_t *d, const float *in, int n, float *out)
+{
+    if (d->factor == 1) {
+        if (out != in) memmove(out, in, (size_t)n * sizeof(float));
+        return n;
+    }
+
+    int m = 0;
+    for (int i = 0; i < n; i++) {
+        /* Only the retained phase is computed */
+        const float *h = decimator_push(d, in[i]);
+        if (h) out[m++] = decimator_dot(d->taps, h, d->n_taps);
+    }
+    return m;
+}
+
+void decimator_reset(decimator_t *d)
+{
+    d->primed = 0;
+    d->pos = 0;
+    d->phase = 0;
+    memset(d->hist, 0, sizeof(d->hist));
+}
+
+/* ------------------------------------------------------------------ */
+/* Multi-channel lanes                                                 */
+/* ------------------------------------------------------------------ */
+
+void decimator_lanes_init(decimator_lanes_t *d, int factor, int width)
+{
+    memset(d, 0, sizeof(*d));
+    if (width < 1) width = 1;
+    if (width > DECIM_MAX_LANES) width = DECIM_MAX_LANES;
+    d->factor = clamp_factor(factor);
+    d->n_taps = design_taps(d->taps, d->factor);
+    d->width = width;
+}
+
+int decimator_lanes_process(decimator_lanes_t *d, const float *in, int n, float *out)
+{
+    int w = d->width;
+
+    if (d->factor == 1) {
+        if (out != in) memmove(out, in, (size_t)n * w * sizeof(float));
+        return n;
+    }
+
+    int nt = d->n_taps;
+    int m = 0;
+
+    for (int i = 0; i < n; i++) {
+        const float *x = in + i * w;
+
+        if (!d->primed) {
+            for (int k = 0; k < 2 * nt; k++) {
+                for (int l = 0; l < w; l++) d->hist[k][l] = x[l];
+            }
+            d->primed = 1;
+        }
+
+        for (int l = 0; l < w; l++) {
+            d->hist[d->pos][l] = x[l];
+            d->hist[d->pos + nt][l] = x[l];
+        }
+        if (++d->pos == nt) d->pos = 0;
+
+        if (++d->phase == d->factor) {
+            d->phase = 0;
+            float acc[DECIM_MAX_LANES] = {0};
+            for (int k = 0; k < nt; k++) {
+                const float *h = d->hist[d->pos + k];
+                float c = d->taps[k];
+                for (int l = 0; l < DECIM_MAX_LANES; l++) acc[l] += c * h[l];
+            }
+            float *y = out + m * w;
+            for (int l = 0; l < w; l++) y[l] = acc[l];
+            m++;
+        }
+    }
+    return m;
+}
+
+void decimator_lanes_reset(decimator_lanes_t *d)
+{
+    d->primed = 0;
+    d->pos = 0;
+    d->phase = 0;
+    memset(d->hist, 0, sizeof(d->hist));
+}
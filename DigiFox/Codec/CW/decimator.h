@@ -0,0 +1,121 @@
+/**
+ * decimator.h — Polyphase FIR decimator for the rectified envelope
+ *
+ * Windowed-sinc lowpass + downsample by an integer factor. Only the
+ * retained output phase is computed (one dot product per factor inputs),
+ * so the cost per input sample is DECIM_TAPS_PER_PHASE multiply-adds.
+ *
+ * Sits between rectification and the envelope lowpass: the keyed envelope
+ * needs a few hundred Hz, so envelope and timing can run at a much lower
+ * detection rate than the audio.
+ */
+
+#ifndef DECIMATOR_H
+#define DECIMATOR_H
+
+#include <stddef.h>
+
+#define DECIM_MAX_FACTOR      64
+#define DECIM_TAPS_PER_PHASE  8
+#define DECIM_MAX_TAPS        (DECIM_MAX_FACTOR * DECIM_TAPS_PER_PHASE)
+#define DECIM_MAX_LANES       8
+
+typedef struct {
+    int factor;               /* Decimation factor (1 = pass-through) */
+    int n_taps;
+    int primed;               /* History seeded from first sample */
+    int pos;                  /* Ring write index */
+    int phase;                /* Inputs since last output */
+
+    float taps[DECIM_MAX_TAPS];
+
+    /* Doubled ring: hist[pos .. pos + n_taps - 1] is the current window */
+    float hist[2 * DECIM_MAX_TAPS];
+} decimator_t;
+
+/**
+ * Initialize decimator.
+ *
+ * @param d       Output struct
+ * @param factor  Decimation factor, clamped to [1, DECIM_MAX_FACTOR]
+ */
+void decimator_init(decimator_t *d, int factor);
+
+/**
+ * Filter and downsample. out may alias in.
+ *
+ * @param d    Decimator state
+ * @param in   Input samples
+ * @param n    Number of input samples
+ * @param out  Output, at most n / factor + 1 samples
+ * @return Number of output samples written
+ */
+int decimator_process(decimator_t *d, const float *in, int n, float *out);
+
+/**
+ * Reset decimator state.
+ */
+void decimator_reset(decimator_t *d);
+
+/**
+ * Dot product of n taps with a window (n a multiple of DECIM_TAPS_PER_PHASE).
+ */
+float decimator_dot(const float *taps, const float *h, int n);
+
+/**
+ * Push one sample into the ring (factor > 1).
+ * Returns the current window (n_taps samples, oldest first) when an output
+ * is due, NULL otherwise. For front ends that apply their own taps.
+ */
+static inline const float *decimator_push(decimator_t *d, float x)
+{
+    int nt = d->n_taps;
+    if (!d->primed) {
+        for (int k = 0; k < 2 * nt; k++) d->hist[k] = x;
+        d->primed = 1;
+    }
+
+    d->hist[d->pos] = x;
+    d->hist[d->pos + nt] = x;
+    if (++d->pos == nt) d->pos = 0;
+
+    if (++d->phase < d->factor) return NULL;
+    d->phase = 0;
+    return d->hist + d->pos;
+}
+
+/* ------------------------------------------------------------------ */
+/* Multi-channel (interleaved lanes, shared taps)                      */
+/* ------------------------------------------------------------------ */
+
+typedef struct {
+    int factor;
+    int n_taps;
+    int width;                /* Lane stride: 4 or 8 */
+    int primed;
+    int pos;
+    int phase;
+
+    float taps[DECIM_MAX_TAPS];
+    float hist[2 * DECIM_MAX_TAPS][DECIM_MAX_LANES];
+} decimator_lanes_t;
+
+/**
+ * Initialize lane decimator (same filter on every lane).
+ */
+void decimator_lanes_init(decimator_lanes_t *d, int factor, int width);
+
+/**
+ * Filter and downsample interleaved data (in[i * width + lane]).
+ * out may alias in.
+ *
+ * @return Output samples written per lane
+ */
+int decimator_lanes_process(decimator_lanes_t *d, const float *in, int n, float *out);
+
+/**
+ * Reset lane decimator state.
+ */
+void decimator_lanes_reset(decimator_lanes_t *d);
+
+#endif /* DECIMATOR_H */
@@ -0,0 +1,302 @@
+/**
+ * duration_hmm.c — Bounded-beam Viterbi over Morse patterns
+ */
+
+#include "duration_hmm.h"
+#include "kalman.h"
+#include "timing.h"
+
+#include <math.h>
+#include <string.h>
+
+/* Element labels in hmm_path_t.pending */
+#define LABEL_DIT   0
+#define LABEL_DAH   1
+#define LABEL_CHAR  2
+#define LABEL_WORD  3
+
+/*
+ * Emission floor: a duration far off every state (a fade, a stuck key)
+ * costs at most this, so one outlier cannot outweigh a whole character.
+ */
+#define HMM_LL_FLOOR      -12.0f
+
+
+static const int k_label_elem[4] = { ELEM_DIT, ELEM_DAH, ELEM_CHAR, ELEM_WORD };
+
+void duration_hmm_init(duration_hmm_t *h)
+{
+    memset(h, 0, sizeof(*h));
+
+    /* Frequency mass of the characters below each pattern */
+    float w[MORSE_TABLE_SIZE] = { 0 }, mass[MORSE_TABLE_SIZE] = { 0 };
+    for (int c = 2; c < MORSE_TABLE_SIZE; c++) {
+        char ch = morse_lookup_code((morse_code_t)c);
+        if (ch == '?') continue;
+        w[c] = (float)(morse_char_weight(ch) + 1);
+        for (int p = c; p >= MORSE_CODE_EMPTY; p >>= 1) mass[p] += w[c];
+    }
+
+    /* A character's prior is the product along its path */
+    for (int c = 0; c < MORSE_TABLE_SIZE; c++) {
+        float rest = mass[c] - w[c];
+        h->step[c] = h->cont[c] = h->end[c] = -INFINITY;
+        if (c >= 2 && mass[c] > 0.0f) {
+            h->step[c] = logf(mass[c] / (mass[c >> 1] - w[c >> 1]));
+        }
+        if (rest > 0.0f) h->cont[c] = logf(rest / mass[c]);
+        if (w[c] > 0.0f) h->end[c] = logf(w[c] / mass[c]);
+    }
+
+    /* Until the first set_model(): ITU ratios at 20 WPM, 12 kHz */
+    static const float ratio[HMM_STATES] = { 1.0f, 3.0f, 1.0f, 3.0f, 7.0f };
+    float mu[HMM_STATES], var[HMM_STATES];
+    for (int s = 0; s < HMM_STATES; s++) {
+        mu[s] = logf(720.0f * ratio[s]);
+        var[s] = 0.2f;
+    }
+    duration_hmm_set_model(h, mu, var);
+    duration_hmm_reset(h);
+}
+
+void duration_hmm_reset(duration_hmm_t *h)
+{
+    hmm_path_t *p = &h->paths[0][0];
+    memset(p, 0, sizeof(*p));
+    p->code = MORSE_CODE_EMPTY;
+    h->cur = 0;
+    h->n_paths = 1;
+    h->out_head = h->out_tail = 0;
+}
+
+void duration_hmm_set_model(duration_hmm_t *h, const float *mu, const float *var)
+{
+    for (int s = 0; s < HMM_STATES; s++) {
+        float v = var[s] > 1e-4f ? var[s] : 1e-4f;
+        h->mu[s] = mu[s];
+        h->inv_2var[s] = 0.5f / v;
+        h->log_norm[s] = 0.5f * logf(v);
+    }
+}
+
+static inline float emission(const duration_hmm_t *h, int s, float x)
+{
+    float d = x - h->mu[s];
+    float ll = -d * d * h->inv_2var[s] - h->log_norm[s];
+    return ll > HMM_LL_FLOOR ? ll : HMM_LL_FLOOR;
+}
+
+static void out_push(duration_hmm_t *h, int label)
+{
+    /* Drained one per run by the caller, so this only fills if it stalls */
+    if (h->out_tail - h->out_head >= HMM_OUT_SIZE) return;
+    h->out[h->out_tail++ % HMM_OUT_SIZE] = k_label_elem[label];
+}
+
+/* Merge into the next beam: same pattern keeps the better, else the best HMM_BEAM */
+static void beam_insert(hmm_path_t *beam, int *n, const hmm_path_t *p)
+{
+    int worst = 0;
+    for (int i = 0; i < *n; i++) {
+        if (beam[i].code == p->code) {
+            if (p->score > beam[i].score) beam[i] = *p;
+            return;
+        }
+        if (beam[i].score < beam[worst].score) worst = i;
+    }
+    if (*n < HMM_BEAM) {
+        beam[(*n)++] = *p;
+    } else if (p->score > beam[worst].score) {
+        beam[worst] = *p;
+    }
+}
+
+static inline void push_label(hmm_path_t *p, int label)
+{
+    p->pending |= (uint64_t)label << (2 * p->n_pending);
+    p->n_pending++;
+}
+
+static int best_path(const duration_hmm_t *h)
+{
+    const hmm_path_t *paths = h->paths[h->cur];
+    int best = 0;
+    for (int i = 1; i < h->n_paths; i++) {
+        if (paths[i].score > paths[best].score) best = i;
+    }
+    return best;
+}
+
+/* Output the oldest element of the best path; drop the paths that disagree */
+static void force_decide(duration_hmm_t *h)
+{
+    hmm_path_t *paths = h->paths[h->cur];
+    const hmm_path_t *best = &paths[best_path(h)];
+    int label = (int)(best->pending & 3u);
+    out_push(h, label);
+
+    int n = 0;
+    for (int i = 0; i < h->n_paths; i++) {
+        hmm_path_t p = paths[i];
+        if (p.n_pending == 0 || (int)(p.pending & 3u) != label) continue;
+        p.pending >>= 2;
+        p.n_pending--;
+        paths[n++] = p;
+    }
+    h->n_paths = n;
+}
+
+/* Output the elements every surviving path agrees on */
+static void decide_agreed(duration_hmm_t *h)
+{
+    hmm_path_t *paths = h->paths[h->cur];
+    for (;;) {
+        if (paths[0].n_pending == 0) return;
+        unsigned label = (unsigned)(paths[0].pending & 3u);
+        for (int i = 1; i < h->n_paths; i++) {
+            if (paths[i].n_pending == 0 || (paths[i].pending & 3u) != label) return;
+        }
+        out_push(h, (int)label);
+        for (int i = 0; i < h->n_paths; i++) {
+            paths[i].pending >>= 2;
+            paths[i].n_pending--;
+        }
+    }
+}
+
+/* Swap beams, renormalize scores, decide what is agreed */
+static int step_done(duration_hmm_t *h, int n)
+{
+    h->cur ^= 1;
+    h->n_paths = n;
+
+    hmm_path_t *paths = h->paths[h->cur];
+    int best = best_path(h);
+    float top = paths[best].score;
+    for (int i = 0; i < n; i++) paths[i].score -= top;
+    int last = paths[best].last;
+
+    decide_agreed(h);
+    return last;
+}
+
+int duration_hmm_mark(duration_hmm_t *h, int dur)
+{
+    if (h->paths[h->cur][best_path(h)].n_pending >= HMM_MAX_PENDING) force_decide(h);
+
+    float x = logf((float)(dur > 0 ? dur : 1));
+    float ll[2] = { emission(h, K_DIT, x), emission(h, K_DAH, x) };
+
+    const hmm_path_t *cur = h->paths[h->cur];
+    hmm_path_t *next = h->paths[h->cur ^ 1];
+    int n = 0;
+    for (int i = 0; i < h->n_paths; i++) {
+        for (int dah = 0; dah < 2; dah++) {
+            unsigned code = ((unsigned)cur[i].code << 1) | (unsigned)dah;
+            if (code >= MORSE_TABLE_SIZE || h->step[code] == -INFINITY) continue;
+            hmm_path_t p = cur[i];
+            p.code = (morse_code_t)code;
+            p.score += ll[dah] + h->step[code];
+            p.last = (uint8_t)(dah ? K_DAH : K_DIT);
+            if (p.n_pending < HMM_MAX_PENDING) push_label(&p, dah ? LABEL_DAH : LABEL_DIT);
+            beam_insert(next, &n, &p);
+        }
+    }
+
+    /* Nothing keys a real character: close the best path's and go on */
+    if (n == 0) {
+        hmm_path_t p = cur[best_path(h)];
+        if (p.n_pending < HMM_MAX_PENDING) push_label(&p, LABEL_CHAR);
+        unsigned dah = emission(h, K_DAH, x) > emission(h, K_DIT, x);
+        p.code = (morse_code_t)(MORSE_CODE_EMPTY << 1 | dah);
+        if (p.n_pending < HMM_MAX_PENDING) push_label(&p, dah ? LABEL_DAH : LABEL_DIT);
+        p.last = (uint8_t)(dah ? K_DAH : K_DIT);
+        next[n++] = p;
+    }
+    return step_done(h, n);
+}
+
+int duration_hmm_space(duration_hmm_t *h, int dur)
+{
+    if (h->paths[h->cur][best_path(h)].n_pending >= HMM_MAX_PENDING) force_decide(h);
+
+    float x = logf((float)(dur > 0 ? dur : 1));
+    float ll_elem = emission(h, K_ELEM_SPACE, x);
+    float ll_char = emission(h, K_CHAR_SPACE, x);
+    float ll_word = emission(h, K_WORD_SPACE, x);
+
+    const hmm_path_t *cur = h->paths[h->cur];
+    hmm_path_t *next = h->paths[h->cur ^ 1];
+    int n = 0;
+    for (int i = 0; i < h->n_paths; i++) {
+        const hmm_path_t *src = &cur[i];
+        unsigned code = src->code;
+
+        /* Element gap: the character goes on, if it can */
+        float cont = code < MORSE_TABLE_SIZE ? h->cont[code] : -INFINITY;
+        if (cont != -INFINITY) {
+            hmm_path_t p = *src;
+            p.score += ll_elem + cont;
+            p.last = K_ELEM_SPACE;
+            beam_insert(next, &n, &p);
+        }
+
+        /* Character or word gap: only after a real character */
+        float end = code < MORSE_TABLE_SIZE ? h->end[code] : -INFINITY;
+        if (end == -INFINITY || src->n_pending >= HMM_MAX_PENDING) continue;
+        hmm_path_t p = *src;
+        p.code = MORSE_CODE_EMPTY;
+        int word = ll_word > ll_char;
+        p.score += end + (word ? ll_word : ll_char);
+        p.last = (uint8_t)(word ? K_WORD_SPACE : K_CHAR_SPACE);
+        push_label(&p, word ? LABEL_WORD : LABEL_CHAR);
+        beam_insert(next, &n, &p);
+    }
+
+    /* Every path stuck on a non-character: end it anyway */
+    if (n == 0) {
+        hmm_path_t p = cur[best_path(h)];
+        int word = ll_word > ll_char;
+        p.code = MORSE_CODE_EMPTY;
+        p.last = (uint8_t)(word ? K_WORD_SPACE : K_CHAR_SPACE);
+        if (p.n_pending < HMM_MAX_PENDING) push_label(&p, word ? LABEL_WORD : LABEL_CHAR);
+        next[n++] = p;
+    }
+    return step_done(h, n);
+}
+
+void duration_hmm_finish(duration_hmm_t *h)
+{
+    /* Prefer a path that ends on a real character */
+    const hmm_path_t *paths = h->paths[h->cur];
+    int best = -1;
+    float best_score = -INFINITY;
+    for (int i = 0; i < h->n_paths; i++) {
+        unsigned code = paths[i].code;
+        float end = code == MORSE_CODE_EMPTY ? 0.0f
+                  : code < MORSE_TABLE_SIZE ? h->end[code] : -INFINITY;
+        float s = paths[i].score + (end == -INFINITY ? HMM_LL_FLOOR : end);
+        if (best < 0 || s > best_score) {
+            best = i;
+            best_score = s;
+        }
+    }
+
+    hmm_path_t p = paths[best];
+    for (int k = 0; k < p.n_pending; k++) {
+        out_push(h, (int)((p.pending >> (2 * k)) & 3u));
+    }
+
+    /* Start over, keeping what is still to be taken */
+    hmm_path_t *start = &h->paths[0][0];
+    memset(start, 0, sizeof(*start));
+    start->code = MORSE_CODE_EMPTY;
+    h->cur = 0;
+    h->n_paths = 1;
+}
+
+int duration_hmm_pop(duration_hmm_t *h)
+{
+    if (h->out_head == h->out_tail) return ELEM_NONE;
+    return h->out[h->out_head++ % HMM_OUT_SIZE];
+}
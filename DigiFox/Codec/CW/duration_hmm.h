@@ -0,0 +1,108 @@
+/**
+ * duration_hmm.h — Duration HMM element decoder (bounded-beam Viterbi)
+ *
+ * Replaces the timing classifier's hard per-duration decisions
+ * (cw_config_t.use_hmm). Each mark is a dit or a dah and each space an
+ * element, character or word gap; a duration's log-likelihood under each
+ * is a log-normal with the Kalman state's mean and predictive variance.
+ * The hidden state is the pattern of the character being keyed
+ * (morse_code_t), so a path can only key prefixes of real characters and
+ * only end a character on a valid one, weighted by its frequency: the
+ * choice between "dah" and "long dit", or "character gap" and "long
+ * element gap", is made with the rest of the character in view instead
+ * of being left for morse_lookup_merged() to repair.
+ *
+ * Viterbi over the pattern states with a fixed beam: paths reaching the
+ * same pattern merge (the better one survives) and at most HMM_BEAM
+ * survive a step, so an observation costs O(HMM_BEAM²) whatever the
+ * signal. Each path carries the elements it decided since the last
+ * output; an element is output once every surviving path agrees on it,
+ * or forced from the best path after HMM_MAX_PENDING. All storage is in
+ * the struct.
+ */
+
+#ifndef DURATION_HMM_H
+#define DURATION_HMM_H
+
+#include "morse_table.h"
+#include <stdint.h>
+
+#define HMM_BEAM          16
+#define HMM_MAX_PENDING   32      /* Undecided elements per path (2 bits each) */
+#define HMM_OUT_SIZE      64      /* Decided elements not yet taken */
+#define HMM_STATES        5       /* kalman.h K_DIT .. K_WORD_SPACE */
+
+typedef struct {
+    float        score;           /* Log-likelihood */
+    morse_code_t code;            /* Character being keyed */
+    uint8_t      n_pending;
+    uint8_t      last;            /* State of the latest observation */
+    uint64_t     pending;         /* Undecided elements, oldest in bits 0-1 */
+} hmm_path_t;
+
+typedef struct {
+    hmm_path_t paths[2][HMM_BEAM];
+    int        cur;
+    int        n_paths;
+
+    /* Emission model: log-normal per state (duration_hmm_set_model()) */
+    float mu[HMM_STATES];
+    float inv_2var[HMM_STATES];
+    float log_norm[HMM_STATES];
+
+    /*
+     * Transition log-probabilities by pattern (codes of up to 7 elements),
+     * from character frequencies over the pattern tree: step[c] keying c
+     * given its parent goes on, cont[c] going on after c, end[c] ending
+     * the character on c. -inf where no character allows it.
+     */
+    float step[MORSE_TABLE_SIZE];
+    float cont[MORSE_TABLE_SIZE];
+    float end[MORSE_TABLE_SIZE];
+
+    /* Decided elements (timing.h codes), FIFO */
+    int      out[HMM_OUT_SIZE];
+    unsigned out_head, out_tail;
+} duration_hmm_t;
+
+/**
+ * Initialize (transition tables, one empty path).
+ */
+void duration_hmm_init(duration_hmm_t *h);
+
+/**
+ * Drop all paths and undecided elements.
+ */
+void duration_hmm_reset(duration_hmm_t *h);
+
+/**
+ * Set the emission model: log-duration mean and variance per state
+ * (kalman.h order). Call whenever the timing estimate changes.
+ */
+void duration_hmm_set_model(duration_hmm_t *h, const float *mu, const float *var);
+
+/**
+ * Observe a mark of dur samples.
+ * @return The best path's reading of it (K_DIT or K_DAH)
+ */
+int duration_hmm_mark(duration_hmm_t *h, int dur);
+
+/**
+ * Observe a space of dur samples between two marks.
+ * @return The best path's reading (K_ELEM_SPACE, K_CHAR_SPACE or K_WORD_SPACE)
+ */
+int duration_hmm_space(duration_hmm_t *h, int dur);
+
+/**
+ * End of signal: decide the best path's elements (the last character
+ * left open for the pattern decoder to flush) and start over.
+ */
+void duration_hmm_finish(duration_hmm_t *h);
+
+/**
+ * Take the oldest decided element (ELEM_DIT, ELEM_DAH, ELEM_CHAR or
+ * ELEM_WORD), or ELEM_NONE.
+ */
+int duration_hmm_pop(duration_hmm_t *h);
+
+#endif /* DURATION_HMM_H */
@@ -3,12 +3,69 @@
  */
 
 #include "envelope.h"
+#include "simd_detect.h"
 #include <math.h>
 #include <string.h>
 
-void envelope_init(envelope_t *env, int sample_rate, float window_s,
-                   float thresh_on, float thresh_off,
-                   envelope_mode_t mode, int mp_passes)
+/*
+ * Hysteresis nibble table for the SIMD kernels.
+ * Index: state << 8 | on_mask << 4 | off_mask, where bit j of on_mask is
+ * (x[j] >= on_thr) and bit j of off_mask is (x[j] >= off_thr).
+ * Value: bit j = on/off after sample j, bit 4 = state after the nibble.
+ */
+const unsigned char envelope_hyst_lut[512] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x01, 0x03, 0x03, 0x01, 0x01, 0x07, 0x07, 0x01, 0x01, 0x03, 0x03, 0x01, 0x01, 0x1F, 0x1F,
+    0x02, 0x02, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06, 0x02, 0x02, 0x02, 0x02, 0x1E, 0x1E, 0x1E, 0x1E,
+    0x01, 0x01, 0x03, 0x03, 0x01, 0x01, 0x07, 0x07, 0x01, 0x01, 0x03, 0x03, 0x01, 0x01, 0x1F, 0x1F,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C,
+    0x05, 0x05, 0x03, 0x03, 0x05, 0x05, 0x07, 0x07, 0x1D, 0x1D, 0x03, 0x03, 0x1D, 0x1D, 0x1F, 0x1F,
+    0x02, 0x02, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06, 0x02, 0x02, 0x02, 0x02, 0x1E, 0x1E, 0x1E, 0x1E,
+    0x05, 0x05, 0x03, 0x03, 0x05, 0x05, 0x07, 0x07, 0x1D, 0x1D, 0x03, 0x03, 0x1D, 0x1D, 0x1F, 0x1F,
+    0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+    0x19, 0x19, 0x1B, 0x1B, 0x19, 0x19, 0x07, 0x07, 0x19, 0x19, 0x1B, 0x1B, 0x19, 0x19, 0x1F, 0x1F,
+    0x1A, 0x1A, 0x1A, 0x1A, 0x06, 0x06, 0x06, 0x06, 0x1A, 0x1A, 0x1A, 0x1A, 0x1E, 0x1E, 0x1E, 0x1E,
+    0x19, 0x19, 0x1B, 0x1B, 0x19, 0x19, 0x07, 0x07, 0x19, 0x19, 0x1B, 0x1B, 0x19, 0x19, 0x1F, 0x1F,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C,
+    0x05, 0x05, 0x1B, 0x1B, 0x05, 0x05, 0x07, 0x07, 0x1D, 0x1D, 0x1B, 0x1B, 0x1D, 0x1D, 0x1F, 0x1F,
+    0x1A, 0x1A, 0x1A, 0x1A, 0x06, 0x06, 0x06, 0x06, 0x1A, 0x1A, 0x1A, 0x1A, 0x1E, 0x1E, 0x1E, 0x1E,
+    0x05, 0x05, 0x1B, 0x1B, 0x05, 0x05, 0x07, 0x07, 0x1D, 0x1D, 0x1B, 0x1B, 0x1D, 0x1D, 0x1F, 0x1F,
+    0x00, 0x01, 0x00, 0x03, 0x00, 0x01, 0x00, 0x07, 0x00, 0x01, 0x00, 0x03, 0x00, 0x01, 0x00, 0x1F,
+    0x00, 0x01, 0x00, 0x03, 0x00, 0x01, 0x00, 0x07, 0x00, 0x01, 0x00, 0x03, 0x00, 0x01, 0x00, 0x1F,
+    0x02, 0x01, 0x02, 0x03, 0x06, 0x01, 0x06, 0x07, 0x02, 0x01, 0x02, 0x03, 0x1E, 0x01, 0x1E, 0x1F,
+    0x02, 0x01, 0x02, 0x03, 0x06, 0x01, 0x06, 0x07, 0x02, 0x01, 0x02, 0x03, 0x1E, 0x01, 0x1E, 0x1F,
+    0x04, 0x05, 0x04, 0x03, 0x04, 0x05, 0x04, 0x07, 0x1C, 0x1D, 0x1C, 0x03, 0x1C, 0x1D, 0x1C, 0x1F,
+    0x04, 0x05, 0x04, 0x03, 0x04, 0x05, 0x04, 0x07, 0x1C, 0x1D, 0x1C, 0x03, 0x1C, 0x1D, 0x1C, 0x1F,
+    0x02, 0x05, 0x02, 0x03, 0x06, 0x05, 0x06, 0x07, 0x02, 0x1D, 0x02, 0x03, 0x1E, 0x1D, 0x1E, 0x1F,
+    0x02, 0x05, 0x02, 0x03, 0x06, 0x05, 0x06, 0x07, 0x02, 0x1D, 0x02, 0x03, 0x1E, 0x1D, 0x1E, 0x1F,
+    0x18, 0x19, 0x18, 0x1B, 0x18, 0x19, 0x18, 0x07, 0x18, 0x19, 0x18, 0x1B, 0x18, 0x19, 0x18, 0x1F,
+    0x18, 0x19, 0x18, 0x1B, 0x18, 0x19, 0x18, 0x07, 0x18, 0x19, 0x18, 0x1B, 0x18, 0x19, 0x18, 0x1F,
+    0x1A, 0x19, 0x1A, 0x1B, 0x06, 0x19, 0x06, 0x07, 0x1A, 0x19, 0x1A, 0x1B, 0x1E, 0x19, 0x1E, 0x1F,
+    0x1A, 0x19, 0x1A, 0x1B, 0x06, 0x19, 0x06, 0x07, 0x1A, 0x19, 0x1A, 0x1B, 0x1E, 0x19, 0x1E, 0x1F,
+    0x04, 0x05, 0x04, 0x1B, 0x04, 0x05, 0x04, 0x07, 0x1C, 0x1D, 0x1C, 0x1B, 0x1C, 0x1D, 0x1C, 0x1F,
+    0x04, 0x05, 0x04, 0x1B, 0x04, 0x05, 0x04, 0x07, 0x1C, 0x1D, 0x1C, 0x1B, 0x1C, 0x1D, 0x1C, 0x1F,
+    0x1A, 0x05, 0x1A, 0x1B, 0x06, 0x05, 0x06, 0x07, 0x1A, 0x1D, 0x1A, 0x1B, 0x1E, 0x1D, 0x1E, 0x1F,
+    0x1A, 0x05, 0x1A, 0x1B, 0x06, 0x05, 0x06, 0x07, 0x1A, 0x1D, 0x1A, 0x1B, 0x1E, 0x1D, 0x1E, 0x1F,
+};
+
+/* Multipass window for the smoothing time window_s */
+static int multipass_window(int sample_rate, float window_s, int mp_passes)
+{
+    /* Calculate window size matching Python:
+     * cutoff = 1.0 / (2.0 * window_s)
+     * window = int(sample_rate / (cutoff * pi * sqrt(n_passes)))
+     */
+    float cutoff = 1.0f / (2.0f * window_s);
+    float window_f = (float)sample_rate / (cutoff * (float)M_PI * sqrtf((float)mp_passes));
+    int window = (int)window_f;
+    if (window < 5) window = 5;
+    if (window % 2 == 0) window++;
+    return window;
+}
+
+/* Everything but the multipass history */
+static void envelope_setup(envelope_t *env, int sample_rate, float window_s,
+                           float thresh_on, float thresh_off, envelope_mode_t mode)
 {
     memset(env, 0, sizeof(*env));
     env->threshold_on = thresh_on;
@@ -17,26 +74,128 @@ void envelope_init(envelope_t *env, int sample_rate, float window_s,
     env->prev_state = 0;
     env->mode = mode;
 
-    if (mode == ENV_MODE_MULTIPASS) {
-        /* Calculate window size matching Python:
-         * cutoff = 1.0 / (2.0 * window_s)
-         * window = int(sample_rate / (cutoff * pi * sqrt(n_passes)))
-         */
-        float cutoff = 1.0f / (2.0f * window_s);
-        float window_f = (float)sample_rate / (cutoff * (float)M_PI * sqrtf((float)mp_passes));
-        int window = (int)window_f;
-        if (window < 5) window = 5;
-        if (window % 2 == 0) window++;
-        multipass_init(&env->mpf, mp_passes, window);
-    } else {
+    if (mode == ENV_MODE_IIR) {
         /* IIR lowpass design */
         float cutoff_hz = 1.0f / (2.0f * window_s);
         iir_design_lowpass(&env->lpf, 2, cutoff_hz, (float)sample_rate);
     }
 }
 
+int envelope_init(envelope_t *env, int sample_rate, float window_s,
+                  float thresh_on, float thresh_off,
+                  envelope_mode_t mode, int mp_passes)
+{
+    envelope_setup(env, sample_rate, window_s, thresh_on, thresh_off, mode);
+    if (mode != ENV_MODE_MULTIPASS) return 0;
+    return multipass_init(&env->mpf, mp_passes,
+                          multipass_window(sample_rate, window_s, mp_passes));
+}
+
+size_t envelope_mem_size(int sample_rate, float window_s,
+                         envelope_mode_t mode, int mp_passes)
+{
+    if (mode != ENV_MODE_MULTIPASS) return 0;
+    return multipass_mem_size(mp_passes, multipass_window(sample_rate, window_s, mp_passes));
+}
+
+void envelope_init_in(envelope_t *env, void *mem, int sample_rate, float window_s,
+                      float thresh_on, float thresh_off,
+                      envelope_mode_t mode, int mp_passes)
+{
+    envelope_setup(env, sample_rate, window_s, thresh_on, thresh_off, mode);
+    if (mode != ENV_MODE_MULTIPASS) return;
+    multipass_init_in(&env->mpf, mp_passes,
+                      multipass_window(sample_rate, window_s, mp_passes), mem);
+}
+
+void envelope_free(envelope_t *env)
+{
+    multipass_free(&env->mpf);
+}
+
+/* ------------------------------------------------------------------ */
+/* Scalar kernels                                                      */
+/* ------------------------------------------------------------------ */
+
+void envelope_rectify_scalar(const float *in, float *out, int n)
+{
+    for (int i = 0; i < n; i++) {
+        out[i] = fabsf(in[i]);
+    }
+}
+
+float envelope_peak_scalar(const float *data, int n)
+{
+    float peak = 0.0f;
+    for (int i = 0; i < n; i++) {
+        if (data[i] > peak) peak = data[i];
+    }
+    return peak;
+}
+
+int envelope_hysteresis_scalar(const float *data, int n,
+                               float on_thr, float off_thr,
+                               int state, int *on_off)
+{
+    for (int i = 0; i < n; i++) {
+        if (state) {
+            state = (data[i] >= off_thr) ? 1 : 0;
+        } else {
+            state = (data[i] >= on_thr) ? 1 : 0;
+        }
+        on_off[i] = state;
+    }
+    return state;
+}
+
+int envelope_hysteresis_bits_scalar(const float *data, int n,
+                                    float on_thr, float off_thr,
+                                    int state, uint32_t *bits)
+{
+    for (int w = 0; w < n; w += 32) {
+        int len = n - w;
+        if (len > 32) len = 32;
+        uint32_t word = 0;
+        for (int j = 0; j < len; j++) {
+            state = (data[w + j] >= (state ? off_thr : on_thr)) ? 1 : 0;
+            word |= (uint32_t)state << j;
+        }
+        bits[w >> 5] = word;
+    }
+    return state;
+}
+
+/* ------------------------------------------------------------------ */
+/* Process                                                             */
+/* ------------------------------------------------------------------ */
+
+/*
+ * Gate above the noise floor, in multiples of the floor. The sliding-DFT
+ * floor is the quieter of two neighbour bins (mean ~0.9 sigma of the
+ * Rayleigh noise magnitude), so 4x is ~3.5 sigma: noise alone crosses the
+ * on threshold well under 1% of the time, even once the peak has decayed.
+ */
+#define ENVELOPE_NOISE_GATE 4.0f
+
+/* Hysteresis thresholds: fraction of peak, gated above the noise floor */
+static inline void envelope_thresholds(float peak, float noise,
+                                       float frac_on, float frac_off,
+                                       float *on_thr, float *off_thr)
+{
+    float gate_on  = ENVELOPE_NOISE_GATE * noise;
+    float gate_off = (frac_on > 0.0f) ? gate_on * frac_off / frac_on : gate_on;
+    *on_thr  = peak * frac_on;
+    *off_thr = peak * frac_off;
+    if (*on_thr < gate_on) *on_thr = gate_on;
+    if (*off_thr < gate_off) *off_thr = gate_off;
+    if (*on_thr < 1e-10f) *on_thr = 1e-10f;
+    if (*off_thr < 1e-10f) *off_thr = 1e-10f;
+}
+
 void envelope_process(envelope_t *env, const float *audio, int *on_off, int n)
 {
+    const cw_kernels_t *k = cw_get_kernels();
+
     /* Step 1: Rectify — work on a temporary buffer to avoid modifying input.
      * For large chunks we process in segments to limit stack usage. */
     float tmp[4096];
@@ -47,22 +206,17 @@ void envelope_process(envelope_t *env, const float *audio, int *on_off, int n)
         if (chunk > 4096) chunk = 4096;
 
         /* Rectify */
-        for (int i = 0; i < chunk; i++) {
-            tmp[i] = fabsf(audio[processed + i]);
-        }
+        k->rectify(audio + processed, tmp, chunk);
 
         /* Step 2: Lowpass filter */
         if (env->mode == ENV_MODE_MULTIPASS) {
-            multipass_process(&env->mpf, tmp, chunk);
-        } else {
-            iir_filter_process(&env->lpf, tmp, chunk);
+            k->multipass(&env->mpf, tmp, chunk);
+        } else if (env->mode == ENV_MODE_IIR) {
+            k->biquad_cascade(&env->lpf, tmp, chunk);
         }
 
         /* Step 3: Peak tracking */
-        float chunk_peak = 0.0f;
-        for (int i = 0; i < chunk; i++) {
-            if (tmp[i] > chunk_peak) chunk_peak = tmp[i];
-        }
+        float chunk_peak = k->peak(tmp, chunk);
 
         if (chunk_peak > env->peak_level) {
             env->peak_level = chunk_peak;
@@ -71,33 +225,278 @@ void envelope_process(envelope_t *env, const float *audio, int *on_off, int n)
         }
 
         /* Step 4: Hysteresis thresholding */
-        float on_thr  = env->peak_level * env->threshold_on;
-        float off_thr = env->peak_level * env->threshold_off;
-        if (on_thr < 1e-10f) on_thr = 1e-10f;
-        if (off_thr < 1e-10f) off_thr = 1e-10f;
-
-        int state = env->prev_state;
-        for (int i = 0; i < chunk; i++) {
-            if (state) {
-                state = (tmp[i] >= off_thr) ? 1 : 0;
-            } else {
-                state = (tmp[i] >= on_thr) ? 1 : 0;
+        float on_thr, off_thr;
+        envelope_thresholds(env->peak_level, env->noise_level,
+                            env->threshold_on, env->threshold_off,
+                            &on_thr, &off_thr);
+
+        env->prev_state = k->hysteresis(tmp, chunk, on_thr, off_thr,
+                                        env->prev_state, on_off + processed);
+
+        processed += chunk;
+    }
+}
+
+void envelope_process_bits(envelope_t *env, float *data, uint32_t *bits, int n)
+{
+    const cw_kernels_t *k = cw_get_kernels();
+
+    /* Chunks are a multiple of 32 samples, so every chunk starts a word */
+    for (int processed = 0; processed < n; processed += 4096) {
+        int chunk = n - processed;
+        if (chunk > 4096) chunk = 4096;
+        float *x = data + processed;
+
+        /* Rectify + lowpass in place — no copy of the input */
+        k->rectify(x, x, chunk);
+        if (env->mode == ENV_MODE_MULTIPASS) {
+            k->multipass(&env->mpf, x, chunk);
+        } else if (env->mode == ENV_MODE_IIR) {
+            k->biquad_cascade(&env->lpf, x, chunk);
+        }
+
+        /* Peak tracking: thresholds depend on this chunk's peak */
+        float chunk_peak = k->peak(x, chunk);
+
+        if (chunk_peak > env->peak_level) {
+            env->peak_level = chunk_peak;
+        } else {
+            env->peak_level = 0.995f * env->peak_level + 0.005f * chunk_peak;
+        }
+
+        float on_thr, off_thr;
+        envelope_thresholds(env->peak_level, env->noise_level,
+                            env->threshold_on, env->threshold_off,
+                            &on_thr, &off_thr);
+
+        /* Compare, resolve hysteresis and pack in one pass */
+        env->prev_state = k->hysteresis_bits(x, chunk, on_thr, off_thr,
+                                             env->prev_state,
+                                             bits + (processed >> 5));
+    }
+}
+
+/* Index of the lowest set bit (x != 0) */
+static inline int lowest_bit(uint32_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(x);
+#else
+    int j = 0;
+    while (!(x & 1u)) { x >>= 1; j++; }
+    return j;
+#endif
+}
+
+int envelope_bits_to_runs(const uint32_t *bits, int n, int *runs)
+{
+    if (n <= 0) return 0;
+
+    int n_runs = 0;
+    int state = (int)(bits[0] & 1u);
+    int len = 0;
+
+    for (int w = 0; w < n; w += 32) {
+        int nb = n - w;
+        if (nb > 32) nb = 32;
+        uint32_t valid = (nb == 32) ? 0xFFFFFFFFu : ((1u << nb) - 1u);
+        uint32_t word = bits[w >> 5];
+        int pos = 0;
+
+        /* Jump from transition to transition within the word */
+        for (;;) {
+            uint32_t diff = (state ? ~word : word) & valid & (0xFFFFFFFFu << pos);
+            if (!diff) {
+                len += nb - pos;
+                break;
             }
-            on_off[processed + i] = state;
+            int j = lowest_bit(diff);
+            len += j - pos;
+            runs[n_runs++] = state ? len : -len;
+            state = !state;
+            len = 0;
+            pos = j;
         }
-        env->prev_state = state;
+    }
+    runs[n_runs++] = state ? len : -len;
+    return n_runs;
+}
 
-        processed += chunk;
+int envelope_process_runs(envelope_t *env, float *data, int *runs, int n)
+{
+    uint32_t bits[ENVELOPE_BITS_WORDS(4096)];
+    int n_runs = 0;
+
+    for (int processed = 0; processed < n; processed += 4096) {
+        int chunk = n - processed;
+        if (chunk > 4096) chunk = 4096;
+
+        envelope_process_bits(env, data + processed, bits, chunk);
+        int r = envelope_bits_to_runs(bits, chunk, runs + n_runs);
+
+        /* Join a run that continues across the 4096-sample boundary */
+        if (n_runs > 0 && (runs[n_runs - 1] > 0) == (runs[n_runs] > 0)) {
+            runs[n_runs - 1] += runs[n_runs];
+            memmove(runs + n_runs, runs + n_runs + 1, (size_t)(r - 1) * sizeof(int));
+            r--;
+        }
+        n_runs += r;
     }
+    return n_runs;
 }
 
 void envelope_reset(envelope_t *env)
 {
     env->peak_level = 0.0f;
+    env->noise_level = 0.0f;
     env->prev_state = 0;
     if (env->mode == ENV_MODE_MULTIPASS) {
         multipass_reset(&env->mpf);
-    } else {
+    } else if (env->mode == ENV_MODE_IIR) {
         iir_filter_reset(&env->lpf);
     }
 }
+
+/* ------------------------------------------------------------------ */
+/* Multi-channel lane detector                                         */
+/* ------------------------------------------------------------------ */
+
+int envelope_lanes_init(envelope_lanes_t *env, const envelope_t *tmpl, int width)
+{
+    memset(env, 0, sizeof(*env));
+    if (width < 1) width = 1;
+    if (width > ENVELOPE_MAX_LANES) width = ENVELOPE_MAX_LANES;
+    env->mode = tmpl->mode;
+    env->width = width;
+
+    if (env->mode == ENV_MODE_MULTIPASS) {
+        return multipass_lanes_init(&env->mpf, tmpl->mpf.n_passes,
+                                    tmpl->mpf.window_size, width);
+    } else if (env->mode == ENV_MODE_IIR) {
+        iir_lanes_init(&env->lpf, width);
+    }
+    return 0;
+}
+
+void envelope_lanes_free(envelope_lanes_t *env)
+{
+    multipass_lanes_free(&env->mpf);
+}
+
+void envelope_lanes_set(envelope_lanes_t *env, int lane, const envelope_t *src)
+{
+    if (lane < 0 || lane >= env->width) return;
+    env->threshold_on[lane]  = src->threshold_on;
+    env->threshold_off[lane] = src->threshold_off;
+    env->peak_level[lane]    = src->peak_level;
+    env->noise_level[lane]   = src->noise_level;
+    env->prev_state[lane]    = src->prev_state;
+    if (env->mode == ENV_MODE_IIR) {
+        iir_lanes_set(&env->lpf, lane, &src->lpf);
+    }
+}
+
+void envelope_lanes_peak_scalar(const float *data, int n, int width, float *peak)
+{
+    for (int l = 0; l < width; l++) peak[l] = 0.0f;
+    for (int i = 0; i < n; i++) {
+        const float *x = data + i * width;
+        for (int l = 0; l < width; l++) {
+            if (x[l] > peak[l]) peak[l] = x[l];
+        }
+    }
+}
+
+void envelope_lanes_hysteresis_scalar(const float *data, int n, int width,
+                                      const float *on_thr, const float *off_thr,
+                                      int *state, int *on_off)
+{
+    for (int l = 0; l < width; l++) {
+        int st = state[l];
+        for (int i = 0; i < n; i++) {
+            float x = data[i * width + l];
+            st = (x >= (st ? off_thr[l] : on_thr[l])) ? 1 : 0;
+            on_off[i * width + l] = st;
+        }
+        state[l] = st;
+    }
+}
+
+void envelope_lanes_process(envelope_lanes_t *env, float *data, int *on_off, int n)
+{
+    const cw_kernels_t *k = cw_get_kernels();
+    int w = env->width;
+    int native = (w == k->lane_width);
+    float chunk_peak[ENVELOPE_MAX_LANES];
+    float on_thr[ENVELOPE_MAX_LANES];
+    float off_thr[ENVELOPE_MAX_LANES];
+
+    if (n <= 0) return;
+
+    /* Step 1: Rectify (lane layout does not matter) */
+    k->rectify(data, data, n * w);
+
+    /* Step 2: Lowpass filter */
+    if (env->mode == ENV_MODE_MULTIPASS) {
+        if (native) k->lanes_multipass(&env->mpf, data, n);
+        else multipass_lanes_process_scalar(&env->mpf, data, n);
+    } else if (env->mode == ENV_MODE_IIR) {
+        iir_lanes_process(&env->lpf, data, n);
+    }
+
+    /* Step 3: Peak tracking (per lane, once per chunk) */
+    if (native) k->lanes_peak(data, n, w, chunk_peak);
+    else envelope_lanes_peak_scalar(data, n, w, chunk_peak);
+
+    for (int l = 0; l < w; l++) {
+        if (chunk_peak[l] > env->peak_level[l]) {
+            env->peak_level[l] = chunk_peak[l];
+        } else {
+            env->peak_level[l] = 0.995f * env->peak_level[l] + 0.005f * chunk_peak[l];
+        }
+        envelope_thresholds(env->peak_level[l], env->noise_level[l],
+                            env->threshold_on[l], env->threshold_off[l],
+                            &on_thr[l], &off_thr[l]);
+    }
+
+    /* Step 4: Hysteresis thresholding */
+    if (native) {
+        k->lanes_hysteresis(data, n, w, on_thr, off_thr, env->prev_state, on_off);
+    } else {
+        envelope_lanes_hysteresis_scalar(data, n, w, on_thr, off_thr,
+                                         env->prev_state, on_off);
+    }
+}
+
+int envelope_lanes_runs(const int *on_off, int n, int width, int lane, int *runs)
+{
+    if (n <= 0) return 0;
+
+    const int *p = on_off + lane;
+    int n_runs = 0;
+    int state = p[0];
+    int start = 0;
+
+    for (int i = 1; i < n; i++) {
+        int on = p[i * width];
+        if (on != state) {
+            runs[n_runs++] = state ? (i - start) : -(i - start);
+            state = on;
+            start = i;
+        }
+    }
+    runs[n_runs++] = state ? (n - start) : -(n - start);
+    return n_runs;
+}
+
+void envelope_lanes_reset(envelope_lanes_t *env)
+{
+    memset(env->peak_level, 0, sizeof(env->peak_level));
+    memset(env->noise_level, 0, sizeof(env->noise_level));
+    memset(env->prev_state, 0, sizeof(env->prev_state));
+    if (env->mode == ENV_MODE_MULTIPASS) {
+        multipass_lanes_reset(&env->mpf);
+    } else if (env->mode == ENV_MODE_IIR) {
+        iir_lanes_reset(&env->lpf);
+    }
+}
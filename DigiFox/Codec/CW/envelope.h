@@ -2,6 +2,10 @@
  * envelope.h — Envelope detector with peak tracking and hysteresis
  *
  * Processing: |audio| → lowpass → peak tracking → hysteresis → on/off
+ *
+ * Thresholds are a fraction of the peak, gated above a multiple of the
+ * noise floor. The floor is 0 unless the front end measures one (sliding
+ * DFT), so the gate keeps a decayed peak from keying on noise.
  */
 
 #ifndef ENVELOPE_H
@@ -9,10 +13,12 @@
 
 #include "iir_filter.h"
 #include "multipass_avg.h"
+#include <stdint.h>
 
 typedef enum {
     ENV_MODE_IIR       = 0,
     ENV_MODE_MULTIPASS = 1,
+    ENV_MODE_NONE      = 2,   /* Front end output is already smooth */
 } envelope_mode_t;
 
 typedef struct {
@@ -28,6 +34,9 @@ typedef struct {
     /* Peak tracking */
     float peak_level;
 
+    /* Noise floor, set by the caller before each chunk (default 0) */
+    float noise_level;
+
     /* Hysteresis thresholds (fraction of peak) */
     float threshold_on;
     float threshold_off;
@@ -44,12 +53,32 @@ typedef struct {
  * @param window_s       Smoothing window in seconds
  * @param thresh_on      On threshold (fraction of peak, e.g. 0.5)
  * @param thresh_off     Off threshold (fraction of peak, e.g. 0.4)
- * @param mode           ENV_MODE_IIR or ENV_MODE_MULTIPASS
+ * @param mode           ENV_MODE_IIR, ENV_MODE_MULTIPASS or ENV_MODE_NONE
  * @param mp_passes      Number of multipass passes (default 3)
+ * @return 0 on success, -1 on allocation failure
+ */
+int envelope_init(envelope_t *env, int sample_rate, float window_s,
+                  float thresh_on, float thresh_off,
+                  envelope_mode_t mode, int mp_passes);
+
+/**
+ * Bytes of history envelope_init_in() needs (0 unless ENV_MODE_MULTIPASS).
+ */
+size_t envelope_mem_size(int sample_rate, float window_s,
+                         envelope_mode_t mode, int mp_passes);
+
+/**
+ * envelope_init() with the multipass history in caller memory:
+ * envelope_mem_size() bytes at mem, float-aligned. Cannot fail.
  */
-void envelope_init(envelope_t *env, int sample_rate, float window_s,
-                   float thresh_on, float thresh_off,
-                   envelope_mode_t mode, int mp_passes);
+void envelope_init_in(envelope_t *env, void *mem, int sample_rate, float window_s,
+                      float thresh_on, float thresh_off,
+                      envelope_mode_t mode, int mp_passes);
+
+/**
+ * Free envelope detector memory (multipass history, unless caller-provided).
+ */
+void envelope_free(envelope_t *env);
 
 /**
  * Process audio chunk and produce on/off decisions.
@@ -61,9 +90,180 @@ void envelope_init(envelope_t *env, int sample_rate, float window_s,
  */
 void envelope_process(envelope_t *env, const float *audio, int *on_off, int n);
 
+/* Words needed for n bit-packed on/off decisions */
+#define ENVELOPE_BITS_WORDS(n) (((n) + 31) / 32)
+
+/**
+ * Process audio chunk in-place and produce bit-packed on/off decisions.
+ * Same decisions as envelope_process(); sample i is bit (i & 31) of
+ * bits[i >> 5]. Unused bits of the last word are zero.
+ *
+ * @param env    Envelope state
+ * @param data   Input audio, n floats (overwritten with the envelope)
+ * @param bits   Output, ENVELOPE_BITS_WORDS(n) words
+ * @param n      Number of samples
+ */
+void envelope_process_bits(envelope_t *env, float *data, uint32_t *bits, int n);
+
+/**
+ * Process audio chunk in-place and produce on/off transition runs.
+ * Each run is a signed length: +len on-samples or -len off-samples.
+ * Consecutive runs alternate in sign.
+ *
+ * @param env    Envelope state
+ * @param data   Input audio, n floats (overwritten with the envelope)
+ * @param runs   Output runs, up to n entries
+ * @param n      Number of samples
+ * @return Number of runs written
+ */
+int envelope_process_runs(envelope_t *env, float *data, int *runs, int n);
+
+/**
+ * Convert n bit-packed on/off decisions to signed runs.
+ * @return Number of runs written (at most n)
+ */
+int envelope_bits_to_runs(const uint32_t *bits, int n, int *runs);
+
 /**
  * Reset envelope state.
  */
 void envelope_reset(envelope_t *env);
 
+/* ------------------------------------------------------------------ */
+/* Multi-channel (struct-of-arrays) envelope detector                  */
+/* ------------------------------------------------------------------ */
+
+#define ENVELOPE_MAX_LANES IIR_MAX_LANES
+
+/*
+ * Envelope state for up to 8 channels stepped together.
+ * Mode and smoothing window are shared; thresholds are per lane.
+ * Same per-chunk peak tracking and hysteresis as envelope_process().
+ */
+typedef struct {
+    envelope_mode_t mode;
+    int width;                 /* Lane stride: 4 or 8 */
+
+    iir_lanes_t lpf;           /* IIR mode */
+    multipass_lanes_t mpf;     /* Multipass mode */
+
+    float peak_level[ENVELOPE_MAX_LANES];
+    float noise_level[ENVELOPE_MAX_LANES];
+    float threshold_on[ENVELOPE_MAX_LANES];
+    float threshold_off[ENVELOPE_MAX_LANES];
+    int   prev_state[ENVELOPE_MAX_LANES];
+} envelope_lanes_t;
+
+/**
+ * Initialize the lane detector from a single-channel template.
+ * Smoothing (mode, window, passes) is copied to every lane.
+ *
+ * @param env    Output struct
+ * @param tmpl   Initialized single-channel detector
+ * @param width  Lane stride (4 or 8)
+ * @return 0 on success, -1 on allocation failure
+ */
+int envelope_lanes_init(envelope_lanes_t *env, const envelope_t *tmpl, int width);
+
+/**
+ * Free lane detector memory (multipass history).
+ */
+void envelope_lanes_free(envelope_lanes_t *env);
+
+/**
+ * Set per-lane thresholds (and lowpass, in IIR mode) from a detector.
+ */
+void envelope_lanes_set(envelope_lanes_t *env, int lane, const envelope_t *src);
+
+/**
+ * Process an interleaved chunk in-place and produce interleaved on/off.
+ *
+ * @param env    Lane state
+ * @param data   Interleaved bandpassed audio, n * width floats (overwritten)
+ * @param on_off Interleaved on/off output, n * width ints
+ * @param n      Samples per lane
+ */
+void envelope_lanes_process(envelope_lanes_t *env, float *data, int *on_off, int n);
+
+/**
+ * Extract one lane of an interleaved on/off chunk as signed runs.
+ * @return Number of runs written (at most n)
+ */
+int envelope_lanes_runs(const int *on_off, int n, int width, int lane, int *runs);
+
+/**
+ * Reset lane envelope state.
+ */
+void envelope_lanes_reset(envelope_lanes_t *env);
+
+/* ------------------------------------------------------------------ */
+/* Per-ISA kernels (selected via cw_get_kernels())                     */
+/* ------------------------------------------------------------------ */
+
+/* on/off bits per nibble — see envelope.c */
+extern const unsigned char envelope_hyst_lut[512];
+
+void  envelope_rectify_scalar(const float *in, float *out, int n);
+float envelope_peak_scalar(const float *data, int n);
+int   envelope_hysteresis_scalar(const float *data, int n,
+                                 float on_thr, float off_thr,
+                                 int state, int *on_off);
+int   envelope_hysteresis_bits_scalar(const float *data, int n,
+                                      float on_thr, float off_thr,
+                                      int state, uint32_t *bits);
+void  envelope_lanes_peak_scalar(const float *data, int n, int width, float *peak);
+void  envelope_lanes_hysteresis_scalar(const float *data, int n, int width,
+                                       const float *on_thr, const float *off_thr,
+                                       int *state, int *on_off);
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+void  envelope_rectify_neon(float *data, int n);
+void  envelope_rectify_copy_neon(const float *in, float *out, int n);
+float envelope_peak_neon(const float *data, int n);
+int   envelope_hysteresis_neon(const float *data, int n,
+                               float on_thr, float off_thr,
+                               int state, int *on_off);
+int   envelope_hysteresis_bits_neon(const float *data, int n,
+                                    float on_thr, float off_thr,
+                                    int state, uint32_t *bits);
+void  multipass_process_neon(multipass_avg_t *mp, float *data, int n);
+void  multipass_lanes_process_neon(multipass_lanes_t *mp, float *data, int n);
+void  envelope_lanes_peak_neon(const float *data, int n, int width, float *peak);
+void  envelope_lanes_hysteresis_neon(const float *data, int n, int width,
+                                     const float *on_thr, const float *off_thr,
+                                     int *state, int *on_off);
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+void  envelope_rectify_copy_sse2(const float *in, float *out, int n);
+float envelope_peak_sse2(const float *data, int n);
+int   envelope_hysteresis_sse2(const float *data, int n,
+                               float on_thr, float off_thr,
+                               int state, int *on_off);
+int   envelope_hysteresis_bits_sse2(const float *data, int n,
+                                    float on_thr, float off_thr,
+                                    int state, uint32_t *bits);
+void  multipass_process_sse2(multipass_avg_t *mp, float *data, int n);
+void  multipass_lanes_process_sse2(multipass_lanes_t *mp, float *data, int n);
+void  envelope_lanes_peak_sse2(const float *data, int n, int width, float *peak);
+void  envelope_lanes_hysteresis_sse2(const float *data, int n, int width,
+                                     const float *on_thr, const float *off_thr,
+                                     int *state, int *on_off);
+
+void  envelope_rectify_copy_avx2(const float *in, float *out, int n);
+float envelope_peak_avx2(const float *data, int n);
+int   envelope_hysteresis_avx2(const float *data, int n,
+                               float on_thr, float off_thr,
+                               int state, int *on_off);
+int   envelope_hysteresis_bits_avx2(const float *data, int n,
+                                    float on_thr, float off_thr,
+                                    int state, uint32_t *bits);
+void  multipass_process_avx2(multipass_avg_t *mp, float *data, int n);
+void  multipass_lanes_process_avx2(multipass_lanes_t *mp, float *data, int n);
+void  envelope_lanes_peak_avx2(const float *data, int n, int width, float *peak);
+void  envelope_lanes_hysteresis_avx2(const float *data, int n, int width,
+                                     const float *on_thr, const float *off_thr,
+                                     int *state, int *on_off);
+#endif
+
 #endif /* ENVELOPE_H */
@@ -1,11 +1,14 @@
 /**
  * envelope_neon.c — NEON vectorized envelope operations
  *
- * Vectorizes rectification (fabsf) for multi-channel batch processing.
+ * Single-channel: rectify, peak search, hysteresis, and the multipass
+ * moving average run as a pass wavefront (pass p one sample behind p-1).
+ * Multi-channel: the same stages for 4 interleaved lanes.
  */
 
 #if defined(__aarch64__) || defined(_M_ARM64)
 
+#include "envelope.h"
 #include <arm_neon.h>
 
 /**
@@ -26,4 +29,210 @@ void envelope_rectify_neon(float *data, int n)
     }
 }
 
+/**
+ * Rectify into a separate buffer: out[i] = fabsf(in[i])
+ */
+void envelope_rectify_copy_neon(const float *in, float *out, int n)
+{
+    int i = 0;
+    for (; i + 3 < n; i += 4) {
+        vst1q_f32(out + i, vabsq_f32(vld1q_f32(in + i)));
+    }
+    envelope_rectify_scalar(in + i, out + i, n - i);
+}
+
+float envelope_peak_neon(const float *data, int n)
+{
+    float32x4_t vmax = vdupq_n_f32(0.0f);
+    int i = 0;
+    for (; i + 3 < n; i += 4) {
+        vmax = vmaxq_f32(vmax, vld1q_f32(data + i));
+    }
+    float peak = vmaxvq_f32(vmax);
+    float tail = envelope_peak_scalar(data + i, n - i);
+    return tail > peak ? tail : peak;
+}
+
+/* Compare mask → 4-bit pattern (bit j = lane j) */
+static inline unsigned movemask_neon(uint32x4_t m)
+{
+    static const uint32_t bits[4] = { 1, 2, 4, 8 };
+    return vaddvq_u32(vandq_u32(m, vld1q_u32(bits)));
+}
+
+/* on/off bit pattern → four ints */
+static const int32_t hyst_expand[16][4] = {
+    {0,0,0,0}, {1,0,0,0}, {0,1,0,0}, {1,1,0,0},
+    {0,0,1,0}, {1,0,1,0}, {0,1,1,0}, {1,1,1,0},
+    {0,0,0,1}, {1,0,0,1}, {0,1,0,1}, {1,1,0,1},
+    {0,0,1,1}, {1,0,1,1}, {0,1,1,1}, {1,1,1,1},
+};
+
+int envelope_hysteresis_neon(const float *data, int n,
+                             float on_thr, float off_thr,
+                             int state, int *on_off)
+{
+    float32x4_t von  = vdupq_n_f32(on_thr);
+    float32x4_t voff = vdupq_n_f32(off_thr);
+    unsigned st = state ? 1u : 0u;
+    int i = 0;
+
+    for (; i + 3 < n; i += 4) {
+        float32x4_t x = vld1q_f32(data + i);
+        unsigned a = movemask_neon(vcgeq_f32(x, von));
+        unsigned b = movemask_neon(vcgeq_f32(x, voff));
+        unsigned e = envelope_hyst_lut[st << 8 | a << 4 | b];
+        vst1q_s32(on_off + i, vld1q_s32(hyst_expand[e & 15]));
+        st = e >> 4;
+    }
+    return envelope_hysteresis_scalar(data + i, n - i, on_thr, off_thr,
+                                      (int)st, on_off + i);
+}
+
+int envelope_hysteresis_bits_neon(const float *data, int n,
+                                  float on_thr, float off_thr,
+                                  int state, uint32_t *bits)
+{
+    float32x4_t von  = vdupq_n_f32(on_thr);
+    float32x4_t voff = vdupq_n_f32(off_thr);
+    unsigned st = state ? 1u : 0u;
+    int i = 0;
+
+    /* Eight nibbles per word */
+    for (; i + 31 < n; i += 32) {
+        uint32_t word = 0;
+        for (int j = 0; j < 32; j += 4) {
+            float32x4_t x = vld1q_f32(data + i + j);
+            unsigned a = movemask_neon(vcgeq_f32(x, von));
+            unsigned b = movemask_neon(vcgeq_f32(x, voff));
+            unsigned e = envelope_hyst_lut[st << 8 | a << 4 | b];
+            word |= (uint32_t)(e & 15) << j;
+            st = e >> 4;
+        }
+        bits[i >> 5] = word;
+    }
+    return envelope_hysteresis_bits_scalar(data + i, n - i, on_thr, off_thr,
+                                           (int)st, bits + (i >> 5));
+}
+
+/**
+ * Single-channel cascaded moving average, passes run as a wavefront.
+ */
+void multipass_process_neon(multipass_avg_t *mp, float *data, int n)
+{
+    int passes = mp->n_passes;
+    int w = mp->window_size;
+    if (passes < 2 || passes > 4 || n < 8) {
+        multipass_process(mp, data, n);
+        return;
+    }
+
+    multipass_prime(mp, data[0]);
+
+    int last = passes - 1;
+    float y[MULTIPASS_MAX_PASSES] = {0};
+    float out[4];
+
+    /* Ramp-up: passes enter one step apart */
+    multipass_wave_steps(mp, y, data, n, 0, last);
+
+    float32x4_t vinv = vdupq_n_f32(1.0f / (float)w);
+    float32x4_t vsum = vld1q_f32(mp->running_sum);
+    float32x4_t vy   = vld1q_f32(y);
+    int row = (mp->pos + last) % w;
+
+    for (int t = last; t < n; t++) {
+        float *h = mp->hist + row * mp->stride;
+        /* x = [data[t], y0, y1, y2] — each pass feeds the next */
+        float32x4_t vx = vextq_f32(vdupq_n_f32(data[t]), vy, 3);
+        vsum = vaddq_f32(vsum, vsubq_f32(vx, vld1q_f32(h)));
+        vy = vmulq_f32(vsum, vinv);
+        vst1q_f32(h, vy);
+        vst1q_f32(out, vy);
+        data[t - last] = out[last];
+        if (++row == w) row = 0;
+    }
+
+    vst1q_f32(out, vsum);
+    for (int p = 0; p < passes; p++) mp->running_sum[p] = out[p];
+    vst1q_f32(y, vy);
+
+    /* Drain: later passes finish the last samples */
+    multipass_wave_steps(mp, y, data, n, n, n + last);
+    mp->pos = (mp->pos + n) % w;
+}
+
+/**
+ * Lane-parallel cascaded moving average, 4 interleaved lanes.
+ */
+void multipass_lanes_process_neon(multipass_lanes_t *mp, float *data, int n)
+{
+    int w = mp->window_size;
+    int passes = mp->n_passes;
+    float32x4_t vinv = vdupq_n_f32(1.0f / (float)w);
+    float32x4_t vsum[MULTIPASS_MAX_PASSES];
+
+    if (n <= 0) return;
+    multipass_lanes_prime(mp, data);
+
+    for (int pass = 0; pass < passes; pass++) {
+        vsum[pass] = vld1q_f32(mp->running_sum[pass]);
+    }
+
+    /* One sweep: each sample runs through every pass before the next */
+    int pos = mp->pos;
+    float *p = data;
+    for (int i = 0; i < n; i++, p += 4) {
+        float *old = multipass_lanes_hist(mp, pos, 0);
+        float32x4_t vx = vld1q_f32(p);
+        for (int pass = 0; pass < passes; pass++, old += 4) {
+            vsum[pass] = vaddq_f32(vsum[pass], vsubq_f32(vx, vld1q_f32(old)));
+            vx = vmulq_f32(vsum[pass], vinv);
+            vst1q_f32(old, vx);
+        }
+        vst1q_f32(p, vx);
+        if (++pos == w) pos = 0;
+    }
+
+    for (int pass = 0; pass < passes; pass++) {
+        vst1q_f32(mp->running_sum[pass], vsum[pass]);
+    }
+    mp->pos = pos;
+}
+
+/**
+ * Per-lane maximum over a chunk of 4 interleaved lanes (floor 0).
+ */
+void envelope_lanes_peak_neon(const float *data, int n, int width, float *peak)
+{
+    (void)width;
+    float32x4_t vmax = vdupq_n_f32(0.0f);
+    for (int i = 0; i < n; i++) {
+        vmax = vmaxq_f32(vmax, vld1q_f32(data + i * 4));
+    }
+    vst1q_f32(peak, vmax);
+}
+
+/**
+ * Per-lane hysteresis on 4 interleaved lanes:
+ * state = x >= (state ? off : on)
+ */
+void envelope_lanes_hysteresis_neon(const float *data, int n, int width,
+                                    const float *on_thr, const float *off_thr,
+                                    int *state, int *on_off)
+{
+    (void)width;
+    float32x4_t von  = vld1q_f32(on_thr);
+    float32x4_t voff = vld1q_f32(off_thr);
+    uint32x4_t  one  = vdupq_n_u32(1);
+    uint32x4_t  vst  = vcgtq_u32(vld1q_u32((const uint32_t *)state), vdupq_n_u32(0));
+
+    for (int i = 0; i < n; i++) {
+        float32x4_t thr = vbslq_f32(vst, voff, von);
+        vst = vcgeq_f32(vld1q_f32(data + i * 4), thr);
+        vst1q_s32(on_off + i * 4, vreinterpretq_s32_u32(vandq_u32(vst, one)));
+    }
+    vst1q_s32(state, vreinterpretq_s32_u32(vandq_u32(vst, one)));
+}
+
 #endif /* __aarch64__ */
@@ -0,0 +1,423 @@
+/**
+ * envelope_x86.c — SSE2/AVX2 vectorized envelope operations
+ *
+ * Single-channel: rectify, peak search, hysteresis, and the multipass
+ * moving average run as a pass wavefront (pass p one sample behind p-1).
+ * Multi-channel: the same stages for 4 (SSE2) or 8 (AVX2) interleaved lanes.
+ *
+ * Only compiled on x86; the AVX2 kernels are selected at runtime.
+ */
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+
+#include "envelope.h"
+#include <emmintrin.h>
+#include <immintrin.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CW_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CW_TARGET_AVX2
+#endif
+
+/* on/off bit pattern → four ints */
+static const int hyst_expand[16][4] = {
+    {0,0,0,0}, {1,0,0,0}, {0,1,0,0}, {1,1,0,0},
+    {0,0,1,0}, {1,0,1,0}, {0,1,1,0}, {1,1,1,0},
+    {0,0,0,1}, {1,0,0,1}, {0,1,0,1}, {1,1,0,1},
+    {0,0,1,1}, {1,0,1,1}, {0,1,1,1}, {1,1,1,1},
+};
+
+/* ------------------------------------------------------------------ */
+/* SSE2 single-channel                                                 */
+/* ------------------------------------------------------------------ */
+
+void envelope_rectify_copy_sse2(const float *in, float *out, int n)
+{
+    const __m128 mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    int i = 0;
+    for (; i + 3 < n; i += 4) {
+        _mm_storeu_ps(out + i, _mm_and_ps(_mm_loadu_ps(in + i), mask));
+    }
+    envelope_rectify_scalar(in + i, out + i, n - i);
+}
+
+float envelope_peak_sse2(const float *data, int n)
+{
+    __m128 vmax = _mm_setzero_ps();
+    int i = 0;
+    for (; i + 3 < n; i += 4) {
+        vmax = _mm_max_ps(vmax, _mm_loadu_ps(data + i));
+    }
+    vmax = _mm_max_ps(vmax, _mm_shuffle_ps(vmax, vmax, _MM_SHUFFLE(1, 0, 3, 2)));
+    vmax = _mm_max_ps(vmax, _mm_shuffle_ps(vmax, vmax, _MM_SHUFFLE(2, 3, 0, 1)));
+    float peak = _mm_cvtss_f32(vmax);
+    float tail = envelope_peak_scalar(data + i, n - i);
+    return tail > peak ? tail : peak;
+}
+
+int envelope_hysteresis_sse2(const float *data, int n,
+                             float on_thr, float off_thr,
+                             int state, int *on_off)
+{
+    __m128 von  = _mm_set1_ps(on_thr);
+    __m128 voff = _mm_set1_ps(off_thr);
+    unsigned st = state ? 1u : 0u;
+    int i = 0;
+
+    for (; i + 3 < n; i += 4) {
+        __m128 x = _mm_loadu_ps(data + i);
+        unsigned a = (unsigned)_mm_movemask_ps(_mm_cmpge_ps(x, von));
+        unsigned b = (unsigned)_mm_movemask_ps(_mm_cmpge_ps(x, voff));
+        unsigned e = envelope_hyst_lut[st << 8 | a << 4 | b];
+        _mm_storeu_si128((__m128i *)(on_off + i),
+                         _mm_loadu_si128((const __m128i *)hyst_expand[e & 15]));
+        st = e >> 4;
+    }
+    return envelope_hysteresis_scalar(data + i, n - i, on_thr, off_thr,
+                                      (int)st, on_off + i);
+}
+
+int envelope_hysteresis_bits_sse2(const float *data, int n,
+                                  float on_thr, float off_thr,
+                                  int state, uint32_t *bits)
+{
+    __m128 von  = _mm_set1_ps(on_thr);
+    __m128 voff = _mm_set1_ps(off_thr);
+    unsigned st = state ? 1u : 0u;
+    int i = 0;
+
+    /* Eight nibbles per word */
+    for (; i + 31 < n; i += 32) {
+        uint32_t word = 0;
+        for (int j = 0; j < 32; j += 4) {
+            __m128 x = _mm_loadu_ps(data + i + j);
+            unsigned a = (unsigned)_mm_movemask_ps(_mm_cmpge_ps(x, von));
+            unsigned b = (unsigned)_mm_movemask_ps(_mm_cmpge_ps(x, voff));
+            unsigned e = envelope_hyst_lut[st << 8 | a << 4 | b];
+            word |= (uint32_t)(e & 15) << j;
+            st = e >> 4;
+        }
+        bits[i >> 5] = word;
+    }
+    return envelope_hysteresis_bits_scalar(data + i, n - i, on_thr, off_thr,
+                                           (int)st, bits + (i >> 5));
+}
+
+void multipass_process_sse2(multipass_avg_t *mp, float *data, int n)
+{
+    int passes = mp->n_passes;
+    int w = mp->window_size;
+    if (passes < 2 || passes > 4 || n < 8) {
+        multipass_process(mp, data, n);
+        return;
+    }
+
+    multipass_prime(mp, data[0]);
+
+    int last = passes - 1;
+    float y[MULTIPASS_MAX_PASSES] = {0};
+    float out[4];
+
+    /* Ramp-up: passes enter one step apart */
+    multipass_wave_steps(mp, y, data, n, 0, last);
+
+    __m128 vinv = _mm_set1_ps(1.0f / (float)w);
+    __m128 vsum = _mm_loadu_ps(mp->running_sum);
+    __m128 vy   = _mm_loadu_ps(y);
+    int row = (mp->pos + last) % w;
+
+    for (int t = last; t < n; t++) {
+        float *h = mp->hist + row * mp->stride;
+        /* x = [data[t], y0, y1, y2] — each pass feeds the next */
+        __m128 vx = _mm_move_ss(_mm_shuffle_ps(vy, vy, _MM_SHUFFLE(2, 1, 0, 0)),
+                                _mm_set_ss(data[t]));
+        vsum = _mm_add_ps(vsum, _mm_sub_ps(vx, _mm_loadu_ps(h)));
+        vy = _mm_mul_ps(vsum, vinv);
+        _mm_storeu_ps(h, vy);
+        _mm_storeu_ps(out, vy);
+        data[t - last] = out[last];
+        if (++row == w) row = 0;
+    }
+
+    _mm_storeu_ps(out, vsum);
+    for (int p = 0; p < passes; p++) mp->running_sum[p] = out[p];
+    _mm_storeu_ps(y, vy);
+
+    /* Drain: later passes finish the last samples */
+    multipass_wave_steps(mp, y, data, n, n, n + last);
+    mp->pos = (mp->pos + n) % w;
+}
+
+/* ------------------------------------------------------------------ */
+/* SSE2 multi-channel (4 lanes)                                        */
+/* ------------------------------------------------------------------ */
+
+void multipass_lanes_process_sse2(multipass_lanes_t *mp, float *data, int n)
+{
+    int w = mp->window_size;
+    int passes = mp->n_passes;
+    __m128 vinv = _mm_set1_ps(1.0f / (float)w);
+    __m128 vsum[MULTIPASS_MAX_PASSES];
+
+    if (n <= 0) return;
+    multipass_lanes_prime(mp, data);
+
+    for (int pass = 0; pass < passes; pass++) {
+        vsum[pass] = _mm_loadu_ps(mp->running_sum[pass]);
+    }
+
+    /* One sweep: each sample runs through every pass before the next */
+    int pos = mp->pos;
+    float *p = data;
+    for (int i = 0; i < n; i++, p += 4) {
+        float *old = multipass_lanes_hist(mp, pos, 0);
+        __m128 vx = _mm_loadu_ps(p);
+        for (int pass = 0; pass < passes; pass++, old += 4) {
+            vsum[pass] = _mm_add_ps(vsum[pass], _mm_sub_ps(vx, _mm_loadu_ps(old)));
+            vx = _mm_mul_ps(vsum[pass], vinv);
+            _mm_storeu_ps(old, vx);
+        }
+        _mm_storeu_ps(p, vx);
+        if (++pos == w) pos = 0;
+    }
+
+    for (int pass = 0; pass < passes; pass++) {
+        _mm_storeu_ps(mp->running_sum[pass], vsum[pass]);
+    }
+    mp->pos = pos;
+}
+
+void envelope_lanes_peak_sse2(const float *data, int n, int width, float *peak)
+{
+    (void)width;
+    __m128 vmax = _mm_setzero_ps();
+    for (int i = 0; i < n; i++) {
+        vmax = _mm_max_ps(vmax, _mm_loadu_ps(data + i * 4));
+    }
+    _mm_storeu_ps(peak, vmax);
+}
+
+void envelope_lanes_hysteresis_sse2(const float *data, int n, int width,
+                                    const float *on_thr, const float *off_thr,
+                                    int *state, int *on_off)
+{
+    (void)width;
+    __m128  von  = _mm_loadu_ps(on_thr);
+    __m128  voff = _mm_loadu_ps(off_thr);
+    __m128i one  = _mm_set1_epi32(1);
+    __m128i vst  = _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i *)state),
+                                   _mm_setzero_si128());
+
+    for (int i = 0; i < n; i++) {
+        __m128 m   = _mm_castsi128_ps(vst);
+        __m128 thr = _mm_or_ps(_mm_and_ps(m, voff), _mm_andnot_ps(m, von));
+        vst = _mm_castps_si128(_mm_cmpge_ps(_mm_loadu_ps(data + i * 4), thr));
+        _mm_storeu_si128((__m128i *)(on_off + i * 4), _mm_and_si128(vst, one));
+    }
+    _mm_storeu_si128((__m128i *)state, _mm_and_si128(vst, one));
+}
+
+/* ------------------------------------------------------------------ */
+/* AVX2 single-channel                                                 */
+/* ------------------------------------------------------------------ */
+
+CW_TARGET_AVX2
+void envelope_rectify_copy_avx2(const float *in, float *out, int n)
+{
+    const __m256 mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    int i = 0;
+    for (; i + 7 < n; i += 8) {
+        _mm256_storeu_ps(out + i, _mm256_and_ps(_mm256_loadu_ps(in + i), mask));
+    }
+    envelope_rectify_scalar(in + i, out + i, n - i);
+}
+
+CW_TARGET_AVX2
+float envelope_peak_avx2(const float *data, int n)
+{
+    __m256 vmax = _mm256_setzero_ps();
+    int i = 0;
+    for (; i + 7 < n; i += 8) {
+        vmax = _mm256_max_ps(vmax, _mm256_loadu_ps(data + i));
+    }
+    __m128 m = _mm_max_ps(_mm256_castps256_ps128(vmax), _mm256_extractf128_ps(vmax, 1));
+    m = _mm_max_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = _mm_max_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+    float peak = _mm_cvtss_f32(m);
+    float tail = envelope_peak_scalar(data + i, n - i);
+    return tail > peak ? tail : peak;
+}
+
+CW_TARGET_AVX2
+int envelope_hysteresis_avx2(const float *data, int n,
+                             float on_thr, float off_thr,
+                             int state, int *on_off)
+{
+    __m256 von  = _mm256_set1_ps(on_thr);
+    __m256 voff = _mm256_set1_ps(off_thr);
+    unsigned st = state ? 1u : 0u;
+    int i = 0;
+
+    for (; i + 7 < n; i += 8) {
+        __m256 x = _mm256_loadu_ps(data + i);
+        unsigned a = (unsigned)_mm256_movemask_ps(_mm256_cmp_ps(x, von, _CMP_GE_OQ));
+        unsigned b = (unsigned)_mm256_movemask_ps(_mm256_cmp_ps(x, voff, _CMP_GE_OQ));
+        unsigned lo = envelope_hyst_lut[st << 8 | (a & 15) << 4 | (b & 15)];
+        unsigned hi = envelope_hyst_lut[(lo >> 4) << 8 | (a >> 4) << 4 | (b >> 4)];
+        __m256i bits = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)hyst_expand[lo & 15])),
+            _mm_loadu_si128((const __m128i *)hyst_expand[hi & 15]), 1);
+        _mm256_storeu_si256((__m256i *)(on_off + i), bits);
+        st = hi >> 4;
+    }
+    return envelope_hysteresis_scalar(data + i, n - i, on_thr, off_thr,
+                                      (int)st, on_off + i);
+}
+
+CW_TARGET_AVX2
+int envelope_hysteresis_bits_avx2(const float *data, int n,
+                                  float on_thr, float off_thr,
+                                  int state, uint32_t *bits)
+{
+    __m256 von  = _mm256_set1_ps(on_thr);
+    __m256 voff = _mm256_set1_ps(off_thr);
+    unsigned st = state ? 1u : 0u;
+    int i = 0;
+
+    /* Four bytes per word */
+    for (; i + 31 < n; i += 32) {
+        uint32_t word = 0;
+        for (int j = 0; j < 32; j += 8) {
+            __m256 x = _mm256_loadu_ps(data + i + j);
+            unsigned a = (unsigned)_mm256_movemask_ps(_mm256_cmp_ps(x, von, _CMP_GE_OQ));
+            unsigned b = (unsigned)_mm256_movemask_ps(_mm256_cmp_ps(x, voff, _CMP_GE_OQ));
+            unsigned lo = envelope_hyst_lut[st << 8 | (a & 15) << 4 | (b & 15)];
+            unsigned hi = envelope_hyst_lut[(lo >> 4) << 8 | (a >> 4) << 4 | (b >> 4)];
+            word |= (uint32_t)((lo & 15) | (hi & 15) << 4) << j;
+            st = hi >> 4;
+        }
+        bits[i >> 5] = word;
+    }
+    return envelope_hysteresis_bits_scalar(data + i, n - i, on_thr, off_thr,
+                                           (int)st, bits + (i >> 5));
+}
+
+CW_TARGET_AVX2
+void multipass_process_avx2(multipass_avg_t *mp, float *data, int n)
+{
+    int passes = mp->n_passes;
+    int w = mp->window_size;
+    if (passes <= 4 || n < 16) {
+        multipass_process_sse2(mp, data, n);
+        return;
+    }
+
+    multipass_prime(mp, data[0]);
+
+    int last = passes - 1;
+    float y[MULTIPASS_MAX_PASSES] = {0};
+    float out[8];
+    const __m256i shift = _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6);
+
+    multipass_wave_steps(mp, y, data, n, 0, last);
+
+    __m256 vinv = _mm256_set1_ps(1.0f / (float)w);
+    __m256 vsum = _mm256_loadu_ps(mp->running_sum);
+    __m256 vy   = _mm256_loadu_ps(y);
+    int row = (mp->pos + last) % w;
+
+    for (int t = last; t < n; t++) {
+        float *h = mp->hist + row * mp->stride;
+        __m256 vx = _mm256_blend_ps(_mm256_permutevar8x32_ps(vy, shift),
+                                    _mm256_set1_ps(data[t]), 0x01);
+        vsum = _mm256_add_ps(vsum, _mm256_sub_ps(vx, _mm256_loadu_ps(h)));
+        vy = _mm256_mul_ps(vsum, vinv);
+        _mm256_storeu_ps(h, vy);
+        _mm256_storeu_ps(out, vy);
+        data[t - last] = out[last];
+        if (++row == w) row = 0;
+    }
+
+    _mm256_storeu_ps(out, vsum);
+    for (int p = 0; p < passes; p++) mp->running_sum[p] = out[p];
+    _mm256_storeu_ps(y, vy);
+
+    multipass_wave_steps(mp, y, data, n, n, n + last);
+    mp->pos = (mp->pos + n) % w;
+}
+
+/* ------------------------------------------------------------------ */
+/* AVX2 multi-channel (8 lanes)                                        */
+/* ------------------------------------------------------------------ */
+
+CW_TARGET_AVX2
+void multipass_lanes_process_avx2(multipass_lanes_t *mp, float *data, int n)
+{
+    int w = mp->window_size;
+    int passes = mp->n_passes;
+    __m256 vinv = _mm256_set1_ps(1.0f / (float)w);
+    __m256 vsum[MULTIPASS_MAX_PASSES];
+
+    if (n <= 0) return;
+    multipass_lanes_prime(mp, data);
+
+    for (int pass = 0; pass < passes; pass++) {
+        vsum[pass] = _mm256_loadu_ps(mp->running_sum[pass]);
+    }
+
+    /* One sweep: each sample runs through every pass before the next */
+    int pos = mp->pos;
+    float *p = data;
+    for (int i = 0; i < n; i++, p += 8) {
+        float *old = multipass_lanes_hist(mp, pos, 0);
+        __m256 vx = _mm256_loadu_ps(p);
+        for (int pass = 0; pass < passes; pass++, old += 8) {
+            vsum[pass] = _mm256_add_ps(vsum[pass],
+                                       _mm256_sub_ps(vx, _mm256_loadu_ps(old)));
+            vx = _mm256_mul_ps(vsum[pass], vinv);
+            _mm256_storeu_ps(old, vx);
+        }
+        _mm256_storeu_ps(p, vx);
+        if (++pos == w) pos = 0;
+    }
+
+    for (int pass = 0; pass < passes; pass++) {
+        _mm256_storeu_ps(mp->running_sum[pass], vsum[pass]);
+    }
+    mp->pos = pos;
+}
+
+CW_TARGET_AVX2
+void envelope_lanes_peak_avx2(const float *data, int n, int width, float *peak)
+{
+    (void)width;
+    __m256 vmax = _mm256_setzero_ps();
+    for (int i = 0; i < n; i++) {
+        vmax = _mm256_max_ps(vmax, _mm256_loadu_ps(data + i * 8));
+    }
+    _mm256_storeu_ps(peak, vmax);
+}
+
+CW_TARGET_AVX2
+void envelope_lanes_hysteresis_avx2(const float *data, int n, int width,
+                                    const float *on_thr, const float *off_thr,
+                                    int *state, int *on_off)
+{
+    (void)width;
+    __m256  von  = _mm256_loadu_ps(on_thr);
+    __m256  voff = _mm256_loadu_ps(off_thr);
+    __m256i one  = _mm256_set1_epi32(1);
+    __m256i vst  = _mm256_cmpgt_epi32(_mm256_loadu_si256((const __m256i *)state),
+                                      _mm256_setzero_si256());
+
+    for (int i = 0; i < n; i++) {
+        __m256 thr = _mm256_blendv_ps(von, voff, _mm256_castsi256_ps(vst));
+        vst = _mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(data + i * 8),
+                                                thr, _CMP_GE_OQ));
+        _mm256_storeu_si256((__m256i *)(on_off + i * 8), _mm256_and_si256(vst, one));
+    }
+    _mm256_storeu_si256((__m256i *)state, _mm256_and_si256(vst, one));
+}
+
+#endif /* x86 */
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""Generate morse_merged_table.h from the character table in morse_table.c.
+
+For every pattern of up to MERGED_MAX_LEN elements the table holds the
+result of the merged lookup: the direct match, else the best-weight split
+into two characters (first best wins, '?' never matches), else '?'.
+
+usage: python3 gen_morse_merged.py   (run from any directory)
+"""
+
+import os
+import re
+
+MERGED_MAX_LEN = 10                     # Codes below 1 << (MERGED_MAX_LEN + 1)
+TABLE_SIZE = 256                        # Direct table: up to 7 elements
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SRC = os.path.join(HERE, "morse_table.c")
+OUT = os.path.join(HERE, "morse_merged_table.h")
+
+
+def read_table():
+    text = open(SRC).read()
+    table = {}
+    for code, ch, weight in re.findall(
+            r"\[0x([0-9A-Fa-f]+)\]\s*=\s*\{('(?:\\.|[^'])')\s*,\s*(\d+)\}", text):
+        table[int(code, 16)] = (eval(ch), int(weight))
+    return table
+
+
+def merged(table, code):
+    ch, _ = table.get(code, ("?", 0))
+    if ch != "?":
+        return ch, ""
+    length = code.bit_length() - 1
+    if length <= 1:
+        return "?", ""
+
+    bits = code & ((1 << length) - 1)
+    best, best_w = None, -1
+    for pos in range(1, length):
+        left = (1 << pos) | (bits >> (length - pos))
+        right = (1 << (length - pos)) | (bits & ((1 << (length - pos)) - 1))
+        if left >= TABLE_SIZE or right >= TABLE_SIZE:
+            continue
+        lc, lw = table.get(left, ("?", 0))
+        rc, rw = table.get(right, ("?", 0))
+        if lc != "?" and rc != "?" and lw + rw > best_w:
+            best, best_w = (lc, rc), lw + rw
+    return best if best else ("?", "")
+
+
+def c_char(c):
+    if not c:
+        return "0"
+    if c in "'\\":
+        return "'\\%s'" % c
+    return "'%s'" % c
+
+
+def main():
+    table = read_table()
+    size = 1 << (MERGED_MAX_LEN + 1)
+    rows = []
+    for base in range(0, size, 8):
+        cells = []
+        for code in range(base, base + 8):
+            a, b = merged(table, code) if code >= 2 else ("", "")
+            cells.append("{%s,%s}" % (c_char(a), c_char(b)))
+        rows.append("    " + ", ".join(cells) + ",")
+
+    with open(OUT, "w") as f:
+        f.write("""/**
+ * morse_merged_table.h — Precomputed merged lookup (generated)
+ *
+ * Generated by gen_morse_merged.py from morse_table.c — do not edit.
+ * Entry [code] is the morse_lookup_merged_code() result for every
+ * pattern of up to MORSE_MERGED_MAX_LEN elements: one character, or two
+ * for the best split (second 0 when there is none).
+ */
+
+#ifndef MORSE_MERGED_TABLE_H
+#define MORSE_MERGED_TABLE_H
+
+#define MORSE_MERGED_MAX_LEN  %d
+#define MORSE_MERGED_SIZE     %d
+
+static const char MORSE_MERGED[MORSE_MERGED_SIZE][2] = {
+%s
+};
+
+#endif /* MORSE_MERGED_TABLE_H */
+""" % (MERGED_MAX_LEN, size, "\n".join(rows)))
+
+
+if __name__ == "__main__":
+    main()
@@ -1,12 +1,25 @@
 #ifndef GGMORSE_C_API_H
 #define GGMORSE_C_API_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 typedef struct ggmorse_wrapper ggmorse_wrapper;
 
+/// A decoded character of a channel (' ' for a word gap, '\n' when the pitch
+/// jumps to another signal, warning NULL), or a capture/parameter warning
+/// (channel -1, character 0).
+typedef void (*ggmorse_wrapper_event_cb)(void * userData, int channel,
+                                         char character, const char * warning);
+
+/// Strongest spectral peaks between fMin and fMax into dst[nTaken..n), each
+/// at least minSpacing from the rest of dst; returns the count in dst.
+typedef int (*ggmorse_wrapper_pitch_cb)(void * userData, float fMin_hz, float fMax_hz,
+                                        float minSpacing_hz, float * dst, int nTaken, int n);
+
 /// Create a ggmorse decoder instance.
 /// @param sampleRate Input audio sample rate (e.g. 12000, 48000)
 /// @param samplesPerFrame Samples per processing frame (default 128)
@@ -25,15 +38,135 @@ int ggmorse_wrapper_process(ggmorse_wrapper * inst,
                             const float * samples, int nSamples,
                             char * output, int maxOutput);
 
+/// Feed audio samples and decode without copying them first.
+/// Takes any number of samples per call; the rest of a frame waits for the
+/// next one. Same arguments and result as ggmorse_wrapper_process(), don't
+/// mix the two on one instance.
+int ggmorse_wrapper_process_push(ggmorse_wrapper * inst,
+                                 const float * samples, int nSamples,
+                                 char * output, int maxOutput);
+
+/// ggmorse_wrapper_process_push() for unsigned 8-bit PCM (128 = silence),
+/// e.g. the TruSDX US audio bytes as they come off the demuxer.
+int ggmorse_wrapper_process_push_u8(ggmorse_wrapper * inst,
+                                    const uint8_t * samples, int nSamples,
+                                    char * output, int maxOutput);
+
+/// A decoded character and where in the audio it was decoded, with the
+/// channel's estimates at that moment.
+typedef struct {
+    int64_t sample;     ///< Input sample its last mark ended at (a space: where the
+                        ///< word gap began), counted from create, reset or set_window
+    float wpm;          ///< Speed estimate
+    float pitch_hz;     ///< Pitch it was decoded at
+    float confidence;   ///< 0..1: how well the speed/level search fits the window
+    int channel;
+    char character;     ///< ' ' for a word gap, '\n' for a jump to another signal
+} ggmorse_wrapper_char_event;
+
+/// ggmorse_wrapper_process_push() returning the characters as records in
+/// the caller's array instead of text, e.g. to place them on a waterfall.
+/// Characters beyond maxEvents are dropped; the event callback still sees
+/// every one.
+/// @return Number of records written (0 if none)
+int ggmorse_wrapper_process_events(ggmorse_wrapper * inst,
+                                   const float * samples, int nSamples,
+                                   ggmorse_wrapper_char_event * events, int maxEvents);
+
+/// ggmorse_wrapper_process_events() for unsigned 8-bit PCM (128 = silence).
+int ggmorse_wrapper_process_events_u8(ggmorse_wrapper * inst,
+                                      const uint8_t * samples, int nSamples,
+                                      ggmorse_wrapper_char_event * events, int maxEvents);
+
+/// Decode a whole recording at once (e.g. an archive being scanned) on
+/// several threads, with the instance's pitch, speed and squelch settings.
+/// The audio is cut into 2-minute segments decoded independently, each
+/// after a 15 s lead-in of the audio before it whose text is dropped, so
+/// the text matches one stream decode except where the pitch or speed
+/// changed within a lead-in of a cut, and does not depend on nThreads.
+/// The instance's own decoding state, callbacks and pitch source are not
+/// used or touched.
+/// @param nThreads Tasks on the shared scheduler (task_sched.h), the caller
+///        included, at batch priority; <= 0 for one per core
+/// @return Number of decoded characters written to output (NUL-terminated)
+int ggmorse_wrapper_decode_batch(ggmorse_wrapper * inst,
+                                 const float * samples, int64_t nSamples, int nThreads,
+                                 char * output, int maxOutput);
+
 /// Get estimated pitch frequency in Hz.
 float ggmorse_wrapper_get_pitch(ggmorse_wrapper * inst);
 
 /// Get estimated speed in WPM.
 float ggmorse_wrapper_get_speed(ggmorse_wrapper * inst);
 
-/// Reset decoder state.
+/// Reset decoder state in place (no reallocation, parameters are kept).
 void ggmorse_wrapper_reset(ggmorse_wrapper * inst);
 
+/// Retune in place through setParametersDecode(): the audio history, the
+/// speed estimate and the decoded text are kept, only the detector moves.
+/// @param frequency_hz Pitch to decode, <= 0 to auto-detect (the default)
+/// @param fMin_hz, fMax_hz Band searched for pitches (default 200-1200 Hz, up to
+///        half the analysis rate, 2000 Hz by default)
+/// @param speed_wpm Fixed speed, <= 0 to auto-detect (the default)
+/// @return 0, or -1 for a bad band (the instance is then unchanged)
+int ggmorse_wrapper_retune(ggmorse_wrapper * inst, float frequency_hz,
+                           float fMin_hz, float fMax_hz, float speed_wpm);
+
+/// Evaluate the per-frame speed/level search on several threads.
+/// @param nThreads Threads including the caller (1 = inline, the default)
+void ggmorse_wrapper_set_search_threads(ggmorse_wrapper * inst, int nThreads);
+
+/// Thin out the fine speed/level search around the last estimate, for
+/// less work per frame at some cost in weak or drifting signals.
+/// @param step 1 = every grid point (the default), 2 = every other one
+void ggmorse_wrapper_set_search_step(ggmorse_wrapper * inst, int step);
+
+/// Skip the detector and the speed/level search while no tone stands out
+/// of the band, catching up over the stored window once one does.
+/// @param on 1 = squelch (the default), 0 = analyse every frame
+void ggmorse_wrapper_set_squelch(ggmorse_wrapper * inst, int on);
+
+/// Analyse a shorter window (less delay and memory, for fast CW) or the
+/// audio at another rate. Starts decoding over, as a new instance would,
+/// keeping the other settings and callbacks.
+/// @param window_s Audio the speed search looks at, 1-3 s; characters come
+///        out a third to five sixths of it late. 0 = 3 s (the default)
+/// @param baseRate_hz Analysis rate, 2000-8000 Hz; pitches up to half of it
+///        are decoded. 0 = 4000 Hz (the default)
+/// @return 0, or -1 for a bad value or a pitch band above half the rate
+///         (the instance is then unchanged)
+int ggmorse_wrapper_set_window(ggmorse_wrapper * inst, float window_s, float baseRate_hz);
+
+/// Keep the sample histories, spectrogram and detector output as 16-bit
+/// half floats: half the memory per channel, 11 significant bits. Starts
+/// decoding over, as set_window does.
+/// @param on 1 = half precision, 0 = float (the default)
+void ggmorse_wrapper_set_half_history(ggmorse_wrapper * inst, int on);
+
+/// Receive decoded characters and warnings as they happen, on the thread
+/// calling process(); the callback must not block. NULL (the default)
+/// drops them, nothing is written to stdout/stderr either way.
+void ggmorse_wrapper_set_event_callback(ggmorse_wrapper * inst,
+                                        ggmorse_wrapper_event_cb cb, void * userData);
+
+/// Take pitches from a spectrum the app already computes (e.g. the shared
+/// spectrum engine) instead of ggmorse's own STFFT, which is then skipped
+/// and leaves the spectrogram rows empty. Called on the thread calling
+/// process(). NULL (the default) goes back to the STFFT.
+void ggmorse_wrapper_set_pitch_source(ggmorse_wrapper * inst,
+                                      ggmorse_wrapper_pitch_cb cb, void * userData);
+
+/// Width of a spectrogram row: power bins from 0 to half the analysis rate
+/// (2000 Hz by default).
+int ggmorse_wrapper_get_spectrogram_bins(ggmorse_wrapper * inst);
+
+/// Copy the spectrogram rows produced after row number *seq, oldest first.
+/// @param seq In: last row already seen (0 = start). Out: advanced past the copied rows.
+/// @param dst Buffer of maxRows * ggmorse_wrapper_get_spectrogram_bins() floats
+/// @return Number of rows copied
+int ggmorse_wrapper_get_spectrogram_rows(ggmorse_wrapper * inst, int64_t * seq,
+                                         float * dst, int maxRows);
+
 #ifdef __cplusplus
 }
 #endif
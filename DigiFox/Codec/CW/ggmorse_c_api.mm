@@ -1,39 +1,157 @@
 #import "ggmorse_c_api.h"
 #include "ggmorse.h"
+#include "task_sched.h"
 
-#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cstring>
+#include <string>
+#include <vector>
 
 struct ggmorse_wrapper {
     GGMorse * morse;
     std::vector<float> audioBuffer;
+    GGMorse::TxRx rxData;       // reused by takeRxData()
     int readOffset;
     float sampleRate;
+    int samplesPerFrame;
+    float frequency_hz;         // <= 0 - auto-detect
+    float speed_wpm;            // <= 0 - auto-detect
+    float frequencyRangeMin_hz;
+    float frequencyRangeMax_hz;
+    int searchThreads;
+    int searchStep;
+    bool squelch;
+    float window_s;             // <= 0 - GGMorse::kMaxWindowToAnalyze_s
+    float baseRate_hz;          // <= 0 - GGMorse::kBaseSampleRate
+    bool halfHistory;           // Parameters::halfPrecisionHistory
+    ggmorse_wrapper_event_cb eventCb;
+    void * eventUserData;
+    ggmorse_wrapper_pitch_cb pitchCb;
+    void * pitchUserData;
+    // caller's array while ggmorse_wrapper_process_events() runs, else NULL
+    ggmorse_wrapper_char_event * events;
+    int maxEvents;
+    int nEvents;
 };
 
-ggmorse_wrapper * ggmorse_wrapper_create(float sampleRate, int samplesPerFrame) {
-    auto * inst = new ggmorse_wrapper();
-    inst->sampleRate = sampleRate;
-    inst->readOffset = 0;
+// Characters with the channel's estimates as they stand when it is decoded
+static void recordEvent(ggmorse_wrapper * inst, const ggmorse_Event * event) {
+    if (inst->nEvents >= inst->maxEvents) return;
 
-    GGMorse::Parameters params;
-    params.sampleRateInp = sampleRate;
-    params.sampleRateOut = sampleRate;
-    params.samplesPerFrame = samplesPerFrame > 0 ? samplesPerFrame : GGMorse::kDefaultSamplesPerFrame;
-    params.sampleFormatInp = GGMORSE_SAMPLE_FORMAT_F32;
-    params.sampleFormatOut = GGMORSE_SAMPLE_FORMAT_F32;
+    const GGMorse::Statistics & stats = inst->morse->getStatistics(event->channel);
+    ggmorse_wrapper_char_event & e = inst->events[inst->nEvents++];
+    e.sample = std::llround(event->time_s*inst->sampleRate);
+    e.wpm = stats.estimatedSpeed_wpm;
+    e.pitch_hz = stats.estimatedPitch_Hz;
+    e.confidence = std::min(1.0f, std::max(0.0f, 1.0f - stats.costFunction));
+    e.channel = event->channel;
+    e.character = event->character;
+}
+
+// The text comes from takeRxData() or the event array; without a callback
+// the events are dropped instead of echoed on stdout from the audio thread
+static void forwardEvent(const ggmorse_Event * event, void * userData) {
+    auto * inst = static_cast<ggmorse_wrapper *>(userData);
+    if (inst->events && event->type == GGMORSE_EVENT_CHARACTER) recordEvent(inst, event);
+    if (!inst->eventCb) return;
 
-    inst->morse = new GGMorse(params);
+    if (event->type == GGMORSE_EVENT_CHARACTER) {
+        inst->eventCb(inst->eventUserData, event->channel, event->character, nullptr);
+    } else {
+        inst->eventCb(inst->eventUserData, -1, 0, event->message);
+    }
+}
 
-    // Set decode parameters: auto-detect pitch and speed
+// For the decoders of a batch decode, which report through their text only
+static void dropEvent(const ggmorse_Event *, void *) {
+}
+
+// Pitch and speed as retuned (auto-detect by default) over the CW passband
+static GGMorse::ParametersDecode decodeParameters(const ggmorse_wrapper * inst) {
     GGMorse::ParametersDecode decParams = GGMorse::getDefaultParametersDecode();
-    decParams.frequency_hz = -1.0f;  // auto-detect
-    decParams.speed_wpm = -1.0f;     // auto-detect
-    decParams.frequencyRangeMin_hz = 200.0f;
-    decParams.frequencyRangeMax_hz = 1200.0f;
+    decParams.frequency_hz = inst->frequency_hz > 0.0f ? inst->frequency_hz : -1.0f;
+    decParams.speed_wpm = inst->speed_wpm > 0.0f ? inst->speed_wpm : -1.0f;
+    decParams.frequencyRangeMin_hz = inst->frequencyRangeMin_hz;
+    decParams.frequencyRangeMax_hz = inst->frequencyRangeMax_hz;
     decParams.applyFilterHighPass = true;
     decParams.applyFilterLowPass = true;
-    inst->morse->setParametersDecode(decParams);
+    decParams.incrementalSearch = true;
+    decParams.slidingGoertzel = true;
+    decParams.searchThreads = inst->searchThreads;
+    decParams.searchStep = inst->searchStep;
+    decParams.squelch = inst->squelch;
+    return decParams;
+}
+
+static void applyDecodeParameters(ggmorse_wrapper * inst) {
+    inst->morse->setParametersDecode(decodeParameters(inst));
+}
+
+static GGMorse::Parameters parameters(const ggmorse_wrapper * inst) {
+    GGMorse::Parameters params = GGMorse::getDefaultParameters();
+    params.sampleRateInp = inst->sampleRate;
+    params.sampleRateOut = inst->sampleRate;
+    params.samplesPerFrame = inst->samplesPerFrame;
+    params.sampleFormatInp = GGMORSE_SAMPLE_FORMAT_F32;
+    params.sampleFormatOut = GGMORSE_SAMPLE_FORMAT_F32;
+    params.sampleRateBase = inst->baseRate_hz > 0.0f ? inst->baseRate_hz : GGMorse::kBaseSampleRate;
+    params.windowToAnalyze_s = inst->window_s > 0.0f ? inst->window_s : GGMorse::kMaxWindowToAnalyze_s;
+    params.halfPrecisionHistory = inst->halfHistory;
+    return params;
+}
+
+// A new decoder for parameters(inst), keeping the settings and callbacks;
+// the audio not yet decoded is dropped
+static void rebuild(ggmorse_wrapper * inst) {
+    delete inst->morse;
+    inst->morse = new GGMorse(parameters(inst));
+    inst->morse->setEventCallback(forwardEvent, inst);
+    inst->morse->setPitchSource(inst->pitchCb, inst->pitchUserData);
+    applyDecodeParameters(inst);
+
+    inst->audioBuffer.clear();
+    inst->readOffset = 0;
+}
+
+// Get decoded text
+static int takeText(ggmorse_wrapper * inst, char * output, int maxOutput) {
+    const GGMorse::TxRx & rxData = inst->rxData;
+    int n = inst->morse->takeRxData(inst->rxData);
+    if (n <= 0 || maxOutput <= 0) return 0;
+
+    int outLen = std::min(n, maxOutput - 1);
+    for (int i = 0; i < outLen; i++) {
+        output[i] = (char)rxData[i];
+    }
+    output[outLen] = '\0';
+    return outLen;
+}
+
+ggmorse_wrapper * ggmorse_wrapper_create(float sampleRate, int samplesPerFrame) {
+    auto * inst = new ggmorse_wrapper();
+    inst->sampleRate = sampleRate;
+    inst->readOffset = 0;
+    inst->frequency_hz = -1.0f;
+    inst->speed_wpm = -1.0f;
+    inst->frequencyRangeMin_hz = 200.0f;
+    inst->frequencyRangeMax_hz = 1200.0f;
+    inst->searchThreads = 1;
+    inst->searchStep = 1;
+    inst->squelch = true;
+    inst->window_s = 0.0f;
+    inst->baseRate_hz = 0.0f;
+    inst->halfHistory = false;
+    // takeRxData() hands this buffer to the decoder, which would grow it
+    // on the audio thread; give it the capacity the channel starts with
+    inst->rxData.reserve(1024);
+
+    inst->samplesPerFrame = samplesPerFrame > 0 ? samplesPerFrame : GGMorse::kDefaultSamplesPerFrame;
+
+    inst->morse = new GGMorse(parameters(inst));
+    inst->morse->setEventCallback(forwardEvent, inst);
+    applyDecodeParameters(inst);
 
     return inst;
 }
@@ -69,14 +187,112 @@ int ggmorse_wrapper_process(ggmorse_wrapper * inst,
         return (uint32_t)(toCopy * bytesPerSample);
     });
 
-    // Get decoded text
-    GGMorse::TxRx rxData;
-    int n = inst->morse->takeRxData(rxData);
-    if (n <= 0 || maxOutput <= 0) return 0;
+    return takeText(inst, output, maxOutput);
+}
 
-    int outLen = std::min(n, maxOutput - 1);
-    for (int i = 0; i < outLen; i++) {
-        output[i] = (char)rxData[i];
+int ggmorse_wrapper_process_push(ggmorse_wrapper * inst,
+                                 const float * samples, int nSamples,
+                                 char * output, int maxOutput) {
+    if (!inst || !inst->morse || !samples || nSamples <= 0) return 0;
+
+    inst->morse->decodePush(samples, nSamples);
+
+    return takeText(inst, output, maxOutput);
+}
+
+int ggmorse_wrapper_process_push_u8(ggmorse_wrapper * inst,
+                                    const uint8_t * samples, int nSamples,
+                                    char * output, int maxOutput) {
+    if (!inst || !inst->morse || !samples || nSamples <= 0) return 0;
+
+    inst->morse->decodePush(samples, nSamples);
+
+    return takeText(inst, output, maxOutput);
+}
+
+// The rx text is taken and dropped: the events carry it
+template <typename T>
+static int processEvents(ggmorse_wrapper * inst, const T * samples, int nSamples,
+                         ggmorse_wrapper_char_event * events, int maxEvents) {
+    if (!inst || !inst->morse || !samples || nSamples <= 0 || !events || maxEvents <= 0) return 0;
+
+    inst->events = events;
+    inst->maxEvents = maxEvents;
+    inst->nEvents = 0;
+
+    inst->morse->decodePush(samples, nSamples);
+    inst->morse->takeRxData(inst->rxData);
+
+    inst->events = nullptr;
+    return inst->nEvents;
+}
+
+int ggmorse_wrapper_process_events(ggmorse_wrapper * inst,
+                                   const float * samples, int nSamples,
+                                   ggmorse_wrapper_char_event * events, int maxEvents) {
+    return processEvents(inst, samples, nSamples, events, maxEvents);
+}
+
+int ggmorse_wrapper_process_events_u8(ggmorse_wrapper * inst,
+                                      const uint8_t * samples, int nSamples,
+                                      ggmorse_wrapper_char_event * events, int maxEvents) {
+    return processEvents(inst, samples, nSamples, events, maxEvents);
+}
+
+// Batch segments: long enough that the lead-ins cost little, short enough
+// to spread an hour over the cores. The lead-in covers the analysis window
+// and lets the pitch, speed and level estimates settle.
+static constexpr float kBatchSegment_s = 120.0f;
+static constexpr float kBatchLeadIn_s = 15.0f;
+
+int ggmorse_wrapper_decode_batch(ggmorse_wrapper * inst,
+                                 const float * samples, int64_t nSamples, int nThreads,
+                                 char * output, int maxOutput) {
+    if (!inst || !inst->morse || !samples || nSamples <= 0 || !output || maxOutput <= 0) return 0;
+
+    const int64_t segment = (int64_t) (kBatchSegment_s*inst->sampleRate);
+    const int64_t leadIn = (int64_t) (kBatchLeadIn_s*inst->sampleRate);
+    const int nSegments = (int) ((nSamples + segment - 1)/segment);
+
+    task_sched_t * sched = task_sched_shared();
+    if (nThreads <= 0) nThreads = task_sched_concurrency(sched);
+    nThreads = std::max(1, std::min(nThreads, nSegments));
+
+    GGMorse::ParametersDecode decParams = decodeParameters(inst);
+    decParams.searchThreads = 1;
+
+    // one decoder per task, reset for each segment it takes
+    std::vector<std::string> texts(nSegments);
+    std::atomic<int> next{0};
+    auto work = [&] {
+        GGMorse morse(parameters(inst));
+        morse.setEventCallback(dropEvent, nullptr);
+        morse.setParametersDecode(decParams);
+        GGMorse::TxRx rx;
+
+        for (int k; (k = next.fetch_add(1)) < nSegments; ) {
+            const int64_t start = k*segment;
+            const int64_t from = std::max<int64_t>(0, start - leadIn);
+            const int64_t end = std::min(nSamples, start + segment);
+
+            morse.reset();
+            morse.decodePush(samples + from, (int) (start - from));
+            morse.takeRxData(rx);
+
+            morse.decodePush(samples + start, (int) (end - start));
+            if (morse.takeRxData(rx) > 0) texts[k].assign(rx.begin(), rx.end());
+        }
+    };
+
+    // batch priority: live CW and slot decodes on the shared workers go first
+    task_sched_parallel(sched, TASK_PRIO_BATCH, nThreads,
+                        [](void * ctx, int) { (*static_cast<decltype(work) *>(ctx))(); }, &work);
+
+    int outLen = 0;
+    for (const auto & text : texts) {
+        const int n = std::min((int) text.size(), maxOutput - 1 - outLen);
+        std::memcpy(output + outLen, text.data(), n);
+        outLen += n;
     }
     output[outLen] = '\0';
     return outLen;
@@ -94,28 +310,93 @@ float ggmorse_wrapper_get_speed(ggmorse_wrapper * inst) {
 
 void ggmorse_wrapper_reset(ggmorse_wrapper * inst) {
     if (!inst || !inst->morse) return;
-    // Recreate to reset all state
-    float sr = inst->sampleRate;
-    int spf = inst->morse->getSamplesPerFrame();
-    delete inst->morse;
-
-    GGMorse::Parameters params;
-    params.sampleRateInp = sr;
-    params.sampleRateOut = sr;
-    params.samplesPerFrame = spf;
-    params.sampleFormatInp = GGMORSE_SAMPLE_FORMAT_F32;
-    params.sampleFormatOut = GGMORSE_SAMPLE_FORMAT_F32;
-    inst->morse = new GGMorse(params);
-
-    GGMorse::ParametersDecode decParams = GGMorse::getDefaultParametersDecode();
-    decParams.frequency_hz = -1.0f;
-    decParams.speed_wpm = -1.0f;
-    decParams.frequencyRangeMin_hz = 200.0f;
-    decParams.frequencyRangeMax_hz = 1200.0f;
-    decParams.applyFilterHighPass = true;
-    decParams.applyFilterLowPass = true;
-    inst->morse->setParametersDecode(decParams);
+    // Clears the decoder in place, keeping its buffers and parameters
+    inst->morse->reset();
 
     inst->audioBuffer.clear();
     inst->readOffset = 0;
 }
+
+int ggmorse_wrapper_retune(ggmorse_wrapper * inst, float frequency_hz,
+                           float fMin_hz, float fMax_hz, float speed_wpm) {
+    if (!inst || !inst->morse) return -1;
+    // the pitch search runs on the base rate
+    const float fNyquist = 0.5f*inst->morse->getSampleRateBase();
+    if (fMin_hz <= 0.0f || fMax_hz > fNyquist || fMin_hz >= fMax_hz) return -1;
+
+    inst->frequency_hz = frequency_hz;
+    inst->speed_wpm = speed_wpm;
+    inst->frequencyRangeMin_hz = fMin_hz;
+    inst->frequencyRangeMax_hz = fMax_hz;
+    applyDecodeParameters(inst);
+    return 0;
+}
+
+void ggmorse_wrapper_set_search_threads(ggmorse_wrapper * inst, int nThreads) {
+    if (!inst || !inst->morse) return;
+    inst->searchThreads = nThreads > 1 ? nThreads : 1;
+    applyDecodeParameters(inst);
+}
+
+void ggmorse_wrapper_set_search_step(ggmorse_wrapper * inst, int step) {
+    if (!inst || !inst->morse) return;
+    inst->searchStep = std::min(std::max(step, 1), 2);
+    applyDecodeParameters(inst);
+}
+
+void ggmorse_wrapper_set_squelch(ggmorse_wrapper * inst, int on) {
+    if (!inst || !inst->morse) return;
+    inst->squelch = on != 0;
+    applyDecodeParameters(inst);
+}
+
+int ggmorse_wrapper_set_window(ggmorse_wrapper * inst, float window_s, float baseRate_hz) {
+    if (!inst || !inst->morse) return -1;
+    if (window_s > 0.0f && (window_s < GGMorse::kMinWindowToAnalyze_s || window_s > GGMorse::kMaxWindowToAnalyze_s)) return -1;
+    if (baseRate_hz > 0.0f && (baseRate_hz < GGMorse::kMinBaseSampleRate || baseRate_hz > GGMorse::kMaxBaseSampleRate)) return -1;
+    const float base = baseRate_hz > 0.0f ? baseRate_hz : GGMorse::kBaseSampleRate;
+    if (inst->frequencyRangeMax_hz > 0.5f*base) return -1;
+
+    inst->window_s = window_s;
+    inst->baseRate_hz = baseRate_hz;
+
+    // the histories and the search are sized for them: a new decoder
+    rebuild(inst);
+    return 0;
+}
+
+void ggmorse_wrapper_set_half_history(ggmorse_wrapper * inst, int on) {
+    if (!inst || !inst->morse) return;
+    if (inst->halfHistory == (on != 0)) return;
+
+    inst->halfHistory = on != 0;
+    rebuild(inst);
+}
+
+void ggmorse_wrapper_set_event_callback(ggmorse_wrapper * inst,
+                                        ggmorse_wrapper_event_cb cb, void * userData) {
+    if (!inst) return;
+    inst->eventCb = cb;
+    inst->eventUserData = userData;
+}
+
+void ggmorse_wrapper_set_pitch_source(ggmorse_wrapper * inst,
+                                      ggmorse_wrapper_pitch_cb cb, void * userData) {
+    if (!inst || !inst->morse) return;
+    inst->pitchCb = cb;
+    inst->pitchUserData = userData;
+    inst->morse->setPitchSource(cb, userData);
+}
+
+int ggmorse_wrapper_get_spectrogram_bins(ggmorse_wrapper * inst) {
+    if (!inst || !inst->morse) return 0;
+    int nRows, nBins, head;
+    inst->morse->getSpectrogramRing(nRows, nBins, head);
+    return nBins;
+}
+
+int ggmorse_wrapper_get_spectrogram_rows(ggmorse_wrapper * inst, int64_t * seq,
+                                         float * dst, int maxRows) {
+    if (!inst || !inst->morse || !seq) return 0;
+    return inst->morse->getSpectrogramRows(*seq, dst, maxRows);
+}
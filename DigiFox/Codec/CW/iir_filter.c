@@ -6,6 +6,7 @@
  */
 
 #include "iir_filter.h"
+#include "simd_detect.h"
 #include <math.h>
 #include <string.h>
 
@@ -15,14 +16,17 @@
 
 /* ------------------------------------------------------------------ */
 /* Analog Butterworth prototype poles (unit circle, left half-plane)   */
+/*                                                                     */
+/* Design runs in double and keeps the double coefficients; the float */
+/* sections are rounded from them (see iir_precision_t).               */
 /* ------------------------------------------------------------------ */
 
-static void butter_analog_poles(int order, float *poles_re, float *poles_im)
+static void butter_analog_poles(int order, double *poles_re, double *poles_im)
 {
     for (int k = 0; k < order; k++) {
-        float angle = (float)M_PI * (2 * k + order + 1) / (2 * order);
-        poles_re[k] = cosf(angle);
-        poles_im[k] = sinf(angle);
+        double angle = M_PI * (2 * k + order + 1) / (2 * order);
+        poles_re[k] = cos(angle);
+        poles_im[k] = sin(angle);
     }
 }
 
@@ -31,17 +35,17 @@ static void butter_analog_poles(int order, float *poles_re, float *poles_im)
 /*   s = 2*fs * (z-1)/(z+1)  →  z = (1 + s/(2*fs)) / (1 - s/(2*fs)) */
 /* ------------------------------------------------------------------ */
 
-static void bilinear_transform(float s_re, float s_im, float fs,
-                                float *z_re, float *z_im)
+static void bilinear_transform(double s_re, double s_im, double fs,
+                                double *z_re, double *z_im)
 {
-    float t = 1.0f / (2.0f * fs);
+    double t = 1.0 / (2.0 * fs);
     /* z = (1 + s*t) / (1 - s*t) */
-    float num_re = 1.0f + s_re * t;
-    float num_im = s_im * t;
-    float den_re = 1.0f - s_re * t;
-    float den_im = -s_im * t;
+    double num_re = 1.0 + s_re * t;
+    double num_im = s_im * t;
+    double den_re = 1.0 - s_re * t;
+    double den_im = -s_im * t;
 
-    float den_mag2 = den_re * den_re + den_im * den_im;
+    double den_mag2 = den_re * den_re + den_im * den_im;
     *z_re = (num_re * den_re + num_im * den_im) / den_mag2;
     *z_im = (num_im * den_re - num_re * den_im) / den_mag2;
 }
@@ -50,39 +54,54 @@ static void bilinear_transform(float s_re, float s_im, float fs,
 /* Build SOS section from a pair of conjugate z-plane poles + zeros    */
 /* ------------------------------------------------------------------ */
 
-static void make_sos_from_pole_pair(float pz_re, float pz_im,
-                                     float zz_re, float zz_im,
-                                     float gain,
-                                     iir_section_t *sec)
+static void make_sos_from_pole_pair(double pz_re, double pz_im,
+                                     double zz_re, double zz_im,
+                                     double gain,
+                                     iir_section_d_t *sec)
 {
     /* Numerator: (z - z1)(z - z1*) = z^2 - 2*Re(z1)*z + |z1|^2 */
     sec->b[0] = gain;
-    sec->b[1] = gain * (-2.0f * zz_re);
+    sec->b[1] = gain * (-2.0 * zz_re);
     sec->b[2] = gain * (zz_re * zz_re + zz_im * zz_im);
 
     /* Denominator: (z - p1)(z - p1*) = z^2 - 2*Re(p1)*z + |p1|^2 */
-    sec->a[0] = 1.0f;
-    sec->a[1] = -2.0f * pz_re;
+    sec->a[0] = 1.0;
+    sec->a[1] = -2.0 * pz_re;
     sec->a[2] = pz_re * pz_re + pz_im * pz_im;
 
-    sec->z[0] = 0.0f;
-    sec->z[1] = 0.0f;
+    sec->z[0] = 0.0;
+    sec->z[1] = 0.0;
 }
 
-static void make_sos_from_real_pole(float pz, float zz, float gain,
-                                     iir_section_t *sec)
+static void make_sos_from_real_pole(double pz, double zz, double gain,
+                                     iir_section_d_t *sec)
 {
     /* First-order section stored as SOS: b2=0, a2=0 */
     sec->b[0] = gain;
     sec->b[1] = gain * (-zz);
-    sec->b[2] = 0.0f;
+    sec->b[2] = 0.0;
 
-    sec->a[0] = 1.0f;
+    sec->a[0] = 1.0;
     sec->a[1] = -pz;
-    sec->a[2] = 0.0f;
+    sec->a[2] = 0.0;
 
-    sec->z[0] = 0.0f;
-    sec->z[1] = 0.0f;
+    sec->z[0] = 0.0;
+    sec->z[1] = 0.0;
+}
+
+/* Round the designed double sections into the float sections */
+static void sections_to_float(iir_filter_t *f)
+{
+    for (int s = 0; s < f->n_sections; s++) {
+        const iir_section_d_t *d = &f->dsections[s];
+        iir_section_t *sec = &f->sections[s];
+        for (int k = 0; k < 3; k++) {
+            sec->b[k] = (float)d->b[k];
+            sec->a[k] = (float)d->a[k];
+        }
+        sec->z[0] = 0.0f;
+        sec->z[1] = 0.0f;
+    }
 }
 
 /* ------------------------------------------------------------------ */
@@ -95,13 +114,13 @@ void iir_design_lowpass(iir_filter_t *f, int order, float cutoff_hz, float fs)
     if (order < 1 || order > 2 * IIR_MAX_SECTIONS) return;
 
     /* Pre-warp cutoff for bilinear transform */
-    float wn = cutoff_hz / (fs / 2.0f);
-    if (wn >= 1.0f) wn = 0.999f;
-    if (wn <= 0.0f) wn = 0.001f;
-    float warped = 2.0f * fs * tanf((float)M_PI * wn / 2.0f);
+    double wn = (double)cutoff_hz / ((double)fs / 2.0);
+    if (wn >= 1.0) wn = 0.999;
+    if (wn <= 0.0) wn = 0.001;
+    double warped = 2.0 * fs * tan(M_PI * wn / 2.0);
 
     /* Analog prototype poles */
-    float ap_re[16], ap_im[16];
+    double ap_re[16], ap_im[16];
     butter_analog_poles(order, ap_re, ap_im);
 
     /* Scale to cutoff frequency */
@@ -115,54 +134,65 @@ void iir_design_lowpass(iir_filter_t *f, int order, float cutoff_hz, float fs)
 
     for (int k = 0; k < order / 2; k++) {
         int i = k;
-        int j = order - 1 - k;
 
-        /* Take pole pair: poles[i] and poles[j] are conjugate */
-        float pz1_re, pz1_im, pz2_re, pz2_im;
-        bilinear_transform(ap_re[i], ap_im[i], fs, &pz1_re, &pz1_im);
-        bilinear_transform(ap_re[j], ap_im[j], fs, &pz2_re, &pz2_im);
+        /* Take pole pair: poles[i] and poles[order-1-i] are conjugate */
+        double pz_re, pz_im;
+        bilinear_transform(ap_re[i], ap_im[i], fs, &pz_re, &pz_im);
 
         /* Lowpass zeros at z = -1 (Nyquist) */
-        float gain = 1.0f;
-        make_sos_from_pole_pair(pz1_re, pz1_im, -1.0f, 0.0f, gain, &f->sections[sec_idx]);
+        make_sos_from_pole_pair(pz_re, pz_im, -1.0, 0.0, 1.0, &f->dsections[sec_idx]);
         sec_idx++;
     }
 
     /* Odd order: one real pole */
     if (order % 2 == 1) {
         int mid = order / 2;
-        float pz_re, pz_im;
+        double pz_re, pz_im;
         bilinear_transform(ap_re[mid], ap_im[mid], fs, &pz_re, &pz_im);
-        make_sos_from_real_pole(pz_re, -1.0f, 1.0f, &f->sections[sec_idx]);
+        make_sos_from_real_pole(pz_re, -1.0, 1.0, &f->dsections[sec_idx]);
         sec_idx++;
     }
 
     f->n_sections = sec_idx;
 
     /* Normalize gain: evaluate H(z) at z=1 (DC) and set overall gain = 1 */
-    float total_gain = 1.0f;
+    double total_gain = 1.0;
     for (int s = 0; s < f->n_sections; s++) {
-        iir_section_t *sec = &f->sections[s];
-        float num_at_dc = sec->b[0] + sec->b[1] + sec->b[2];
-        float den_at_dc = sec->a[0] + sec->a[1] + sec->a[2];
-        if (fabsf(den_at_dc) > 1e-12f) {
+        iir_section_d_t *sec = &f->dsections[s];
+        double num_at_dc = sec->b[0] + sec->b[1] + sec->b[2];
+        double den_at_dc = sec->a[0] + sec->a[1] + sec->a[2];
+        if (fabs(den_at_dc) > 1e-12) {
             total_gain *= num_at_dc / den_at_dc;
         }
     }
 
     /* Apply correction to first section */
-    if (fabsf(total_gain) > 1e-12f && f->n_sections > 0) {
-        float correction = 1.0f / total_gain;
-        f->sections[0].b[0] *= correction;
-        f->sections[0].b[1] *= correction;
-        f->sections[0].b[2] *= correction;
+    if (fabs(total_gain) > 1e-12 && f->n_sections > 0) {
+        double correction = 1.0 / total_gain;
+        f->dsections[0].b[0] *= correction;
+        f->dsections[0].b[1] *= correction;
+        f->dsections[0].b[2] *= correction;
     }
+    sections_to_float(f);
 }
 
 /* ------------------------------------------------------------------ */
 /* Bandpass design (lowpass-to-bandpass transform)                     */
 /* ------------------------------------------------------------------ */
 
+/* BP zeros at z=+1 (DC) and z=-1 (Nyquist): numerator z^2 - 1 */
+static void make_sos_bandpass(double pz_re, double pz_im, iir_section_d_t *sec)
+{
+    sec->b[0] = 1.0;
+    sec->b[1] = 0.0;
+    sec->b[2] = -1.0;
+    sec->a[0] = 1.0;
+    sec->a[1] = -2.0 * pz_re;
+    sec->a[2] = pz_re * pz_re + pz_im * pz_im;
+    sec->z[0] = 0.0;
+    sec->z[1] = 0.0;
+}
+
 void iir_design_bandpass(iir_filter_t *f, int order,
                          float low_hz, float high_hz, float fs)
 {
@@ -170,21 +200,21 @@ void iir_design_bandpass(iir_filter_t *f, int order,
     if (order < 1) return;
 
     /* Normalize to [0, 1] where 1 = Nyquist */
-    float nyquist = fs / 2.0f;
-    float wn_low  = low_hz / nyquist;
-    float wn_high = high_hz / nyquist;
-    if (wn_low <= 0.0f)  wn_low = 0.001f;
-    if (wn_high >= 1.0f) wn_high = 0.999f;
+    double nyquist = (double)fs / 2.0;
+    double wn_low  = low_hz / nyquist;
+    double wn_high = high_hz / nyquist;
+    if (wn_low <= 0.0)  wn_low = 0.001;
+    if (wn_high >= 1.0) wn_high = 0.999;
     if (wn_low >= wn_high) return;
 
     /* Pre-warp */
-    float w_low  = 2.0f * fs * tanf((float)M_PI * wn_low / 2.0f);
-    float w_high = 2.0f * fs * tanf((float)M_PI * wn_high / 2.0f);
-    float bw = w_high - w_low;
-    float w0 = sqrtf(w_low * w_high);
+    double w_low  = 2.0 * fs * tan(M_PI * wn_low / 2.0);
+    double w_high = 2.0 * fs * tan(M_PI * wn_high / 2.0);
+    double bw = w_high - w_low;
+    double w0 = sqrt(w_low * w_high);
 
     /* Analog prototype poles */
-    float ap_re[16], ap_im[16];
+    double ap_re[16], ap_im[16];
     butter_analog_poles(order, ap_re, ap_im);
 
     /* Lowpass-to-bandpass: each LP pole p becomes two BP poles:
@@ -192,126 +222,179 @@ void iir_design_bandpass(iir_filter_t *f, int order,
      */
     int sec_idx = 0;
     for (int k = 0; k < order; k++) {
-        float half_bw_re = ap_re[k] * bw / 2.0f;
-        float half_bw_im = ap_im[k] * bw / 2.0f;
+        double half_bw_re = ap_re[k] * bw / 2.0;
+        double half_bw_im = ap_im[k] * bw / 2.0;
 
         /* (p*bw/2)^2 */
-        float sq_re = half_bw_re * half_bw_re - half_bw_im * half_bw_im;
-        float sq_im = 2.0f * half_bw_re * half_bw_im;
+        double sq_re = half_bw_re * half_bw_re - half_bw_im * half_bw_im;
+        double sq_im = 2.0 * half_bw_re * half_bw_im;
 
         /* (p*bw/2)^2 - w0^2 */
         sq_re -= w0 * w0;
 
         /* Complex sqrt */
-        float mag = sqrtf(sq_re * sq_re + sq_im * sq_im);
-        float phase = atan2f(sq_im, sq_re);
-        float sqrt_mag = sqrtf(mag);
-        float sqrt_re = sqrt_mag * cosf(phase / 2.0f);
-        float sqrt_im = sqrt_mag * sinf(phase / 2.0f);
+        double mag = sqrt(sq_re * sq_re + sq_im * sq_im);
+        double phase = atan2(sq_im, sq_re);
+        double sqrt_mag = sqrt(mag);
+        double sqrt_re = sqrt_mag * cos(phase / 2.0);
+        double sqrt_im = sqrt_mag * sin(phase / 2.0);
 
         /* Two analog poles from LP→BP transform */
-        float s1_re = half_bw_re + sqrt_re;
-        float s1_im = half_bw_im + sqrt_im;
-        float s2_re = half_bw_re - sqrt_re;
-        float s2_im = half_bw_im - sqrt_im;
+        double s1_re = half_bw_re + sqrt_re;
+        double s1_im = half_bw_im + sqrt_im;
+        double s2_re = half_bw_re - sqrt_re;
+        double s2_im = half_bw_im - sqrt_im;
 
         /* Bilinear transform each to z-plane */
-        float z1_re, z1_im, z2_re, z2_im;
+        double z1_re, z1_im, z2_re, z2_im;
         bilinear_transform(s1_re, s1_im, fs, &z1_re, &z1_im);
         bilinear_transform(s2_re, s2_im, fs, &z2_re, &z2_im);
 
-        /* Build SOS section for each z-plane pole
-         * BP zeros: at z=+1 (DC) and z=-1 (Nyquist)
-         * So each SOS numerator is z^2 - 1 = (z-1)(z+1) */
+        /* One SOS section per z-plane pole */
         if (sec_idx < IIR_MAX_SECTIONS) {
-            iir_section_t *sec = &f->sections[sec_idx];
-            sec->b[0] = 1.0f;
-            sec->b[1] = 0.0f;
-            sec->b[2] = -1.0f;
-            sec->a[0] = 1.0f;
-            sec->a[1] = -2.0f * z1_re;
-            sec->a[2] = z1_re * z1_re + z1_im * z1_im;
-            sec->z[0] = 0.0f;
-            sec->z[1] = 0.0f;
-            sec_idx++;
+            make_sos_bandpass(z1_re, z1_im, &f->dsections[sec_idx++]);
         }
         if (sec_idx < IIR_MAX_SECTIONS) {
-            iir_section_t *sec = &f->sections[sec_idx];
-            sec->b[0] = 1.0f;
-            sec->b[1] = 0.0f;
-            sec->b[2] = -1.0f;
-            sec->a[0] = 1.0f;
-            sec->a[1] = -2.0f * z2_re;
-            sec->a[2] = z2_re * z2_re + z2_im * z2_im;
-            sec->z[0] = 0.0f;
-            sec->z[1] = 0.0f;
-            sec_idx++;
+            make_sos_bandpass(z2_re, z2_im, &f->dsections[sec_idx++]);
         }
     }
     f->n_sections = sec_idx;
 
     /* Normalize gain at center frequency */
-    float wc = 2.0f * (float)M_PI * (low_hz + high_hz) / 2.0f / fs;
-    float cos_wc = cosf(wc);
-    float sin_wc = sinf(wc);
-    float total_gain_re = 1.0f;
-    float total_gain_im = 0.0f;
+    double wc = 2.0 * M_PI * ((double)low_hz + high_hz) / 2.0 / fs;
+    double cos_wc = cos(wc);
+    double sin_wc = sin(wc);
+    double total_gain_re = 1.0;
+    double total_gain_im = 0.0;
 
     for (int s = 0; s < f->n_sections; s++) {
-        iir_section_t *sec = &f->sections[s];
+        iir_section_d_t *sec = &f->dsections[s];
         /* Evaluate H(e^jw) = (b0 + b1*e^-jw + b2*e^-2jw) / (1 + a1*e^-jw + a2*e^-2jw) */
-        float cos2 = cos_wc * cos_wc - sin_wc * sin_wc;
-        float sin2 = 2.0f * sin_wc * cos_wc;
+        double cos2 = cos_wc * cos_wc - sin_wc * sin_wc;
+        double sin2 = 2.0 * sin_wc * cos_wc;
 
-        float nr = sec->b[0] + sec->b[1] * cos_wc + sec->b[2] * cos2;
-        float ni = -sec->b[1] * sin_wc - sec->b[2] * sin2;
-        float dr = sec->a[0] + sec->a[1] * cos_wc + sec->a[2] * cos2;
-        float di = -sec->a[1] * sin_wc - sec->a[2] * sin2;
+        double nr = sec->b[0] + sec->b[1] * cos_wc + sec->b[2] * cos2;
+        double ni = -sec->b[1] * sin_wc - sec->b[2] * sin2;
+        double dr = sec->a[0] + sec->a[1] * cos_wc + sec->a[2] * cos2;
+        double di = -sec->a[1] * sin_wc - sec->a[2] * sin2;
 
-        float dm2 = dr * dr + di * di;
-        if (dm2 < 1e-20f) continue;
+        double dm2 = dr * dr + di * di;
+        if (dm2 < 1e-20) continue;
 
-        float h_re = (nr * dr + ni * di) / dm2;
-        float h_im = (ni * dr - nr * di) / dm2;
+        double h_re = (nr * dr + ni * di) / dm2;
+        double h_im = (ni * dr - nr * di) / dm2;
 
-        float new_re = total_gain_re * h_re - total_gain_im * h_im;
-        float new_im = total_gain_re * h_im + total_gain_im * h_re;
+        double new_re = total_gain_re * h_re - total_gain_im * h_im;
+        double new_im = total_gain_re * h_im + total_gain_im * h_re;
         total_gain_re = new_re;
         total_gain_im = new_im;
     }
 
-    float gain_mag = sqrtf(total_gain_re * total_gain_re +
+    double gain_mag = sqrt(total_gain_re * total_gain_re +
                            total_gain_im * total_gain_im);
-    if (gain_mag > 1e-12f && f->n_sections > 0) {
-        float correction = 1.0f / gain_mag;
-        f->sections[0].b[0] *= correction;
-        f->sections[0].b[1] *= correction;
-        f->sections[0].b[2] *= correction;
+    if (gain_mag > 1e-12 && f->n_sections > 0) {
+        double correction = 1.0 / gain_mag;
+        f->dsections[0].b[0] *= correction;
+        f->dsections[0].b[1] *= correction;
+        f->dsections[0].b[2] *= correction;
     }
+    sections_to_float(f);
 }
 
 /* ------------------------------------------------------------------ */
 /* Process: Direct Form II Transposed                                  */
 /* ------------------------------------------------------------------ */
 
-void iir_filter_process(iir_filter_t *f, float *data, int n)
+/* One DF-II Transposed step with explicit state */
+static inline float section_step(const iir_section_t *sec, float x,
+                                 float *z0, float *z1)
+{
+    float y = sec->b[0] * x + *z0;
+    *z0 = sec->b[1] * x - sec->a[1] * y + *z1;
+    *z1 = sec->b[2] * x - sec->a[2] * y;
+    return y;
+}
+
+/*
+ * Fused cascade over sec[0 .. count-1] (count <= 4): each sample passes
+ * through every section before the next is loaded, so the sections'
+ * recursions overlap instead of running back to back. Called with a
+ * constant count so the states stay in registers.
+ */
+static inline void cascade_fused(iir_section_t *sec, int count, float *data, int n)
+{
+    float z00 = sec[0].z[0], z01 = sec[0].z[1];
+    float z10 = 0.0f, z11 = 0.0f, z20 = 0.0f, z21 = 0.0f, z30 = 0.0f, z31 = 0.0f;
+    if (count > 1) { z10 = sec[1].z[0]; z11 = sec[1].z[1]; }
+    if (count > 2) { z20 = sec[2].z[0]; z21 = sec[2].z[1]; }
+    if (count > 3) { z30 = sec[3].z[0]; z31 = sec[3].z[1]; }
+
+    for (int i = 0; i < n; i++) {
+        float x = section_step(&sec[0], data[i], &z00, &z01);
+        if (count > 1) x = section_step(&sec[1], x, &z10, &z11);
+        if (count > 2) x = section_step(&sec[2], x, &z20, &z21);
+        if (count > 3) x = section_step(&sec[3], x, &z30, &z31);
+        data[i] = x;
+    }
+
+    sec[0].z[0] = z00; sec[0].z[1] = z01;
+    if (count > 1) { sec[1].z[0] = z10; sec[1].z[1] = z11; }
+    if (count > 2) { sec[2].z[0] = z20; sec[2].z[1] = z21; }
+    if (count > 3) { sec[3].z[0] = z30; sec[3].z[1] = z31; }
+}
+
+/* Double-precision cascade, fused the same way */
+static void cascade_double(iir_filter_t *f, float *data, int n)
+{
+    int ns = f->n_sections;
+
+    for (int i = 0; i < n; i++) {
+        double x = data[i];
+        for (int s = 0; s < ns; s++) {
+            iir_section_d_t *sec = &f->dsections[s];
+            double y = sec->b[0] * x + sec->z[0];
+            sec->z[0] = sec->b[1] * x - sec->a[1] * y + sec->z[1];
+            sec->z[1] = sec->b[2] * x - sec->a[2] * y;
+            x = y;
+        }
+        data[i] = (float)x;
+    }
+}
+
+void iir_filter_set_precision(iir_filter_t *f, iir_precision_t precision)
 {
+    if (precision == f->precision) return;
+
     for (int s = 0; s < f->n_sections; s++) {
         iir_section_t *sec = &f->sections[s];
-        float b0 = sec->b[0], b1 = sec->b[1], b2 = sec->b[2];
-        float a1 = sec->a[1], a2 = sec->a[2];
-        float z0 = sec->z[0], z1 = sec->z[1];
-
-        for (int i = 0; i < n; i++) {
-            float x = data[i];
-            float y = b0 * x + z0;
-            z0 = b1 * x - a1 * y + z1;
-            z1 = b2 * x - a2 * y;
-            data[i] = y;
+        iir_section_d_t *d = &f->dsections[s];
+        if (precision == IIR_PRECISION_DOUBLE) {
+            d->z[0] = sec->z[0];
+            d->z[1] = sec->z[1];
+        } else {
+            sec->z[0] = (float)d->z[0];
+            sec->z[1] = (float)d->z[1];
         }
+    }
+    f->precision = precision;
+}
+
+void iir_filter_process(iir_filter_t *f, float *data, int n)
+{
+    if (f->precision == IIR_PRECISION_DOUBLE) {
+        cascade_double(f, data, n);
+        return;
+    }
 
-        sec->z[0] = z0;
-        sec->z[1] = z1;
+    /* Up to 4 sections per pass over the data */
+    for (int s = 0; s < f->n_sections; s += 4) {
+        iir_section_t *sec = &f->sections[s];
+        switch (f->n_sections - s) {
+        case 1:  cascade_fused(sec, 1, data, n); break;
+        case 2:  cascade_fused(sec, 2, data, n); break;
+        case 3:  cascade_fused(sec, 3, data, n); break;
+        default: cascade_fused(sec, 4, data, n); break;
+        }
     }
 }
 
@@ -320,5 +403,184 @@ void iir_filter_reset(iir_filter_t *f)
     for (int s = 0; s < f->n_sections; s++) {
         f->sections[s].z[0] = 0.0f;
         f->sections[s].z[1] = 0.0f;
+        f->dsections[s].z[0] = 0.0;
+        f->dsections[s].z[1] = 0.0;
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Multi-channel lane bank                                             */
+/* ------------------------------------------------------------------ */
+
+static void lane_section_passthrough(iir_lane_section_t *ls, int lane)
+{
+    ls->b0[lane] = 1.0f;
+    ls->b1[lane] = 0.0f;
+    ls->b2[lane] = 0.0f;
+    ls->a1[lane] = 0.0f;
+    ls->a2[lane] = 0.0f;
+    ls->z0[lane] = 0.0f;
+    ls->z1[lane] = 0.0f;
+}
+
+void iir_lanes_init(iir_lanes_t *fl, int width)
+{
+    memset(fl, 0, sizeof(*fl));
+    if (width < 1) width = 1;
+    if (width > IIR_MAX_LANES) width = IIR_MAX_LANES;
+    fl->width = width;
+
+    for (int s = 0; s < IIR_MAX_SECTIONS; s++) {
+        for (int l = 0; l < IIR_MAX_LANES; l++) {
+            lane_section_passthrough(&fl->sections[s], l);
+        }
+    }
+}
+
+void iir_lanes_set(iir_lanes_t *fl, int lane, const iir_filter_t *f)
+{
+    if (lane < 0 || lane >= fl->width) return;
+
+    for (int s = 0; s < IIR_MAX_SECTIONS; s++) {
+        iir_lane_section_t *ls = &fl->sections[s];
+        if (s < f->n_sections) {
+            const iir_section_t *sec = &f->sections[s];
+            ls->b0[lane] = sec->b[0];
+            ls->b1[lane] = sec->b[1];
+            ls->b2[lane] = sec->b[2];
+            ls->a1[lane] = sec->a[1];
+            ls->a2[lane] = sec->a[2];
+            ls->z0[lane] = sec->z[0];
+            ls->z1[lane] = sec->z[1];
+        } else {
+            lane_section_passthrough(ls, lane);
+        }
+    }
+    if (f->n_sections > fl->n_sections) fl->n_sections = f->n_sections;
+}
+
+void iir_lanes_process_scalar(iir_lanes_t *fl, float *data, int n)
+{
+    int w = fl->width;
+
+    for (int s = 0; s < fl->n_sections; s++) {
+        iir_lane_section_t *ls = &fl->sections[s];
+
+        for (int l = 0; l < w; l++) {
+            float b0 = ls->b0[l], b1 = ls->b1[l], b2 = ls->b2[l];
+            float a1 = ls->a1[l], a2 = ls->a2[l];
+            float z0 = ls->z0[l], z1 = ls->z1[l];
+
+            for (int i = 0; i < n; i++) {
+                float x = data[i * w + l];
+                float y = b0 * x + z0;
+                z0 = b1 * x - a1 * y + z1;
+                z1 = b2 * x - a2 * y;
+                data[i * w + l] = y;
+            }
+
+            ls->z0[l] = z0;
+            ls->z1[l] = z1;
+        }
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Single-channel block form (shared by SIMD cascade kernels)          */
+/* ------------------------------------------------------------------ */
+
+void iir_block_init(iir_block_t *bk, const iir_section_t *sec, int len)
+{
+    memset(bk, 0, sizeof(*bk));
+    if (len > IIR_MAX_LANES) len = IIR_MAX_LANES;
+
+    float z0 = 0.0f, z1 = 0.0f;
+    for (int i = 0; i < len; i++) {
+        bk->h[IIR_MAX_LANES + i] = section_step(sec, i == 0 ? 1.0f : 0.0f, &z0, &z1);
+    }
+
+    z0 = 1.0f; z1 = 0.0f;
+    for (int i = 0; i < len; i++) bk->o0[i] = section_step(sec, 0.0f, &z0, &z1);
+
+    z0 = 0.0f; z1 = 1.0f;
+    for (int i = 0; i < len; i++) bk->o1[i] = section_step(sec, 0.0f, &z0, &z1);
+}
+
+/* ------------------------------------------------------------------ */
+/* Single-channel wavefront helpers (shared by SIMD cascade kernels)   */
+/* ------------------------------------------------------------------ */
+
+void iir_wave_load(iir_wave_t *w, const iir_filter_t *f, int s0, int width)
+{
+    memset(w, 0, sizeof(*w));
+    if (width > IIR_MAX_LANES) width = IIR_MAX_LANES;
+    w->s0 = s0;
+    w->width = width;
+
+    for (int l = 0; l < width; l++) {
+        int s = s0 + l;
+        if (s < f->n_sections) {
+            const iir_section_t *sec = &f->sections[s];
+            w->b0[l] = sec->b[0];
+            w->b1[l] = sec->b[1];
+            w->b2[l] = sec->b[2];
+            w->a1[l] = sec->a[1];
+            w->a2[l] = sec->a[2];
+            w->z0[l] = sec->z[0];
+            w->z1[l] = sec->z[1];
+        } else {
+            w->b0[l] = 1.0f;   /* Pass-through: y = x exactly */
+        }
+    }
+}
+
+void iir_wave_store(const iir_wave_t *w, iir_filter_t *f)
+{
+    for (int l = 0; l < w->width; l++) {
+        int s = w->s0 + l;
+        if (s < f->n_sections) {
+            f->sections[s].z[0] = w->z0[l];
+            f->sections[s].z[1] = w->z1[l];
+        }
+    }
+}
+
+void iir_wave_steps(iir_wave_t *w, float *data, int n, int t_begin, int t_end)
+{
+    int last = w->width - 1;
+
+    for (int t = t_begin; t < t_end; t++) {
+        /* Descending: lane s consumes lane s-1's output from step t-1 */
+        for (int l = last; l >= 0; l--) {
+            int i = t - l;
+            if (i < 0 || i >= n) continue;
+
+            float x = (l == 0) ? data[t] : w->y[l - 1];
+            float y = w->b0[l] * x + w->z0[l];
+            w->z0[l] = w->b1[l] * x - w->a1[l] * y + w->z1[l];
+            w->z1[l] = w->b2[l] * x - w->a2[l] * y;
+            w->y[l] = y;
+            if (l == last) data[i] = y;
+        }
+    }
+}
+
+void iir_lanes_process(iir_lanes_t *fl, float *data, int n)
+{
+    if (n <= 0 || fl->n_sections == 0) return;
+
+    const cw_kernels_t *k = cw_get_kernels();
+    if (fl->width == k->lane_width) {
+        k->lanes_biquad(fl, data, n);
+    } else {
+        iir_lanes_process_scalar(fl, data, n);
+    }
+}
+
+void iir_lanes_reset(iir_lanes_t *fl)
+{
+    for (int s = 0; s < IIR_MAX_SECTIONS; s++) {
+        memset(fl->sections[s].z0, 0, sizeof(fl->sections[s].z0));
+        memset(fl->sections[s].z1, 0, sizeof(fl->sections[s].z1));
     }
 }
@@ -3,6 +3,10 @@
  *
  * Designs Butterworth filters using analog prototype → bilinear transform → SOS.
  * Processes audio via Direct Form II Transposed (numerically stable).
+ *
+ * Design runs in double precision. Sections normally run in float; narrow
+ * filters whose poles sit close to the unit circle (e.g. 100 Hz wide at
+ * 48 kHz) can run in double instead, see iir_filter_set_precision().
  */
 
 #ifndef IIR_FILTER_H
@@ -18,10 +22,26 @@ typedef struct {
     float z[2];   /* State variables (DF-II Transposed) */
 } iir_section_t;
 
+/* Same section at design precision */
+typedef struct {
+    double b[3];
+    double a[3];
+    double z[2];
+} iir_section_d_t;
+
+/* Section arithmetic */
+typedef enum {
+    IIR_PRECISION_FLOAT  = 0,   /* float coefficients + state (SIMD kernels, default) */
+    IIR_PRECISION_DOUBLE = 1,   /* double coefficients + state (scalar) */
+} iir_precision_t;
+
 /* IIR filter (cascade of biquad sections) */
 typedef struct {
     iir_section_t sections[IIR_MAX_SECTIONS];
     int n_sections;
+
+    iir_precision_t precision;
+    iir_section_d_t dsections[IIR_MAX_SECTIONS];   /* Used when precision is double */
 } iir_filter_t;
 
 /**
@@ -46,6 +66,14 @@ void iir_design_lowpass(iir_filter_t *f, int order, float cutoff_hz, float fs);
 void iir_design_bandpass(iir_filter_t *f, int order,
                          float low_hz, float high_hz, float fs);
 
+/**
+ * Select the section arithmetic (designs start out IIR_PRECISION_FLOAT).
+ * Double keeps the unrounded design coefficients and a double state, so
+ * rounding noise no longer builds up in high-Q sections. State carries
+ * over, so this may be called mid-stream.
+ */
+void iir_filter_set_precision(iir_filter_t *f, iir_precision_t precision);
+
 /**
  * Process audio samples in-place through the filter.
  *
@@ -60,4 +88,139 @@ void iir_filter_process(iir_filter_t *f, float *data, int n);
  */
 void iir_filter_reset(iir_filter_t *f);
 
+/* ------------------------------------------------------------------ */
+/* Multi-channel (struct-of-arrays) biquad cascade                     */
+/* ------------------------------------------------------------------ */
+
+/* Maximum SIMD lanes (AVX2: 8 floats, SSE2/NEON: 4 floats) */
+#define IIR_MAX_LANES 8
+
+/* One biquad section replicated across lanes: coef[lane] */
+typedef struct {
+    float b0[IIR_MAX_LANES], b1[IIR_MAX_LANES], b2[IIR_MAX_LANES];
+    float a1[IIR_MAX_LANES], a2[IIR_MAX_LANES];
+    float z0[IIR_MAX_LANES], z1[IIR_MAX_LANES];
+} iir_lane_section_t;
+
+/*
+ * N channels with independent coefficients, processed lane-parallel.
+ * Sample data is interleaved: data[i * width + lane].
+ * Lanes with fewer sections are padded with pass-through sections.
+ */
+typedef struct {
+    iir_lane_section_t sections[IIR_MAX_SECTIONS];
+    int n_sections;
+    int width;               /* Lane stride: 4 or 8 */
+} iir_lanes_t;
+
+/**
+ * Initialize an empty lane bank (all lanes pass-through).
+ *
+ * @param fl     Output lane bank
+ * @param width  Lane stride (4 or IIR_MAX_LANES)
+ */
+void iir_lanes_init(iir_lanes_t *fl, int width);
+
+/**
+ * Load a designed filter into one lane (float coefficients and state).
+ */
+void iir_lanes_set(iir_lanes_t *fl, int lane, const iir_filter_t *f);
+
+/**
+ * Process interleaved samples in-place through all lanes.
+ *
+ * @param fl    Lane bank (state is updated)
+ * @param data  Interleaved samples, n * width floats
+ * @param n     Number of samples per lane
+ */
+void iir_lanes_process(iir_lanes_t *fl, float *data, int n);
+
+/**
+ * Reset all lane states to zero (keep coefficients).
+ */
+void iir_lanes_reset(iir_lanes_t *fl);
+
+/* ------------------------------------------------------------------ */
+/* Per-ISA kernels (selected via cw_get_kernels())                     */
+/* ------------------------------------------------------------------ */
+
+/*
+ * Single-channel cascade kernels pick one of two layouts by section count.
+ *
+ * Three or more sections run as a wavefront: lane s holds section s and
+ * works one sample behind lane s-1, so a 4-section bandpass advances one
+ * full sample per vector step (bit-identical to iir_filter_process()).
+ *
+ * One or two sections would leave most wavefront lanes idle, so they use
+ * the state-space block form instead: per section, a block of L = vector
+ * width outputs is
+ *
+ *   y[0..L-1] = H · x[0..L-1] + o0 · z0 + o1 · z1
+ *
+ * with H the lower-triangular Toeplitz matrix of the impulse response and
+ * o0/o1 the zero-input responses to the two state variables. The state
+ * after the block follows from the last two inputs/outputs by the usual
+ * DF-II Transposed update, so the recursion runs once per block instead
+ * of once per sample. Rounding differs from iir_filter_process() in the
+ * last bits.
+ */
+void iir_lanes_process_scalar(iir_lanes_t *fl, float *data, int n);
+
+/* Block form of one section for L <= IIR_MAX_LANES */
+typedef struct {
+    /*
+     * Impulse response behind IIR_MAX_LANES zeros: column j of H is the
+     * L floats at h + IIR_MAX_LANES - j.
+     */
+    float h[2 * IIR_MAX_LANES];
+    float o0[IIR_MAX_LANES];   /* Response to z0 = 1, zero input */
+    float o1[IIR_MAX_LANES];   /* Response to z1 = 1, zero input */
+} iir_block_t;
+
+/** Derive the L-sample block form of a section. */
+void iir_block_init(iir_block_t *bk, const iir_section_t *sec, int len);
+
+/* Wavefront state: lanes s0 .. s0+width-1 of a single-channel cascade */
+typedef struct {
+    int   s0, width;
+    float b0[IIR_MAX_LANES], b1[IIR_MAX_LANES], b2[IIR_MAX_LANES];
+    float a1[IIR_MAX_LANES], a2[IIR_MAX_LANES];
+    float z0[IIR_MAX_LANES], z1[IIR_MAX_LANES];
+    float y[IIR_MAX_LANES];   /* Last output per lane (feeds lane + 1) */
+} iir_wave_t;
+
+/** Load sections s0.. of f into lanes (missing sections pass through). */
+void iir_wave_load(iir_wave_t *w, const iir_filter_t *f, int s0, int width);
+
+/** Write lane states back into f. */
+void iir_wave_store(const iir_wave_t *w, iir_filter_t *f);
+
+/**
+ * Masked scalar wavefront steps t_begin .. t_end-1 (ramp-up / drain).
+ * Lane s at step t handles sample t - s; last lane writes data[t - width + 1].
+ */
+void iir_wave_steps(iir_wave_t *w, float *data, int n, int t_begin, int t_end);
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+void iir_filter_process_neon(iir_filter_t *f, float *data, int n);
+void iir_lanes_process_neon(iir_lanes_t *fl, float *data, int n);
+
+/**
+ * Process N channels (up to 4) through the same IIR filter in parallel.
+ *
+ * @param data    Planar channel pointers
+ * @param states  Per-channel section state, states[(s * n_ch + ch) * 2 + k]
+ */
+void iir_filter_process_multi_neon(const iir_filter_t *f,
+                                    float **data, int n_ch, int n_samples,
+                                    float *states);
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+void iir_filter_process_sse2(iir_filter_t *f, float *data, int n);
+void iir_filter_process_avx2(iir_filter_t *f, float *data, int n);
+void iir_lanes_process_sse2(iir_lanes_t *fl, float *data, int n);
+void iir_lanes_process_avx2(iir_lanes_t *fl, float *data, int n);
+#endif
+
 #endif /* IIR_FILTER_H */
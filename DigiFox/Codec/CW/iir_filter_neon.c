@@ -1,8 +1,11 @@
 /**
- * iir_filter_neon.c — NEON multi-channel IIR filter
+ * iir_filter_neon.c — NEON IIR filter kernels
  *
- * Processes up to 4 channels in parallel using 128-bit NEON registers.
- * Each lane = one channel, same biquad coefficients across all channels.
+ * Single-channel: biquad cascade as a 4-section wavefront, or in
+ * state-space block form (4 samples per block) for one or two sections.
+ * Multi-channel: processes 4 channels in parallel using 128-bit NEON
+ * registers, sections fused in pairs. Each lane = one channel;
+ * coefficients may differ per lane.
  *
  * Only compiled on AArch64 (NEON always available).
  */
@@ -12,8 +15,194 @@
 #include "iir_filter.h"
 #include <arm_neon.h>
 
+/* One section's block form, broadcast where the update needs it */
+typedef struct {
+    float32x4_t h[4];          /* Columns of H */
+    float32x4_t o0, o1;
+    float32x4_t b1, b2, a1, a2;
+} block4_t;
+
+static void block4_load(block4_t *k, const iir_section_t *sec)
+{
+    iir_block_t b;
+    iir_block_init(&b, sec, 4);
+    for (int j = 0; j < 4; j++) k->h[j] = vld1q_f32(b.h + IIR_MAX_LANES - j);
+    k->o0 = vld1q_f32(b.o0);
+    k->o1 = vld1q_f32(b.o1);
+    k->b1 = vdupq_n_f32(sec->b[1]);
+    k->b2 = vdupq_n_f32(sec->b[2]);
+    k->a1 = vdupq_n_f32(sec->a[1]);
+    k->a2 = vdupq_n_f32(sec->a[2]);
+}
+
+/* 4 outputs of one section; z0/z1 hold the state broadcast to all lanes */
+static inline float32x4_t block4_step(const block4_t *k, float32x4_t x,
+                                      float32x4_t *z0, float32x4_t *z1)
+{
+    float32x4_t y = vmulq_laneq_f32(k->h[0], x, 0);
+    y = vfmaq_laneq_f32(y, k->h[1], x, 1);
+    y = vfmaq_laneq_f32(y, k->h[2], x, 2);
+    y = vfmaq_laneq_f32(y, k->h[3], x, 3);
+    y = vfmaq_f32(y, k->o0, *z0);
+    y = vfmaq_f32(y, k->o1, *z1);
+
+    /* State after the block: DF-II T update over the last two samples */
+    float32x4_t z1_2 = vfmsq_laneq_f32(vmulq_laneq_f32(k->b2, x, 2), k->a2, y, 2);
+    *z0 = vaddq_f32(vfmsq_laneq_f32(vmulq_laneq_f32(k->b1, x, 3), k->a1, y, 3), z1_2);
+    *z1 = vfmsq_laneq_f32(vmulq_laneq_f32(k->b2, x, 3), k->a2, y, 3);
+    return y;
+}
+
+/* Called with a constant count (1 or 2) so state stays in registers */
+static inline void block4_run(iir_filter_t *f, int count, float *data, int nb)
+{
+    block4_t k0, k1;
+    float32x4_t z00 = vdupq_n_f32(f->sections[0].z[0]);
+    float32x4_t z01 = vdupq_n_f32(f->sections[0].z[1]);
+    float32x4_t z10 = vdupq_n_f32(0.0f), z11 = vdupq_n_f32(0.0f);
+    block4_load(&k0, &f->sections[0]);
+    if (count > 1) {
+        block4_load(&k1, &f->sections[1]);
+        z10 = vdupq_n_f32(f->sections[1].z[0]);
+        z11 = vdupq_n_f32(f->sections[1].z[1]);
+    }
+
+    for (int i = 0; i < nb; i += 4) {
+        float32x4_t x = block4_step(&k0, vld1q_f32(data + i), &z00, &z01);
+        if (count > 1) x = block4_step(&k1, x, &z10, &z11);
+        vst1q_f32(data + i, x);
+    }
+
+    f->sections[0].z[0] = vgetq_lane_f32(z00, 0);
+    f->sections[0].z[1] = vgetq_lane_f32(z01, 0);
+    if (count > 1) {
+        f->sections[1].z[0] = vgetq_lane_f32(z10, 0);
+        f->sections[1].z[1] = vgetq_lane_f32(z11, 0);
+    }
+}
+
+static void cascade_block4(iir_filter_t *f, float *data, int n)
+{
+    int nb = n & ~3;
+    if (f->n_sections == 1) block4_run(f, 1, data, nb);
+    else                    block4_run(f, 2, data, nb);
+    if (nb < n) iir_filter_process(f, data + nb, n - nb);
+}
+
+/**
+ * Single-channel cascade: block form for one or two sections, otherwise
+ * lane s = section s, one sample behind lane s-1.
+ */
+void iir_filter_process_neon(iir_filter_t *f, float *data, int n)
+{
+    if (n < 8 || f->n_sections == 0 || f->precision != IIR_PRECISION_FLOAT) {
+        iir_filter_process(f, data, n);
+        return;
+    }
+    if (f->n_sections <= 2) {
+        cascade_block4(f, data, n);
+        return;
+    }
+
+    for (int s0 = 0; s0 < f->n_sections; s0 += 4) {
+        iir_wave_t w;
+        iir_wave_load(&w, f, s0, 4);
+
+        /* Ramp-up: lanes enter one step apart */
+        iir_wave_steps(&w, data, n, 0, 3);
+
+        float32x4_t vb0 = vld1q_f32(w.b0);
+        float32x4_t vb1 = vld1q_f32(w.b1);
+        float32x4_t vb2 = vld1q_f32(w.b2);
+        float32x4_t va1 = vld1q_f32(w.a1);
+        float32x4_t va2 = vld1q_f32(w.a2);
+        float32x4_t vz0 = vld1q_f32(w.z0);
+        float32x4_t vz1 = vld1q_f32(w.z1);
+        float32x4_t vy  = vld1q_f32(w.y);
+
+        for (int t = 3; t < n; t++) {
+            /* x = [data[t], y0, y1, y2] — each section feeds the next */
+            float32x4_t vx = vextq_f32(vdupq_n_f32(data[t]), vy, 3);
+            vy  = vfmaq_f32(vz0, vb0, vx);
+            vz0 = vfmsq_f32(vfmaq_f32(vz1, vb1, vx), va1, vy);
+            vz1 = vfmsq_f32(vmulq_f32(vb2, vx), va2, vy);
+            data[t - 3] = vgetq_lane_f32(vy, 3);
+        }
+
+        vst1q_f32(w.z0, vz0);
+        vst1q_f32(w.z1, vz1);
+        vst1q_f32(w.y, vy);
+
+        /* Drain: later sections finish the last samples */
+        iir_wave_steps(&w, data, n, n, n + 3);
+        iir_wave_store(&w, f);
+    }
+}
+
+/* One DF-II Transposed step on 4 lanes */
+static inline float32x4_t lane_step(float32x4_t vx,
+                                    float32x4_t vb0, float32x4_t vb1, float32x4_t vb2,
+                                    float32x4_t va1, float32x4_t va2,
+                                    float32x4_t *vz0, float32x4_t *vz1)
+{
+    /* y = b0*x + z0 */
+    float32x4_t vy = vfmaq_f32(*vz0, vb0, vx);
+
+    /* z0 = b1*x - a1*y + z1 */
+    *vz0 = vfmsq_f32(vfmaq_f32(*vz1, vb1, vx), va1, vy);
+
+    /* z1 = b2*x - a2*y */
+    *vz1 = vfmsq_f32(vmulq_f32(vb2, vx), va2, vy);
+    return vy;
+}
+
+/**
+ * Process 4 interleaved lanes (data[i * 4 + lane]) through the lane bank.
+ * Sections run in fused pairs: one pass over data per two sections.
+ */
+void iir_lanes_process_neon(iir_lanes_t *fl, float *data, int n)
+{
+    for (int s = 0; s < fl->n_sections; s += 2) {
+        iir_lane_section_t *la = &fl->sections[s];
+        int pair = (s + 1 < fl->n_sections);
+
+        float32x4_t ab0 = vld1q_f32(la->b0), ab1 = vld1q_f32(la->b1);
+        float32x4_t ab2 = vld1q_f32(la->b2);
+        float32x4_t aa1 = vld1q_f32(la->a1), aa2 = vld1q_f32(la->a2);
+        float32x4_t az0 = vld1q_f32(la->z0), az1 = vld1q_f32(la->z1);
+
+        if (!pair) {
+            float *p = data;
+            for (int i = 0; i < n; i++, p += 4) {
+                vst1q_f32(p, lane_step(vld1q_f32(p), ab0, ab1, ab2, aa1, aa2, &az0, &az1));
+            }
+            vst1q_f32(la->z0, az0);
+            vst1q_f32(la->z1, az1);
+            break;
+        }
+
+        iir_lane_section_t *lb = la + 1;
+        float32x4_t bb0 = vld1q_f32(lb->b0), bb1 = vld1q_f32(lb->b1);
+        float32x4_t bb2 = vld1q_f32(lb->b2);
+        float32x4_t ba1 = vld1q_f32(lb->a1), ba2 = vld1q_f32(lb->a2);
+        float32x4_t bz0 = vld1q_f32(lb->z0), bz1 = vld1q_f32(lb->z1);
+
+        float *p = data;
+        for (int i = 0; i < n; i++, p += 4) {
+            float32x4_t vy = lane_step(vld1q_f32(p), ab0, ab1, ab2, aa1, aa2, &az0, &az1);
+            vst1q_f32(p, lane_step(vy, bb0, bb1, bb2, ba1, ba2, &bz0, &bz1));
+        }
+
+        vst1q_f32(la->z0, az0);
+        vst1q_f32(la->z1, az1);
+        vst1q_f32(lb->z0, bz0);
+        vst1q_f32(lb->z1, bz1);
+    }
+}
+
 /**
  * Process N channels (up to 4) through the same IIR filter in parallel.
+ * Planar input is interleaved in blocks and run through the lane kernel.
  */
 void iir_filter_process_multi_neon(const iir_filter_t *f,
                                     float **data, int n_ch, int n_samples,
@@ -21,57 +210,47 @@ void iir_filter_process_multi_neon(const iir_filter_t *f,
 {
     if (n_ch <= 0 || n_ch > 4) return;
 
-    for (int s = 0; s < f->n_sections; s++) {
-        const iir_section_t *sec = &f->sections[s];
-
-        float32x4_t vb0 = vdupq_n_f32(sec->b[0]);
-        float32x4_t vb1 = vdupq_n_f32(sec->b[1]);
-        float32x4_t vb2 = vdupq_n_f32(sec->b[2]);
-        float32x4_t va1 = vdupq_n_f32(sec->a[1]);
-        float32x4_t va2 = vdupq_n_f32(sec->a[2]);
+    iir_lanes_t fl;
+    iir_lanes_init(&fl, 4);
+    for (int ch = 0; ch < n_ch; ch++) {
+        iir_lanes_set(&fl, ch, f);
+    }
 
-        /* Load per-channel states */
-        float z0_arr[4] = {0}, z1_arr[4] = {0};
+    /* Load per-channel states */
+    for (int s = 0; s < f->n_sections; s++) {
         for (int ch = 0; ch < n_ch; ch++) {
-            z0_arr[ch] = states[(s * n_ch + ch) * 2 + 0];
-            z1_arr[ch] = states[(s * n_ch + ch) * 2 + 1];
+            fl.sections[s].z0[ch] = states[(s * n_ch + ch) * 2 + 0];
+            fl.sections[s].z1[ch] = states[(s * n_ch + ch) * 2 + 1];
         }
-        float32x4_t vz0 = vld1q_f32(z0_arr);
-        float32x4_t vz1 = vld1q_f32(z1_arr);
-
-        for (int i = 0; i < n_samples; i++) {
-            /* Gather input */
-            float x_arr[4] = {0};
-            for (int ch = 0; ch < n_ch; ch++) {
-                x_arr[ch] = data[ch][i];
-            }
-            float32x4_t vx = vld1q_f32(x_arr);
+    }
 
-            /* y = b0*x + z0 */
-            float32x4_t vy = vfmaq_f32(vz0, vb0, vx);
+    float block[256 * 4];
+    for (int off = 0; off < n_samples; off += 256) {
+        int len = n_samples - off;
+        if (len > 256) len = 256;
 
-            /* z0 = b1*x - a1*y + z1 */
-            vz0 = vfmaq_f32(vz1, vb1, vx);
-            vz0 = vfmsq_f32(vz0, va1, vy);
+        /* Gather input */
+        for (int i = 0; i < len; i++) {
+            for (int ch = 0; ch < 4; ch++) {
+                block[i * 4 + ch] = (ch < n_ch) ? data[ch][off + i] : 0.0f;
+            }
+        }
 
-            /* z1 = b2*x - a2*y */
-            vz1 = vmulq_f32(vb2, vx);
-            vz1 = vfmsq_f32(vz1, va2, vy);
+        iir_lanes_process_neon(&fl, block, len);
 
-            /* Scatter output */
-            float y_arr[4];
-            vst1q_f32(y_arr, vy);
+        /* Scatter output */
+        for (int i = 0; i < len; i++) {
             for (int ch = 0; ch < n_ch; ch++) {
-                data[ch][i] = y_arr[ch];
+                data[ch][off + i] = block[i * 4 + ch];
             }
         }
+    }
 
-        /* Store states */
-        vst1q_f32(z0_arr, vz0);
-        vst1q_f32(z1_arr, vz1);
+    /* Store states */
+    for (int s = 0; s < f->n_sections; s++) {
         for (int ch = 0; ch < n_ch; ch++) {
-            states[(s * n_ch + ch) * 2 + 0] = z0_arr[ch];
-            states[(s * n_ch + ch) * 2 + 1] = z1_arr[ch];
+            states[(s * n_ch + ch) * 2 + 0] = fl.sections[s].z0[ch];
+            states[(s * n_ch + ch) * 2 + 1] = fl.sections[s].z1[ch];
         }
     }
 }
@@ -0,0 +1,417 @@
+/**
+ * iir_filter_x86.c — SSE2/AVX2 IIR filter kernels
+ *
+ * Single-channel: biquad cascade as a section wavefront (4 sections per
+ * SSE2 register, 8 per AVX2 register), or in state-space block form (4 or
+ * 8 samples per block) for one or two sections.
+ * Multi-channel: lane-parallel DF-II Transposed cascade, 4 channels per
+ * SSE2 register, 8 channels per AVX2 register, sections fused in pairs.
+ *
+ * Same arithmetic order as the scalar path (no FMA), so results match
+ * iir_filter_process() / iir_lanes_process_scalar() bit for bit, except
+ * for the block form (see iir_filter.h).
+ *
+ * Only compiled on x86; the AVX2 kernel is selected at runtime.
+ */
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+
+#include "iir_filter.h"
+#include <emmintrin.h>
+#include <immintrin.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CW_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CW_TARGET_AVX2
+#endif
+
+/* ------------------------------------------------------------------ */
+/* Single-channel cascade (state-space blocks, 1-2 sections)           */
+/* ------------------------------------------------------------------ */
+
+/* One section's block form, broadcast where the update needs it */
+typedef struct {
+    __m128 h[4];               /* Columns of H */
+    __m128 o0, o1;
+    __m128 b1, b2, a1, a2;
+} block4_t;
+
+static void block4_load(block4_t *k, const iir_section_t *sec)
+{
+    iir_block_t b;
+    iir_block_init(&b, sec, 4);
+    for (int j = 0; j < 4; j++) k->h[j] = _mm_loadu_ps(b.h + IIR_MAX_LANES - j);
+    k->o0 = _mm_loadu_ps(b.o0);
+    k->o1 = _mm_loadu_ps(b.o1);
+    k->b1 = _mm_set1_ps(sec->b[1]);
+    k->b2 = _mm_set1_ps(sec->b[2]);
+    k->a1 = _mm_set1_ps(sec->a[1]);
+    k->a2 = _mm_set1_ps(sec->a[2]);
+}
+
+/* 4 outputs of one section; z0/z1 hold the state broadcast to all lanes */
+static inline __m128 block4_step(const block4_t *k, __m128 x, __m128 *z0, __m128 *z1)
+{
+    __m128 x0 = _mm_shuffle_ps(x, x, _MM_SHUFFLE(0, 0, 0, 0));
+    __m128 x1 = _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1));
+    __m128 x2 = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 2, 2, 2));
+    __m128 x3 = _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3));
+
+    __m128 y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(k->h[0], x0), _mm_mul_ps(k->h[1], x1)),
+                          _mm_add_ps(_mm_mul_ps(k->h[2], x2), _mm_mul_ps(k->h[3], x3)));
+    y = _mm_add_ps(y, _mm_add_ps(_mm_mul_ps(k->o0, *z0), _mm_mul_ps(k->o1, *z1)));
+
+    /* State after the block: DF-II T update over the last two samples */
+    __m128 y2 = _mm_shuffle_ps(y, y, _MM_SHUFFLE(2, 2, 2, 2));
+    __m128 y3 = _mm_shuffle_ps(y, y, _MM_SHUFFLE(3, 3, 3, 3));
+    __m128 z1_2 = _mm_sub_ps(_mm_mul_ps(k->b2, x2), _mm_mul_ps(k->a2, y2));
+    *z0 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(k->b1, x3), _mm_mul_ps(k->a1, y3)), z1_2);
+    *z1 = _mm_sub_ps(_mm_mul_ps(k->b2, x3), _mm_mul_ps(k->a2, y3));
+    return y;
+}
+
+/* Called with a constant count (1 or 2) so state stays in registers */
+static inline void block4_run(iir_filter_t *f, int count, float *data, int nb)
+{
+    block4_t k0, k1;
+    __m128 z00 = _mm_set1_ps(f->sections[0].z[0]), z01 = _mm_set1_ps(f->sections[0].z[1]);
+    __m128 z10 = _mm_setzero_ps(), z11 = _mm_setzero_ps();
+    block4_load(&k0, &f->sections[0]);
+    if (count > 1) {
+        block4_load(&k1, &f->sections[1]);
+        z10 = _mm_set1_ps(f->sections[1].z[0]);
+        z11 = _mm_set1_ps(f->sections[1].z[1]);
+    }
+
+    for (int i = 0; i < nb; i += 4) {
+        __m128 x = block4_step(&k0, _mm_loadu_ps(data + i), &z00, &z01);
+        if (count > 1) x = block4_step(&k1, x, &z10, &z11);
+        _mm_storeu_ps(data + i, x);
+    }
+
+    f->sections[0].z[0] = _mm_cvtss_f32(z00);
+    f->sections[0].z[1] = _mm_cvtss_f32(z01);
+    if (count > 1) {
+        f->sections[1].z[0] = _mm_cvtss_f32(z10);
+        f->sections[1].z[1] = _mm_cvtss_f32(z11);
+    }
+}
+
+static void cascade_block4(iir_filter_t *f, float *data, int n)
+{
+    int nb = n & ~3;
+    if (f->n_sections == 1) block4_run(f, 1, data, nb);
+    else                    block4_run(f, 2, data, nb);
+    if (nb < n) iir_filter_process(f, data + nb, n - nb);
+}
+
+typedef struct {
+    __m256 h[8];
+    __m256 o0, o1;
+    __m256 b1, b2, a1, a2;
+} block8_t;
+
+CW_TARGET_AVX2
+static void block8_load(block8_t *k, const iir_section_t *sec)
+{
+    iir_block_t b;
+    iir_block_init(&b, sec, 8);
+    for (int j = 0; j < 8; j++) k->h[j] = _mm256_loadu_ps(b.h + IIR_MAX_LANES - j);
+    k->o0 = _mm256_loadu_ps(b.o0);
+    k->o1 = _mm256_loadu_ps(b.o1);
+    k->b1 = _mm256_set1_ps(sec->b[1]);
+    k->b2 = _mm256_set1_ps(sec->b[2]);
+    k->a1 = _mm256_set1_ps(sec->a[1]);
+    k->a2 = _mm256_set1_ps(sec->a[2]);
+}
+
+/*
+ * 8 outputs of one section, from x[0..7] to y[0..7] (may alias). Lanes are
+ * broadcast straight from memory: vbroadcastss is a load, so the shuffle
+ * port stays free.
+ */
+CW_TARGET_AVX2
+static inline void block8_step(const block8_t *k, const float *x, float *y,
+                               __m256 *z0, __m256 *z1)
+{
+    /* Two accumulators halve the dependent add chain */
+    __m256 acc0 = _mm256_mul_ps(k->h[0], _mm256_broadcast_ss(x + 0));
+    __m256 acc1 = _mm256_mul_ps(k->h[1], _mm256_broadcast_ss(x + 1));
+    for (int j = 2; j < 8; j += 2) {
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(k->h[j], _mm256_broadcast_ss(x + j)));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(k->h[j + 1], _mm256_broadcast_ss(x + j + 1)));
+    }
+    __m256 x6 = _mm256_broadcast_ss(x + 6);
+    __m256 x7 = _mm256_broadcast_ss(x + 7);
+    __m256 vy = _mm256_add_ps(_mm256_add_ps(acc0, acc1),
+                              _mm256_add_ps(_mm256_mul_ps(k->o0, *z0),
+                                            _mm256_mul_ps(k->o1, *z1)));
+    _mm256_storeu_ps(y, vy);
+
+    /* State after the block: DF-II T update over the last two samples */
+    __m256 y6 = _mm256_broadcast_ss(y + 6);
+    __m256 y7 = _mm256_broadcast_ss(y + 7);
+    __m256 z1_6 = _mm256_sub_ps(_mm256_mul_ps(k->b2, x6), _mm256_mul_ps(k->a2, y6));
+    *z0 = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(k->b1, x7),
+                                      _mm256_mul_ps(k->a1, y7)), z1_6);
+    *z1 = _mm256_sub_ps(_mm256_mul_ps(k->b2, x7), _mm256_mul_ps(k->a2, y7));
+}
+
+CW_TARGET_AVX2
+static inline void block8_run(iir_filter_t *f, int count, float *data, int nb)
+{
+    block8_t k0, k1;
+    float mid[8];
+    __m256 z00 = _mm256_set1_ps(f->sections[0].z[0]), z01 = _mm256_set1_ps(f->sections[0].z[1]);
+    __m256 z10 = _mm256_setzero_ps(), z11 = _mm256_setzero_ps();
+    block8_load(&k0, &f->sections[0]);
+    if (count > 1) {
+        block8_load(&k1, &f->sections[1]);
+        z10 = _mm256_set1_ps(f->sections[1].z[0]);
+        z11 = _mm256_set1_ps(f->sections[1].z[1]);
+    }
+
+    for (int i = 0; i < nb; i += 8) {
+        if (count > 1) {
+            block8_step(&k0, data + i, mid, &z00, &z01);
+            block8_step(&k1, mid, data + i, &z10, &z11);
+        } else {
+            block8_step(&k0, data + i, data + i, &z00, &z01);
+        }
+    }
+
+    f->sections[0].z[0] = _mm256_cvtss_f32(z00);
+    f->sections[0].z[1] = _mm256_cvtss_f32(z01);
+    if (count > 1) {
+        f->sections[1].z[0] = _mm256_cvtss_f32(z10);
+        f->sections[1].z[1] = _mm256_cvtss_f32(z11);
+    }
+}
+
+CW_TARGET_AVX2
+static void cascade_block8(iir_filter_t *f, float *data, int n)
+{
+    int nb = n & ~7;
+    if (f->n_sections == 1) block8_run(f, 1, data, nb);
+    else                    block8_run(f, 2, data, nb);
+    if (nb < n) iir_filter_process(f, data + nb, n - nb);
+}
+
+/* ------------------------------------------------------------------ */
+/* Single-channel cascade (section wavefront)                          */
+/* ------------------------------------------------------------------ */
+
+void iir_filter_process_sse2(iir_filter_t *f, float *data, int n)
+{
+    if (n < 8 || f->n_sections == 0 || f->precision != IIR_PRECISION_FLOAT) {
+        iir_filter_process(f, data, n);
+        return;
+    }
+    if (f->n_sections <= 2) {
+        cascade_block4(f, data, n);
+        return;
+    }
+
+    for (int s0 = 0; s0 < f->n_sections; s0 += 4) {
+        iir_wave_t w;
+        iir_wave_load(&w, f, s0, 4);
+
+        /* Ramp-up: lanes enter one step apart */
+        iir_wave_steps(&w, data, n, 0, 3);
+
+        __m128 vb0 = _mm_loadu_ps(w.b0);
+        __m128 vb1 = _mm_loadu_ps(w.b1);
+        __m128 vb2 = _mm_loadu_ps(w.b2);
+        __m128 va1 = _mm_loadu_ps(w.a1);
+        __m128 va2 = _mm_loadu_ps(w.a2);
+        __m128 vz0 = _mm_loadu_ps(w.z0);
+        __m128 vz1 = _mm_loadu_ps(w.z1);
+        __m128 vy  = _mm_loadu_ps(w.y);
+
+        for (int t = 3; t < n; t++) {
+            /* x = [data[t], y0, y1, y2] — each section feeds the next */
+            __m128 vx = _mm_move_ss(_mm_shuffle_ps(vy, vy, _MM_SHUFFLE(2, 1, 0, 0)),
+                                    _mm_set_ss(data[t]));
+            vy  = _mm_add_ps(_mm_mul_ps(vb0, vx), vz0);
+            vz0 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(vb1, vx), _mm_mul_ps(va1, vy)), vz1);
+            vz1 = _mm_sub_ps(_mm_mul_ps(vb2, vx), _mm_mul_ps(va2, vy));
+            data[t - 3] = _mm_cvtss_f32(_mm_shuffle_ps(vy, vy, _MM_SHUFFLE(3, 3, 3, 3)));
+        }
+
+        _mm_storeu_ps(w.z0, vz0);
+        _mm_storeu_ps(w.z1, vz1);
+        _mm_storeu_ps(w.y, vy);
+
+        /* Drain: later sections finish the last samples */
+        iir_wave_steps(&w, data, n, n, n + 3);
+        iir_wave_store(&w, f);
+    }
+}
+
+CW_TARGET_AVX2
+void iir_filter_process_avx2(iir_filter_t *f, float *data, int n)
+{
+    if (n < 16 || f->n_sections == 0 || f->precision != IIR_PRECISION_FLOAT) {
+        iir_filter_process_sse2(f, data, n);
+        return;
+    }
+    if (f->n_sections <= 2) {
+        cascade_block8(f, data, n);
+        return;
+    }
+    if (f->n_sections <= 4) {
+        iir_filter_process_sse2(f, data, n);
+        return;
+    }
+
+    const __m256i shift = _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6);
+
+    for (int s0 = 0; s0 < f->n_sections; s0 += 8) {
+        iir_wave_t w;
+        iir_wave_load(&w, f, s0, 8);
+
+        iir_wave_steps(&w, data, n, 0, 7);
+
+        __m256 vb0 = _mm256_loadu_ps(w.b0);
+        __m256 vb1 = _mm256_loadu_ps(w.b1);
+        __m256 vb2 = _mm256_loadu_ps(w.b2);
+        __m256 va1 = _mm256_loadu_ps(w.a1);
+        __m256 va2 = _mm256_loadu_ps(w.a2);
+        __m256 vz0 = _mm256_loadu_ps(w.z0);
+        __m256 vz1 = _mm256_loadu_ps(w.z1);
+        __m256 vy  = _mm256_loadu_ps(w.y);
+
+        for (int t = 7; t < n; t++) {
+            __m256 vx = _mm256_blend_ps(_mm256_permutevar8x32_ps(vy, shift),
+                                        _mm256_set1_ps(data[t]), 0x01);
+            vy  = _mm256_add_ps(_mm256_mul_ps(vb0, vx), vz0);
+            vz0 = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(vb1, vx),
+                                              _mm256_mul_ps(va1, vy)), vz1);
+            vz1 = _mm256_sub_ps(_mm256_mul_ps(vb2, vx), _mm256_mul_ps(va2, vy));
+            __m128 hi = _mm256_extractf128_ps(vy, 1);
+            data[t - 7] = _mm_cvtss_f32(_mm_shuffle_ps(hi, hi, _MM_SHUFFLE(3, 3, 3, 3)));
+        }
+
+        _mm256_storeu_ps(w.z0, vz0);
+        _mm256_storeu_ps(w.z1, vz1);
+        _mm256_storeu_ps(w.y, vy);
+
+        iir_wave_steps(&w, data, n, n, n + 7);
+        iir_wave_store(&w, f);
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Multi-channel lanes (sections fused in pairs)                       */
+/* ------------------------------------------------------------------ */
+
+void iir_lanes_process_sse2(iir_lanes_t *fl, float *data, int n)
+{
+    for (int s = 0; s < fl->n_sections; s += 2) {
+        const iir_lane_section_t *la = &fl->sections[s];
+        /* Odd count: the last section is paired with a pass-through */
+        const iir_lane_section_t *lb = (s + 1 < fl->n_sections) ? la + 1 : NULL;
+
+        __m128 ab0 = _mm_loadu_ps(la->b0), ab1 = _mm_loadu_ps(la->b1);
+        __m128 ab2 = _mm_loadu_ps(la->b2);
+        __m128 aa1 = _mm_loadu_ps(la->a1), aa2 = _mm_loadu_ps(la->a2);
+        __m128 az0 = _mm_loadu_ps(la->z0), az1 = _mm_loadu_ps(la->z1);
+
+        if (!lb) {
+            float *p = data;
+            for (int i = 0; i < n; i++, p += 4) {
+                __m128 vx = _mm_loadu_ps(p);
+                __m128 vy = _mm_add_ps(_mm_mul_ps(ab0, vx), az0);
+                az0 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(ab1, vx), _mm_mul_ps(aa1, vy)), az1);
+                az1 = _mm_sub_ps(_mm_mul_ps(ab2, vx), _mm_mul_ps(aa2, vy));
+                _mm_storeu_ps(p, vy);
+            }
+            _mm_storeu_ps(fl->sections[s].z0, az0);
+            _mm_storeu_ps(fl->sections[s].z1, az1);
+            break;
+        }
+
+        __m128 bb0 = _mm_loadu_ps(lb->b0), bb1 = _mm_loadu_ps(lb->b1);
+        __m128 bb2 = _mm_loadu_ps(lb->b2);
+        __m128 ba1 = _mm_loadu_ps(lb->a1), ba2 = _mm_loadu_ps(lb->a2);
+        __m128 bz0 = _mm_loadu_ps(lb->z0), bz1 = _mm_loadu_ps(lb->z1);
+
+        float *p = data;
+        for (int i = 0; i < n; i++, p += 4) {
+            __m128 vx = _mm_loadu_ps(p);
+            __m128 vy = _mm_add_ps(_mm_mul_ps(ab0, vx), az0);
+            az0 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(ab1, vx), _mm_mul_ps(aa1, vy)), az1);
+            az1 = _mm_sub_ps(_mm_mul_ps(ab2, vx), _mm_mul_ps(aa2, vy));
+
+            /* Second section consumes the first's output in registers */
+            vx = vy;
+            vy = _mm_add_ps(_mm_mul_ps(bb0, vx), bz0);
+            bz0 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(bb1, vx), _mm_mul_ps(ba1, vy)), bz1);
+            bz1 = _mm_sub_ps(_mm_mul_ps(bb2, vx), _mm_mul_ps(ba2, vy));
+            _mm_storeu_ps(p, vy);
+        }
+
+        _mm_storeu_ps(fl->sections[s].z0, az0);
+        _mm_storeu_ps(fl->sections[s].z1, az1);
+        _mm_storeu_ps(fl->sections[s + 1].z0, bz0);
+        _mm_storeu_ps(fl->sections[s + 1].z1, bz1);
+    }
+}
+
+CW_TARGET_AVX2
+void iir_lanes_process_avx2(iir_lanes_t *fl, float *data, int n)
+{
+    for (int s = 0; s < fl->n_sections; s += 2) {
+        const iir_lane_section_t *la = &fl->sections[s];
+        const iir_lane_section_t *lb = (s + 1 < fl->n_sections) ? la + 1 : NULL;
+
+        __m256 ab0 = _mm256_loadu_ps(la->b0), ab1 = _mm256_loadu_ps(la->b1);
+        __m256 ab2 = _mm256_loadu_ps(la->b2);
+        __m256 aa1 = _mm256_loadu_ps(la->a1), aa2 = _mm256_loadu_ps(la->a2);
+        __m256 az0 = _mm256_loadu_ps(la->z0), az1 = _mm256_loadu_ps(la->z1);
+
+        if (!lb) {
+            float *p = data;
+            for (int i = 0; i < n; i++, p += 8) {
+                __m256 vx = _mm256_loadu_ps(p);
+                __m256 vy = _mm256_add_ps(_mm256_mul_ps(ab0, vx), az0);
+                az0 = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(ab1, vx),
+                                                  _mm256_mul_ps(aa1, vy)), az1);
+                az1 = _mm256_sub_ps(_mm256_mul_ps(ab2, vx), _mm256_mul_ps(aa2, vy));
+                _mm256_storeu_ps(p, vy);
+            }
+            _mm256_storeu_ps(fl->sections[s].z0, az0);
+            _mm256_storeu_ps(fl->sections[s].z1, az1);
+            break;
+        }
+
+        __m256 bb0 = _mm256_loadu_ps(lb->b0), bb1 = _mm256_loadu_ps(lb->b1);
+        __m256 bb2 = _mm256_loadu_ps(lb->b2);
+        __m256 ba1 = _mm256_loadu_ps(lb->a1), ba2 = _mm256_loadu_ps(lb->a2);
+        __m256 bz0 = _mm256_loadu_ps(lb->z0), bz1 = _mm256_loadu_ps(lb->z1);
+
+        float *p = data;
+        for (int i = 0; i < n; i++, p += 8) {
+            __m256 vx = _mm256_loadu_ps(p);
+            __m256 vy = _mm256_add_ps(_mm256_mul_ps(ab0, vx), az0);
+            az0 = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(ab1, vx),
+                                              _mm256_mul_ps(aa1, vy)), az1);
+            az1 = _mm256_sub_ps(_mm256_mul_ps(ab2, vx), _mm256_mul_ps(aa2, vy));
+
+            vx = vy;
+            vy = _mm256_add_ps(_mm256_mul_ps(bb0, vx), bz0);
+            bz0 = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(bb1, vx),
+                                              _mm256_mul_ps(ba1, vy)), bz1);
+            bz1 = _mm256_sub_ps(_mm256_mul_ps(bb2, vx), _mm256_mul_ps(ba2, vy));
+            _mm256_storeu_ps(p, vy);
+        }
+
+        _mm256_storeu_ps(fl->sections[s].z0, az0);
+        _mm256_storeu_ps(fl->sections[s].z1, az1);
+        _mm256_storeu_ps(fl->sections[s + 1].z0, bz0);
+        _mm256_storeu_ps(fl->sections[s + 1].z1, bz1);
+    }
+}
+
+#endif /* x86 */
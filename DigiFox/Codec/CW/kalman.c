@@ -12,6 +12,16 @@
 #define M_LN2 0.693147180559945309f
 #endif
 
+/*
+ * No fused multiply-adds: the lane kernels (kalman_x86.c, kalman_neon.c)
+ * multiply and add separately, and every lane must match kalman_update().
+ */
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
 void kalman_init(kalman_t *k, int sample_rate, float initial_wpm,
                  float min_wpm, float max_wpm)
 {
@@ -27,6 +37,14 @@ void kalman_init(kalman_t *k, int sample_rate, float initial_wpm,
         k->Q[i] = 0.01f;
     }
 
+    /* WPM bounds on dit, ratio bounds relative to dit */
+    k->log_min_dit = logf((1.2f / max_wpm) * (float)sample_rate);
+    k->log_max_dit = logf((1.2f / min_wpm) * (float)sample_rate);
+    k->log2 = logf(2.0f);
+    k->log4 = logf(4.0f);
+    k->log5 = logf(5.0f);
+    k->log9 = logf(9.0f);
+
     kalman_reset(k, initial_wpm);
 }
 
@@ -42,49 +60,41 @@ void kalman_reset(kalman_t *k, float initial_wpm)
     k->x[K_WORD_SPACE] = logf(dit_samples * 7.0f);
 
     /* Initialize P as diagonal 0.1 */
-    memset(k->P, 0, sizeof(k->P));
     for (int i = 0; i < KALMAN_STATES; i++) {
-        k->P[i][i] = 0.1f;
+        k->P[i] = 0.1f;
     }
+    k->generation++;
+}
+
+static void apply_bounds(kalman_t *k);
+
+void kalman_set_bounds(kalman_t *k, float min_wpm, float max_wpm)
+{
+    k->min_wpm = min_wpm;
+    k->max_wpm = max_wpm;
+    k->log_min_dit = logf((1.2f / max_wpm) * (float)k->sample_rate);
+    k->log_max_dit = logf((1.2f / min_wpm) * (float)k->sample_rate);
+    apply_bounds(k);
+    k->generation++;
+}
+
+static inline void clamp(float *v, float lo, float hi)
+{
+    if (*v < lo) *v = lo;
+    if (*v > hi) *v = hi;
 }
 
 static void apply_bounds(kalman_t *k)
 {
     /* WPM bounds on dit */
-    float min_dit = (1.2f / k->max_wpm) * (float)k->sample_rate;
-    float max_dit = (1.2f / k->min_wpm) * (float)k->sample_rate;
-    float log_min = logf(min_dit);
-    float log_max = logf(max_dit);
-
-    if (k->x[K_DIT] < log_min) k->x[K_DIT] = log_min;
-    if (k->x[K_DIT] > log_max) k->x[K_DIT] = log_max;
+    clamp(&k->x[K_DIT], k->log_min_dit, k->log_max_dit);
 
     /* Ratio bounds relative to dit (±50% around ITU ratios) */
     float ld = k->x[K_DIT];
-
-    /* dah: 2× to 4× dit */
-    float dah_lo = ld + logf(2.0f);
-    float dah_hi = ld + logf(4.0f);
-    if (k->x[K_DAH] < dah_lo) k->x[K_DAH] = dah_lo;
-    if (k->x[K_DAH] > dah_hi) k->x[K_DAH] = dah_hi;
-
-    /* elem_space: 0.5× to 2× dit */
-    float es_lo = ld - M_LN2;
-    float es_hi = ld + M_LN2;
-    if (k->x[K_ELEM_SPACE] < es_lo) k->x[K_ELEM_SPACE] = es_lo;
-    if (k->x[K_ELEM_SPACE] > es_hi) k->x[K_ELEM_SPACE] = es_hi;
-
-    /* char_space: 2× to 4× dit */
-    float cs_lo = ld + logf(2.0f);
-    float cs_hi = ld + logf(4.0f);
-    if (k->x[K_CHAR_SPACE] < cs_lo) k->x[K_CHAR_SPACE] = cs_lo;
-    if (k->x[K_CHAR_SPACE] > cs_hi) k->x[K_CHAR_SPACE] = cs_hi;
-
-    /* word_space: 5× to 9× dit */
-    float ws_lo = ld + logf(5.0f);
-    float ws_hi = ld + logf(9.0f);
-    if (k->x[K_WORD_SPACE] < ws_lo) k->x[K_WORD_SPACE] = ws_lo;
-    if (k->x[K_WORD_SPACE] > ws_hi) k->x[K_WORD_SPACE] = ws_hi;
+    clamp(&k->x[K_DAH],        ld + k->log2, ld + k->log4);   /* 2× to 4× dit */
+    clamp(&k->x[K_ELEM_SPACE], ld - k->log2, ld + k->log2);   /* 0.5× to 2× dit */
+    clamp(&k->x[K_CHAR_SPACE], ld + k->log2, ld + k->log4);   /* 2× to 4× dit */
+    clamp(&k->x[K_WORD_SPACE], ld + k->log5, ld + k->log9);   /* 5× to 9× dit */
 }
 
 int kalman_update(kalman_t *k, int state_idx, float duration_samples)
@@ -92,52 +102,37 @@ int kalman_update(kalman_t *k, int state_idx, float duration_samples)
     if (state_idx < 0 || state_idx >= KALMAN_STATES) return 0;
     if (duration_samples <= 0.0f) return 0;
 
+    int idx = state_idx;
     float z = logf(duration_samples);
-    float innovation = z - k->x[state_idx];
+    float innovation = z - k->x[idx];
 
     /* Innovation gating: reject outliers */
     if (fabsf(innovation) > k->innovation_gate) {
         return 0;
     }
 
-    /* Kalman gain: K = P[idx][idx] / (P[idx][idx] + R) */
-    int idx = state_idx;
-    float S = k->P[idx][idx] + k->R;
+    /* Kalman gain: K = P[idx] / (P[idx] + R), zero for the other states */
+    float p = k->P[idx];
+    float S = p + k->R;
     if (S < 1e-10f) S = 1e-10f;
-
-    /* Compute Kalman gain vector (sparse H: only idx-th element = 1) */
-    float K[KALMAN_STATES];
-    for (int i = 0; i < KALMAN_STATES; i++) {
-        K[i] = k->P[i][idx] / S;
-    }
+    float K = p / S;
 
     /* State update: x = x + K * innovation */
-    for (int i = 0; i < KALMAN_STATES; i++) {
-        k->x[i] += K[i] * innovation;
-    }
+    k->x[idx] += K * innovation;
 
-    /* Covariance update: Joseph form P = (I - K*H)*P*(I - K*H)' + K*R*K' */
-    float P_new[KALMAN_STATES][KALMAN_STATES];
-    for (int i = 0; i < KALMAN_STATES; i++) {
-        for (int j = 0; j < KALMAN_STATES; j++) {
-            /* (I - K*H) * P */
-            float ikh_P = k->P[i][j] - K[i] * k->P[idx][j];
-            /* * (I - K*H)' */
-            P_new[i][j] = ikh_P - k->P[i][idx] * K[j] + K[i] * k->P[idx][idx] * K[j];
-            /* + K*R*K' */
-            P_new[i][j] += K[i] * k->R * K[j];
-        }
-    }
+    /* Joseph form P = (I - K*H)*P*(I - K*H)' + K*R*K', diagonal entry idx */
+    float ikh_P = p - K * p;
+    float p_new = ikh_P - p * K + K * p * K;
+    p_new += K * k->R * K;
 
     /* Add process noise (predict step) */
     for (int i = 0; i < KALMAN_STATES; i++) {
-        for (int j = 0; j < KALMAN_STATES; j++) {
-            k->P[i][j] = P_new[i][j];
-        }
-        k->P[i][i] += k->Q[i];
+        k->P[i] += k->Q[i];
     }
+    k->P[idx] = p_new + k->Q[idx];
 
     apply_bounds(k);
+    k->generation++;
     return 1;
 }
 
@@ -160,3 +155,76 @@ float kalman_get_wpm(const kalman_t *k)
     if (dit_s <= 0.0f) return 20.0f;
     return 1.2f / dit_s;
 }
+
+/* ------------------------------------------------------------------ */
+/* Multi-channel                                                       */
+/* ------------------------------------------------------------------ */
+
+void kalman_lanes_init(kalman_lanes_t *kl, int width)
+{
+    memset(kl, 0, sizeof(*kl));
+    kl->width = width;
+    kl->log2 = logf(2.0f);
+    kl->log4 = logf(4.0f);
+    kl->log5 = logf(5.0f);
+    kl->log9 = logf(9.0f);
+}
+
+void kalman_lanes_load(kalman_lanes_t *kl, int lane, const kalman_t *k)
+{
+    for (int i = 0; i < KALMAN_STATES; i++) {
+        kl->x[i][lane] = k->x[i];
+        kl->P[i][lane] = k->P[i];
+        kl->Q[i][lane] = k->Q[i];
+    }
+    kl->R[lane] = k->R;
+    kl->gate[lane] = k->innovation_gate;
+    kl->log_min_dit[lane] = k->log_min_dit;
+    kl->log_max_dit[lane] = k->log_max_dit;
+}
+
+void kalman_lanes_store(const kalman_lanes_t *kl, int lane, kalman_t *k)
+{
+    for (int i = 0; i < KALMAN_STATES; i++) {
+        k->x[i] = kl->x[i][lane];
+        k->P[i] = kl->P[i][lane];
+    }
+}
+
+void kalman_lanes_update_scalar(kalman_lanes_t *kl, const int *state, const float *z,
+                                int *accepted)
+{
+    for (int l = 0; l < kl->width; l++) {
+        int idx = state[l];
+        accepted[l] = 0;
+        if (idx < 0 || idx >= KALMAN_STATES) continue;
+
+        float xi = kl->x[idx][l];
+        float innovation = z[l] - xi;
+        if (fabsf(innovation) > kl->gate[l]) continue;
+
+        /* As kalman_update() */
+        float p = kl->P[idx][l];
+        float R = kl->R[l];
+        float S = p + R;
+        if (S < 1e-10f) S = 1e-10f;
+        float K = p / S;
+        kl->x[idx][l] = xi + K * innovation;
+
+        float ikh_P = p - K * p;
+        float p_new = ikh_P - p * K + K * p * K;
+        p_new += K * R * K;
+        for (int i = 0; i < KALMAN_STATES; i++) kl->P[i][l] += kl->Q[i][l];
+        kl->P[idx][l] = p_new + kl->Q[idx][l];
+
+        /* As apply_bounds() */
+        clamp(&kl->x[K_DIT][l], kl->log_min_dit[l], kl->log_max_dit[l]);
+        float ld = kl->x[K_DIT][l];
+        clamp(&kl->x[K_DAH][l],        ld + kl->log2, ld + kl->log4);
+        clamp(&kl->x[K_ELEM_SPACE][l], ld - kl->log2, ld + kl->log2);
+        clamp(&kl->x[K_CHAR_SPACE][l], ld + kl->log2, ld + kl->log4);
+        clamp(&kl->x[K_WORD_SPACE][l], ld + kl->log5, ld + kl->log9);
+
+        accepted[l] = 1;
+    }
+}
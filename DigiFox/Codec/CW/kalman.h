@@ -3,6 +3,12 @@
  *
  * States: [log(dit), log(dah), log(elem_space), log(char_space), log(word_space)]
  * All in sample-count units (log-space for multiplicative errors).
+ *
+ * Every measurement observes a single state (H = e_i) and the process
+ * noise is diagonal, so a covariance that starts diagonal stays
+ * diagonal: P is kept as its diagonal and an update touches one state.
+ * `generation` changes whenever the state does, so callers can cache
+ * thresholds derived from it.
  */
 
 #ifndef KALMAN_H
@@ -19,14 +25,19 @@
 
 typedef struct {
     float x[KALMAN_STATES];                    /* State vector (log-space) */
-    float P[KALMAN_STATES][KALMAN_STATES];     /* Covariance */
+    float P[KALMAN_STATES];                    /* Covariance (diagonal) */
     float Q[KALMAN_STATES];                    /* Process noise (diagonal) */
     float R;                                   /* Measurement noise */
     float innovation_gate;                     /* Log-space gate (default: log(2)) */
+    unsigned generation;                       /* Bumped on every state change */
 
     int   sample_rate;
     float min_wpm;
     float max_wpm;
+
+    /* apply_bounds() limits, precomputed in kalman_init() */
+    float log_min_dit, log_max_dit;
+    float log2, log4, log5, log9;
 } kalman_t;
 
 /**
@@ -57,9 +68,71 @@ float kalman_get_threshold(const kalman_t *k, int state_a, int state_b);
  */
 float kalman_get_wpm(const kalman_t *k);
 
+/**
+ * Change the WPM bounds on the dit, keeping the state (clamped to them).
+ */
+void kalman_set_bounds(kalman_t *k, float min_wpm, float max_wpm);
+
 /**
  * Reset to initial state.
  */
 void kalman_reset(kalman_t *k, float initial_wpm);
 
+/* ------------------------------------------------------------------ */
+/* Multi-channel (struct of arrays, one filter per lane)               */
+/* ------------------------------------------------------------------ */
+
+/* Maximum lanes (AVX2: 8 floats, SSE2/NEON: 4 floats), as IIR_MAX_LANES */
+#define KALMAN_MAX_LANES 8
+
+/*
+ * Filters of up to KALMAN_MAX_LANES channels side by side: field[state][lane],
+ * so one vector operation advances a state of every lane. Loaded from and
+ * stored back to each channel's kalman_t around a batch of updates.
+ */
+typedef struct {
+    int   width;
+    float x[KALMAN_STATES][KALMAN_MAX_LANES];
+    float P[KALMAN_STATES][KALMAN_MAX_LANES];
+    float Q[KALMAN_STATES][KALMAN_MAX_LANES];
+    float R[KALMAN_MAX_LANES];
+    float gate[KALMAN_MAX_LANES];
+    float log_min_dit[KALMAN_MAX_LANES];
+    float log_max_dit[KALMAN_MAX_LANES];
+    float log2, log4, log5, log9;
+} kalman_lanes_t;
+
+/**
+ * Initialize an empty bank of `width` lanes (4 or 8, the kernel lane width).
+ */
+void kalman_lanes_init(kalman_lanes_t *kl, int width);
+
+/**
+ * Copy a channel's filter into a lane, or its state back out. Storing
+ * does not touch the generation; the caller bumps it if the lane changed.
+ */
+void kalman_lanes_load(kalman_lanes_t *kl, int lane, const kalman_t *k);
+void kalman_lanes_store(const kalman_lanes_t *kl, int lane, kalman_t *k);
+
+/**
+ * kalman_update() on every lane at once: lane l measures log-duration
+ * z[l] into state[l], or sits out when state[l] < 0. accepted[l] is set
+ * to 1 where the measurement passed the innovation gate, else 0. Each
+ * lane ends exactly as kalman_update() would leave it.
+ */
+void kalman_lanes_update_scalar(kalman_lanes_t *kl, const int *state, const float *z,
+                                int *accepted);
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+void kalman_lanes_update_neon(kalman_lanes_t *kl, const int *state, const float *z,
+                              int *accepted);
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+void kalman_lanes_update_sse2(kalman_lanes_t *kl, const int *state, const float *z,
+                              int *accepted);
+void kalman_lanes_update_avx2(kalman_lanes_t *kl, const int *state, const float *z,
+                              int *accepted);
+#endif
+
 #endif /* KALMAN_H */
@@ -0,0 +1,84 @@
+/**
+ * kalman_neon.c — NEON multi-channel Kalman timing update
+ *
+ * 4 lanes per instruction, as the SSE2 kernel in kalman_x86.c: pick each
+ * lane's measured state by compare-and-select, update every lane, and
+ * keep the result only where the measurement passed the gate. No fused
+ * multiply-adds, so every lane matches kalman_update().
+ */
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+#include "kalman.h"
+#include <arm_neon.h>
+
+static inline float32x4_t clamp_neon(float32x4_t v, float32x4_t lo, float32x4_t hi)
+{
+    return vminq_f32(vmaxq_f32(v, lo), hi);
+}
+
+static void update4_neon(kalman_lanes_t *kl, int l0, const int *state, const float *z,
+                         int *accepted)
+{
+    const int32x4_t st = vld1q_s32(state + l0);
+
+    /* This lane's state and covariance */
+    uint32x4_t is[KALMAN_STATES];
+    float32x4_t xi = vdupq_n_f32(0.0f), p = vdupq_n_f32(0.0f);
+    uint32x4_t active = vdupq_n_u32(0);
+    for (int i = 0; i < KALMAN_STATES; i++) {
+        is[i] = vceqq_s32(st, vdupq_n_s32(i));
+        xi = vbslq_f32(is[i], vld1q_f32(&kl->x[i][l0]), xi);
+        p = vbslq_f32(is[i], vld1q_f32(&kl->P[i][l0]), p);
+        active = vorrq_u32(active, is[i]);
+    }
+
+    const float32x4_t innovation = vsubq_f32(vld1q_f32(z + l0), xi);
+    const uint32x4_t ok = vandq_u32(active, vcleq_f32(vabsq_f32(innovation),
+                                                      vld1q_f32(kl->gate + l0)));
+    int32x4_t acc = vreinterpretq_s32_u32(vshrq_n_u32(ok, 31));
+    vst1q_s32(accepted + l0, acc);
+    if (vmaxvq_u32(ok) == 0) return;
+
+    const float32x4_t R = vld1q_f32(kl->R + l0);
+    const float32x4_t S = vmaxq_f32(vaddq_f32(p, R), vdupq_n_f32(1e-10f));
+    const float32x4_t K = vdivq_f32(p, S);
+    const float32x4_t x_new = vaddq_f32(xi, vmulq_f32(K, innovation));
+
+    const float32x4_t ikh_P = vsubq_f32(p, vmulq_f32(K, p));
+    float32x4_t p_new = vaddq_f32(vsubq_f32(ikh_P, vmulq_f32(p, K)),
+                                  vmulq_f32(vmulq_f32(K, p), K));
+    p_new = vaddq_f32(p_new, vmulq_f32(vmulq_f32(K, R), K));
+
+    float32x4_t x[KALMAN_STATES];
+    for (int i = 0; i < KALMAN_STATES; i++) {
+        const float32x4_t q = vld1q_f32(&kl->Q[i][l0]);
+        const float32x4_t P_old = vld1q_f32(&kl->P[i][l0]);
+        const float32x4_t P_upd = vbslq_f32(is[i], vaddq_f32(p_new, q), vaddq_f32(P_old, q));
+        vst1q_f32(&kl->P[i][l0], vbslq_f32(ok, P_upd, P_old));
+        x[i] = vbslq_f32(is[i], x_new, vld1q_f32(&kl->x[i][l0]));
+    }
+
+    /* Bounds, as apply_bounds() */
+    const float32x4_t l2 = vdupq_n_f32(kl->log2), l4 = vdupq_n_f32(kl->log4);
+    const float32x4_t l5 = vdupq_n_f32(kl->log5), l9 = vdupq_n_f32(kl->log9);
+    x[K_DIT] = clamp_neon(x[K_DIT], vld1q_f32(kl->log_min_dit + l0),
+                          vld1q_f32(kl->log_max_dit + l0));
+    const float32x4_t ld = x[K_DIT];
+    x[K_DAH]        = clamp_neon(x[K_DAH],        vaddq_f32(ld, l2), vaddq_f32(ld, l4));
+    x[K_ELEM_SPACE] = clamp_neon(x[K_ELEM_SPACE], vsubq_f32(ld, l2), vaddq_f32(ld, l2));
+    x[K_CHAR_SPACE] = clamp_neon(x[K_CHAR_SPACE], vaddq_f32(ld, l2), vaddq_f32(ld, l4));
+    x[K_WORD_SPACE] = clamp_neon(x[K_WORD_SPACE], vaddq_f32(ld, l5), vaddq_f32(ld, l9));
+
+    for (int i = 0; i < KALMAN_STATES; i++) {
+        vst1q_f32(&kl->x[i][l0], vbslq_f32(ok, x[i], vld1q_f32(&kl->x[i][l0])));
+    }
+}
+
+void kalman_lanes_update_neon(kalman_lanes_t *kl, const int *state, const float *z,
+                              int *accepted)
+{
+    for (int l0 = 0; l0 < kl->width; l0 += 4) update4_neon(kl, l0, state, z, accepted);
+}
+
+#endif /* aarch64 */
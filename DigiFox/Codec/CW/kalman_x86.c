@@ -0,0 +1,181 @@
+/**
+ * kalman_x86.c — SSE2/AVX2 multi-channel Kalman timing update
+ *
+ * 4 (SSE2) or 8 (AVX2) lanes per instruction. Each lane's measured state
+ * is picked out of the five by compare-and-blend, the gain and covariance
+ * update run on all lanes, and the results are blended back only where
+ * the lane has a measurement that passed its gate. Separate multiplies
+ * and adds, as kalman.c, so every lane matches kalman_update().
+ *
+ * Only compiled on x86; the AVX2 kernel is selected at runtime.
+ */
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+
+#include "kalman.h"
+#include <emmintrin.h>
+#include <immintrin.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CW_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CW_TARGET_AVX2
+#endif
+
+/* ------------------------------------------------------------------ */
+/* SSE2                                                                */
+/* ------------------------------------------------------------------ */
+
+static inline __m128 blend_sse2(__m128 mask, __m128 a, __m128 b)
+{
+    /* mask ? a : b */
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static inline __m128 clamp_sse2(__m128 v, __m128 lo, __m128 hi)
+{
+    return _mm_min_ps(_mm_max_ps(v, lo), hi);
+}
+
+static void update4_sse2(kalman_lanes_t *kl, int l0, const int *state, const float *z,
+                         int *accepted)
+{
+    const __m128i st = _mm_loadu_si128((const __m128i *)(state + l0));
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+    /* This lane's state and covariance */
+    __m128 is[KALMAN_STATES];
+    __m128 xi = _mm_setzero_ps(), p = _mm_setzero_ps();
+    for (int i = 0; i < KALMAN_STATES; i++) {
+        is[i] = _mm_castsi128_ps(_mm_cmpeq_epi32(st, _mm_set1_epi32(i)));
+        xi = blend_sse2(is[i], _mm_loadu_ps(&kl->x[i][l0]), xi);
+        p = blend_sse2(is[i], _mm_loadu_ps(&kl->P[i][l0]), p);
+    }
+    __m128 active = _mm_setzero_ps();
+    for (int i = 0; i < KALMAN_STATES; i++) active = _mm_or_ps(active, is[i]);
+
+    const __m128 innovation = _mm_sub_ps(_mm_loadu_ps(z + l0), xi);
+    const __m128 ok = _mm_and_ps(active, _mm_cmple_ps(_mm_and_ps(innovation, abs_mask),
+                                                      _mm_loadu_ps(kl->gate + l0)));
+    const int okbits = _mm_movemask_ps(ok);
+    for (int l = 0; l < 4; l++) accepted[l0 + l] = (okbits >> l) & 1;
+    if (!okbits) return;
+
+    const __m128 R = _mm_loadu_ps(kl->R + l0);
+    const __m128 S = _mm_max_ps(_mm_add_ps(p, R), _mm_set1_ps(1e-10f));
+    const __m128 K = _mm_div_ps(p, S);
+    const __m128 x_new = _mm_add_ps(xi, _mm_mul_ps(K, innovation));
+
+    const __m128 ikh_P = _mm_sub_ps(p, _mm_mul_ps(K, p));
+    __m128 p_new = _mm_add_ps(_mm_sub_ps(ikh_P, _mm_mul_ps(p, K)),
+                              _mm_mul_ps(_mm_mul_ps(K, p), K));
+    p_new = _mm_add_ps(p_new, _mm_mul_ps(_mm_mul_ps(K, R), K));
+
+    __m128 x[KALMAN_STATES];
+    for (int i = 0; i < KALMAN_STATES; i++) {
+        const __m128 q = _mm_loadu_ps(&kl->Q[i][l0]);
+        const __m128 P_old = _mm_loadu_ps(&kl->P[i][l0]);
+        const __m128 P_upd = blend_sse2(is[i], _mm_add_ps(p_new, q), _mm_add_ps(P_old, q));
+        _mm_storeu_ps(&kl->P[i][l0], blend_sse2(ok, P_upd, P_old));
+        x[i] = blend_sse2(is[i], x_new, _mm_loadu_ps(&kl->x[i][l0]));
+    }
+
+    /* Bounds, as apply_bounds() */
+    const __m128 l2 = _mm_set1_ps(kl->log2), l4 = _mm_set1_ps(kl->log4);
+    const __m128 l5 = _mm_set1_ps(kl->log5), l9 = _mm_set1_ps(kl->log9);
+    x[K_DIT] = clamp_sse2(x[K_DIT], _mm_loadu_ps(kl->log_min_dit + l0),
+                          _mm_loadu_ps(kl->log_max_dit + l0));
+    const __m128 ld = x[K_DIT];
+    x[K_DAH]        = clamp_sse2(x[K_DAH],        _mm_add_ps(ld, l2), _mm_add_ps(ld, l4));
+    x[K_ELEM_SPACE] = clamp_sse2(x[K_ELEM_SPACE], _mm_sub_ps(ld, l2), _mm_add_ps(ld, l2));
+    x[K_CHAR_SPACE] = clamp_sse2(x[K_CHAR_SPACE], _mm_add_ps(ld, l2), _mm_add_ps(ld, l4));
+    x[K_WORD_SPACE] = clamp_sse2(x[K_WORD_SPACE], _mm_add_ps(ld, l5), _mm_add_ps(ld, l9));
+
+    for (int i = 0; i < KALMAN_STATES; i++) {
+        _mm_storeu_ps(&kl->x[i][l0], blend_sse2(ok, x[i], _mm_loadu_ps(&kl->x[i][l0])));
+    }
+}
+
+void kalman_lanes_update_sse2(kalman_lanes_t *kl, const int *state, const float *z,
+                              int *accepted)
+{
+    for (int l0 = 0; l0 < kl->width; l0 += 4) update4_sse2(kl, l0, state, z, accepted);
+}
+
+/* ------------------------------------------------------------------ */
+/* AVX2                                                                */
+/* ------------------------------------------------------------------ */
+
+CW_TARGET_AVX2
+static inline __m256 clamp_avx2(__m256 v, __m256 lo, __m256 hi)
+{
+    return _mm256_min_ps(_mm256_max_ps(v, lo), hi);
+}
+
+CW_TARGET_AVX2
+static void update8_avx2(kalman_lanes_t *kl, int l0, const int *state, const float *z,
+                         int *accepted)
+{
+    const __m256i st = _mm256_loadu_si256((const __m256i *)(state + l0));
+    const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+    __m256 is[KALMAN_STATES];
+    __m256 xi = _mm256_setzero_ps(), p = _mm256_setzero_ps();
+    __m256 active = _mm256_setzero_ps();
+    for (int i = 0; i < KALMAN_STATES; i++) {
+        is[i] = _mm256_castsi256_ps(_mm256_cmpeq_epi32(st, _mm256_set1_epi32(i)));
+        xi = _mm256_blendv_ps(xi, _mm256_loadu_ps(&kl->x[i][l0]), is[i]);
+        p = _mm256_blendv_ps(p, _mm256_loadu_ps(&kl->P[i][l0]), is[i]);
+        active = _mm256_or_ps(active, is[i]);
+    }
+
+    const __m256 innovation = _mm256_sub_ps(_mm256_loadu_ps(z + l0), xi);
+    const __m256 ok = _mm256_and_ps(active,
+                                    _mm256_cmp_ps(_mm256_and_ps(innovation, abs_mask),
+                                                  _mm256_loadu_ps(kl->gate + l0), _CMP_LE_OQ));
+    const int okbits = _mm256_movemask_ps(ok);
+    for (int l = 0; l < 8; l++) accepted[l0 + l] = (okbits >> l) & 1;
+    if (!okbits) return;
+
+    const __m256 R = _mm256_loadu_ps(kl->R + l0);
+    const __m256 S = _mm256_max_ps(_mm256_add_ps(p, R), _mm256_set1_ps(1e-10f));
+    const __m256 K = _mm256_div_ps(p, S);
+    const __m256 x_new = _mm256_add_ps(xi, _mm256_mul_ps(K, innovation));
+
+    const __m256 ikh_P = _mm256_sub_ps(p, _mm256_mul_ps(K, p));
+    __m256 p_new = _mm256_add_ps(_mm256_sub_ps(ikh_P, _mm256_mul_ps(p, K)),
+                                 _mm256_mul_ps(_mm256_mul_ps(K, p), K));
+    p_new = _mm256_add_ps(p_new, _mm256_mul_ps(_mm256_mul_ps(K, R), K));
+
+    __m256 x[KALMAN_STATES];
+    for (int i = 0; i < KALMAN_STATES; i++) {
+        const __m256 q = _mm256_loadu_ps(&kl->Q[i][l0]);
+        const __m256 P_old = _mm256_loadu_ps(&kl->P[i][l0]);
+        const __m256 P_upd = _mm256_blendv_ps(_mm256_add_ps(P_old, q), _mm256_add_ps(p_new, q), is[i]);
+        _mm256_storeu_ps(&kl->P[i][l0], _mm256_blendv_ps(P_old, P_upd, ok));
+        x[i] = _mm256_blendv_ps(_mm256_loadu_ps(&kl->x[i][l0]), x_new, is[i]);
+    }
+
+    const __m256 l2 = _mm256_set1_ps(kl->log2), l4 = _mm256_set1_ps(kl->log4);
+    const __m256 l5 = _mm256_set1_ps(kl->log5), l9 = _mm256_set1_ps(kl->log9);
+    x[K_DIT] = clamp_avx2(x[K_DIT], _mm256_loadu_ps(kl->log_min_dit + l0),
+                          _mm256_loadu_ps(kl->log_max_dit + l0));
+    const __m256 ld = x[K_DIT];
+    x[K_DAH]        = clamp_avx2(x[K_DAH],        _mm256_add_ps(ld, l2), _mm256_add_ps(ld, l4));
+    x[K_ELEM_SPACE] = clamp_avx2(x[K_ELEM_SPACE], _mm256_sub_ps(ld, l2), _mm256_add_ps(ld, l2));
+    x[K_CHAR_SPACE] = clamp_avx2(x[K_CHAR_SPACE], _mm256_add_ps(ld, l2), _mm256_add_ps(ld, l4));
+    x[K_WORD_SPACE] = clamp_avx2(x[K_WORD_SPACE], _mm256_add_ps(ld, l5), _mm256_add_ps(ld, l9));
+
+    for (int i = 0; i < KALMAN_STATES; i++) {
+        _mm256_storeu_ps(&kl->x[i][l0], _mm256_blendv_ps(_mm256_loadu_ps(&kl->x[i][l0]), x[i], ok));
+    }
+}
+
+CW_TARGET_AVX2
+void kalman_lanes_update_avx2(kalman_lanes_t *kl, const int *state, const float *z,
+                              int *accepted)
+{
+    for (int l0 = 0; l0 < kl->width; l0 += 8) update8_avx2(kl, l0, state, z, accepted);
+}
+
+#endif /* x86 */
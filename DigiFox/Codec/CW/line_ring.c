@@ -0,0 +1,109 @@
+/**
+ * line_ring.c — Overwrite ring of byte lines with a sequence-checked layout
+ */
+
+#include "line_ring.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+
+/* Layout word: start line << 16 | bins */
+#define LAYOUT_BINS_BITS  16
+#define LAYOUT_BINS_MASK  ((1u << LAYOUT_BINS_BITS) - 1)
+
+struct line_ring_t {
+    uint8_t *rows;                /* capacity rows of max_bins */
+    int      capacity;
+    int      max_bins;
+    int      bins;                /* Producer's current width */
+    _Atomic uint64_t layout;
+    _Atomic uint64_t written;     /* Lines complete */
+    _Atomic uint64_t reserved;    /* Lines complete or being written */
+};
+
+static inline uint64_t pack_layout(uint64_t start, int bins)
+{
+    return start << LAYOUT_BINS_BITS | (uint64_t)bins;
+}
+
+line_ring_t *line_ring_create(int capacity, int max_bins)
+{
+    if (capacity < 1 || max_bins < 1 || max_bins > (int)LAYOUT_BINS_MASK) return NULL;
+
+    line_ring_t *r = (line_ring_t *)calloc(1, sizeof(line_ring_t));
+    if (!r) return NULL;
+    r->rows = (uint8_t *)calloc((size_t)capacity * (size_t)max_bins, 1);
+    if (!r->rows) {
+        free(r);
+        return NULL;
+    }
+    r->capacity = capacity;
+    r->max_bins = max_bins;
+    atomic_init(&r->layout, pack_layout(0, 0));
+    atomic_init(&r->written, 0);
+    atomic_init(&r->reserved, 0);
+    return r;
+}
+
+int line_ring_capacity(const line_ring_t *r)
+{
+    return r->capacity;
+}
+
+uint8_t *line_ring_begin(line_ring_t *r, int bins)
+{
+    if (bins < 1 || bins > r->max_bins) return NULL;
+
+    uint64_t w = atomic_load_explicit(&r->written, memory_order_relaxed);
+    if (bins != r->bins) {
+        r->bins = bins;
+        atomic_store_explicit(&r->layout, pack_layout(w, bins), memory_order_relaxed);
+    }
+
+    /* Claim the row before touching it, so readers can tell */
+    atomic_store_explicit(&r->reserved, w + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    return r->rows + (size_t)(w % (uint64_t)r->capacity) * (size_t)r->max_bins;
+}
+
+void line_ring_commit(line_ring_t *r)
+{
+    uint64_t w = atomic_load_explicit(&r->written, memory_order_relaxed);
+    atomic_store_explicit(&r->written, w + 1, memory_order_release);
+}
+
+void line_ring_clear(line_ring_t *r)
+{
+    uint64_t w = atomic_load_explicit(&r->written, memory_order_relaxed);
+    atomic_store_explicit(&r->layout, pack_layout(w, r->bins), memory_order_release);
+}
+
+void line_ring_view(const line_ring_t *r, line_ring_view_t *v)
+{
+    /* Layout first: a line is never published before the layout it belongs to */
+    uint64_t layout = atomic_load_explicit(&((line_ring_t *)r)->layout, memory_order_acquire);
+    v->written = atomic_load_explicit(&((line_ring_t *)r)->written, memory_order_acquire);
+    v->start = layout >> LAYOUT_BINS_BITS;
+    v->bins = (int)(layout & LAYOUT_BINS_MASK);
+}
+
+const uint8_t *line_ring_row(const line_ring_t *r, uint64_t n)
+{
+    return r->rows + (size_t)(n % (uint64_t)r->capacity) * (size_t)r->max_bins;
+}
+
+int line_ring_intact(const line_ring_t *r, const line_ring_view_t *v, uint64_t from)
+{
+    /* Order the caller's reads of the rows before the checks */
+    atomic_thread_fence(memory_order_acquire);
+    uint64_t layout = atomic_load_explicit(&((line_ring_t *)r)->layout, memory_order_relaxed);
+    uint64_t claimed = atomic_load_explicit(&((line_ring_t *)r)->reserved, memory_order_relaxed);
+    return layout == pack_layout(v->start, v->bins) && claimed - from <= (uint64_t)r->capacity;
+}
+
+void line_ring_destroy(line_ring_t *r)
+{
+    if (!r) return;
+    free(r->rows);
+    free(r);
+}
@@ -0,0 +1,83 @@
+/**
+ * line_ring.h — Lock-free ring of display lines, one writer, any readers
+ *
+ * The waterfall's counterpart of sample_ring: the audio thread appends
+ * a line of bytes as each spectrum line completes and never waits, and
+ * the renderers copy the lines they have not seen straight from the
+ * ring at draw time, under no lock.
+ *
+ * Lines are counted from creation. The width and the line the current
+ * width (or the last clear) started at form the layout word; each line
+ * is claimed (reserved) before its row is written and published
+ * (written, release) after. A reader takes a view (acquire), copies the
+ * rows it wants in place, then checks line_ring_intact(): if the layout
+ * changed or the writer lapped the rows meanwhile, the copies are
+ * suspect and the reader takes them again from a fresh view. A seqlock,
+ * in effect, with the write count as its sequence.
+ *
+ * All memory is allocated in line_ring_create().
+ */
+
+#ifndef LINE_RING_H
+#define LINE_RING_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct line_ring_t line_ring_t;
+
+/* What a reader saw */
+typedef struct {
+    uint64_t start;     /* First line of the current layout */
+    int      bins;      /* Bytes per line, 0 before the first */
+    uint64_t written;   /* One past the newest line */
+} line_ring_view_t;
+
+/**
+ * Create a ring keeping the last `capacity` lines of up to `max_bins`
+ * bytes. Returns NULL on allocation failure or bad sizes.
+ */
+line_ring_t *line_ring_create(int capacity, int max_bins);
+
+/* Lines kept */
+int line_ring_capacity(const line_ring_t *r);
+
+/**
+ * Producer: the row to fill with the next line, `bins` bytes. A width
+ * other than the last starts a new layout, leaving the older lines
+ * behind. Returns NULL if bins is out of range.
+ */
+uint8_t *line_ring_begin(line_ring_t *r, int bins);
+
+/* Producer: publish the line filled since line_ring_begin() */
+void line_ring_commit(line_ring_t *r);
+
+/* Producer (or while it is idle): forget every line */
+void line_ring_clear(line_ring_t *r);
+
+/* Reader: the current layout and line count */
+void line_ring_view(const line_ring_t *r, line_ring_view_t *v);
+
+/* Reader: row of line n, in place; lines share a row capacity apart */
+const uint8_t *line_ring_row(const line_ring_t *r, uint64_t n);
+
+/**
+ * Reader: true if the rows of lines from `from` on, read under view v,
+ * are what v described: the layout is unchanged and none of them has
+ * been or is being overwritten. Call it after reading.
+ */
+int line_ring_intact(const line_ring_t *r, const line_ring_view_t *v, uint64_t from);
+
+/**
+ * Destroy ring and free all resources.
+ */
+void line_ring_destroy(line_ring_t *r);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LINE_RING_H */
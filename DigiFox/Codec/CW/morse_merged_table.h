@@ -0,0 +1,275 @@
+/**
+ * morse_merged_table.h — Precomputed merged lookup (generated)
+ *
+ * Generated by gen_morse_merged.py from morse_table.c — do not edit.
+ * Entry [code] is the morse_lookup_merged_code() result for every
+ * pattern of up to MORSE_MERGED_MAX_LEN elements: one character, or two
+ * for the best split (second 0 when there is none).
+ */
+
+#ifndef MORSE_MERGED_TABLE_H
+#define MORSE_MERGED_TABLE_H
+
+#define MORSE_MERGED_MAX_LEN  10
+#define MORSE_MERGED_SIZE     2048
+
+static const char MORSE_MERGED[MORSE_MERGED_SIZE][2] = {
+    {0,0}, {0,0}, {'E',0}, {'T',0}, {'I',0}, {'A',0}, {'N',0}, {'M',0},
+    {'S',0}, {'U',0}, {'R',0}, {'W',0}, {'D',0}, {'K',0}, {'G',0}, {'O',0},
+    {'H',0}, {'V',0}, {'F',0}, {'E','W'}, {'L',0}, {'E','K'}, {'P',0}, {'J',0},
+    {'B',0}, {'X',0}, {'C',0}, {'Y',0}, {'Z',0}, {'Q',0}, {'O','E'}, {'T','O'},
+    {'5',0}, {'4',0}, {'E','F'}, {'3',0}, {'E','L'}, {'F','T'}, {'E','P'}, {'2',0},
+    {'&',0}, {'E','X'}, {'+',0}, {'E','Y'}, {'P','E'}, {'E','Q'}, {'J','E'}, {'1',0},
+    {'6',0}, {'=',0}, {'/',0}, {'X','T'}, {'C','E'}, {'C','T'}, {'(',0}, {'Y','T'},
+    {'7',0}, {'T','X'}, {'Q','E'}, {'T','Y'}, {'8',0}, {'O','A'}, {'9',0}, {'0',0},
+    {'E','5'}, {'E','4'}, {'4','E'}, {'E','3'}, {'I','L'}, {'V','A'}, {'3','E'}, {'E','2'},
+    {'E','&'}, {'F','A'}, {'E','+'}, {'I','Y'}, {'I','Z'}, {'_',0}, {'2','E'}, {'E','1'},
+    {'E','6'}, {'E','='}, {'"',0}, {'R','W'}, {'+','E'}, {'.',0}, {'E','('}, {'R','O'},
+    {'E','7'}, {'P','A'}, {'@',0}, {'A','Y'}, {'E','8'}, {'J','A'}, {'\'',0}, {'E','0'},
+    {'6','E'}, {'-',0}, {'=','E'}, {'T','3'}, {'/','E'}, {'/','T'}, {'N','P'}, {'T','2'},
+    {'T','&'}, {'C','A'}, {';',0}, {'!',0}, {'(','E'}, {')',0}, {'Y','N'}, {'T','1'},
+    {'7','E'}, {'7','T'}, {'T','/'}, {',',0}, {'Q','I'}, {'Q','A'}, {'T','('}, {'G','O'},
+    {':',0}, {'8','T'}, {'O','R'}, {'O','W'}, {'9','E'}, {'9','T'}, {'0','E'}, {'O','O'},
+    {'S','H'}, {'H','U'}, {'H','R'}, {'H','W'}, {'H','D'}, {'4','A'}, {'H','G'}, {'H','O'},
+    {'S','B'}, {'$',0}, {'S','C'}, {'S','Y'}, {'3','I'}, {'E','_'}, {'3','N'}, {'V','O'},
+    {'U','H'}, {'I','='}, {'E','"'}, {'F','W'}, {'U','L'}, {'E','.'}, {'I','('}, {'F','O'},
+    {'I','7'}, {'U','X'}, {'E','@'}, {'_','T'}, {'I','8'}, {'2','A'}, {'E','\''}, {'I','0'},
+    {'R','H'}, {'E','-'}, {'L','R'}, {'A','3'}, {'"','E'}, {'"','T'}, {'R','P'}, {'L','O'},
+    {'A','&'}, {'+','A'}, {'.','E'}, {'E','!'}, {'R','Z'}, {'E',')'}, {'?',0}, {'A','1'},
+    {'W','H'}, {'A','='}, {'A','/'}, {'E',','}, {'@','E'}, {'@','T'}, {'A','('}, {'P','O'},
+    {'E',':'}, {'J','U'}, {'J','R'}, {'W','Y'}, {'\'','E'}, {'\'','T'}, {'A','9'}, {'A','0'},
+    {'D','H'}, {'6','A'}, {'-','E'}, {'-','T'}, {'D','L'}, {'=','A'}, {'=','N'}, {'B','O'},
+    {'/','I'}, {'/','A'}, {'D','C'}, {'D','Y'}, {'X','D'}, {'T','_'}, {'X','G'}, {'X','O'},
+    {'C','S'}, {'N','='}, {'T','"'}, {'C','W'}, {';','E'}, {'T','.'}, {'!','E'}, {'!','T'},
+    {'Y','S'}, {'(','A'}, {')','E'}, {')','T'}, {'N','8'}, {'Y','K'}, {'T','\''}, {'Y','O'},
+    {'G','H'}, {'T','-'}, {'7','N'}, {'M','3'}, {'G','L'}, {'Z','K'}, {',','E'}, {',','T'},
+    {'Q','S'}, {'Q','U'}, {'T',';'}, {'T','!'}, {'Q','D'}, {'T',')'}, {'Q','G'}, {'Q','O'},
+    {':','E'}, {':','T'}, {'O','F'}, {'T',','}, {'O','L'}, {'?',0}, {'O','P'}, {'O','J'},
+    {'T',':'}, {'9','A'}, {'O','C'}, {'O','Y'}, {'O','Z'}, {'0','A'}, {'0','N'}, {'M','0'},
+    {'H','H'}, {'H','V'}, {'H','F'}, {'S','3'}, {'H','L'}, {'5','K'}, {'H','P'}, {'5','O'},
+    {'H','B'}, {'E','$'}, {'H','C'}, {'H','Y'}, {'H','Z'}, {'I','_'}, {'4','G'}, {'4','O'},
+    {'V','H'}, {'S','='}, {'$','E'}, {'$','T'}, {'V','L'}, {'I','.'}, {'S','('}, {'V','J'},
+    {'S','7'}, {'3','U'}, {'I','@'}, {'V','Y'}, {'S','8'}, {'3','K'}, {'I','\''}, {'3','O'},
+    {'F','H'}, {'I','-'}, {'F','F'}, {'U','3'}, {'F','L'}, {'?',0}, {'F','P'}, {'U','2'},
+    {'F','B'}, {'F','X'}, {'I',';'}, {'I','!'}, {'F','Z'}, {'I',')'}, {'?',0}, {'U','1'},
+    {'U','6'}, {'U','='}, {'U','/'}, {'I',','}, {'_','I'}, {'_','A'}, {'_','N'}, {'_','M'},
+    {'I',':'}, {'2','U'}, {'2','R'}, {'2','W'}, {'2','D'}, {'2','K'}, {'U','9'}, {'2','O'},
+    {'L','H'}, {'R','4'}, {'L','F'}, {'R','3'}, {'L','L'}, {'&','K'}, {'L','P'}, {'&','O'},
+    {'"','I'}, {'"','A'}, {'L','C'}, {'L','Y'}, {'L','Z'}, {'A','_'}, {'?',0}, {'R','1'},
+    {'+','S'}, {'R','='}, {'A','"'}, {'+','W'}, {'.','I'}, {'A','.'}, {'.','N'}, {'+','O'},
+    {'R','7'}, {'?',0}, {'A','@'}, {'?',0}, {'R','8'}, {'?',0}, {'A','\''}, {'R','0'},
+    {'P','H'}, {'A','-'}, {'P','F'}, {'W','3'}, {'P','L'}, {'?',0}, {'P','P'}, {'W','2'},
+    {'@','I'}, {'@','A'}, {'A',';'}, {'A','!'}, {'P','Z'}, {'A',')'}, {'?',0}, {'W','1'},
+    {'J','H'}, {'W','='}, {'W','/'}, {'A',','}, {'J','L'}, {'?',0}, {'W','('}, {'J','J'},
+    {'A',':'}, {'\'','A'}, {'\'','N'}, {'\'','M'}, {'1','D'}, {'1','K'}, {'W','9'}, {'1','O'},
+    {'B','H'}, {'D','4'}, {'6','R'}, {'D','3'}, {'-','I'}, {'-','A'}, {'-','N'}, {'6','O'},
+    {'=','S'}, {'T','$'}, {'=','R'}, {'B','Y'}, {'=','D'}, {'N','_'}, {'=','G'}, {'=','O'},
+    {'X','H'}, {'D','='}, {'N','"'}, {'/','W'}, {'/','D'}, {'N','.'}, {'D','('}, {'/','O'},
+    {'D','7'}, {'X','X'}, {'N','@'}, {'X','Y'}, {'D','8'}, {'X','Q'}, {'N','\''}, {'D','0'},
+    {'C','H'}, {'N','-'}, {'C','F'}, {'K','3'}, {'C','L'}, {'?',0}, {'C','P'}, {'C','J'},
+    {';','I'}, {';','A'}, {'N',';'}, {'N','!'}, {'!','I'}, {'!','A'}, {'!','N'}, {'!','M'},
+    {'Y','H'}, {'(','U'}, {'(','R'}, {'N',','}, {')','I'}, {')','A'}, {')','N'}, {'(','O'},
+    {'N',':'}, {'Y','X'}, {'Y','C'}, {'Y','Y'}, {'Y','Z'}, {'Y','Q'}, {'K','9'}, {'K','0'},
+    {'7','S'}, {'7','U'}, {'7','R'}, {'7','W'}, {'7','D'}, {'7','K'}, {'7','G'}, {'7','O'},
+    {'G','&'}, {'Z','X'}, {'Z','C'}, {'Z','Y'}, {',','I'}, {',','A'}, {',','N'}, {',','M'},
+    {'Q','H'}, {'G','='}, {'M','"'}, {'?',0}, {'Q','L'}, {'M','.'}, {'G','('}, {'Q','J'},
+    {'G','7'}, {'Q','X'}, {'M','@'}, {'Q','Y'}, {'G','8'}, {'Q','Q'}, {'M','\''}, {'G','0'},
+    {'O','5'}, {'O','4'}, {':','N'}, {'O','3'}, {'8','D'}, {'8','K'}, {'8','G'}, {'O','2'},
+    {'O','&'}, {'?',0}, {'O','+'}, {'M','!'}, {'?',0}, {'M',')'}, {'?',0}, {'O','1'},
+    {'O','6'}, {'O','='}, {'O','/'}, {'M',','}, {'9','D'}, {'9','K'}, {'O','('}, {'9','O'},
+    {'O','7'}, {'0','U'}, {'0','R'}, {'0','W'}, {'O','8'}, {'0','K'}, {'O','9'}, {'O','0'},
+    {'H','5'}, {'H','4'}, {'5','F'}, {'H','3'}, {'5','L'}, {'?',0}, {'5','P'}, {'H','2'},
+    {'H','&'}, {'I','$'}, {'H','+'}, {'5','Y'}, {'5','Z'}, {'S','_'}, {'?',0}, {'H','1'},
+    {'H','6'}, {'H','='}, {'H','/'}, {'?',0}, {'4','L'}, {'S','.'}, {'H','('}, {'4','J'},
+    {'H','7'}, {'4','X'}, {'S','@'}, {'4','Y'}, {'H','8'}, {'4','Q'}, {'H','9'}, {'H','0'},
+    {'V','5'}, {'S','-'}, {'?',0}, {'V','3'}, {'$','I'}, {'$','A'}, {'$','N'}, {'$','M'},
+    {'V','&'}, {'?',0}, {'S',';'}, {'S','!'}, {'?',0}, {'S',')'}, {'?',0}, {'V','1'},
+    {'3','H'}, {'3','V'}, {'3','F'}, {'S',','}, {'3','L'}, {'?',0}, {'3','P'}, {'3','J'},
+    {'S',':'}, {'3','X'}, {'3','C'}, {'3','Y'}, {'V','8'}, {'3','Q'}, {'V','9'}, {'V','0'},
+    {'F','5'}, {'F','4'}, {'?',0}, {'F','3'}, {'?',0}, {'?',0}, {'?',0}, {'F','2'},
+    {'F','&'}, {'?',0}, {'F','+'}, {'?',0}, {'?',0}, {'U','_'}, {'?',0}, {'F','1'},
+    {'F','6'}, {'F','='}, {'U','"'}, {'?',0}, {'?',0}, {'U','.'}, {'F','('}, {'?',0},
+    {'F','7'}, {'?',0}, {'U','@'}, {'?',0}, {'F','8'}, {'?',0}, {'U','\''}, {'F','0'},
+    {'?',0}, {'U','-'}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'_','S'}, {'_','U'}, {'_','R'}, {'U','!'}, {'_','D'}, {'U',')'}, {'_','G'}, {'_','O'},
+    {'2','H'}, {'2','V'}, {'2','F'}, {'U',','}, {'2','L'}, {'?',0}, {'2','P'}, {'2','J'},
+    {'U',':'}, {'2','X'}, {'2','C'}, {'2','Y'}, {'2','Z'}, {'2','Q'}, {'?',0}, {'?',0},
+    {'&','H'}, {'L','4'}, {'&','F'}, {'L','3'}, {'&','L'}, {'?',0}, {'&','P'}, {'L','2'},
+    {'L','&'}, {'A','$'}, {'L','+'}, {'&','Y'}, {'&','Z'}, {'R','_'}, {'?',0}, {'L','1'},
+    {'"','S'}, {'L','='}, {'R','"'}, {'"','W'}, {'"','D'}, {'R','.'}, {'L','('}, {'"','O'},
+    {'L','7'}, {'?',0}, {'R','@'}, {'?',0}, {'L','8'}, {'?',0}, {'R','\''}, {'L','0'},
+    {'+','H'}, {'R','-'}, {'+','F'}, {'?',0}, {'+','L'}, {'?',0}, {'+','P'}, {'+','J'},
+    {'.','S'}, {'.','U'}, {'.','R'}, {'R','!'}, {'.','D'}, {'R',')'}, {'.','G'}, {'.','O'},
+    {'?',0}, {'?',0}, {'?',0}, {'R',','}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'R',':'}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'P','5'}, {'P','4'}, {'?',0}, {'P','3'}, {'?',0}, {'?',0}, {'?',0}, {'P','2'},
+    {'P','&'}, {'?',0}, {'P','+'}, {'?',0}, {'?',0}, {'W','_'}, {'?',0}, {'P','1'},
+    {'@','S'}, {'@','U'}, {'@','R'}, {'@','W'}, {'@','D'}, {'W','.'}, {'P','('}, {'@','O'},
+    {'P','7'}, {'?',0}, {'W','@'}, {'?',0}, {'P','8'}, {'?',0}, {'W','\''}, {'P','0'},
+    {'J','5'}, {'W','-'}, {'?',0}, {'J','3'}, {'?',0}, {'?',0}, {'?',0}, {'J','2'},
+    {'J','&'}, {'?',0}, {'W',';'}, {'W','!'}, {'?',0}, {'W',')'}, {'?',0}, {'J','1'},
+    {'1','H'}, {'\'','U'}, {'\'','R'}, {'W',','}, {'1','L'}, {'\'','K'}, {'1','P'}, {'\'','O'},
+    {'W',':'}, {'1','X'}, {'1','C'}, {'1','Y'}, {'J','8'}, {'1','Q'}, {'J','9'}, {'J','0'},
+    {'6','H'}, {'B','4'}, {'6','F'}, {'B','3'}, {'6','L'}, {'?',0}, {'6','P'}, {'B','2'},
+    {'-','S'}, {'N','$'}, {'-','R'}, {'6','Y'}, {'-','D'}, {'D','_'}, {'-','G'}, {'-','O'},
+    {'=','H'}, {'B','='}, {'D','"'}, {'?',0}, {'=','L'}, {'D','.'}, {'=','P'}, {'=','J'},
+    {'B','7'}, {'=','X'}, {'D','@'}, {'=','Y'}, {'B','8'}, {'=','Q'}, {'D','\''}, {'B','0'},
+    {'/','H'}, {'D','-'}, {'/','F'}, {'X','3'}, {'/','L'}, {'?',0}, {'/','P'}, {'X','2'},
+    {'/','B'}, {'/','X'}, {'D',';'}, {'D','!'}, {'/','Z'}, {'D',')'}, {'?',0}, {'X','1'},
+    {'X','6'}, {'X','='}, {'X','/'}, {'D',','}, {'?',0}, {'?',0}, {'X','('}, {'?',0},
+    {'D',':'}, {'?',0}, {'?',0}, {'?',0}, {'X','8'}, {'?',0}, {'X','9'}, {'X','0'},
+    {'C','5'}, {'C','4'}, {'?',0}, {'C','3'}, {'?',0}, {'?',0}, {'?',0}, {'C','2'},
+    {'C','&'}, {'?',0}, {'C','+'}, {'?',0}, {'?',0}, {'K','_'}, {'?',0}, {'C','1'},
+    {';','S'}, {';','U'}, {';','R'}, {';','W'}, {';','D'}, {'K','.'}, {'C','('}, {';','O'},
+    {'!','S'}, {'!','U'}, {'!','R'}, {'!','W'}, {'!','D'}, {'!','K'}, {'C','9'}, {'!','O'},
+    {'(','H'}, {'Y','4'}, {'(','F'}, {'Y','3'}, {'(','L'}, {'?',0}, {'(','P'}, {'Y','2'},
+    {')','S'}, {')','U'}, {')','R'}, {')','W'}, {')','D'}, {'K',')'}, {')','G'}, {')','O'},
+    {'Y','6'}, {'Y','='}, {'Y','/'}, {'K',','}, {'?',0}, {'?',0}, {'Y','('}, {'?',0},
+    {'Y','7'}, {'?',0}, {'?',0}, {'?',0}, {'Y','8'}, {'?',0}, {'Y','9'}, {'Y','0'},
+    {'7','H'}, {'7','V'}, {'7','F'}, {'Z','3'}, {'7','L'}, {'?',0}, {'7','P'}, {'7','J'},
+    {'7','B'}, {'M','$'}, {'7','C'}, {'7','Y'}, {'7','Z'}, {'G','_'}, {'?',0}, {'Z','1'},
+    {'Z','6'}, {'Z','='}, {'G','"'}, {'?',0}, {'?',0}, {'G','.'}, {'Z','('}, {'?',0},
+    {',','S'}, {',','U'}, {',','R'}, {',','W'}, {',','D'}, {',','K'}, {',','G'}, {',','O'},
+    {'Q','5'}, {'G','-'}, {'?',0}, {'Q','3'}, {'?',0}, {'?',0}, {'?',0}, {'Q','2'},
+    {'Q','&'}, {'?',0}, {'G',';'}, {'G','!'}, {'?',0}, {'G',')'}, {'?',0}, {'Q','1'},
+    {'Q','6'}, {'Q','='}, {'Q','/'}, {'G',','}, {'?',0}, {'?',0}, {'Q','('}, {'?',0},
+    {'G',':'}, {'?',0}, {'?',0}, {'?',0}, {'Q','8'}, {'?',0}, {'Q','9'}, {'Q','0'},
+    {'8','H'}, {':','U'}, {':','R'}, {':','W'}, {'8','L'}, {':','K'}, {'8','P'}, {':','O'},
+    {'8','B'}, {'8','X'}, {'8','C'}, {'8','Y'}, {'8','Z'}, {'O','_'}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'O','"'}, {'?',0}, {'?',0}, {'O','.'}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'O','@'}, {'?',0}, {'?',0}, {'?',0}, {'O','\''}, {'?',0},
+    {'9','H'}, {'O','-'}, {'9','F'}, {'?',0}, {'9','L'}, {'?',0}, {'9','P'}, {'9','J'},
+    {'9','B'}, {'9','X'}, {'O',';'}, {'O','!'}, {'9','Z'}, {'O',')'}, {'?',0}, {'?',0},
+    {'0','H'}, {'0','V'}, {'0','F'}, {'O',','}, {'0','L'}, {'?',0}, {'0','P'}, {'0','J'},
+    {'O',':'}, {'0','X'}, {'0','C'}, {'0','Y'}, {'0','Z'}, {'0','Q'}, {'?',0}, {'?',0},
+    {'5','5'}, {'5','4'}, {'?',0}, {'5','3'}, {'?',0}, {'?',0}, {'?',0}, {'5','2'},
+    {'5','&'}, {'S','$'}, {'5','+'}, {'?',0}, {'?',0}, {'H','_'}, {'?',0}, {'5','1'},
+    {'5','6'}, {'5','='}, {'H','"'}, {'?',0}, {'?',0}, {'H','.'}, {'5','('}, {'?',0},
+    {'5','7'}, {'?',0}, {'H','@'}, {'?',0}, {'5','8'}, {'?',0}, {'H','\''}, {'5','0'},
+    {'4','5'}, {'H','-'}, {'?',0}, {'4','3'}, {'?',0}, {'?',0}, {'?',0}, {'4','2'},
+    {'4','&'}, {'?',0}, {'H',';'}, {'H','!'}, {'?',0}, {'H',')'}, {'?',0}, {'4','1'},
+    {'4','6'}, {'4','='}, {'4','/'}, {'H',','}, {'?',0}, {'?',0}, {'4','('}, {'?',0},
+    {'H',':'}, {'?',0}, {'?',0}, {'?',0}, {'4','8'}, {'?',0}, {'4','9'}, {'4','0'},
+    {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'$','S'}, {'$','U'}, {'$','R'}, {'$','W'}, {'$','D'}, {'$','K'}, {'$','G'}, {'$','O'},
+    {'?',0}, {'?',0}, {'V','"'}, {'?',0}, {'?',0}, {'V','.'}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'V','@'}, {'?',0}, {'?',0}, {'?',0}, {'V','\''}, {'?',0},
+    {'3','5'}, {'3','4'}, {'?',0}, {'3','3'}, {'?',0}, {'?',0}, {'?',0}, {'3','2'},
+    {'3','&'}, {'?',0}, {'V',';'}, {'V','!'}, {'?',0}, {'V',')'}, {'?',0}, {'3','1'},
+    {'3','6'}, {'3','='}, {'3','/'}, {'V',','}, {'?',0}, {'?',0}, {'3','('}, {'?',0},
+    {'3','7'}, {'?',0}, {'?',0}, {'?',0}, {'3','8'}, {'?',0}, {'3','9'}, {'3','0'},
+    {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'U','$'}, {'?',0}, {'?',0}, {'?',0}, {'F','_'}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'F','"'}, {'?',0}, {'?',0}, {'F','.'}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'F','@'}, {'?',0}, {'?',0}, {'?',0}, {'F','\''}, {'?',0},
+    {'?',0}, {'F','-'}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'F',';'}, {'F','!'}, {'?',0}, {'F',')'}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'?',0}, {'F',','}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'F',':'}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'_','H'}, {'_','V'}, {'_','F'}, {'?',0}, {'_','L'}, {'?',0}, {'_','P'}, {'_','J'},
+    {'_','B'}, {'_','X'}, {'_','C'}, {'_','Y'}, {'_','Z'}, {'_','Q'}, {'?',0}, {'?',0},
+    {'2','5'}, {'2','4'}, {'?',0}, {'2','3'}, {'?',0}, {'?',0}, {'?',0}, {'2','2'},
+    {'2','&'}, {'?',0}, {'2','+'}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'2','1'},
+    {'2','6'}, {'2','='}, {'2','/'}, {'?',0}, {'?',0}, {'?',0}, {'2','('}, {'?',0},
+    {'2','7'}, {'?',0}, {'?',0}, {'?',0}, {'2','8'}, {'?',0}, {'2','9'}, {'2','0'},
+    {'&','5'}, {'&','4'}, {'?',0}, {'&','3'}, {'?',0}, {'?',0}, {'?',0}, {'&','2'},
+    {'&','&'}, {'R','$'}, {'&','+'}, {'?',0}, {'?',0}, {'L','_'}, {'?',0}, {'&','1'},
+    {'&','6'}, {'&','='}, {'L','"'}, {'?',0}, {'?',0}, {'L','.'}, {'&','('}, {'?',0},
+    {'&','7'}, {'?',0}, {'L','@'}, {'?',0}, {'&','8'}, {'?',0}, {'L','\''}, {'&','0'},
+    {'"','H'}, {'L','-'}, {'"','F'}, {'?',0}, {'"','L'}, {'?',0}, {'"','P'}, {'"','J'},
+    {'"','B'}, {'"','X'}, {'L',';'}, {'L','!'}, {'"','Z'}, {'L',')'}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'?',0}, {'L',','}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'L',':'}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'+','5'}, {'+','4'}, {'?',0}, {'+','3'}, {'?',0}, {'?',0}, {'?',0}, {'+','2'},
+    {'+','&'}, {'?',0}, {'+','+'}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'+','1'},
+    {'.','H'}, {'.','V'}, {'.','F'}, {'?',0}, {'.','L'}, {'?',0}, {'.','P'}, {'.','J'},
+    {'.','B'}, {'.','X'}, {'.','C'}, {'.','Y'}, {'+','8'}, {'.','Q'}, {'+','9'}, {'+','0'},
+    {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'W','$'}, {'?',0}, {'?',0}, {'?',0}, {'P','_'}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'P','"'}, {'?',0}, {'?',0}, {'P','.'}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'P','@'}, {'?',0}, {'?',0}, {'?',0}, {'P','\''}, {'?',0},
+    {'@','H'}, {'P','-'}, {'@','F'}, {'?',0}, {'@','L'}, {'?',0}, {'@','P'}, {'@','J'},
+    {'@','B'}, {'@','X'}, {'@','C'}, {'@','Y'}, {'@','Z'}, {'P',')'}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'?',0}, {'P',','}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'P',':'}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'J','_'}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'J','"'}, {'?',0}, {'?',0}, {'J','.'}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'J','@'}, {'?',0}, {'?',0}, {'?',0}, {'J','\''}, {'?',0},
+    {'\'','H'}, {'1','4'}, {'\'','F'}, {'1','3'}, {'\'','L'}, {'?',0}, {'\'','P'}, {'1','2'},
+    {'\'','B'}, {'\'','X'}, {'\'','C'}, {'\'','Y'}, {'\'','Z'}, {'J',')'}, {'?',0}, {'1','1'},
+    {'1','6'}, {'1','='}, {'1','/'}, {'J',','}, {'?',0}, {'?',0}, {'1','('}, {'?',0},
+    {'1','7'}, {'?',0}, {'?',0}, {'?',0}, {'1','8'}, {'?',0}, {'1','9'}, {'1','0'},
+    {'6','5'}, {'6','4'}, {'?',0}, {'6','3'}, {'?',0}, {'?',0}, {'?',0}, {'6','2'},
+    {'6','&'}, {'D','$'}, {'6','+'}, {'?',0}, {'?',0}, {'B','_'}, {'?',0}, {'6','1'},
+    {'-','H'}, {'-','V'}, {'-','F'}, {'?',0}, {'-','L'}, {'B','.'}, {'-','P'}, {'-','J'},
+    {'-','B'}, {'-','X'}, {'-','C'}, {'-','Y'}, {'6','8'}, {'-','Q'}, {'B','\''}, {'6','0'},
+    {'=','5'}, {'B','-'}, {'?',0}, {'=','3'}, {'?',0}, {'?',0}, {'?',0}, {'=','2'},
+    {'=','&'}, {'?',0}, {'B',';'}, {'B','!'}, {'?',0}, {'B',')'}, {'?',0}, {'=','1'},
+    {'=','6'}, {'=','='}, {'=','/'}, {'B',','}, {'?',0}, {'?',0}, {'=','('}, {'?',0},
+    {'B',':'}, {'?',0}, {'?',0}, {'?',0}, {'=','8'}, {'?',0}, {'=','9'}, {'=','0'},
+    {'/','5'}, {'/','4'}, {'?',0}, {'/','3'}, {'?',0}, {'?',0}, {'?',0}, {'/','2'},
+    {'/','&'}, {'?',0}, {'/','+'}, {'?',0}, {'?',0}, {'X','_'}, {'?',0}, {'/','1'},
+    {'/','6'}, {'/','='}, {'/','/'}, {'?',0}, {'?',0}, {'X','.'}, {'/','('}, {'?',0},
+    {'/','7'}, {'?',0}, {'X','@'}, {'?',0}, {'/','8'}, {'?',0}, {'/','9'}, {'/','0'},
+    {'?',0}, {'X','-'}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'X',';'}, {'X','!'}, {'?',0}, {'X',')'}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'?',0}, {'X',','}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'X',':'}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'K','$'}, {'?',0}, {'?',0}, {'?',0}, {'C','_'}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'C','"'}, {'?',0}, {'?',0}, {'C','.'}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'C','@'}, {'?',0}, {'?',0}, {'?',0}, {'C','\''}, {'?',0},
+    {';','H'}, {'C','-'}, {';','F'}, {'?',0}, {';','L'}, {'?',0}, {';','P'}, {';','J'},
+    {';','B'}, {';','X'}, {'C',';'}, {'C','!'}, {';','Z'}, {'C',')'}, {'?',0}, {'?',0},
+    {'!','H'}, {'!','V'}, {'!','F'}, {'C',','}, {'!','L'}, {'?',0}, {'!','P'}, {'!','J'},
+    {'C',':'}, {'!','X'}, {'!','C'}, {'!','Y'}, {'!','Z'}, {'!','Q'}, {'?',0}, {'?',0},
+    {'(','5'}, {'(','4'}, {'?',0}, {'(','3'}, {'?',0}, {'?',0}, {'?',0}, {'(','2'},
+    {'(','&'}, {'?',0}, {'(','+'}, {'?',0}, {'?',0}, {'Y','_'}, {'?',0}, {'(','1'},
+    {')','H'}, {')','V'}, {')','F'}, {'?',0}, {')','L'}, {'Y','.'}, {')','P'}, {')','J'},
+    {')','B'}, {')','X'}, {')','C'}, {')','Y'}, {'(','8'}, {')','Q'}, {'Y','\''}, {'(','0'},
+    {'?',0}, {'Y','-'}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'Y',';'}, {'Y','!'}, {'?',0}, {'Y',')'}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'?',0}, {'Y',','}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'Y',':'}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'7','5'}, {'7','4'}, {'?',0}, {'7','3'}, {'?',0}, {'?',0}, {'?',0}, {'7','2'},
+    {'7','&'}, {'G','$'}, {'7','+'}, {'?',0}, {'?',0}, {'Z','_'}, {'?',0}, {'7','1'},
+    {'7','6'}, {'7','='}, {'7','/'}, {'?',0}, {'?',0}, {'Z','.'}, {'7','('}, {'?',0},
+    {'7','7'}, {'?',0}, {'Z','@'}, {'?',0}, {'7','8'}, {'?',0}, {'7','9'}, {'7','0'},
+    {'?',0}, {'Z','-'}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'Z',';'}, {'Z','!'}, {'?',0}, {'Z',')'}, {'?',0}, {'?',0},
+    {',','H'}, {',','V'}, {',','F'}, {'Z',','}, {',','L'}, {'?',0}, {',','P'}, {',','J'},
+    {',','B'}, {',','X'}, {',','C'}, {',','Y'}, {',','Z'}, {',','Q'}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'Q','_'}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'Q','"'}, {'?',0}, {'?',0}, {'Q','.'}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'Q','@'}, {'?',0}, {'?',0}, {'?',0}, {'Q','\''}, {'?',0},
+    {'?',0}, {'Q','-'}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'Q',';'}, {'Q','!'}, {'?',0}, {'Q',')'}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'?',0}, {'Q',','}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'Q',':'}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {':','H'}, {'8','4'}, {':','F'}, {'8','3'}, {':','L'}, {'?',0}, {':','P'}, {'8','2'},
+    {':','B'}, {'O','$'}, {':','C'}, {':','Y'}, {':','Z'}, {':','Q'}, {'?',0}, {'8','1'},
+    {'8','6'}, {'8','='}, {'8','/'}, {'?',0}, {'?',0}, {'?',0}, {'8','('}, {'?',0},
+    {'8','7'}, {'?',0}, {'?',0}, {'?',0}, {'8','8'}, {'?',0}, {'8','9'}, {'8','0'},
+    {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'?',0},
+    {'9','5'}, {'9','4'}, {'?',0}, {'9','3'}, {'?',0}, {'?',0}, {'?',0}, {'9','2'},
+    {'9','&'}, {'?',0}, {'9','+'}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'9','1'},
+    {'9','6'}, {'9','='}, {'9','/'}, {'?',0}, {'?',0}, {'?',0}, {'9','('}, {'?',0},
+    {'9','7'}, {'?',0}, {'?',0}, {'?',0}, {'9','8'}, {'?',0}, {'9','9'}, {'9','0'},
+    {'0','5'}, {'0','4'}, {'?',0}, {'0','3'}, {'?',0}, {'?',0}, {'?',0}, {'0','2'},
+    {'0','&'}, {'?',0}, {'0','+'}, {'?',0}, {'?',0}, {'?',0}, {'?',0}, {'0','1'},
+    {'0','6'}, {'0','='}, {'0','/'}, {'?',0}, {'?',0}, {'?',0}, {'0','('}, {'?',0},
+    {'0','7'}, {'?',0}, {'?',0}, {'?',0}, {'0','8'}, {'?',0}, {'0','9'}, {'0','0'},
+};
+
+#endif /* MORSE_MERGED_TABLE_H */
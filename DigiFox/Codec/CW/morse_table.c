@@ -5,142 +5,150 @@
  */
 
 #include "morse_table.h"
+#include "morse_merged_table.h"
 #include <string.h>
 
 /* Morse table entry */
 typedef struct {
-    const char *pattern;
-    char        ch;
-    int         weight;
+    char ch;                  /* 0 = no character */
+    int  weight;
 } morse_entry_t;
 
-/* Sorted by pattern for binary search */
-static const morse_entry_t MORSE_TABLE[] = {
+/* Indexed by morse_code_t (leading 1 bit, then 1 = dah per element) */
+static const morse_entry_t MORSE_TABLE[MORSE_TABLE_SIZE] = {
     /* Single elements */
-    {".",       'E',  321},
-    {"-",       'T',  236},
+    [0x02] = {'E',  321},   /* .       */
+    [0x03] = {'T',  236},   /* -       */
     /* Two elements */
-    {"..",      'I',  115},
-    {".-",      'A',  127},
-    {"-.",      'N',  103},
-    {"--",      'M',   48},
+    [0x04] = {'I',  115},   /* ..      */
+    [0x05] = {'A',  127},   /* .-      */
+    [0x06] = {'N',  103},   /* -.      */
+    [0x07] = {'M',   48},   /* --      */
     /* Three elements */
-    {"...",     'S',  101},
-    {"..-",     'U',   48},
-    {".-.",     'R',   84},
-    {".--",     'W',   38},
-    {"-..",     'D',   68},
-    {"-.-",     'K',   17},
-    {"--.",     'G',   31},
-    {"---",     'O',  127},
+    [0x08] = {'S',  101},   /* ...     */
+    [0x09] = {'U',   48},   /* ..-     */
+    [0x0A] = {'R',   84},   /* .-.     */
+    [0x0B] = {'W',   38},   /* .--     */
+    [0x0C] = {'D',   68},   /* -..     */
+    [0x0D] = {'K',   17},   /* -.-     */
+    [0x0E] = {'G',   31},   /* --.     */
+    [0x0F] = {'O',  127},   /* ---     */
     /* Four elements */
-    {"....",    'H',  103},
-    {"...-",    'V',   16},
-    {"..-.",    'F',   37},
-    {".-..",    'L',   66},
-    {".--.",    'P',   31},
-    {".---",    'J',    3},
-    {"-...",    'B',   25},
-    {"-..-",    'X',    3},
-    {"-.-.",    'C',   44},
-    {"-.--",    'Y',   32},
-    {"--..",    'Z',    2},
-    {"--.-",    'Q',    2},
-    /* Five elements — digits (ITU-R M.1677) */
-    {".----",   '1',   10},
-    {"..---",   '2',   10},
-    {"...--",   '3',   10},
-    {"....-",   '4',   10},
-    {".....",   '5',   10},
-    {"-....",   '6',   10},
-    {"--...",   '7',   10},
-    {"---..",   '8',   10},
-    {"----.",   '9',   10},
-    {"-----",   '0',   10},
-    /* Punctuation */
-    {".-.-.-",  '.',    5},
-    {"--..--",  ',',    5},
-    {"..--..",  '?',    5},
-    {".----.",  '\'',   3},
-    {"-.-.--",  '!',    3},
-    {"-..-.",   '/',    5},
-    {"-.--.",   '(',    3},
-    {"-.--.-",  ')',    3},
-    {".-...",   '&',    3},
-    {"---...",  ':',    3},
-    {"-.-.-.",  ';',    3},
-    {"-...-",   '=',    5},
-    {".-.-.",   '+',    3},
-    {"-....-",  '-',    3},
-    {"..--.-",  '_',    3},
-    {".-..-.",  '"',    3},
-    {"...-..-", '$',    3},
-    {".--.-.",  '@',    3},
+    [0x10] = {'H',  103},   /* ....    */
+    [0x11] = {'V',   16},   /* ...-    */
+    [0x12] = {'F',   37},   /* ..-.    */
+    [0x14] = {'L',   66},   /* .-..    */
+    [0x16] = {'P',   31},   /* .--.    */
+    [0x17] = {'J',    3},   /* .---    */
+    [0x18] = {'B',   25},   /* -...    */
+    [0x19] = {'X',    3},   /* -..-    */
+    [0x1A] = {'C',   44},   /* -.-.    */
+    [0x1B] = {'Y',   32},   /* -.--    */
+    [0x1C] = {'Z',    2},   /* --..    */
+    [0x1D] = {'Q',    2},   /* --.-    */
+    /* Five elements */
+    [0x20] = {'5',   10},   /* .....   */
+    [0x21] = {'4',   10},   /* ....-   */
+    [0x23] = {'3',   10},   /* ...--   */
+    [0x27] = {'2',   10},   /* ..---   */
+    [0x28] = {'&',    3},   /* .-...   */
+    [0x2A] = {'+',    3},   /* .-.-.   */
+    [0x2F] = {'1',   10},   /* .----   */
+    [0x30] = {'6',   10},   /* -....   */
+    [0x31] = {'=',    5},   /* -...-   */
+    [0x32] = {'/',    5},   /* -..-.   */
+    [0x36] = {'(',    3},   /* -.--.   */
+    [0x38] = {'7',   10},   /* --...   */
+    [0x3C] = {'8',   10},   /* ---..   */
+    [0x3E] = {'9',   10},   /* ----.   */
+    [0x3F] = {'0',   10},   /* -----   */
+    /* Six elements */
+    [0x4C] = {'?',    5},   /* ..--..  */
+    [0x4D] = {'_',    3},   /* ..--.-  */
+    [0x52] = {'"',    3},   /* .-..-.  */
+    [0x55] = {'.',    5},   /* .-.-.-  */
+    [0x5A] = {'@',    3},   /* .--.-.  */
+    [0x5E] = {'\'',   3},   /* .----.  */
+    [0x61] = {'-',    3},   /* -....-  */
+    [0x6A] = {';',    3},   /* -.-.-.  */
+    [0x6B] = {'!',    3},   /* -.-.--  */
+    [0x6D] = {')',    3},   /* -.--.-  */
+    [0x73] = {',',    5},   /* --..--  */
+    [0x78] = {':',    3},   /* ---...  */
+    /* Seven elements */
+    [0x89] = {'$',    3},   /* ...-..- */
 };
 
-#define TABLE_SIZE (sizeof(MORSE_TABLE) / sizeof(MORSE_TABLE[0]))
+/* ------------------------------------------------------------------ */
+/* Binary patterns                                                     */
+/* ------------------------------------------------------------------ */
 
-char morse_lookup(const char *pattern)
+int morse_code_length(morse_code_t code)
 {
-    if (!pattern || !pattern[0]) return '?';
-
-    for (int i = 0; i < (int)TABLE_SIZE; i++) {
-        if (strcmp(MORSE_TABLE[i].pattern, pattern) == 0) {
-            return MORSE_TABLE[i].ch;
-        }
+    int len = -1;
+    while (code) {
+        code >>= 1;
+        len++;
     }
-    return '?';
+    return len;
 }
 
-int morse_char_weight(char ch)
+morse_code_t morse_encode(const char *pattern)
 {
-    for (int i = 0; i < (int)TABLE_SIZE; i++) {
-        if (MORSE_TABLE[i].ch == ch) {
-            return MORSE_TABLE[i].weight;
-        }
+    if (!pattern) return 0;
+    morse_code_t code = MORSE_CODE_EMPTY;
+    for (const char *p = pattern; *p; p++) {
+        if ((*p != '.' && *p != '-') || p - pattern >= MORSE_CODE_MAX_LEN) return 0;
+        code = morse_code_push(code, *p == '-');
     }
-    return 1;
+    return code;
 }
 
-int morse_lookup_merged(const char *pattern, char *out, int out_len)
+char morse_lookup_code(morse_code_t code)
 {
-    if (!pattern || !pattern[0] || out_len < 1) return 0;
+    if (code < MORSE_TABLE_SIZE && MORSE_TABLE[code].ch) return MORSE_TABLE[code].ch;
+    return '?';
+}
 
+/* Direct lookup, then the best two-character split */
+static int merged_search(morse_code_t code, char *out, int out_len)
+{
     /* Direct lookup */
-    char direct = morse_lookup(pattern);
+    char direct = morse_lookup_code(code);
     if (direct != '?') {
         out[0] = direct;
         return 1;
     }
 
-    int len = (int)strlen(pattern);
+    int len = morse_code_length(code);
     if (len <= 1) {
         out[0] = '?';
         return 1;
     }
 
-    /* Split-and-retry: try all split positions */
+    /*
+     * Split-and-retry: try all split positions. Both halves must be
+     * table entries (<= 7 elements), so only splits near the middle of
+     * a long pattern can match.
+     */
     int best_weight = -1;
     char best_left = 0, best_right = 0;
-
-    char left_buf[16], right_buf[16];
-
-    for (int pos = 1; pos < len && pos < 15; pos++) {
-        /* Split pattern at pos */
-        memcpy(left_buf, pattern, pos);
-        left_buf[pos] = '\0';
-        memcpy(right_buf, pattern + pos, len - pos);
-        right_buf[len - pos] = '\0';
-
-        char lch = morse_lookup(left_buf);
-        char rch = morse_lookup(right_buf);
-
-        if (lch != '?' && rch != '?') {
-            int w = morse_char_weight(lch) + morse_char_weight(rch);
+    unsigned bits = code & ((1u << len) - 1u);
+
+    for (int pos = 1; pos < len; pos++) {
+        unsigned left = (1u << pos) | (bits >> (len - pos));
+        unsigned right = (1u << (len - pos)) | (bits & ((1u << (len - pos)) - 1u));
+        if (left >= MORSE_TABLE_SIZE || right >= MORSE_TABLE_SIZE) continue;
+
+        /* '?' itself reads as "not found", as in direct lookup */
+        const morse_entry_t *l = &MORSE_TABLE[left];
+        const morse_entry_t *r = &MORSE_TABLE[right];
+        if (l->ch && l->ch != '?' && r->ch && r->ch != '?') {
+            int w = l->weight + r->weight;
             if (w > best_weight) {
                 best_weight = w;
-                best_left = lch;
-                best_right = rch;
+                best_left = l->ch;
+                best_right = r->ch;
             }
         }
     }
@@ -154,3 +162,53 @@ int morse_lookup_merged(const char *pattern, char *out, int out_len)
     out[0] = '?';
     return 1;
 }
+
+int morse_lookup_merged_code(morse_code_t code, char *out, int out_len)
+{
+    if (code <= MORSE_CODE_EMPTY || out_len < 1) return 0;
+
+    /* Up to MORSE_MERGED_MAX_LEN elements: precomputed */
+    if (code < MORSE_MERGED_SIZE) {
+        const char *m = MORSE_MERGED[code];
+        if (m[1] && out_len >= 2) {
+            out[0] = m[0];
+            out[1] = m[1];
+            return 2;
+        }
+        out[0] = m[1] ? '?' : m[0];
+        return 1;
+    }
+    return merged_search(code, out, out_len);
+}
+
+/* ------------------------------------------------------------------ */
+/* String patterns                                                     */
+/* ------------------------------------------------------------------ */
+
+char morse_lookup(const char *pattern)
+{
+    if (!pattern || !pattern[0]) return '?';
+    return morse_lookup_code(morse_encode(pattern));
+}
+
+int morse_char_weight(char ch)
+{
+    for (int i = 0; i < MORSE_TABLE_SIZE; i++) {
+        if (MORSE_TABLE[i].ch && MORSE_TABLE[i].ch == ch) {
+            return MORSE_TABLE[i].weight;
+        }
+    }
+    return 1;
+}
+
+int morse_lookup_merged(const char *pattern, char *out, int out_len)
+{
+    if (!pattern || !pattern[0] || out_len < 1) return 0;
+
+    morse_code_t code = morse_encode(pattern);
+    if (!code) {
+        out[0] = '?';
+        return 1;
+    }
+    return morse_lookup_merged_code(code, out, out_len);
+}
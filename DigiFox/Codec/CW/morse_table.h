@@ -1,10 +1,55 @@
 /**
  * morse_table.h — Morse code lookup + error-tolerant merged lookup
+ *
+ * Patterns are held as morse_code_t: a leading 1 bit followed by one bit
+ * per element, first element most significant, 1 = dah (".-" = 0b101).
+ * Every character (at most 7 elements) is then a direct index into a
+ * 256-entry table, and a split of a pattern is two shifts and a mask.
  */
 
 #ifndef MORSE_TABLE_H
 #define MORSE_TABLE_H
 
+#include <stdint.h>
+
+typedef uint16_t morse_code_t;
+
+#define MORSE_CODE_EMPTY    1     /* No elements yet */
+#define MORSE_CODE_MAX_LEN  15    /* Elements that fit a morse_code_t */
+#define MORSE_TABLE_SIZE    256   /* Codes of up to 7 elements */
+
+/**
+ * Append one element (dah != 0 for a dah) to a pattern.
+ */
+static inline morse_code_t morse_code_push(morse_code_t code, int dah)
+{
+    return (morse_code_t)((code << 1) | (dah != 0));
+}
+
+/**
+ * Number of elements in a pattern.
+ */
+int morse_code_length(morse_code_t code);
+
+/**
+ * Encode a string pattern (e.g. ".-").
+ * Returns 0 for characters other than '.' / '-' or more than
+ * MORSE_CODE_MAX_LEN elements.
+ */
+morse_code_t morse_encode(const char *pattern);
+
+/**
+ * Look up a binary pattern. Returns the character, or '?' if not found.
+ */
+char morse_lookup_code(morse_code_t code);
+
+/**
+ * Error-tolerant lookup of a binary pattern (see morse_lookup_merged()).
+ *
+ * @return Number of characters written (0 for an empty pattern)
+ */
+int morse_lookup_merged_code(morse_code_t code, char *out, int out_len);
+
 /**
  * Look up a Morse pattern (e.g. ".-" → "A").
  * Returns the character, or '?' if not found.
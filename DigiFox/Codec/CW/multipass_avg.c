@@ -3,100 +3,219 @@
  */
 
 #include "multipass_avg.h"
+#include <stdlib.h>
 #include <string.h>
 
-void multipass_init(multipass_avg_t *mp, int n_passes, int window_size)
+/* Clamp the settings and size the ring; hist is left to the caller */
+static void multipass_setup(multipass_avg_t *mp, int n_passes, int window_size)
 {
     memset(mp, 0, sizeof(*mp));
     if (n_passes < 1) n_passes = 1;
     if (n_passes > MULTIPASS_MAX_PASSES) n_passes = MULTIPASS_MAX_PASSES;
     if (window_size < 3) window_size = 3;
     if (window_size > MULTIPASS_MAX_WINDOW) window_size = MULTIPASS_MAX_WINDOW;
-    if (window_size % 2 == 0) window_size++;  /* Must be odd */
+    if (window_size % 2 == 0) window_size--;  /* Must be odd, stay in bounds */
 
     mp->n_passes = n_passes;
     mp->window_size = window_size;
+    mp->stride = (n_passes <= 4) ? 4 : 8;
+}
+
+int multipass_init(multipass_avg_t *mp, int n_passes, int window_size)
+{
+    multipass_setup(mp, n_passes, window_size);
+    mp->hist = (float *)calloc((size_t)mp->window_size * mp->stride, sizeof(float));
+    mp->owns_hist = 1;
+    return mp->hist ? 0 : -1;
+}
+
+size_t multipass_mem_size(int n_passes, int window_size)
+{
+    multipass_avg_t mp;
+    multipass_setup(&mp, n_passes, window_size);
+    return (size_t)mp.window_size * mp.stride * sizeof(float);
+}
+
+void multipass_init_in(multipass_avg_t *mp, int n_passes, int window_size, void *mem)
+{
+    multipass_setup(mp, n_passes, window_size);
+    mp->hist = (float *)mem;
+    memset(mp->hist, 0, (size_t)mp->window_size * mp->stride * sizeof(float));
+}
+
+void multipass_free(multipass_avg_t *mp)
+{
+    if (mp->owns_hist) free(mp->hist);
+    mp->hist = NULL;
+    mp->owns_hist = 0;
+}
+
+void multipass_prime(multipass_avg_t *mp, float first)
+{
+    if (mp->primed) return;
+    mp->primed = 1;
+
+    /* Cold start: sum = first * (w - 1), window filled with its mean */
+    int w = mp->window_size;
+    float fill = first * (float)(w - 1) / (float)w;
+    for (int k = 0; k < w; k++) {
+        for (int p = 0; p < mp->n_passes; p++) {
+            mp->hist[k * mp->stride + p] = fill;
+        }
+    }
+    for (int p = 0; p < mp->n_passes; p++) {
+        mp->running_sum[p] = first * (float)(w - 1);
+    }
 }
 
 void multipass_process(multipass_avg_t *mp, float *data, int n)
 {
     int w = mp->window_size;
+    int passes = mp->n_passes;
+    int stride = mp->stride;
     float inv_w = 1.0f / (float)w;
+    float sum[MULTIPASS_MAX_PASSES];
 
-    for (int pass = 0; pass < mp->n_passes; pass++) {
-        float *buf = mp->buffers[pass];
-        int buf_n = mp->buf_len[pass];
+    if (n <= 0) return;
+    multipass_prime(mp, data[0]);
 
-        /* Process each sample as a moving average using a sliding window.
-         * We prepend the buffer from the previous chunk to handle boundaries. */
+    for (int p = 0; p < passes; p++) sum[p] = mp->running_sum[p];
 
-        /* Running sum approach: maintain sum of last w samples */
-        float sum = mp->running_sum[pass];
-
-        /* If buffer is not yet full, we need to initialize the sum */
-        if (buf_n == 0 && n > 0) {
-            /* Cold start: fill with first sample */
-            sum = data[0] * (float)(w - 1);
+    /* One sweep: each sample runs through every pass before the next */
+    int row0 = mp->pos;
+    for (int i = 0; i < n; i++) {
+        float x = data[i];
+        int row = row0;
+        for (int p = 0; p < passes; p++) {
+            /* Running sum: add new sample, drop the one leaving the window */
+            float *old = &mp->hist[row * stride + p];
+            sum[p] += x - *old;
+            x = sum[p] * inv_w;
+            *old = x;
+            if (++row == w) row = 0;
         }
+        data[i] = x;
+        if (++row0 == w) row0 = 0;
+    }
 
-        for (int i = 0; i < n; i++) {
-            /* Add new sample to window */
-            sum += data[i];
-
-            /* Remove oldest sample from window */
-            int oldest_idx = i - w;
-            if (oldest_idx >= 0) {
-                sum -= data[oldest_idx];
-            } else {
-                /* Oldest is in the buffer from previous chunk */
-                int buf_idx = buf_n + oldest_idx;
-                if (buf_idx >= 0 && buf_idx < buf_n) {
-                    sum -= buf[buf_idx];
-                } else {
-                    /* Buffer not long enough — use first available value */
-                    sum -= data[0];
-                }
-            }
+    for (int p = 0; p < passes; p++) mp->running_sum[p] = sum[p];
+    mp->pos = row0;
+}
 
-            data[i] = sum * inv_w;
+void multipass_wave_steps(multipass_avg_t *mp, float *y, float *data, int n,
+                          int t_begin, int t_end)
+{
+    int w = mp->window_size;
+    int last = mp->n_passes - 1;
+    float inv_w = 1.0f / (float)w;
+
+    for (int t = t_begin; t < t_end; t++) {
+        float *h = mp->hist + ((mp->pos + t) % w) * mp->stride;
+
+        /* Descending: pass p consumes pass p-1's output from step t-1 */
+        for (int p = last; p >= 0; p--) {
+            int i = t - p;
+            if (i < 0 || i >= n) continue;
+
+            float x = (p == 0) ? data[t] : y[p - 1];
+            mp->running_sum[p] += x - h[p];
+            y[p] = mp->running_sum[p] * inv_w;
+            h[p] = y[p];
+            if (p == last) data[i] = y[p];
         }
+    }
+}
 
-        /* Save last (w-1) samples as buffer for next chunk */
-        int save_n = w - 1;
-        if (save_n > n) save_n = n;
-        if (save_n > MULTIPASS_MAX_WINDOW) save_n = MULTIPASS_MAX_WINDOW;
+void multipass_reset(multipass_avg_t *mp)
+{
+    memset(mp->hist, 0, (size_t)mp->window_size * mp->stride * sizeof(float));
+    memset(mp->running_sum, 0, sizeof(mp->running_sum));
+    mp->primed = 0;
+    mp->pos = 0;
+}
 
-        if (n >= w - 1) {
-            /* Copy from data */
-            for (int j = 0; j < save_n; j++) {
-                buf[j] = data[n - save_n + j];
-            }
-            mp->buf_len[pass] = save_n;
-        } else {
-            /* Shift old buffer and append new data */
-            int keep = buf_n - n;
-            if (keep < 0) keep = 0;
-            if (keep > 0) {
-                for (int j = 0; j < keep; j++) {
-                    buf[j] = buf[buf_n - keep + j];
-                }
-            }
-            for (int j = 0; j < n && keep + j < MULTIPASS_MAX_WINDOW; j++) {
-                buf[keep + j] = data[j];
+/* ------------------------------------------------------------------ */
+/* Multi-channel variant                                               */
+/* ------------------------------------------------------------------ */
+
+int multipass_lanes_init(multipass_lanes_t *mp, int n_passes, int window_size,
+                         int width)
+{
+    memset(mp, 0, sizeof(*mp));
+    if (n_passes < 1) n_passes = 1;
+    if (n_passes > MULTIPASS_MAX_PASSES) n_passes = MULTIPASS_MAX_PASSES;
+    if (window_size < 3) window_size = 3;
+    if (window_size > MULTIPASS_MAX_WINDOW) window_size = MULTIPASS_MAX_WINDOW;
+    if (window_size % 2 == 0) window_size--;  /* Must be odd, stay in bounds */
+    if (width < 1) width = 1;
+    if (width > MULTIPASS_MAX_LANES) width = MULTIPASS_MAX_LANES;
+
+    mp->n_passes = n_passes;
+    mp->window_size = window_size;
+    mp->width = width;
+    mp->hist = (float *)calloc((size_t)window_size * n_passes * width, sizeof(float));
+    return mp->hist ? 0 : -1;
+}
+
+void multipass_lanes_free(multipass_lanes_t *mp)
+{
+    free(mp->hist);
+    mp->hist = NULL;
+}
+
+void multipass_lanes_prime(multipass_lanes_t *mp, const float *first)
+{
+    if (mp->primed) return;
+    mp->primed = 1;
+
+    /* Cold start as in multipass_process(): sum = first * (w - 1) */
+    int w = mp->window_size;
+    for (int pass = 0; pass < mp->n_passes; pass++) {
+        for (int k = 0; k < w; k++) {
+            float *h = multipass_lanes_hist(mp, k, pass);
+            for (int l = 0; l < mp->width; l++) {
+                h[l] = first[l] * (float)(w - 1) / (float)w;
             }
-            mp->buf_len[pass] = keep + n;
-            if (mp->buf_len[pass] > save_n) mp->buf_len[pass] = save_n;
         }
-
-        mp->running_sum[pass] = sum;
+        for (int l = 0; l < mp->width; l++) {
+            mp->running_sum[pass][l] = first[l] * (float)(w - 1);
+        }
     }
 }
 
-void multipass_reset(multipass_avg_t *mp)
+void multipass_lanes_process_scalar(multipass_lanes_t *mp, float *data, int n)
 {
-    for (int i = 0; i < mp->n_passes; i++) {
-        memset(mp->buffers[i], 0, sizeof(mp->buffers[i]));
-        mp->buf_len[i] = 0;
-        mp->running_sum[i] = 0.0f;
+    int w = mp->window_size;
+    int lanes = mp->width;
+    int passes = mp->n_passes;
+    float inv_w = 1.0f / (float)w;
+
+    if (n <= 0) return;
+    multipass_lanes_prime(mp, data);
+
+    /* One sweep: each sample runs through every pass before the next */
+    int pos = mp->pos;
+    for (int i = 0; i < n; i++) {
+        float *x = data + i * lanes;
+        for (int pass = 0; pass < passes; pass++) {
+            float *sum = mp->running_sum[pass];
+            float *old = multipass_lanes_hist(mp, pos, pass);
+            for (int l = 0; l < lanes; l++) {
+                sum[l] += x[l] - old[l];
+                x[l] = sum[l] * inv_w;
+                old[l] = x[l];
+            }
+        }
+        if (++pos == w) pos = 0;
     }
+    mp->pos = pos;
+}
+
+void multipass_lanes_reset(multipass_lanes_t *mp)
+{
+    memset(mp->hist, 0,
+           (size_t)mp->window_size * mp->n_passes * mp->width * sizeof(float));
+    memset(mp->running_sum, 0, sizeof(mp->running_sum));
+    mp->primed = 0;
+    mp->pos = 0;
 }
@@ -3,30 +3,67 @@
  *
  * N passes of M-point moving average approximates a Gaussian filter.
  * Ring buffer per pass to handle chunk boundaries.
+ *
+ * Each pass works in-place, so the value leaving the window is the pass
+ * output from window_size samples earlier (recursive running sum). A
+ * rounding error in a running sum is fed back with weight -1/window and
+ * dies out, so the sums need no periodic renormalization.
+ *
+ * All passes run in one sweep over the data (one sample through every
+ * pass before the next), and the history is allocated for the configured
+ * window in multipass_init().
  */
 
 #ifndef MULTIPASS_AVG_H
 #define MULTIPASS_AVG_H
 
+#include <stddef.h>
+
 #define MULTIPASS_MAX_PASSES  8
 #define MULTIPASS_MAX_WINDOW  256
 
 typedef struct {
     int n_passes;
     int window_size;
+    int stride;               /* Floats per ring row: 4 (<= 4 passes) or 8 */
+    int primed;               /* History seeded from first sample */
+    int pos;                  /* Samples processed, mod window_size */
 
-    /* Per-pass ring buffer (stores last window_size-1 samples) */
-    float buffers[MULTIPASS_MAX_PASSES][MULTIPASS_MAX_WINDOW];
-    int   buf_len[MULTIPASS_MAX_PASSES];  /* How many valid samples in buffer */
+    /*
+     * Ring buffer shared by all passes, window_size rows of stride floats:
+     * pass p's value for sample i is stored at row (i + p) % window_size,
+     * column p. The skew lets the SIMD kernels run passes as a wavefront
+     * (pass p one sample behind p-1) while touching a single row per step;
+     * the row is padded to a full vector.
+     */
+    float *hist;
+    int owns_hist;            /* Allocated by multipass_init() */
 
     /* Running sum per pass (for O(1) moving average) */
     float running_sum[MULTIPASS_MAX_PASSES];
 } multipass_avg_t;
 
 /**
- * Initialize multipass average filter.
+ * Initialize multipass average filter and allocate its history.
+ * @return 0 on success, -1 on allocation failure
+ */
+int multipass_init(multipass_avg_t *mp, int n_passes, int window_size);
+
+/**
+ * Bytes of history for n_passes and window_size (multipass_init_in()).
+ */
+size_t multipass_mem_size(int n_passes, int window_size);
+
+/**
+ * Initialize with the history in caller memory: multipass_mem_size()
+ * bytes at mem, float-aligned, kept until the filter is done with.
+ */
+void multipass_init_in(multipass_avg_t *mp, int n_passes, int window_size, void *mem);
+
+/**
+ * Free filter history (if multipass_init() allocated it).
  */
-void multipass_init(multipass_avg_t *mp, int n_passes, int window_size);
+void multipass_free(multipass_avg_t *mp);
 
 /**
  * Process samples in-place through cascaded moving average.
@@ -38,4 +75,75 @@ void multipass_process(multipass_avg_t *mp, float *data, int n);
  */
 void multipass_reset(multipass_avg_t *mp);
 
+/**
+ * Seed history with the first sample if not yet primed.
+ */
+void multipass_prime(multipass_avg_t *mp, float first);
+
+/**
+ * Masked scalar wavefront steps t_begin .. t_end-1 (ramp-up / drain) for
+ * the SIMD kernels. Pass p at step t handles sample t - p; y holds the
+ * last output per pass.
+ */
+void multipass_wave_steps(multipass_avg_t *mp, float *y, float *data, int n,
+                          int t_begin, int t_end);
+
+/* ------------------------------------------------------------------ */
+/* Multi-channel (struct-of-arrays) variant                            */
+/* ------------------------------------------------------------------ */
+
+#define MULTIPASS_MAX_LANES 8
+
+/*
+ * Same window and pass count for every lane. History is kept as
+ * hist[tap][pass][lane] (window_size * n_passes * width floats) so one
+ * vector load covers all lanes and one sample step touches one
+ * contiguous row; data is interleaved as data[i * width + lane].
+ *
+ * Same recursion and cold start as multipass_process().
+ */
+typedef struct {
+    int n_passes;
+    int window_size;
+    int width;                /* Lane stride: 4 or 8 */
+    int primed;               /* History seeded from first sample */
+    int pos;                  /* Ring position (shared by all lanes) */
+
+    float *hist;
+    float running_sum[MULTIPASS_MAX_PASSES][MULTIPASS_MAX_LANES];
+} multipass_lanes_t;
+
+/* Lane history for one pass at ring position pos */
+static inline float *multipass_lanes_hist(const multipass_lanes_t *mp, int pos, int pass)
+{
+    return mp->hist + ((size_t)pos * mp->n_passes + pass) * mp->width;
+}
+
+/**
+ * Initialize lane-parallel multipass filter and allocate its history.
+ * @return 0 on success, -1 on allocation failure
+ */
+int multipass_lanes_init(multipass_lanes_t *mp, int n_passes, int window_size,
+                         int width);
+
+/**
+ * Free lane filter history.
+ */
+void multipass_lanes_free(multipass_lanes_t *mp);
+
+/**
+ * Seed history with the first interleaved sample if not yet primed.
+ */
+void multipass_lanes_prime(multipass_lanes_t *mp, const float *first);
+
+/**
+ * Process interleaved samples in-place (portable kernel).
+ */
+void multipass_lanes_process_scalar(multipass_lanes_t *mp, float *data, int n);
+
+/**
+ * Reset lane filter state.
+ */
+void multipass_lanes_reset(multipass_lanes_t *mp);
+
 #endif /* MULTIPASS_AVG_H */
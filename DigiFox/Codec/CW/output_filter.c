@@ -20,6 +20,15 @@ void output_filter_init(output_filter_t *f, int min_word_length)
     f->min_word_length = min_word_length;
 }
 
+/* The held word's stamps, for the n characters just written */
+static void stamp_word(output_filter_t *f, int n)
+{
+    if (f->stamps_out) {
+        memcpy(f->stamps_out, f->word_stamp, (size_t)n * sizeof(int64_t));
+        f->stamps_out += n;
+    }
+}
+
 static int emit_word(output_filter_t *f, char *out, int out_len)
 {
     if (f->word_len == 0) return 0;
@@ -29,6 +38,7 @@ static int emit_word(output_filter_t *f, char *out, int out_len)
         int n = f->word_len;
         if (n > out_len) n = out_len;
         memcpy(out, f->word_buf, n);
+        stamp_word(f, n);
         return n;
     }
 
@@ -49,6 +59,7 @@ static int emit_word(output_filter_t *f, char *out, int out_len)
     int n = f->word_len;
     if (n > out_len) n = out_len;
     memcpy(out, f->word_buf, n);
+    stamp_word(f, n);
     return n;
 }
 
@@ -65,12 +76,14 @@ int output_filter_feed(output_filter_t *f, const char *text, int text_len,
             if (n > 0) {
                 written += n;
                 if (written < out_len) {
+                    if (f->stamps_out) *f->stamps_out++ = f->stamp;
                     out[written++] = ' ';
                 }
             }
             f->word_len = 0;
         } else {
             if (f->word_len < OUTPUT_FILTER_MAX_WORD - 1) {
+                f->word_stamp[f->word_len] = f->stamp;
                 f->word_buf[f->word_len++] = ch;
             }
         }
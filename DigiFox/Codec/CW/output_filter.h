@@ -3,6 +3,10 @@
  *
  * Suppresses startup noise (short words of E,T,I,A,N,M) until
  * first valid word passes, then permanently disables filtering.
+ *
+ * Each character keeps the stamp it was fed with while its word is
+ * held, so an event caller can place it where it was decoded rather
+ * than where the word ended.
  */
 
 #ifndef OUTPUT_FILTER_H
@@ -10,11 +14,19 @@
 
 #define OUTPUT_FILTER_MAX_WORD 64
 
+#include <stdint.h>
+
 typedef struct {
     char word_buf[OUTPUT_FILTER_MAX_WORD];
     int  word_len;
     int  warmed_up;
     int  min_word_length;
+
+    /* Stamp given to characters fed now, theirs while held, and a cursor
+     * the stamp of each character written is stored at (NULL: not wanted) */
+    int64_t stamp;
+    int64_t word_stamp[OUTPUT_FILTER_MAX_WORD];
+    int64_t *stamps_out;
 } output_filter_t;
 
 /**
@@ -0,0 +1,176 @@
+/**
+ * polyphase_resampler.c — One filter per output phase, history carried
+ */
+
+#include "polyphase_resampler.h"
+#include "decimator.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* Inputs per pass through the work buffer */
+#define POLYPHASE_BLOCK  1024
+
+/* Stopband ~70 dB */
+#define POLYPHASE_KAISER_BETA  7.0
+
+/* Cutoff as a fraction of the lower Nyquist rate */
+#define POLYPHASE_CUTOFF  0.9
+
+struct polyphase_resampler_t {
+    int L, M;
+    int half;                  /* half_taps */
+    int n_taps;                /* 2 · half */
+    float *phases;             /* L · n_taps */
+
+    /* n_taps of history, then the block being resampled */
+    float *buf;
+    int    next;               /* Input in buf at or before the next output */
+    int    phase;              /* Next output's offset past it, in 1/L */
+};
+
+/* Zeroth-order modified Bessel function, for the Kaiser window */
+static double bessel_i0(double x)
+{
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 50; k++) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+        if (term < 1e-12 * sum) break;
+    }
+    return sum;
+}
+
+/* Filter of phase p: tap i weighs input next - half + 1 + i */
+static void make_phase(float *h, int p, int L, int half, double cutoff)
+{
+    const int n_taps = 2 * half;
+    const double offset = (double)p / L;
+    const double norm = bessel_i0(POLYPHASE_KAISER_BETA);
+
+    double sum = 0.0;
+    for (int i = 0; i < n_taps; i++) {
+        double x = offset + half - 1 - i;
+        double v = 0.0;
+        if (fabs(x) < half) {
+            double arg = M_PI * cutoff * x;
+            double r = x / half;
+            v = arg == 0.0 ? 1.0 : sin(arg) / arg;
+            v *= bessel_i0(POLYPHASE_KAISER_BETA * sqrt(1.0 - r * r)) / norm;
+        }
+        h[i] = (float)v;
+        sum += v;
+    }
+    for (int i = 0; i < n_taps; i++) h[i] = (float)(h[i] / sum);
+}
+
+polyphase_resampler_t *polyphase_resampler_create(double in_rate, double out_rate,
+                                                  int half_taps)
+{
+    if (!(in_rate > 0.0) || !(out_rate > 0.0)) return NULL;
+
+    /* Smallest L with in_rate · L / out_rate a whole M */
+    int L = 0;
+    long M = 0;
+    for (int l = 1; l <= POLYPHASE_MAX_PHASES; l++) {
+        double m = in_rate * l / out_rate;
+        long mi = lround(m);
+        if (mi > 0 && fabs(m - (double)mi) < 1e-6 * (double)mi) {
+            L = l;
+            M = mi;
+            break;
+        }
+    }
+    if (L == 0 || M > 0x7fffffffL) return NULL;
+
+    if (half_taps <= 0) half_taps = POLYPHASE_HALF_TAPS;
+    if (half_taps > POLYPHASE_MAX_HALF_TAPS) half_taps = POLYPHASE_MAX_HALF_TAPS;
+    half_taps = (half_taps + 3) & ~3;
+
+    polyphase_resampler_t *r = (polyphase_resampler_t *)calloc(1, sizeof(polyphase_resampler_t));
+    if (!r) return NULL;
+    r->L = L;
+    r->M = (int)M;
+    r->half = half_taps;
+    r->n_taps = 2 * half_taps;
+
+    r->phases = (float *)malloc((size_t)L * r->n_taps * sizeof(float));
+    r->buf = (float *)malloc((size_t)(r->n_taps + POLYPHASE_BLOCK) * sizeof(float));
+    if (!r->phases || !r->buf) {
+        polyphase_resampler_destroy(r);
+        return NULL;
+    }
+
+    /* Decimating: cut below the output Nyquist rate instead */
+    double cutoff = POLYPHASE_CUTOFF * (M > L ? (double)L / (double)M : 1.0);
+    for (int p = 0; p < L; p++) make_phase(r->phases + (size_t)p * r->n_taps, p, L, half_taps, cutoff);
+
+    polyphase_resampler_reset(r);
+    return r;
+}
+
+void polyphase_resampler_factors(const polyphase_resampler_t *r, int *L, int *M)
+{
+    if (L) *L = r->L;
+    if (M) *M = r->M;
+}
+
+int polyphase_resampler_max_output(const polyphase_resampler_t *r, int n)
+{
+    if (n <= 0) return 0;
+    return (int)(((long long)n * r->L + r->M - 1) / r->M) + 1;
+}
+
+void polyphase_resampler_reset(polyphase_resampler_t *r)
+{
+    /* The first output is at the first input, with silence before it */
+    memset(r->buf, 0, (size_t)r->n_taps * sizeof(float));
+    r->next = r->n_taps;
+    r->phase = 0;
+}
+
+int polyphase_resampler_process(polyphase_resampler_t *r, const float *in, int n,
+                                float *out)
+{
+    const int n_taps = r->n_taps;
+    const int half = r->half;
+    int n_out = 0;
+
+    while (n > 0) {
+        int take = n < POLYPHASE_BLOCK ? n : POLYPHASE_BLOCK;
+        memcpy(r->buf + n_taps, in, (size_t)take * sizeof(float));
+        const int n_avail = n_taps + take;
+
+        /* Each output needs half inputs past its own position */
+        int next = r->next;
+        int phase = r->phase;
+        while (next + half < n_avail) {
+            out[n_out++] = decimator_dot(r->phases + (size_t)phase * n_taps,
+                                         r->buf + next - half + 1, n_taps);
+            phase += r->M;
+            next += phase / r->L;
+            phase %= r->L;
+        }
+
+        /* Keep the last n_taps inputs in front for the next block */
+        memmove(r->buf, r->buf + take, (size_t)n_taps * sizeof(float));
+        r->next = next - take;
+        r->phase = phase;
+        in += take;
+        n -= take;
+    }
+    return n_out;
+}
+
+void polyphase_resampler_destroy(polyphase_resampler_t *r)
+{
+    if (!r) return;
+    free(r->phases);
+    free(r->buf);
+    free(r);
+}
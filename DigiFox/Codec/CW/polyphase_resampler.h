@@ -0,0 +1,79 @@
+/**
+ * polyphase_resampler.h — Streaming rational-factor resampler
+ *
+ * Converts between two rates whose ratio is a fraction L / M with
+ * L <= POLYPHASE_MAX_PHASES: conceptually upsample by L, lowpass,
+ * keep every M-th sample, but only the outputs are computed, each one
+ * dot product with the filter of its phase. The (tr)uSDX rates all
+ * qualify: 7825 → 12000 Hz is 480 / 313, 12000 → 11520 Hz is 24 / 25,
+ * and 7812.5 → 12000 Hz is 192 / 125.
+ *
+ * The filter is a Kaiser-windowed sinc with the cutoff just below the
+ * lower of the two Nyquist rates, normalized to unit gain at DC for
+ * every phase. Input may come in blocks of any size: the last taps of
+ * history and the phase carry over, so a stream resampled block by
+ * block is identical to resampling it whole. Output k is the signal at
+ * input time k · M / L, written once half_taps inputs past it are in.
+ *
+ * All memory is allocated in polyphase_resampler_create().
+ */
+
+#ifndef POLYPHASE_RESAMPLER_H
+#define POLYPHASE_RESAMPLER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define POLYPHASE_MAX_PHASES     1024
+#define POLYPHASE_HALF_TAPS      16      /* Default: 32 taps per phase */
+#define POLYPHASE_MAX_HALF_TAPS  64
+
+/* Opaque resampler handle */
+typedef struct polyphase_resampler_t polyphase_resampler_t;
+
+/**
+ * Create a resampler from in_rate to out_rate (Hz).
+ *
+ * @param half_taps  Input samples either side of each output, rounded
+ *                   up to a multiple of 4 (<= 0 = POLYPHASE_HALF_TAPS)
+ * @return NULL if the ratio is not L / M with L <= POLYPHASE_MAX_PHASES,
+ *         or on allocation failure
+ */
+polyphase_resampler_t *polyphase_resampler_create(double in_rate, double out_rate,
+                                                  int half_taps);
+
+/**
+ * The reduced factors: out_rate / in_rate = L / M.
+ */
+void polyphase_resampler_factors(const polyphase_resampler_t *r, int *L, int *M);
+
+/**
+ * Outputs n more inputs can give at most; size out with it.
+ */
+int polyphase_resampler_max_output(const polyphase_resampler_t *r, int n);
+
+/**
+ * Resample a block. out may not alias in.
+ *
+ * @param out  At least polyphase_resampler_max_output(r, n) floats
+ * @return Outputs written
+ */
+int polyphase_resampler_process(polyphase_resampler_t *r, const float *in, int n,
+                                float *out);
+
+/**
+ * Forget the history: the next input starts a new stream.
+ */
+void polyphase_resampler_reset(polyphase_resampler_t *r);
+
+/**
+ * Destroy resampler and free all resources.
+ */
+void polyphase_resampler_destroy(polyphase_resampler_t *r);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POLYPHASE_RESAMPLER_H */
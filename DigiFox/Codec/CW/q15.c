@@ -0,0 +1,249 @@
+/**
+ * q15.c — Fixed-point bandpass and decimator, scalar kernels
+ */
+
+#include "q15.h"
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define Q28        (1 << 28)
+#define GUARD      Q15_IIR_GUARD_BITS
+
+/* Frequency points for the section scaling */
+#define GAIN_GRID  8192
+
+static inline int16_t sat16(int32_t v)
+{
+    if (v > 32767) return 32767;
+    if (v < -32768) return -32768;
+    return (int16_t)v;
+}
+
+/* |H| of sections 0..upto at w, each input scaled by g[s] */
+static double cascade_mag(const iir_filter_t *f, const double *g, int upto, double w)
+{
+    double c1 = cos(w), s1 = sin(w), c2 = cos(2.0 * w), s2 = sin(2.0 * w);
+    double mag = 1.0;
+    for (int s = 0; s <= upto; s++) {
+        const iir_section_d_t *d = &f->dsections[s];
+        double nr = d->b[0] + d->b[1] * c1 + d->b[2] * c2;
+        double ni = -d->b[1] * s1 - d->b[2] * s2;
+        double dr = 1.0 + d->a[1] * c1 + d->a[2] * c2;
+        double di = -d->a[1] * s1 - d->a[2] * s2;
+        mag *= g[s] * sqrt((nr * nr + ni * ni) / (dr * dr + di * di));
+    }
+    return mag;
+}
+
+void q15_iir_init(q15_iir_t *q, const iir_filter_t *f)
+{
+    memset(q, 0, sizeof(*q));
+    q->n_sections = f->n_sections;
+
+    /* Section by section: scale its input so the cascade so far peaks at 1 */
+    double g[IIR_MAX_SECTIONS];
+    double total = 1.0;
+    for (int s = 0; s < f->n_sections; s++) {
+        g[s] = 1.0;
+        double peak = 0.0;
+        for (int k = 1; k < GAIN_GRID; k++) {
+            double m = cascade_mag(f, g, s, M_PI * k / GAIN_GRID);
+            if (m > peak) peak = m;
+        }
+        if (peak > 0.0) g[s] = 1.0 / peak;
+        total *= g[s];
+
+        const iir_section_d_t *d = &f->dsections[s];
+        q15_section_t *qs = &q->sections[s];
+        for (int j = 0; j < 3; j++) {
+            qs->b[j] = (int32_t)lrint(d->b[j] * g[s] * Q28);
+            qs->a[j] = (int32_t)lrint(d->a[j] * Q28);
+        }
+    }
+    q->gain = (float)total;
+}
+
+/* One DF-I step: x at guard precision in, y at guard precision out */
+static inline int32_t section_step(const q15_section_t *sec, int32_t x,
+                                   int32_t *x1, int32_t *x2, int32_t *y1, int32_t *y2)
+{
+    int64_t acc = (int64_t)sec->b[0] * x + (int64_t)sec->b[1] * *x1
+                + (int64_t)sec->b[2] * *x2
+                - (int64_t)sec->a[1] * *y1 - (int64_t)sec->a[2] * *y2;
+    int32_t y = (int32_t)((acc + (Q28 >> 1)) >> 28);
+    *x2 = *x1;
+    *x1 = x;
+    *y2 = *y1;
+    *y1 = y;
+    return y;
+}
+
+/*
+ * Fused cascade over sec[0 .. count-1] (count <= 4), as in iir_filter.c:
+ * the sections' recursions overlap across samples, and a constant count
+ * keeps the states in registers.
+ */
+static inline void cascade_fused(q15_section_t *sec, int count,
+                                 const int16_t *in, int16_t *out, int n)
+{
+    int32_t s0[4] = { sec[0].x1, sec[0].x2, sec[0].y1, sec[0].y2 };
+    int32_t s1[4] = { 0 }, s2[4] = { 0 }, s3[4] = { 0 };
+    if (count > 1) { s1[0] = sec[1].x1; s1[1] = sec[1].x2; s1[2] = sec[1].y1; s1[3] = sec[1].y2; }
+    if (count > 2) { s2[0] = sec[2].x1; s2[1] = sec[2].x2; s2[2] = sec[2].y1; s2[3] = sec[2].y2; }
+    if (count > 3) { s3[0] = sec[3].x1; s3[1] = sec[3].x2; s3[2] = sec[3].y1; s3[3] = sec[3].y2; }
+
+    for (int i = 0; i < n; i++) {
+        int32_t x = (int32_t)in[i] * (1 << GUARD);
+        x = section_step(&sec[0], x, &s0[0], &s0[1], &s0[2], &s0[3]);
+        if (count > 1) x = section_step(&sec[1], x, &s1[0], &s1[1], &s1[2], &s1[3]);
+        if (count > 2) x = section_step(&sec[2], x, &s2[0], &s2[1], &s2[2], &s2[3]);
+        if (count > 3) x = section_step(&sec[3], x, &s3[0], &s3[1], &s3[2], &s3[3]);
+        out[i] = sat16((x + (1 << (GUARD - 1))) >> GUARD);
+    }
+
+    sec[0].x1 = s0[0]; sec[0].x2 = s0[1]; sec[0].y1 = s0[2]; sec[0].y2 = s0[3];
+    if (count > 1) { sec[1].x1 = s1[0]; sec[1].x2 = s1[1]; sec[1].y1 = s1[2]; sec[1].y2 = s1[3]; }
+    if (count > 2) { sec[2].x1 = s2[0]; sec[2].x2 = s2[1]; sec[2].y1 = s2[2]; sec[2].y2 = s2[3]; }
+    if (count > 3) { sec[3].x1 = s3[0]; sec[3].x2 = s3[1]; sec[3].y1 = s3[2]; sec[3].y2 = s3[3]; }
+}
+
+void q15_iir_process(q15_iir_t *q, const int16_t *in, int16_t *out, int n)
+{
+    if (q->n_sections == 0) {
+        if (out != in) memmove(out, in, (size_t)n * sizeof(int16_t));
+        return;
+    }
+
+    /* Up to 4 sections per pass; between passes the block is Q15 */
+    for (int s = 0; s < q->n_sections; s += 4) {
+        q15_section_t *sec = &q->sections[s];
+        const int16_t *src = s == 0 ? in : out;
+        switch (q->n_sections - s) {
+        case 1:  cascade_fused(sec, 1, src, out, n); break;
+        case 2:  cascade_fused(sec, 2, src, out, n); break;
+        case 3:  cascade_fused(sec, 3, src, out, n); break;
+        default: cascade_fused(sec, 4, src, out, n); break;
+        }
+    }
+}
+
+void q15_iir_reset(q15_iir_t *q)
+{
+    for (int s = 0; s < q->n_sections; s++) {
+        q15_section_t *qs = &q->sections[s];
+        qs->x1 = qs->x2 = qs->y1 = qs->y2 = 0;
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Decimator                                                           */
+/* ------------------------------------------------------------------ */
+
+void q15_decimator_init(q15_decimator_t *d, int factor, float scale)
+{
+    memset(d, 0, sizeof(*d));
+
+    /* decimator.c's design, quantized */
+    decimator_t fd;
+    decimator_init(&fd, factor);
+    d->factor = fd.factor;
+    d->n_taps = fd.n_taps;
+
+    if (d->factor == 1) {
+        d->scale = scale / 32768.0f;
+        return;
+    }
+
+    /*
+     * Q16 with unity DC gain, shrunk if the taps' absolute sum would
+     * otherwise let a rectified full-scale window overflow int32.
+     */
+    double sum_abs = 0.0;
+    for (int k = 0; k < d->n_taps; k++) sum_abs += fabs((double)fd.taps[k]);
+    double q = 65536.0;
+    if (sum_abs * q > 65535.0) q = 65535.0 / sum_abs;
+    for (int k = 0; k < d->n_taps; k++) {
+        d->taps[k] = (int16_t)lrint(fd.taps[k] * q);
+    }
+    d->scale = (float)(scale / (32768.0 * q));
+}
+
+int q15_decimator_process(q15_decimator_t *d, const int16_t *in, int n,
+                          float *out, q15_dot_fn dot)
+{
+    if (d->factor == 1) {
+        for (int i = 0; i < n; i++) out[i] = (float)in[i] * d->scale;
+        return n;
+    }
+
+    const int nt = d->n_taps;
+    if (n > 0 && !d->primed) {
+        for (int k = 0; k < 2 * nt; k++) d->hist[k] = in[0];
+        d->primed = 1;
+    }
+
+    /* Only the retained phase is computed */
+    int m = 0;
+    for (int i = 0; i < n; i++) {
+        d->hist[d->pos] = in[i];
+        d->hist[d->pos + nt] = in[i];
+        if (++d->pos == nt) d->pos = 0;
+
+        if (++d->phase < d->factor) continue;
+        d->phase = 0;
+        out[m++] = (float)dot(d->taps, d->hist + d->pos, nt) * d->scale;
+    }
+    return m;
+}
+
+void q15_decimator_reset(q15_decimator_t *d)
+{
+    d->primed = 0;
+    d->pos = 0;
+    d->phase = 0;
+    memset(d->hist, 0, sizeof(d->hist));
+}
+
+/* ------------------------------------------------------------------ */
+/* Scalar kernels                                                      */
+/* ------------------------------------------------------------------ */
+
+void q15_rectify_scalar(const int16_t *in, int16_t *out, int n)
+{
+    for (int i = 0; i < n; i++) {
+        int32_t v = in[i];
+        out[i] = sat16(v < 0 ? -v : v);
+    }
+}
+
+int32_t q15_dot_scalar(const int16_t *taps, const int16_t *h, int n)
+{
+    int32_t acc[DECIM_TAPS_PER_PHASE] = {0};
+    for (int k = 0; k < n; k += DECIM_TAPS_PER_PHASE) {
+        for (int j = 0; j < DECIM_TAPS_PER_PHASE; j++) {
+            acc[j] += (int32_t)taps[k + j] * h[k + j];
+        }
+    }
+    int32_t sum = 0;
+    for (int j = 0; j < DECIM_TAPS_PER_PHASE; j++) sum += acc[j];
+    return sum;
+}
+
+void q15_to_float_scalar(const int16_t *in, float *out, int n)
+{
+    for (int i = 0; i < n; i++) out[i] = (float)in[i] * (1.0f / 32768.0f);
+}
+
+void q15_from_float_scalar(const float *in, int16_t *out, int n)
+{
+    for (int i = 0; i < n; i++) {
+        float v = in[i] * 32768.0f;
+        if (v > 32767.0f) v = 32767.0f;
+        if (v < -32768.0f) v = -32768.0f;
+        out[i] = (int16_t)lrintf(v);
+    }
+}
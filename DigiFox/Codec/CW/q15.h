@@ -0,0 +1,129 @@
+/**
+ * q15.h — Fixed-point (Q15 / int16) bandpass and decimator front end
+ *
+ * For int16 sources (TruSDX, archives) and background monitoring: the
+ * audio-rate half of the filter pipeline (bandpass → rectify → decimate)
+ * runs on int16 samples, the full-scale range [-1, 1) as Q15, and only
+ * the decimated signal is handed on as float to the envelope and timing
+ * stages, which run at the detection rate.
+ *
+ * Bandpass: the design's biquads in Direct Form I with Q28 coefficients,
+ * 32 x 32 → 64-bit multiply-accumulates (one smaddl each on ARM64) and a 32-bit state carrying 12 bits below the Q15
+ * LSB, which is also what passes from section to section. A narrow
+ * bandpass at 48 kHz has its poles so close to the unit circle that int16
+ * feedback (even with error feedback) leaves only ~25 dB between tone and
+ * rounding noise; this keeps ~85 dB at every rate. Each section's input
+ * is scaled so the cascade's gain up to that section peaks at 1, so a
+ * full-scale tone cannot overflow; the output saturates regardless.
+ *
+ * Rectify and decimate are 8-lane int16 kernels (cw_kernels_t): the
+ * decimator taps are Q16 with unity DC gain, so a dot product of
+ * rectified samples stays inside int32.
+ */
+
+#ifndef Q15_H
+#define Q15_H
+
+#include "iir_filter.h"
+#include "decimator.h"
+#include <stdint.h>
+
+/* Feedback state bits below the Q15 LSB */
+#define Q15_IIR_GUARD_BITS  12
+
+/* One biquad section, DF-I */
+typedef struct {
+    int32_t b[3];             /* Q28, input scaling folded in */
+    int32_t a[3];             /* Q28: 1, a1, a2 */
+    int32_t x1, x2;           /* Q(15 + guard) input history */
+    int32_t y1, y2;           /* Q(15 + guard) output history */
+} q15_section_t;
+
+typedef struct {
+    q15_section_t sections[IIR_MAX_SECTIONS];
+    int   n_sections;
+    float gain;               /* Cascade gain relative to the design */
+} q15_iir_t;
+
+/**
+ * Load a designed filter's double sections.
+ */
+void q15_iir_init(q15_iir_t *q, const iir_filter_t *f);
+
+/**
+ * Filter n samples. out may alias in.
+ */
+void q15_iir_process(q15_iir_t *q, const int16_t *in, int16_t *out, int n);
+
+/**
+ * Reset filter state to zero (keep coefficients).
+ */
+void q15_iir_reset(q15_iir_t *q);
+
+typedef int32_t (*q15_dot_fn)(const int16_t *taps, const int16_t *h, int n);
+
+/* decimator.h's filter on int16 input, float output */
+typedef struct {
+    int factor;
+    int n_taps;
+    int primed;
+    int pos;
+    int phase;
+    float scale;              /* Dot product → float, gain compensation */
+
+    int16_t taps[DECIM_MAX_TAPS];           /* Q16, unity DC gain */
+    int16_t hist[2 * DECIM_MAX_TAPS];       /* Doubled ring */
+} q15_decimator_t;
+
+/**
+ * Initialize decimator.
+ *
+ * @param d       Output struct
+ * @param factor  Decimation factor, clamped to [1, DECIM_MAX_FACTOR]
+ * @param scale   Output = float(input) / 32768 * scale
+ */
+void q15_decimator_init(q15_decimator_t *d, int factor, float scale);
+
+/**
+ * Filter and downsample rectified (non-negative) samples.
+ *
+ * @param out  Float output, at most n / factor + 1 samples
+ * @param dot  Dot product kernel (cw_kernels_t.dot_s16)
+ * @return Number of output samples written
+ */
+int q15_decimator_process(q15_decimator_t *d, const int16_t *in, int n,
+                          float *out, q15_dot_fn dot);
+
+/**
+ * Reset decimator state.
+ */
+void q15_decimator_reset(q15_decimator_t *d);
+
+/* ------------------------------------------------------------------ */
+/* Per-ISA kernels (selected via cw_get_kernels())                     */
+/* ------------------------------------------------------------------ */
+
+/* out[i] = |in[i]|, saturating (-32768 → 32767); out may alias in */
+void    q15_rectify_scalar(const int16_t *in, int16_t *out, int n);
+/* Dot product, n a multiple of DECIM_TAPS_PER_PHASE */
+int32_t q15_dot_scalar(const int16_t *taps, const int16_t *h, int n);
+/* in / 32768 */
+void    q15_to_float_scalar(const int16_t *in, float *out, int n);
+/* in * 32768, rounded and saturated */
+void    q15_from_float_scalar(const float *in, int16_t *out, int n);
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+void    q15_rectify_neon(const int16_t *in, int16_t *out, int n);
+int32_t q15_dot_neon(const int16_t *taps, const int16_t *h, int n);
+void    q15_to_float_neon(const int16_t *in, float *out, int n);
+void    q15_from_float_neon(const float *in, int16_t *out, int n);
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+void    q15_rectify_sse2(const int16_t *in, int16_t *out, int n);
+int32_t q15_dot_sse2(const int16_t *taps, const int16_t *h, int n);
+void    q15_to_float_sse2(const int16_t *in, float *out, int n);
+void    q15_from_float_sse2(const float *in, int16_t *out, int n);
+#endif
+
+#endif /* Q15_H */
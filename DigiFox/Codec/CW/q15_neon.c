@@ -0,0 +1,61 @@
+/**
+ * q15_neon.c — NEON int16 kernels for the fixed-point front end
+ *
+ * Eight samples per instruction: saturating abs, widening multiply-add
+ * for the decimator dot product, and the int16 ↔ float conversions.
+ */
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+#include "q15.h"
+#include <arm_neon.h>
+
+void q15_rectify_neon(const int16_t *in, int16_t *out, int n)
+{
+    int i = 0;
+    for (; i + 7 < n; i += 8) {
+        vst1q_s16(out + i, vqabsq_s16(vld1q_s16(in + i)));
+    }
+    q15_rectify_scalar(in + i, out + i, n - i);
+}
+
+/* n is a multiple of 8 */
+int32_t q15_dot_neon(const int16_t *taps, const int16_t *h, int n)
+{
+    int32x4_t acc0 = vdupq_n_s32(0);
+    int32x4_t acc1 = vdupq_n_s32(0);
+    for (int k = 0; k < n; k += 8) {
+        int16x8_t t = vld1q_s16(taps + k);
+        int16x8_t x = vld1q_s16(h + k);
+        acc0 = vmlal_s16(acc0, vget_low_s16(t), vget_low_s16(x));
+        acc1 = vmlal_high_s16(acc1, t, x);
+    }
+    return vaddvq_s32(vaddq_s32(acc0, acc1));
+}
+
+void q15_to_float_neon(const int16_t *in, float *out, int n)
+{
+    int i = 0;
+    for (; i + 7 < n; i += 8) {
+        int16x8_t v = vld1q_s16(in + i);
+        /* Fixed-point convert: int32 with 15 fraction bits */
+        vst1q_f32(out + i,     vcvtq_n_f32_s32(vmovl_s16(vget_low_s16(v)), 15));
+        vst1q_f32(out + i + 4, vcvtq_n_f32_s32(vmovl_high_s16(v), 15));
+    }
+    q15_to_float_scalar(in + i, out + i, n - i);
+}
+
+void q15_from_float_neon(const float *in, int16_t *out, int n)
+{
+    const float32x4_t full = vdupq_n_f32(32768.0f);
+    int i = 0;
+    for (; i + 7 < n; i += 8) {
+        /* Round to nearest; the int32 convert and the narrow both saturate */
+        int32x4_t lo = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(in + i), full));
+        int32x4_t hi = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(in + i + 4), full));
+        vst1q_s16(out + i, vqmovn_high_s32(vqmovn_s32(lo), hi));
+    }
+    q15_from_float_scalar(in + i, out + i, n - i);
+}
+
+#endif /* __aarch64__ */
@@ -0,0 +1,73 @@
+/**
+ * q15_x86.c — SSE2 int16 kernels for the fixed-point front end
+ *
+ * Eight samples per instruction, as on NEON. AVX2 keeps these: the
+ * decimator dot is 8 taps per phase and the rest is memory-bound.
+ */
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+
+#include "q15.h"
+#include <emmintrin.h>
+
+void q15_rectify_sse2(const int16_t *in, int16_t *out, int n)
+{
+    const __m128i zero = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 7 < n; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(in + i));
+        /* max(x, 0 -sat x): -32768 → 32767 */
+        v = _mm_max_epi16(v, _mm_subs_epi16(zero, v));
+        _mm_storeu_si128((__m128i *)(out + i), v);
+    }
+    q15_rectify_scalar(in + i, out + i, n - i);
+}
+
+/* n is a multiple of 8 */
+int32_t q15_dot_sse2(const int16_t *taps, const int16_t *h, int n)
+{
+    __m128i acc = _mm_setzero_si128();
+    for (int k = 0; k < n; k += 8) {
+        __m128i t = _mm_loadu_si128((const __m128i *)(taps + k));
+        __m128i x = _mm_loadu_si128((const __m128i *)(h + k));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(t, x));
+    }
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(acc);
+}
+
+void q15_to_float_sse2(const int16_t *in, float *out, int n)
+{
+    const __m128 inv = _mm_set1_ps(1.0f / 32768.0f);
+    int i = 0;
+    for (; i + 7 < n; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(in + i));
+        /* Sign-extend: each int16 into the top half, shift back down */
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_ps(out + i,     _mm_mul_ps(_mm_cvtepi32_ps(lo), inv));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), inv));
+    }
+    q15_to_float_scalar(in + i, out + i, n - i);
+}
+
+void q15_from_float_sse2(const float *in, int16_t *out, int n)
+{
+    const __m128 full = _mm_set1_ps(32768.0f);
+    /* Clamp first: out-of-range converts to INT32_MIN whatever the sign */
+    const __m128 hi_lim = _mm_set1_ps(32767.0f);
+    const __m128 lo_lim = _mm_set1_ps(-32768.0f);
+    int i = 0;
+    for (; i + 7 < n; i += 8) {
+        __m128 a = _mm_mul_ps(_mm_loadu_ps(in + i), full);
+        __m128 b = _mm_mul_ps(_mm_loadu_ps(in + i + 4), full);
+        a = _mm_max_ps(_mm_min_ps(a, hi_lim), lo_lim);
+        b = _mm_max_ps(_mm_min_ps(b, hi_lim), lo_lim);
+        __m128i v = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+        _mm_storeu_si128((__m128i *)(out + i), v);
+    }
+    q15_from_float_scalar(in + i, out + i, n - i);
+}
+
+#endif /* x86 */
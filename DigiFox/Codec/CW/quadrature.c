@@ -0,0 +1,117 @@
+/**
+ * quadrature.c — Quadrature front end
+ *
+ * With the window h[k] = x[n - N + 1 + k] (oldest first), the mixed and
+ * filtered output is
+ *
+ *   y[n] = sum_k p[k] x[n-N+1+k] e^{-j w (n-N+1+k)}
+ *        = e^{-j w (n-N+1)} · sum_k (p[k] e^{-j w k}) h[k]
+ *
+ * The sum uses the pre-modulated taps; the leading phase factor advances
+ * by e^{-j w factor} per output and is applied at the decimated rate.
+ */
+
+#include "quadrature.h"
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* Re-normalize the low-rate phasor this often (outputs) */
+#define QUAD_RENORM_INTERVAL 1024
+
+/* Baseband samples buffered before the channel filter */
+#define QUAD_BLOCK 256
+
+void quadrature_init(quadrature_t *q, int sample_rate, int factor,
+                     float center_freq, float bandwidth)
+{
+    memset(q, 0, sizeof(*q));
+    if (factor < 2) factor = 2;
+    decimator_init(&q->dec, factor);
+
+    double w = 2.0 * M_PI * (double)center_freq / (double)sample_rate;
+    for (int k = 0; k < q->dec.n_taps; k++) {
+        q->taps_i[k] = (float)((double)q->dec.taps[k] * cos(w * k));
+        q->taps_q[k] = (float)(-(double)q->dec.taps[k] * sin(w * k));
+    }
+
+    double wd = w * (double)q->dec.factor;
+    q->step_re = (float)cos(wd);
+    q->step_im = (float)-sin(wd);
+    q->rot_re = 1.0f;
+    q->rot_im = 0.0f;
+
+    float rate = (float)sample_rate / (float)q->dec.factor;
+    float cutoff = bandwidth > 0.0f ? 0.5f * bandwidth : 50.0f;
+    if (cutoff > 0.45f * rate) cutoff = 0.45f * rate;
+    iir_design_lowpass(&q->lpf_i, 2, cutoff, rate);
+    iir_design_lowpass(&q->lpf_q, 2, cutoff, rate);
+}
+
+/* Channel filter + magnitude for a block of baseband samples */
+static void flush_block(quadrature_t *q, float *bi, float *bq, int cnt, float *out)
+{
+    iir_filter_process(&q->lpf_i, bi, cnt);
+    iir_filter_process(&q->lpf_q, bq, cnt);
+    for (int j = 0; j < cnt; j++) {
+        out[j] = sqrtf(bi[j] * bi[j] + bq[j] * bq[j]);
+    }
+}
+
+int quadrature_process(quadrature_t *q, const float *in, int n, float *out)
+{
+    decimator_t *d = &q->dec;
+    int nt = d->n_taps;
+    int m = 0;
+    int cnt = 0;
+    float bi[QUAD_BLOCK], bq[QUAD_BLOCK];
+
+    for (int i = 0; i < n; i++) {
+        const float *h = decimator_push(d, in[i]);
+        if (!h) continue;
+
+        float zi = decimator_dot(q->taps_i, h, nt);
+        float zq = decimator_dot(q->taps_q, h, nt);
+
+        /* Apply the leading phase factor, then advance it */
+        bi[cnt] = q->rot_re * zi - q->rot_im * zq;
+        bq[cnt] = q->rot_re * zq + q->rot_im * zi;
+        cnt++;
+
+        float re = q->rot_re * q->step_re - q->rot_im * q->step_im;
+        float im = q->rot_re * q->step_im + q->rot_im * q->step_re;
+        q->rot_re = re;
+        q->rot_im = im;
+        if (++q->n_out == QUAD_RENORM_INTERVAL) {
+            float g = 1.0f / sqrtf(re * re + im * im);
+            q->rot_re *= g;
+            q->rot_im *= g;
+            q->n_out = 0;
+        }
+
+        /* Outputs never overtake the input, so out may alias in */
+        if (cnt == QUAD_BLOCK) {
+            flush_block(q, bi, bq, cnt, out + m);
+            m += cnt;
+            cnt = 0;
+        }
+    }
+    if (cnt > 0) {
+        flush_block(q, bi, bq, cnt, out + m);
+        m += cnt;
+    }
+    return m;
+}
+
+void quadrature_reset(quadrature_t *q)
+{
+    decimator_reset(&q->dec);
+    q->rot_re = 1.0f;
+    q->rot_im = 0.0f;
+    q->n_out = 0;
+    iir_filter_reset(&q->lpf_i);
+    iir_filter_reset(&q->lpf_q);
+}
@@ -0,0 +1,66 @@
+/**
+ * quadrature.h — Quadrature (I/Q) front end: NCO mix → lowpass → |I + jQ|
+ *
+ * Alternative to bandpass + rectifier. The tone at center_freq is shifted
+ * to 0 Hz, I and Q are lowpassed to ±bandwidth/2 and decimated, and the
+ * magnitude is the envelope — no rectifier ripple at 2·center_freq.
+ *
+ * The mix is folded into the decimator: the windowed-sinc taps are
+ * modulated by the NCO, so each output costs two dot products and the
+ * remaining phase rotation runs at the decimated rate. The per-input-
+ * sample cost is 2 × DECIM_TAPS_PER_PHASE multiply-adds.
+ */
+
+#ifndef QUADRATURE_H
+#define QUADRATURE_H
+
+#include "decimator.h"
+#include "iir_filter.h"
+
+typedef struct {
+    /* Input ring / phase bookkeeping (its real taps are the prototype) */
+    decimator_t dec;
+
+    /* Prototype taps modulated by e^{-j w k} */
+    float taps_i[DECIM_MAX_TAPS];
+    float taps_q[DECIM_MAX_TAPS];
+
+    /* Low-rate NCO: rotation by e^{-j w factor} per output */
+    float rot_re, rot_im;
+    float step_re, step_im;
+    int   n_out;              /* Outputs since last renormalization */
+
+    /* Channel filter at the decimated rate (±bandwidth/2) */
+    iir_filter_t lpf_i;
+    iir_filter_t lpf_q;
+} quadrature_t;
+
+/**
+ * Initialize quadrature front end.
+ *
+ * @param q            Output struct
+ * @param sample_rate  Input sample rate in Hz
+ * @param factor      Decimation factor (>= 2)
+ * @param center_freq  Tone frequency in Hz
+ * @param bandwidth    Channel width in Hz (lowpass at bandwidth / 2)
+ */
+void quadrature_init(quadrature_t *q, int sample_rate, int factor,
+                     float center_freq, float bandwidth);
+
+/**
+ * Mix, filter and decimate; write the magnitude. out may alias in.
+ *
+ * @param q    Front-end state
+ * @param in   Input audio
+ * @param n    Number of input samples
+ * @param out  Magnitude output, at most n / factor + 1 samples
+ * @return Number of output samples written
+ */
+int quadrature_process(quadrature_t *q, const float *in, int n, float *out);
+
+/**
+ * Reset front-end state.
+ */
+void quadrature_reset(quadrature_t *q);
+
+#endif /* QUADRATURE_H */
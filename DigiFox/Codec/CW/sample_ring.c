@@ -0,0 +1,117 @@
+/**
+ * sample_ring.c — Mirrored overwrite ring with a release-published write count
+ */
+
+#include "sample_ring.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct sample_ring_t {
+    float   *buf;                 /* 2 · capacity: each sample at i and i + capacity */
+    size_t   capacity;            /* Power of two */
+    size_t   mask;
+    int      history;
+    _Atomic uint64_t written;     /* Samples complete */
+    _Atomic uint64_t reserved;    /* Samples complete or being written */
+};
+
+sample_ring_t *sample_ring_create(int history)
+{
+    if (history < 1) return NULL;
+
+    sample_ring_t *r = (sample_ring_t *)calloc(1, sizeof(sample_ring_t));
+    if (!r) return NULL;
+
+    size_t want = (size_t)history + (size_t)history / 4;
+    size_t cap = 1;
+    while (cap < want) cap <<= 1;
+
+    r->buf = (float *)calloc(2 * cap, sizeof(float));
+    if (!r->buf) {
+        free(r);
+        return NULL;
+    }
+    r->capacity = cap;
+    r->mask = cap - 1;
+    r->history = history;
+    atomic_init(&r->written, 0);
+    atomic_init(&r->reserved, 0);
+    return r;
+}
+
+int sample_ring_history(const sample_ring_t *r)
+{
+    return r->history;
+}
+
+void sample_ring_write(sample_ring_t *r, const float *samples, int n)
+{
+    if (n <= 0) return;
+
+    uint64_t w = atomic_load_explicit(&r->written, memory_order_relaxed);
+    uint64_t end = w + (uint64_t)n;
+
+    /* More than a capacity at once: only the newest can be kept */
+    if ((size_t)n > r->capacity) {
+        samples += (size_t)n - r->capacity;
+        w = end - r->capacity;
+        n = (int)r->capacity;
+    }
+
+    /* Claim the slots before touching them, so readers can tell */
+    atomic_store_explicit(&r->reserved, end, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    size_t i = (size_t)w & r->mask;
+    size_t first = r->capacity - i;
+    if (first > (size_t)n) first = (size_t)n;
+    size_t rest = (size_t)n - first;
+
+    memcpy(r->buf + i, samples, first * sizeof(float));
+    memcpy(r->buf + i + r->capacity, samples, first * sizeof(float));
+    if (rest) {
+        memcpy(r->buf, samples + first, rest * sizeof(float));
+        memcpy(r->buf + r->capacity, samples + first, rest * sizeof(float));
+    }
+
+    atomic_store_explicit(&r->written, end, memory_order_release);
+}
+
+uint64_t sample_ring_written(const sample_ring_t *r)
+{
+    return atomic_load_explicit(&((sample_ring_t *)r)->written, memory_order_acquire);
+}
+
+const float *sample_ring_window(const sample_ring_t *r, uint64_t start, int n)
+{
+    if (n < 0 || n > r->history) return NULL;
+
+    uint64_t w = sample_ring_written(r);
+    if (start > w || w - start < (uint64_t)n) return NULL;
+    if (w - start > (uint64_t)r->history) return NULL;
+
+    return r->buf + ((size_t)start & r->mask);
+}
+
+int sample_ring_intact(const sample_ring_t *r, uint64_t start)
+{
+    /* Order the caller's reads of the window before the check */
+    atomic_thread_fence(memory_order_acquire);
+    uint64_t claimed = atomic_load_explicit(&((sample_ring_t *)r)->reserved, memory_order_relaxed);
+    return claimed - start <= r->capacity;
+}
+
+void sample_ring_reset(sample_ring_t *r)
+{
+    atomic_store_explicit(&r->reserved, 0, memory_order_relaxed);
+    atomic_store_explicit(&r->written, 0, memory_order_release);
+}
+
+void sample_ring_destroy(sample_ring_t *r)
+{
+    if (!r) return;
+    free(r->buf);
+    free(r);
+}
@@ -0,0 +1,83 @@
+/**
+ * sample_ring.h — Lock-free audio history with zero-copy windows
+ *
+ * The history counterpart of spsc_ring: one producer (the audio input)
+ * writes and never waits, and the oldest samples are simply overwritten
+ * once the ring is full. Readers ask for any span of the last `history`
+ * samples and get a pointer straight into the ring, never a copy.
+ *
+ * Every sample is stored twice, at its slot and one capacity further on,
+ * so any span up to the capacity is contiguous however it wraps. The
+ * write count is published with release ordering after the samples, so
+ * a reader that loads it (acquire) sees all samples before it.
+ *
+ * A window stays intact until capacity - n more samples are written.
+ * The capacity is at least 1.25 × history, so even a window of the whole
+ * history survives a quarter of the history. Readers that hold on to a
+ * window for long can check sample_ring_intact() after use.
+ *
+ * All memory is allocated in sample_ring_create().
+ */
+
+#ifndef SAMPLE_RING_H
+#define SAMPLE_RING_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct sample_ring_t sample_ring_t;
+
+/**
+ * Create a ring that keeps at least the last `history` samples.
+ * Returns NULL on allocation failure or history < 1.
+ */
+sample_ring_t *sample_ring_create(int history);
+
+/* Samples kept for readers */
+int sample_ring_history(const sample_ring_t *r);
+
+/**
+ * Producer: append n samples, overwriting the oldest. Never blocks.
+ */
+void sample_ring_write(sample_ring_t *r, const float *samples, int n);
+
+/**
+ * Samples written since creation or the last reset; the index one past
+ * the newest sample.
+ */
+uint64_t sample_ring_written(const sample_ring_t *r);
+
+/**
+ * Reader: the n samples starting at index start, in place.
+ *
+ * @return Pointer to n contiguous samples, or NULL if the span is not
+ *         all written yet or reaches back past the history
+ */
+const float *sample_ring_window(const sample_ring_t *r, uint64_t start, int n);
+
+/**
+ * True if the samples from index start on have not been overwritten,
+ * nor are being. Call it after reading a window to know the reads saw
+ * the samples asked for, not newer ones written over them.
+ */
+int sample_ring_intact(const sample_ring_t *r, uint64_t start);
+
+/**
+ * Drop all samples and start counting from 0. Only safe while the
+ * producer is not writing.
+ */
+void sample_ring_reset(sample_ring_t *r);
+
+/**
+ * Destroy ring and free all resources.
+ */
+void sample_ring_destroy(sample_ring_t *r);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SAMPLE_RING_H */
@@ -0,0 +1,129 @@
+/**
+ * sdft.c — Sliding-DFT tone detector with neighbour-bin noise floor
+ */
+
+#include "sdft.h"
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* Re-normalize the phasors this often (input samples) */
+#define SDFT_RENORM_INTERVAL 1024
+
+/* Noise floor smoothing time constant in seconds */
+#define SDFT_NOISE_TC_S 0.5f
+
+static void bin_init(sdft_bin_t *b, double w, int n_win)
+{
+    memset(b, 0, sizeof(*b));
+    b->rot_re = 1.0;
+    b->step_re = cos(w);
+    b->step_im = -sin(w);
+    b->old_re = cos(w * n_win);
+    b->old_im = sin(w * n_win);
+}
+
+void sdft_init(sdft_t *s, int sample_rate, int factor,
+               float center_freq, float bandwidth)
+{
+    memset(s, 0, sizeof(*s));
+    if (factor < 1) factor = 1;
+    s->factor = factor;
+
+    float bw = bandwidth > 0.0f ? bandwidth : 100.0f;
+    int n_win = (int)((float)sample_rate / bw + 0.5f);
+    if (n_win < 16) n_win = 16;
+    if (n_win > SDFT_MAX_WINDOW) n_win = SDFT_MAX_WINDOW;
+    s->n_win = n_win;
+    s->scale = 2.0f / (float)n_win;
+
+    double fs = (double)sample_rate;
+    double spacing = SDFT_NOISE_BINS * fs / n_win;
+    bin_init(&s->bin[0], 2.0 * M_PI * center_freq / fs, n_win);
+    s->n_bins = 1;
+
+    /* Neighbours that fall outside (0, Nyquist) are dropped */
+    double lo = center_freq - spacing;
+    double hi = center_freq + spacing;
+    if (lo > 0.0) bin_init(&s->bin[s->n_bins++], 2.0 * M_PI * lo / fs, n_win);
+    if (hi < 0.5 * fs) bin_init(&s->bin[s->n_bins++], 2.0 * M_PI * hi / fs, n_win);
+
+    float rate = (float)sample_rate / (float)factor;
+    s->noise_alpha = 1.0f / (rate * SDFT_NOISE_TC_S);
+    if (s->noise_alpha > 1.0f) s->noise_alpha = 1.0f;
+}
+
+static inline float bin_mag(const sdft_bin_t *b)
+{
+    return (float)sqrt(b->acc_re * b->acc_re + b->acc_im * b->acc_im);
+}
+
+int sdft_process(sdft_t *s, const float *in, int n, float *out)
+{
+    int nb = s->n_bins;
+    int m = 0;
+
+    for (int i = 0; i < n; i++) {
+        double x = in[i];
+        double x_old = s->ring[s->pos];
+        s->ring[s->pos] = in[i];
+        if (++s->pos == s->n_win) s->pos = 0;
+
+        for (int k = 0; k < nb; k++) {
+            sdft_bin_t *b = &s->bin[k];
+            double dr = x - x_old * b->old_re;
+            double di = -x_old * b->old_im;
+            b->acc_re += b->rot_re * dr - b->rot_im * di;
+            b->acc_im += b->rot_re * di + b->rot_im * dr;
+
+            double re = b->rot_re * b->step_re - b->rot_im * b->step_im;
+            double im = b->rot_re * b->step_im + b->rot_im * b->step_re;
+            b->rot_re = re;
+            b->rot_im = im;
+        }
+
+        if (++s->n_renorm == SDFT_RENORM_INTERVAL) {
+            for (int k = 0; k < nb; k++) {
+                sdft_bin_t *b = &s->bin[k];
+                double g = 1.0 / sqrt(b->rot_re * b->rot_re + b->rot_im * b->rot_im);
+                b->rot_re *= g;
+                b->rot_im *= g;
+            }
+            s->n_renorm = 0;
+        }
+
+        if (++s->phase < s->factor) continue;
+        s->phase = 0;
+
+        /* Outputs never overtake the input, so out may alias in */
+        out[m++] = s->scale * bin_mag(&s->bin[0]);
+
+        if (nb > 1) {
+            float floor_mag = bin_mag(&s->bin[1]);
+            if (nb > 2) {
+                float hi = bin_mag(&s->bin[2]);
+                if (hi < floor_mag) floor_mag = hi;
+            }
+            s->noise += s->noise_alpha * (s->scale * floor_mag - s->noise);
+        }
+    }
+    return m;
+}
+
+void sdft_reset(sdft_t *s)
+{
+    for (int k = 0; k < s->n_bins; k++) {
+        sdft_bin_t *b = &s->bin[k];
+        b->acc_re = b->acc_im = 0.0;
+        b->rot_re = 1.0;
+        b->rot_im = 0.0;
+    }
+    memset(s->ring, 0, sizeof(s->ring));
+    s->pos = 0;
+    s->phase = 0;
+    s->n_renorm = 0;
+    s->noise = 0.0f;
+}
@@ -0,0 +1,81 @@
+/**
+ * sdft.h — Sliding-DFT tone detector with neighbour-bin noise floor
+ *
+ * Alternative to bandpass + rectifier + envelope lowpass. Three DFT bins
+ * of an N-sample rectangular window are updated recursively per input
+ * sample: one at center_freq, two at ±SDFT_NOISE_BINS bin spacings. The
+ * tone bin's magnitude is the envelope (the window itself is the
+ * smoothing, bin width = bandwidth); the quieter neighbour gives a noise
+ * floor for the hysteresis.
+ *
+ * Each bin is kept in an absolute-phase frame,
+ *
+ *   A[n] = A[n-1] + e^{-j w n} (x[n] - x[n-N] e^{j w N})
+ *
+ * so the center frequency need not fall on a bin of N. Accumulators and
+ * phasors are double precision; the phasors are renormalized
+ * periodically. Magnitudes are emitted every `factor` inputs.
+ */
+
+#ifndef SDFT_H
+#define SDFT_H
+
+#define SDFT_MAX_WINDOW  4096
+#define SDFT_BINS        3    /* Tone + two neighbours */
+#define SDFT_NOISE_BINS  2    /* Neighbour offset in bin spacings */
+
+typedef struct {
+    double acc_re, acc_im;     /* Windowed DFT, absolute-phase frame */
+    double rot_re, rot_im;     /* e^{-j w n} */
+    double step_re, step_im;   /* e^{-j w} */
+    double old_re, old_im;     /* e^{j w N}: re-phases the leaving sample */
+} sdft_bin_t;
+
+typedef struct {
+    int n_win;                 /* Window N in input samples */
+    int factor;                /* Output every factor inputs */
+    int phase;
+    int pos;                   /* Ring write index */
+    int n_renorm;              /* Inputs since last phasor renormalization */
+    int n_bins;                /* 1 + usable neighbours (below Nyquist, above 0) */
+
+    sdft_bin_t bin[SDFT_BINS]; /* [0] = tone */
+    float scale;               /* 2 / N: bin magnitude → tone amplitude */
+
+    /* Noise floor: smoothed magnitude of the quieter neighbour (0 at start) */
+    float noise;
+    float noise_alpha;
+
+    float ring[SDFT_MAX_WINDOW];
+} sdft_t;
+
+/**
+ * Initialize tone detector.
+ *
+ * @param s            Output struct
+ * @param sample_rate  Input sample rate in Hz
+ * @param factor       Output decimation factor (>= 1)
+ * @param center_freq  Tone frequency in Hz
+ * @param bandwidth    Bin width in Hz (window N = sample_rate / bandwidth)
+ */
+void sdft_init(sdft_t *s, int sample_rate, int factor,
+               float center_freq, float bandwidth);
+
+/**
+ * Update the bins and write the tone magnitude every factor inputs.
+ * out may alias in. s->noise is updated with every output.
+ *
+ * @param s    Detector state
+ * @param in   Input audio
+ * @param n    Number of input samples
+ * @param out  Magnitude output, at most n / factor + 1 samples
+ * @return Number of output samples written
+ */
+int sdft_process(sdft_t *s, const float *in, int n, float *out);
+
+/**
+ * Reset detector state.
+ */
+void sdft_reset(sdft_t *s);
+
+#endif /* SDFT_H */
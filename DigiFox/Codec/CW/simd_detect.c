@@ -3,9 +3,13 @@
  *
  * x86_64: CPUID to detect SSE2/AVX2
  * AArch64: NEON always available (compile-time)
+ *
+ * cw_init_simd() fills the kernel dispatch table from the detected level.
  */
 
 #include "simd_detect.h"
+#include "envelope.h"
+#include "kalman.h"
 #include <stddef.h>
 
 #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
@@ -54,15 +58,114 @@ cw_simd_level_t cw_detect_simd(void)
 }
 
 /* Function pointer dispatch — filled by cw_init_simd() */
-static int _simd_initialized = 0;
+static cw_kernels_t _kernels;
+static volatile int _simd_initialized = 0;
+
+static void fill_scalar(cw_kernels_t *k)
+{
+    k->level            = CW_SIMD_NONE;
+    k->rectify          = envelope_rectify_scalar;
+    k->biquad_cascade   = iir_filter_process;
+    k->multipass        = multipass_process;
+    k->peak             = envelope_peak_scalar;
+    k->hysteresis       = envelope_hysteresis_scalar;
+    k->hysteresis_bits  = envelope_hysteresis_bits_scalar;
+
+    k->rectify_s16      = q15_rectify_scalar;
+    k->dot_s16          = q15_dot_scalar;
+    k->s16_to_float     = q15_to_float_scalar;
+    k->float_to_s16     = q15_from_float_scalar;
+
+    k->lane_width       = 4;
+    k->lanes_biquad     = iir_lanes_process_scalar;
+    k->lanes_multipass  = multipass_lanes_process_scalar;
+    k->lanes_peak       = envelope_lanes_peak_scalar;
+    k->lanes_hysteresis = envelope_lanes_hysteresis_scalar;
+    k->lanes_kalman     = kalman_lanes_update_scalar;
+}
 
 void cw_init_simd(void)
 {
     if (_simd_initialized) return;
+
+    /* Built locally, then published — repeated calls write identical values */
+    cw_kernels_t k;
+    fill_scalar(&k);
+
+    cw_simd_level_t level = cw_detect_simd();
+
+#if defined(CW_ARCH_ARM64)
+    if (level == CW_SIMD_NEON) {
+        k.level            = CW_SIMD_NEON;
+        k.rectify          = envelope_rectify_copy_neon;
+        k.biquad_cascade   = iir_filter_process_neon;
+        k.multipass        = multipass_process_neon;
+        k.peak             = envelope_peak_neon;
+        k.hysteresis       = envelope_hysteresis_neon;
+        k.hysteresis_bits  = envelope_hysteresis_bits_neon;
+
+        k.rectify_s16      = q15_rectify_neon;
+        k.dot_s16          = q15_dot_neon;
+        k.s16_to_float     = q15_to_float_neon;
+        k.float_to_s16     = q15_from_float_neon;
+
+        k.lane_width       = 4;
+        k.lanes_biquad     = iir_lanes_process_neon;
+        k.lanes_multipass  = multipass_lanes_process_neon;
+        k.lanes_peak       = envelope_lanes_peak_neon;
+        k.lanes_hysteresis = envelope_lanes_hysteresis_neon;
+        k.lanes_kalman     = kalman_lanes_update_neon;
+    }
+#elif defined(CW_ARCH_X86)
+    if (level >= CW_SIMD_SSE2) {
+        k.level            = CW_SIMD_SSE2;
+        k.rectify          = envelope_rectify_copy_sse2;
+        k.biquad_cascade   = iir_filter_process_sse2;
+        k.multipass        = multipass_process_sse2;
+        k.peak             = envelope_peak_sse2;
+        k.hysteresis       = envelope_hysteresis_sse2;
+        k.hysteresis_bits  = envelope_hysteresis_bits_sse2;
+
+        k.rectify_s16      = q15_rectify_sse2;
+        k.dot_s16          = q15_dot_sse2;
+        k.s16_to_float     = q15_to_float_sse2;
+        k.float_to_s16     = q15_from_float_sse2;
+
+        k.lane_width       = 4;
+        k.lanes_biquad     = iir_lanes_process_sse2;
+        k.lanes_multipass  = multipass_lanes_process_sse2;
+        k.lanes_peak       = envelope_lanes_peak_sse2;
+        k.lanes_hysteresis = envelope_lanes_hysteresis_sse2;
+        k.lanes_kalman     = kalman_lanes_update_sse2;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    if (level == CW_SIMD_AVX2) {
+        k.level            = CW_SIMD_AVX2;
+        k.rectify          = envelope_rectify_copy_avx2;
+        k.biquad_cascade   = iir_filter_process_avx2;
+        k.multipass        = multipass_process_avx2;
+        k.peak             = envelope_peak_avx2;
+        k.hysteresis       = envelope_hysteresis_avx2;
+        k.hysteresis_bits  = envelope_hysteresis_bits_avx2;
+
+        k.lane_width       = 8;
+        k.lanes_biquad     = iir_lanes_process_avx2;
+        k.lanes_multipass  = multipass_lanes_process_avx2;
+        k.lanes_peak       = envelope_lanes_peak_avx2;
+        k.lanes_hysteresis = envelope_lanes_hysteresis_avx2;
+        k.lanes_kalman     = kalman_lanes_update_avx2;
+    }
+#endif
+#else
+    (void)level;
+#endif
+
+    _kernels = k;
     _simd_initialized = 1;
+}
 
-    /* Currently the scalar code is used for all paths.
-     * SIMD-specific function pointers will be set here
-     * when AVX2/NEON variants are compiled. */
-    (void)cw_detect_simd();  /* Detect but don't dispatch yet */
+const cw_kernels_t *cw_get_kernels(void)
+{
+    if (!_simd_initialized) cw_init_simd();
+    return &_kernels;
 }
@@ -1,10 +1,16 @@
 /**
- * simd_detect.h — Runtime SIMD capability detection
+ * simd_detect.h — Runtime SIMD capability detection and kernel dispatch
  */
 
 #ifndef SIMD_DETECT_H
 #define SIMD_DETECT_H
 
+#include "iir_filter.h"
+#include "kalman.h"
+#include "multipass_avg.h"
+#include "q15.h"
+#include <stdint.h>
+
 typedef enum {
     CW_SIMD_NONE  = 0,
     CW_SIMD_SSE2  = 1,
@@ -17,10 +23,50 @@ typedef enum {
  */
 cw_simd_level_t cw_detect_simd(void);
 
+/*
+ * Hot-kernel dispatch table. Filled once by cw_init_simd() with the
+ * scalar, SSE2, AVX2 or NEON implementation of each kernel.
+ */
+typedef struct {
+    cw_simd_level_t level;
+
+    /* Single-channel kernels */
+    void  (*rectify)(const float *in, float *out, int n);
+    void  (*biquad_cascade)(iir_filter_t *f, float *data, int n);
+    void  (*multipass)(multipass_avg_t *mp, float *data, int n);
+    float (*peak)(const float *data, int n);
+    int   (*hysteresis)(const float *data, int n, float on_thr, float off_thr,
+                        int state, int *on_off);
+    int   (*hysteresis_bits)(const float *data, int n, float on_thr, float off_thr,
+                             int state, uint32_t *bits);
+
+    /* Fixed-point front end kernels (q15.h), 8 int16 lanes */
+    void    (*rectify_s16)(const int16_t *in, int16_t *out, int n);
+    int32_t (*dot_s16)(const int16_t *taps, const int16_t *h, int n);
+    void    (*s16_to_float)(const int16_t *in, float *out, int n);
+    void    (*float_to_s16)(const float *in, int16_t *out, int n);
+
+    /* Lane-parallel kernels (interleaved data, lane_width lanes) */
+    int   lane_width;
+    void  (*lanes_biquad)(iir_lanes_t *fl, float *data, int n);
+    void  (*lanes_multipass)(multipass_lanes_t *mp, float *data, int n);
+    void  (*lanes_peak)(const float *data, int n, int width, float *peak);
+    void  (*lanes_hysteresis)(const float *data, int n, int width,
+                              const float *on_thr, const float *off_thr,
+                              int *state, int *on_off);
+    void  (*lanes_kalman)(kalman_lanes_t *kl, const int *state, const float *z,
+                          int *accepted);
+} cw_kernels_t;
+
 /**
  * Initialize SIMD function pointers (call once at startup).
  * Called automatically by cw_decoder_create() on first use.
  */
 void cw_init_simd(void);
 
+/**
+ * Get the dispatch table (initializes it on first call).
+ */
+const cw_kernels_t *cw_get_kernels(void);
+
 #endif /* SIMD_DETECT_H */
@@ -0,0 +1,99 @@
+/**
+ * spsc_ring.c — Lock-free single-producer / single-consumer ring buffer
+ */
+
+#include "spsc_ring.h"
+#include <stdlib.h>
+#include <string.h>
+
+int spsc_ring_init(spsc_ring_t *r, size_t elem_size, size_t min_capacity)
+{
+    memset(r, 0, sizeof(*r));
+    if (elem_size == 0 || min_capacity == 0) return -1;
+
+    size_t cap = 1;
+    while (cap < min_capacity) cap <<= 1;
+
+    r->buf = (unsigned char *)calloc(cap, elem_size);
+    if (!r->buf) return -1;
+    r->elem_size = elem_size;
+    r->capacity = cap;
+    r->mask = cap - 1;
+    atomic_init(&r->head, 0);
+    atomic_init(&r->tail, 0);
+    return 0;
+}
+
+void spsc_ring_free(spsc_ring_t *r)
+{
+    free(r->buf);
+    memset(r, 0, sizeof(*r));
+}
+
+/* Copy n elements between the ring at index pos and flat memory */
+static void ring_copy_in(spsc_ring_t *r, size_t pos, const unsigned char *src, size_t n)
+{
+    size_t i = pos & r->mask;
+    size_t first = r->capacity - i;
+    if (first > n) first = n;
+    memcpy(r->buf + i * r->elem_size, src, first * r->elem_size);
+    memcpy(r->buf, src + first * r->elem_size, (n - first) * r->elem_size);
+}
+
+static void ring_copy_out(const spsc_ring_t *r, size_t pos, unsigned char *dst, size_t n)
+{
+    size_t i = pos & r->mask;
+    size_t first = r->capacity - i;
+    if (first > n) first = n;
+    memcpy(dst, r->buf + i * r->elem_size, first * r->elem_size);
+    memcpy(dst + first * r->elem_size, r->buf, (n - first) * r->elem_size);
+}
+
+size_t spsc_ring_push(spsc_ring_t *r, const void *src, size_t n)
+{
+    size_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    size_t space = r->capacity - (head - r->tail_cache);
+    if (space < n) {
+        /* Looks full: refresh the consumer's index */
+        r->tail_cache = atomic_load_explicit(&r->tail, memory_order_acquire);
+        space = r->capacity - (head - r->tail_cache);
+    }
+    if (n > space) n = space;
+    if (n == 0) return 0;
+
+    ring_copy_in(r, head, (const unsigned char *)src, n);
+    atomic_store_explicit(&r->head, head + n, memory_order_release);
+    return n;
+}
+
+size_t spsc_ring_pop(spsc_ring_t *r, void *dst, size_t n)
+{
+    size_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    size_t avail = r->head_cache - tail;
+    if (avail < n) {
+        /* Looks empty: refresh the producer's index */
+        r->head_cache = atomic_load_explicit(&r->head, memory_order_acquire);
+        avail = r->head_cache - tail;
+    }
+    if (n > avail) n = avail;
+    if (n == 0) return 0;
+
+    ring_copy_out(r, tail, (unsigned char *)dst, n);
+    atomic_store_explicit(&r->tail, tail + n, memory_order_release);
+    return n;
+}
+
+size_t spsc_ring_count(spsc_ring_t *r)
+{
+    size_t tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+    size_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+    return head - tail;
+}
+
+void spsc_ring_reset(spsc_ring_t *r)
+{
+    atomic_store_explicit(&r->head, 0, memory_order_relaxed);
+    atomic_store_explicit(&r->tail, 0, memory_order_relaxed);
+    r->tail_cache = 0;
+    r->head_cache = 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * spsc_ring.h — Lock-free single-producer / single-consumer ring buffer
+ *
+ * Fixed-size elements in a power-of-two ring. One thread may push and
+ * one other thread may pop concurrently without locks: each index is
+ * written by one side only and published with release / acquire
+ * ordering. push() and pop() never block, allocate or make system
+ * calls, so the producer can be a real-time audio callback.
+ *
+ * The two indices sit on separate cache lines, and each side keeps a
+ * private copy of the other's index so the shared line is only re-read
+ * when the ring looks full (producer) or empty (consumer).
+ *
+ * All memory is allocated in spsc_ring_init().
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+/* Covers the 128-byte lines of Apple silicon as well as 64-byte x86 */
+#define SPSC_CACHE_LINE 128
+
+typedef struct {
+    unsigned char *buf;
+    size_t elem_size;
+    size_t capacity;          /* Elements, power of two */
+    size_t mask;
+
+    /* Producer side */
+    _Atomic size_t head;      /* Next slot to write (monotonic) */
+    size_t tail_cache;        /* Producer's last view of tail */
+    char pad0[SPSC_CACHE_LINE - sizeof(size_t) * 2];
+
+    /* Consumer side */
+    _Atomic size_t tail;      /* Next slot to read (monotonic) */
+    size_t head_cache;        /* Consumer's last view of head */
+    char pad1[SPSC_CACHE_LINE - sizeof(size_t) * 2];
+} spsc_ring_t;
+
+/**
+ * Initialize ring.
+ *
+ * @param r             Output struct
+ * @param elem_size     Bytes per element
+ * @param min_capacity  Elements to hold (rounded up to a power of two)
+ * @return 0 on success, -1 on allocation failure / bad arguments
+ */
+int spsc_ring_init(spsc_ring_t *r, size_t elem_size, size_t min_capacity);
+
+/**
+ * Producer: append up to n elements.
+ *
+ * @return Number of elements written (less than n if the ring is full)
+ */
+size_t spsc_ring_push(spsc_ring_t *r, const void *src, size_t n);
+
+/**
+ * Consumer: remove up to n elements.
+ *
+ * @return Number of elements read (less than n if the ring ran empty)
+ */
+size_t spsc_ring_pop(spsc_ring_t *r, void *dst, size_t n);
+
+/**
+ * Elements currently queued. Exact from either side's own thread at the
+ * time of the call; only a snapshot from anywhere else.
+ */
+size_t spsc_ring_count(spsc_ring_t *r);
+
+/**
+ * Discard all queued elements. Only safe while neither side is active.
+ */
+void spsc_ring_reset(spsc_ring_t *r);
+
+/**
+ * Free ring memory.
+ */
+void spsc_ring_free(spsc_ring_t *r);
+
+#endif /* SPSC_RING_H */
@@ -0,0 +1,334 @@
+/**
+ * task_sched.c — Per-worker deques with stealing and priorities
+ *
+ * Deques are small locked rings: the owner pushes and pops at the tail,
+ * thieves take from the head. A lock per deque is uncontended unless a
+ * thief is at the same deque, and a task is far longer than the lock.
+ */
+
+#include "task_sched.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+
+/* Tasks one deque holds, power of two; more spill onto the submitter */
+#define TASK_QUEUE_SIZE 128
+
+typedef struct {
+    atomic_int pending;       /* Tasks submitted and not finished */
+} task_group_t;
+
+typedef struct {
+    task_fn fn;
+    void *ctx;
+    int index;
+    task_group_t *group;
+} task_t;
+
+typedef struct {
+    pthread_mutex_t lock;
+    unsigned head;            /* Oldest task (thieves) */
+    unsigned tail;            /* Next free slot (owner) */
+    task_t ring[TASK_QUEUE_SIZE];
+} task_deque_t;
+
+typedef struct {
+    task_sched_t *sched;
+    int id;
+} worker_arg_t;
+
+struct task_sched_t {
+    int n_threads;
+    pthread_t *threads;
+    worker_arg_t *args;
+    int n_started;
+
+    /* (n_threads + 1) x TASK_PRIO_COUNT: one set per worker, then the
+     * injection queues of threads outside the scheduler */
+    task_deque_t *deques;
+
+    atomic_int queued[TASK_PRIO_COUNT];   /* Tasks sitting in deques */
+
+    pthread_mutex_t lock;
+    pthread_cond_t  wake;     /* Work queued, a group finished, or shutdown */
+    int shutdown;
+};
+
+/* Which scheduler and deque set the current thread works for */
+static _Thread_local task_sched_t *t_sched;
+static _Thread_local int t_self;
+
+static task_deque_t *deque_of(task_sched_t *s, int owner, int prio)
+{
+    return &s->deques[owner * TASK_PRIO_COUNT + prio];
+}
+
+/* ------------------------------------------------------------------ */
+/* Deques                                                              */
+/* ------------------------------------------------------------------ */
+
+static int push(task_deque_t *q, const task_t *t)
+{
+    int ok = 0;
+    pthread_mutex_lock(&q->lock);
+    if (q->tail - q->head < TASK_QUEUE_SIZE) {
+        q->ring[q->tail++ & (TASK_QUEUE_SIZE - 1)] = *t;
+        ok = 1;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return ok;
+}
+
+static int pop_newest(task_deque_t *q, task_t *t)
+{
+    int ok = 0;
+    pthread_mutex_lock(&q->lock);
+    if (q->tail != q->head) {
+        *t = q->ring[--q->tail & (TASK_QUEUE_SIZE - 1)];
+        ok = 1;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return ok;
+}
+
+static int steal_oldest(task_deque_t *q, task_t *t)
+{
+    int ok = 0;
+    pthread_mutex_lock(&q->lock);
+    if (q->tail != q->head) {
+        *t = q->ring[q->head++ & (TASK_QUEUE_SIZE - 1)];
+        ok = 1;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return ok;
+}
+
+/* ------------------------------------------------------------------ */
+/* Taking and running tasks                                            */
+/* ------------------------------------------------------------------ */
+
+static int queued_upto(task_sched_t *s, int max_prio)
+{
+    for (int p = 0; p <= max_prio; p++) {
+        if (atomic_load_explicit(&s->queued[p], memory_order_acquire) > 0) return 1;
+    }
+    return 0;
+}
+
+/*
+ * Most urgent task up to max_prio: own deque first (newest, still warm
+ * in cache), then the injection queue and the other workers' (oldest,
+ * the largest piece of work left), starting after self so thieves
+ * spread out.
+ */
+static int take(task_sched_t *s, int self, int max_prio, task_t *t)
+{
+    const int n_owners = s->n_threads + 1;
+
+    for (int p = 0; p <= max_prio; p++) {
+        if (atomic_load_explicit(&s->queued[p], memory_order_acquire) <= 0) continue;
+
+        int ok = self < s->n_threads && pop_newest(deque_of(s, self, p), t);
+        for (int k = 1; !ok && k < n_owners; k++) {
+            ok = steal_oldest(deque_of(s, (self + k) % n_owners, p), t);
+        }
+        if (ok) {
+            atomic_fetch_sub_explicit(&s->queued[p], 1, memory_order_relaxed);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void run(task_sched_t *s, const task_t *t)
+{
+    task_group_t *g = t->group;
+    t->fn(t->ctx, t->index);
+
+    /* The group lives on its waiter's stack: not touched after this */
+    if (atomic_fetch_sub_explicit(&g->pending, 1, memory_order_acq_rel) == 1) {
+        pthread_mutex_lock(&s->lock);
+        pthread_cond_broadcast(&s->wake);
+        pthread_mutex_unlock(&s->lock);
+    }
+}
+
+static void *worker_main(void *arg)
+{
+    task_sched_t *s = ((worker_arg_t *)arg)->sched;
+    const int self = ((worker_arg_t *)arg)->id;
+    t_sched = s;
+    t_self = self;
+
+    for (;;) {
+        task_t t;
+        if (take(s, self, TASK_PRIO_COUNT - 1, &t)) {
+            run(s, &t);
+            continue;
+        }
+
+        pthread_mutex_lock(&s->lock);
+        while (!s->shutdown && !queued_upto(s, TASK_PRIO_COUNT - 1)) {
+            pthread_cond_wait(&s->wake, &s->lock);
+        }
+        int stop = s->shutdown;
+        pthread_mutex_unlock(&s->lock);
+        if (stop) break;
+    }
+    return NULL;
+}
+
+/* ------------------------------------------------------------------ */
+/* Public API                                                          */
+/* ------------------------------------------------------------------ */
+
+int task_sched_cores(void)
+{
+#if defined(__APPLE__)
+    int perf = 0;
+    size_t len = sizeof(perf);
+    if (sysctlbyname("hw.perflevel0.logicalcpu", &perf, &len, NULL, 0) == 0 && perf > 0) {
+        return perf;
+    }
+#endif
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+task_sched_t *task_sched_create(int n_threads)
+{
+    if (n_threads < 0) return NULL;
+
+    task_sched_t *s = (task_sched_t *)calloc(1, sizeof(task_sched_t));
+    if (!s) return NULL;
+    s->n_threads = n_threads;
+
+    const int n_deques = (n_threads + 1) * TASK_PRIO_COUNT;
+    s->deques = (task_deque_t *)calloc((size_t)n_deques, sizeof(task_deque_t));
+    if (!s->deques || pthread_mutex_init(&s->lock, NULL) != 0) {
+        free(s->deques);
+        free(s);
+        return NULL;
+    }
+    pthread_cond_init(&s->wake, NULL);
+    for (int k = 0; k < n_deques; k++) pthread_mutex_init(&s->deques[k].lock, NULL);
+    for (int p = 0; p < TASK_PRIO_COUNT; p++) atomic_init(&s->queued[p], 0);
+
+    if (n_threads > 0) {
+        s->threads = (pthread_t *)calloc((size_t)n_threads, sizeof(pthread_t));
+        s->args = (worker_arg_t *)calloc((size_t)n_threads, sizeof(worker_arg_t));
+        if (!s->threads || !s->args) {
+            task_sched_destroy(s);
+            return NULL;
+        }
+        for (int i = 0; i < n_threads; i++) {
+            s->args[i].sched = s;
+            s->args[i].id = i;
+            if (pthread_create(&s->threads[i], NULL, worker_main, &s->args[i]) != 0) {
+                task_sched_destroy(s);
+                return NULL;
+            }
+            s->n_started++;
+        }
+    }
+    return s;
+}
+
+static task_sched_t *s_shared;
+static pthread_once_t s_shared_once = PTHREAD_ONCE_INIT;
+
+static void shared_init(void)
+{
+    s_shared = task_sched_create(task_sched_cores() - 1);
+}
+
+task_sched_t *task_sched_shared(void)
+{
+    pthread_once(&s_shared_once, shared_init);
+    return s_shared;
+}
+
+int task_sched_concurrency(const task_sched_t *s)
+{
+    return s ? s->n_threads + 1 : 1;
+}
+
+void task_sched_parallel(task_sched_t *s, task_prio_t prio, int n,
+                         task_fn fn, void *ctx)
+{
+    if (n <= 0) return;
+    if (!s || s->n_threads == 0 || n == 1) {
+        for (int i = 0; i < n; i++) fn(ctx, i);
+        return;
+    }
+
+    const int self = t_sched == s ? t_self : s->n_threads;
+    task_deque_t *q = deque_of(s, self, prio);
+
+    task_group_t g;
+    atomic_init(&g.pending, 0);
+
+    /* Counted before they are visible, so neither count goes negative */
+    int spill = n;
+    for (int i = 1; i < n; i++) {
+        task_t t = { fn, ctx, i, &g };
+        atomic_fetch_add_explicit(&g.pending, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&s->queued[prio], 1, memory_order_release);
+        if (!push(q, &t)) {
+            atomic_fetch_sub_explicit(&s->queued[prio], 1, memory_order_relaxed);
+            atomic_fetch_sub_explicit(&g.pending, 1, memory_order_relaxed);
+            spill = i;
+            break;
+        }
+    }
+
+    pthread_mutex_lock(&s->lock);
+    pthread_cond_broadcast(&s->wake);
+    pthread_mutex_unlock(&s->lock);
+
+    fn(ctx, 0);
+    for (int i = spill; i < n; i++) fn(ctx, i);
+
+    /* Help instead of sleeping, but never with less urgent work */
+    while (atomic_load_explicit(&g.pending, memory_order_acquire) > 0) {
+        task_t t;
+        if (take(s, self, prio, &t)) {
+            run(s, &t);
+            continue;
+        }
+
+        pthread_mutex_lock(&s->lock);
+        while (atomic_load_explicit(&g.pending, memory_order_acquire) > 0 &&
+               !queued_upto(s, prio)) {
+            pthread_cond_wait(&s->wake, &s->lock);
+        }
+        pthread_mutex_unlock(&s->lock);
+    }
+}
+
+void task_sched_destroy(task_sched_t *s)
+{
+    if (!s) return;
+
+    pthread_mutex_lock(&s->lock);
+    s->shutdown = 1;
+    pthread_cond_broadcast(&s->wake);
+    pthread_mutex_unlock(&s->lock);
+
+    for (int i = 0; i < s->n_started; i++) pthread_join(s->threads[i], NULL);
+
+    const int n_deques = (s->n_threads + 1) * TASK_PRIO_COUNT;
+    for (int k = 0; k < n_deques; k++) pthread_mutex_destroy(&s->deques[k].lock);
+    pthread_cond_destroy(&s->wake);
+    pthread_mutex_destroy(&s->lock);
+    free(s->threads);
+    free(s->args);
+    free(s->deques);
+    free(s);
+}
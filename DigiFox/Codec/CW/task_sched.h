@@ -0,0 +1,92 @@
+/**
+ * task_sched.h — Shared work-stealing scheduler for decode jobs
+ *
+ * One process-wide set of worker threads, one per performance core less
+ * the thread that submits, which every decoder hands its parallel work
+ * to: CW lane groups, FT8/JS8 candidates, WSPR passes and batch ggmorse
+ * segments share the same cores instead of each starting threads of
+ * their own.
+ *
+ * Each worker owns a deque per priority. Tasks a worker submits go on
+ * its own deque and are popped newest first; idle workers steal the
+ * oldest task of another's. Threads outside the scheduler (audio, slot
+ * timers) submit through a shared injection queue. Every thread takes
+ * the most urgent task available anywhere, so a live CW channel queued
+ * behind slot-end LDPC work still runs first.
+ *
+ * task_sched_parallel() is fork-join, and the submitting thread does
+ * not sleep while its tasks are queued: it runs them itself, along with
+ * anything at least as urgent, so a waiting decoder keeps its core busy
+ * rather than adding a thread to it.
+ *
+ * Queues are fixed rings allocated with the scheduler; submitting and
+ * waiting allocate nothing. A task that finds its queue full runs on
+ * the submitting thread.
+ */
+
+#ifndef TASK_SCHED_H
+#define TASK_SCHED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct task_sched_t task_sched_t;
+
+/* Most urgent first */
+typedef enum {
+    TASK_PRIO_REALTIME = 0,   /* Live CW channels: paced by the audio */
+    TASK_PRIO_SLOT     = 1,   /* FT8/JS8/WSPR decode at the end of a slot */
+    TASK_PRIO_BATCH    = 2,   /* Whole recordings, archive scans */
+    TASK_PRIO_COUNT
+} task_prio_t;
+
+/* Runs once per task; index is 0 .. n - 1 of task_sched_parallel() */
+typedef void (*task_fn)(void *ctx, int index);
+
+/**
+ * Performance cores on this machine (Apple: hw.perflevel0, else all
+ * online CPUs), at least 1.
+ */
+int task_sched_cores(void);
+
+/**
+ * The process-wide scheduler, started on first use with
+ * task_sched_cores() - 1 workers. NULL if it could not start, in which
+ * case task_sched_parallel() runs everything on the caller.
+ */
+task_sched_t *task_sched_shared(void);
+
+/**
+ * Create a scheduler of its own (tests, benchmarks).
+ *
+ * @param n_threads  Worker threads, >= 0 (0 = callers run every task)
+ * @return           Scheduler, or NULL on failure
+ */
+task_sched_t *task_sched_create(int n_threads);
+
+/**
+ * Threads that can run tasks at once: the workers plus the caller.
+ */
+int task_sched_concurrency(const task_sched_t *s);
+
+/**
+ * Run fn(ctx, i) for i = 0 .. n - 1 and wait for all of them. The caller
+ * runs index 0 itself; the rest may run on any thread, in any order.
+ * May be called from inside a task. With s NULL everything runs in
+ * order on the caller.
+ */
+void task_sched_parallel(task_sched_t *s, task_prio_t prio, int n,
+                         task_fn fn, void *ctx);
+
+/**
+ * Stop and join the workers. Nothing may be running on s.
+ * The shared scheduler is never destroyed.
+ */
+void task_sched_destroy(task_sched_t *s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TASK_SCHED_H */
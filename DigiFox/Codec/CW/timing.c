@@ -5,6 +5,7 @@
  */
 
 #include "timing.h"
+#include "simd_detect.h"
 #include <math.h>
 #include <string.h>
 
@@ -32,29 +33,80 @@ void timing_init(timing_t *t, timing_mode_t mode, int sample_rate,
     }
 }
 
-/* Classify a signal (mark) duration */
-static int classify_signal_kalman(timing_t *t, int dur)
+void timing_set_limits(timing_t *t, float min_wpm, float max_wpm,
+                       float min_element_ratio, float min_element_s)
+{
+    t->min_element_ratio = min_element_ratio;
+    t->min_element_abs = (int)(min_element_s * (float)t->sample_rate);
+
+    /* Bumps the generation, so the cached limits are redone too */
+    if (t->mode == TIMING_MODE_KALMAN) {
+        kalman_set_bounds(&t->kalman, min_wpm, max_wpm);
+    }
+}
+
+/* Refresh the integer Kalman limits after a state change */
+static void kalman_limits(timing_t *t)
 {
+    if (t->kal_generation == t->kalman.generation) return;
+    t->kal_generation = t->kalman.generation;
+
     float avg_dit = kalman_get_duration(&t->kalman, K_DIT);
     int min_dur = (int)(avg_dit * t->min_element_ratio);
     if (min_dur < t->min_element_abs) min_dur = t->min_element_abs;
+    t->kal_min_dur = min_dur;
 
-    if (dur < min_dur) return ELEM_NONE;  /* Noise */
+    t->kal_dah  = (int)ceilf(kalman_get_threshold(&t->kalman, K_DIT, K_DAH));
+    t->kal_char = (int)ceilf(kalman_get_threshold(&t->kalman, K_ELEM_SPACE, K_CHAR_SPACE));
+    t->kal_word = (int)ceilf(kalman_get_threshold(&t->kalman, K_CHAR_SPACE, K_WORD_SPACE));
+}
+
+/* Score a mark against the dit or dah length it was taken for */
+static void mark_fit(timing_t *t, int dur, int dah)
+{
+    float ideal;
+    if (t->mode == TIMING_MODE_KALMAN) {
+        ideal = kalman_get_duration(&t->kalman, dah ? K_DAH : K_DIT);
+    } else {
+        ideal = dah ? 3.0f * t->avg_dit : t->avg_dit;
+    }
+    float err = fabsf(log2f((float)dur / ideal));
+    float score = err < 1.0f ? 1.0f - err : 0.0f;
+    t->fit += 0.2f * (score - t->fit);
+}
+
+/*
+ * Classify a signal (mark) duration. *update is set to the state the
+ * duration measures once warmed up, else -1; the caller runs the update.
+ */
+static inline int classify_signal_kalman_state(timing_t *t, int dur, int *update)
+{
+    *update = -1;
+    kalman_limits(t);
+    if (dur < t->kal_min_dur) return ELEM_NONE;  /* Noise */
 
     t->element_count++;
     int warm = (t->element_count > TIMING_KALMAN_WARMUP);
 
-    float thresh = kalman_get_threshold(&t->kalman, K_DIT, K_DAH);
-
-    if ((float)dur < thresh) {
-        if (warm) kalman_update(&t->kalman, K_DIT, (float)dur);
+    if (dur < t->kal_dah) {
+        mark_fit(t, dur, 0);
+        if (warm) *update = K_DIT;
         return ELEM_DIT;
     } else {
-        if (warm) kalman_update(&t->kalman, K_DAH, (float)dur);
+        mark_fit(t, dur, 1);
+        if (warm) *update = K_DAH;
         return ELEM_DAH;
     }
 }
 
+static int classify_signal_kalman(timing_t *t, int dur)
+{
+    int update;
+    int elem = classify_signal_kalman_state(t, dur, &update);
+    if (update >= 0) kalman_update(&t->kalman, update, (float)dur);
+    return elem;
+}
+
 static int classify_signal_ema(timing_t *t, int dur)
 {
     int min_dur = (int)(t->avg_dit * t->min_element_ratio);
@@ -63,7 +115,9 @@ static int classify_signal_ema(timing_t *t, int dur)
     if (dur < min_dur) return ELEM_NONE;
 
     float thresh = t->avg_dit * t->dit_dah_threshold;
-    if ((float)dur < thresh) {
+    int dah = (float)dur >= thresh;
+    mark_fit(t, dur, dah);
+    if (!dah) {
         /* Update dit estimate (EMA) */
         t->avg_dit = (1.0f - t->ema_alpha) * t->avg_dit + t->ema_alpha * (float)dur;
         return ELEM_DIT;
@@ -71,26 +125,32 @@ static int classify_signal_ema(timing_t *t, int dur)
     return ELEM_DAH;
 }
 
-/* Classify a gap (space) duration */
-static int classify_gap_kalman(timing_t *t, int dur)
+/* Classify a gap (space) duration; *update as classify_signal_kalman_state() */
+static inline int classify_gap_kalman_state(timing_t *t, int dur, int *update)
 {
     int warm = (t->element_count > TIMING_KALMAN_WARMUP);
 
-    float word_thresh = kalman_get_threshold(&t->kalman, K_CHAR_SPACE, K_WORD_SPACE);
-    float char_thresh = kalman_get_threshold(&t->kalman, K_ELEM_SPACE, K_CHAR_SPACE);
-
-    if ((float)dur >= word_thresh) {
-        if (warm) kalman_update(&t->kalman, K_WORD_SPACE, (float)dur);
+    kalman_limits(t);
+    if (dur >= t->kal_word) {
+        *update = warm ? K_WORD_SPACE : -1;
         return ELEM_WORD;
-    } else if ((float)dur >= char_thresh) {
-        if (warm) kalman_update(&t->kalman, K_CHAR_SPACE, (float)dur);
+    } else if (dur >= t->kal_char) {
+        *update = warm ? K_CHAR_SPACE : -1;
         return ELEM_CHAR;
     } else {
-        if (warm) kalman_update(&t->kalman, K_ELEM_SPACE, (float)dur);
+        *update = warm ? K_ELEM_SPACE : -1;
         return ELEM_NONE;
     }
 }
 
+static int classify_gap_kalman(timing_t *t, int dur)
+{
+    int update;
+    int elem = classify_gap_kalman_state(t, dur, &update);
+    if (update >= 0) kalman_update(&t->kalman, update, (float)dur);
+    return elem;
+}
+
 static int classify_gap_ema(timing_t *t, int dur)
 {
     float word_thresh = t->avg_dit * t->word_pause_ratio;
@@ -103,6 +163,8 @@ static int classify_gap_ema(timing_t *t, int dur)
 
 int timing_process_sample(timing_t *t, int on)
 {
+    if (t->use_hmm) return timing_process_run(t, on ? 1 : -1);
+
     int result = ELEM_NONE;
 
     if (on) {
@@ -145,8 +207,286 @@ int timing_process_sample(timing_t *t, int on)
     return result;
 }
 
+int timing_process_run(timing_t *t, int run)
+{
+    if (run == 0) return ELEM_NONE;
+    if (t->use_hmm) {
+        int elem;
+        return timing_process_runs_hmm(t, &run, 1, &elem) ? elem : ELEM_NONE;
+    }
+
+    /* Transitions happen on the first sample; the rest only accumulate */
+    int on = run > 0;
+    int len = on ? run : -run;
+    int result = timing_process_sample(t, on);
+    if (on) {
+        t->on_dur += len - 1;
+    } else {
+        t->off_dur += len - 1;
+    }
+    return result;
+}
+
+/*
+ * Run loop with the classifiers fixed at compile time: one instance per
+ * timing mode, so the transition logic and the classifier inline into a
+ * single loop with no per-run mode test. Same results as calling
+ * timing_process_run() per run.
+ */
+#define TIMING_DEFINE_RUNS(name, classify_signal, classify_gap)                \
+int name(timing_t *t, const int *runs, int n_runs, int *elems)                 \
+{                                                                              \
+    int count = 0;                                                             \
+    for (int i = 0; i < n_runs; i++) {                                         \
+        int run = runs[i];                                                     \
+        if (run > 0) {                                                         \
+            /* OFF → ON: classify the gap */                                   \
+            if (!t->prev_on) {                                                 \
+                if (t->seen_signal) {                                          \
+                    int elem = classify_gap(t, t->off_dur);                    \
+                    if (elem != ELEM_NONE) elems[count++] = elem;              \
+                }                                                              \
+                t->off_dur = 0;                                                \
+            }                                                                  \
+            t->on_dur += run;                                                  \
+            t->prev_on = 1;                                                    \
+        } else if (run < 0) {                                                  \
+            /* ON → OFF: classify the signal */                                \
+            if (t->prev_on) {                                                  \
+                int elem = classify_signal(t, t->on_dur);                      \
+                if (elem != ELEM_NONE) elems[count++] = elem;                  \
+                t->on_dur = 0;                                                 \
+                t->seen_signal = 1;                                            \
+            }                                                                  \
+            t->off_dur -= run;                                                 \
+            t->prev_on = 0;                                                    \
+        }                                                                      \
+    }                                                                          \
+    return count;                                                              \
+}
+
+TIMING_DEFINE_RUNS(timing_process_runs_kalman, classify_signal_kalman, classify_gap_kalman)
+TIMING_DEFINE_RUNS(timing_process_runs_ema, classify_signal_ema, classify_gap_ema)
+
+/* ------------------------------------------------------------------ */
+/* Multi-channel Kalman                                                */
+/* ------------------------------------------------------------------ */
+
+/*
+ * Run index i of every lane per step, as TIMING_DEFINE_RUNS: transitions
+ * are classified per lane, then the filter updates they call for go to
+ * the lane kernel together. An accepted update is stored straight back
+ * into the channel's kalman_t (generation bumped), so the limits and
+ * mark fit of its next transition see it as kalman_update() would.
+ */
+void timing_process_runs_lanes(timing_t *const *t, int n, kalman_lanes_t *kl,
+                               int *const *runs, const int *n_runs, int *n_elems)
+{
+    const cw_kernels_t *k = cw_get_kernels();
+    int state[KALMAN_MAX_LANES], accepted[KALMAN_MAX_LANES];
+    float z[KALMAN_MAX_LANES];
+
+    int steps = 0;
+    for (int l = 0; l < kl->width; l++) {
+        state[l] = -1;
+        z[l] = 0.0f;
+        if (l >= n) continue;
+        kalman_lanes_load(kl, l, &t[l]->kalman);
+        n_elems[l] = 0;
+        if (n_runs[l] > steps) steps = n_runs[l];
+    }
+
+    for (int i = 0; i < steps; i++) {
+        int pending = 0;
+        for (int l = 0; l < n; l++) {
+            state[l] = -1;
+            if (i >= n_runs[l]) continue;
+
+            timing_t *tl = t[l];
+            int run = runs[l][i];
+            int elem = ELEM_NONE, dur = 0;
+            if (run > 0) {
+                /* OFF → ON: classify the gap */
+                if (!tl->prev_on) {
+                    if (tl->seen_signal) {
+                        dur = tl->off_dur;
+                        elem = classify_gap_kalman_state(tl, dur, &state[l]);
+                    }
+                    tl->off_dur = 0;
+                }
+                tl->on_dur += run;
+                tl->prev_on = 1;
+            } else if (run < 0) {
+                /* ON → OFF: classify the signal */
+                if (tl->prev_on) {
+                    dur = tl->on_dur;
+                    elem = classify_signal_kalman_state(tl, dur, &state[l]);
+                    tl->on_dur = 0;
+                    tl->seen_signal = 1;
+                }
+                tl->off_dur -= run;
+                tl->prev_on = 0;
+            }
+            if (elem != ELEM_NONE) runs[l][n_elems[l]++] = elem;
+            if (state[l] >= 0) {
+                z[l] = logf((float)dur);
+                pending = 1;
+            }
+        }
+        if (!pending) continue;
+
+        k->lanes_kalman(kl, state, z, accepted);
+        for (int l = 0; l < n; l++) {
+            if (!accepted[l]) continue;
+            kalman_lanes_store(kl, l, &t[l]->kalman);
+            t[l]->kalman.generation++;
+        }
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Duration HMM                                                        */
+/* ------------------------------------------------------------------ */
+
+/* EMA mode: ITU ratios to the dit, with a fixed log-space spread */
+#define HMM_EMA_VAR 0.1f
+
+void timing_set_hmm(timing_t *t, int on)
+{
+    t->use_hmm = on;
+    if (on) {
+        duration_hmm_init(&t->hmm);
+        t->hmm_generation = t->kalman.generation - 1u;
+        t->hmm_dit = 0.0f;
+    }
+}
+
+/* Hand the HMM the current timing estimate, if it changed */
+static void hmm_model(timing_t *t)
+{
+    float mu[KALMAN_STATES], var[KALMAN_STATES];
+    if (t->mode == TIMING_MODE_KALMAN) {
+        const kalman_t *k = &t->kalman;
+        if (t->hmm_generation == k->generation) return;
+        t->hmm_generation = k->generation;
+        /* Predictive spread: the estimate's own plus the measurement's */
+        for (int s = 0; s < KALMAN_STATES; s++) {
+            mu[s] = k->x[s];
+            var[s] = k->P[s] + k->R;
+        }
+    } else {
+        static const float ratio[KALMAN_STATES] = { 1.0f, 3.0f, 1.0f, 3.0f, 7.0f };
+        if (t->hmm_dit == t->avg_dit) return;
+        t->hmm_dit = t->avg_dit;
+        for (int s = 0; s < KALMAN_STATES; s++) {
+            mu[s] = logf(t->avg_dit * ratio[s]);
+            var[s] = HMM_EMA_VAR;
+        }
+    }
+    duration_hmm_set_model(&t->hmm, mu, var);
+}
+
+static int hmm_min_dur(timing_t *t)
+{
+    if (t->mode == TIMING_MODE_KALMAN) {
+        kalman_limits(t);
+        return t->kal_min_dur;
+    }
+    int min_dur = (int)(t->avg_dit * t->min_element_ratio);
+    return min_dur < t->min_element_abs ? t->min_element_abs : min_dur;
+}
+
+/* Feed the timing estimate what the HMM's best path made of a duration */
+static void hmm_learn(timing_t *t, int state, int dur)
+{
+    if (t->mode == TIMING_MODE_KALMAN) {
+        if (t->element_count > TIMING_KALMAN_WARMUP) {
+            kalman_update(&t->kalman, state, (float)dur);
+        }
+    } else if (state == K_DIT) {
+        t->avg_dit = (1.0f - t->ema_alpha) * t->avg_dit + t->ema_alpha * (float)dur;
+    }
+}
+
+/* A mark ended: observe the gap before it and the mark itself */
+static void hmm_mark(timing_t *t, int dur)
+{
+    if (dur < hmm_min_dur(t)) {
+        /* Noise: part of the gap, which goes on */
+        t->off_dur = t->hmm_gap + dur;
+        t->hmm_gap = 0;
+        return;
+    }
+
+    hmm_model(t);
+    if (t->seen_signal) {
+        hmm_learn(t, duration_hmm_space(&t->hmm, t->hmm_gap), t->hmm_gap);
+    }
+    t->element_count++;
+    int state = duration_hmm_mark(&t->hmm, dur);
+    mark_fit(t, dur, state == K_DAH);
+    hmm_learn(t, state, dur);
+    t->hmm_gap = 0;
+    t->seen_signal = 1;
+}
+
+/*
+ * Run loop through the HMM: a gap is held until the mark after it is
+ * accepted, so a noise spike merges into the gap around it instead of
+ * splitting it. Decided elements are drained one per run, which keeps
+ * elems from overtaking runs when they alias.
+ */
+int timing_process_runs_hmm(timing_t *t, const int *runs, int n_runs, int *elems)
+{
+    int count = 0;
+    for (int i = 0; i < n_runs; i++) {
+        int run = runs[i];
+        if (run > 0) {
+            /* OFF → ON: the gap waits for this mark */
+            if (!t->prev_on) {
+                t->hmm_gap = t->off_dur;
+                t->off_dur = 0;
+            }
+            t->on_dur += run;
+            t->prev_on = 1;
+        } else if (run < 0) {
+            /* ON → OFF */
+            if (t->prev_on) {
+                hmm_mark(t, t->on_dur);
+                t->on_dur = 0;
+            }
+            t->off_dur -= run;
+            t->prev_on = 0;
+        }
+
+        int elem = duration_hmm_pop(&t->hmm);
+        if (elem != ELEM_NONE) elems[count++] = elem;
+    }
+    return count;
+}
+
+int timing_process_runs(timing_t *t, const int *runs, int n_runs, int *elems)
+{
+    if (t->use_hmm) {
+        return timing_process_runs_hmm(t, runs, n_runs, elems);
+    }
+    if (t->mode == TIMING_MODE_KALMAN) {
+        return timing_process_runs_kalman(t, runs, n_runs, elems);
+    }
+    return timing_process_runs_ema(t, runs, n_runs, elems);
+}
+
 int timing_finalize(timing_t *t)
 {
+    if (t->use_hmm) {
+        /* The last mark, then everything still undecided (finishing
+         * again adds nothing) */
+        if (t->on_dur > 0 && t->seen_signal) hmm_mark(t, t->on_dur);
+        t->on_dur = 0;
+        duration_hmm_finish(&t->hmm);
+        return duration_hmm_pop(&t->hmm);
+    }
+
     /* If we have a pending on-duration, classify it */
     if (t->on_dur > 0 && t->seen_signal) {
         int result;
@@ -172,6 +512,11 @@ float timing_get_wpm(const timing_t *t)
     return 1.2f / dit_s;
 }
 
+float timing_get_fit(const timing_t *t)
+{
+    return t->fit;
+}
+
 void timing_reset(timing_t *t, float initial_wpm)
 {
     float dit_s = 1.2f / initial_wpm;
@@ -181,8 +526,15 @@ void timing_reset(timing_t *t, float initial_wpm)
     t->prev_on = 0;
     t->seen_signal = 0;
     t->element_count = 0;
+    t->fit = 0.0f;
+    t->hmm_gap = 0;
 
     if (t->mode == TIMING_MODE_KALMAN) {
         kalman_reset(&t->kalman, initial_wpm);
     }
+    if (t->use_hmm) {
+        duration_hmm_reset(&t->hmm);
+        t->hmm_generation = t->kalman.generation - 1u;
+        t->hmm_dit = 0.0f;
+    }
 }
@@ -2,13 +2,15 @@
  * timing.h — Element classification: mark/space durations → Morse elements
  *
  * Tracks on/off transitions, classifies durations as dit/dah/char_gap/word_gap.
- * Supports Kalman and EMA timing modes.
+ * Supports Kalman and EMA timing modes, each optionally through the
+ * duration HMM (duration_hmm.h) instead of per-duration thresholds.
  */
 
 #ifndef TIMING_H
 #define TIMING_H
 
 #include "kalman.h"
+#include "duration_hmm.h"
 
 #define TIMING_KALMAN_WARMUP 8
 
@@ -31,6 +33,15 @@ typedef struct {
     /* Kalman filter (Kalman mode) */
     kalman_t kalman;
 
+    /* Kalman-derived limits as integer sample counts, valid while
+     * kalman.generation == kal_generation: a duration d satisfies
+     * (float)d < thr  exactly when  d < ceil(thr). */
+    unsigned kal_generation;
+    int kal_min_dur;          /* Noise reject floor */
+    int kal_dah;              /* dit/dah threshold */
+    int kal_char;             /* elem/char space threshold */
+    int kal_word;             /* char/word space threshold */
+
     /* EMA state */
     float avg_dit;            /* Average dit duration in samples */
     float ema_alpha;          /* Smoothing factor (default 0.1) */
@@ -50,6 +61,15 @@ typedef struct {
     int prev_on;              /* Previous state */
     int seen_signal;          /* True after first element */
     int element_count;        /* Element counter for warmup */
+    float fit;                /* Smoothed mark fit, 0..1 (timing_get_fit()) */
+
+    /* Duration HMM (timing_set_hmm()): the gap before a mark is observed
+     * once the mark proves not to be noise */
+    int use_hmm;
+    int hmm_gap;              /* Gap awaiting its mark, samples */
+    unsigned hmm_generation;  /* Model source last given to the HMM */
+    float hmm_dit;
+    duration_hmm_t hmm;
 } timing_t;
 
 /**
@@ -59,6 +79,19 @@ void timing_init(timing_t *t, timing_mode_t mode, int sample_rate,
                  float initial_wpm, float min_wpm, float max_wpm,
                  float min_element_ratio, float min_element_s);
 
+/**
+ * Classify through the duration HMM (on) or the thresholds (off).
+ * Elements then come out as the HMM decides them, not per transition.
+ */
+void timing_set_hmm(timing_t *t, int on);
+
+/**
+ * Change the WPM bounds (Kalman mode) and the noise-reject limits,
+ * keeping the speed estimate and the current mark/space.
+ */
+void timing_set_limits(timing_t *t, float min_wpm, float max_wpm,
+                       float min_element_ratio, float min_element_s);
+
 /**
  * Process a single on/off sample.
  * Returns element code (ELEM_DIT, ELEM_DAH, ELEM_CHAR, ELEM_WORD, or ELEM_NONE).
@@ -66,7 +99,50 @@ void timing_init(timing_t *t, timing_mode_t mode, int sample_rate,
 int timing_process_sample(timing_t *t, int on);
 
 /**
- * Finalize: emit pending element (if any).
+ * Process a run of identical on/off samples.
+ * A run is a signed length: +len for len on-samples, -len for len
+ * off-samples. Same result as len calls to timing_process_sample() —
+ * only the first sample of a run can produce an element.
+ */
+int timing_process_run(timing_t *t, int run);
+
+/**
+ * Process a sequence of runs (see timing_process_run()).
+ *
+ * @param t       Timing state
+ * @param runs    Signed run lengths
+ * @param n_runs  Number of runs
+ * @param elems   Output element codes, at most n_runs (may alias runs)
+ * @return Number of elements written (ELEM_NONE results are skipped)
+ */
+int timing_process_runs(timing_t *t, const int *runs, int n_runs, int *elems);
+
+/**
+ * timing_process_runs() for a decoder whose mode is known up front
+ * (TIMING_MODE_KALMAN / TIMING_MODE_EMA respectively). t->mode must match.
+ */
+int timing_process_runs_kalman(timing_t *t, const int *runs, int n_runs, int *elems);
+int timing_process_runs_ema(timing_t *t, const int *runs, int n_runs, int *elems);
+
+/**
+ * timing_process_runs() with the duration HMM on (either mode). At most
+ * one decided element is written per run; the rest wait for later runs.
+ */
+int timing_process_runs_hmm(timing_t *t, const int *runs, int n_runs, int *elems);
+
+/**
+ * timing_process_runs_kalman() for n channels at once (n <= kl->width),
+ * their filter updates run lane-parallel through kl. Every t[l] must be
+ * in Kalman mode without the HMM. Lane l's elements are written over
+ * runs[l], n_elems[l] of them; each channel ends as it would have with
+ * timing_process_runs_kalman().
+ */
+void timing_process_runs_lanes(timing_t *const *t, int n, kalman_lanes_t *kl,
+                               int *const *runs, const int *n_runs, int *n_elems);
+
+/**
+ * Finalize: emit pending element (if any). With the HMM, one element per
+ * call — call until ELEM_NONE.
  */
 int timing_finalize(timing_t *t);
 
@@ -75,6 +151,13 @@ int timing_finalize(timing_t *t);
  */
 float timing_get_wpm(const timing_t *t);
 
+/**
+ * How well recent marks fit the speed estimate, 0..1: each scores 1 at
+ * the estimated dit or dah length and 0 at half or twice it, smoothed
+ * over about five marks. 0 after init/reset.
+ */
+float timing_get_fit(const timing_t *t);
+
 /**
  * Reset timing state.
  */
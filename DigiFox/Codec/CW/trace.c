@@ -0,0 +1,49 @@
+/**
+ * trace.c — Backend slot and event names for the tracing shim
+ */
+
+#include "trace.h"
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+static trace_backend_t s_backend;
+static _Atomic(const trace_backend_t *) s_active;
+
+static const char *const k_names[TRACE_EVENT_COUNT] = {
+    [TRACE_CW_PROCESS]       = "cw.process",
+    [TRACE_GGMORSE_RESAMPLE] = "ggmorse.resample",
+    [TRACE_GGMORSE_PITCH]    = "ggmorse.pitch",
+    [TRACE_GGMORSE_GOERTZEL] = "ggmorse.goertzel",
+    [TRACE_GGMORSE_ANALYSIS] = "ggmorse.analysis",
+    [TRACE_FT8_SYNC]         = "ft8.sync",
+    [TRACE_FT8_LDPC]         = "ft8.ldpc",
+    [TRACE_FT8_OSD]          = "ft8.osd",
+    [TRACE_TRUSDX_DEMUX]     = "trusdx.demux",
+};
+
+void trace_set_backend(const trace_backend_t *backend)
+{
+    atomic_store_explicit(&s_active, NULL, memory_order_release);
+    if (!backend || !backend->begin || !backend->end) return;
+    s_backend = *backend;
+    atomic_store_explicit(&s_active, &s_backend, memory_order_release);
+}
+
+const char *trace_event_name(trace_event_t event)
+{
+    return (unsigned)event < TRACE_EVENT_COUNT ? k_names[event] : "?";
+}
+
+uint64_t trace_begin(trace_event_t event)
+{
+    const trace_backend_t *b = atomic_load_explicit(&s_active, memory_order_acquire);
+    return b ? b->begin(b->ctx, event) : 0;
+}
+
+void trace_end(trace_event_t event, uint64_t id)
+{
+    if (!id) return;
+    const trace_backend_t *b = atomic_load_explicit(&s_active, memory_order_acquire);
+    if (b) b->end(b->ctx, event, id);
+}
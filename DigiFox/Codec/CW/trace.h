@@ -0,0 +1,77 @@
+/**
+ * trace.h — Interval tracing shim for the decoder cores
+ *
+ * The C and C++ cores mark the stages of their pipelines (CW block,
+ * ggmorse resample / pitch / Goertzel / analysis, FT8 sync / LDPC / OSD,
+ * TruSDX demux) with TRACE_BEGIN / TRACE_END pairs. What the marks turn
+ * into is up to a backend the app installs: on Apple platforms
+ * trace_signpost.h maps them onto os_signpost intervals, so Instruments
+ * shows each stage on its own lane next to the app's own signposts.
+ * The cores themselves link against nothing but this file.
+ *
+ * With no backend installed a mark costs one atomic load and a branch;
+ * defining TRACE_DISABLE compiles them out altogether.
+ *
+ *   TRACE_BEGIN(TRACE_FT8_SYNC);
+ *   n = ft8_sync_search(...);
+ *   TRACE_END(TRACE_FT8_SYNC);
+ *
+ * A BEGIN declares the interval's id in the enclosing block, so the END
+ * must be in the same block and every path out of it must pass the END.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    TRACE_CW_PROCESS = 0,          /* cw_decoder_process(), one block */
+    TRACE_GGMORSE_RESAMPLE,        /* Input to the 4 kHz frame */
+    TRACE_GGMORSE_PITCH,           /* Filters, spectrum and pitch search */
+    TRACE_GGMORSE_GOERTZEL,        /* One channel's tone detector */
+    TRACE_GGMORSE_ANALYSIS,        /* One channel's speed / level search */
+    TRACE_FT8_SYNC,                /* Costas candidate search */
+    TRACE_FT8_LDPC,                /* Soft bits and BP, all candidates */
+    TRACE_FT8_OSD,                 /* OSD fallback, all candidates */
+    TRACE_TRUSDX_DEMUX,            /* One serial read */
+    TRACE_EVENT_COUNT
+} trace_event_t;
+
+typedef struct {
+    /* Start an interval: a nonzero id, handed to end */
+    uint64_t (*begin)(void *ctx, trace_event_t event);
+    void     (*end)(void *ctx, trace_event_t event, uint64_t id);
+    void     *ctx;
+} trace_backend_t;
+
+/**
+ * Install a backend (copied), or remove it with NULL. Meant for startup:
+ * an interval begun before the switch ends on the new backend, or not
+ * at all if it began with none.
+ */
+void trace_set_backend(const trace_backend_t *backend);
+
+/* Short stable name for an event, e.g. "ft8.sync" */
+const char *trace_event_name(trace_event_t event);
+
+uint64_t trace_begin(trace_event_t event);
+void     trace_end(trace_event_t event, uint64_t id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef TRACE_DISABLE
+#define TRACE_BEGIN(event)  ((void)0)
+#define TRACE_END(event)    ((void)0)
+#else
+#define TRACE_BEGIN(event)  const uint64_t trace_id_##event = trace_begin(event)
+#define TRACE_END(event)    trace_end(event, trace_id_##event)
+#endif
+
+#endif /* TRACE_H */
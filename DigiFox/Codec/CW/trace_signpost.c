@@ -0,0 +1,74 @@
+/**
+ * trace_signpost.c — trace.h intervals as os_signpost intervals
+ */
+
+#include "trace_signpost.h"
+#include "trace.h"
+
+#if defined(__APPLE__)
+
+#include <os/log.h>
+#include <os/signpost.h>
+#include <pthread.h>
+
+static os_log_t s_log;
+
+/* os_signpost wants a literal name, so one case per event */
+#define TRACE_SIGNPOST_EVENTS(X)                     \
+    X(TRACE_CW_PROCESS,       "cw.process")          \
+    X(TRACE_GGMORSE_RESAMPLE, "ggmorse.resample")    \
+    X(TRACE_GGMORSE_PITCH,    "ggmorse.pitch")       \
+    X(TRACE_GGMORSE_GOERTZEL, "ggmorse.goertzel")    \
+    X(TRACE_GGMORSE_ANALYSIS, "ggmorse.analysis")    \
+    X(TRACE_FT8_SYNC,         "ft8.sync")            \
+    X(TRACE_FT8_LDPC,         "ft8.ldpc")            \
+    X(TRACE_FT8_OSD,          "ft8.osd")             \
+    X(TRACE_TRUSDX_DEMUX,     "trusdx.demux")
+
+static uint64_t signpost_begin(void *ctx, trace_event_t event)
+{
+    (void)ctx;
+    if (!os_signpost_enabled(s_log)) return 0;
+    os_signpost_id_t id = os_signpost_id_generate(s_log);
+    switch (event) {
+#define BEGIN_CASE(e, name) case e: os_signpost_interval_begin(s_log, id, name); break;
+    TRACE_SIGNPOST_EVENTS(BEGIN_CASE)
+#undef BEGIN_CASE
+    default: return 0;
+    }
+    return id;
+}
+
+static void signpost_end(void *ctx, trace_event_t event, uint64_t id)
+{
+    (void)ctx;
+    switch (event) {
+#define END_CASE(e, name) case e: os_signpost_interval_end(s_log, id, name); break;
+    TRACE_SIGNPOST_EVENTS(END_CASE)
+#undef END_CASE
+    default: break;
+    }
+}
+
+static void install(void)
+{
+    s_log = os_log_create("com.digifox.app", "Decode");
+    trace_backend_t backend = { signpost_begin, signpost_end, NULL };
+    trace_set_backend(&backend);
+}
+
+int trace_signpost_install(void)
+{
+    static pthread_once_t once = PTHREAD_ONCE_INIT;
+    pthread_once(&once, install);
+    return 0;
+}
+
+#else
+
+int trace_signpost_install(void)
+{
+    return -1;
+}
+
+#endif /* __APPLE__ */
@@ -0,0 +1,27 @@
+/**
+ * trace_signpost.h — os_signpost backend for the tracing shim
+ *
+ * Installs a trace.h backend that turns each core interval into an
+ * os_signpost interval on the com.digifox.app "Decode" log, the one the
+ * app's own signposts (audio tap, UI updates) use. Intervals are only
+ * generated while a tool such as Instruments is recording the log.
+ */
+
+#ifndef TRACE_SIGNPOST_H
+#define TRACE_SIGNPOST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Install the backend. Idempotent.
+ * @return 0 on success, -1 where os_signpost is not available
+ */
+int trace_signpost_install(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_SIGNPOST_H */
@@ -0,0 +1,133 @@
+/**
+ * trusdx_demux.c — Run-at-a-time CAT_STREAMING demux
+ */
+
+#include "trusdx_demux.h"
+#include "trace.h"
+
+#include <string.h>
+
+void trusdx_demux_reset(trusdx_demux_t *d)
+{
+    d->state = TRUSDX_STATE_CAT;
+    d->n_cat = 0;
+}
+
+void trusdx_u8_to_float(const uint8_t *src, float *dst, int n)
+{
+    const float scale = 1.0f / 128.0f;
+    for (int i = 0; i < n; i++) dst[i] = ((float)src[i] - 128.0f) * scale;
+}
+
+static void cat_append(trusdx_demux_t *d, const uint8_t *bytes, int n)
+{
+    if (n > TRUSDX_CAT_MAX - d->n_cat) n = TRUSDX_CAT_MAX - d->n_cat;
+    if (n <= 0) return;
+    memcpy(d->cat + d->n_cat, bytes, (size_t)n);
+    d->n_cat += n;
+}
+
+/* Room in out for one more response of length bytes and its ';' */
+static int cat_room(const trusdx_demux_out_t *out, int length)
+{
+    if (!out->cat_text || !out->cat) return 1;   /* Responses are dropped */
+    int used = out->n_cat ? out->cat[out->n_cat - 1].offset + out->cat[out->n_cat - 1].length : 0;
+    return out->n_cat < out->cat_cap && out->cat_text_cap - used >= length + 1;
+}
+
+/* The pending response with its ';' → out */
+static void cat_emit(trusdx_demux_t *d, trusdx_demux_out_t *out)
+{
+    if (out->cat_text && out->cat) {
+        int used = out->n_cat ? out->cat[out->n_cat - 1].offset + out->cat[out->n_cat - 1].length : 0;
+        memcpy(out->cat_text + used, d->cat, (size_t)d->n_cat);
+        out->cat_text[used + d->n_cat] = ';';
+        out->cat[out->n_cat].offset = used;
+        out->cat[out->n_cat].length = d->n_cat + 1;
+        out->n_cat++;
+    }
+    d->n_cat = 0;
+}
+
+/* The state machine over one read: bytes consumed, n unless a buffer filled */
+static int demux(trusdx_demux_t *d, const uint8_t *bytes, int n, trusdx_demux_out_t *out)
+{
+    int i = 0;
+    while (i < n) {
+        switch (d->state) {
+        case TRUSDX_STATE_AUDIO: {
+            const uint8_t *end = (const uint8_t *)memchr(bytes + i, ';', (size_t)(n - i));
+            int run = (end ? (int)(end - bytes) : n) - i;
+            int room = out->audio_cap - out->n_audio;
+            if (run > room) {
+                run = room;
+                end = NULL;
+            }
+            if (out->audio) trusdx_u8_to_float(bytes + i, out->audio + out->n_audio, run);
+            if (out->audio_u8) memcpy(out->audio_u8 + out->n_audio, bytes + i, (size_t)run);
+            out->n_audio += run;
+            i += run;
+            if (!end) {
+                if (i < n) return i;              /* Audio buffer full */
+                break;
+            }
+            d->state = TRUSDX_STATE_SEMICOLON;
+            i++;
+            break;
+        }
+
+        case TRUSDX_STATE_CAT: {
+            const uint8_t *end = (const uint8_t *)memchr(bytes + i, ';', (size_t)(n - i));
+            int run = (end ? (int)(end - bytes) : n) - i;
+            if (end) {
+                int length = d->n_cat + run;
+                if (length > TRUSDX_CAT_MAX) length = TRUSDX_CAT_MAX;
+                if (length > 0 && !cat_room(out, length)) return i;   /* CAT buffers full */
+            }
+            cat_append(d, bytes + i, run);
+            i += run;
+            if (!end) break;
+            if (d->n_cat > 0) cat_emit(d, out);
+            d->state = TRUSDX_STATE_SEMICOLON;
+            i++;
+            break;
+        }
+
+        case TRUSDX_STATE_SEMICOLON:
+            if (bytes[i] == 'U') {
+                d->state = TRUSDX_STATE_SEMICOLON_U;
+            } else {
+                cat_append(d, bytes + i, 1);
+                d->state = TRUSDX_STATE_CAT;
+            }
+            i++;
+            break;
+
+        case TRUSDX_STATE_SEMICOLON_U:
+            if (bytes[i] == 'S') {
+                d->state = TRUSDX_STATE_AUDIO;
+            } else {
+                static const uint8_t u = 'U';
+                cat_append(d, &u, 1);
+                cat_append(d, bytes + i, 1);
+                d->state = TRUSDX_STATE_CAT;
+            }
+            i++;
+            break;
+        }
+    }
+    return n;
+}
+
+int trusdx_demux_process(trusdx_demux_t *d, const uint8_t *bytes, int n,
+                         trusdx_demux_out_t *out)
+{
+    out->n_audio = 0;
+    out->n_cat = 0;
+    if (!bytes || n <= 0) return 0;
+
+    TRACE_BEGIN(TRACE_TRUSDX_DEMUX);
+    int used = demux(d, bytes, n, out);
+    TRACE_END(TRACE_TRUSDX_DEMUX);
+    return used;
+}
@@ -0,0 +1,93 @@
+/**
+ * trusdx_demux.h — (tr)uSDX CAT_STREAMING demultiplexer
+ *
+ * Splits the serial byte stream into audio and CAT responses. Audio
+ * comes in blocks of "US" followed by unsigned 8-bit samples up to the
+ * next ';' (the firmware sends 0x3C in place of a ';' sample); anything
+ * else up to a ';' is a CAT response, which may also interrupt audio.
+ *
+ * Same state machine as TruSDXDemuxer had in Swift:
+ *   cat:        ';' → semicolon (ends a response if one is pending)
+ *   semicolon:  'U' → semicolon_u; else the byte starts a response
+ *   semicolon_u:'S' → audio; else "U" and the byte go to the response
+ *   audio:      ';' → semicolon; else a sample
+ *
+ * Reads are processed whole runs at a time: each state scans ahead for
+ * the next ';' with memchr(), audio runs are converted to float in one
+ * vectorizable loop straight into the caller's buffer, and CAT responses
+ * are handed back as slices of a caller text buffer. No allocation.
+ */
+
+#ifndef TRUSDX_DEMUX_H
+#define TRUSDX_DEMUX_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Longest CAT response kept; the rest of a longer one is dropped */
+#define TRUSDX_CAT_MAX  128
+
+enum {
+    TRUSDX_STATE_CAT = 0,
+    TRUSDX_STATE_SEMICOLON,
+    TRUSDX_STATE_SEMICOLON_U,
+    TRUSDX_STATE_AUDIO,
+};
+
+typedef struct {
+    int  state;
+    int  n_cat;                   /* Response bytes pending */
+    char cat[TRUSDX_CAT_MAX];
+} trusdx_demux_t;
+
+/* A CAT response in trusdx_demux_out_t.cat_text, ';' included */
+typedef struct {
+    int offset;
+    int length;
+} trusdx_slice_t;
+
+/*
+ * Output buffers for one call. audio and audio_u8 may each be NULL; the
+ * samples go to whichever are given, both sized audio_cap.
+ */
+typedef struct {
+    float          *audio;        /* Samples in [-1, 1) */
+    uint8_t        *audio_u8;     /* Samples as received */
+    int             audio_cap;
+    int             n_audio;      /* Out */
+
+    char           *cat_text;
+    int             cat_text_cap; /* At least TRUSDX_CAT_MAX + 1 */
+    trusdx_slice_t *cat;
+    int             cat_cap;
+    int             n_cat;        /* Out */
+} trusdx_demux_out_t;
+
+/**
+ * Start in the CAT state with nothing pending.
+ */
+void trusdx_demux_reset(trusdx_demux_t *d);
+
+/**
+ * Demultiplex bytes into out, which is cleared first. Stops early when
+ * the audio buffer or the CAT buffers are full; call again with the
+ * rest.
+ *
+ * @return Bytes consumed
+ */
+int trusdx_demux_process(trusdx_demux_t *d, const uint8_t *bytes, int n,
+                         trusdx_demux_out_t *out);
+
+/**
+ * Unsigned 8-bit PCM to float: (b - 128) / 128, n samples.
+ */
+void trusdx_u8_to_float(const uint8_t *src, float *dst, int n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRUSDX_DEMUX_H */
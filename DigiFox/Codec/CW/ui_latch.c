@@ -0,0 +1,53 @@
+/**
+ * ui_latch.c — Atomic value slots with a dirty mask
+ */
+
+#include "ui_latch.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct ui_latch_t {
+    _Atomic uint64_t value[UI_LATCH_SLOTS];   /* Bits of a double */
+    _Atomic uint32_t dirty;                   /* Slots stored since the last take */
+};
+
+ui_latch_t *ui_latch_create(void)
+{
+    ui_latch_t *l = (ui_latch_t *)calloc(1, sizeof(ui_latch_t));
+    if (!l) return NULL;
+
+    for (int i = 0; i < UI_LATCH_SLOTS; i++) atomic_init(&l->value[i], 0);
+    atomic_init(&l->dirty, 0);
+    return l;
+}
+
+void ui_latch_store(ui_latch_t *l, int slot, double value)
+{
+    if (slot < 0 || slot >= UI_LATCH_SLOTS) return;
+
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    atomic_store_explicit(&l->value[slot], bits, memory_order_release);
+    atomic_fetch_or_explicit(&l->dirty, 1u << slot, memory_order_release);
+}
+
+uint32_t ui_latch_take(ui_latch_t *l, double values[UI_LATCH_SLOTS])
+{
+    /* Cheap check first: most refreshes find nothing new */
+    if (atomic_load_explicit(&l->dirty, memory_order_relaxed) == 0) return 0;
+
+    uint32_t mask = atomic_exchange_explicit(&l->dirty, 0, memory_order_acquire);
+    for (int i = 0; i < UI_LATCH_SLOTS; i++) {
+        if (!(mask & (1u << i))) continue;
+        uint64_t bits = atomic_load_explicit(&l->value[i], memory_order_acquire);
+        memcpy(&values[i], &bits, sizeof(bits));
+    }
+    return mask;
+}
+
+void ui_latch_destroy(ui_latch_t *l)
+{
+    free(l);
+}
@@ -0,0 +1,59 @@
+/**
+ * ui_latch.h — Latest-value slots from the audio threads to the UI
+ *
+ * The audio side stores a value per slot (input level, sample rate, ...)
+ * as often as it likes; the UI takes whatever changed once per display
+ * refresh. A store is two atomic operations and never blocks, allocates
+ * or makes a system call, so it is safe in a real-time callback, and
+ * however many stores land between two takes the UI sees only the last.
+ *
+ * Each value is published (release) before its slot's bit is set in the
+ * dirty mask; take() swaps the mask to 0 (acquire) and then reads the
+ * marked slots. A store racing a take at worst marks a slot whose newer
+ * value the take already read, so the next take publishes it again.
+ *
+ * All memory is allocated in ui_latch_create().
+ */
+
+#ifndef UI_LATCH_H
+#define UI_LATCH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UI_LATCH_SLOTS 32
+
+typedef struct ui_latch_t ui_latch_t;
+
+/**
+ * Create a latch with UI_LATCH_SLOTS slots, none marked.
+ * Returns NULL on allocation failure.
+ */
+ui_latch_t *ui_latch_create(void);
+
+/**
+ * Producer: set slot to value and mark it changed. Any thread; slots out
+ * of range are ignored.
+ */
+void ui_latch_store(ui_latch_t *l, int slot, double value);
+
+/**
+ * Consumer: the slots marked since the last take, as a bit mask, with
+ * their latest values in values[slot] (other entries untouched). One
+ * consumer thread at a time.
+ */
+uint32_t ui_latch_take(ui_latch_t *l, double values[UI_LATCH_SLOTS]);
+
+/**
+ * Destroy latch and free all resources.
+ */
+void ui_latch_destroy(ui_latch_t *l);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UI_LATCH_H */
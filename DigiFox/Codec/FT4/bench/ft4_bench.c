@@ -0,0 +1,235 @@
+/**
+ * ft4_bench.c — Standalone benchmark for the C FT4 decoder core
+ *
+ * Synthesizes 7.5 s slots holding N FT4 signals with random payloads
+ * (4-GFSK, BT 1.0, through ft8_synth as a transmitter would send them,
+ * random base frequency and start time, white Gaussian noise at a given
+ * SNR in 2500 Hz, optionally each signal up to -r dB stronger), feeds
+ * each to the decoder in 0.1 s chunks and times ft4_decoder_decode_fed()
+ * at slot end against its deadline (-d). Reports the feed and decode
+ * times, the decode's real-time factor, and how many of the sent
+ * messages came back, plus false decodes (payloads that were never
+ * sent). Each slot's times are the best of -n repeats.
+ *
+ * Not part of the app target; see bench/Makefile.
+ */
+
+#include "ft4_decoder.h"
+#include "ft8_synth.h"
+#include "bench_synth.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_MAX_SIGNALS   32
+#define BENCH_MAX_RESULTS   64
+#define BENCH_SLOT_SAMPLES  FT4_SLOT_SAMPLES
+#define BENCH_CHUNK_SAMPLES 1200      /* 0.1 s per feed */
+
+typedef struct {
+    int   signals;
+    float snr_db;
+    int   slots;
+    int   repeats;
+    int   max_candidates;
+    int   osd_depth;       /* -1 = decoder default */
+    float deadline_ms;     /* 0 = decoder default */
+    float spread_db;       /* Per-signal SNR in [snr_db, snr_db + spread_db] */
+    int   threads;         /* 0 = decoder default */
+} bench_opts_t;
+
+typedef struct {
+    uint8_t payload[FT4_PAYLOAD_BITS];
+    double  freq_hz;
+    double  start_s;
+    double  amplitude;
+} bench_signal_t;
+
+/* ------------------------------------------------------------------ */
+/* Signal synthesis                                                    */
+/* ------------------------------------------------------------------ */
+
+/* Non-overlapping frequencies, start within the first 2 s of the slot */
+static void pick_signals(const bench_opts_t *o, bench_signal_t *sig)
+{
+    for (int i = 0; i < o->signals; i++) {
+        for (int b = 0; b < FT4_PAYLOAD_BITS; b++) {
+            sig[i].payload[b] = bench_uniform() < 0.5;
+        }
+
+        double span = 2400.0 / o->signals;
+        sig[i].freq_hz = 300.0 + span * i + bench_uniform() * FT4_TONE_SPACING;
+        sig[i].amplitude = pow(10.0, bench_uniform() * o->spread_db / 20.0);
+        sig[i].start_s = bench_uniform() * 2.0;
+    }
+}
+
+static void synth(const bench_opts_t *o, ft8_synth_t *tx, const bench_signal_t *sig,
+                  float *x)
+{
+    /* Unit-amplitude tones at snr_db: power 1/2 each */
+    memset(x, 0, BENCH_SLOT_SAMPLES * sizeof(float));
+    bench_add_noise(x, BENCH_SLOT_SAMPLES, FT4_SAMPLE_RATE, 0.5, o->snr_db);
+
+    static float frame[FT4_SYMBOL_COUNT * FT4_SYMBOL_SAMPLES];
+    for (int s = 0; s < o->signals; s++) {
+        uint8_t tones[FT4_SYMBOL_COUNT];
+        ft4_encode(sig[s].payload, tones);
+        ft8_synth_start(tx, tones, FT4_SYMBOL_COUNT, (float)sig[s].freq_hz,
+                        (float)sig[s].amplitude);
+        int n = ft8_synth_render(tx, frame, FT4_SYMBOL_COUNT * FT4_SYMBOL_SAMPLES);
+
+        int start = (int)(sig[s].start_s * FT4_SAMPLE_RATE);
+        for (int j = 0; j < n && start + j < BENCH_SLOT_SAMPLES; j++) x[start + j] += frame[j];
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Timing                                                              */
+/* ------------------------------------------------------------------ */
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+/* ------------------------------------------------------------------ */
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr,
+        "usage: %s [options]\n"
+        "  -m signals    signals per slot (10)\n"
+        "  -s snr_db     SNR in 2500 Hz (-10)\n"
+        "  -l slots      slots to decode (5)\n"
+        "  -n repeats    best-of count per slot (3)\n"
+        "  -c count      max candidates (decoder default)\n"
+        "  -o depth      OSD fallback depth, 0 = off (decoder default)\n"
+        "  -d ms         decode deadline (decoder default)\n"
+        "  -r spread_db  signals up to this much above the SNR (0)\n"
+        "  -t threads    per-candidate workers (decoder default)\n",
+        argv0);
+}
+
+int main(int argc, char **argv)
+{
+    bench_opts_t o = {
+        .signals = 10, .snr_db = -10.0f, .slots = 5, .repeats = 3,
+        .osd_depth = -1,
+    };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "m:s:l:n:c:o:d:r:t:h")) != -1) {
+        switch (opt) {
+        case 'm': o.signals = atoi(optarg); break;
+        case 's': o.snr_db = (float)atof(optarg); break;
+        case 'l': o.slots = atoi(optarg); break;
+        case 'n': o.repeats = atoi(optarg); break;
+        case 'c': o.max_candidates = atoi(optarg); break;
+        case 'o': o.osd_depth = atoi(optarg); break;
+        case 'd': o.deadline_ms = (float)atof(optarg); break;
+        case 'r': o.spread_db = (float)atof(optarg); break;
+        case 't': o.threads = atoi(optarg); break;
+        default: usage(argv[0]); return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (o.signals <= 0 || o.signals > BENCH_MAX_SIGNALS || o.slots <= 0 ||
+        o.repeats <= 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    ft4_config_t cfg;
+    ft4_config_init(&cfg);
+    if (o.max_candidates > 0) cfg.max_candidates = o.max_candidates;
+    if (o.osd_depth >= 0) cfg.osd_depth = o.osd_depth;
+    if (o.deadline_ms > 0.0f) cfg.deadline_ms = o.deadline_ms;
+    if (o.threads > 0) cfg.threads = o.threads;
+
+    /* FT4 as WSJT-X sends it: BT 1.0, a whole ramp symbol at each end */
+    ft8_synth_config_t scfg;
+    ft8_synth_config_init(&scfg);
+    scfg.symbol_samples = FT4_SYMBOL_SAMPLES;
+    scfg.bt = 1.0f;
+    scfg.ramp_samples = FT4_SYMBOL_SAMPLES;
+
+    ft4_decoder_t *dec = ft4_decoder_create(&cfg);
+    ft8_synth_t *tx = ft8_synth_create(&scfg);
+    float *x = (float *)malloc(BENCH_SLOT_SAMPLES * sizeof(float));
+    if (!dec || !tx || !x) return 1;
+
+    char threads_desc[16] = "auto";
+    if (o.threads > 0) snprintf(threads_desc, sizeof(threads_desc), "%d", o.threads);
+
+    printf("FT4 decoder benchmark: %d signals, SNR %.1f dB (+%.0f), %d candidates, "
+           "OSD depth %d, deadline %.0f ms, %s threads, best of %d\n",
+           o.signals, o.snr_db, o.spread_db, cfg.max_candidates, cfg.osd_depth,
+           cfg.deadline_ms, threads_desc, o.repeats);
+    printf("%4s  %9s  %9s  %10s  %7s  %5s\n", "slot", "feed ms", "ms", "x realtime",
+           "decoded", "false");
+
+    static bench_signal_t sig[BENCH_MAX_SIGNALS];
+    static ft4_result_t res[BENCH_MAX_RESULTS];
+    int total_sent = 0, total_found = 0, total_false = 0;
+    double total_ms = 0.0, total_feed_ms = 0.0, worst_ms = 0.0;
+
+    for (int slot = 0; slot < o.slots; slot++) {
+        pick_signals(&o, sig);
+        synth(&o, tx, sig, x);
+
+        double best = 1e30, best_feed = 1e30;
+        int n = 0;
+        for (int rep = 0; rep < o.repeats; rep++) {
+            double feed = 0.0;
+            ft4_decoder_reset(dec);
+            for (int i = 0; i < BENCH_SLOT_SAMPLES; i += BENCH_CHUNK_SAMPLES) {
+                int len = BENCH_SLOT_SAMPLES - i;
+                if (len > BENCH_CHUNK_SAMPLES) len = BENCH_CHUNK_SAMPLES;
+                double t0 = now_s();
+                ft4_decoder_feed(dec, x + i, len);
+                feed += now_s() - t0;
+            }
+            double t0 = now_s();
+            n = ft4_decoder_decode_fed(dec, res, BENCH_MAX_RESULTS);
+            double dt = now_s() - t0;
+            if (feed < best_feed) best_feed = feed;
+            if (dt < best) best = dt;
+            if (dt > worst_ms * 1e-3) worst_ms = dt * 1e3;
+        }
+
+        int found = 0;
+        for (int s = 0; s < o.signals; s++) {
+            for (int r = 0; r < n; r++) {
+                if (memcmp(res[r].payload, sig[s].payload, FT4_PAYLOAD_BITS) == 0) {
+                    found++;
+                    break;
+                }
+            }
+        }
+        int false_dec = n - found;
+
+        printf("%4d  %9.2f  %9.2f  %10.1f  %3d/%-3d  %5d\n", slot, best_feed * 1e3,
+               best * 1e3, 7.5 / best, found, o.signals, false_dec);
+        total_sent += o.signals;
+        total_found += found;
+        total_false += false_dec;
+        total_ms += best * 1e3;
+        total_feed_ms += best_feed * 1e3;
+    }
+
+    printf("mean  %9.2f  %9.2f  %10.1f  %3d/%-3d  %5d\n", total_feed_ms / o.slots,
+           total_ms / o.slots, 7.5e3 * o.slots / total_ms, total_found, total_sent,
+           total_false);
+    printf("slowest decode %.2f ms of a %.0f ms deadline\n", worst_ms, cfg.deadline_ms);
+
+    free(x);
+    ft8_synth_destroy(tx);
+    ft4_decoder_destroy(dec);
+    return 0;
+}
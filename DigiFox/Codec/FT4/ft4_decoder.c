@@ -0,0 +1,496 @@
+/**
+ * ft4_decoder.c — FT4 pipeline: Waterfall → Costas sync → Soft bits → LDPC → CRC
+ *
+ * No heap allocation during feed() or decode() — all state pre-allocated
+ * in create().
+ */
+
+#include "ft4_decoder.h"
+#include "ft8_crc.h"
+#include "ft8_ldpc.h"
+#include "ft8_osd.h"
+#include "ft8_pool.h"
+#include "ft8_softbits.h"
+#include "ft8_sync.h"
+#include "ft8_waterfall.h"
+
+#include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FT4_BITS_PER_SYMBOL  2
+#define FT4_NUM_TONES        4
+
+/* Bins left and right of the 4 tones used as noise reference for SNR */
+#define FT4_SNR_GUARD        4
+
+/* As FT8_OSD_MAX_ERRORS in ft8_decoder.c */
+#define FT4_OSD_MAX_ERRORS   18
+
+/* Marks a candidate recovered by OSD in the per-candidate iterations */
+#define FT4_ITER_OSD         (-1)
+
+#define FT4_MAX_THREADS      16
+
+/* The 77 payload bits are sent XORed with these, first bit in bit 7 */
+static const uint8_t k_scramble[10] = {
+    0x4A, 0x5E, 0x89, 0xB4, 0xB0, 0x8A, 0x79, 0x55, 0xBE, 0x28,
+};
+
+/* 2 coded bits → tone; the same map decodes (ft8_softbits_gray4) */
+static const int k_gray_encode[FT4_NUM_TONES] = { 0, 1, 3, 2 };
+
+struct ft4_decoder_t {
+    ft4_config_t cfg;
+
+    ft8_waterfall_t wf;
+    int             n_bins;       /* Waterfall bins per grid */
+
+    /* Base-bin search range [min_bin, max_bin) */
+    int min_bin, max_bin;
+
+    ft8_sync_t       sync;
+    ft8_candidate_t *cand;        /* max_candidates, best sync first */
+
+    const ft8_ldpc_code_t *code;
+
+    /* Per-candidate stage: workers claim candidates off a shared counter */
+    ft8_pool_t       *pool;
+    int               n_workers;
+    ft8_ldpc_batch_t *ldpc;       /* n_workers */
+    ft8_osd_t        *osd;        /* n_workers */
+    int               chunk;      /* Candidates per LDPC claim */
+    _Atomic int       next;       /* Next unclaimed chunk / candidate */
+    int               n_cand;
+    uint64_t          deadline;
+
+    /* Data symbol rows within the frame (all but ramps and Costas blocks) */
+    int data_pos[FT4_SYMBOL_COUNT];
+    int n_data;
+
+    /* Per tried candidate, decoded as one LDPC batch */
+    float   *llr;                 /* max_candidates * FT8_LDPC_N */
+    uint8_t *message;             /* max_candidates * FT8_LDPC_K */
+    int     *iterations;          /* max_candidates */
+    uint8_t *solved;              /* max_candidates: BP found a CRC-valid codeword */
+};
+
+/* ------------------------------------------------------------------ */
+/* Config init                                                         */
+/* ------------------------------------------------------------------ */
+
+void ft4_config_init(ft4_config_t *cfg)
+{
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->min_freq        = 200.0f;
+    cfg->max_freq        = 3000.0f;
+    cfg->sync_threshold  = 4.0f;
+    cfg->max_candidates  = 40;
+    cfg->ldpc_iterations = 50;
+    cfg->osd_depth       = 2;
+    cfg->deadline_ms     = 1000.0f;
+    cfg->threads         = 0;
+    cfg->max_samples     = FT4_SLOT_SAMPLES;
+}
+
+/* ------------------------------------------------------------------ */
+/* Create / destroy                                                    */
+/* ------------------------------------------------------------------ */
+
+ft4_decoder_t *ft4_decoder_create(const ft4_config_t *cfg)
+{
+    ft4_decoder_t *dec = (ft4_decoder_t *)calloc(1, sizeof(ft4_decoder_t));
+    if (!dec) return NULL;
+
+    if (cfg) {
+        dec->cfg = *cfg;
+    } else {
+        ft4_config_init(&dec->cfg);
+    }
+    if (dec->cfg.max_samples < FT4_SYMBOL_SAMPLES * FT4_SYMBOL_COUNT) {
+        dec->cfg.max_samples = FT4_SYMBOL_SAMPLES * FT4_SYMBOL_COUNT;
+    }
+    if (dec->cfg.max_candidates < 1) dec->cfg.max_candidates = 1;
+    if (dec->cfg.ldpc_iterations < 1) dec->cfg.ldpc_iterations = 1;
+    if (dec->cfg.osd_depth < 0) dec->cfg.osd_depth = 0;
+    if (dec->cfg.osd_depth > FT8_OSD_MAX_DEPTH) dec->cfg.osd_depth = FT8_OSD_MAX_DEPTH;
+    if (dec->cfg.deadline_ms < 0.0f) dec->cfg.deadline_ms = 0.0f;
+    if (dec->cfg.threads <= 0) dec->cfg.threads = ft8_pool_default_size();
+    if (dec->cfg.threads > FT4_MAX_THREADS) dec->cfg.threads = FT4_MAX_THREADS;
+
+    /* Bins up to the top tone of the highest base, plus its SNR noise bins */
+    dec->min_bin = (int)(dec->cfg.min_freq / FT4_TONE_SPACING);
+    if (dec->min_bin < 0) dec->min_bin = 0;
+    dec->max_bin = (int)(dec->cfg.max_freq / FT4_TONE_SPACING);
+    dec->n_bins = dec->max_bin + FT4_NUM_TONES + FT4_SNR_GUARD;
+    if (dec->n_bins > FT4_SYMBOL_SAMPLES / 2) dec->n_bins = FT4_SYMBOL_SAMPLES / 2;
+    if (dec->max_bin > dec->n_bins - FT4_NUM_TONES) {
+        dec->max_bin = dec->n_bins - FT4_NUM_TONES;
+    }
+
+    if (ft8_waterfall_init(&dec->wf, FT4_SYMBOL_SAMPLES, dec->cfg.max_samples,
+                           dec->n_bins) != 0) {
+        ft4_decoder_destroy(dec);
+        return NULL;
+    }
+
+    dec->cand = (ft8_candidate_t *)calloc((size_t)dec->cfg.max_candidates, sizeof(ft8_candidate_t));
+    dec->llr = (float *)calloc((size_t)dec->cfg.max_candidates * FT8_LDPC_N, sizeof(float));
+    dec->message = (uint8_t *)calloc((size_t)dec->cfg.max_candidates * FT8_LDPC_K, 1);
+    dec->iterations = (int *)calloc((size_t)dec->cfg.max_candidates, sizeof(int));
+    dec->solved = (uint8_t *)calloc((size_t)dec->cfg.max_candidates, 1);
+    if (!dec->cand || !dec->llr || !dec->message || !dec->iterations || !dec->solved ||
+        ft8_sync_init_layout(&dec->sync, &dec->wf, &ft8_sync_layout_ft4) != 0) {
+        ft4_decoder_destroy(dec);
+        return NULL;
+    }
+    ft8_sync_set_backend(&dec->sync, dec->cfg.sync_score, dec->cfg.sync_ctx);
+
+    dec->code = ft8_ldpc_ft8();
+
+    /* Threads that fail to start leave the stage on the calling thread */
+    dec->pool = dec->cfg.threads > 1 ? ft8_pool_create(dec->cfg.threads) : NULL;
+    dec->n_workers = ft8_pool_size(dec->pool);
+    dec->ldpc = (ft8_ldpc_batch_t *)calloc((size_t)dec->n_workers, sizeof(ft8_ldpc_batch_t));
+    dec->osd = (ft8_osd_t *)calloc((size_t)dec->n_workers, sizeof(ft8_osd_t));
+    if (!dec->ldpc || !dec->osd) {
+        ft4_decoder_destroy(dec);
+        return NULL;
+    }
+    for (int w = 0; w < dec->n_workers; w++) ft8_osd_init(&dec->osd[w], dec->code);
+    dec->chunk = ft8_ldpc_batch_width();
+
+    const ft8_sync_layout_t *lay = &ft8_sync_layout_ft4;
+    for (int pos = 1; pos < FT4_SYMBOL_COUNT - 1; pos++) {
+        int sync = 0;
+        for (int b = 0; b < lay->n_blocks; b++) {
+            int off = pos - lay->offsets[b];
+            if (off >= 0 && off < lay->costas_length) sync = 1;
+        }
+        if (!sync) dec->data_pos[dec->n_data++] = pos;
+    }
+
+    return dec;
+}
+
+void ft4_decoder_destroy(ft4_decoder_t *dec)
+{
+    if (!dec) return;
+    ft8_waterfall_free(&dec->wf);
+    ft8_sync_free(&dec->sync);
+    free(dec->cand);
+    free(dec->llr);
+    free(dec->message);
+    free(dec->iterations);
+    free(dec->solved);
+    ft8_pool_destroy(dec->pool);
+    free(dec->ldpc);
+    free(dec->osd);
+    free(dec);
+}
+
+/* ------------------------------------------------------------------ */
+/* Soft bits, SNR, frequency                                           */
+/* ------------------------------------------------------------------ */
+
+/* Row 0, bin 0 of the waterfall grid a candidate was found in */
+static const float *cand_grid(const ft4_decoder_t *dec, const ft8_candidate_t *c)
+{
+    return ft8_waterfall_grid(&dec->wf, c->time_sub, c->freq_sub);
+}
+
+/* LLRs of the data symbols (ft8_softbits.h) */
+static void extract_llr(const ft4_decoder_t *dec, const ft8_candidate_t *c,
+                        float *out)
+{
+    ft8_softbits_extract(cand_grid(dec, c), dec->n_bins, c->row, c->bin,
+                         dec->data_pos, dec->n_data, FT4_SYMBOL_COUNT,
+                         FT4_NUM_TONES, ft8_softbits_gray4, out);
+}
+
+/* Mean tone-bin power over mean guard-bin power, referred to 2500 Hz */
+static float estimate_snr(const ft4_decoder_t *dec, const ft8_candidate_t *c)
+{
+    const float *grid = cand_grid(dec, c);
+    double signal = 0.0, noise = 0.0;
+    int n_signal = 0, n_noise = 0;
+
+    for (int d = 0; d < dec->n_data; d++) {
+        const float *p = grid + (long)(c->row + dec->data_pos[d]) * dec->n_bins;
+
+        for (int t = 0; t < FT4_NUM_TONES; t++) {
+            signal += p[c->bin + t];
+            n_signal++;
+        }
+        for (int g = 1; g <= FT4_SNR_GUARD; g++) {
+            int lo = c->bin - g;
+            int hi = c->bin + FT4_NUM_TONES + g;
+            if (lo >= 0) { noise += p[lo]; n_noise++; }
+            if (hi < dec->n_bins) { noise += p[hi]; n_noise++; }
+        }
+    }
+
+    double avg_signal = n_signal ? signal / n_signal : 1e-10;
+    double avg_noise = n_noise ? noise / n_noise : 1e-10;
+    return (float)(10.0 * log10(avg_signal / avg_noise)
+                   - 10.0 * log10(2500.0 / FT4_TONE_SPACING));
+}
+
+/* Parabolic interpolation around each Costas tone, averaged */
+static float refine_frequency(const ft4_decoder_t *dec, const ft8_candidate_t *c)
+{
+    const ft8_sync_layout_t *lay = &ft8_sync_layout_ft4;
+    const float *grid = cand_grid(dec, c);
+    double sum = 0.0;
+    int count = 0;
+
+    if (c->bin > 0 && c->bin + FT4_NUM_TONES - 1 < dec->n_bins) {
+        for (int b = 0; b < lay->n_blocks; b++) {
+            for (int i = 0; i < lay->costas_length; i++) {
+                int bin = c->bin + lay->costas[b][i];
+                if (bin + 1 >= dec->n_bins) continue;
+
+                const float *p = grid + (long)(c->row + lay->offsets[b] + i) * dec->n_bins;
+                double left = p[bin - 1], center = p[bin], right = p[bin + 1];
+                double denom = 2.0 * (2.0 * center - left - right);
+                if (fabs(denom) > 1e-10) {
+                    sum += (right - left) / denom;
+                    count++;
+                }
+            }
+        }
+    }
+
+    double offset = count ? sum / count : 0.0;
+    return (float)((c->bin + (double)c->freq_sub / FT8_WF_FREQ_OSR + offset)
+                   * FT4_TONE_SPACING);
+}
+
+/* Frame start in samples */
+static int cand_start(const ft8_candidate_t *c)
+{
+    return c->row * FT4_SYMBOL_SAMPLES + c->time_sub * (FT4_SYMBOL_SAMPLES / FT8_WF_TIME_OSR);
+}
+
+/* ------------------------------------------------------------------ */
+/* Decode                                                              */
+/* ------------------------------------------------------------------ */
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* payload ^= the scramble pattern, 77 bits */
+static void scramble(uint8_t *bits)
+{
+    for (int i = 0; i < FT4_PAYLOAD_BITS; i++) {
+        bits[i] ^= (k_scramble[i / 8] >> (7 - i % 8)) & 1;
+    }
+}
+
+/* CRC-valid and not all zeros, which the CRC passes but FT4 never sends */
+static int message_valid(const uint8_t *message)
+{
+    if (!ft8_crc_check(message, FT4_PAYLOAD_BITS)) return 0;
+    for (int i = 0; i < FT8_LDPC_K; i++) {
+        if (message[i]) return 1;
+    }
+    return 0;
+}
+
+/* BP converged on a codeword that passes the CRC */
+static int bp_solved(const ft4_decoder_t *dec, int i)
+{
+    return dec->iterations[i] > 0 && message_valid(dec->message + (long)i * FT8_LDPC_K);
+}
+
+/* Within a symbol and a tone of a solved candidate: its sidelobe */
+static int near_solved(const ft4_decoder_t *dec, int n_cand, const ft8_candidate_t *c)
+{
+    for (int i = 0; i < n_cand; i++) {
+        if (!dec->solved[i]) continue;
+        const ft8_candidate_t *s = &dec->cand[i];
+        int r = (s->row - c->row) * FT8_WF_TIME_OSR + s->time_sub - c->time_sub;
+        int f = (s->bin - c->bin) * FT8_WF_FREQ_OSR + s->freq_sub - c->freq_sub;
+        if (abs(r) <= FT8_WF_TIME_OSR && abs(f) <= FT8_WF_FREQ_OSR) return 1;
+    }
+    return 0;
+}
+
+/*
+ * Soft bits and LDPC, one chunk of candidates per claim, until the
+ * deadline: a chunk claimed is always finished, so the overrun is one
+ * batch per worker.
+ */
+static void ldpc_stage(void *ctx, int worker)
+{
+    ft4_decoder_t *dec = (ft4_decoder_t *)ctx;
+
+    for (;;) {
+        if (now_ns() >= dec->deadline) return;
+        int lo = atomic_fetch_add_explicit(&dec->next, 1, memory_order_relaxed) * dec->chunk;
+        if (lo >= dec->n_cand) return;
+        int n = dec->n_cand - lo < dec->chunk ? dec->n_cand - lo : dec->chunk;
+
+        for (int i = lo; i < lo + n; i++) {
+            extract_llr(dec, &dec->cand[i], dec->llr + (long)i * FT8_LDPC_N);
+        }
+        ft8_ldpc_decode_batch(dec->code, dec->llr + (long)lo * FT8_LDPC_N, n,
+                              dec->cfg.ldpc_iterations, &dec->ldpc[worker],
+                              dec->message + (long)lo * FT8_LDPC_K, dec->iterations + lo);
+    }
+}
+
+/* Ordered statistics for the candidates BP did not solve, best sync
+ * first, until the deadline (as osd_stage in ft8_decoder.c) */
+static void osd_stage(void *ctx, int worker)
+{
+    ft4_decoder_t *dec = (ft4_decoder_t *)ctx;
+
+    for (;;) {
+        int i = atomic_fetch_add_explicit(&dec->next, 1, memory_order_relaxed);
+        if (i >= dec->n_cand) return;
+        if (dec->solved[i]) continue;
+        if (near_solved(dec, dec->n_cand, &dec->cand[i])) continue;
+        if (now_ns() >= dec->deadline) return;
+
+        uint8_t *message = dec->message + (long)i * FT8_LDPC_K;
+        int errors = ft8_osd_decode(&dec->osd[worker], dec->llr + (long)i * FT8_LDPC_N,
+                                    dec->cfg.osd_depth, message);
+        dec->iterations[i] = errors >= 0 && errors <= FT4_OSD_MAX_ERRORS ? FT4_ITER_OSD : 0;
+    }
+}
+
+static int already_decoded(const ft4_decoder_t *dec, int n_tried,
+                           const ft8_candidate_t *c,
+                           const ft4_result_t *out, int n_out,
+                           const uint8_t *payload)
+{
+    for (int i = 0; i < n_tried; i++) {
+        const ft8_candidate_t *o = &dec->cand[i];
+        if (o->decoded && o->row == c->row && o->bin == c->bin &&
+            o->time_sub == c->time_sub && o->freq_sub == c->freq_sub) {
+            return 1;
+        }
+    }
+    for (int i = 0; i < n_out; i++) {
+        if (memcmp(out[i].payload, payload, FT4_PAYLOAD_BITS) == 0) return 1;
+    }
+    return 0;
+}
+
+void ft4_decoder_reset(ft4_decoder_t *dec)
+{
+    if (!dec) return;
+    ft8_waterfall_reset(&dec->wf);
+}
+
+int ft4_decoder_feed(ft4_decoder_t *dec, const float *audio, int n)
+{
+    if (!dec || !audio || n <= 0) return 0;
+    return ft8_waterfall_feed(&dec->wf, audio, n);
+}
+
+int ft4_decoder_decode_fed(ft4_decoder_t *dec, ft4_result_t *out, int max_out)
+{
+    if (!dec || !out || max_out <= 0) return 0;
+
+    dec->deadline = now_ns() + (uint64_t)(dec->cfg.deadline_ms * 1e6f);
+    ft8_waterfall_flush(&dec->wf);
+
+    int n_cand = ft8_sync_search(&dec->sync, &dec->wf, dec->min_bin, dec->max_bin,
+                                 dec->cfg.sync_threshold, FT4_SYMBOL_COUNT, dec->cand,
+                                 dec->cfg.max_candidates);
+    dec->n_cand = n_cand;
+    if (n_cand == 0) return 0;
+
+    /* Chunks are claimed in order, so the ones done are a prefix */
+    atomic_store(&dec->next, 0);
+    ft8_pool_run(dec->pool, ldpc_stage, dec);
+    int tried = atomic_load(&dec->next) * dec->chunk;
+    if (tried < n_cand) n_cand = tried;
+    dec->n_cand = n_cand;
+
+    for (int i = 0; i < n_cand; i++) dec->solved[i] = (uint8_t)bp_solved(dec, i);
+    if (dec->cfg.osd_depth > 0) {
+        atomic_store(&dec->next, 0);
+        ft8_pool_run(dec->pool, osd_stage, dec);
+    }
+
+    /* Reduction: CRC and dedup in candidate order, best sync first */
+    int n_out = 0;
+    for (int i = 0; i < n_cand && n_out < max_out; i++) {
+        ft8_candidate_t *c = &dec->cand[i];
+        const uint8_t *message = dec->message + (long)i * FT8_LDPC_K;
+        int iterations = dec->iterations[i];
+
+        if (!iterations) continue;
+        if (!message_valid(message)) continue;
+
+        uint8_t payload[FT4_PAYLOAD_BITS];
+        memcpy(payload, message, FT4_PAYLOAD_BITS);
+        scramble(payload);
+        if (already_decoded(dec, i, c, out, n_out, payload)) continue;
+        c->decoded = 1;
+
+        ft4_result_t *r = &out[n_out++];
+        memcpy(r->payload, payload, FT4_PAYLOAD_BITS);
+        r->snr = estimate_snr(dec, c);
+        r->freq_hz = refine_frequency(dec, c);
+        r->time_s = (float)cand_start(c) / FT4_SAMPLE_RATE;
+        r->score = c->score;
+        r->iterations = iterations > 0 ? iterations : 0;
+    }
+
+    return n_out;
+}
+
+int ft4_decoder_decode(ft4_decoder_t *dec, const float *audio, int n,
+                       ft4_result_t *out, int max_out)
+{
+    if (!dec || !audio || !out || max_out <= 0) return 0;
+
+    ft4_decoder_reset(dec);
+    ft4_decoder_feed(dec, audio, n);
+    return ft4_decoder_decode_fed(dec, out, max_out);
+}
+
+/* ------------------------------------------------------------------ */
+/* Encode                                                              */
+/* ------------------------------------------------------------------ */
+
+void ft4_encode(const uint8_t *payload, uint8_t *tones)
+{
+    const ft8_sync_layout_t *lay = &ft8_sync_layout_ft4;
+    uint8_t message[FT8_LDPC_K];
+    uint8_t codeword[FT8_LDPC_N];
+
+    memcpy(message, payload, FT4_PAYLOAD_BITS);
+    scramble(message);
+    ft8_crc_append(message, FT4_PAYLOAD_BITS);
+    ft8_ldpc_encode(ft8_ldpc_ft8(), message, codeword);
+
+    int d = 0;
+    for (int pos = 1; pos < FT4_SYMBOL_COUNT - 1; pos++) {
+        int b = 0;
+        while (b < lay->n_blocks &&
+               (pos < lay->offsets[b] || pos >= lay->offsets[b] + lay->costas_length)) {
+            b++;
+        }
+        if (b < lay->n_blocks) {
+            tones[pos] = (uint8_t)lay->costas[b][pos - lay->offsets[b]];
+        } else {
+            const uint8_t *bits = codeword + FT4_BITS_PER_SYMBOL * d++;
+            tones[pos] = (uint8_t)k_gray_encode[(bits[0] << 1) | bits[1]];
+        }
+    }
+
+    /* Ramp symbols hold the neighbouring tone while the amplitude rises / falls */
+    tones[0] = tones[1];
+    tones[FT4_SYMBOL_COUNT - 1] = tones[FT4_SYMBOL_COUNT - 2];
+}
@@ -0,0 +1,165 @@
+/**
+ * ft4_decoder.h — Public C API for the FT4 decoder core
+ *
+ * FT4 on the FT8 engines: the same oversampled waterfall, Costas search,
+ * soft bits, LDPC(174,91) batch, ordered-statistics fallback and CRC-14,
+ * with FT4's frame. A 7.5 s slot carries 105 symbols of 4-GFSK at
+ * 20.833 Baud (576 samples, tones 20.833 Hz apart): a ramp symbol at
+ * each end and four 4-symbol Costas blocks, each with its own pattern,
+ * around 87 Gray-coded data symbols of 2 bits. The 77 payload bits are
+ * sent XORed with a fixed pattern; results carry them unscrambled, for
+ * FT8MessagePack.unpack() as FT8's.
+ *
+ * FT4 leaves a little over 2 s between the end of a frame and the next
+ * slot, so decoding has a hard deadline: cfg.deadline_ms after
+ * ft4_decoder_decode_fed() is called, no new LDPC work is claimed and
+ * the OSD fallback stops, and whatever is decoded by then is returned.
+ * Candidates are tried best sync first, so the ones cut off are the
+ * weakest. One pass only: there is no subtraction for FT4 (ft8_subtract.h
+ * is built for FT8's frame).
+ *
+ * Usage, whole slot:
+ *   ft4_config_t cfg;
+ *   ft4_config_init(&cfg);
+ *
+ *   ft4_decoder_t *dec = ft4_decoder_create(&cfg);
+ *   ft4_result_t res[64];
+ *   int n = ft4_decoder_decode(dec, audio, num_samples, res, 64);
+ *   ft4_decoder_destroy(dec);
+ *
+ * Streaming:
+ *   ft4_decoder_reset(dec);                          // slot starts
+ *   ft4_decoder_feed(dec, chunk, chunk_len);         // as audio arrives
+ *   int n = ft4_decoder_decode_fed(dec, res, 64);    // slot ends
+ */
+
+#ifndef FT4_DECODER_H
+#define FT4_DECODER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FT4_SAMPLE_RATE     12000
+#define FT4_SYMBOL_SAMPLES  576         /* 48 ms */
+#define FT4_SYMBOL_COUNT    105         /* Ramps, 4 × 4 Costas, 87 data */
+#define FT4_TONE_SPACING    20.833333f  /* Hz, one spectrogram bin */
+#define FT4_PAYLOAD_BITS    77
+#define FT4_SLOT_SAMPLES    90000       /* 7.5 s */
+
+/* Opaque decoder handle */
+typedef struct ft4_decoder_t ft4_decoder_t;
+
+/* One Costas search's scoring (ft8_sync.h) */
+struct ft8_sync_job_t;
+
+/* Configuration struct — all fields have sensible defaults via ft4_config_init() */
+typedef struct ft4_config_t {
+    float min_freq;          /* Lowest base (tone 0) frequency searched in Hz (default: 200) */
+    float max_freq;          /* Highest base frequency searched in Hz (default: 3000) */
+    float sync_threshold;    /* Minimum Costas score for a candidate (default: 4.0) */
+    int   max_candidates;    /* Best-scoring candidates tried per slot (default: 40) */
+    int   ldpc_iterations;   /* Belief-propagation iteration cap (default: 50) */
+    int   osd_depth;         /* Ordered-statistics fallback for candidates BP
+                                gives up on: 0 = off, 1 or 2 flips (default: 2) */
+    float deadline_ms;       /* Decode time per slot, LDPC and OSD included;
+                                work still pending then is dropped
+                                (default: 1000) */
+    int   threads;           /* Workers for the per-candidate stage, the
+                                calling thread included; 0 = one per
+                                performance core (default: 0) */
+    int   max_samples;       /* Longest buffer decoded; the rest is ignored
+                                (default: 7.5 s at 12 kHz) */
+    int (*sync_score)(void *ctx, const struct ft8_sync_job_t *job, float *map);
+                             /* Scores the Costas search elsewhere, e.g.
+                                ft8_sync_metal_score() on the GPU; the CPU
+                                does it when NULL or when it fails
+                                (default: NULL) */
+    void *sync_ctx;          /* Passed to sync_score */
+} ft4_config_t;
+
+/* One decoded message */
+typedef struct {
+    uint8_t payload[FT4_PAYLOAD_BITS];  /* Message bits, 0/1, unscrambled */
+    float   snr;                        /* Estimated SNR in dB (2500 Hz) */
+    float   freq_hz;                    /* Refined base frequency in Hz */
+    float   time_s;                     /* Frame start (ramp symbol) within
+                                           the buffer in s */
+    float   score;                      /* Costas sync score */
+    int     iterations;                 /* LDPC iterations to converge; 0 when
+                                           recovered by the OSD fallback */
+} ft4_result_t;
+
+/**
+ * Initialize config with default values.
+ * Always call this before modifying individual fields.
+ */
+void ft4_config_init(ft4_config_t *cfg);
+
+/**
+ * Create a decoder instance. All buffers are sized here from cfg;
+ * decoding does no heap allocation.
+ * Returns NULL on allocation failure.
+ */
+ft4_decoder_t *ft4_decoder_create(const ft4_config_t *cfg);
+
+/**
+ * Start a new slot: drop all audio fed so far.
+ */
+void ft4_decoder_reset(ft4_decoder_t *dec);
+
+/**
+ * Append audio to the current slot, transforming the waterfall windows
+ * it completes.
+ *
+ * @param dec    Decoder handle
+ * @param audio  Audio samples (mono, float, 12 kHz)
+ * @param n      Number of samples
+ * @return       Samples taken (fewer than n once cfg.max_samples is reached)
+ */
+int ft4_decoder_feed(ft4_decoder_t *dec, const float *audio, int n);
+
+/**
+ * Decode the audio fed since the last reset, within cfg.deadline_ms.
+ *
+ * @param dec      Decoder handle
+ * @param out      Output array for decoded messages, best sync first
+ * @param max_out  Capacity of out
+ * @return         Number of messages written to out
+ */
+int ft4_decoder_decode_fed(ft4_decoder_t *dec, ft4_result_t *out, int max_out);
+
+/**
+ * Decode one slot of audio: reset, feed and decode_fed in one call.
+ *
+ * @param dec      Decoder handle
+ * @param audio    Audio samples (mono, float, 12 kHz)
+ * @param n        Number of samples (at most cfg.max_samples are used)
+ * @param out      Output array for decoded messages, best sync first
+ * @param max_out  Capacity of out
+ * @return         Number of messages written to out
+ */
+int ft4_decoder_decode(ft4_decoder_t *dec, const float *audio, int n,
+                       ft4_result_t *out, int max_out);
+
+/**
+ * The 105 channel tones of a 77-bit payload, as FT4 sends them:
+ * scrambled, CRC-14, LDPC(174,91), Gray-coded between the Costas blocks.
+ *
+ * @param payload  FT4_PAYLOAD_BITS bits, 0/1
+ * @param tones    Out: FT4_SYMBOL_COUNT tones (0-3)
+ */
+void ft4_encode(const uint8_t *payload, uint8_t *tones);
+
+/**
+ * Destroy decoder and free all resources.
+ */
+void ft4_decoder_destroy(ft4_decoder_t *dec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FT4_DECODER_H */
@@ -0,0 +1,76 @@
+import Foundation
+
+/// Recently heard callsigns, shared by FT8 and JS8 decoding.
+///
+/// Wraps the native LRU table (`ft8_calls.h`). A standard 28-bit callsign
+/// is unpacked the first time it is heard and looked up by code after
+/// that. A hashed callsign (`<...>`) resolves against every call heard in
+/// full, whichever mode it was heard in. Both lookups are O(1). The Swift
+/// string of each entry is built once and reused until the entry goes to
+/// another call, so a call heard again allocates nothing.
+final class CallsignTable {
+
+    static let shared = CallsignTable()
+
+    /// Placeholder for a hashed call not heard in full yet, as WSJT-X shows it.
+    static let unresolved = "<...>"
+
+    private let table: OpaquePointer?
+    private var strings: [String?]
+    private var stamps: [UInt32]
+    private let lock = NSLock()
+
+    init(capacity: Int = 1024) {
+        table = ft8_calls_create(Int32(capacity))
+        strings = [String?](repeating: nil, count: capacity)
+        stamps = [UInt32](repeating: 0, count: capacity)
+    }
+
+    deinit {
+        if let t = table { ft8_calls_destroy(t) }
+    }
+
+    /// WSJT-X hash of a callsign: 22 bits in the callsign field, 12 or 10 elsewhere.
+    static func hash(_ call: String, bits: Int = 22) -> UInt32 {
+        ft8_call_hash(call.uppercased(), Int32(bits))
+    }
+
+    /// Callsign of a standard 28-bit code, or nil if the code is not one.
+    func callsign(n28: UInt32) -> String? {
+        lock.lock()
+        defer { lock.unlock() }
+        guard let t = table else { return nil }
+        return string(t, ft8_calls_find_n28(t, n28))
+    }
+
+    /// Hashed callsign as displayed: `<CALL>` once heard in full, else `<...>`.
+    func hashed(_ hash: UInt32, bits: Int = 22) -> String {
+        lock.lock()
+        defer { lock.unlock() }
+        guard let t = table,
+              let call = string(t, ft8_calls_find_hash(t, hash, Int32(bits))) else {
+            return Self.unresolved
+        }
+        return "<\(call)>"
+    }
+
+    /// Remember a callsign heard in full, so its hash resolves from now on.
+    func record(_ call: String) {
+        lock.lock()
+        defer { lock.unlock() }
+        guard let t = table else { return }
+        _ = ft8_calls_add(t, call)
+    }
+
+    /// Cached string for an entry, rebuilt only after the entry changed hands.
+    private func string(_ t: OpaquePointer, _ entry: Int32) -> String? {
+        guard entry >= 0 else { return nil }
+        let e = Int(entry)
+        let stamp = ft8_calls_stamp(t, entry)
+        if stamps[e] != stamp || strings[e] == nil {
+            strings[e] = String(cString: ft8_calls_get(t, entry))
+            stamps[e] = stamp
+        }
+        return strings[e]
+    }
+}
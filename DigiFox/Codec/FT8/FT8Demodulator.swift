@@ -1,23 +1,74 @@
 import Foundation
-import Accelerate
 
 /// FT8 Demodulator — RX chain.
 ///
-/// Pipeline: Audio → spectrogram → Costas sync search → extract soft symbols
-///         → LDPC decode → CRC-14 validate → unpack → FT8Message.
+/// Pipeline: Audio → oversampled waterfall → Costas sync search → extract soft symbols
+///         → LDPC decode (OSD fallback) → CRC-14 validate → subtract decoded
+///         signals and repeat on the residual → unpack → FT8Message.
+///
+/// Everything before unpacking runs in the native core (`ft8_decoder.h`) on
+/// flat, preallocated buffers; only the 77 payload bits of each decode
+/// come back to Swift for unpacking.
+///
+/// Audio can be handed over whole (`demodulate`) or taken live from the
+/// sample ring the audio thread writes (`start`). Live audio is pulled
+/// off the audio thread by `pump`, `decodeEarly` and `decodeSlot`, which
+/// cut the slots at ring indices on the 15 s UTC grid; the audio thread
+/// itself never waits for the decoder. Pumped during the slot, the
+/// waterfall is built as the audio arrives and only sync and decoding are
+/// left for the end; with `AudioEngine.spectrum` it is taken from the
+/// shared engine's rows rather than transformed again.
+/// `decodeEarly` at `earlyDecodeTime` returns frames that are nearly
+/// complete, so a reply can still go out in the next slot; `decodeSlot`
+/// then only reports what it missed.
 final class FT8Demodulator {
 
     /// Minimum Costas correlation score to consider a candidate.
-    var syncThreshold: Double = 4.0
+    var syncThreshold: Double = 4.0 { didSet { rebuild() } }
 
     /// Maximum number of sync candidates to attempt decoding.
-    var maxCandidates: Int = 40
+    var maxCandidates: Int = 40 { didSet { rebuild() } }
 
     /// Minimum search frequency (Hz).
-    var minFrequency: Double = 200.0
+    var minFrequency: Double = 200.0 { didSet { rebuild() } }
 
     /// Maximum search frequency (Hz).
-    var maxFrequency: Double = 3000.0
+    var maxFrequency: Double = 3000.0 { didSet { rebuild() } }
+
+    /// Ordered-statistics fallback after LDPC: 0 = off, 1 or 2 bit flips.
+    var osdDepth: Int = 2 { didSet { rebuild() } }
+
+    /// Time the OSD fallback may spend per slot (seconds).
+    var osdTimeBudget: Double = 0.25 { didSet { rebuild() } }
+
+    /// Decode passes at slot end. Each pass after the first subtracts the
+    /// signals decoded so far from the audio and decodes the residual.
+    var decodePasses: Int = 3 { didSet { rebuild() } }
+
+    /// Threads sharing the per-candidate work (soft bits, LDPC, OSD);
+    /// 0 = one per performance core.
+    var decodeThreads: Int = 0 { didSet { rebuild() } }
+
+    /// Score the Costas search on the GPU (`ft8_sync_metal.h`), leaving the
+    /// cores to LDPC and subtraction; the CPU does it when there is no GPU.
+    var gpuSync: Bool = false { didSet { rebuild() } }
+
+    /// How hard the next decodes try, within the settings above: candidates
+    /// and passes are capped at `maxCandidates` and `decodePasses`. Unlike
+    /// them it takes effect without a rebuild, so the slot's audio is kept
+    /// (nil = the settings as they are).
+    var effort: Effort? { didSet { applyEffort() } }
+
+    /// Per-slot decode work, see `effort`.
+    struct Effort: Equatable {
+        var maxCandidates: Int
+        var passes: Int
+        var osdDepth: Int
+        var osdTimeBudget: Double       // seconds
+    }
+
+    /// Seconds into the slot for `decodeEarly`, as WSJT-X's early decode.
+    static let earlyDecodeTime: Double = 11.8
 
     /// A successfully decoded FT8 message with metadata.
     struct DecodedMessage {
@@ -27,193 +78,201 @@ final class FT8Demodulator {
         let timeOffset: Double      // time offset within the buffer in seconds
     }
 
+    /// Samples in one slot.
+    static let slotSamples = Int64(FT8Protocol.txWindow * FT8Protocol.sampleRate)
+
+    /// Native decoder, built in `init` and again when a setting changes.
+    private var decoder: OpaquePointer?
+    private var results = [ft8_result_t](repeating: ft8_result_t(), count: 64)
+    private var fedSamples = 0
+    private let lock = NSLock()
+
+    /// Live audio (`start`): the ring and the engine that transformed it.
+    private var source: SampleRing?
+    private var spectrum: SpectrumEngine?
+    /// Ring index of the current slot's first sample (may precede the ring).
+    private var slotStart: Int64 = 0
+    /// Ring index of the next sample to hand to the decoder.
+    private var next: Int64 = 0
+    private let silence = [Float](repeating: 0, count: 4096)
+
+    init() {
+        rebuild()
+    }
+
+    deinit {
+        if let dec = decoder { ft8_decoder_destroy(dec) }
+    }
+
     // MARK: - Public API
 
     /// Demodulate audio samples (12 kHz sample rate) and return decoded FT8 messages.
     func demodulate(_ samples: [Float]) -> [DecodedMessage] {
-        // Generate spectrogram
-        let spec = FT8CostasSync.spectrogram(from: samples)
-        guard !spec.isEmpty else { return [] }
-
-        let freqBins = spec[0].count
-        let binSpacing = FT8Protocol.sampleRate / Double(FT8Protocol.symbolSamples * 2)
-        let minBin = max(0, Int(minFrequency / binSpacing))
-        let maxBin = min(freqBins - 8, Int(maxFrequency / binSpacing))
-
-        // Find sync candidates
-        let candidates = FT8CostasSync.correlate(
-            spectrogram: spec,
-            freqBins: freqBins,
-            minFreq: minBin,
-            maxFreq: maxBin,
-            maxCandidates: maxCandidates
-        )
-
-        var decoded = [DecodedMessage]()
-        var usedOffsets = Set<Int>()   // prevent duplicate decodes at same time/freq
-
-        for candidate in candidates {
-            // Deduplicate: skip if we already decoded near this time/freq
-            let key = (candidate.timeOffset / FT8Protocol.symbolSamples) * 1000 + candidate.freqBin
-            if usedOffsets.contains(key) { continue }
-
-            // Extract soft symbols
-            let symbolStart = candidate.timeOffset / FT8Protocol.symbolSamples
-            guard let softBits = extractSoftBits(
-                spectrogram: spec,
-                timeStart: symbolStart,
-                freqBin: candidate.freqBin,
-                freqBins: freqBins
-            ) else { continue }
-
-            // LDPC decode
-            guard let decoded91 = LDPC.decode(softBits) else { continue }
-
-            // CRC validate
-            let message91 = decoded91.map { $0 }
-            guard FT8CRC.validate(message91) else { continue }
-
-            // Extract 77 payload bits
-            let payload = Array(message91[0..<FT8Protocol.payloadBits])
-
-            // Unpack message
-            let msg = FT8MessagePack.unpack(payload)
-
-            // Estimate SNR
-            let snr = estimateSNR(spectrogram: spec, candidate: candidate, freqBins: freqBins)
-
-            // Refine frequency
-            let refinedFreq = FT8CostasSync.refineFrequency(
-                spectrogram: spec, candidate: candidate, freqBins: freqBins
-            )
+        samples.withUnsafeBufferPointer { demodulate($0) }
+    }
 
-            let timeOffsetSec = Double(candidate.timeOffset) / FT8Protocol.sampleRate
+    /// `demodulate` on audio in place, e.g. a window of `AudioEngine`'s buffer.
+    /// A live slot in progress is taken from the ring again afterwards.
+    func demodulate(_ samples: UnsafeBufferPointer<Float>) -> [DecodedMessage] {
+        lock.lock()
+        defer { lock.unlock() }
 
-            decoded.append(DecodedMessage(
-                message: msg,
-                snr: snr,
-                frequency: refinedFreq,
-                timeOffset: timeOffsetSec
-            ))
+        guard let base = samples.baseAddress, !samples.isEmpty, let dec = decoder else { return [] }
 
-            usedOffsets.insert(key)
+        let n = results.withUnsafeMutableBufferPointer { out in
+            ft8_decoder_decode(dec, base, Int32(samples.count), out.baseAddress, Int32(out.count))
         }
-
-        return decoded
+        restartSlot(dec)
+        return messages(Int(n))
     }
 
-    // MARK: - Soft Symbol Extraction
-
-    /// Extract 174 soft LLR values from the spectrogram at the given time/freq position.
-    private func extractSoftBits(
-        spectrogram: [[Float]],
-        timeStart: Int,
-        freqBin: Int,
-        freqBins: Int
-    ) -> [Float]? {
-        let dataPositions = FT8Protocol.dataPositions
-        guard dataPositions.count == FT8Protocol.dataSymbolCount else { return nil }
+    /// Receive live audio from `ring`, written by the audio thread; the
+    /// sample at index `ring.written` is taken as heard at `date`, which
+    /// places the slot grid. `spectrum` is the engine fed with the same
+    /// stream, ring index i being its stream index i (nil = own FFTs).
+    func start(ring: SampleRing?, spectrum: SpectrumEngine?, at date: Date = Date()) {
+        lock.lock()
+        defer { lock.unlock() }
+
+        source = ring
+        self.spectrum = spectrum
+        let intoSlot = date.timeIntervalSince1970.truncatingRemainder(dividingBy: FT8Protocol.txWindow)
+        slotStart = Int64(ring?.written ?? 0) - Int64(intoSlot * FT8Protocol.sampleRate)
+        if let dec = decoder { restartSlot(dec) }
+    }
 
-        var llr = [Float](repeating: 0, count: FT8Protocol.codedBits)
+    /// Hand the decoder the live audio of the slot that arrived since the
+    /// last call. Call it every second or so off the audio thread; the
+    /// shared engine only keeps about 10 s of rows.
+    func pump() {
+        lock.lock()
+        defer { lock.unlock() }
+        if let dec = decoder { take(dec) }
+    }
 
-        for (dataIdx, symPos) in dataPositions.enumerated() {
-            let row = timeStart + symPos
-            guard row >= 0, row < spectrogram.count else { return nil }
+    /// Decode frames of the current slot that are nearly complete. The
+    /// messages found are not returned again by `decodeSlot`.
+    func decodeEarly() -> [DecodedMessage] {
+        lock.lock()
+        defer { lock.unlock() }
 
-            // Read power in each of the 8 tone bins
-            var tonePower = [Float](repeating: 0, count: 8)
-            for tone in 0..<8 {
-                let bin = freqBin + tone
-                if bin >= 0, bin < freqBins {
-                    tonePower[tone] = spectrogram[row][bin]
-                }
-            }
+        guard let dec = decoder else { return [] }
+        take(dec)
+        guard fedSamples > 0 else { return [] }
 
-            // Convert tone powers to soft bits (3 bits per symbol, Gray-coded)
-            let bitOffset = dataIdx * FT8Protocol.bitsPerSymbol
-            let softBits = toneToSoftBits(tonePower)
-            for b in 0..<FT8Protocol.bitsPerSymbol {
-                if bitOffset + b < llr.count {
-                    llr[bitOffset + b] = softBits[b]
-                }
-            }
+        let n = results.withUnsafeMutableBufferPointer { out in
+            ft8_decoder_decode_early(dec, out.baseAddress, Int32(out.count))
         }
+        return messages(Int(n))
+    }
 
-        return llr
-    }
-
-    /// Convert 8 tone powers to 3 soft LLR bits using Gray-code mapping.
-    ///
-    /// For each of the 3 bit positions, compute the LLR as:
-    ///   LLR(bit_k) = log(sum of powers where bit_k=0) - log(sum of powers where bit_k=1)
-    /// Positive LLR means bit is more likely 0.
-    private func toneToSoftBits(_ powers: [Float]) -> [Float] {
-        var softBits = [Float](repeating: 0, count: 3)
-
-        for bit in 0..<3 {
-            var sum0: Float = 1e-10
-            var sum1: Float = 1e-10
-
-            for tone in 0..<8 {
-                let grayVal = FT8Protocol.grayDecode[tone]
-                let bitVal = (grayVal >> (2 - bit)) & 1
-                if bitVal == 0 {
-                    sum0 += powers[tone]
-                } else {
-                    sum1 += powers[tone]
-                }
+    /// Decode the current slot and move on to the next one on the grid
+    /// (to the slot in progress, if decoding fell behind).
+    func decodeSlot() -> [DecodedMessage] {
+        lock.lock()
+        defer { lock.unlock() }
+
+        guard let dec = decoder else { return [] }
+        take(dec)
+        defer {
+            slotStart += Self.slotSamples
+            if let ring = source, Int64(ring.written) - slotStart >= Self.slotSamples {
+                slotStart += (Int64(ring.written) - slotStart) / Self.slotSamples * Self.slotSamples
             }
-
-            softBits[bit] = log(sum0) - log(sum1)
+            restartSlot(dec)
         }
+        guard fedSamples > FT8Protocol.symbolSamples * FT8Protocol.symbolCount else { return [] }
 
-        return softBits
+        let n = results.withUnsafeMutableBufferPointer { out in
+            ft8_decoder_decode_fed(dec, out.baseAddress, Int32(out.count))
+        }
+        return messages(Int(n))
     }
 
-    // MARK: - SNR Estimation
-
-    /// Estimate signal-to-noise ratio from the spectrogram around a candidate.
-    private func estimateSNR(
-        spectrogram: [[Float]],
-        candidate: FT8CostasSync.Candidate,
-        freqBins: Int
-    ) -> Float {
-        let timeStart = candidate.timeOffset / FT8Protocol.symbolSamples
-        let f = candidate.freqBin
-
-        var signalPower: Float = 0
-        var noisePower: Float = 0
-        var signalCount = 0
-        var noiseCount = 0
-
-        for pos in FT8Protocol.dataPositions {
-            let row = timeStart + pos
-            guard row >= 0, row < spectrogram.count else { continue }
+    /// Start the current slot over: the next `take` feeds it from its start.
+    private func restartSlot(_ dec: OpaquePointer) {
+        ft8_decoder_reset(dec)
+        next = slotStart
+        fedSamples = 0
+    }
 
-            // Signal: max power in tone bins
-            for tone in 0..<8 {
-                let bin = f + tone
-                guard bin >= 0, bin < freqBins else { continue }
-                signalPower += spectrogram[row][bin]
-                signalCount += 1
+    /// Feed the ring's samples of the current slot from `next` on. Those
+    /// the ring no longer (or never) had go in as silence, so the slot
+    /// keeps its place on the grid.
+    private func take(_ dec: OpaquePointer) {
+        guard let ring = source else { return }
+        let end = min(Int64(ring.written), slotStart + Self.slotSamples)
+        guard next < end else { return }
+
+        _ = ring.withIndexedWindow(from: UInt64(max(next, 0))) { buf, first in
+            while next < min(Int64(first), end) {
+                let n = Int(min(min(Int64(first), end) - next, Int64(silence.count)))
+                fedSamples += Int(silence.withUnsafeBufferPointer { ft8_decoder_feed(dec, $0.baseAddress, Int32(n)) })
+                next += Int64(n)
             }
+            let skip = Int(next - Int64(first))
+            let n = Int(end - next)
+            guard n > 0, skip >= 0, skip + n <= buf.count, let base = buf.baseAddress else { return }
+            let taken = ft8_decoder_feed_shared(dec, base + skip, Int32(n), spectrum?.native, UInt64(next))
+            fedSamples += Int(taken)
+            next += Int64(n)
+        }
+    }
 
-            // Noise: bins outside the signal bandwidth
-            for offset in [-4, -3, -2, -1, 9, 10, 11, 12] {
-                let bin = f + offset
-                guard bin >= 0, bin < freqBins else { continue }
-                noisePower += spectrogram[row][bin]
-                noiseCount += 1
-            }
+    private func messages(_ n: Int) -> [DecodedMessage] {
+        results.prefix(n).map { r in
+            let payload = withUnsafeBytes(of: r.payload) { Array($0) }
+            return DecodedMessage(
+                message: FT8MessagePack.unpack(payload),
+                snr: r.snr,
+                frequency: Double(r.freq_hz),
+                timeOffset: Double(r.time_s)
+            )
         }
+    }
 
-        let avgSignal = signalCount > 0 ? signalPower / Float(signalCount) : 1e-10
-        let avgNoise = noiseCount > 0 ? noisePower / Float(noiseCount) : 1e-10
+    // MARK: - Native Decoder
+
+    /// (Re)build the native decoder with the current settings, on the
+    /// caller's thread, and take the live slot in progress from the ring
+    /// again.
+    private func rebuild() {
+        var cfg = ft8_config_t()
+        ft8_config_init(&cfg)
+        cfg.min_freq = Float(minFrequency)
+        cfg.max_freq = Float(maxFrequency)
+        cfg.sync_threshold = Float(syncThreshold)
+        cfg.max_candidates = Int32(maxCandidates)
+        cfg.osd_depth = Int32(osdDepth)
+        cfg.osd_budget_ms = Float(osdTimeBudget * 1000)
+        cfg.passes = Int32(decodePasses)
+        cfg.threads = Int32(decodeThreads)
+        if gpuSync, let gpu = ft8_sync_metal_shared() {
+            cfg.sync_score = ft8_sync_metal_score
+            cfg.sync_ctx = UnsafeMutableRawPointer(gpu)
+        }
+        let built = ft8_decoder_create(&cfg)
+
+        lock.lock()
+        defer { lock.unlock() }
+        if let dec = decoder { ft8_decoder_destroy(dec) }
+        decoder = built
+        if let dec = decoder {
+            if effort != nil { setNativeEffort(dec) }
+            restartSlot(dec)
+        }
+    }
 
-        // SNR in dB, referenced to 2500 Hz bandwidth
-        let snrLinear = Double(avgSignal) / Double(avgNoise)
-        let snrDB = 10.0 * log10(snrLinear) - 10.0 * log10(2500.0 / FT8Protocol.toneSpacing)
+    private func applyEffort() {
+        lock.lock()
+        defer { lock.unlock() }
+        if let dec = decoder { setNativeEffort(dec) }
+    }
 
-        return Float(snrDB)
+    private func setNativeEffort(_ dec: OpaquePointer) {
+        let e = effort ?? Effort(maxCandidates: maxCandidates, passes: decodePasses,
+                                 osdDepth: osdDepth, osdTimeBudget: osdTimeBudget)
+        ft8_decoder_set_effort(dec, Int32(e.maxCandidates), Int32(e.passes),
+                               Int32(e.osdDepth), Float(e.osdTimeBudget * 1000))
     }
 }
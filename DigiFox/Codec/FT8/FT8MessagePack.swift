@@ -62,11 +62,54 @@ enum FT8MessagePack {
     }
 
     /// Unpack 77 payload bits into an FT8Message.
+    ///
+    /// Messages are cached by payload, so one heard every slot (a CQ, a
+    /// beacon) is unpacked once. Those naming a hashed call that is not
+    /// resolved yet stay out of the cache until it is.
     static func unpack(_ bits: [UInt8]) -> FT8Message {
         guard bits.count >= FT8Protocol.payloadBits else {
             return FT8Message(type: .freeText, freeText: "?")
         }
 
+        let key = PayloadKey(bits)
+        cacheLock.lock()
+        let cached = cache[key]
+        cacheLock.unlock()
+        if let msg = cached {
+            // A full unpack would have refreshed its calls in the table
+            if let from = msg.from { CallsignTable.shared.record(from) }
+            if let to = msg.to, to != "CQ" { CallsignTable.shared.record(to) }
+            return msg
+        }
+
+        let msg = unpackFields(bits)
+        if msg.from != CallsignTable.unresolved && msg.to != CallsignTable.unresolved {
+            cacheLock.lock()
+            if cache.count >= cacheLimit { cache.removeAll(keepingCapacity: true) }
+            cache[key] = msg
+            cacheLock.unlock()
+        }
+        return msg
+    }
+
+    // MARK: - Message Cache
+
+    /// The 77 payload bits as two words.
+    private struct PayloadKey: Hashable {
+        var high: UInt64 = 0
+        var low: UInt64 = 0
+
+        init(_ bits: [UInt8]) {
+            for i in 0..<13 { high = (high << 1) | UInt64(bits[i] & 1) }
+            for i in 13..<FT8Protocol.payloadBits { low = (low << 1) | UInt64(bits[i] & 1) }
+        }
+    }
+
+    private static var cache = [PayloadKey: FT8Message]()
+    private static let cacheLimit = 512
+    private static let cacheLock = NSLock()
+
+    private static func unpackFields(_ bits: [UInt8]) -> FT8Message {
         let i3 = extractBits(bits, start: 74, count: 3)
         let n3 = extractBits(bits, start: 71, count: 3)
 
@@ -218,10 +261,13 @@ enum FT8MessagePack {
     //   c3-c5: ' '=0, 'A'-'Z'=1-26                (27 values)
     //
     // n28 = ((((c0*36 + c1)*10 + c2)*27 + c3)*27 + c4)*27 + c5
+    //
+    // Calls that do not fit go as hashedCallBase + their 22-bit hash.
 
     static func encodeCallsign(_ call: String) -> UInt32 {
         let trimmed = call.uppercased().trimmingCharacters(in: .whitespaces)
         if trimmed == "CQ" { return FT8Protocol.cqToken }
+        if trimmed.isEmpty { return 0 }
 
         // Align so that the digit falls at position 2 (0-indexed)
         let aligned = alignCallsign(trimmed)
@@ -235,27 +281,34 @@ enum FT8MessagePack {
 
         let val = ((((UInt32(c0) * 36 + UInt32(c1)) * 10 + UInt32(c2)) * 27
                     + UInt32(c3)) * 27 + UInt32(c4)) * 27 + UInt32(c5)
-        return val
+        if isStandard(val, trimmed) { return val }
+
+        // Portable or long calls do not fit: send the 22-bit hash, and
+        // remember the call so our own transmissions resolve locally.
+        CallsignTable.shared.record(trimmed)
+        return FT8Protocol.hashedCallBase + CallsignTable.hash(trimmed)
     }
 
+    /// Standard codes and hashes resolve through `CallsignTable.shared`:
+    /// no per-character string building, and a hash finds any call heard
+    /// in full so far.
     static func decodeCallsign(_ val: UInt32) -> String {
         if val == FT8Protocol.cqToken { return "CQ" }
         if val >= FT8Protocol.cqToken - 3 { return "CQ" }
         if val >= FT8Protocol.ntokens { return "?" }
 
-        var rem = val
-        let c5 = rem % 27; rem /= 27
-        let c4 = rem % 27; rem /= 27
-        let c3 = rem % 27; rem /= 27
-        let c2 = rem % 10; rem /= 10
-        let c1 = rem % 36; rem /= 36
-        let c0 = rem
+        let hashed = val &- FT8Protocol.hashedCallBase
+        if hashed < FT8Protocol.hashedCallCount {
+            return CallsignTable.shared.hashed(hashed)
+        }
+        return CallsignTable.shared.callsign(n28: val) ?? "?"
+    }
 
-        let chars: [Character] = [
-            decodeC0(c0), decodeC1(c1), decodeC2(c2),
-            decodeC345(c3), decodeC345(c4), decodeC345(c5)
-        ]
-        return String(chars).trimmingCharacters(in: .whitespaces)
+    /// Whether n28 unpacks back to exactly this call.
+    private static func isStandard(_ val: UInt32, _ call: String) -> Bool {
+        var buf = [CChar](repeating: 0, count: Int(FT8_CALL_MAX) + 1)
+        guard ft8_call_unpack28(val, &buf) > 0 else { return false }
+        return String(cString: buf) == call
     }
 
     /// Align a callsign so the digit is at position 2.
@@ -285,12 +338,6 @@ enum FT8MessagePack {
         }
         return 0
     }
-    private static func decodeC0(_ v: UInt32) -> Character {
-        if v == 0 { return " " }
-        if v <= 26 { return Character(UnicodeScalar(0x41 + v - 1)!) }
-        if v <= 36 { return Character(UnicodeScalar(0x30 + v - 27)!) }
-        return " "
-    }
 
     // Position 1: '0'-'9'=0-9, 'A'-'Z'=10-35
     private static func encodeC1(_ c: Character) -> Int {
@@ -300,11 +347,6 @@ enum FT8MessagePack {
         }
         return 0
     }
-    private static func decodeC1(_ v: UInt32) -> Character {
-        if v <= 9 { return Character(UnicodeScalar(0x30 + v)!) }
-        if v <= 35 { return Character(UnicodeScalar(0x41 + v - 10)!) }
-        return "0"
-    }
 
     // Position 2: '0'-'9'=0-9
     private static func encodeC2(_ c: Character) -> Int {
@@ -313,9 +355,6 @@ enum FT8MessagePack {
         }
         return 0
     }
-    private static func decodeC2(_ v: UInt32) -> Character {
-        return Character(UnicodeScalar(0x30 + min(v, 9))!)
-    }
 
     // Positions 3-5: ' '=0, 'A'-'Z'=1-26
     private static func encodeC345(_ c: Character) -> Int {
@@ -325,11 +364,6 @@ enum FT8MessagePack {
         }
         return 0
     }
-    private static func decodeC345(_ v: UInt32) -> Character {
-        if v == 0 { return " " }
-        if v <= 26 { return Character(UnicodeScalar(0x41 + v - 1)!) }
-        return " "
-    }
 
     // MARK: - Grid Encoding (15 bits)
 
@@ -6,7 +6,8 @@ import Accelerate
 /// Pipeline: FT8Message → pack (77 bits) → CRC-14 (91 bits) → LDPC encode (174 bits)
 ///         → Gray-coded 8-FSK symbols (58 data + 21 sync = 79) → GFSK audio waveform.
 ///
-/// Generates continuous-phase FSK with raised-cosine amplitude ramp.
+/// Generates continuous-phase GFSK (BT = 2.0, as WSJT-X sends it) with a
+/// raised-cosine amplitude ramp, through the shared `ToneSynthesizer`.
 final class FT8Modulator {
 
     /// Audio frequency of the lowest tone (Hz).
@@ -16,27 +17,46 @@ final class FT8Modulator {
     var amplitude: Double = 0.5
 
     /// Duration of raised-cosine ramp at start/end (seconds).
-    var rampDuration: Double = 0.005
+    var rampDuration: Double = 0.005 { didSet { synthesizer = nil } }
+
+    /// Gaussian bandwidth-time product of the tone steps; 0 = plain FSK.
+    var bt: Double = 2.0 { didSet { synthesizer = nil } }
+
+    /// Built on first use with the current shaping.
+    private var synthesizer: ToneSynthesizer?
 
     // MARK: - Public API
 
     /// Modulate an FT8Message into audio samples at 12 kHz.
     func modulate(_ message: FT8Message) -> [Float] {
-        let payload = FT8MessagePack.pack(message)
-        let withCRC = FT8CRC.append(to: payload)
-        let codeword = LDPC.encode(withCRC)
-        let symbols = bitsToSymbols(codeword)
-        let frame = insertSync(symbols)
-        return synthesize(frame)
+        synthesize(tones(for: FT8MessagePack.pack(message)))
     }
 
     /// Modulate raw 77-bit payload (for testing or pre-packed messages).
     func modulatePayload(_ payload: [UInt8]) -> [Float] {
+        synthesize(tones(for: payload))
+    }
+
+    /// Stream an FT8Message: 12 kHz audio rendered block by block as the
+    /// output pulls it, from a synthesizer of its own.
+    func source(for message: FT8Message) -> TXAudioSource? {
+        guard let synth = makeSynthesizer() else { return nil }
+        let ok = synth.start(tones: tones(for: FT8MessagePack.pack(message)),
+                             baseFrequency: baseFrequency, amplitude: amplitude)
+        return ok ? synth : nil
+    }
+
+    /// The 79 channel tones of a message, e.g. for FSK keying by CAT.
+    func tones(for message: FT8Message) -> [Int] {
+        tones(for: FT8MessagePack.pack(message))
+    }
+
+    /// 77-bit payload → 79 channel tones.
+    private func tones(for payload: [UInt8]) -> [Int] {
         let withCRC = FT8CRC.append(to: payload)
         let codeword = LDPC.encode(withCRC)
         let symbols = bitsToSymbols(codeword)
-        let frame = insertSync(symbols)
-        return synthesize(frame)
+        return insertSync(symbols)
     }
 
     // MARK: - Symbol Mapping
@@ -82,49 +102,20 @@ final class FT8Modulator {
 
     /// Synthesize continuous-phase GFSK audio from 79 tone symbols.
     private func synthesize(_ symbols: [Int]) -> [Float] {
-        let sampleRate = FT8Protocol.sampleRate
-        let symbolSamples = FT8Protocol.symbolSamples
-        let totalSamples = FT8Protocol.frameSamples
-        let rampSamples = Int(rampDuration * sampleRate)
-
-        var samples = [Float](repeating: 0, count: totalSamples)
-        var phase: Double = 0
-
-        for (symIdx, symbol) in symbols.enumerated() {
-            let freq = baseFrequency + Double(symbol) * FT8Protocol.toneSpacing
-            let phaseIncrement = 2.0 * .pi * freq / sampleRate
-
-            for j in 0..<symbolSamples {
-                let sampleIdx = symIdx * symbolSamples + j
-                guard sampleIdx < totalSamples else { break }
-
-                let value = sin(phase) * amplitude
-                samples[sampleIdx] = Float(value)
-                phase += phaseIncrement
-
-                // Keep phase in [0, 2π) to prevent floating-point drift
-                if phase >= 2.0 * .pi {
-                    phase -= 2.0 * .pi
-                }
-            }
-        }
-
-        // Apply raised-cosine ramp at start and end
-        applyRamp(&samples, rampSamples: rampSamples)
-
-        return samples
+        guard let synth = toneSynthesizer() else { return [] }
+        return synth.renderFrame(tones: symbols, baseFrequency: baseFrequency, amplitude: amplitude)
     }
 
-    /// Apply raised-cosine ramp to avoid click artifacts.
-    private func applyRamp(_ samples: inout [Float], rampSamples: Int) {
-        let count = samples.count
-        guard rampSamples > 0, count > 2 * rampSamples else { return }
+    private func toneSynthesizer() -> ToneSynthesizer? {
+        if let synth = synthesizer { return synth }
+        synthesizer = makeSynthesizer()
+        return synthesizer
+    }
 
-        for i in 0..<rampSamples {
-            let ramp = Float(0.5 * (1.0 - cos(.pi * Double(i) / Double(rampSamples))))
-            samples[i] *= ramp
-            samples[count - 1 - i] *= ramp
-        }
+    private func makeSynthesizer() -> ToneSynthesizer? {
+        ToneSynthesizer(sampleRate: FT8Protocol.sampleRate,
+                        symbolSamples: FT8Protocol.symbolSamples,
+                        bt: bt, rampDuration: rampDuration)
     }
 
     // MARK: - Utility
@@ -59,6 +59,10 @@ enum FT8Protocol {
 
     static let ntokens: UInt32 = 268_435_456       // 2^28
     static let cqToken: UInt32 = ntokens - 2
+    /// Standard calls take codes below this; a 22-bit callsign hash h is
+    /// sent as `hashedCallBase + h` (`FT8_CALL_N28_HASH`).
+    static let hashedCallBase: UInt32 = 262_177_560    // 37·36·10·27³
+    static let hashedCallCount: UInt32 = 1 << 22
 
     // MARK: - Gray Code Tables
 
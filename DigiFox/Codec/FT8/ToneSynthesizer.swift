@@ -0,0 +1,80 @@
+import Foundation
+
+/// Continuous-phase FSK / GFSK synthesizer shared by the TX modulators.
+///
+/// Wraps the native synthesizer (`ft8_synth.h`): an integer phase
+/// accumulator, a sine table and a precomputed Gaussian frequency pulse,
+/// so rendering makes no `sin()` or `cos()` calls. A frame is started
+/// from its tones and rendered in blocks of any size, or all at once
+/// with `renderFrame`.
+final class ToneSynthesizer {
+
+    let sampleRate: Double
+    let symbolSamples: Int
+
+    private let synth: OpaquePointer
+    private let lock = NSLock()
+
+    /// - Parameters:
+    ///   - bt: Gaussian bandwidth-time product of the frequency pulse
+    ///     (FT8 and JS8: 2.0); 0 sends plain FSK.
+    ///   - rampDuration: Raised-cosine ramp at each end of a frame (s).
+    init?(sampleRate: Double, symbolSamples: Int, bt: Double, rampDuration: Double) {
+        var cfg = ft8_synth_config_t()
+        ft8_synth_config_init(&cfg)
+        cfg.sample_rate = Float(sampleRate)
+        cfg.symbol_samples = Int32(symbolSamples)
+        cfg.bt = Float(bt)
+        cfg.ramp_samples = Int32(rampDuration * sampleRate)
+        guard let s = ft8_synth_create(&cfg) else { return nil }
+        self.synth = s
+        self.sampleRate = sampleRate
+        self.symbolSamples = symbolSamples
+    }
+
+    deinit {
+        ft8_synth_destroy(synth)
+    }
+
+    /// Samples in the current frame.
+    var length: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return Int(ft8_synth_length(synth))
+    }
+
+    /// Samples of the current frame not rendered yet.
+    var remaining: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return Int(ft8_synth_remaining(synth))
+    }
+
+    /// Begin a frame. Returns false if `tones` is empty or too long.
+    @discardableResult
+    func start(tones: [Int], baseFrequency: Double, amplitude: Double) -> Bool {
+        let bytes = tones.map { UInt8(truncatingIfNeeded: $0) }
+        lock.lock()
+        defer { lock.unlock() }
+        return bytes.withUnsafeBufferPointer { buf in
+            ft8_synth_start(synth, buf.baseAddress, Int32(buf.count),
+                            Float(baseFrequency), Float(amplitude)) == 0
+        }
+    }
+
+    /// Render the next block; returns the samples written, 0 once the frame is done.
+    func render(into buffer: UnsafeMutableBufferPointer<Float>) -> Int {
+        guard let base = buffer.baseAddress else { return 0 }
+        lock.lock()
+        defer { lock.unlock() }
+        return Int(ft8_synth_render(synth, base, Int32(buffer.count)))
+    }
+
+    /// Synthesize a whole frame.
+    func renderFrame(tones: [Int], baseFrequency: Double, amplitude: Double) -> [Float] {
+        guard start(tones: tones, baseFrequency: baseFrequency, amplitude: amplitude) else { return [] }
+        var samples = [Float](repeating: 0, count: length)
+        let n = samples.withUnsafeMutableBufferPointer { render(into: $0) }
+        return Array(samples.prefix(n))
+    }
+}
@@ -0,0 +1,390 @@
+/**
+ * ft8_bench.c — Standalone benchmark for the C FT8 decoder core
+ *
+ * Synthesizes 15 s slots holding N FT8 signals with random payloads
+ * (continuous-phase 8-FSK as FT8Modulator, random base frequency and
+ * start time, white Gaussian noise at a given SNR in 2500 Hz, optionally
+ * each signal up to -r dB stronger), feeds each
+ * to the decoder in 0.1 s chunks as the audio engine would and times
+ * ft8_decoder_decode_fed() at slot end, optionally after an early decode
+ * (-e). With -S the audio goes through a shared spectrum engine first
+ * and the decoder takes its rows, as AudioEngine feeds it; the feed
+ * time then includes the engine. Reports the total feed time, the early and slot-end decode times
+ * and the latter's real-time factor, and how many of the sent messages
+ * came back (and how many of those early), plus false decodes (payloads
+ * that were never sent). Each slot's times are the best of -n repeats.
+ *
+ * With -A the slots come from a recording (audio_archive.h) instead:
+ * every whole 15 s UTC slot in it is resampled to 12 kHz if need be, fed
+ * and decoded once, and each message is listed (SNR, dt, frequency, the
+ * 77 bits in hex and, for standard messages, the two calls).
+ *
+ * Not part of the app target; see bench/Makefile.
+ */
+
+#include "ft8_decoder.h"
+#include "ft8_calls.h"
+#include "audio_archive.h"
+#include "polyphase_resampler.h"
+#include "bench_synth.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_MAX_SIGNALS   64
+#define BENCH_MAX_RESULTS   128
+#define BENCH_SLOT_SAMPLES  (15 * FT8_SAMPLE_RATE)
+#define BENCH_CHUNK_SAMPLES 1200      /* 0.1 s per feed */
+
+typedef struct {
+    int   signals;
+    float snr_db;
+    int   slots;
+    int   repeats;
+    int   aligned;         /* Start times on whole symbols */
+    int   max_candidates;
+    int   osd_depth;       /* -1 = decoder default */
+    float early_s;         /* Early decode after this much audio, 0 = off */
+    int   passes;          /* 0 = decoder default */
+    float spread_db;       /* Per-signal SNR in [snr_db, snr_db + spread_db] */
+    int   threads;         /* 0 = decoder default */
+    int   shared;          /* Feed through a spectrum engine */
+    const char *archive;   /* Replay this recording instead */
+} bench_opts_t;
+
+typedef struct {
+    uint8_t payload[FT8_PAYLOAD_BITS];
+    double  freq_hz;
+    double  start_s;
+    double  amplitude;
+} bench_signal_t;
+
+/* ------------------------------------------------------------------ */
+/* Signal synthesis                                                    */
+/* ------------------------------------------------------------------ */
+
+/* Non-overlapping frequencies, start within the first 2 s of the slot */
+static void pick_signals(const bench_opts_t *o, bench_signal_t *sig)
+{
+    for (int i = 0; i < o->signals; i++) {
+        for (int b = 0; b < FT8_PAYLOAD_BITS; b++) {
+            sig[i].payload[b] = bench_uniform() < 0.5;
+        }
+
+        double span = 2400.0 / o->signals;
+        double jitter = o->aligned ? 0.0 : bench_uniform() * FT8_TONE_SPACING;
+        int bin = (int)((300.0 + span * i) / FT8_TONE_SPACING);
+        sig[i].freq_hz = bin * FT8_TONE_SPACING + jitter;
+
+        sig[i].amplitude = pow(10.0, bench_uniform() * o->spread_db / 20.0);
+
+        int sym = (int)(bench_uniform() * 12.0);
+        sig[i].start_s = sym * (double)FT8_SYMBOL_SAMPLES / FT8_SAMPLE_RATE;
+        if (!o->aligned) sig[i].start_s += bench_uniform() * 0.16;
+    }
+}
+
+static void synth(const bench_opts_t *o, const bench_signal_t *sig, float *x)
+{
+    /* Unit-amplitude tones at snr_db: power 1/2 each */
+    memset(x, 0, BENCH_SLOT_SAMPLES * sizeof(float));
+    bench_add_noise(x, BENCH_SLOT_SAMPLES, FT8_SAMPLE_RATE, 0.5, o->snr_db);
+
+    for (int s = 0; s < o->signals; s++) {
+        uint8_t tones[FT8_SYMBOL_COUNT];
+        ft8_encode(sig[s].payload, tones);
+        bench_add_fsk(x, BENCH_SLOT_SAMPLES, (long)(sig[s].start_s * FT8_SAMPLE_RATE), tones,
+                      FT8_SYMBOL_COUNT, FT8_SYMBOL_SAMPLES, FT8_SAMPLE_RATE, sig[s].freq_hz,
+                      FT8_TONE_SPACING, 0.0, sig[s].amplitude);
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Timing                                                              */
+/* ------------------------------------------------------------------ */
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+/* ------------------------------------------------------------------ */
+/* Replay                                                              */
+/* ------------------------------------------------------------------ */
+
+static uint32_t payload_bits(const uint8_t *payload, int from, int n)
+{
+    uint32_t v = 0;
+    for (int i = 0; i < n; i++) v = (v << 1) | payload[from + i];
+    return v;
+}
+
+static void print_message(const ft8_result_t *r)
+{
+    char hex[2 * 10 + 1];
+    for (int b = 0; b < 10; b++) {
+        int n = b < 9 ? 8 : FT8_PAYLOAD_BITS - 72;
+        snprintf(hex + 2 * b, 3, "%02x", payload_bits(r->payload, 8 * b, n) << (8 - n));
+    }
+    printf("      %+4.0f  %+5.2f  %7.1f  %s", r->snr, r->time_s - 0.5, r->freq_hz, hex);
+
+    /* i3 = 1: c28 r1 c28 r1 R1 g15 */
+    if (payload_bits(r->payload, 74, 3) == 1) {
+        char a[FT8_CALL_MAX + 1], b[FT8_CALL_MAX + 1];
+        if (ft8_call_unpack28(payload_bits(r->payload, 0, 28), a) > 0 &&
+            ft8_call_unpack28(payload_bits(r->payload, 29, 28), b) > 0)
+            printf("  %s %s", a, b);
+    }
+    printf("\n");
+}
+
+static int replay(const bench_opts_t *o, ft8_decoder_t *dec, spectrum_engine_t *eng)
+{
+    audio_archive_t *a = audio_archive_open(o->archive);
+    if (!a) {
+        fprintf(stderr, "%s: not a recording\n", o->archive);
+        return 1;
+    }
+    const audio_archive_header_t *h = audio_archive_header(a);
+    polyphase_resampler_t *rs = NULL;
+    if (h->sample_rate != FT8_SAMPLE_RATE) {
+        rs = polyphase_resampler_create(h->sample_rate, FT8_SAMPLE_RATE, 0);
+        if (!rs) {
+            fprintf(stderr, "%s: cannot resample %.1f Hz to 12 kHz\n", o->archive, h->sample_rate);
+            audio_archive_close(a);
+            return 1;
+        }
+    }
+
+    int n_in = (int)ceil(15.0 * h->sample_rate);
+    float *in = (float *)malloc((size_t)n_in * sizeof(float));
+    float *x = (float *)calloc(rs ? (size_t)polyphase_resampler_max_output(rs, n_in) + BENCH_SLOT_SAMPLES
+                                  : (size_t)n_in, sizeof(float));
+    static ft8_result_t res[BENCH_MAX_RESULTS];
+    if (!in || !x) return 1;
+
+    uint64_t end = audio_archive_end(a);
+    double t_end = h->start_utc + (double)end / h->sample_rate;
+    printf("%s: %.1f Hz, %.1f s, %d frames\n", o->archive, h->sample_rate,
+           (double)end / h->sample_rate, audio_archive_frames(a));
+    printf("%10s  %9s  %5s  %7s  %s\n", "utc", "dial Hz", "count", "ms", "snr  dt  freq  payload");
+
+    int slots = 0, total = 0;
+    double total_ms = 0.0;
+    for (double t = ceil(h->start_utc / 15.0) * 15.0; t + 15.0 <= t_end; t += 15.0) {
+        uint64_t dial;
+        uint64_t first = audio_archive_index_at(a, t);
+        if (audio_archive_read(a, first, in, n_in, &dial) == 0) continue;
+
+        const float *slot = in;
+        if (rs) {
+            polyphase_resampler_reset(rs);
+            int k = polyphase_resampler_process(rs, in, n_in, x);
+            if (k < BENCH_SLOT_SAMPLES) memset(x + k, 0, (size_t)(BENCH_SLOT_SAMPLES - k) * sizeof(float));
+            slot = x;
+        }
+
+        double t0 = now_s();
+        ft8_decoder_reset(dec);
+        for (int i = 0; i < BENCH_SLOT_SAMPLES; i += BENCH_CHUNK_SAMPLES) {
+            int len = BENCH_SLOT_SAMPLES - i;
+            if (len > BENCH_CHUNK_SAMPLES) len = BENCH_CHUNK_SAMPLES;
+            if (eng) {
+                uint64_t pos = spectrum_engine_samples(eng);
+                spectrum_engine_feed(eng, slot + i, len);
+                ft8_decoder_feed_shared(dec, slot + i, len, eng, pos);
+            } else {
+                ft8_decoder_feed(dec, slot + i, len);
+            }
+        }
+        int n = ft8_decoder_decode_fed(dec, res, BENCH_MAX_RESULTS);
+        double ms = (now_s() - t0) * 1e3;
+
+        printf("%10.0f  %9llu  %5d  %7.2f\n", t, (unsigned long long)dial, n, ms);
+        for (int r = 0; r < n; r++) print_message(&res[r]);
+        slots++;
+        total += n;
+        total_ms += ms;
+    }
+    if (slots > 0)
+        printf("%d slots, %d messages, %.2f ms per slot (%.1fx realtime)\n", slots, total,
+               total_ms / slots, 15e3 * slots / total_ms);
+
+    free(in);
+    free(x);
+    polyphase_resampler_destroy(rs);
+    audio_archive_close(a);
+    return 0;
+}
+
+/* ------------------------------------------------------------------ */
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr,
+        "usage: %s [options]\n"
+        "  -m signals    signals per slot (10)\n"
+        "  -s snr_db     SNR in 2500 Hz (-10)\n"
+        "  -l slots      slots to decode (5)\n"
+        "  -n repeats    best-of count per slot (3)\n"
+        "  -a            symbol-aligned start times, on-bin frequencies\n"
+        "  -c count      max candidates (decoder default)\n"
+        "  -o depth      OSD fallback depth, 0 = off (decoder default)\n"
+        "  -e seconds    early decode after this much audio (off)\n"
+        "  -p passes     decode passes with subtraction, 1 = off (decoder default)\n"
+        "  -r spread_db  signals up to this much above the SNR (0)\n"
+        "  -t threads    per-candidate workers (decoder default)\n"
+        "  -S            take the waterfall from a shared spectrum engine\n"
+        "  -A file       decode the slots of a recording (.dfxa) instead\n",
+        argv0);
+}
+
+int main(int argc, char **argv)
+{
+    bench_opts_t o = {
+        .signals = 10, .snr_db = -10.0f, .slots = 5, .repeats = 3,
+        .osd_depth = -1,
+    };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "m:s:l:n:ac:o:e:p:r:t:SA:h")) != -1) {
+        switch (opt) {
+        case 'm': o.signals = atoi(optarg); break;
+        case 's': o.snr_db = (float)atof(optarg); break;
+        case 'l': o.slots = atoi(optarg); break;
+        case 'n': o.repeats = atoi(optarg); break;
+        case 'a': o.aligned = 1; break;
+        case 'c': o.max_candidates = atoi(optarg); break;
+        case 'o': o.osd_depth = atoi(optarg); break;
+        case 'e': o.early_s = (float)atof(optarg); break;
+        case 'p': o.passes = atoi(optarg); break;
+        case 'r': o.spread_db = (float)atof(optarg); break;
+        case 't': o.threads = atoi(optarg); break;
+        case 'S': o.shared = 1; break;
+        case 'A': o.archive = optarg; break;
+        default: usage(argv[0]); return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (o.signals <= 0 || o.signals > BENCH_MAX_SIGNALS || o.slots <= 0 ||
+        o.repeats <= 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    ft8_config_t cfg;
+    ft8_config_init(&cfg);
+    if (o.max_candidates > 0) cfg.max_candidates = o.max_candidates;
+    if (o.osd_depth >= 0) cfg.osd_depth = o.osd_depth;
+    if (o.passes > 0) cfg.passes = o.passes;
+    if (o.threads > 0) cfg.threads = o.threads;
+
+    ft8_decoder_t *dec = ft8_decoder_create(&cfg);
+    float *x = (float *)malloc(BENCH_SLOT_SAMPLES * sizeof(float));
+    spectrum_engine_t *eng = o.shared ? spectrum_engine_create(NULL) : NULL;
+    if (!dec || !x || (o.shared && !eng)) return 1;
+    if (o.archive) {
+        int rc = replay(&o, dec, eng);
+        free(x);
+        spectrum_engine_destroy(eng);
+        ft8_decoder_destroy(dec);
+        return rc;
+    }
+
+
+    int early_at = (int)(o.early_s * FT8_SAMPLE_RATE);
+    if (early_at > BENCH_SLOT_SAMPLES) early_at = 0;
+
+    char threads_desc[16] = "auto";
+    if (o.threads > 0) snprintf(threads_desc, sizeof(threads_desc), "%d", o.threads);
+    char early_desc[32] = "off";
+    if (early_at) snprintf(early_desc, sizeof(early_desc), "at %.1f s", o.early_s);
+
+    printf("FT8 decoder benchmark: %d signals, SNR %.1f dB (+%.0f), %s, %d candidates, "
+           "OSD depth %d, %d passes, %s threads, early decode %s, %s waterfall, best of %d\n",
+           o.signals, o.snr_db, o.spread_db, o.aligned ? "aligned" : "random offsets",
+           cfg.max_candidates, cfg.osd_depth, cfg.passes, threads_desc, early_desc,
+           o.shared ? "shared" : "own", o.repeats);
+    printf("%4s  %9s  %9s  %9s  %10s  %7s  %5s  %5s\n", "slot", "feed ms", "early ms",
+           "ms", "x realtime", "decoded", "early", "false");
+
+    static bench_signal_t sig[BENCH_MAX_SIGNALS];
+    static ft8_result_t res[BENCH_MAX_RESULTS];
+    int total_sent = 0, total_found = 0, total_early = 0, total_false = 0;
+    double total_ms = 0.0, total_feed_ms = 0.0, total_early_ms = 0.0;
+
+    for (int slot = 0; slot < o.slots; slot++) {
+        pick_signals(&o, sig);
+        synth(&o, sig, x);
+
+        double best = 1e30, best_feed = 1e30, best_early = 1e30;
+        int n = 0, n_early = 0;
+        for (int rep = 0; rep < o.repeats; rep++) {
+            double feed = 0.0, early = 0.0;
+            ft8_decoder_reset(dec);
+            n_early = 0;
+            for (int i = 0; i < BENCH_SLOT_SAMPLES; i += BENCH_CHUNK_SAMPLES) {
+                int len = BENCH_SLOT_SAMPLES - i;
+                if (len > BENCH_CHUNK_SAMPLES) len = BENCH_CHUNK_SAMPLES;
+                double t0 = now_s();
+                if (eng) {
+                    uint64_t pos = spectrum_engine_samples(eng);
+                    spectrum_engine_feed(eng, x + i, len);
+                    ft8_decoder_feed_shared(dec, x + i, len, eng, pos);
+                } else {
+                    ft8_decoder_feed(dec, x + i, len);
+                }
+                double t1 = now_s();
+                feed += t1 - t0;
+                if (early_at && i < early_at && i + len >= early_at) {
+                    n_early = ft8_decoder_decode_early(dec, res, BENCH_MAX_RESULTS);
+                    early = now_s() - t1;
+                }
+            }
+            double t0 = now_s();
+            n = n_early + ft8_decoder_decode_fed(dec, res + n_early,
+                                                 BENCH_MAX_RESULTS - n_early);
+            double dt = now_s() - t0;
+            if (feed < best_feed) best_feed = feed;
+            if (early < best_early) best_early = early;
+            if (dt < best) best = dt;
+        }
+
+        int found = 0, found_early = 0, false_dec = 0;
+        for (int s = 0; s < o.signals; s++) {
+            for (int r = 0; r < n; r++) {
+                if (memcmp(res[r].payload, sig[s].payload, FT8_PAYLOAD_BITS) == 0) {
+                    found++;
+                    if (r < n_early) found_early++;
+                    break;
+                }
+            }
+        }
+        false_dec = n - found;
+
+        printf("%4d  %9.2f  %9.2f  %9.2f  %10.1f  %3d/%-3d  %5d  %5d\n", slot,
+               best_feed * 1e3, best_early * 1e3, best * 1e3, 15.0 / best, found,
+               o.signals, found_early, false_dec);
+        total_sent += o.signals;
+        total_found += found;
+        total_early += found_early;
+        total_false += false_dec;
+        total_ms += best * 1e3;
+        total_feed_ms += best_feed * 1e3;
+        total_early_ms += best_early * 1e3;
+    }
+
+    printf("mean  %9.2f  %9.2f  %9.2f  %10.1f  %3d/%-3d  %5d  %5d\n",
+           total_feed_ms / o.slots, total_early_ms / o.slots, total_ms / o.slots,
+           15e3 * o.slots / total_ms, total_found, total_sent, total_early, total_false);
+
+    free(x);
+    spectrum_engine_destroy(eng);
+    ft8_decoder_destroy(dec);
+    return 0;
+}
@@ -0,0 +1,312 @@
+/**
+ * ft8_calls.c — LRU callsign table with code and hash indexes
+ */
+
+#include "ft8_calls.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define NO_ENTRY  (-1)
+#define NO_N28    0xFFFFFFFFu
+
+/* Base-38 alphabet of the WSJT-X callsign hash */
+static const char k_hash_chars[] = " 0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ/";
+
+/* Per-position alphabets of the 28-bit standard code */
+static const char k_c0[] = " ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+static const char k_c1[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+static const char k_c2[] = "0123456789";
+static const char k_c3[] = " ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+typedef struct {
+    char     call[FT8_CALL_MAX + 1];
+    uint32_t n28;             /* NO_N28 until heard as a standard code */
+    uint32_t h22, h12;
+    uint32_t stamp;
+    int      prev, next;      /* LRU list, head = most recent */
+} entry_t;
+
+/* Open addressing with linear probing: key → entry, unique keys */
+typedef struct {
+    uint32_t *key;
+    int32_t  *entry;          /* NO_ENTRY = empty bucket */
+    uint32_t  mask;
+    int       shift;
+} index_t;
+
+struct ft8_calls_t {
+    entry_t *entries;
+    int capacity;
+    int used;
+    int head, tail;
+
+    index_t by_n28, by_h22, by_h12;
+};
+
+/* ── Hashing and unpacking ──────────────────────────────────────────── */
+
+static int hash_char(char c)
+{
+    const char *p = c ? strchr(k_hash_chars, c) : NULL;
+    return p ? (int)(p - k_hash_chars) : -1;
+}
+
+uint32_t ft8_call_hash(const char *call, int bits)
+{
+    uint64_t n = 0;
+    int i = 0;
+    for (; i < FT8_CALL_MAX && call[i]; i++) {
+        int j = hash_char(call[i]);
+        n = 38 * n + (uint64_t)(j < 0 ? 0 : j);
+    }
+    for (; i < FT8_CALL_MAX; i++) n = 38 * n;        /* Pad with spaces */
+
+    return (uint32_t)((47055833459ull * n) >> (64 - bits));
+}
+
+int ft8_call_unpack28(uint32_t n28, char *out)
+{
+    if (n28 >= FT8_CALL_N28_CALLS) {
+        out[0] = '\0';
+        return 0;
+    }
+
+    char c[6];
+    c[5] = k_c3[n28 % 27]; n28 /= 27;
+    c[4] = k_c3[n28 % 27]; n28 /= 27;
+    c[3] = k_c3[n28 % 27]; n28 /= 27;
+    c[2] = k_c2[n28 % 10]; n28 /= 10;
+    c[1] = k_c1[n28 % 36]; n28 /= 36;
+    c[0] = k_c0[n28];
+
+    int lo = 0, hi = 6;
+    while (lo < hi && c[lo] == ' ') lo++;
+    while (hi > lo && c[hi - 1] == ' ') hi--;
+    memcpy(out, c + lo, (size_t)(hi - lo));
+    out[hi - lo] = '\0';
+    return hi - lo;
+}
+
+/* ── Indexes ────────────────────────────────────────────────────────── */
+
+static int index_init(index_t *ix, int capacity)
+{
+    int bits = 4;
+    while ((1 << bits) < 2 * capacity) bits++;
+
+    ix->mask = (1u << bits) - 1;
+    ix->shift = 32 - bits;
+    ix->key = (uint32_t *)calloc(ix->mask + 1, sizeof(uint32_t));
+    ix->entry = (int32_t *)malloc((ix->mask + 1) * sizeof(int32_t));
+    if (!ix->key || !ix->entry) return -1;
+    for (uint32_t i = 0; i <= ix->mask; i++) ix->entry[i] = NO_ENTRY;
+    return 0;
+}
+
+static void index_free(index_t *ix)
+{
+    free(ix->key);
+    free(ix->entry);
+}
+
+static inline uint32_t index_home(const index_t *ix, uint32_t key)
+{
+    return (key * 0x9E3779B1u) >> ix->shift;
+}
+
+/* Bucket holding key, or the empty bucket where it would go */
+static uint32_t index_probe(const index_t *ix, uint32_t key)
+{
+    uint32_t i = index_home(ix, key);
+    while (ix->entry[i] != NO_ENTRY && ix->key[i] != key) i = (i + 1) & ix->mask;
+    return i;
+}
+
+static int index_find(const index_t *ix, uint32_t key)
+{
+    return ix->entry[index_probe(ix, key)];
+}
+
+static void index_put(index_t *ix, uint32_t key, int entry)
+{
+    uint32_t i = index_probe(ix, key);
+    ix->key[i] = key;
+    ix->entry[i] = entry;
+}
+
+/* Drop key if it still points at entry; later buckets shift back into the gap */
+static void index_remove(index_t *ix, uint32_t key, int entry)
+{
+    uint32_t i = index_probe(ix, key);
+    if (ix->entry[i] != entry) return;
+
+    for (uint32_t j = i;;) {
+        j = (j + 1) & ix->mask;
+        if (ix->entry[j] == NO_ENTRY) break;
+        /* Leave j alone if its home lies cyclically in (i, j] */
+        uint32_t home = index_home(ix, ix->key[j]);
+        if (((j - home) & ix->mask) < ((j - i) & ix->mask)) continue;
+        ix->key[i] = ix->key[j];
+        ix->entry[i] = ix->entry[j];
+        i = j;
+    }
+    ix->entry[i] = NO_ENTRY;
+}
+
+/* ── LRU list ───────────────────────────────────────────────────────── */
+
+static void lru_unlink(ft8_calls_t *t, int e)
+{
+    entry_t *x = &t->entries[e];
+    if (x->prev != NO_ENTRY) t->entries[x->prev].next = x->next; else t->head = x->next;
+    if (x->next != NO_ENTRY) t->entries[x->next].prev = x->prev; else t->tail = x->prev;
+}
+
+static void lru_push_front(ft8_calls_t *t, int e)
+{
+    entry_t *x = &t->entries[e];
+    x->prev = NO_ENTRY;
+    x->next = t->head;
+    if (t->head != NO_ENTRY) t->entries[t->head].prev = e; else t->tail = e;
+    t->head = e;
+}
+
+static void touch(ft8_calls_t *t, int e)
+{
+    if (t->head == e) return;
+    lru_unlink(t, e);
+    lru_push_front(t, e);
+}
+
+/* A free entry, else the least recently used one, out of every index */
+static int take_entry(ft8_calls_t *t)
+{
+    if (t->used < t->capacity) return t->used++;
+
+    int e = t->tail;
+    entry_t *x = &t->entries[e];
+    lru_unlink(t, e);
+    if (x->n28 != NO_N28) index_remove(&t->by_n28, x->n28, e);
+    index_remove(&t->by_h22, x->h22, e);
+    index_remove(&t->by_h12, x->h12, e);
+    return e;
+}
+
+/* ── Table ──────────────────────────────────────────────────────────── */
+
+ft8_calls_t *ft8_calls_create(int capacity)
+{
+    if (capacity < 1) return NULL;
+
+    ft8_calls_t *t = (ft8_calls_t *)calloc(1, sizeof(ft8_calls_t));
+    if (!t) return NULL;
+    t->capacity = capacity;
+    t->head = t->tail = NO_ENTRY;
+
+    t->entries = (entry_t *)calloc((size_t)capacity, sizeof(entry_t));
+    if (!t->entries ||
+        index_init(&t->by_n28, capacity) != 0 ||
+        index_init(&t->by_h22, capacity) != 0 ||
+        index_init(&t->by_h12, capacity) != 0) {
+        ft8_calls_destroy(t);
+        return NULL;
+    }
+    return t;
+}
+
+int ft8_calls_capacity(const ft8_calls_t *t)
+{
+    return t->capacity;
+}
+
+int ft8_calls_add(ft8_calls_t *t, const char *call)
+{
+    while (*call == ' ') call++;
+    int len = (int)strlen(call);
+    while (len > 0 && call[len - 1] == ' ') len--;
+    if (len == 0 || len > FT8_CALL_MAX) return NO_ENTRY;
+
+    char buf[FT8_CALL_MAX + 1];
+    for (int i = 0; i < len; i++) {
+        char c = call[i];
+        if (c >= 'a' && c <= 'z') c = (char)(c - 'a' + 'A');
+        if (hash_char(c) < 0) return NO_ENTRY;
+        buf[i] = c;
+    }
+    buf[len] = '\0';
+
+    const uint32_t h22 = ft8_call_hash(buf, 22);
+    int e = index_find(&t->by_h22, h22);
+    if (e != NO_ENTRY && strcmp(t->entries[e].call, buf) == 0) {
+        touch(t, e);
+        return e;
+    }
+
+    e = take_entry(t);
+    entry_t *x = &t->entries[e];
+    memcpy(x->call, buf, (size_t)len + 1);
+    x->n28 = NO_N28;
+    x->h22 = h22;
+    x->h12 = h22 >> 10;
+    x->stamp++;
+    lru_push_front(t, e);
+
+    index_put(&t->by_h22, x->h22, e);
+    index_put(&t->by_h12, x->h12, e);
+    return e;
+}
+
+int ft8_calls_find_n28(ft8_calls_t *t, uint32_t n28)
+{
+    if (n28 >= FT8_CALL_N28_CALLS) return NO_ENTRY;
+
+    int e = index_find(&t->by_n28, n28);
+    if (e != NO_ENTRY) {
+        touch(t, e);
+        return e;
+    }
+
+    char call[FT8_CALL_MAX + 1];
+    if (ft8_call_unpack28(n28, call) == 0) return NO_ENTRY;
+    e = ft8_calls_add(t, call);
+    if (e != NO_ENTRY && t->entries[e].n28 == NO_N28) {
+        t->entries[e].n28 = n28;
+        index_put(&t->by_n28, n28, e);
+    }
+    return e;
+}
+
+int ft8_calls_find_hash(ft8_calls_t *t, uint32_t hash, int bits)
+{
+    int e;
+    if (bits == 22) {
+        e = index_find(&t->by_h22, hash);
+    } else if (bits == 12) {
+        e = index_find(&t->by_h12, hash);
+    } else {
+        return NO_ENTRY;
+    }
+    if (e != NO_ENTRY) touch(t, e);
+    return e;
+}
+
+const char *ft8_calls_get(const ft8_calls_t *t, int entry)
+{
+    return t->entries[entry].call;
+}
+
+uint32_t ft8_calls_stamp(const ft8_calls_t *t, int entry)
+{
+    return t->entries[entry].stamp;
+}
+
+void ft8_calls_destroy(ft8_calls_t *t)
+{
+    if (!t) return;
+    index_free(&t->by_n28);
+    index_free(&t->by_h22);
+    index_free(&t->by_h12);
+    free(t->entries);
+    free(t);
+}
@@ -0,0 +1,106 @@
+/**
+ * ft8_calls.h — Table of recently heard callsigns for FT8/JS8 unpacking
+ *
+ * A fixed number of entries, kept in least-recently-used order. When the
+ * table is full, a new call replaces the one unused for longest. Each
+ * entry is indexed three ways, each lookup O(1):
+ *   - by its 28-bit standard code, so a call decoded once is never
+ *     unpacked again;
+ *   - by its 22-bit hash, as sent in place of a callsign (`<...>`);
+ *   - by its 12-bit hash.
+ * Hashes follow WSJT-X: the call in base 38 over 11 characters, times
+ * 47055833459 mod 2^64, top bits. When two calls share a hash, the one
+ * heard last wins.
+ *
+ * Lookups move the entry to the front. The table allocates only in
+ * ft8_calls_create(). It is not thread-safe; the caller serialises.
+ */
+
+#ifndef FT8_CALLS_H
+#define FT8_CALLS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FT8_CALL_MAX       11          /* Longest callsign in characters */
+
+/*
+ * 28-bit callsign field: standard calls are 0 .. FT8_CALL_N28_CALLS - 1
+ * (37·36·10·27³, see FT8MessagePack.encodeCallsign), and a 22-bit hash h
+ * is sent as FT8_CALL_N28_HASH + h. The CQ tokens sit above both.
+ */
+#define FT8_CALL_N28_CALLS 262177560u
+#define FT8_CALL_N28_HASH  FT8_CALL_N28_CALLS
+
+typedef struct ft8_calls_t ft8_calls_t;
+
+/**
+ * WSJT-X hash of a callsign ("ihashcall").
+ *
+ * @param call  Callsign, upper case
+ * @param bits  10, 12 or 22
+ * @return      Hash in the low bits
+ */
+uint32_t ft8_call_hash(const char *call, int bits);
+
+/**
+ * Unpack a standard 28-bit code to its callsign, spaces trimmed.
+ *
+ * @param n28  Code below FT8_CALL_N28_CALLS
+ * @param out  At least FT8_CALL_MAX + 1 bytes
+ * @return     Length written, 0 if n28 is not a standard call
+ */
+int ft8_call_unpack28(uint32_t n28, char *out);
+
+/**
+ * Create a table of capacity entries.
+ *
+ * @return Table, or NULL on allocation failure
+ */
+ft8_calls_t *ft8_calls_create(int capacity);
+
+int ft8_calls_capacity(const ft8_calls_t *t);
+
+/**
+ * Record a heard callsign. Leading and trailing spaces are dropped.
+ *
+ * @return Entry index, or -1 if the call is empty, too long, or has
+ *         characters no hash can carry
+ */
+int ft8_calls_add(ft8_calls_t *t, const char *call);
+
+/**
+ * Entry for a standard 28-bit code. A call not in the table yet is
+ * unpacked and added.
+ *
+ * @return Entry index, or -1 if n28 is not a standard call
+ */
+int ft8_calls_find_n28(ft8_calls_t *t, uint32_t n28);
+
+/**
+ * Entry whose call has this hash.
+ *
+ * @param bits  22 or 12
+ * @return      Entry index, or -1 if no call heard has it
+ */
+int ft8_calls_find_hash(ft8_calls_t *t, uint32_t hash, int bits);
+
+/* Callsign of an entry */
+const char *ft8_calls_get(const ft8_calls_t *t, int entry);
+
+/**
+ * Changes whenever the entry is given to another call, so a copy of the
+ * callsign made earlier is known to be current while the stamp matches.
+ */
+uint32_t ft8_calls_stamp(const ft8_calls_t *t, int entry);
+
+void ft8_calls_destroy(ft8_calls_t *t);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FT8_CALLS_H */
@@ -0,0 +1,40 @@
+/**
+ * ft8_crc.c — CRC-14 over FT8 payload bits
+ */
+
+#include "ft8_crc.h"
+
+#define FT8_CRC_POLY  0x2757u
+
+static uint16_t crc_step(uint16_t crc, int bit)
+{
+    int msb = (crc >> 13) & 1;
+    crc = (uint16_t)((crc << 1) | (bit & 1));
+    if (msb) crc ^= FT8_CRC_POLY;
+    return crc;
+}
+
+uint16_t ft8_crc_compute(const uint8_t *bits, int n)
+{
+    uint16_t crc = 0;
+    for (int i = 0; i < n; i++) crc = crc_step(crc, bits[i]);
+    for (int i = 0; i < FT8_CRC_BITS; i++) crc = crc_step(crc, 0);
+    return crc & 0x3FFF;
+}
+
+void ft8_crc_append(uint8_t *bits, int n)
+{
+    uint16_t crc = ft8_crc_compute(bits, n);
+    for (int i = 0; i < FT8_CRC_BITS; i++) {
+        bits[n + i] = (crc >> (FT8_CRC_BITS - 1 - i)) & 1;
+    }
+}
+
+int ft8_crc_check(const uint8_t *bits, int n)
+{
+    uint16_t received = 0;
+    for (int i = 0; i < FT8_CRC_BITS; i++) {
+        received = (uint16_t)((received << 1) | (bits[n + i] & 1));
+    }
+    return ft8_crc_compute(bits, n) == received;
+}
@@ -0,0 +1,32 @@
+/**
+ * ft8_crc.h — CRC-14 over FT8 payload bits
+ *
+ * Polynomial 0x2757, bits fed MSB first and flushed with 14 zeros, as in
+ * FT8CRC.swift. Bits are 0/1 per byte.
+ */
+
+#ifndef FT8_CRC_H
+#define FT8_CRC_H
+
+#include <stdint.h>
+
+#define FT8_CRC_BITS  14
+
+/**
+ * CRC of n bits.
+ */
+uint16_t ft8_crc_compute(const uint8_t *bits, int n);
+
+/**
+ * Write the CRC of the n payload bits to bits[n .. n + 13].
+ */
+void ft8_crc_append(uint8_t *bits, int n);
+
+/**
+ * Check bits[n .. n + 13] against the CRC of the n payload bits.
+ *
+ * @return 1 if they match, 0 otherwise
+ */
+int ft8_crc_check(const uint8_t *bits, int n);
+
+#endif /* FT8_CRC_H */
@@ -0,0 +1,707 @@
+/**
+ * ft8_decoder.c — FT8 pipeline: Waterfall → Costas sync → Soft bits → LDPC → CRC
+ *
+ * No heap allocation during feed() or decode() — all state pre-allocated
+ * in create().
+ */
+
+#include "ft8_decoder.h"
+#include "ft8_crc.h"
+#include "ft8_ldpc.h"
+#include "ft8_osd.h"
+#include "ft8_pool.h"
+#include "ft8_softbits.h"
+#include "ft8_subtract.h"
+#include "ft8_sync.h"
+#include "ft8_waterfall.h"
+#include "trace.h"
+
+#include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FT8_BITS_PER_SYMBOL  3
+#define FT8_COSTAS_LENGTH    7
+#define FT8_NUM_TONES        8
+
+/* Bins left and right of the 8 tones used as noise reference for SNR */
+#define FT8_SNR_GUARD        4
+
+/*
+ * OSD answers are only trusted this close to the channel decisions;
+ * beyond it the CRC alone lets too many noise candidates through.
+ */
+#define FT8_OSD_MAX_ERRORS   18
+
+/* Marks a candidate recovered by OSD in the per-candidate iterations */
+#define FT8_ITER_OSD         (-1)
+
+#define FT8_MAX_PASSES       8
+#define FT8_MAX_THREADS      16
+
+/*
+ * Early decodes take frames with at least this many symbols in: both
+ * first Costas blocks and all but the last 4 data symbols, whose 12
+ * bits go to LDPC as erasures.
+ */
+#define FT8_EARLY_SYMBOLS    68
+
+static const int k_costas[FT8_COSTAS_LENGTH] = { 3, 1, 4, 0, 6, 5, 2 };
+static const int k_sync_offsets[3] = { 0, 36, 72 };
+
+/* 3 coded bits → tone (FT8Protocol.grayEncode) */
+static const int k_gray_encode[FT8_NUM_TONES] = { 0, 1, 3, 2, 6, 7, 5, 4 };
+
+struct ft8_decoder_t {
+    ft8_config_t cfg;
+
+    /* cfg.max_candidates and passes at create: the buffers' sizes, and
+       the most ft8_decoder_set_effort() may ask for */
+    int cap_candidates, cap_passes;
+
+    ft8_waterfall_t wf;
+    int             n_bins;       /* Waterfall bins per grid */
+
+    /* Base-bin search range [min_bin, max_bin) */
+    int min_bin, max_bin;
+
+    ft8_sync_t       sync;
+    ft8_candidate_t *cand;        /* max_candidates, best sync first */
+
+    const ft8_ldpc_code_t *code;
+
+    /* Per-candidate stage: workers claim candidates off a shared counter */
+    ft8_pool_t       *pool;
+    int               n_workers;
+    ft8_ldpc_batch_t *ldpc;       /* n_workers */
+    ft8_osd_t        *osd;        /* n_workers */
+    int               chunk;      /* Candidates per LDPC claim */
+    _Atomic int       next;       /* Next unclaimed chunk / candidate */
+    int               n_cand;
+    uint64_t          osd_deadline;
+
+    /* Data symbol rows within the frame (all but the Costas blocks) */
+    int data_pos[FT8_SYMBOL_COUNT];
+    int n_data;
+
+    /* Per tried candidate, decoded as one LDPC batch */
+    float   *llr;                 /* max_candidates * FT8_LDPC_N */
+    uint8_t *message;             /* max_candidates * FT8_LDPC_K */
+    int     *iterations;          /* max_candidates */
+    uint8_t *solved;              /* max_candidates: BP found a CRC-valid codeword */
+
+    /*
+     * Decoded since the last reset, early pass and every subtraction
+     * pass: not retried, not reported again, and subtracted from the
+     * audio before the next pass. [n_subtracted, n_found) are pending.
+     */
+    ft8_candidate_t *found;          /* max_found */
+    uint8_t         *found_payload;  /* max_found * FT8_PAYLOAD_BITS */
+    int              n_found, max_found;
+    int              n_subtracted;
+
+    /* Windows copied from a spectrum engine (ft8_decoder_feed_shared) */
+    int      shared;              /* This slot's rows come from the engine */
+    uint64_t shared_row;          /* Engine row of waterfall window 0 */
+    uint64_t shared_next;         /* Stream index the next feed starts at */
+};
+
+/* ------------------------------------------------------------------ */
+/* Config init                                                         */
+/* ------------------------------------------------------------------ */
+
+void ft8_config_init(ft8_config_t *cfg)
+{
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->min_freq        = 200.0f;
+    cfg->max_freq        = 3000.0f;
+    cfg->sync_threshold  = 4.0f;
+    cfg->max_candidates  = 40;
+    cfg->ldpc_iterations = 50;
+    cfg->osd_depth       = 2;
+    cfg->osd_budget_ms   = 250.0f;
+    cfg->passes          = 3;
+    cfg->threads         = 0;
+    cfg->max_samples     = 15 * FT8_SAMPLE_RATE;
+}
+
+/* ------------------------------------------------------------------ */
+/* Create / destroy                                                    */
+/* ------------------------------------------------------------------ */
+
+ft8_decoder_t *ft8_decoder_create(const ft8_config_t *cfg)
+{
+    ft8_decoder_t *dec = (ft8_decoder_t *)calloc(1, sizeof(ft8_decoder_t));
+    if (!dec) return NULL;
+
+    if (cfg) {
+        dec->cfg = *cfg;
+    } else {
+        ft8_config_init(&dec->cfg);
+    }
+    if (dec->cfg.max_samples < FT8_SYMBOL_SAMPLES * FT8_SYMBOL_COUNT) {
+        dec->cfg.max_samples = FT8_SYMBOL_SAMPLES * FT8_SYMBOL_COUNT;
+    }
+    if (dec->cfg.max_candidates < 1) dec->cfg.max_candidates = 1;
+    if (dec->cfg.ldpc_iterations < 1) dec->cfg.ldpc_iterations = 1;
+    if (dec->cfg.osd_depth < 0) dec->cfg.osd_depth = 0;
+    if (dec->cfg.osd_depth > FT8_OSD_MAX_DEPTH) dec->cfg.osd_depth = FT8_OSD_MAX_DEPTH;
+    if (dec->cfg.passes < 1) dec->cfg.passes = 1;
+    if (dec->cfg.passes > FT8_MAX_PASSES) dec->cfg.passes = FT8_MAX_PASSES;
+    if (dec->cfg.threads <= 0) dec->cfg.threads = ft8_pool_default_size();
+    if (dec->cfg.threads > FT8_MAX_THREADS) dec->cfg.threads = FT8_MAX_THREADS;
+    dec->cap_candidates = dec->cfg.max_candidates;
+    dec->cap_passes = dec->cfg.passes;
+
+    /* Bins up to the top tone of the highest base, plus its SNR noise bins */
+    dec->min_bin = (int)(dec->cfg.min_freq / FT8_TONE_SPACING);
+    if (dec->min_bin < 0) dec->min_bin = 0;
+    dec->max_bin = (int)(dec->cfg.max_freq / FT8_TONE_SPACING);
+    dec->n_bins = dec->max_bin + FT8_NUM_TONES + FT8_SNR_GUARD;
+    if (dec->n_bins > FT8_SYMBOL_SAMPLES / 2) dec->n_bins = FT8_SYMBOL_SAMPLES / 2;
+    if (dec->max_bin > dec->n_bins - FT8_NUM_TONES) {
+        dec->max_bin = dec->n_bins - FT8_NUM_TONES;
+    }
+
+    if (ft8_waterfall_init(&dec->wf, FT8_SYMBOL_SAMPLES, dec->cfg.max_samples,
+                           dec->n_bins) != 0) {
+        ft8_decoder_destroy(dec);
+        return NULL;
+    }
+
+    dec->cand = (ft8_candidate_t *)calloc((size_t)dec->cfg.max_candidates, sizeof(ft8_candidate_t));
+    dec->llr = (float *)calloc((size_t)dec->cfg.max_candidates * FT8_LDPC_N, sizeof(float));
+    dec->message = (uint8_t *)calloc((size_t)dec->cfg.max_candidates * FT8_LDPC_K, 1);
+    dec->iterations = (int *)calloc((size_t)dec->cfg.max_candidates, sizeof(int));
+    dec->solved = (uint8_t *)calloc((size_t)dec->cfg.max_candidates, 1);
+    dec->max_found = dec->cfg.max_candidates * (dec->cfg.passes + 1);
+    dec->found = (ft8_candidate_t *)calloc((size_t)dec->max_found, sizeof(ft8_candidate_t));
+    dec->found_payload = (uint8_t *)calloc((size_t)dec->max_found * FT8_PAYLOAD_BITS, 1);
+    if (!dec->cand || !dec->llr || !dec->message || !dec->iterations || !dec->solved ||
+        !dec->found || !dec->found_payload ||
+        ft8_sync_init(&dec->sync, &dec->wf) != 0) {
+        ft8_decoder_destroy(dec);
+        return NULL;
+    }
+    ft8_sync_set_backend(&dec->sync, dec->cfg.sync_score, dec->cfg.sync_ctx);
+
+    dec->code = ft8_ldpc_ft8();
+
+    /* Threads that fail to start leave the stage on the calling thread */
+    dec->pool = dec->cfg.threads > 1 ? ft8_pool_create(dec->cfg.threads) : NULL;
+    dec->n_workers = ft8_pool_size(dec->pool);
+    dec->ldpc = (ft8_ldpc_batch_t *)calloc((size_t)dec->n_workers, sizeof(ft8_ldpc_batch_t));
+    dec->osd = (ft8_osd_t *)calloc((size_t)dec->n_workers, sizeof(ft8_osd_t));
+    if (!dec->ldpc || !dec->osd) {
+        ft8_decoder_destroy(dec);
+        return NULL;
+    }
+    for (int w = 0; w < dec->n_workers; w++) ft8_osd_init(&dec->osd[w], dec->code);
+    dec->chunk = ft8_ldpc_batch_width();
+
+    for (int pos = 0; pos < FT8_SYMBOL_COUNT; pos++) {
+        int sync = 0;
+        for (int b = 0; b < 3; b++) {
+            int off = pos - k_sync_offsets[b];
+            if (off >= 0 && off < FT8_COSTAS_LENGTH) sync = 1;
+        }
+        if (!sync) dec->data_pos[dec->n_data++] = pos;
+    }
+
+    return dec;
+}
+
+void ft8_decoder_set_effort(ft8_decoder_t *dec, int max_candidates, int passes,
+                            int osd_depth, float osd_budget_ms)
+{
+    if (!dec) return;
+    if (max_candidates < 1) max_candidates = 1;
+    if (max_candidates > dec->cap_candidates) max_candidates = dec->cap_candidates;
+    if (passes < 1) passes = 1;
+    if (passes > dec->cap_passes) passes = dec->cap_passes;
+    if (osd_depth < 0) osd_depth = 0;
+    if (osd_depth > FT8_OSD_MAX_DEPTH) osd_depth = FT8_OSD_MAX_DEPTH;
+    if (osd_budget_ms < 0.0f) osd_budget_ms = 0.0f;
+
+    dec->cfg.max_candidates = max_candidates;
+    dec->cfg.passes = passes;
+    dec->cfg.osd_depth = osd_depth;
+    dec->cfg.osd_budget_ms = osd_budget_ms;
+}
+
+void ft8_decoder_destroy(ft8_decoder_t *dec)
+{
+    if (!dec) return;
+    ft8_waterfall_free(&dec->wf);
+    ft8_sync_free(&dec->sync);
+    free(dec->cand);
+    free(dec->llr);
+    free(dec->message);
+    free(dec->iterations);
+    free(dec->solved);
+    ft8_pool_destroy(dec->pool);
+    free(dec->ldpc);
+    free(dec->osd);
+    free(dec->found);
+    free(dec->found_payload);
+    free(dec);
+}
+
+/* ------------------------------------------------------------------ */
+/* Soft bits, SNR, frequency                                           */
+/* ------------------------------------------------------------------ */
+
+/* Row 0, bin 0 of the waterfall grid a candidate was found in */
+static const float *cand_grid(const ft8_decoder_t *dec, const ft8_candidate_t *c)
+{
+    return ft8_waterfall_grid(&dec->wf, c->time_sub, c->freq_sub);
+}
+
+/* Frame symbols in the waterfall so far (FT8_SYMBOL_COUNT once complete) */
+static int cand_symbols(const ft8_decoder_t *dec, const ft8_candidate_t *c)
+{
+    int n = ft8_waterfall_rows(&dec->wf, c->time_sub) - c->row;
+    return n < FT8_SYMBOL_COUNT ? n : FT8_SYMBOL_COUNT;
+}
+
+/* LLRs of the data symbols (ft8_softbits.h); symbols not received yet
+ * are erasures */
+static void extract_llr(const ft8_decoder_t *dec, const ft8_candidate_t *c,
+                        float *out)
+{
+    ft8_softbits_extract(cand_grid(dec, c), dec->n_bins, c->row, c->bin,
+                         dec->data_pos, dec->n_data, cand_symbols(dec, c),
+                         FT8_SOFTBITS_TONES, ft8_softbits_gray, out);
+}
+
+/* Mean tone-bin power over mean guard-bin power, referred to 2500 Hz */
+static float estimate_snr(const ft8_decoder_t *dec, const ft8_candidate_t *c)
+{
+    const float *grid = cand_grid(dec, c);
+    const int n_sym = cand_symbols(dec, c);
+    double signal = 0.0, noise = 0.0;
+    int n_signal = 0, n_noise = 0;
+
+    for (int d = 0; d < dec->n_data && dec->data_pos[d] < n_sym; d++) {
+        const float *p = grid + (long)(c->row + dec->data_pos[d]) * dec->n_bins;
+
+        for (int t = 0; t < FT8_NUM_TONES; t++) {
+            signal += p[c->bin + t];
+            n_signal++;
+        }
+        for (int g = 1; g <= FT8_SNR_GUARD; g++) {
+            int lo = c->bin - g;
+            int hi = c->bin + FT8_NUM_TONES + g;
+            if (lo >= 0) { noise += p[lo]; n_noise++; }
+            if (hi < dec->n_bins) { noise += p[hi]; n_noise++; }
+        }
+    }
+
+    double avg_signal = n_signal ? signal / n_signal : 1e-10;
+    double avg_noise = n_noise ? noise / n_noise : 1e-10;
+    return (float)(10.0 * log10(avg_signal / avg_noise)
+                   - 10.0 * log10(2500.0 / FT8_TONE_SPACING));
+}
+
+/* Parabolic interpolation around each Costas tone, averaged */
+static float refine_frequency(const ft8_decoder_t *dec, const ft8_candidate_t *c)
+{
+    const float *grid = cand_grid(dec, c);
+    const int n_sym = cand_symbols(dec, c);
+    double sum = 0.0;
+    int count = 0;
+
+    if (c->bin > 0 && c->bin + FT8_NUM_TONES - 1 < dec->n_bins) {
+        for (int b = 0; b < 3 && k_sync_offsets[b] + FT8_COSTAS_LENGTH <= n_sym; b++) {
+            for (int i = 0; i < FT8_COSTAS_LENGTH; i++) {
+                int bin = c->bin + k_costas[i];
+                if (bin + 1 >= dec->n_bins) continue;
+
+                const float *p = grid + (long)(c->row + k_sync_offsets[b] + i) * dec->n_bins;
+                double left = p[bin - 1], center = p[bin], right = p[bin + 1];
+                double denom = 2.0 * (2.0 * center - left - right);
+                if (fabs(denom) > 1e-10) {
+                    sum += (right - left) / denom;
+                    count++;
+                }
+            }
+        }
+    }
+
+    double offset = count ? sum / count : 0.0;
+    return (float)((c->bin + (double)c->freq_sub / FT8_WF_FREQ_OSR + offset)
+                   * FT8_TONE_SPACING);
+}
+
+/* Frame start in samples */
+static int cand_start(const ft8_candidate_t *c)
+{
+    return c->row * FT8_SYMBOL_SAMPLES + c->time_sub * (FT8_SYMBOL_SAMPLES / FT8_WF_TIME_OSR);
+}
+
+/* ------------------------------------------------------------------ */
+/* Decode                                                              */
+/* ------------------------------------------------------------------ */
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* BP converged on a codeword that passes the CRC */
+static int bp_solved(const ft8_decoder_t *dec, int i)
+{
+    return dec->iterations[i] > 0 &&
+           ft8_crc_check(dec->message + (long)i * FT8_LDPC_K, FT8_PAYLOAD_BITS);
+}
+
+/* Within dr quarter symbols and db half tones of each other */
+static int cand_near(const ft8_candidate_t *a, const ft8_candidate_t *b, int dr, int db)
+{
+    int r = (a->row - b->row) * FT8_WF_TIME_OSR + a->time_sub - b->time_sub;
+    int f = (a->bin - b->bin) * FT8_WF_FREQ_OSR + a->freq_sub - b->freq_sub;
+    return abs(r) <= dr && abs(f) <= db;
+}
+
+/* Within a symbol and a tone of a solved candidate: its sidelobe */
+static int near_solved(const ft8_decoder_t *dec, int n_cand, const ft8_candidate_t *c)
+{
+    for (int i = 0; i < n_cand; i++) {
+        if (dec->solved[i] && cand_near(&dec->cand[i], c, FT8_WF_TIME_OSR, FT8_WF_FREQ_OSR)) {
+            return 1;
+        }
+    }
+    for (int i = 0; i < dec->n_found; i++) {
+        if (cand_near(&dec->found[i], c, FT8_WF_TIME_OSR, FT8_WF_FREQ_OSR)) return 1;
+    }
+    return 0;
+}
+
+/*
+ * Drop candidates an earlier decode in the slot already covers (its sync
+ * peak may move a step once the last Costas block is in, or what is left
+ * of it after subtraction), keeping the order.
+ */
+static int skip_found(ft8_decoder_t *dec, int n_cand)
+{
+    int n = 0;
+    for (int i = 0; i < n_cand; i++) {
+        int seen = 0;
+        for (int f = 0; f < dec->n_found && !seen; f++) {
+            seen = cand_near(&dec->found[f], &dec->cand[i], 1, 1);
+        }
+        if (!seen) dec->cand[n++] = dec->cand[i];
+    }
+    return n;
+}
+
+/*
+ * Soft bits and LDPC, one chunk of candidates per claim: a batch of
+ * SIMD lanes on the worker's own scratch.
+ */
+static void ldpc_stage(void *ctx, int worker)
+{
+    ft8_decoder_t *dec = (ft8_decoder_t *)ctx;
+
+    for (;;) {
+        int lo = atomic_fetch_add_explicit(&dec->next, 1, memory_order_relaxed) * dec->chunk;
+        if (lo >= dec->n_cand) return;
+        int n = dec->n_cand - lo < dec->chunk ? dec->n_cand - lo : dec->chunk;
+
+        for (int i = lo; i < lo + n; i++) {
+            extract_llr(dec, &dec->cand[i], dec->llr + (long)i * FT8_LDPC_N);
+        }
+        ft8_ldpc_decode_batch(dec->code, dec->llr + (long)lo * FT8_LDPC_N, n,
+                              dec->cfg.ldpc_iterations, &dec->ldpc[worker],
+                              dec->message + (long)lo * FT8_LDPC_K, dec->iterations + lo);
+    }
+}
+
+/*
+ * Ordered statistics for the candidates BP did not solve, claimed best
+ * sync first, until the budget runs out. The clock is read between
+ * candidates, so one OSD run (a fraction of a millisecond) per worker
+ * is the overrun. Only unsolved candidates are written, and solved[] is
+ * fixed for the stage, so workers never read what another writes.
+ */
+static void osd_stage(void *ctx, int worker)
+{
+    ft8_decoder_t *dec = (ft8_decoder_t *)ctx;
+
+    for (;;) {
+        int i = atomic_fetch_add_explicit(&dec->next, 1, memory_order_relaxed);
+        if (i >= dec->n_cand) return;
+        if (dec->solved[i]) continue;
+        if (near_solved(dec, dec->n_cand, &dec->cand[i])) continue;
+        if (now_ns() >= dec->osd_deadline) return;
+
+        uint8_t *message = dec->message + (long)i * FT8_LDPC_K;
+        int errors = ft8_osd_decode(&dec->osd[worker], dec->llr + (long)i * FT8_LDPC_N,
+                                    dec->cfg.osd_depth, message);
+        dec->iterations[i] = errors >= 0 && errors <= FT8_OSD_MAX_ERRORS ? FT8_ITER_OSD : 0;
+    }
+}
+
+static int already_decoded(const ft8_decoder_t *dec, int n_tried,
+                           const ft8_candidate_t *c,
+                           const ft8_result_t *out, int n_out,
+                           const uint8_t *payload)
+{
+    for (int i = 0; i < n_tried; i++) {
+        const ft8_candidate_t *o = &dec->cand[i];
+        if (o->decoded && o->row == c->row && o->bin == c->bin &&
+            o->time_sub == c->time_sub && o->freq_sub == c->freq_sub) {
+            return 1;
+        }
+    }
+    for (int i = 0; i < n_out; i++) {
+        if (memcmp(out[i].payload, payload, FT8_PAYLOAD_BITS) == 0) return 1;
+    }
+    for (int i = 0; i < dec->n_found; i++) {
+        if (memcmp(dec->found_payload + (long)i * FT8_PAYLOAD_BITS, payload,
+                   FT8_PAYLOAD_BITS) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Sync, LDPC batch, OSD fallback, CRC and dedup over frames with at least
+ * frame_symbols symbols in the waterfall, appending to out[0 .. n_out).
+ * Messages found earlier in the slot are neither retried nor reported
+ * again; this pass's are added to them.
+ */
+static int decode_pass(ft8_decoder_t *dec, int frame_symbols, uint64_t osd_deadline,
+                       ft8_result_t *out, int n_out, int max_out)
+{
+    TRACE_BEGIN(TRACE_FT8_SYNC);
+    int n_cand = ft8_sync_search(&dec->sync, &dec->wf, dec->min_bin, dec->max_bin,
+                                 dec->cfg.sync_threshold, frame_symbols, dec->cand,
+                                 dec->cfg.max_candidates);
+    if (dec->n_found) n_cand = skip_found(dec, n_cand);
+    dec->n_cand = n_cand;
+    TRACE_END(TRACE_FT8_SYNC);
+
+    /* Candidates are independent up to dedup: spread them over the workers */
+    if (n_cand > 0) {
+        TRACE_BEGIN(TRACE_FT8_LDPC);
+        atomic_store(&dec->next, 0);
+        ft8_pool_run(dec->pool, ldpc_stage, dec);
+        TRACE_END(TRACE_FT8_LDPC);
+
+        for (int i = 0; i < n_cand; i++) dec->solved[i] = (uint8_t)bp_solved(dec, i);
+        if (dec->cfg.osd_depth > 0 && dec->cfg.osd_budget_ms > 0.0f) {
+            TRACE_BEGIN(TRACE_FT8_OSD);
+            dec->osd_deadline = osd_deadline;
+            atomic_store(&dec->next, 0);
+            ft8_pool_run(dec->pool, osd_stage, dec);
+            TRACE_END(TRACE_FT8_OSD);
+        }
+    }
+
+    /* Reduction: CRC and dedup in candidate order, best sync first */
+    const int first = n_out;
+    for (int i = 0; i < n_cand && n_out < max_out; i++) {
+        ft8_candidate_t *c = &dec->cand[i];
+        const uint8_t *message = dec->message + (long)i * FT8_LDPC_K;
+        int iterations = dec->iterations[i];
+
+        if (!iterations) continue;
+        if (!ft8_crc_check(message, FT8_PAYLOAD_BITS)) continue;
+        if (already_decoded(dec, i, c, out + first, n_out - first, message)) continue;
+        c->decoded = 1;
+
+        ft8_result_t *r = &out[n_out++];
+        memcpy(r->payload, message, FT8_PAYLOAD_BITS);
+        r->snr = estimate_snr(dec, c);
+        r->freq_hz = refine_frequency(dec, c);
+        r->time_s = (float)cand_start(c) / FT8_SAMPLE_RATE;
+        r->score = c->score;
+        r->iterations = iterations > 0 ? iterations : 0;
+
+        if (dec->n_found < dec->max_found) {
+            dec->found[dec->n_found] = *c;
+            memcpy(dec->found_payload + (long)dec->n_found * FT8_PAYLOAD_BITS,
+                   message, FT8_PAYLOAD_BITS);
+            dec->n_found++;
+        }
+    }
+
+    return n_out;
+}
+
+/*
+ * Subtract every pending found message from the slot audio and rebuild
+ * the waterfall from the residual. Frequencies are refined on the
+ * waterfall, which only changes at the rebuild.
+ */
+static void subtract_found(ft8_decoder_t *dec)
+{
+    uint8_t sent[FT8_SYMBOL_COUNT];
+    int tones[FT8_SYMBOL_COUNT];
+
+    for (int i = dec->n_subtracted; i < dec->n_found; i++) {
+        const ft8_candidate_t *c = &dec->found[i];
+        ft8_encode(dec->found_payload + (long)i * FT8_PAYLOAD_BITS, sent);
+        for (int k = 0; k < FT8_SYMBOL_COUNT; k++) tones[k] = sent[k];
+        ft8_subtract(dec->wf.audio, dec->wf.n_audio, tones, refine_frequency(dec, c),
+                     cand_start(c));
+    }
+    dec->n_subtracted = dec->n_found;
+    ft8_waterfall_rebuild(&dec->wf);
+}
+
+/* ------------------------------------------------------------------ */
+/* Streaming                                                           */
+/* ------------------------------------------------------------------ */
+
+void ft8_decoder_reset(ft8_decoder_t *dec)
+{
+    if (!dec) return;
+    ft8_waterfall_reset(&dec->wf);
+    dec->n_found = 0;
+    dec->n_subtracted = 0;
+    dec->shared = 0;
+}
+
+int ft8_decoder_feed(ft8_decoder_t *dec, const float *audio, int n)
+{
+    if (!dec || !audio || n <= 0) return 0;
+    return ft8_waterfall_feed(&dec->wf, audio, n);
+}
+
+/* Engine rows are this waterfall's windows: same length, hop and bins at 12 kHz */
+static int engine_fits(const ft8_decoder_t *dec, const spectrum_engine_t *eng)
+{
+    return spectrum_engine_window(eng) == FT8_SYMBOL_SAMPLES &&
+           spectrum_engine_hop(eng) == dec->wf.hop &&
+           spectrum_engine_fft_size(eng) == FT8_WF_FREQ_OSR * FT8_SYMBOL_SAMPLES &&
+           spectrum_engine_bins(eng) >= FT8_WF_FREQ_OSR * dec->n_bins &&
+           spectrum_engine_sample_rate(eng) == FT8_SAMPLE_RATE;
+}
+
+/* Copy the rows of every complete window the engine has made */
+static void take_rows(ft8_decoder_t *dec, const spectrum_engine_t *eng)
+{
+    const int n_fine = FT8_WF_FREQ_OSR * dec->n_bins;
+    const int ready = ft8_waterfall_windows_ready(&dec->wf);
+
+    while (dec->wf.n_windows < ready) {
+        int r = spectrum_engine_row(eng, dec->shared_row + (uint64_t)dec->wf.n_windows,
+                                    0, n_fine, dec->wf.fine);
+        if (r > 0) return;          /* Still pending in the engine: next feed */
+        if (r < 0) {
+            /* Gone already: the rest of the slot is transformed here */
+            dec->shared = 0;
+            ft8_waterfall_flush(&dec->wf);
+            return;
+        }
+        ft8_waterfall_put(&dec->wf, dec->wf.fine);
+    }
+}
+
+int ft8_decoder_feed_shared(ft8_decoder_t *dec, const float *audio, int n,
+                            const spectrum_engine_t *eng, uint64_t pos)
+{
+    if (!dec || !audio || n <= 0) return 0;
+    if (!eng) return ft8_decoder_feed(dec, audio, n);
+
+    int skip = 0;
+    if (dec->wf.n_audio == 0) {
+        /* Start the slot on the engine's window grid */
+        const uint64_t hop = (uint64_t)dec->wf.hop;
+        skip = (int)((hop - pos % hop) % hop);
+        if (skip >= n) return n;
+        audio += skip;
+        n -= skip;
+        pos += (uint64_t)skip;
+        dec->shared = engine_fits(dec, eng);
+        dec->shared_row = pos / hop;
+        dec->shared_next = pos;
+    }
+    if (dec->shared && pos != dec->shared_next) dec->shared = 0;
+    if (!dec->shared) return skip + ft8_waterfall_feed(&dec->wf, audio, n);
+
+    int taken = ft8_waterfall_append(&dec->wf, audio, n);
+    dec->shared_next = pos + (uint64_t)n;
+    take_rows(dec, eng);
+    return skip + taken;
+}
+
+static uint64_t osd_budget_end(const ft8_decoder_t *dec)
+{
+    return now_ns() + (uint64_t)(dec->cfg.osd_budget_ms * 1e6f);
+}
+
+int ft8_decoder_decode_early(ft8_decoder_t *dec, ft8_result_t *out, int max_out)
+{
+    if (!dec || !out || max_out <= 0) return 0;
+    return decode_pass(dec, FT8_EARLY_SYMBOLS, osd_budget_end(dec), out, 0, max_out);
+}
+
+int ft8_decoder_decode_fed(ft8_decoder_t *dec, ft8_result_t *out, int max_out)
+{
+    if (!dec || !out || max_out <= 0) return 0;
+
+    ft8_waterfall_flush(&dec->wf);
+    const uint64_t deadline = osd_budget_end(dec);
+    int n_out = 0;
+
+    /*
+     * Early decodes are subtracted before the first pass; after that each
+     * pass runs on what is left once its predecessor's finds are gone,
+     * until one finds nothing new.
+     */
+    for (int pass = 0; pass < dec->cfg.passes && n_out < max_out; pass++) {
+        if (dec->cfg.passes > 1 && dec->n_found > dec->n_subtracted) {
+            subtract_found(dec);
+        } else if (pass > 0) {
+            break;
+        }
+        n_out = decode_pass(dec, FT8_SYMBOL_COUNT, deadline, out, n_out, max_out);
+    }
+    return n_out;
+}
+
+int ft8_decoder_decode(ft8_decoder_t *dec, const float *audio, int n,
+                       ft8_result_t *out, int max_out)
+{
+    if (!dec || !audio || !out || max_out <= 0) return 0;
+
+    ft8_decoder_reset(dec);
+    ft8_decoder_feed(dec, audio, n);
+    return ft8_decoder_decode_fed(dec, out, max_out);
+}
+
+/* ------------------------------------------------------------------ */
+/* Encode                                                              */
+/* ------------------------------------------------------------------ */
+
+void ft8_encode(const uint8_t *payload, uint8_t *tones)
+{
+    uint8_t message[FT8_LDPC_K];
+    uint8_t codeword[FT8_LDPC_N];
+
+    memcpy(message, payload, FT8_PAYLOAD_BITS);
+    ft8_crc_append(message, FT8_PAYLOAD_BITS);
+    ft8_ldpc_encode(ft8_ldpc_ft8(), message, codeword);
+
+    int d = 0;
+    for (int pos = 0; pos < FT8_SYMBOL_COUNT; pos++) {
+        int b = 0;
+        while (b < 3 && (pos < k_sync_offsets[b] || pos >= k_sync_offsets[b] + FT8_COSTAS_LENGTH)) {
+            b++;
+        }
+        if (b < 3) {
+            tones[pos] = (uint8_t)k_costas[pos - k_sync_offsets[b]];
+        } else {
+            const uint8_t *bits = codeword + FT8_BITS_PER_SYMBOL * d++;
+            tones[pos] = (uint8_t)k_gray_encode[(bits[0] << 2) | (bits[1] << 1) | bits[2]];
+        }
+    }
+}
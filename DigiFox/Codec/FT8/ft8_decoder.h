@@ -0,0 +1,211 @@
+/**
+ * ft8_decoder.h — Public C API for the FT8 decoder core
+ *
+ * Native counterpart of FT8Demodulator.demodulate(): waterfall →
+ * Costas sync → soft bits → LDPC(174,91) (belief propagation, then
+ * ordered statistics within a time budget) → CRC-14, then subtraction of
+ * what was decoded and another pass over the residual, on flat buffers
+ * that are all allocated in ft8_decoder_create(). Input is 12 kHz mono audio
+ * covering one 15 s slot; the result carries the 77 payload bits for
+ * FT8MessagePack.unpack().
+ *
+ * The waterfall is oversampled 4× in time and 2× in frequency (see
+ * ft8_waterfall.h) and built as audio is fed, so the FFT work is spread
+ * over the slot and decoding can start as soon as it ends.
+ *
+ * Usage, whole slot:
+ *   ft8_config_t cfg;
+ *   ft8_config_init(&cfg);
+ *
+ *   ft8_decoder_t *dec = ft8_decoder_create(&cfg);
+ *   ft8_result_t res[64];
+ *   int n = ft8_decoder_decode(dec, audio, num_samples, res, 64);
+ *   ft8_decoder_destroy(dec);
+ *
+ * Streaming:
+ *   ft8_decoder_reset(dec);                          // slot starts
+ *   ft8_decoder_feed(dec, chunk, chunk_len);         // as audio arrives
+ *   int e = ft8_decoder_decode_early(dec, res, 64);  // optional, ~11.8 s in
+ *   int n = ft8_decoder_decode_fed(dec, res, 64);    // slot ends: new ones only
+ *
+ * With a spectrum engine already transforming the same audio, feed it
+ * through ft8_decoder_feed_shared() instead and the waterfall takes the
+ * engine's rows rather than running its own FFTs.
+ */
+
+#ifndef FT8_DECODER_H
+#define FT8_DECODER_H
+
+#include <stdint.h>
+
+#include "spectrum_engine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FT8_SAMPLE_RATE     12000
+#define FT8_SYMBOL_SAMPLES  1920    /* 0.16 s */
+#define FT8_SYMBOL_COUNT    79
+#define FT8_TONE_SPACING    6.25f   /* Hz, one spectrogram bin */
+#define FT8_PAYLOAD_BITS    77
+
+/* Opaque decoder handle */
+typedef struct ft8_decoder_t ft8_decoder_t;
+
+/* One Costas search's scoring (ft8_sync.h) */
+struct ft8_sync_job_t;
+
+/* Configuration struct — all fields have sensible defaults via ft8_config_init() */
+typedef struct ft8_config_t {
+    float min_freq;          /* Lowest base (tone 0) frequency searched in Hz (default: 200) */
+    float max_freq;          /* Highest base frequency searched in Hz (default: 3000) */
+    float sync_threshold;    /* Minimum Costas score for a candidate (default: 4.0) */
+    int   max_candidates;    /* Best-scoring candidates tried per slot (default: 40) */
+    int   ldpc_iterations;   /* Belief-propagation iteration cap (default: 50) */
+    int   osd_depth;         /* Ordered-statistics fallback for candidates BP
+                                gives up on: 0 = off, 1 or 2 flips (default: 2) */
+    float osd_budget_ms;     /* Time the fallback may spend per slot
+                                (default: 250) */
+    int   passes;            /* Decode passes at slot end; each one after the
+                                first runs on the audio with every message
+                                found so far subtracted, 1 = no subtraction,
+                                at most 8 (default: 3) */
+    int   threads;           /* Workers for the per-candidate stage (soft bits,
+                                LDPC, OSD), the calling thread included;
+                                0 = one per performance core (default: 0) */
+    int   max_samples;       /* Longest buffer decoded; the rest is ignored
+                                (default: 15 s at 12 kHz) */
+    int (*sync_score)(void *ctx, const struct ft8_sync_job_t *job, float *map);
+                             /* Scores the Costas search elsewhere, e.g.
+                                ft8_sync_metal_score() on the GPU; the CPU
+                                does it when NULL or when it fails
+                                (default: NULL) */
+    void *sync_ctx;          /* Passed to sync_score */
+} ft8_config_t;
+
+/* One decoded message */
+typedef struct {
+    uint8_t payload[FT8_PAYLOAD_BITS];  /* Message bits, 0/1, first bit first */
+    float   snr;                        /* Estimated SNR in dB (2500 Hz) */
+    float   freq_hz;                    /* Refined base frequency in Hz */
+    float   time_s;                     /* Frame start within the buffer in s */
+    float   score;                      /* Costas sync score */
+    int     iterations;                 /* LDPC iterations to converge; 0 when
+                                           recovered by the OSD fallback */
+} ft8_result_t;
+
+/**
+ * Initialize config with default values.
+ * Always call this before modifying individual fields.
+ */
+void ft8_config_init(ft8_config_t *cfg);
+
+/**
+ * Create a decoder instance. All buffers are sized here from cfg;
+ * decoding does no heap allocation.
+ * Returns NULL on allocation failure.
+ */
+ft8_decoder_t *ft8_decoder_create(const ft8_config_t *cfg);
+
+/**
+ * Start a new slot: drop all audio fed so far.
+ */
+void ft8_decoder_reset(ft8_decoder_t *dec);
+
+/**
+ * Append audio to the current slot, transforming the waterfall windows
+ * it completes.
+ *
+ * @param dec    Decoder handle
+ * @param audio  Audio samples (mono, float, 12 kHz)
+ * @param n      Number of samples
+ * @return       Samples taken (fewer than n once cfg.max_samples is reached)
+ */
+int ft8_decoder_feed(ft8_decoder_t *dec, const float *audio, int n);
+
+/**
+ * ft8_decoder_feed() for audio the engine has already taken: the
+ * waterfall windows are copied from its rows instead of transformed.
+ * A slot starts on the engine's window grid, so up to hop - 1 of its
+ * first samples are dropped. The decoder falls back to its own FFTs
+ * if the engine's windows differ from the waterfall's, if its rows are
+ * not 12 kHz, or if pos shows a gap in the audio.
+ *
+ * @param eng    Engine fed with the same stream (NULL = ft8_decoder_feed())
+ * @param pos    Stream index of audio[0] in the engine,
+ *               spectrum_engine_samples() before it was fed
+ * @return       Samples taken, dropped ones included
+ */
+int ft8_decoder_feed_shared(ft8_decoder_t *dec, const float *audio, int n,
+                            const spectrum_engine_t *eng, uint64_t pos);
+
+/**
+ * Decode frames of the current slot that are not complete yet, as
+ * WSJT-X's early decode does about 11.8 s into the slot. A frame is
+ * tried once at least 68 of its 79 symbols have been fed; data symbols
+ * still missing go to LDPC as erasures. Messages found here are
+ * remembered until the next reset, so ft8_decoder_decode_fed() neither
+ * retries their candidates nor reports them again.
+ *
+ * @param dec      Decoder handle
+ * @param out      Output array for decoded messages, best sync first
+ * @param max_out  Capacity of out
+ * @return         Number of messages written to out
+ */
+int ft8_decoder_decode_early(ft8_decoder_t *dec, ft8_result_t *out, int max_out);
+
+/**
+ * Decode the audio fed since the last reset. After
+ * ft8_decoder_decode_early() only the messages it did not find are
+ * returned.
+ *
+ * @param dec      Decoder handle
+ * @param out      Output array for decoded messages, best sync first
+ * @param max_out  Capacity of out
+ * @return         Number of messages written to out
+ */
+int ft8_decoder_decode_fed(ft8_decoder_t *dec, ft8_result_t *out, int max_out);
+
+/**
+ * Decode one slot of audio: reset, feed and decode_fed in one call.
+ *
+ * @param dec      Decoder handle
+ * @param audio    Audio samples (mono, float, 12 kHz)
+ * @param n        Number of samples (at most cfg.max_samples are used)
+ * @param out      Output array for decoded messages, best sync first
+ * @param max_out  Capacity of out
+ * @return         Number of messages written to out
+ */
+int ft8_decoder_decode(ft8_decoder_t *dec, const float *audio, int n,
+                       ft8_result_t *out, int max_out);
+
+/**
+ * Change how hard the next decodes try, without a rebuild and without
+ * dropping the audio fed so far. Candidates and passes are capped at
+ * what cfg asked for at create (the buffers are sized for that); the
+ * OSD depth and budget take any value cfg would. Not thread-safe
+ * against a decode in progress.
+ */
+void ft8_decoder_set_effort(ft8_decoder_t *dec, int max_candidates, int passes,
+                            int osd_depth, float osd_budget_ms);
+
+/**
+ * The 79 channel tones of a 77-bit payload, as FT8Modulator sends them:
+ * CRC-14, LDPC(174,91), Gray-coded between the three Costas blocks.
+ *
+ * @param payload  FT8_PAYLOAD_BITS bits, 0/1
+ * @param tones    Out: FT8_SYMBOL_COUNT tones (0-7)
+ */
+void ft8_encode(const uint8_t *payload, uint8_t *tones);
+
+/**
+ * Destroy decoder and free all resources.
+ */
+void ft8_decoder_destroy(ft8_decoder_t *dec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FT8_DECODER_H */
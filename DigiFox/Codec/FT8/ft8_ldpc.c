@@ -0,0 +1,296 @@
+/**
+ * ft8_ldpc.c — LDPC(174,91) encode and layered min-sum decode on flat edge arrays
+ */
+
+#include "ft8_ldpc.h"
+#include "ft8_ldpc_tables.h"
+#include "simd_detect.h"
+
+#include <math.h>
+#include <string.h>
+
+#define FT8_LDPC_SCALE  0.8f   /* Min-sum normalization */
+
+const ft8_ldpc_code_t *ft8_ldpc_ft8(void)
+{
+    return &FT8_LDPC_CODE;
+}
+
+const ft8_ldpc_code_t *ft8_ldpc_js8(void)
+{
+    return &JS8_LDPC_CODE;
+}
+
+void ft8_ldpc_encode(const ft8_ldpc_code_t *code, const uint8_t *message,
+                     uint8_t *codeword)
+{
+    memcpy(codeword, message, FT8_LDPC_K);
+
+    for (int m = 0; m < FT8_LDPC_M; m++) {
+        uint8_t parity = 0;
+        for (int e = code->row_start[m]; e < code->row_start[m + 1]; e++) {
+            int col = code->edge_col[e];
+            if (col < FT8_LDPC_K) parity ^= message[col];
+        }
+        codeword[FT8_LDPC_K + m] = parity & 1;
+    }
+}
+
+/* Checks not satisfied by the hard decisions */
+static int count_unsatisfied(const ft8_ldpc_code_t *code, const uint8_t *bits)
+{
+    int count = 0;
+    for (int m = 0; m < FT8_LDPC_M; m++) {
+        uint8_t parity = 0;
+        for (int e = code->row_start[m]; e < code->row_start[m + 1]; e++) {
+            parity ^= bits[code->edge_col[e]];
+        }
+        count += parity & 1;
+    }
+    return count;
+}
+
+int ft8_ldpc_decode(const ft8_ldpc_code_t *code, const float *llr,
+                    int max_iterations, ft8_ldpc_work_t *w,
+                    uint8_t *message)
+{
+    memcpy(w->total, llr, sizeof(w->total));
+    memset(w->c2v, 0, (size_t)code->n_edges * sizeof(float));
+
+    for (int i = 0; i < FT8_LDPC_N; i++) w->hard[i] = llr[i] < 0.0f;
+    int unsatisfied = count_unsatisfied(code, w->hard);
+    if (unsatisfied == 0) {
+        memcpy(message, w->hard, FT8_LDPC_K);
+        return 1;
+    }
+
+    int best = unsatisfied, stalled = 0;
+
+    for (int iter = 1; iter <= max_iterations; iter++) {
+        for (int m = 0; m < FT8_LDPC_M; m++) {
+            const int start = code->row_start[m];
+            const int deg = code->row_start[m + 1] - start;
+            const uint8_t *col = code->edge_col + start;
+            float *r = w->c2v + start;
+            float *q = w->q;
+
+            /* Variable → check: posterior minus this check's last message */
+            for (int j = 0; j < deg; j++) q[j] = w->total[col[j]] - r[j];
+
+            /* Two smallest magnitudes and the sign of the product */
+            float min1 = INFINITY, min2 = INFINITY;
+            int at = 0;
+            uint32_t sign = 0;
+            for (int j = 0; j < deg; j++) {
+                float a = fabsf(q[j]);
+                if (a < min2) {
+                    if (a < min1) { min2 = min1; min1 = a; at = j; }
+                    else          { min2 = a; }
+                }
+                sign ^= signbit(q[j]) != 0;
+            }
+            min1 *= FT8_LDPC_SCALE;
+            min2 *= FT8_LDPC_SCALE;
+
+            /* Check → variable: every edge but the minimum sees min1 */
+            for (int j = 0; j < deg; j++) {
+                float mag = j == at ? min2 : min1;
+                float v = (sign ^ (signbit(q[j]) != 0)) ? -mag : mag;
+                r[j] = v;
+                w->total[col[j]] = q[j] + v;
+            }
+        }
+
+        for (int i = 0; i < FT8_LDPC_N; i++) w->hard[i] = w->total[i] < 0.0f;
+        unsatisfied = count_unsatisfied(code, w->hard);
+        if (unsatisfied == 0) {
+            memcpy(message, w->hard, FT8_LDPC_K);
+            return iter;
+        }
+
+        /* Stalled far from a codeword: more iterations will not get there */
+        if (unsatisfied < best) {
+            best = unsatisfied;
+            stalled = 0;
+        } else if (++stalled >= 5 && iter >= 10 && unsatisfied > 15) {
+            break;
+        }
+    }
+
+    return 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* Batch decode                                                        */
+/* ------------------------------------------------------------------ */
+
+#define SCALAR_LANES 4
+
+/* Same arithmetic as ft8_ldpc_decode(), lane by lane */
+void ft8_ldpc_sweep_scalar(const ft8_ldpc_code_t *code, float *c2v,
+                           float *total, float *q)
+{
+    for (int m = 0; m < FT8_LDPC_M; m++) {
+        const int start = code->row_start[m];
+        const int deg = code->row_start[m + 1] - start;
+        const uint8_t *col = code->edge_col + start;
+        float *r = c2v + start * SCALAR_LANES;
+
+        for (int l = 0; l < SCALAR_LANES; l++) {
+            float min1 = INFINITY, min2 = INFINITY;
+            int at = 0;
+            uint32_t sign = 0;
+
+            for (int j = 0; j < deg; j++) {
+                float v = total[col[j] * SCALAR_LANES + l] - r[j * SCALAR_LANES + l];
+                float a = fabsf(v);
+                q[j * SCALAR_LANES + l] = v;
+                if (a < min2) {
+                    if (a < min1) { min2 = min1; min1 = a; at = j; }
+                    else          { min2 = a; }
+                }
+                sign ^= signbit(v) != 0;
+            }
+            min1 *= FT8_LDPC_SCALE;
+            min2 *= FT8_LDPC_SCALE;
+
+            for (int j = 0; j < deg; j++) {
+                float qj = q[j * SCALAR_LANES + l];
+                float mag = j == at ? min2 : min1;
+                float v = (sign ^ (signbit(qj) != 0)) ? -mag : mag;
+                r[j * SCALAR_LANES + l] = v;
+                total[col[j] * SCALAR_LANES + l] = qj + v;
+            }
+        }
+    }
+}
+
+static ft8_ldpc_sweep_fn s_sweep;
+static int s_width;
+
+static void init_sweep(void)
+{
+    if (s_sweep) return;
+
+    ft8_ldpc_sweep_fn sweep = ft8_ldpc_sweep_scalar;
+    int width = SCALAR_LANES;
+    cw_simd_level_t level = cw_detect_simd();
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+    if (level == CW_SIMD_NEON) sweep = ft8_ldpc_sweep_neon;
+#elif defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    if (level >= CW_SIMD_SSE2) sweep = ft8_ldpc_sweep_sse2;
+#if defined(__GNUC__) || defined(__clang__)
+    if (level == CW_SIMD_AVX2) {
+        sweep = ft8_ldpc_sweep_avx2;
+        width = 8;
+    }
+#endif
+#else
+    (void)level;
+#endif
+
+    /* Repeated calls write identical values */
+    s_width = width;
+    s_sweep = sweep;
+}
+
+int ft8_ldpc_batch_width(void)
+{
+    init_sweep();
+    return s_width;
+}
+
+typedef struct {
+    int task;        /* Problem index, -1 = idle */
+    int iter;
+    int best;
+    int stalled;
+} lane_t;
+
+/* Gather one lane's hard decisions into b->hard */
+static void lane_hard(ft8_ldpc_batch_t *b, int width, int l)
+{
+    for (int i = 0; i < FT8_LDPC_N; i++) {
+        b->hard[i] = b->total[i * width + l] < 0.0f;
+    }
+}
+
+int ft8_ldpc_decode_batch(const ft8_ldpc_code_t *code, const float *llr,
+                          int n, int max_iterations, ft8_ldpc_batch_t *b,
+                          uint8_t *messages, int *iterations)
+{
+    init_sweep();
+    const int width = s_width;
+    const int n_edges = code->n_edges;
+
+    lane_t lane[FT8_LDPC_MAX_LANES];
+    for (int l = 0; l < width; l++) lane[l].task = -1;
+
+    memset(b->c2v, 0, (size_t)n_edges * width * sizeof(float));
+    memset(b->total, 0, (size_t)FT8_LDPC_N * width * sizeof(float));
+
+    int next = 0, decoded = 0;
+
+    for (;;) {
+        /* Refill idle lanes; problems the channel already solves skip the sweep */
+        int active = 0;
+        for (int l = 0; l < width; l++) {
+            while (lane[l].task < 0 && next < n) {
+                int t = next++;
+                const float *x = llr + (long)t * FT8_LDPC_N;
+
+                iterations[t] = 0;
+                for (int i = 0; i < FT8_LDPC_N; i++) b->hard[i] = x[i] < 0.0f;
+                int unsatisfied = count_unsatisfied(code, b->hard);
+                if (unsatisfied == 0) {
+                    memcpy(messages + (long)t * FT8_LDPC_K, b->hard, FT8_LDPC_K);
+                    iterations[t] = 1;
+                    decoded++;
+                    continue;
+                }
+
+                for (int i = 0; i < FT8_LDPC_N; i++) b->total[i * width + l] = x[i];
+                for (int e = 0; e < n_edges; e++) b->c2v[e * width + l] = 0.0f;
+                lane[l].task = t;
+                lane[l].iter = 0;
+                lane[l].best = unsatisfied;
+                lane[l].stalled = 0;
+            }
+            if (lane[l].task >= 0) active++;
+        }
+        if (!active) break;
+
+        s_sweep(code, b->c2v, b->total, b->q);
+
+        for (int l = 0; l < width; l++) {
+            lane_t *ln = &lane[l];
+            if (ln->task < 0) continue;
+            ln->iter++;
+
+            lane_hard(b, width, l);
+            int unsatisfied = count_unsatisfied(code, b->hard);
+            int done = 0;
+            if (unsatisfied == 0) {
+                memcpy(messages + (long)ln->task * FT8_LDPC_K, b->hard, FT8_LDPC_K);
+                iterations[ln->task] = ln->iter;
+                decoded++;
+                done = 1;
+            } else if (unsatisfied < ln->best) {
+                ln->best = unsatisfied;
+                ln->stalled = 0;
+            } else if (++ln->stalled >= 5 && ln->iter >= 10 && unsatisfied > 15) {
+                done = 1;
+            }
+            if (ln->iter >= max_iterations) done = 1;
+
+            if (done) {
+                /* Park the lane on zeros until it is refilled */
+                for (int i = 0; i < FT8_LDPC_N; i++) b->total[i * width + l] = 0.0f;
+                ln->task = -1;
+            }
+        }
+    }
+
+    return decoded;
+}
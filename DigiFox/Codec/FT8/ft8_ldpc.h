@@ -0,0 +1,141 @@
+/**
+ * ft8_ldpc.h — LDPC(174,91) codes and min-sum decoder for FT8 and JS8
+ *
+ * Both modes use a systematic H = [P | I_83] but different P: FT8 the
+ * table its modulator has always encoded with, JS8 a column-weight-3
+ * construction. Both are const tables generated at build time
+ * (gen_ldpc_tables.py → ft8_ldpc_tables.h) as flat edge arrays: the
+ * edges of check m are edge_col[row_start[m] .. row_start[m + 1] - 1],
+ * and those of codeword bit n are the edge indices col_edge[col_start[n]
+ * .. col_start[n + 1] - 1]. Messages live in caller-owned workspaces, so
+ * decoding does no heap traffic.
+ *
+ * The decoder is layered (check by check, each update seen by the next
+ * check in the same iteration), which converges in about half the
+ * iterations of a flooding schedule. Each check keeps only the two
+ * smallest incoming magnitudes, so an update is O(degree).
+ */
+
+#ifndef FT8_LDPC_H
+#define FT8_LDPC_H
+
+#include <stdint.h>
+
+#define FT8_LDPC_N          174   /* Codeword bits */
+#define FT8_LDPC_K          91    /* Message bits (77 payload + 14 CRC) */
+#define FT8_LDPC_M          83    /* Parity checks */
+#define FT8_LDPC_MAX_EDGES  2080  /* Ones in H (FT8; JS8 has 356) */
+#define FT8_LDPC_MAX_DEGREE 64    /* Edges per check */
+#define FT8_LDPC_MAX_LANES  8     /* Problems per batch sweep (AVX2) */
+
+typedef struct {
+    int      n_edges;
+    uint16_t row_start[FT8_LDPC_M + 1];      /* Check-node CSR */
+    uint8_t  edge_col[FT8_LDPC_MAX_EDGES];
+    uint16_t col_start[FT8_LDPC_N + 1];      /* Variable-node CSR */
+    uint16_t col_edge[FT8_LDPC_MAX_EDGES];   /* Edge indices, by check */
+} ft8_ldpc_code_t;
+
+/* Per-decode scratch (one per concurrent decode) */
+typedef struct {
+    float   c2v[FT8_LDPC_MAX_EDGES];   /* Check → variable messages */
+    float   total[FT8_LDPC_N];         /* A-posteriori LLR */
+    float   q[FT8_LDPC_MAX_DEGREE];    /* Current check's inputs, contiguous */
+    uint8_t hard[FT8_LDPC_N];
+} ft8_ldpc_work_t;
+
+/*
+ * Batch scratch: one problem per SIMD lane, interleaved — value i of
+ * lane l at [i * width + l].
+ */
+typedef struct {
+    float   c2v[FT8_LDPC_MAX_EDGES * FT8_LDPC_MAX_LANES];
+    float   total[FT8_LDPC_N * FT8_LDPC_MAX_LANES];
+    float   q[FT8_LDPC_MAX_DEGREE * FT8_LDPC_MAX_LANES];
+    uint8_t hard[FT8_LDPC_N];
+} ft8_ldpc_batch_t;
+
+/*
+ * One layered iteration over every check for `width` interleaved lanes.
+ * Selected once from the CPU's SIMD level (simd_detect.h).
+ */
+typedef void (*ft8_ldpc_sweep_fn)(const ft8_ldpc_code_t *code, float *c2v,
+                                  float *total, float *q);
+
+/**
+ * The FT8 code (FT8 and FT4).
+ */
+const ft8_ldpc_code_t *ft8_ldpc_ft8(void);
+
+/**
+ * The JS8 code.
+ */
+const ft8_ldpc_code_t *ft8_ldpc_js8(void);
+
+/**
+ * Systematic encode: 91 message bits → 174 codeword bits (0/1 per byte).
+ */
+void ft8_ldpc_encode(const ft8_ldpc_code_t *code, const uint8_t *message,
+                     uint8_t *codeword);
+
+/**
+ * Layered normalized min-sum (0.8 scaling). Stops as soon as the hard
+ * decisions satisfy every check, and gives up early when the count of
+ * unsatisfied checks has stopped falling (no improvement in 5
+ * iterations, past iteration 10, with more than 15 left).
+ *
+ * @param code            ft8_ldpc_ft8() or ft8_ldpc_js8()
+ * @param llr             174 channel LLRs, positive = bit more likely 0
+ * @param max_iterations  Iteration cap
+ * @param w               Scratch
+ * @param message         Out: 91 decoded message bits on success
+ * @return Iterations used (>= 1; 1 also when the channel decisions are
+ *         already a codeword), or 0 if no valid codeword was found
+ */
+int ft8_ldpc_decode(const ft8_ldpc_code_t *code, const float *llr,
+                    int max_iterations, ft8_ldpc_work_t *w,
+                    uint8_t *message);
+
+/**
+ * Decode n independent problems through the batch sweep, `width`
+ * problems at a time (4 scalar / SSE2 / NEON, 8 AVX2). A lane that
+ * converges or gives up is refilled with the next problem at the
+ * following iteration, so lanes never idle behind a slow neighbour.
+ * Per problem the result is exactly that of ft8_ldpc_decode().
+ *
+ * @param code            ft8_ldpc_ft8() or ft8_ldpc_js8()
+ * @param llr             n rows of 174 channel LLRs
+ * @param n               Number of problems
+ * @param max_iterations  Iteration cap per problem
+ * @param b               Scratch
+ * @param messages        Out: n rows of 91 message bits (valid where
+ *                        iterations[i] > 0)
+ * @param iterations      Out: per problem as ft8_ldpc_decode() returns
+ * @return Number of problems decoded
+ */
+int ft8_ldpc_decode_batch(const ft8_ldpc_code_t *code, const float *llr,
+                          int n, int max_iterations, ft8_ldpc_batch_t *b,
+                          uint8_t *messages, int *iterations);
+
+/**
+ * Lanes per batch sweep on this CPU.
+ */
+int ft8_ldpc_batch_width(void);
+
+/* Sweep kernels, 4 lanes unless noted */
+void ft8_ldpc_sweep_scalar(const ft8_ldpc_code_t *code, float *c2v,
+                           float *total, float *q);
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+void ft8_ldpc_sweep_neon(const ft8_ldpc_code_t *code, float *c2v,
+                         float *total, float *q);
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+void ft8_ldpc_sweep_sse2(const ft8_ldpc_code_t *code, float *c2v,
+                         float *total, float *q);
+void ft8_ldpc_sweep_avx2(const ft8_ldpc_code_t *code, float *c2v,
+                         float *total, float *q);   /* 8 lanes */
+#endif
+
+#endif /* FT8_LDPC_H */
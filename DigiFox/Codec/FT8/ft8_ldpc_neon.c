@@ -0,0 +1,58 @@
+/**
+ * ft8_ldpc_neon.c — NEON batch min-sum sweep
+ *
+ * Four problems advance through the same check at once, one per lane.
+ * Arithmetic matches the scalar sweep lane for lane.
+ */
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+#include "ft8_ldpc.h"
+#include <arm_neon.h>
+
+#define FT8_LDPC_SCALE  0.8f
+
+void ft8_ldpc_sweep_neon(const ft8_ldpc_code_t *code, float *c2v,
+                         float *total, float *q)
+{
+    const uint32x4_t sgn = vdupq_n_u32(0x80000000u);
+    const float32x4_t inf = vdupq_n_f32(__builtin_inff());
+
+    for (int m = 0; m < FT8_LDPC_M; m++) {
+        const int start = code->row_start[m];
+        const int deg = code->row_start[m + 1] - start;
+        const uint8_t *col = code->edge_col + start;
+        float *r = c2v + start * 4;
+
+        float32x4_t min1 = inf, min2 = inf;
+        uint32x4_t at = vdupq_n_u32(0);       /* Edge index of min1 */
+        uint32x4_t sign = vdupq_n_u32(0);
+
+        for (int j = 0; j < deg; j++) {
+            float32x4_t v = vsubq_f32(vld1q_f32(total + col[j] * 4),
+                                      vld1q_f32(r + j * 4));
+            float32x4_t a = vabsq_f32(v);
+            vst1q_f32(q + j * 4, v);
+
+            uint32x4_t lt1 = vcltq_f32(a, min1);
+            min2 = vbslq_f32(lt1, min1, vminq_f32(min2, a));
+            min1 = vbslq_f32(lt1, a, min1);
+            at   = vbslq_u32(lt1, vdupq_n_u32((uint32_t)j), at);
+            sign = veorq_u32(sign, vandq_u32(vreinterpretq_u32_f32(v), sgn));
+        }
+        min1 = vmulq_n_f32(min1, FT8_LDPC_SCALE);
+        min2 = vmulq_n_f32(min2, FT8_LDPC_SCALE);
+
+        for (int j = 0; j < deg; j++) {
+            float32x4_t v = vld1q_f32(q + j * 4);
+            uint32x4_t is_at = vceqq_u32(at, vdupq_n_u32((uint32_t)j));
+            float32x4_t mag = vbslq_f32(is_at, min2, min1);
+            uint32x4_t s = veorq_u32(sign, vandq_u32(vreinterpretq_u32_f32(v), sgn));
+            float32x4_t out = vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(mag), s));
+            vst1q_f32(r + j * 4, out);
+            vst1q_f32(total + col[j] * 4, vaddq_f32(v, out));
+        }
+    }
+}
+
+#endif /* AArch64 */
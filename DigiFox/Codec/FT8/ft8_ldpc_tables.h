@@ -0,0 +1,377 @@
+/**
+ * ft8_ldpc_tables.h — FT8 and JS8 LDPC(174,91) Tanner graphs (generated)
+ *
+ * Generated by gen_ldpc_tables.py — do not edit. Included by
+ * ft8_ldpc.c only; use ft8_ldpc_ft8() / ft8_ldpc_js8().
+ */
+
+#ifndef FT8_LDPC_TABLES_H
+#define FT8_LDPC_TABLES_H
+
+#include "ft8_ldpc.h"
+
+static const ft8_ldpc_code_t FT8_LDPC_CODE = {
+    .n_edges = 2080,
+    .row_start = {
+        0, 35, 69, 110, 132, 186, 214, 242, 273, 306, 327, 348, 369, 398, 421, 443,
+        464, 493, 517, 538, 564, 589, 613, 634, 660, 685, 708, 730, 756, 781, 804, 826,
+        852, 877, 900, 922, 948, 973, 996, 1018, 1044, 1069, 1092, 1114, 1140, 1166, 1189, 1211,
+        1237, 1262, 1286, 1308, 1334, 1359, 1382, 1404, 1430, 1455, 1478, 1500, 1527, 1552, 1575, 1597,
+        1623, 1648, 1671, 1693, 1719, 1744, 1767, 1789, 1815, 1841, 1864, 1886, 1912, 1938, 1961, 1983,
+        2009, 2034, 2058, 2080,
+    },
+    .edge_col = {
+        0, 1, 2, 3, 4, 6, 7, 10, 11, 12, 15, 17, 19, 24, 27, 29,
+        31, 33, 36, 44, 45, 47, 51, 55, 58, 61, 63, 67, 73, 79, 82, 84,
+        86, 89, 91, 0, 5, 6, 8, 9, 11, 13, 14, 16, 18, 20, 25, 28,
+        30, 32, 34, 37, 42, 46, 48, 52, 56, 59, 62, 64, 68, 72, 78, 83,
+        85, 87, 88, 90, 92, 1, 2, 3, 4, 7, 8, 9, 10, 12, 13, 14,
+        15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30,
+        35, 38, 40, 43, 49, 53, 57, 60, 65, 69, 74, 76, 80, 93, 31, 32,
+        33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 46, 50, 54, 70,
+        75, 77, 81, 94, 0, 1, 5, 9, 22, 26, 39, 41, 45, 47, 48, 49,
+        50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65,
+        66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81,
+        82, 83, 84, 85, 86, 87, 88, 89, 90, 95, 2, 3, 4, 6, 7, 8,
+        10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 23, 24, 25, 27,
+        28, 29, 30, 66, 71, 96, 0, 1, 2, 5, 6, 8, 10, 14, 21, 22,
+        23, 26, 31, 35, 39, 41, 44, 46, 50, 54, 66, 71, 76, 80, 82, 86,
+        89, 97, 0, 3, 4, 7, 9, 11, 13, 15, 17, 20, 24, 25, 27, 32,
+        33, 37, 40, 42, 45, 47, 51, 55, 67, 70, 75, 77, 81, 83, 87, 88,
+        98, 1, 5, 6, 8, 12, 16, 18, 19, 28, 29, 30, 34, 36, 38, 43,
+        48, 49, 52, 53, 56, 57, 58, 59, 68, 72, 73, 74, 78, 79, 84, 85,
+        90, 99, 2, 9, 10, 14, 22, 26, 31, 35, 39, 60, 61, 62, 63, 64,
+        65, 69, 76, 80, 82, 86, 100, 0, 3, 7, 11, 15, 21, 23, 32, 36,
+        40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89, 101, 1, 4, 6, 13,
+        17, 20, 24, 25, 33, 37, 42, 45, 47, 51, 55, 67, 72, 78, 83, 87,
+        102, 5, 8, 12, 16, 18, 19, 27, 28, 29, 30, 34, 38, 41, 43, 46,
+        48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90, 103, 2, 9,
+        10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69,
+        76, 80, 82, 86, 104, 0, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40,
+        44, 50, 54, 66, 70, 71, 75, 77, 81, 89, 105, 1, 4, 6, 13, 17,
+        20, 24, 25, 33, 37, 42, 45, 47, 51, 55, 67, 72, 78, 83, 87, 106,
+        5, 8, 12, 16, 18, 19, 27, 28, 29, 30, 34, 38, 41, 43, 46, 48,
+        49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90, 107, 0, 2, 9,
+        10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69,
+        76, 80, 82, 86, 108, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44,
+        50, 54, 66, 70, 71, 75, 77, 81, 89, 109, 1, 4, 5, 6, 8, 13,
+        16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72,
+        78, 83, 87, 110, 0, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48,
+        49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90, 111, 1, 2, 9,
+        10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69,
+        76, 80, 82, 86, 112, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44,
+        50, 54, 66, 70, 71, 75, 77, 81, 89, 113, 0, 4, 5, 6, 8, 13,
+        16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72,
+        78, 83, 87, 114, 1, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48,
+        49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90, 115, 2, 9, 10,
+        14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76,
+        80, 82, 86, 116, 0, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44,
+        50, 54, 66, 70, 71, 75, 77, 81, 89, 117, 1, 4, 5, 6, 8, 13,
+        16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72,
+        78, 83, 87, 118, 2, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48,
+        49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90, 119, 0, 9, 10,
+        14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76,
+        80, 82, 86, 120, 1, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44,
+        50, 54, 66, 70, 71, 75, 77, 81, 89, 121, 2, 4, 5, 6, 8, 13,
+        16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72,
+        78, 83, 87, 122, 0, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48,
+        49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90, 123, 1, 9, 10,
+        14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76,
+        80, 82, 86, 124, 2, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44,
+        50, 54, 66, 70, 71, 75, 77, 81, 89, 125, 0, 4, 5, 6, 8, 13,
+        16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72,
+        78, 83, 87, 126, 1, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48,
+        49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90, 127, 2, 9, 10,
+        14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76,
+        80, 82, 86, 128, 0, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44,
+        50, 54, 66, 70, 71, 75, 77, 81, 89, 129, 1, 4, 5, 6, 8, 13,
+        16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72,
+        78, 83, 87, 130, 2, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48,
+        49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90, 131, 0, 9, 10,
+        14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76,
+        80, 82, 86, 132, 1, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44,
+        50, 54, 66, 70, 71, 75, 77, 81, 89, 133, 2, 4, 5, 6, 8, 13,
+        16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72,
+        78, 83, 87, 134, 0, 1, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46,
+        48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90, 135, 2, 9,
+        10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69,
+        76, 80, 82, 86, 136, 0, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40,
+        44, 50, 54, 66, 70, 71, 75, 77, 81, 89, 137, 1, 4, 5, 6, 8,
+        13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67,
+        72, 78, 83, 87, 138, 2, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46,
+        48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90, 139, 0, 1,
+        9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65,
+        69, 76, 80, 82, 86, 140, 2, 3, 7, 11, 15, 21, 23, 31, 32, 36,
+        40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89, 141, 0, 4, 5, 6,
+        8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55,
+        67, 72, 78, 83, 87, 142, 1, 12, 19, 28, 29, 30, 34, 38, 41, 43,
+        46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90, 143, 2,
+        9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65,
+        69, 76, 80, 82, 86, 144, 0, 3, 7, 11, 15, 21, 23, 31, 32, 36,
+        40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89, 145, 1, 4, 5, 6,
+        8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55,
+        67, 72, 78, 83, 87, 146, 2, 12, 19, 28, 29, 30, 34, 38, 41, 43,
+        46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90, 147, 0,
+        9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65,
+        69, 76, 80, 82, 86, 148, 1, 3, 7, 11, 15, 21, 23, 31, 32, 36,
+        40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89, 149, 0, 2, 4, 5,
+        6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51,
+        55, 67, 72, 78, 83, 87, 150, 1, 12, 19, 28, 29, 30, 34, 38, 41,
+        43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90, 151,
+        2, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64,
+        65, 69, 76, 80, 82, 86, 152, 0, 3, 7, 11, 15, 21, 23, 31, 32,
+        36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89, 153, 1, 4, 5,
+        6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51,
+        55, 67, 72, 78, 83, 87, 154, 2, 12, 19, 28, 29, 30, 34, 38, 41,
+        43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90, 155,
+        0, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64,
+        65, 69, 76, 80, 82, 86, 156, 1, 3, 7, 11, 15, 21, 23, 31, 32,
+        36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89, 157, 2, 4, 5,
+        6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51,
+        55, 67, 72, 78, 83, 87, 158, 0, 12, 19, 28, 29, 30, 34, 38, 41,
+        43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90, 159,
+        1, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64,
+        65, 69, 76, 80, 82, 86, 160, 2, 3, 7, 11, 15, 21, 23, 31, 32,
+        36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89, 161, 0, 4, 5,
+        6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51,
+        55, 67, 72, 78, 83, 87, 162, 1, 2, 12, 19, 28, 29, 30, 34, 38,
+        41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90,
+        163, 0, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63,
+        64, 65, 69, 76, 80, 82, 86, 164, 1, 3, 7, 11, 15, 21, 23, 31,
+        32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89, 165, 2, 4,
+        5, 6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47,
+        51, 55, 67, 72, 78, 83, 87, 166, 0, 1, 12, 19, 28, 29, 30, 34,
+        38, 41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88,
+        90, 167, 2, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62,
+        63, 64, 65, 69, 76, 80, 82, 86, 168, 0, 3, 7, 11, 15, 21, 23,
+        31, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89, 169, 1,
+        4, 5, 6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45,
+        47, 51, 55, 67, 72, 78, 83, 87, 170, 2, 12, 19, 28, 29, 30, 34,
+        38, 41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88,
+        90, 171, 0, 1, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61,
+        62, 63, 64, 65, 69, 76, 80, 82, 86, 172, 2, 3, 7, 11, 15, 21,
+        23, 31, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89, 173,
+    },
+    .col_start = {
+        0, 31, 62, 92, 115, 137, 159, 182, 205, 228, 251, 274, 297, 319, 341, 364,
+        387, 409, 431, 453, 475, 497, 519, 541, 563, 585, 607, 629, 651, 673, 695, 717,
+        739, 761, 782, 803, 825, 847, 868, 889, 911, 933, 954, 975, 996, 1018, 1039, 1060,
+        1081, 1102, 1123, 1145, 1166, 1187, 1208, 1230, 1251, 1272, 1293, 1314, 1335, 1356, 1377, 1398,
+        1419, 1440, 1461, 1483, 1504, 1525, 1546, 1568, 1590, 1611, 1632, 1653, 1675, 1697, 1719, 1740,
+        1761, 1783, 1805, 1827, 1848, 1869, 1890, 1912, 1933, 1954, 1976, 1997, 1998, 1999, 2000, 2001,
+        2002, 2003, 2004, 2005, 2006, 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017,
+        2018, 2019, 2020, 2021, 2022, 2023, 2024, 2025, 2026, 2027, 2028, 2029, 2030, 2031, 2032, 2033,
+        2034, 2035, 2036, 2037, 2038, 2039, 2040, 2041, 2042, 2043, 2044, 2045, 2046, 2047, 2048, 2049,
+        2050, 2051, 2052, 2053, 2054, 2055, 2056, 2057, 2058, 2059, 2060, 2061, 2062, 2063, 2064, 2065,
+        2066, 2067, 2068, 2069, 2070, 2071, 2072, 2073, 2074, 2075, 2076, 2077, 2078, 2079, 2080,
+    },
+    .col_edge = {
+        0, 35, 132, 214, 242, 327, 421, 493, 564, 634, 708, 781, 852, 922, 996, 1069,
+        1140, 1189, 1262, 1308, 1382, 1455, 1500, 1575, 1648, 1719, 1789, 1841, 1912, 1961, 2034, 1,
+        69, 133, 215, 273, 348, 443, 538, 589, 660, 730, 804, 877, 948, 1018, 1092, 1141,
+        1211, 1263, 1334, 1404, 1478, 1527, 1597, 1671, 1744, 1815, 1864, 1913, 1983, 2035, 2, 70,
+        186, 216, 306, 398, 494, 590, 685, 756, 826, 900, 973, 1044, 1114, 1166, 1237, 1286,
+        1359, 1430, 1501, 1552, 1623, 1693, 1767, 1816, 1886, 1938, 2009, 2058, 3, 71, 187, 243,
+        328, 422, 517, 613, 709, 805, 901, 997, 1093, 1190, 1287, 1383, 1479, 1576, 1672, 1768,
+        1865, 1962, 2059, 4, 72, 188, 244, 349, 444, 539, 635, 731, 827, 923, 1019, 1115,
+        1212, 1309, 1405, 1502, 1598, 1694, 1790, 1887, 1984, 36, 134, 217, 274, 369, 464, 540,
+        636, 732, 828, 924, 1020, 1116, 1213, 1310, 1406, 1503, 1599, 1695, 1791, 1888, 1985, 5,
+        37, 189, 218, 275, 350, 445, 541, 637, 733, 829, 925, 1021, 1117, 1214, 1311, 1407,
+        1504, 1600, 1696, 1792, 1889, 1986, 6, 73, 190, 245, 329, 423, 518, 614, 710, 806,
+        902, 998, 1094, 1191, 1288, 1384, 1480, 1577, 1673, 1769, 1866, 1963, 2060, 38, 74, 191,
+        219, 276, 370, 465, 542, 638, 734, 830, 926, 1022, 1118, 1215, 1312, 1408, 1505, 1601,
+        1697, 1793, 1890, 1987, 39, 75, 135, 246, 307, 399, 495, 591, 686, 782, 878, 974,
+        1070, 1167, 1264, 1360, 1456, 1553, 1649, 1745, 1842, 1939, 2036, 7, 76, 192, 220, 308,
+        400, 496, 592, 687, 783, 879, 975, 1071, 1168, 1265, 1361, 1457, 1554, 1650, 1746, 1843,
+        1940, 2037, 8, 40, 193, 247, 330, 424, 519, 615, 711, 807, 903, 999, 1095, 1192,
+        1289, 1385, 1481, 1578, 1674, 1770, 1867, 1964, 2061, 9, 77, 194, 277, 371, 466, 565,
+        661, 757, 853, 949, 1045, 1142, 1238, 1335, 1431, 1528, 1624, 1720, 1817, 1914, 2010, 41,
+        78, 195, 248, 351, 446, 543, 639, 735, 831, 927, 1023, 1119, 1216, 1313, 1409, 1506,
+        1602, 1698, 1794, 1891, 1988, 42, 79, 196, 221, 309, 401, 497, 593, 688, 784, 880,
+        976, 1072, 1169, 1266, 1362, 1458, 1555, 1651, 1747, 1844, 1941, 2038, 10, 80, 197, 249,
+        331, 425, 520, 616, 712, 808, 904, 1000, 1096, 1193, 1290, 1386, 1482, 1579, 1675, 1771,
+        1868, 1965, 2062, 43, 81, 198, 278, 372, 467, 544, 640, 736, 832, 928, 1024, 1120,
+        1217, 1314, 1410, 1507, 1603, 1699, 1795, 1892, 1989, 11, 82, 199, 250, 352, 447, 545,
+        641, 737, 833, 929, 1025, 1121, 1218, 1315, 1411, 1508, 1604, 1700, 1796, 1893, 1990, 44,
+        83, 200, 279, 373, 468, 546, 642, 738, 834, 930, 1026, 1122, 1219, 1316, 1412, 1509,
+        1605, 1701, 1797, 1894, 1991, 12, 84, 201, 280, 374, 469, 566, 662, 758, 854, 950,
+        1046, 1143, 1239, 1336, 1432, 1529, 1625, 1721, 1818, 1915, 2011, 45, 85, 202, 251, 353,
+        448, 547, 643, 739, 835, 931, 1027, 1123, 1220, 1317, 1413, 1510, 1606, 1702, 1798, 1895,
+        1992, 86, 203, 222, 332, 426, 521, 617, 713, 809, 905, 1001, 1097, 1194, 1291, 1387,
+        1483, 1580, 1676, 1772, 1869, 1966, 2063, 87, 136, 223, 310, 402, 498, 594, 689, 785,
+        881, 977, 1073, 1170, 1267, 1363, 1459, 1556, 1652, 1748, 1845, 1942, 2039, 88, 204, 224,
+        333, 427, 522, 618, 714, 810, 906, 1002, 1098, 1195, 1292, 1388, 1484, 1581, 1677, 1773,
+        1870, 1967, 2064, 13, 89, 205, 252, 354, 449, 548, 644, 740, 836, 932, 1028, 1124,
+        1221, 1318, 1414, 1511, 1607, 1703, 1799, 1896, 1993, 46, 90, 206, 253, 355, 450, 549,
+        645, 741, 837, 933, 1029, 1125, 1222, 1319, 1415, 1512, 1608, 1704, 1800, 1897, 1994, 91,
+        137, 225, 311, 403, 499, 595, 690, 786, 882, 978, 1074, 1171, 1268, 1364, 1460, 1557,
+        1653, 1749, 1846, 1943, 2040, 14, 92, 207, 254, 375, 470, 550, 646, 742, 838, 934,
+        1030, 1126, 1223, 1320, 1416, 1513, 1609, 1705, 1801, 1898, 1995, 47, 93, 208, 281, 376,
+        471, 567, 663, 759, 855, 951, 1047, 1144, 1240, 1337, 1433, 1530, 1626, 1722, 1819, 1916,
+        2012, 15, 94, 209, 282, 377, 472, 568, 664, 760, 856, 952, 1048, 1145, 1241, 1338,
+        1434, 1531, 1627, 1723, 1820, 1917, 2013, 48, 95, 210, 283, 378, 473, 569, 665, 761,
+        857, 953, 1049, 1146, 1242, 1339, 1435, 1532, 1628, 1724, 1821, 1918, 2014, 16, 110, 226,
+        312, 428, 523, 619, 715, 811, 907, 1003, 1099, 1196, 1293, 1389, 1485, 1582, 1678, 1774,
+        1871, 1968, 2065, 49, 111, 255, 334, 429, 524, 620, 716, 812, 908, 1004, 1100, 1197,
+        1294, 1390, 1486, 1583, 1679, 1775, 1872, 1969, 2066, 17, 112, 256, 356, 451, 551, 647,
+        743, 839, 935, 1031, 1127, 1224, 1321, 1417, 1514, 1610, 1706, 1802, 1899, 1996, 50, 113,
+        284, 379, 474, 570, 666, 762, 858, 954, 1050, 1147, 1243, 1340, 1436, 1533, 1629, 1725,
+        1822, 1919, 2015, 96, 114, 227, 313, 404, 500, 596, 691, 787, 883, 979, 1075, 1172,
+        1269, 1365, 1461, 1558, 1654, 1750, 1847, 1944, 2041, 18, 115, 285, 335, 430, 525, 621,
+        717, 813, 909, 1005, 1101, 1198, 1295, 1391, 1487, 1584, 1680, 1776, 1873, 1970, 2067, 51,
+        116, 257, 357, 452, 552, 648, 744, 840, 936, 1032, 1128, 1225, 1322, 1418, 1515, 1611,
+        1707, 1803, 1900, 1997, 97, 117, 286, 380, 475, 571, 667, 763, 859, 955, 1051, 1148,
+        1244, 1341, 1437, 1534, 1630, 1726, 1823, 1920, 2016, 118, 138, 228, 314, 405, 501, 597,
+        692, 788, 884, 980, 1076, 1173, 1270, 1366, 1462, 1559, 1655, 1751, 1848, 1945, 2042, 98,
+        119, 258, 336, 431, 526, 622, 718, 814, 910, 1006, 1102, 1199, 1296, 1392, 1488, 1585,
+        1681, 1777, 1874, 1971, 2068, 120, 139, 229, 381, 476, 572, 668, 764, 860, 956, 1052,
+        1149, 1245, 1342, 1438, 1535, 1631, 1727, 1824, 1921, 2017, 52, 121, 259, 358, 453, 553,
+        649, 745, 841, 937, 1033, 1129, 1226, 1323, 1419, 1516, 1612, 1708, 1804, 1901, 1998, 99,
+        122, 287, 382, 477, 573, 669, 765, 861, 957, 1053, 1150, 1246, 1343, 1439, 1536, 1632,
+        1728, 1825, 1922, 2018, 19, 123, 230, 337, 432, 527, 623, 719, 815, 911, 1007, 1103,
+        1200, 1297, 1393, 1489, 1586, 1682, 1778, 1875, 1972, 2069, 20, 140, 260, 359, 454, 554,
+        650, 746, 842, 938, 1034, 1130, 1227, 1324, 1420, 1517, 1613, 1709, 1805, 1902, 1999, 53,
+        124, 231, 383, 478, 574, 670, 766, 862, 958, 1054, 1151, 1247, 1344, 1440, 1537, 1633,
+        1729, 1826, 1923, 2019, 21, 141, 261, 360, 455, 555, 651, 747, 843, 939, 1035, 1131,
+        1228, 1325, 1421, 1518, 1614, 1710, 1806, 1903, 2000, 54, 142, 288, 384, 479, 575, 671,
+        767, 863, 959, 1055, 1152, 1248, 1345, 1441, 1538, 1634, 1730, 1827, 1924, 2020, 100, 143,
+        289, 385, 480, 576, 672, 768, 864, 960, 1056, 1153, 1249, 1346, 1442, 1539, 1635, 1731,
+        1828, 1925, 2021, 125, 144, 232, 338, 433, 528, 624, 720, 816, 912, 1008, 1104, 1201,
+        1298, 1394, 1490, 1587, 1683, 1779, 1876, 1973, 2070, 22, 145, 262, 361, 456, 556, 652,
+        748, 844, 940, 1036, 1132, 1229, 1326, 1422, 1519, 1615, 1711, 1807, 1904, 2001, 55, 146,
+        290, 386, 481, 577, 673, 769, 865, 961, 1057, 1154, 1250, 1347, 1443, 1540, 1636, 1732,
+        1829, 1926, 2022, 101, 147, 291, 387, 482, 578, 674, 770, 866, 962, 1058, 1155, 1251,
+        1348, 1444, 1541, 1637, 1733, 1830, 1927, 2023, 126, 148, 233, 339, 434, 529, 625, 721,
+        817, 913, 1009, 1105, 1202, 1299, 1395, 1491, 1588, 1684, 1780, 1877, 1974, 2071, 23, 149,
+        263, 362, 457, 557, 653, 749, 845, 941, 1037, 1133, 1230, 1327, 1423, 1520, 1616, 1712,
+        1808, 1905, 2002, 56, 150, 292, 388, 483, 579, 675, 771, 867, 963, 1059, 1156, 1252,
+        1349, 1445, 1542, 1638, 1734, 1831, 1928, 2024, 102, 151, 293, 406, 502, 598, 693, 789,
+        885, 981, 1077, 1174, 1271, 1367, 1463, 1560, 1656, 1752, 1849, 1946, 2043, 24, 152, 294,
+        407, 503, 599, 694, 790, 886, 982, 1078, 1175, 1272, 1368, 1464, 1561, 1657, 1753, 1850,
+        1947, 2044, 57, 153, 295, 408, 504, 600, 695, 791, 887, 983, 1079, 1176, 1273, 1369,
+        1465, 1562, 1658, 1754, 1851, 1948, 2045, 103, 154, 315, 409, 505, 601, 696, 792, 888,
+        984, 1080, 1177, 1274, 1370, 1466, 1563, 1659, 1755, 1852, 1949, 2046, 25, 155, 316, 410,
+        506, 602, 697, 793, 889, 985, 1081, 1178, 1275, 1371, 1467, 1564, 1660, 1756, 1853, 1950,
+        2047, 58, 156, 317, 411, 507, 603, 698, 794, 890, 986, 1082, 1179, 1276, 1372, 1468,
+        1565, 1661, 1757, 1854, 1951, 2048, 26, 157, 318, 412, 508, 604, 699, 795, 891, 987,
+        1083, 1180, 1277, 1373, 1469, 1566, 1662, 1758, 1855, 1952, 2049, 59, 158, 319, 413, 509,
+        605, 700, 796, 892, 988, 1084, 1181, 1278, 1374, 1470, 1567, 1663, 1759, 1856, 1953, 2050,
+        104, 159, 320, 414, 510, 606, 701, 797, 893, 989, 1085, 1182, 1279, 1375, 1471, 1568,
+        1664, 1760, 1857, 1954, 2051, 160, 211, 234, 340, 435, 530, 626, 722, 818, 914, 1010,
+        1106, 1203, 1300, 1396, 1492, 1589, 1685, 1781, 1878, 1975, 2072, 27, 161, 264, 363, 458,
+        558, 654, 750, 846, 942, 1038, 1134, 1231, 1328, 1424, 1521, 1617, 1713, 1809, 1906, 2003,
+        60, 162, 296, 389, 484, 580, 676, 772, 868, 964, 1060, 1157, 1253, 1350, 1446, 1543,
+        1639, 1735, 1832, 1929, 2025, 105, 163, 321, 415, 511, 607, 702, 798, 894, 990, 1086,
+        1183, 1280, 1376, 1472, 1569, 1665, 1761, 1858, 1955, 2052, 127, 164, 265, 341, 436, 531,
+        627, 723, 819, 915, 1011, 1107, 1204, 1301, 1397, 1493, 1590, 1686, 1782, 1879, 1976, 2073,
+        165, 212, 235, 342, 437, 532, 628, 724, 820, 916, 1012, 1108, 1205, 1302, 1398, 1494,
+        1591, 1687, 1783, 1880, 1977, 2074, 61, 166, 297, 364, 459, 559, 655, 751, 847, 943,
+        1039, 1135, 1232, 1329, 1425, 1522, 1618, 1714, 1810, 1907, 2004, 28, 167, 298, 390, 485,
+        581, 677, 773, 869, 965, 1061, 1158, 1254, 1351, 1447, 1544, 1640, 1736, 1833, 1930, 2026,
+        106, 168, 299, 391, 486, 582, 678, 774, 870, 966, 1062, 1159, 1255, 1352, 1448, 1545,
+        1641, 1737, 1834, 1931, 2027, 128, 169, 266, 343, 438, 533, 629, 725, 821, 917, 1013,
+        1109, 1206, 1303, 1399, 1495, 1592, 1688, 1784, 1881, 1978, 2075, 107, 170, 236, 322, 416,
+        512, 608, 703, 799, 895, 991, 1087, 1184, 1281, 1377, 1473, 1570, 1666, 1762, 1859, 1956,
+        2053, 129, 171, 267, 344, 439, 534, 630, 726, 822, 918, 1014, 1110, 1207, 1304, 1400,
+        1496, 1593, 1689, 1785, 1882, 1979, 2076, 62, 172, 300, 365, 460, 560, 656, 752, 848,
+        944, 1040, 1136, 1233, 1330, 1426, 1523, 1619, 1715, 1811, 1908, 2005, 29, 173, 301, 392,
+        487, 583, 679, 775, 871, 967, 1063, 1160, 1256, 1353, 1449, 1546, 1642, 1738, 1835, 1932,
+        2028, 108, 174, 237, 323, 417, 513, 609, 704, 800, 896, 992, 1088, 1185, 1282, 1378,
+        1474, 1571, 1667, 1763, 1860, 1957, 2054, 130, 175, 268, 345, 440, 535, 631, 727, 823,
+        919, 1015, 1111, 1208, 1305, 1401, 1497, 1594, 1690, 1786, 1883, 1980, 2077, 30, 176, 238,
+        324, 418, 514, 610, 705, 801, 897, 993, 1089, 1186, 1283, 1379, 1475, 1572, 1668, 1764,
+        1861, 1958, 2055, 63, 177, 269, 366, 461, 561, 657, 753, 849, 945, 1041, 1137, 1234,
+        1331, 1427, 1524, 1620, 1716, 1812, 1909, 2006, 31, 178, 302, 393, 488, 584, 680, 776,
+        872, 968, 1064, 1161, 1257, 1354, 1450, 1547, 1643, 1739, 1836, 1933, 2029, 64, 179, 303,
+        394, 489, 585, 681, 777, 873, 969, 1065, 1162, 1258, 1355, 1451, 1548, 1644, 1740, 1837,
+        1934, 2030, 32, 180, 239, 325, 419, 515, 611, 706, 802, 898, 994, 1090, 1187, 1284,
+        1380, 1476, 1573, 1669, 1765, 1862, 1959, 2056, 65, 181, 270, 367, 462, 562, 658, 754,
+        850, 946, 1042, 1138, 1235, 1332, 1428, 1525, 1621, 1717, 1813, 1910, 2007, 66, 182, 271,
+        395, 490, 586, 682, 778, 874, 970, 1066, 1163, 1259, 1356, 1452, 1549, 1645, 1741, 1838,
+        1935, 2031, 33, 183, 240, 346, 441, 536, 632, 728, 824, 920, 1016, 1112, 1209, 1306,
+        1402, 1498, 1595, 1691, 1787, 1884, 1981, 2078, 67, 184, 304, 396, 491, 587, 683, 779,
+        875, 971, 1067, 1164, 1260, 1357, 1453, 1550, 1646, 1742, 1839, 1936, 2032, 34, 68, 109,
+        131, 185, 213, 241, 272, 305, 326, 347, 368, 397, 420, 442, 463, 492, 516, 537,
+        563, 588, 612, 633, 659, 684, 707, 729, 755, 780, 803, 825, 851, 876, 899, 921,
+        947, 972, 995, 1017, 1043, 1068, 1091, 1113, 1139, 1165, 1188, 1210, 1236, 1261, 1285, 1307,
+        1333, 1358, 1381, 1403, 1429, 1454, 1477, 1499, 1526, 1551, 1574, 1596, 1622, 1647, 1670, 1692,
+        1718, 1743, 1766, 1788, 1814, 1840, 1863, 1885, 1911, 1937, 1960, 1982, 2008, 2033, 2057, 2079,
+    },
+};
+
+static const ft8_ldpc_code_t JS8_LDPC_CODE = {
+    .n_edges = 356,
+    .row_start = {
+        0, 5, 10, 15, 20, 25, 30, 35, 40, 44, 49, 53, 57, 61, 66, 70,
+        74, 78, 82, 86, 90, 96, 100, 104, 108, 112, 116, 120, 125, 129, 133, 137,
+        142, 146, 150, 155, 159, 163, 168, 172, 176, 180, 185, 189, 193, 197, 201, 205,
+        209, 215, 219, 223, 227, 231, 235, 238, 244, 248, 252, 256, 261, 265, 269, 274,
+        278, 282, 286, 290, 293, 298, 302, 307, 310, 315, 319, 323, 327, 331, 335, 339,
+        343, 347, 352, 356,
+    },
+    .edge_col = {
+        0, 10, 57, 83, 91, 1, 22, 42, 84, 92, 2, 27, 34, 85, 93, 3,
+        12, 46, 86, 94, 4, 58, 80, 87, 95, 5, 65, 70, 88, 96, 6, 50,
+        82, 89, 97, 7, 11, 35, 90, 98, 8, 20, 23, 99, 5, 9, 35, 88,
+        100, 10, 47, 73, 101, 11, 58, 59, 102, 12, 43, 71, 103, 0, 13, 28,
+        83, 104, 12, 13, 14, 105, 15, 24, 81, 106, 16, 36, 66, 107, 17, 48,
+        51, 108, 18, 36, 60, 109, 19, 21, 72, 110, 1, 6, 20, 84, 89, 111,
+        13, 21, 74, 112, 22, 25, 59, 113, 23, 37, 44, 114, 24, 29, 49, 115,
+        14, 25, 61, 116, 26, 73, 82, 117, 2, 27, 67, 85, 118, 14, 28, 52,
+        119, 26, 29, 37, 120, 22, 30, 38, 121, 7, 31, 50, 90, 122, 32, 62,
+        75, 123, 33, 60, 74, 124, 3, 34, 45, 86, 125, 15, 30, 35, 126, 15,
+        27, 36, 127, 0, 37, 39, 83, 128, 38, 51, 68, 129, 39, 53, 63, 130,
+        38, 40, 75, 131, 4, 23, 41, 87, 132, 8, 16, 42, 133, 28, 43, 76,
+        134, 40, 44, 61, 135, 45, 46, 52, 136, 31, 46, 64, 137, 16, 47, 76,
+        138, 1, 5, 48, 84, 88, 139, 17, 49, 69, 140, 29, 50, 54, 141, 39,
+        41, 51, 142, 24, 52, 53, 143, 9, 53, 65, 144, 54, 77, 145, 6, 55,
+        62, 77, 89, 146, 18, 47, 56, 147, 30, 32, 57, 148, 17, 42, 58, 149,
+        2, 54, 59, 85, 150, 60, 66, 70, 151, 55, 61, 78, 152, 7, 40, 62,
+        90, 153, 19, 25, 63, 154, 10, 31, 64, 155, 43, 65, 78, 156, 55, 63,
+        66, 157, 48, 67, 158, 33, 67, 68, 79, 159, 8, 18, 69, 160, 3, 20,
+        70, 86, 161, 32, 71, 162, 44, 56, 71, 72, 163, 41, 56, 73, 164, 26,
+        68, 74, 165, 11, 75, 80, 166, 9, 76, 79, 167, 21, 64, 77, 168, 33,
+        49, 78, 169, 34, 45, 79, 170, 19, 57, 80, 171, 4, 69, 81, 87, 172,
+        72, 81, 82, 173,
+    },
+    .col_start = {
+        0, 3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 33, 36, 39, 42, 45,
+        48, 51, 54, 57, 60, 63, 66, 69, 72, 75, 78, 81, 84, 87, 90, 93,
+        96, 99, 102, 105, 108, 111, 114, 117, 120, 123, 126, 129, 132, 135, 138, 141,
+        144, 147, 150, 153, 156, 159, 162, 165, 168, 171, 174, 177, 180, 183, 186, 189,
+        192, 195, 198, 201, 204, 207, 210, 213, 216, 219, 222, 225, 228, 231, 234, 237,
+        240, 243, 246, 249, 252, 255, 258, 261, 264, 267, 270, 273, 274, 275, 276, 277,
+        278, 279, 280, 281, 282, 283, 284, 285, 286, 287, 288, 289, 290, 291, 292, 293,
+        294, 295, 296, 297, 298, 299, 300, 301, 302, 303, 304, 305, 306, 307, 308, 309,
+        310, 311, 312, 313, 314, 315, 316, 317, 318, 319, 320, 321, 322, 323, 324, 325,
+        326, 327, 328, 329, 330, 331, 332, 333, 334, 335, 336, 337, 338, 339, 340, 341,
+        342, 343, 344, 345, 346, 347, 348, 349, 350, 351, 352, 353, 354, 355, 356,
+    },
+    .col_edge = {
+        0, 61, 163, 5, 90, 209, 10, 120, 256, 15, 150, 302, 20, 180, 347, 25,
+        44, 210, 30, 91, 238, 35, 137, 269, 40, 185, 298, 45, 231, 327, 1, 49,
+        278, 36, 53, 323, 16, 57, 66, 62, 67, 96, 68, 112, 125, 70, 155, 159,
+        74, 186, 205, 78, 215, 252, 82, 244, 299, 86, 274, 343, 41, 92, 303, 87,
+        97, 331, 6, 100, 133, 42, 104, 181, 71, 108, 227, 101, 113, 275, 116, 129,
+        319, 11, 121, 160, 63, 126, 189, 109, 130, 219, 134, 156, 248, 138, 201, 279,
+        142, 249, 307, 146, 293, 335, 12, 151, 339, 37, 46, 157, 75, 83, 161, 105,
+        131, 164, 135, 168, 176, 165, 172, 223, 177, 193, 270, 182, 224, 315, 7, 187,
+        253, 58, 190, 282, 106, 194, 310, 152, 197, 340, 17, 198, 202, 50, 206, 245,
+        79, 211, 290, 110, 216, 336, 31, 139, 220, 80, 169, 225, 127, 199, 228, 173,
+        229, 232, 221, 235, 257, 239, 265, 286, 246, 311, 316, 2, 250, 344, 21, 54,
+        254, 55, 102, 258, 84, 147, 261, 114, 195, 266, 143, 240, 271, 174, 276, 287,
+        203, 280, 332, 26, 233, 283, 76, 262, 288, 122, 291, 294, 170, 295, 320, 217,
+        300, 348, 27, 263, 304, 59, 308, 312, 88, 313, 352, 51, 117, 317, 98, 148,
+        321, 144, 178, 324, 191, 207, 328, 236, 241, 333, 267, 284, 337, 296, 329, 341,
+        22, 325, 345, 72, 349, 353, 32, 118, 354, 3, 64, 166, 8, 93, 212, 13,
+        123, 259, 18, 153, 305, 23, 183, 350, 28, 47, 213, 33, 94, 242, 38, 140,
+        272, 4, 9, 14, 19, 24, 29, 34, 39, 43, 48, 52, 56, 60, 65, 69,
+        73, 77, 81, 85, 89, 95, 99, 103, 107, 111, 115, 119, 124, 128, 132, 136,
+        141, 145, 149, 154, 158, 162, 167, 171, 175, 179, 184, 188, 192, 196, 200, 204,
+        208, 214, 218, 222, 226, 230, 234, 237, 243, 247, 251, 255, 260, 264, 268, 273,
+        277, 281, 285, 289, 292, 297, 301, 306, 309, 314, 318, 322, 326, 330, 334, 338,
+        342, 346, 351, 355,
+    },
+};
+
+#endif /* FT8_LDPC_TABLES_H */
@@ -0,0 +1,196 @@
+/**
+ * ft8_osd.c — Ordered-statistics decoding on bit-set generator rows
+ */
+
+#include "ft8_osd.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * A CRC-valid winner may carry at most this much more discrepancy than
+ * the best candidate overall. Past it the CRC has merely been matched by
+ * chance among thousands of tries, which on this code's short distance
+ * is a wrong message close to the right one.
+ */
+#define OSD_CRC_MARGIN  1.2f
+
+#define OSD_PAYLOAD_BITS  (FT8_LDPC_K - FT8_CRC_BITS)   /* 77 */
+
+#define BIT_SET(v, i)   ((v)[(i) >> 6] |= 1ull << ((i) & 63))
+#define BIT_TEST(v, i)  (((v)[(i) >> 6] >> ((i) & 63)) & 1)
+
+void ft8_osd_init(ft8_osd_t *osd, const ft8_ldpc_code_t *code)
+{
+    memset(osd, 0, sizeof(*osd));
+
+    /* Systematic: message bit k is codeword bit k */
+    for (int k = 0; k < FT8_LDPC_K; k++) BIT_SET(osd->gen_col[k], k);
+
+    /* Parity bit K + m is the sum of the message bits check m covers */
+    for (int m = 0; m < FT8_LDPC_M; m++) {
+        for (int e = code->row_start[m]; e < code->row_start[m + 1]; e++) {
+            int col = code->edge_col[e];
+            if (col < FT8_LDPC_K) BIT_SET(osd->gen_col[FT8_LDPC_K + m], col);
+        }
+    }
+
+    /* CRC check = recomputed CRC ^ received CRC, linear in every bit */
+    uint8_t unit[FT8_LDPC_K];
+    for (int k = 0; k < FT8_LDPC_K; k++) {
+        if (k < OSD_PAYLOAD_BITS) {
+            memset(unit, 0, sizeof(unit));
+            unit[k] = 1;
+            osd->crc_syn[k] = ft8_crc_compute(unit, OSD_PAYLOAD_BITS);
+        } else {
+            osd->crc_syn[k] = (uint16_t)(1u << (FT8_LDPC_K - 1 - k));
+        }
+    }
+}
+
+typedef struct {
+    float   rel;
+    uint8_t bit;
+} osd_order_t;
+
+static int cmp_order(const void *a, const void *b)
+{
+    float ra = ((const osd_order_t *)a)->rel;
+    float rb = ((const osd_order_t *)b)->rel;
+    return (ra < rb) - (ra > rb);
+}
+
+/* Permute generator columns by reliability, then reduce onto the MRB */
+static void reduce(ft8_osd_t *osd, const float *llr)
+{
+    osd_order_t order[FT8_LDPC_N];
+    for (int i = 0; i < FT8_LDPC_N; i++) {
+        order[i].rel = fabsf(llr[i]);
+        order[i].bit = (uint8_t)i;
+    }
+    qsort(order, FT8_LDPC_N, sizeof(osd_order_t), cmp_order);
+
+    memset(osd->row, 0, sizeof(osd->row));
+    memset(osd->hard, 0, sizeof(osd->hard));
+    for (int p = 0; p < FT8_LDPC_N; p++) {
+        int bit = order[p].bit;
+        osd->perm[p] = (uint8_t)bit;
+        osd->rel[p] = order[p].rel;
+        if (llr[bit] < 0.0f) BIT_SET(osd->hard, p);
+        for (int k = 0; k < FT8_LDPC_K; k++) {
+            if (BIT_TEST(osd->gen_col[bit], k)) BIT_SET(osd->row[k], p);
+        }
+    }
+
+    /* Gauss-Jordan, taking pivots in reliability order */
+    int rank = 0;
+    for (int p = 0; p < FT8_LDPC_N && rank < FT8_LDPC_K; p++) {
+        int r = rank;
+        while (r < FT8_LDPC_K && !BIT_TEST(osd->row[r], p)) r++;
+        if (r == FT8_LDPC_K) continue;
+
+        if (r != rank) {
+            for (int w = 0; w < FT8_OSD_WORDS; w++) {
+                uint64_t t = osd->row[r][w];
+                osd->row[r][w] = osd->row[rank][w];
+                osd->row[rank][w] = t;
+            }
+        }
+        for (int k = 0; k < FT8_LDPC_K; k++) {
+            if (k == rank || !BIT_TEST(osd->row[k], p)) continue;
+            for (int w = 0; w < FT8_OSD_WORDS; w++) osd->row[k][w] ^= osd->row[rank][w];
+        }
+        osd->pivot[rank++] = (uint8_t)p;
+    }
+
+    for (int k = 0; k < FT8_LDPC_K; k++) {
+        uint16_t syn = 0;
+        for (int p = 0; p < FT8_LDPC_N; p++) {
+            int bit = osd->perm[p];
+            if (bit < FT8_LDPC_K && BIT_TEST(osd->row[k], p)) syn ^= osd->crc_syn[bit];
+        }
+        osd->row_syn[k] = syn;
+    }
+}
+
+/* Total reliability of the set bits of e, or `limit` once it is reached */
+static float discrepancy(const float *rel, const uint64_t *e, float limit)
+{
+    float sum = 0.0f;
+    for (int w = 0; w < FT8_OSD_WORDS; w++) {
+        uint64_t v = e[w];
+        while (v) {
+            sum += rel[(w << 6) + __builtin_ctzll(v)];
+            if (sum >= limit) return limit;
+            v &= v - 1;
+        }
+    }
+    return sum;
+}
+
+int ft8_osd_decode(ft8_osd_t *osd, const float *llr, int depth,
+                   uint8_t *message)
+{
+    if (depth < 0 || depth > FT8_OSD_MAX_DEPTH) return -1;
+
+    reduce(osd, llr);
+
+    /* OSD-0: re-encode the MRB hard decisions */
+    uint64_t e0[FT8_OSD_WORDS];
+    uint16_t syn0 = 0;
+    memcpy(e0, osd->hard, sizeof(e0));
+    for (int k = 0; k < FT8_LDPC_K; k++) {
+        if (BIT_TEST(osd->hard, osd->pivot[k])) {
+            for (int w = 0; w < FT8_OSD_WORDS; w++) e0[w] ^= osd->row[k][w];
+            syn0 ^= osd->row_syn[k];
+        }
+    }
+
+    /*
+     * e = codeword ^ hard decisions; each flip XORs in one more row, and
+     * its syndrome into the codeword's. `any` tracks the best candidate
+     * overall, `best` the best CRC-valid one.
+     */
+    float any = discrepancy(osd->rel, e0, INFINITY);
+    float best = syn0 == 0 ? any : INFINITY;
+    int best_i = -1, best_j = -1;
+
+    for (int i = 0; depth >= 1 && i < FT8_LDPC_K; i++) {
+        uint64_t e1[FT8_OSD_WORDS];
+        uint16_t syn1 = syn0 ^ osd->row_syn[i];
+        for (int w = 0; w < FT8_OSD_WORDS; w++) e1[w] = e0[w] ^ osd->row[i][w];
+
+        float d = discrepancy(osd->rel, e1, syn1 == 0 ? fmaxf(any, best) : any);
+        if (d < any) any = d;
+        if (syn1 == 0 && d < best) { best = d; best_i = i; best_j = -1; }
+
+        for (int j = i + 1; depth >= 2 && j < FT8_LDPC_K; j++) {
+            uint16_t syn2 = syn1 ^ osd->row_syn[j];
+            uint64_t e2[FT8_OSD_WORDS];
+            for (int w = 0; w < FT8_OSD_WORDS; w++) e2[w] = e1[w] ^ osd->row[j][w];
+
+            d = discrepancy(osd->rel, e2, syn2 == 0 ? fmaxf(any, best) : any);
+            if (d < any) any = d;
+            if (syn2 == 0 && d < best) { best = d; best_i = i; best_j = j; }
+        }
+    }
+    if (best > any * OSD_CRC_MARGIN) return -1;   /* Also: none passed */
+
+    uint64_t e[FT8_OSD_WORDS];
+    for (int w = 0; w < FT8_OSD_WORDS; w++) {
+        e[w] = e0[w];
+        if (best_i >= 0) e[w] ^= osd->row[best_i][w];
+        if (best_j >= 0) e[w] ^= osd->row[best_j][w];
+    }
+
+    /* Back to natural order; message bits are codeword bits 0 .. K-1 */
+    int errors = 0;
+    for (int p = 0; p < FT8_LDPC_N; p++) {
+        int flip = (int)BIT_TEST(e, p);
+        int bit = osd->perm[p];
+        errors += flip;
+        if (bit < FT8_LDPC_K) message[bit] = (uint8_t)(BIT_TEST(osd->hard, p) ^ flip);
+    }
+    return errors;
+}
@@ -0,0 +1,69 @@
+/**
+ * ft8_osd.h — Ordered-statistics decoding for LDPC(174,91)
+ *
+ * Fallback for candidates belief propagation gives up on, or settles on
+ * a codeword that fails the CRC (the app's FT8 table has low-weight
+ * codewords, so BP does that often). The 174 channel LLRs are sorted by
+ * magnitude, the generator matrix is reduced over the 91 most reliable
+ * independent positions (the MRB), and the codeword re-encoded from the
+ * MRB hard decisions is compared against those with one (OSD-1) or two
+ * (OSD-2) MRB bits flipped. Of the candidates whose CRC-14 checks, the
+ * one whose disagreements with the channel carry the least total |LLR|
+ * wins, provided that total is within a small margin of the best
+ * candidate's overall.
+ *
+ * Generator columns and each bit's CRC syndrome are built once in
+ * ft8_osd_init(); each decode only permutes and eliminates them. Rows are
+ * 174-bit sets in three words and the CRC is linear, so each of OSD-2's
+ * 4095 candidates costs a few XORs plus the discrepancy sum.
+ */
+
+#ifndef FT8_OSD_H
+#define FT8_OSD_H
+
+#include "ft8_crc.h"
+#include "ft8_ldpc.h"
+
+#include <stdint.h>
+
+#define FT8_OSD_WORDS     3     /* 64-bit words per 174-bit row */
+#define FT8_OSD_MAX_DEPTH 2
+
+typedef struct {
+    /* Generator columns: message bits each codeword bit depends on */
+    uint64_t gen_col[FT8_LDPC_N][2];
+    /* CRC-14 syndrome of each message bit (payload bits, then the CRC) */
+    uint16_t crc_syn[FT8_LDPC_K];
+
+    /* Per-decode scratch */
+    uint8_t  perm[FT8_LDPC_N];                  /* Sorted position → bit */
+    float    rel[FT8_LDPC_N];                   /* |LLR| in sorted order */
+    uint64_t row[FT8_LDPC_K][FT8_OSD_WORDS];    /* Reduced generator */
+    uint8_t  pivot[FT8_LDPC_K];                 /* MRB position of each row */
+    uint16_t row_syn[FT8_LDPC_K];               /* CRC syndrome of each row */
+    uint64_t hard[FT8_OSD_WORDS];
+} ft8_osd_t;
+
+/**
+ * Precompute the generator columns of a code (ft8_ldpc_ft8() /
+ * ft8_ldpc_js8()).
+ */
+void ft8_osd_init(ft8_osd_t *osd, const ft8_ldpc_code_t *code);
+
+/**
+ * Most likely CRC-valid codeword within `depth` MRB flips (0, 1 or 2).
+ * The CRC is FT8's: 14 bits over the first 77 message bits.
+ *
+ * @param osd      From ft8_osd_init()
+ * @param llr      174 channel LLRs, positive = bit more likely 0
+ * @param depth    Flips tried; 2 costs about 4000 candidate codewords
+ * @param message  Out: the winning codeword's 91 message bits
+ * @return Bits where the winner disagrees with the channel hard
+ *         decisions (the caller's confidence check), or -1 if no
+ *         candidate passed the CRC close enough to the best overall, or
+ *         depth is out of range
+ */
+int ft8_osd_decode(ft8_osd_t *osd, const float *llr, int depth,
+                   uint8_t *message);
+
+#endif /* FT8_OSD_H */
@@ -0,0 +1,48 @@
+/**
+ * ft8_pool.c — Worker pool on the shared task scheduler
+ */
+
+#include "ft8_pool.h"
+#include "task_sched.h"
+
+#include <stdlib.h>
+
+struct ft8_pool_t {
+    int n;                    /* Workers, the caller included */
+    task_sched_t *sched;      /* Shared; NULL runs every worker inline */
+};
+
+int ft8_pool_default_size(void)
+{
+    return task_sched_cores();
+}
+
+ft8_pool_t *ft8_pool_create(int n)
+{
+    if (n < 1) return NULL;
+
+    ft8_pool_t *p = (ft8_pool_t *)calloc(1, sizeof(ft8_pool_t));
+    if (!p) return NULL;
+    p->n = n;
+    p->sched = n > 1 ? task_sched_shared() : NULL;
+    return p;
+}
+
+int ft8_pool_size(const ft8_pool_t *p)
+{
+    return p ? p->n : 1;
+}
+
+void ft8_pool_run(ft8_pool_t *p, ft8_pool_fn fn, void *ctx)
+{
+    if (!p) {
+        fn(ctx, 0);
+        return;
+    }
+    task_sched_parallel(p->sched, TASK_PRIO_SLOT, p->n, fn, ctx);
+}
+
+void ft8_pool_destroy(ft8_pool_t *p)
+{
+    free(p);
+}
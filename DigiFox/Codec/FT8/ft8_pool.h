@@ -0,0 +1,49 @@
+/**
+ * ft8_pool.h — Workers for the FT8 per-candidate stage
+ *
+ * ft8_pool_run() runs the same function once per worker (the calling
+ * thread is worker 0) and returns once all have finished. The function
+ * splits its work itself, typically by claiming items from a shared
+ * atomic counter until none are left, so a worker stuck on a slow item
+ * never holds up the rest.
+ *
+ * The workers are tasks on the shared scheduler (task_sched.h) at slot
+ * priority, so the FT8, JS8 and WSPR decoders share one set of threads
+ * with each other and with live CW instead of each starting its own. A
+ * run starts no threads and allocates nothing; worker numbers stay
+ * distinct within a run, so per-worker scratch needs no locking, but
+ * fewer of them may run at once than the pool has.
+ */
+
+#ifndef FT8_POOL_H
+#define FT8_POOL_H
+
+typedef struct ft8_pool_t ft8_pool_t;
+
+/* Runs once per worker; worker is 0 .. ft8_pool_size() - 1 */
+typedef void (*ft8_pool_fn)(void *ctx, int worker);
+
+/**
+ * Performance cores on this machine (Apple: hw.perflevel0, else all
+ * online CPUs), at least 1.
+ */
+int ft8_pool_default_size(void);
+
+/**
+ * Create a pool of n workers, starting the shared scheduler if this is
+ * its first user.
+ *
+ * @return Pool, or NULL on failure (n < 1)
+ */
+ft8_pool_t *ft8_pool_create(int n);
+
+int ft8_pool_size(const ft8_pool_t *p);
+
+/**
+ * Run fn(ctx, worker) on every worker and wait for all of them.
+ */
+void ft8_pool_run(ft8_pool_t *p, ft8_pool_fn fn, void *ctx);
+
+void ft8_pool_destroy(ft8_pool_t *p);
+
+#endif /* FT8_POOL_H */
@@ -0,0 +1,53 @@
+/**
+ * ft8_softbits.c — Gathered, symbol-parallel M-FSK LLRs
+ */
+
+#include "ft8_softbits.h"
+
+#include <math.h>
+#include <string.h>
+
+const int ft8_softbits_gray[FT8_SOFTBITS_TONES]    = { 0, 1, 3, 2, 7, 6, 4, 5 };
+const int ft8_softbits_natural[FT8_SOFTBITS_TONES] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+const int ft8_softbits_gray4[4]                    = { 0, 1, 3, 2 };
+
+void ft8_softbits_extract(const float *grid, int n_bins, int row, int bin,
+                          const int *data_pos, int n_data, int n_sym,
+                          int n_tones, const int *tone_bits, float *llr)
+{
+    const int per_sym = n_tones == FT8_SOFTBITS_TONES ? FT8_SOFTBITS_PER_SYM : 2;
+    float tone[FT8_SOFTBITS_TONES][FT8_SOFTBITS_MAX_DATA];
+    float sum0[FT8_SOFTBITS_MAX_DATA];
+    float sum1[FT8_SOFTBITS_MAX_DATA];
+
+    if (n_data > FT8_SOFTBITS_MAX_DATA) n_data = FT8_SOFTBITS_MAX_DATA;
+
+    /* Received data symbols: a prefix, data_pos ascending */
+    int n = 0;
+    while (n < n_data && data_pos[n] < n_sym) n++;
+
+    for (int d = 0; d < n; d++) {
+        const float *p = grid + (long)(row + data_pos[d]) * n_bins + bin;
+        for (int t = 0; t < n_tones; t++) tone[t][d] = p[t];
+    }
+
+    for (int b = 0; b < per_sym; b++) {
+        const int shift = per_sym - 1 - b;
+
+        for (int d = 0; d < n; d++) {
+            sum0[d] = 1e-10f;
+            sum1[d] = 1e-10f;
+        }
+        /* Tones in order, the same sums as a per-symbol loop */
+        for (int t = 0; t < n_tones; t++) {
+            const float *row_t = tone[t];
+            float *sum = (tone_bits[t] >> shift) & 1 ? sum1 : sum0;
+            for (int d = 0; d < n; d++) sum[d] += row_t[d];
+        }
+        for (int d = 0; d < n; d++) {
+            llr[d * per_sym + b] = logf(sum0[d] / sum1[d]);
+        }
+    }
+
+    memset(llr + n * per_sym, 0, (size_t)(n_data - n) * per_sym * sizeof(float));
+}
@@ -0,0 +1,50 @@
+/**
+ * ft8_softbits.h — Soft bits of an M-FSK frame from a power waterfall
+ *
+ * One kernel for FT8, JS8 (8 tones) and FT4 (4): the tone powers of
+ * every data symbol of a candidate are gathered from its grid into
+ * per-tone rows (one strided pass), then each bit's two power sums run
+ * down the rows for all symbols at once, which vectorizes. The LLR of a
+ * bit is the log-sum metric the decoders have always used, log(sum of
+ * powers of the tones sending 0 / sum sending 1), taken as one log of
+ * the ratio; only the tone → bits map differs (Gray for FT8 and FT4, the
+ * tone number for JS8).
+ *
+ * The waterfall keeps power only, so multi-symbol coherent metrics
+ * (WSJT-X nsym 2/3) would need complex spectra it does not have.
+ *
+ * No allocation: the gather rows live on the stack.
+ */
+
+#ifndef FT8_SOFTBITS_H
+#define FT8_SOFTBITS_H
+
+#define FT8_SOFTBITS_TONES     8    /* Most tones */
+#define FT8_SOFTBITS_PER_SYM   3    /* Bits per symbol of 8 tones */
+#define FT8_SOFTBITS_MAX_DATA  96   /* Data symbols per frame (FT8/JS8: 58, FT4: 87) */
+
+/* Bits each tone sends, first bit highest */
+extern const int ft8_softbits_gray[FT8_SOFTBITS_TONES];     /* FT8 */
+extern const int ft8_softbits_natural[FT8_SOFTBITS_TONES];  /* JS8 */
+extern const int ft8_softbits_gray4[4];                     /* FT4 */
+
+/**
+ * LLRs of one candidate's data symbols.
+ *
+ * @param grid       Row 0, bin 0 of the candidate's waterfall grid
+ * @param n_bins     Bins per grid row
+ * @param row        Frame start row
+ * @param bin        Base (tone 0) bin
+ * @param data_pos   Frame position of each data symbol, ascending
+ * @param n_data     Data symbols (<= FT8_SOFTBITS_MAX_DATA)
+ * @param n_sym      Frame symbols in the grid so far; data symbols at or
+ *                   past it are erasures (LLR 0)
+ * @param n_tones    8 (3 bits per symbol) or 4 (2 bits)
+ * @param tone_bits  n_tones entries: ft8_softbits_gray, _natural or _gray4
+ * @param llr        Out: n_data * bits per symbol, symbol by symbol
+ */
+void ft8_softbits_extract(const float *grid, int n_bins, int row, int bin,
+                          const int *data_pos, int n_data, int n_sym,
+                          int n_tones, const int *tone_bits, float *llr);
+
+#endif /* FT8_SOFTBITS_H */
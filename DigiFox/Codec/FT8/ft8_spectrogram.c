@@ -0,0 +1,183 @@
+/**
+ * ft8_spectrogram.c — Hann-windowed, zero-padded mixed-radix FFT power spectra
+ */
+
+#include "ft8_spectrogram.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define FT8_FFT_MAX_RADIX  5
+
+/* ------------------------------------------------------------------ */
+/* Mixed-radix Stockham FFT                                            */
+/* ------------------------------------------------------------------ */
+
+/* Radix 4 first (fewest stages), then 2, 3, 5 */
+static int factorize(int n, int *factors)
+{
+    static const int radices[] = { 4, 2, 3, 5 };
+    int count = 0;
+
+    for (int i = 0; i < 4; i++) {
+        while (n % radices[i] == 0) {
+            if (count == FT8_FFT_MAX_FACTORS) return -1;
+            factors[count++] = radices[i];
+            n /= radices[i];
+        }
+    }
+    return n == 1 ? count : -1;
+}
+
+/*
+ * Forward DFT of re/im in place. Each stage of radix r splits a length
+ * len = r·m sub-transform (stride s, s·len = n) into r of length m:
+ *
+ *   y[q + s(r p + u)] = W_len^{u p} · sum_k x[q + s(p + k m)] · W_r^{u k}
+ *
+ * Outputs land in natural order (autosort); W_len^{u p} = W_n^{u p s}.
+ */
+static void fft_forward(ft8_spectrogram_t *s)
+{
+    const int n = s->n_fft;
+    float *x_re = s->re, *x_im = s->im;
+    float *y_re = s->tmp_re, *y_im = s->tmp_im;
+    int len = n, stride = 1;
+
+    for (int f = 0; f < s->n_factors; f++) {
+        const int r = s->factors[f];
+        const int m = len / r;
+        const int tw_r = n / r;   /* W_r^k = W_n^{k n / r} */
+
+        for (int p = 0; p < m; p++) {
+            for (int q = 0; q < stride; q++) {
+                float a_re[FT8_FFT_MAX_RADIX], a_im[FT8_FFT_MAX_RADIX];
+                for (int k = 0; k < r; k++) {
+                    a_re[k] = x_re[q + stride * (p + k * m)];
+                    a_im[k] = x_im[q + stride * (p + k * m)];
+                }
+
+                for (int u = 0; u < r; u++) {
+                    float b_re = a_re[0], b_im = a_im[0];
+                    for (int k = 1; k < r; k++) {
+                        int t = ((u * k) % r) * tw_r;
+                        b_re += a_re[k] * s->tw_re[t] - a_im[k] * s->tw_im[t];
+                        b_im += a_re[k] * s->tw_im[t] + a_im[k] * s->tw_re[t];
+                    }
+
+                    int t = u * p * stride;
+                    int o = q + stride * (r * p + u);
+                    y_re[o] = b_re * s->tw_re[t] - b_im * s->tw_im[t];
+                    y_im[o] = b_re * s->tw_im[t] + b_im * s->tw_re[t];
+                }
+            }
+        }
+
+        float *t_re = x_re, *t_im = x_im;
+        x_re = y_re; x_im = y_im;
+        y_re = t_re; y_im = t_im;
+        len = m;
+        stride *= r;
+    }
+
+    if (x_re != s->re) {
+        memcpy(s->re, x_re, (size_t)n * sizeof(float));
+        memcpy(s->im, x_im, (size_t)n * sizeof(float));
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Init / free                                                         */
+/* ------------------------------------------------------------------ */
+
+int ft8_spectrogram_init(ft8_spectrogram_t *s, int n_window, int n_fft, int n_bins)
+{
+    memset(s, 0, sizeof(*s));
+    if (n_window < 2 || n_fft < n_window || n_bins < 1 || n_bins > n_fft / 2) return -1;
+
+    s->n_factors = factorize(n_fft, s->factors);
+    if (s->n_factors < 0) return -1;
+
+    s->n_window = n_window;
+    s->n_fft = n_fft;
+    s->n_bins = n_bins;
+
+    s->window = (float *)calloc((size_t)n_window, sizeof(float));
+    s->tw_re  = (float *)calloc((size_t)n_fft, sizeof(float));
+    s->tw_im  = (float *)calloc((size_t)n_fft, sizeof(float));
+    s->re     = (float *)calloc((size_t)n_fft, sizeof(float));
+    s->im     = (float *)calloc((size_t)n_fft, sizeof(float));
+    s->tmp_re = (float *)calloc((size_t)n_fft, sizeof(float));
+    s->tmp_im = (float *)calloc((size_t)n_fft, sizeof(float));
+    if (!s->window || !s->tw_re || !s->tw_im || !s->re || !s->im ||
+        !s->tmp_re || !s->tmp_im) {
+        ft8_spectrogram_free(s);
+        return -1;
+    }
+
+    for (int k = 0; k < n_fft; k++) {
+        s->tw_re[k] = (float)cos(2.0 * M_PI * k / n_fft);
+        s->tw_im[k] = (float)-sin(2.0 * M_PI * k / n_fft);
+    }
+    for (int k = 0; k < n_window; k++) {
+        s->window[k] = (float)(0.5 - 0.5 * cos(2.0 * M_PI * k / n_window));
+    }
+    return 0;
+}
+
+void ft8_spectrogram_free(ft8_spectrogram_t *s)
+{
+    free(s->window);
+    free(s->tw_re);
+    free(s->tw_im);
+    free(s->re);
+    free(s->im);
+    free(s->tmp_re);
+    free(s->tmp_im);
+    memset(s, 0, sizeof(*s));
+}
+
+/* ------------------------------------------------------------------ */
+/* Power spectra                                                       */
+/* ------------------------------------------------------------------ */
+
+void ft8_spectrogram_pair(ft8_spectrogram_t *s, const float *x0, const float *x1,
+                          float *p0, float *p1)
+{
+    const int n = s->n_fft;
+
+    for (int k = 0; k < s->n_window; k++) {
+        s->re[k] = x0[k] * s->window[k];
+        s->im[k] = x1 ? x1[k] * s->window[k] : 0.0f;
+    }
+    memset(s->re + s->n_window, 0, (size_t)(n - s->n_window) * sizeof(float));
+    memset(s->im + s->n_window, 0, (size_t)(n - s->n_window) * sizeof(float));
+
+    fft_forward(s);
+
+    if (!x1) {
+        for (int k = 0; k < s->n_bins; k++) {
+            p0[k] = s->re[k] * s->re[k] + s->im[k] * s->im[k] + 1e-10f;
+        }
+        return;
+    }
+
+    /*
+     * Z = X0 + j X1 with X0, X1 Hermitian:
+     *   X0[k] = (Z[k] + conj Z[n-k]) / 2,  X1[k] = (Z[k] - conj Z[n-k]) / 2j
+     */
+    for (int k = 0; k < s->n_bins; k++) {
+        int m = k ? n - k : 0;
+        float zr = s->re[k], zi = s->im[k];
+        float yr = s->re[m], yi = s->im[m];
+        float ar = zr + yr, ai = zi - yi;
+        float br = zi + yi, bi = zr - yr;
+        p0[k] = 0.25f * (ar * ar + ai * ai) + 1e-10f;
+        p1[k] = 0.25f * (br * br + bi * bi) + 1e-10f;
+    }
+}
@@ -0,0 +1,62 @@
+/**
+ * ft8_spectrogram.h — Windowed power spectra for the FT8 waterfall
+ *
+ * Hann-windowed, zero-padded DFTs: a window of n_window samples (one
+ * symbol, 1920 at 12 kHz) padded to n_fft = 2 · n_window, so the bins
+ * fall every 3.125 Hz, half the tone spacing. Even bins are exactly the
+ * unpadded transform. The lengths are not powers of two, so the
+ * transform is a mixed-radix (2, 3, 4, 5) Stockham FFT.
+ *
+ * Audio is real, so windows go through the complex FFT two at a time
+ * (one as the real part, one as the imaginary) and are separated by
+ * conjugate symmetry. All memory is allocated in ft8_spectrogram_init().
+ */
+
+#ifndef FT8_SPECTROGRAM_H
+#define FT8_SPECTROGRAM_H
+
+#define FT8_FFT_MAX_FACTORS  32
+
+typedef struct {
+    int n_window;
+    int n_fft;
+    int n_bins;
+
+    int n_factors;
+    int factors[FT8_FFT_MAX_FACTORS];
+
+    float *window;            /* n_window */
+    float *tw_re, *tw_im;     /* e^{-2 pi j k / n_fft}, n_fft */
+    float *re, *im;           /* n_fft work */
+    float *tmp_re, *tmp_im;   /* n_fft ping-pong */
+} ft8_spectrogram_t;
+
+/**
+ * Initialize the transform.
+ *
+ * @param s         Output struct
+ * @param n_window  Samples per window
+ * @param n_fft     DFT length (>= n_window); must factor into 2, 3 and 5
+ * @param n_bins    Bins kept per window (<= n_fft / 2)
+ * @return 0 on success, -1 on bad size or allocation failure
+ */
+int ft8_spectrogram_init(ft8_spectrogram_t *s, int n_window, int n_fft, int n_bins);
+
+/**
+ * Power spectra of one or two windows.
+ *
+ * @param s   Transform
+ * @param x0  n_window samples
+ * @param x1  n_window samples, or NULL for x0 alone
+ * @param p0  Out: n_bins powers of x0 (plus 1e-10)
+ * @param p1  Out: n_bins powers of x1 (unused when x1 is NULL)
+ */
+void ft8_spectrogram_pair(ft8_spectrogram_t *s, const float *x0, const float *x1,
+                          float *p0, float *p1);
+
+/**
+ * Free all memory.
+ */
+void ft8_spectrogram_free(ft8_spectrogram_t *s);
+
+#endif /* FT8_SPECTROGRAM_H */
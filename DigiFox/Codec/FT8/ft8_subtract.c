@@ -0,0 +1,239 @@
+/**
+ * ft8_subtract.c — Per-symbol amplitude fit and subtraction of a decoded signal
+ */
+
+#include "ft8_subtract.h"
+
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define SUB_SAMPLE_RATE    12000.0
+#define SUB_SYMBOL_SAMPLES 1920
+#define SUB_TONE_SPACING   6.25
+
+/* Start time search over ± half a quarter symbol: coarse, then 1/40 symbol */
+#define SUB_TIME_SPAN      192
+#define SUB_TIME_STEP      96
+#define SUB_TIME_FINE      48
+
+static const int k_sync_offsets[3] = { 0, 36, 72 };
+
+/*
+ * Phase rotator for e^{j(phase + w (t - t0))} from t = lo on, as
+ * SUB_LANES interleaved rotators stepping by SUB_LANES · w, so the
+ * recurrence is not one long dependency chain. Recurrences in double
+ * stay on the unit circle to well under 1e-9 over a symbol.
+ */
+#define SUB_LANES 4
+
+typedef struct {
+    double c[SUB_LANES], s[SUB_LANES];
+    double cw, sw;
+} rotator_t;
+
+static void rotator_init(rotator_t *r, double phase, double w)
+{
+    for (int l = 0; l < SUB_LANES; l++) {
+        r->c[l] = cos(phase + w * l);
+        r->s[l] = sin(phase + w * l);
+    }
+    r->cw = cos(w * SUB_LANES);
+    r->sw = sin(w * SUB_LANES);
+}
+
+static inline void rotator_step(rotator_t *r)
+{
+    for (int l = 0; l < SUB_LANES; l++) {
+        double nc = r->c[l] * r->cw - r->s[l] * r->sw;
+        r->s[l] = r->s[l] * r->cw + r->c[l] * r->sw;
+        r->c[l] = nc;
+    }
+}
+
+/*
+ * Sum of audio[t] · e^{-j(phase + w (t - t0))} over t in [t0, t0 + len)
+ * clipped to the buffer. Returns the samples summed.
+ */
+static int correlate(const float *audio, int n, int t0, int len, double phase, double w,
+                     double *re, double *im)
+{
+    int lo = t0 < 0 ? 0 : t0;
+    int hi = t0 + len > n ? n : t0 + len;
+    double acc_re[SUB_LANES] = { 0 }, acc_im[SUB_LANES] = { 0 };
+    rotator_t r;
+    rotator_init(&r, phase + w * (lo - t0), w);
+
+    int t = lo;
+    for (; t + SUB_LANES <= hi; t += SUB_LANES) {
+        for (int l = 0; l < SUB_LANES; l++) {
+            acc_re[l] += audio[t + l] * r.c[l];
+            acc_im[l] -= audio[t + l] * r.s[l];
+        }
+        rotator_step(&r);
+    }
+    for (int l = 0; t < hi; t++, l++) {
+        acc_re[l] += audio[t] * r.c[l];
+        acc_im[l] -= audio[t] * r.s[l];
+    }
+
+    *re = acc_re[0] + acc_re[1] + acc_re[2] + acc_re[3];
+    *im = acc_im[0] + acc_im[1] + acc_im[2] + acc_im[3];
+    return hi > lo ? hi - lo : 0;
+}
+
+static double tone_step(const int *tones, int k, double freq_hz)
+{
+    return 2.0 * M_PI * (freq_hz + tones[k] * SUB_TONE_SPACING) / SUB_SAMPLE_RATE;
+}
+
+/* Costas tone energy with the frame starting at start */
+static double sync_energy(const float *audio, int n, const int *tones, double freq_hz,
+                          int start)
+{
+    double energy = 0.0;
+
+    for (int b = 0; b < 3; b++) {
+        for (int i = 0; i < 7; i++) {
+            int k = k_sync_offsets[b] + i;
+            double re, im;
+            correlate(audio, n, start + k * SUB_SYMBOL_SAMPLES, SUB_SYMBOL_SAMPLES, 0.0,
+                      tone_step(tones, k, freq_hz), &re, &im);
+            energy += re * re + im * im;
+        }
+    }
+    return energy;
+}
+
+/*
+ * Phase of the continuous-phase reference at each symbol's start, and
+ * the least-squares complex amplitude of each symbol against it
+ */
+static void fit_symbols(const float *audio, int n, const int *tones, double freq_hz,
+                        int start, double *phase0, double *amp_re, double *amp_im)
+{
+    double phase = 0.0;
+    for (int k = 0; k < FT8_SUB_SYMBOLS; k++) {
+        phase0[k] = phase;
+        phase = fmod(phase + tone_step(tones, k, freq_hz) * SUB_SYMBOL_SAMPLES, 2.0 * M_PI);
+    }
+
+    for (int k = 0; k < FT8_SUB_SYMBOLS; k++) {
+        double re, im;
+        int len = correlate(audio, n, start + k * SUB_SYMBOL_SAMPLES, SUB_SYMBOL_SAMPLES,
+                            phase0[k], tone_step(tones, k, freq_hz), &re, &im);
+        double scale = len >= SUB_SYMBOL_SAMPLES / 4 ? 2.0 / len : 0.0;
+        amp_re[k] = re * scale;
+        amp_im[k] = im * scale;
+    }
+}
+
+/* Mean phase step between symbols: the residual frequency error */
+static double phase_step(const double *amp_re, const double *amp_im)
+{
+    double dr = 0.0, di = 0.0;
+    for (int k = 0; k + 1 < FT8_SUB_SYMBOLS; k++) {
+        dr += amp_re[k + 1] * amp_re[k] + amp_im[k + 1] * amp_im[k];
+        di += amp_im[k + 1] * amp_re[k] - amp_re[k + 1] * amp_im[k];
+    }
+    return atan2(di, dr);
+}
+
+int ft8_subtract(float *audio, int n, const int *tones, double freq_hz, int start)
+{
+    double best = -1.0;
+    int best_start = start;
+    for (int d = -SUB_TIME_SPAN; d <= SUB_TIME_SPAN; d += SUB_TIME_STEP) {
+        double e = sync_energy(audio, n, tones, freq_hz, start + d);
+        if (e > best) {
+            best = e;
+            best_start = start + d;
+        }
+    }
+    /* Fine steps until the middle of three wins */
+    const int h = SUB_TIME_FINE;
+    double left = sync_energy(audio, n, tones, freq_hz, best_start - h);
+    double right = sync_energy(audio, n, tones, freq_hz, best_start + h);
+    start = best_start;
+    for (int i = 0; i < 2 && (left > best || right > best); i++) {
+        if (left > right) {
+            start -= h;
+            right = best; best = left;
+            left = sync_energy(audio, n, tones, freq_hz, start - h);
+        } else {
+            start += h;
+            left = best; best = right;
+            right = sync_energy(audio, n, tones, freq_hz, start + h);
+        }
+    }
+
+    /*
+     * Correlation magnitude falls off linearly either side of the true
+     * start: fit that triangle through the three points.
+     */
+    double a_l = sqrt(left), a_m = sqrt(best), a_r = sqrt(right);
+    double off = 0.0;
+    if (a_r > a_l && a_m > a_l) {
+        off = 0.5 * (1.0 + (a_r - a_m) / (a_m - a_l));
+    } else if (a_l > a_r && a_m > a_r) {
+        off = -0.5 * (1.0 + (a_l - a_m) / (a_m - a_r));
+    }
+    if (off > 0.5) off = 0.5;
+    if (off < -0.5) off = -0.5;
+    start += (int)lround(off * h);
+
+    /*
+     * Fit, correct the frequency by the mean phase step between symbols,
+     * fit again: a residual error would also turn the phase within each
+     * symbol, which no per-symbol amplitude can follow.
+     */
+    double phase0[FT8_SUB_SYMBOLS];
+    double amp_re[FT8_SUB_SYMBOLS], amp_im[FT8_SUB_SYMBOLS];
+    double step = 0.0;
+    for (int fit = 0; fit < 2; fit++) {
+        fit_symbols(audio, n, tones, freq_hz, start, phase0, amp_re, amp_im);
+        step = phase_step(amp_re, amp_im);
+        if (fit == 0) freq_hz += step * SUB_SAMPLE_RATE / (2.0 * M_PI * SUB_SYMBOL_SAMPLES);
+    }
+
+    /* Derotate what is left, smooth (1 2 1) across symbols, rotate back, subtract */
+    double flat_re[FT8_SUB_SYMBOLS], flat_im[FT8_SUB_SYMBOLS];
+    for (int k = 0; k < FT8_SUB_SYMBOLS; k++) {
+        double c = cos(step * k), s = sin(step * k);
+        flat_re[k] = amp_re[k] * c + amp_im[k] * s;
+        flat_im[k] = amp_im[k] * c - amp_re[k] * s;
+    }
+
+    for (int k = 0; k < FT8_SUB_SYMBOLS; k++) {
+        double sr = 2.0 * flat_re[k], si = 2.0 * flat_im[k], wsum = 2.0;
+        if (k > 0) { sr += flat_re[k - 1]; si += flat_im[k - 1]; wsum += 1.0; }
+        if (k + 1 < FT8_SUB_SYMBOLS) { sr += flat_re[k + 1]; si += flat_im[k + 1]; wsum += 1.0; }
+
+        double c = cos(step * k), s = sin(step * k);
+        double a_re = (sr * c - si * s) / wsum;
+        double a_im = (si * c + sr * s) / wsum;
+
+        /* audio[t] -= Re(A e^{j theta(t)}) */
+        int t0 = start + k * SUB_SYMBOL_SAMPLES;
+        int lo = t0 < 0 ? 0 : t0;
+        int hi = t0 + SUB_SYMBOL_SAMPLES > n ? n : t0 + SUB_SYMBOL_SAMPLES;
+        const double w = tone_step(tones, k, freq_hz);
+        rotator_t r;
+        rotator_init(&r, phase0[k] + w * (lo - t0), w);
+
+        int t = lo;
+        for (; t + SUB_LANES <= hi; t += SUB_LANES) {
+            for (int l = 0; l < SUB_LANES; l++) {
+                audio[t + l] -= (float)(a_re * r.c[l] - a_im * r.s[l]);
+            }
+            rotator_step(&r);
+        }
+        for (int l = 0; t < hi; t++, l++) {
+            audio[t] -= (float)(a_re * r.c[l] - a_im * r.s[l]);
+        }
+    }
+
+    return start;
+}
@@ -0,0 +1,33 @@
+/**
+ * ft8_subtract.h — Remove a decoded FT8 signal from the slot audio
+ *
+ * Multi-pass decoding: once a message is decoded its waveform is known
+ * up to amplitude, phase and small time and frequency errors. It is
+ * rebuilt from its 79 tones as continuous-phase 8-FSK, as FT8Modulator
+ * sends it. First the start time is refined on the 21 Costas symbols, to
+ * better than 1/40 symbol. Then the complex amplitude is fitted against
+ * the audio one symbol at a time. The mean phase step between symbols
+ * gives the residual frequency error, which is corrected before a second
+ * fit. That fit is smoothed over neighbouring symbols and subtracted.
+ *
+ * Works in place on the caller's buffer and allocates nothing.
+ */
+
+#ifndef FT8_SUBTRACT_H
+#define FT8_SUBTRACT_H
+
+#define FT8_SUB_SYMBOLS  79
+
+/**
+ * Subtract one signal.
+ *
+ * @param audio    12 kHz slot audio, modified in place
+ * @param n        Samples in audio
+ * @param tones    The frame's 79 tones (Costas and Gray-coded data)
+ * @param freq_hz  Base (tone 0) frequency
+ * @param start    Frame start in samples, within a quarter symbol
+ * @return Refined start in samples
+ */
+int ft8_subtract(float *audio, int n, const int *tones, double freq_hz, int start);
+
+#endif /* FT8_SUBTRACT_H */
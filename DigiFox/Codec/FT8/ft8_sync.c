@@ -0,0 +1,284 @@
+/**
+ * ft8_sync.c — Costas correlator on a summed-area table with top-K selection
+ */
+
+#include "ft8_sync.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+const ft8_sync_layout_t ft8_sync_layout_ft8 = {
+    FT8_SYNC_SYMBOLS, FT8_SYNC_TONES, 7, 3,
+    { 0, 36, 72 },
+    {
+        { 3, 1, 4, 0, 6, 5, 2 },
+        { 3, 1, 4, 0, 6, 5, 2 },
+        { 3, 1, 4, 0, 6, 5, 2 },
+    },
+};
+
+/* Symbol 0 and 104 are ramp symbols */
+const ft8_sync_layout_t ft8_sync_layout_ft4 = {
+    105, 4, 4, 4,
+    { 1, 34, 67, 100 },
+    {
+        { 0, 1, 3, 2 },
+        { 1, 0, 2, 3 },
+        { 2, 3, 1, 0 },
+        { 3, 2, 0, 1 },
+    },
+};
+
+int ft8_sync_init(ft8_sync_t *s, const ft8_waterfall_t *w)
+{
+    return ft8_sync_init_layout(s, w, &ft8_sync_layout_ft8);
+}
+
+int ft8_sync_init_layout(ft8_sync_t *s, const ft8_waterfall_t *w,
+                         const ft8_sync_layout_t *layout)
+{
+    memset(s, 0, sizeof(*s));
+    s->layout = layout;
+    s->max_rows = w->max_rows;
+    s->n_bins = w->n_bins;
+
+    int starts = w->max_rows - layout->n_symbols + 1;
+    s->map_rows = starts > 0 ? starts * FT8_WF_TIME_OSR : 0;
+    s->map_cols = w->n_bins * FT8_WF_FREQ_OSR;
+
+    s->sat = (double *)calloc((size_t)(s->max_rows + 1) * (s->n_bins + 1), sizeof(double));
+    s->score = (float *)calloc((size_t)s->n_bins, sizeof(float));
+    s->map = (float *)calloc((size_t)s->map_rows * s->map_cols + 1, sizeof(float));
+    if (!s->sat || !s->score || !s->map) {
+        ft8_sync_free(s);
+        return -1;
+    }
+    return 0;
+}
+
+void ft8_sync_free(ft8_sync_t *s)
+{
+    free(s->sat);
+    free(s->score);
+    free(s->map);
+    memset(s, 0, sizeof(*s));
+}
+
+void ft8_sync_set_backend(ft8_sync_t *s, ft8_sync_score_fn fn, void *ctx)
+{
+    s->backend = fn;
+    s->backend_ctx = ctx;
+}
+
+/*
+ * sat[r][k] = sum of power over rows < r and bins < k, for k <= n_cols.
+ * Double keeps the four-corner differences exact enough next to strong
+ * signals.
+ */
+static void build_sat(ft8_sync_t *s, const float *power, int rows, int n_cols)
+{
+    const int w = s->n_bins + 1;
+    double *sat = s->sat;
+
+    memset(sat, 0, (size_t)(n_cols + 1) * sizeof(double));
+    for (int r = 0; r < rows; r++) {
+        const float *p = power + (long)r * s->n_bins;
+        const double *above = sat + (long)r * w;
+        double *cur = sat + (long)(r + 1) * w;
+        double run = 0.0;
+
+        cur[0] = 0.0;
+        for (int k = 0; k < n_cols; k++) {
+            run += p[k];
+            cur[k + 1] = above[k + 1] + run;
+        }
+    }
+}
+
+/*
+ * Sync score of start row t for base bins [min_bin, max_bin) into
+ * s->score, over the first n_blocks Costas blocks: tone power first,
+ * then the blocks' totals from the table. Every pass runs across bins,
+ * so all of them vectorize.
+ */
+static void score_row(ft8_sync_t *s, const float *power, int t, int n_blocks,
+                      int min_bin, int max_bin)
+{
+    const ft8_sync_layout_t *lay = s->layout;
+    const int len = lay->costas_length;
+    const int tones = lay->n_tones;
+    const int w = s->n_bins + 1;
+    float *score = s->score;
+    memset(score + min_bin, 0, (size_t)(max_bin - min_bin) * sizeof(float));
+
+    for (int b = 0; b < n_blocks; b++) {
+        for (int i = 0; i < len; i++) {
+            const float *p = power + (long)(t + lay->offsets[b] + i) * s->n_bins
+                           + lay->costas[b][i];
+            for (int f = min_bin; f < max_bin; f++) score[f] += p[f];
+        }
+    }
+
+    const double *top[FT8_SYNC_MAX_BLOCKS], *bot[FT8_SYNC_MAX_BLOCKS];
+    for (int b = 0; b < n_blocks; b++) {
+        top[b] = s->sat + (long)(t + lay->offsets[b]) * w;
+        bot[b] = top[b] + (long)len * w;
+    }
+
+    const float noise_cells = (float)(n_blocks * (len * tones - len) + 1);
+    for (int f = min_bin; f < max_bin; f++) {
+        double all = 0.0;
+        for (int b = 0; b < n_blocks; b++) {
+            all += bot[b][f + tones] - bot[b][f]
+                 - top[b][f + tones] + top[b][f];
+        }
+        float signal = score[f];
+        float noise_avg = (float)(all - signal) / noise_cells;
+        score[f] = signal / (noise_avg + 1e-10f);
+    }
+}
+
+/* Every grid's scores for job into the interleaved map */
+static void score_map(ft8_sync_t *s, const ft8_sync_job_t *job)
+{
+    for (int ts = 0; ts < FT8_WF_TIME_OSR; ts++) {
+        const int rows = job->rows[ts];
+        if (rows == 0) continue;
+
+        for (int fs = 0; fs < FT8_WF_FREQ_OSR; fs++) {
+            const float *power = job->power
+                               + (long)(ts * FT8_WF_FREQ_OSR + fs) * job->max_rows * job->n_bins;
+            build_sat(s, power, rows, job->max_bin - 1 + s->layout->n_tones);
+
+            for (int t = 0; t + job->frame_symbols <= rows; t++) {
+                int r = t * FT8_WF_TIME_OSR + ts;
+                if (r >= s->map_rows) break;
+                score_row(s, power, t, job->n_blocks, job->min_bin, job->max_bin);
+
+                float *m = s->map + (long)r * s->map_cols + fs;
+                for (int f = job->min_bin; f < job->max_bin; f++) {
+                    m[f * FT8_WF_FREQ_OSR] = s->score[f];
+                }
+            }
+        }
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Top-K                                                               */
+/* ------------------------------------------------------------------ */
+
+/* Min-heap on score: out[0] is the weakest kept candidate */
+static void sift_down(ft8_candidate_t *h, int n, int i)
+{
+    for (;;) {
+        int l = 2 * i + 1, r = l + 1, m = i;
+        if (l < n && h[l].score < h[m].score) m = l;
+        if (r < n && h[r].score < h[m].score) m = r;
+        if (m == i) return;
+        ft8_candidate_t t = h[i]; h[i] = h[m]; h[m] = t;
+        i = m;
+    }
+}
+
+static void sift_up(ft8_candidate_t *h, int i)
+{
+    while (i > 0) {
+        int p = (i - 1) / 2;
+        if (h[p].score <= h[i].score) return;
+        ft8_candidate_t t = h[i]; h[i] = h[p]; h[p] = t;
+        i = p;
+    }
+}
+
+static int cmp_candidate(const void *a, const void *b)
+{
+    float sa = ((const ft8_candidate_t *)a)->score;
+    float sb = ((const ft8_candidate_t *)b)->score;
+    return (sa < sb) - (sa > sb);
+}
+
+/* Strictly best of its quarter-symbol and half-tone neighbours' scores */
+static int local_max(const ft8_sync_t *s, int r, int c, int c_lo, int c_hi)
+{
+    const float *m = s->map + (long)r * s->map_cols + c;
+    float v = *m;
+
+    if (r > 0 && m[-s->map_cols] >= v) return 0;
+    if (r + 1 < s->map_rows && m[s->map_cols] > v) return 0;
+    if (c > c_lo && m[-1] >= v) return 0;
+    if (c + 1 < c_hi && m[1] > v) return 0;
+    return 1;
+}
+
+int ft8_sync_search(ft8_sync_t *s, const ft8_waterfall_t *w,
+                    int min_bin, int max_bin, float threshold,
+                    int frame_symbols, ft8_candidate_t *out, int max_out)
+{
+    const ft8_sync_layout_t *lay = s->layout;
+    const int min_symbols = lay->offsets[1] + lay->costas_length;
+
+    if (min_bin < 0) min_bin = 0;
+    if (max_bin > s->n_bins - lay->n_tones + 1) max_bin = s->n_bins - lay->n_tones + 1;
+    if (max_bin <= min_bin || max_out <= 0 || s->map_rows == 0) return 0;
+    if (frame_symbols > lay->n_symbols) frame_symbols = lay->n_symbols;
+    if (frame_symbols < min_symbols) frame_symbols = min_symbols;
+
+    int n_blocks = 0;
+    while (n_blocks < lay->n_blocks &&
+           lay->offsets[n_blocks] + lay->costas_length <= frame_symbols) {
+        n_blocks++;
+    }
+
+    ft8_sync_job_t job = {
+        w->power, s->max_rows, s->n_bins, { 0 }, frame_symbols, *lay, n_blocks,
+        min_bin, max_bin, 0, s->map_cols,
+    };
+    for (int ts = 0; ts < FT8_WF_TIME_OSR; ts++) {
+        int rows = ft8_waterfall_rows(w, ts);
+        if (rows > s->max_rows) rows = s->max_rows;
+        if (rows < frame_symbols) continue;
+        job.rows[ts] = rows;
+
+        int last = (rows - frame_symbols) * FT8_WF_TIME_OSR + ts;
+        if (last >= s->map_rows) last = (s->map_rows - 1 - ts) / FT8_WF_TIME_OSR * FT8_WF_TIME_OSR + ts;
+        if (last + 1 > job.map_rows_used) job.map_rows_used = last + 1;
+    }
+    const int map_rows_used = job.map_rows_used;
+
+    /* Rows past the used ones are read as neighbours */
+    for (long i = 0; i < (long)s->map_rows * s->map_cols; i++) s->map[i] = -INFINITY;
+    if (!s->backend || s->backend(s->backend_ctx, &job, s->map) != 0) {
+        score_map(s, &job);
+    }
+
+    /* Local maxima above threshold → top K */
+    const int c_lo = min_bin * FT8_WF_FREQ_OSR;
+    const int c_hi = max_bin * FT8_WF_FREQ_OSR;
+    int n = 0;
+
+    for (int r = 0; r < map_rows_used; r++) {
+        for (int c = c_lo; c < c_hi; c++) {
+            float score = s->map[(long)r * s->map_cols + c];
+            if (!(score > threshold)) continue;
+            if (n == max_out && score <= out[0].score) continue;
+            if (!local_max(s, r, c, c_lo, c_hi)) continue;
+
+            ft8_candidate_t cand = {
+                r / FT8_WF_TIME_OSR, c / FT8_WF_FREQ_OSR,
+                r % FT8_WF_TIME_OSR, c % FT8_WF_FREQ_OSR, score, 0,
+            };
+            if (n < max_out) {
+                out[n] = cand;
+                sift_up(out, n++);
+            } else {
+                out[0] = cand;
+                sift_down(out, n, 0);
+            }
+        }
+    }
+
+    qsort(out, (size_t)n, sizeof(ft8_candidate_t), cmp_candidate);
+    return n;
+}
@@ -0,0 +1,150 @@
+/**
+ * ft8_sync.h — Costas sync search over the oversampled waterfall
+ *
+ * Scores every (start row, base bin) of every waterfall grid as
+ * ft8_decoder.c always has: power in the 21 Costas tone bins over the
+ * mean of the other 147 bins of the three 7 × 8 sync blocks. A
+ * summed-area table over (row, bin) makes each block's total energy four
+ * reads, so a position costs 21 tone reads plus 12 instead of 168; the
+ * tone reads for one start row are 21 contiguous passes across all base
+ * bins, which vectorize.
+ *
+ * The grids' scores are interleaved into one map at quarter-symbol,
+ * half-tone resolution. A signal lights up a cluster of neighbouring
+ * positions there, so only local maxima that beat the threshold are
+ * candidates; they go through a bounded min-heap, so only the best K
+ * are kept and sorted.
+ *
+ * Frames still being received can be searched too: only the Costas
+ * blocks already in the waterfall are scored.
+ *
+ * The frame layout is a parameter: FT8 and JS8 send three 7-symbol
+ * blocks of 8 tones, FT4 four 4-symbol blocks of 4 tones, each with its
+ * own pattern. The noise reference is the rest of each block either way.
+ *
+ * The score map can also be filled elsewhere, e.g. on the GPU
+ * (ft8_sync_metal.h): the search hands an ft8_sync_job_t to the backend
+ * and only picks the maxima itself. A backend scores each position
+ * directly rather than from the table, so its scores match the CPU's to
+ * float rounding.
+ *
+ * Everything is allocated in ft8_sync_init(); searching does no heap
+ * allocation.
+ */
+
+#ifndef FT8_SYNC_H
+#define FT8_SYNC_H
+
+#include "ft8_waterfall.h"
+
+#define FT8_SYNC_TONES        8    /* Bins per sync block */
+#define FT8_SYNC_SYMBOLS      79   /* Symbols per frame */
+#define FT8_SYNC_MIN_SYMBOLS  43   /* Through the second Costas block */
+
+#define FT8_SYNC_MAX_BLOCKS   4    /* FT4 */
+#define FT8_SYNC_MAX_COSTAS   7    /* FT8 */
+
+/* Where a mode's Costas blocks are and which tones they send */
+typedef struct {
+    int n_symbols;                                  /* Symbols per frame */
+    int n_tones;                                    /* Bins per sync block */
+    int costas_length;                              /* Symbols per block */
+    int n_blocks;
+    int offsets[FT8_SYNC_MAX_BLOCKS];               /* First symbol of each */
+    int costas[FT8_SYNC_MAX_BLOCKS][FT8_SYNC_MAX_COSTAS];  /* Tone per symbol */
+} ft8_sync_layout_t;
+
+extern const ft8_sync_layout_t ft8_sync_layout_ft8;   /* FT8, JS8 */
+extern const ft8_sync_layout_t ft8_sync_layout_ft4;
+
+typedef struct {
+    int   row;       /* Frame start in grid rows (symbols) */
+    int   bin;       /* Base (tone 0) bin */
+    int   time_sub;  /* Waterfall grid: quarter-symbol offset */
+    int   freq_sub;  /* Waterfall grid: half-tone offset */
+    float score;
+    int   decoded;   /* Set by the decoder */
+} ft8_candidate_t;
+
+/*
+ * One search's scoring, for a backend. Map cell (r, c) is start row
+ * r / FT8_WF_TIME_OSR of the grids with time offset ts = r % FT8_WF_TIME_OSR,
+ * base bin c / FT8_WF_FREQ_OSR of frequency offset c % FT8_WF_FREQ_OSR. It
+ * is scored if the frame fits in rows[ts] and the bin is in
+ * [min_bin, max_bin); every other cell of the first map_rows_used rows
+ * is -INFINITY.
+ */
+typedef struct ft8_sync_job_t {
+    const float *power;           /* ft8_waterfall_t power: all grids */
+    int   max_rows;               /* Rows per grid */
+    int   n_bins;                 /* Bins per grid row */
+    int   rows[FT8_WF_TIME_OSR];  /* Complete rows per time offset */
+    int   frame_symbols;          /* Leading symbols of a frame required */
+    ft8_sync_layout_t layout;     /* The mode's blocks */
+    int   n_blocks;               /* Leading blocks scored */
+    int   min_bin;
+    int   max_bin;
+    int   map_rows_used;          /* Map rows to fill */
+    int   map_cols;
+} ft8_sync_job_t;
+
+/* Fills map (map_rows_used x map_cols) for job; nonzero = map left as it
+ * was, the CPU scores instead */
+typedef int (*ft8_sync_score_fn)(void *ctx, const ft8_sync_job_t *job, float *map);
+
+typedef struct {
+    const ft8_sync_layout_t *layout;
+    int     max_rows;
+    int     n_bins;
+    double *sat;     /* (max_rows + 1) * (n_bins + 1): sums above-left */
+    float  *score;   /* n_bins: one start row's scores */
+    float  *map;     /* map_rows * map_cols: all grids interleaved */
+    int     map_rows;
+    int     map_cols;
+
+    ft8_sync_score_fn backend;    /* NULL = score on the CPU */
+    void   *backend_ctx;
+} ft8_sync_t;
+
+/**
+ * Allocate for a waterfall from ft8_waterfall_init(), FT8 frames.
+ *
+ * @return 0 on success, -1 on allocation failure
+ */
+int ft8_sync_init(ft8_sync_t *s, const ft8_waterfall_t *w);
+
+/**
+ * ft8_sync_init() for frames of another layout (kept by pointer).
+ */
+int ft8_sync_init_layout(ft8_sync_t *s, const ft8_waterfall_t *w,
+                         const ft8_sync_layout_t *layout);
+
+void ft8_sync_free(ft8_sync_t *s);
+
+/**
+ * Score the map with fn(ctx, ...) from now on; NULL for the CPU.
+ */
+void ft8_sync_set_backend(ft8_sync_t *s, ft8_sync_score_fn fn, void *ctx);
+
+/**
+ * Best-scoring candidates over the rows the waterfall has so far, best
+ * first.
+ *
+ * @param s          From ft8_sync_init()
+ * @param w          Waterfall
+ * @param min_bin    Lowest base bin searched
+ * @param max_bin    Base bins searched are [min_bin, max_bin)
+ * @param threshold  Minimum score
+ * @param frame_symbols  Leading symbols of a frame that must be in the
+ *                   waterfall: the layout's n_symbols for whole frames,
+ *                   down to the end of its second block (FT8:
+ *                   FT8_SYNC_MIN_SYMBOLS) for frames still arriving
+ * @param out        Output array
+ * @param max_out    Capacity of out (K)
+ * @return Candidates written
+ */
+int ft8_sync_search(ft8_sync_t *s, const ft8_waterfall_t *w,
+                    int min_bin, int max_bin, float threshold,
+                    int frame_symbols, ft8_candidate_t *out, int max_out);
+
+#endif /* FT8_SYNC_H */
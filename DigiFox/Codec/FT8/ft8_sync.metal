@@ -0,0 +1,66 @@
+/**
+ * ft8_sync.metal — Costas sync score of every map cell (ft8_sync_metal.h)
+ *
+ * One thread per cell of the interleaved score map. Each sums its Costas
+ * tone bins and all bins of its sync blocks (FT8: 21 of 3 × 7 × 8, FT4:
+ * 16 of 4 × 4 × 4) straight from the grid: neighbouring threads read
+ * neighbouring bins, so the reads coalesce and no summed-area table is
+ * needed.
+ */
+
+#include <metal_stdlib>
+using namespace metal;
+
+/* ft8_sync_job_t without the power pointer; FT8_WF_TIME_OSR = 4,
+ * FT8_SYNC_MAX_BLOCKS = 4, FT8_SYNC_MAX_COSTAS = 7 */
+struct ft8_sync_params {
+    int max_rows;
+    int n_bins;
+    int rows[4];
+    int frame_symbols;
+    int n_tones;
+    int costas_length;
+    int offsets[4];
+    int costas[4][7];
+    int n_blocks;
+    int min_bin;
+    int max_bin;
+    int map_rows_used;
+    int map_cols;
+};
+
+kernel void ft8_sync_score(device const float *power        [[buffer(0)]],
+                           constant ft8_sync_params &p      [[buffer(1)]],
+                           device float *map                [[buffer(2)]],
+                           uint2 gid                        [[thread_position_in_grid]])
+{
+    const int c = int(gid.x);
+    const int r = int(gid.y);
+    if (r >= p.map_rows_used || c >= p.map_cols) return;
+
+    /* Map layout of ft8_sync.h: FT8_WF_TIME_OSR 4, FT8_WF_FREQ_OSR 2 */
+    const int ts = r % 4, t = r / 4;
+    const int fs = c % 2, f = c / 2;
+    device float *out = map + long(r) * p.map_cols + c;
+
+    if (p.rows[ts] == 0 || t + p.frame_symbols > p.rows[ts] ||
+        f < p.min_bin || f >= p.max_bin) {
+        *out = -INFINITY;
+        return;
+    }
+
+    device const float *grid = power + long(ts * 2 + fs) * p.max_rows * p.n_bins;
+    float signal = 0.0f;
+    float all = 0.0f;
+    for (int b = 0; b < p.n_blocks; b++) {
+        for (int i = 0; i < p.costas_length; i++) {
+            device const float *row = grid + long(t + p.offsets[b] + i) * p.n_bins + f;
+            signal += row[p.costas[b][i]];
+            for (int k = 0; k < p.n_tones; k++) all += row[k];
+        }
+    }
+
+    const int len = p.costas_length;
+    const float noise_avg = (all - signal) / float(p.n_blocks * (len * p.n_tones - len) + 1);
+    *out = signal / (noise_avg + 1e-10f);
+}
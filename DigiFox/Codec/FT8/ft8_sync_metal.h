@@ -0,0 +1,48 @@
+/**
+ * ft8_sync_metal.h — Costas sync scoring on the GPU (Metal)
+ *
+ * A backend for the sync search (ft8_sync.h) that scores the whole
+ * (start row, base bin) map of every waterfall grid in one compute pass,
+ * a thread per map cell, leaving the CPU free for LDPC and subtraction
+ * at slot end. The search still picks the local maxima and the top K
+ * itself, so a decoder finds the same candidates either way; scores
+ * differ only by float rounding.
+ *
+ * Set it in ft8_config_t / js8_config_t / ft4_config_t:
+ *   cfg.sync_score = ft8_sync_metal_score;
+ *   cfg.sync_ctx   = ft8_sync_metal_shared();   // NULL: no GPU, CPU it is
+ *
+ * The GPU buffers grow to the largest waterfall seen and are then
+ * reused. Searches from several threads take turns on the one queue.
+ */
+
+#ifndef FT8_SYNC_METAL_H
+#define FT8_SYNC_METAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ft8_sync_metal_t ft8_sync_metal_t;
+
+struct ft8_sync_job_t;
+
+/**
+ * The process-wide GPU context, set up on first use. NULL when there is
+ * no Metal device or the kernel is missing from the app's library.
+ */
+ft8_sync_metal_t *ft8_sync_metal_shared(void);
+
+/**
+ * ft8_sync_score_fn for ctx from ft8_sync_metal_shared().
+ *
+ * @return 0 with map filled, -1 (map untouched) if ctx is NULL, a buffer
+ *         could not be allocated or the GPU pass failed
+ */
+int ft8_sync_metal_score(void *ctx, const struct ft8_sync_job_t *job, float *map);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FT8_SYNC_METAL_H */
@@ -0,0 +1,138 @@
+/**
+ * ft8_sync_metal.m — Metal backend of the FT8/JS8/FT4 Costas sync search
+ */
+
+#import "ft8_sync_metal.h"
+#import "ft8_sync.h"
+
+#import <Foundation/Foundation.h>
+#import <Metal/Metal.h>
+#include <os/lock.h>
+#include <string.h>
+
+/* As ft8_sync_params in ft8_sync.metal */
+typedef struct {
+    int max_rows;
+    int n_bins;
+    int rows[FT8_WF_TIME_OSR];
+    int frame_symbols;
+    int n_tones;
+    int costas_length;
+    int offsets[FT8_SYNC_MAX_BLOCKS];
+    int costas[FT8_SYNC_MAX_BLOCKS][FT8_SYNC_MAX_COSTAS];
+    int n_blocks;
+    int min_bin;
+    int max_bin;
+    int map_rows_used;
+    int map_cols;
+} ft8_sync_params_t;
+
+@interface FT8SyncMetal : NSObject {
+@public
+    id<MTLDevice> _device;
+    id<MTLCommandQueue> _queue;
+    id<MTLComputePipelineState> _pipeline;
+    id<MTLBuffer> _power;     /* Grown to the largest waterfall searched */
+    id<MTLBuffer> _map;
+    os_unfair_lock _lock;     /* One search on the queue at a time */
+}
+@end
+
+@implementation FT8SyncMetal
+@end
+
+static FT8SyncMetal *s_shared;
+
+static FT8SyncMetal *create_shared(void)
+{
+    id<MTLDevice> device = MTLCreateSystemDefaultDevice();
+    if (!device) return nil;
+
+    id<MTLLibrary> library = [device newDefaultLibrary];
+    id<MTLFunction> fn = [library newFunctionWithName:@"ft8_sync_score"];
+    if (!fn) return nil;
+
+    NSError *error = nil;
+    id<MTLComputePipelineState> pipeline = [device newComputePipelineStateWithFunction:fn
+                                                                                 error:&error];
+    id<MTLCommandQueue> queue = [device newCommandQueue];
+    if (!pipeline || !queue) {
+        NSLog(@"[ft8_sync_metal] no pipeline: %@", error);
+        return nil;
+    }
+
+    FT8SyncMetal *m = [FT8SyncMetal new];
+    m->_device = device;
+    m->_queue = queue;
+    m->_pipeline = pipeline;
+    m->_lock = OS_UNFAIR_LOCK_INIT;
+    return m;
+}
+
+ft8_sync_metal_t *ft8_sync_metal_shared(void)
+{
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        s_shared = create_shared();
+    });
+    return (__bridge ft8_sync_metal_t *)s_shared;
+}
+
+/* A shared buffer of at least bytes, reusing buf when it is big enough */
+static id<MTLBuffer> ensure_buffer(FT8SyncMetal *m, id<MTLBuffer> buf, size_t bytes)
+{
+    if (buf && buf.length >= bytes) return buf;
+    return [m->_device newBufferWithLength:bytes options:MTLResourceStorageModeShared];
+}
+
+int ft8_sync_metal_score(void *ctx, const struct ft8_sync_job_t *job, float *map)
+{
+    if (!ctx) return -1;
+    FT8SyncMetal *m = (__bridge FT8SyncMetal *)ctx;
+    if (job->map_rows_used <= 0) return 0;
+
+    const size_t power_bytes = (size_t)FT8_WF_SUBGRIDS * job->max_rows * job->n_bins * sizeof(float);
+    const size_t map_bytes = (size_t)job->map_rows_used * job->map_cols * sizeof(float);
+
+    ft8_sync_params_t params = {
+        job->max_rows, job->n_bins, { 0 }, job->frame_symbols,
+        job->layout.n_tones, job->layout.costas_length, { 0 }, { { 0 } }, job->n_blocks,
+        job->min_bin, job->max_bin, job->map_rows_used, job->map_cols,
+    };
+    memcpy(params.rows, job->rows, sizeof(params.rows));
+    memcpy(params.offsets, job->layout.offsets, sizeof(params.offsets));
+    memcpy(params.costas, job->layout.costas, sizeof(params.costas));
+
+    int status = -1;
+    os_unfair_lock_lock(&m->_lock);
+    @autoreleasepool {
+        m->_power = ensure_buffer(m, m->_power, power_bytes);
+        m->_map = ensure_buffer(m, m->_map, map_bytes);
+        if (m->_power && m->_map) {
+            memcpy(m->_power.contents, job->power, power_bytes);
+
+            id<MTLCommandBuffer> cmd = [m->_queue commandBuffer];
+            id<MTLComputeCommandEncoder> enc = [cmd computeCommandEncoder];
+            [enc setComputePipelineState:m->_pipeline];
+            [enc setBuffer:m->_power offset:0 atIndex:0];
+            [enc setBytes:&params length:sizeof(params) atIndex:1];
+            [enc setBuffer:m->_map offset:0 atIndex:2];
+
+            /* A SIMD group along a map row: neighbouring bins */
+            NSUInteger w = m->_pipeline.threadExecutionWidth;
+            NSUInteger h = m->_pipeline.maxTotalThreadsPerThreadgroup / w;
+            [enc dispatchThreads:MTLSizeMake((NSUInteger)job->map_cols, (NSUInteger)job->map_rows_used, 1)
+           threadsPerThreadgroup:MTLSizeMake(w, h, 1)];
+            [enc endEncoding];
+            [cmd commit];
+            [cmd waitUntilCompleted];
+
+            if (cmd.status == MTLCommandBufferStatusCompleted) {
+                memcpy(map, m->_map.contents, map_bytes);
+                status = 0;
+            }
+        }
+    }
+    os_unfair_lock_unlock(&m->_lock);
+    return status;
+}
@@ -0,0 +1,205 @@
+/**
+ * ft8_synth.c — NCO with sine table and tabulated Gaussian frequency pulse
+ */
+
+#include "ft8_synth.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define SYNTH_LUT_BITS   10
+#define SYNTH_LUT_SIZE   (1 << SYNTH_LUT_BITS)
+#define SYNTH_FRAC_BITS  (32 - SYNTH_LUT_BITS)
+
+/* Phase increment of 1 Hz is 2^32 / sample_rate */
+#define SYNTH_PHASE_UNITS 4294967296.0
+
+struct ft8_synth_t {
+    float    sample_rate;
+    int      nsps;
+    int      ramp_cfg;
+
+    /* Sine at SYNTH_LUT_SIZE points of the cycle, and the step to the next */
+    float    sine[SYNTH_LUT_SIZE];
+    float    slope[SYNTH_LUT_SIZE];
+
+    /*
+     * Frequency pulse of one symbol, one tone high, over the three symbol
+     * periods it reaches into: pulse[k + nsps] is its own period.
+     */
+    uint32_t *pulse;          /* 3 · nsps increments */
+    float    *ramp;           /* ramp_cfg gains, rising */
+
+    /* Current frame: tones with the end ones repeated at both sides */
+    uint32_t tone[FT8_SYNTH_MAX_SYMBOLS + 2];
+    int      n_symbols;
+    int      total;
+    int      pos;
+    int      ramp_len;
+    uint32_t base_inc;
+    uint32_t phase;
+    float    amplitude;
+};
+
+void ft8_synth_config_init(ft8_synth_config_t *cfg)
+{
+    cfg->sample_rate = 12000.0f;
+    cfg->symbol_samples = 1920;
+    cfg->bt = 2.0f;
+    cfg->ramp_samples = 60;
+}
+
+/* Gaussian-filtered rectangular pulse one symbol wide, t in symbols from its centre */
+static double gfsk_pulse(double bt, double t)
+{
+    const double c = M_PI * sqrt(2.0 / log(2.0));
+    return 0.5 * (erf(c * bt * (t + 0.5)) - erf(c * bt * (t - 0.5)));
+}
+
+ft8_synth_t *ft8_synth_create(const ft8_synth_config_t *cfg)
+{
+    ft8_synth_config_t def;
+    if (!cfg) {
+        ft8_synth_config_init(&def);
+        cfg = &def;
+    }
+
+    ft8_synth_t *s = (ft8_synth_t *)calloc(1, sizeof(ft8_synth_t));
+    if (!s) return NULL;
+
+    s->sample_rate = cfg->sample_rate > 0 ? cfg->sample_rate : 12000.0f;
+    s->nsps = cfg->symbol_samples > 0 ? cfg->symbol_samples : 1920;
+    s->ramp_cfg = cfg->ramp_samples > 0 ? cfg->ramp_samples : 0;
+
+    const int nsps = s->nsps;
+    s->pulse = (uint32_t *)malloc(sizeof(uint32_t) * 3 * nsps);
+    s->ramp = (float *)malloc(sizeof(float) * (s->ramp_cfg + 1));
+    if (!s->pulse || !s->ramp) {
+        ft8_synth_destroy(s);
+        return NULL;
+    }
+
+    for (int i = 0; i < SYNTH_LUT_SIZE; i++) {
+        double a = 2.0 * M_PI * i / SYNTH_LUT_SIZE;
+        double b = 2.0 * M_PI * (i + 1) / SYNTH_LUT_SIZE;
+        s->sine[i] = (float)sin(a);
+        s->slope[i] = (float)(sin(b) - sin(a));
+    }
+
+    /* One tone is the symbol rate: 2^32 / nsps per sample */
+    const double tone_inc = SYNTH_PHASE_UNITS / nsps;
+    for (int i = 0; i < 3 * nsps; i++) {
+        double p;
+        if (cfg->bt > 0) {
+            p = gfsk_pulse(cfg->bt, (i + 0.5) / nsps - 1.5);
+        } else {
+            p = (i >= nsps && i < 2 * nsps) ? 1.0 : 0.0;
+        }
+        s->pulse[i] = (uint32_t)llround(p * tone_inc);
+    }
+
+    for (int i = 0; i < s->ramp_cfg; i++) {
+        s->ramp[i] = (float)(0.5 * (1.0 - cos(M_PI * i / s->ramp_cfg)));
+    }
+
+    return s;
+}
+
+int ft8_synth_start(ft8_synth_t *s, const uint8_t *tones, int n_symbols,
+                    float base_freq, float amplitude)
+{
+    if (n_symbols < 1 || n_symbols > FT8_SYNTH_MAX_SYMBOLS) return -1;
+
+    for (int i = 0; i < n_symbols; i++) s->tone[i + 1] = tones[i];
+    s->tone[0] = tones[0];
+    s->tone[n_symbols + 1] = tones[n_symbols - 1];
+
+    s->n_symbols = n_symbols;
+    s->total = n_symbols * s->nsps;
+    s->pos = 0;
+    s->phase = 0;
+    s->amplitude = amplitude;
+
+    /* Frames too short for the full ramp at both ends are not ramped */
+    s->ramp_len = s->total > 2 * s->ramp_cfg ? s->ramp_cfg : 0;
+
+    double inc = fmod(base_freq * SYNTH_PHASE_UNITS / s->sample_rate, SYNTH_PHASE_UNITS);
+    if (inc < 0) inc += SYNTH_PHASE_UNITS;
+    s->base_inc = (uint32_t)(uint64_t)llround(inc);
+    return 0;
+}
+
+int ft8_synth_render(ft8_synth_t *s, float *out, int n)
+{
+    const int nsps = s->nsps;
+    const float *sine = s->sine, *slope = s->slope;
+    const float amp = s->amplitude;
+    const float frac_scale = 1.0f / (float)(1u << SYNTH_FRAC_BITS);
+    const int start = s->pos;
+    uint32_t phase = s->phase;
+    int done = 0;
+
+    while (done < n && s->pos < s->total) {
+        const int sym = s->pos / nsps;
+        int k = s->pos - sym * nsps;
+        int len = nsps - k;
+        if (len > n - done) len = n - done;
+
+        /* Symbol sym is tone[sym + 1]; its neighbours overlap its period */
+        const uint32_t prev = s->tone[sym];
+        const uint32_t cur = s->tone[sym + 1];
+        const uint32_t next = s->tone[sym + 2];
+        const uint32_t *p_prev = s->pulse + 2 * nsps + k;
+        const uint32_t *p_cur = s->pulse + nsps + k;
+        const uint32_t *p_next = s->pulse + k;
+        const uint32_t base = s->base_inc;
+        float *o = out + done;
+
+        for (int i = 0; i < len; i++) {
+            uint32_t idx = phase >> SYNTH_FRAC_BITS;
+            float frac = (float)(phase & ((1u << SYNTH_FRAC_BITS) - 1)) * frac_scale;
+            o[i] = amp * (sine[idx] + frac * slope[idx]);
+            phase += base + prev * p_prev[i] + cur * p_cur[i] + next * p_next[i];
+        }
+
+        s->pos += len;
+        done += len;
+    }
+    s->phase = phase;
+
+    /* Amplitude ramp where this block overlaps either end of the frame */
+    const int r = s->ramp_len;
+    if (r > 0) {
+        for (int t = start; t < r && t < s->pos; t++) {
+            out[t - start] *= s->ramp[t];
+        }
+        int from = s->total - r > start ? s->total - r : start;
+        for (int t = from; t < s->pos; t++) {
+            out[t - start] *= s->ramp[s->total - 1 - t];
+        }
+    }
+
+    return done;
+}
+
+int ft8_synth_length(const ft8_synth_t *s)
+{
+    return s->total;
+}
+
+int ft8_synth_remaining(const ft8_synth_t *s)
+{
+    return s->total - s->pos;
+}
+
+void ft8_synth_destroy(ft8_synth_t *s)
+{
+    if (!s) return;
+    free(s->pulse);
+    free(s->ramp);
+    free(s);
+}
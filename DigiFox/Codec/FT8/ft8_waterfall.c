@@ -0,0 +1,141 @@
+/**
+ * ft8_waterfall.c — Incremental oversampled waterfall
+ */
+
+#include "ft8_waterfall.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+int ft8_waterfall_init(ft8_waterfall_t *w, int symbol_samples, int max_samples,
+                       int n_bins)
+{
+    memset(w, 0, sizeof(*w));
+    if (symbol_samples % FT8_WF_TIME_OSR || max_samples < symbol_samples ||
+        n_bins < 1 || n_bins > symbol_samples / 2) {
+        return -1;
+    }
+
+    w->symbol_samples = symbol_samples;
+    w->hop = symbol_samples / FT8_WF_TIME_OSR;
+    w->max_samples = max_samples;
+    w->max_windows = (max_samples - symbol_samples) / w->hop + 1;
+    w->max_rows = (w->max_windows + FT8_WF_TIME_OSR - 1) / FT8_WF_TIME_OSR;
+    w->n_bins = n_bins;
+
+    if (ft8_spectrogram_init(&w->fft, symbol_samples, FT8_WF_FREQ_OSR * symbol_samples,
+                             FT8_WF_FREQ_OSR * n_bins) != 0) {
+        ft8_waterfall_free(w);
+        return -1;
+    }
+
+    w->audio = (float *)calloc((size_t)max_samples, sizeof(float));
+    w->power = (float *)calloc((size_t)FT8_WF_SUBGRIDS * w->max_rows * n_bins, sizeof(float));
+    w->fine = (float *)calloc((size_t)2 * FT8_WF_FREQ_OSR * n_bins, sizeof(float));
+    if (!w->audio || !w->power || !w->fine) {
+        ft8_waterfall_free(w);
+        return -1;
+    }
+    return 0;
+}
+
+void ft8_waterfall_free(ft8_waterfall_t *w)
+{
+    ft8_spectrogram_free(&w->fft);
+    free(w->audio);
+    free(w->power);
+    free(w->fine);
+    memset(w, 0, sizeof(*w));
+}
+
+void ft8_waterfall_reset(ft8_waterfall_t *w)
+{
+    w->n_audio = 0;
+    w->n_windows = 0;
+}
+
+/* Half-tone bins of window j → bin b of grids (j % 4, 0) and (j % 4, 1) */
+static void scatter(ft8_waterfall_t *w, int j, const float *fine)
+{
+    const int ts = j % FT8_WF_TIME_OSR;
+    const long row = (long)(j / FT8_WF_TIME_OSR) * w->n_bins;
+
+    for (int fs = 0; fs < FT8_WF_FREQ_OSR; fs++) {
+        float *out = (float *)ft8_waterfall_grid(w, ts, fs) + row;
+        for (int b = 0; b < w->n_bins; b++) out[b] = fine[b * FT8_WF_FREQ_OSR + fs];
+    }
+}
+
+static int window_ready(const ft8_waterfall_t *w, int j)
+{
+    return j < w->max_windows && (long)j * w->hop + w->symbol_samples <= w->n_audio;
+}
+
+/* Every pair of windows the audio so far completes */
+static void transform_pairs(ft8_waterfall_t *w)
+{
+    const int n_fine = FT8_WF_FREQ_OSR * w->n_bins;
+    while (window_ready(w, w->n_windows + 1)) {
+        int j = w->n_windows;
+        ft8_spectrogram_pair(&w->fft, w->audio + (long)j * w->hop,
+                             w->audio + (long)(j + 1) * w->hop,
+                             w->fine, w->fine + n_fine);
+        scatter(w, j, w->fine);
+        scatter(w, j + 1, w->fine + n_fine);
+        w->n_windows += 2;
+    }
+}
+
+int ft8_waterfall_append(ft8_waterfall_t *w, const float *audio, int n)
+{
+    if (n > w->max_samples - w->n_audio) n = w->max_samples - w->n_audio;
+    if (n <= 0) return 0;
+
+    memcpy(w->audio + w->n_audio, audio, (size_t)n * sizeof(float));
+    w->n_audio += n;
+    return n;
+}
+
+int ft8_waterfall_feed(ft8_waterfall_t *w, const float *audio, int n)
+{
+    n = ft8_waterfall_append(w, audio, n);
+    transform_pairs(w);
+    return n;
+}
+
+int ft8_waterfall_windows_ready(const ft8_waterfall_t *w)
+{
+    if (w->n_audio < w->symbol_samples) return 0;
+    int n = (w->n_audio - w->symbol_samples) / w->hop + 1;
+    return n < w->max_windows ? n : w->max_windows;
+}
+
+void ft8_waterfall_put(ft8_waterfall_t *w, const float *fine)
+{
+    if (!window_ready(w, w->n_windows)) return;
+    scatter(w, w->n_windows, fine);
+    w->n_windows++;
+}
+
+void ft8_waterfall_flush(ft8_waterfall_t *w)
+{
+    transform_pairs(w);
+
+    int j = w->n_windows;
+    if (!window_ready(w, j)) return;
+
+    ft8_spectrogram_pair(&w->fft, w->audio + (long)j * w->hop, NULL, w->fine, NULL);
+    scatter(w, j, w->fine);
+    w->n_windows++;
+}
+
+int ft8_waterfall_rows(const ft8_waterfall_t *w, int ts)
+{
+    return w->n_windows > ts ? (w->n_windows - ts - 1) / FT8_WF_TIME_OSR + 1 : 0;
+}
+
+void ft8_waterfall_rebuild(ft8_waterfall_t *w)
+{
+    w->n_windows = 0;
+    ft8_waterfall_flush(w);
+}
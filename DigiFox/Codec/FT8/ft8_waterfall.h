@@ -0,0 +1,118 @@
+/**
+ * ft8_waterfall.h — Incremental, oversampled FT8 power waterfall
+ *
+ * Accumulates one slot of 12 kHz audio and turns it into symbol-length
+ * power spectra as it arrives: a window starts every quarter symbol
+ * (480 samples, 4× time oversampling), and each is zero-padded to give
+ * bins every half tone (3.125 Hz, 2× frequency oversampling). A window
+ * is transformed as soon as its last sample is fed, so by the end of
+ * the slot the waterfall is already complete.
+ *
+ * The spectra are stored as FT8_WF_SUBGRIDS symbol-rate grids, one per
+ * (time offset, frequency offset): grid (ts, fs) row r, bin b holds the
+ * window starting at (4r + ts) · 480 samples, at (b + fs / 2) · 6.25 Hz.
+ * Within a grid, symbol k of a frame starting at row r is row r + k and
+ * tone t of base bin b is bin b + t, so sync and soft bits read every
+ * grid exactly as they would an unoversampled spectrogram.
+ */
+
+#ifndef FT8_WATERFALL_H
+#define FT8_WATERFALL_H
+
+#include "ft8_spectrogram.h"
+
+#define FT8_WF_TIME_OSR  4
+#define FT8_WF_FREQ_OSR  2
+#define FT8_WF_SUBGRIDS  (FT8_WF_TIME_OSR * FT8_WF_FREQ_OSR)
+
+typedef struct {
+    int symbol_samples;   /* Window length (1920) */
+    int hop;              /* symbol_samples / FT8_WF_TIME_OSR */
+    int max_samples;
+    int max_windows;
+    int max_rows;         /* Rows per grid */
+    int n_bins;           /* Bins per grid (6.25 Hz apart) */
+
+    ft8_spectrogram_t fft;
+
+    float *audio;         /* max_samples: the slot so far */
+    int    n_audio;
+    int    n_windows;     /* Windows transformed */
+
+    float *power;         /* FT8_WF_SUBGRIDS * max_rows * n_bins */
+    float *fine;          /* 2 * FT8_WF_FREQ_OSR * n_bins scratch */
+} ft8_waterfall_t;
+
+/**
+ * Allocate for slots of up to max_samples.
+ *
+ * @param w               Output struct
+ * @param symbol_samples  Samples per symbol
+ * @param max_samples     Slot length in samples (>= symbol_samples)
+ * @param n_bins          Bins kept per grid (<= symbol_samples / 2)
+ * @return 0 on success, -1 on bad size or allocation failure
+ */
+int ft8_waterfall_init(ft8_waterfall_t *w, int symbol_samples, int max_samples,
+                       int n_bins);
+
+void ft8_waterfall_free(ft8_waterfall_t *w);
+
+/**
+ * Start a new slot.
+ */
+void ft8_waterfall_reset(ft8_waterfall_t *w);
+
+/**
+ * Append audio and transform every window it completes. Windows are
+ * transformed in pairs; ft8_waterfall_flush() does a lone last one.
+ *
+ * @return Samples taken (fewer than n once the slot is full)
+ */
+int ft8_waterfall_feed(ft8_waterfall_t *w, const float *audio, int n);
+
+/**
+ * Append audio without transforming it, for windows whose spectra come
+ * from elsewhere (ft8_waterfall_put()).
+ *
+ * @return Samples taken (fewer than n once the slot is full)
+ */
+int ft8_waterfall_append(ft8_waterfall_t *w, const float *audio, int n);
+
+/**
+ * Windows the audio so far completes (transformed or not).
+ */
+int ft8_waterfall_windows_ready(const ft8_waterfall_t *w);
+
+/**
+ * Store the next window's spectrum instead of transforming it: fine
+ * holds FT8_WF_FREQ_OSR * n_bins half-tone bins from DC, as
+ * ft8_spectrogram makes them for this window.
+ */
+void ft8_waterfall_put(ft8_waterfall_t *w, const float *fine);
+
+/**
+ * Transform every complete window still waiting: in pairs, and a lone
+ * last one.
+ */
+void ft8_waterfall_flush(ft8_waterfall_t *w);
+
+/**
+ * Transform every complete window again, after w->audio has been changed
+ * in place (signal subtraction).
+ */
+void ft8_waterfall_rebuild(ft8_waterfall_t *w);
+
+/**
+ * Complete rows of the grids with time offset ts.
+ */
+int ft8_waterfall_rows(const ft8_waterfall_t *w, int ts);
+
+/**
+ * Row 0, bin 0 of grid (ts, fs); rows are n_bins apart.
+ */
+static inline const float *ft8_waterfall_grid(const ft8_waterfall_t *w, int ts, int fs)
+{
+    return w->power + (long)(ts * FT8_WF_FREQ_OSR + fs) * w->max_rows * w->n_bins;
+}
+
+#endif /* FT8_WATERFALL_H */
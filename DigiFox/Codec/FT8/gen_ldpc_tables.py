@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""Generate ft8_ldpc_tables.h: the FT8 and JS8 LDPC(174,91) Tanner graphs.
+
+Both codes are H = [P | I_83]. FT8's P is the table below (the one
+FT8Modulator has always encoded with); JS8's is the column-weight-3
+construction JS8Modulator uses. Each is written as a const
+ft8_ldpc_code_t in compressed-sparse-row form, by check (row_start /
+edge_col) and by variable (col_start / col_edge), so nothing is built
+at run time.
+
+usage: python3 gen_ldpc_tables.py   (run from any directory)
+"""
+
+import os
+
+N, K, M = 174, 91, 83
+MAX_EDGES = 2080                        # FT8_LDPC_MAX_EDGES
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+OUT = os.path.join(HERE, "ft8_ldpc_tables.h")
+
+# Message-bit columns of each FT8 parity check (the P part of H)
+FT8_P = [
+    [0, 1, 2, 3, 4, 6, 7, 10, 11, 12, 15, 17, 19, 24, 27, 29, 31, 33, 36, 44, 45, 47, 51, 55, 58, 61, 63, 67, 73, 79, 82, 84, 86, 89],
+    [0, 5, 6, 8, 9, 11, 13, 14, 16, 18, 20, 25, 28, 30, 32, 34, 37, 42, 46, 48, 52, 56, 59, 62, 64, 68, 72, 78, 83, 85, 87, 88, 90],
+    [1, 2, 3, 4, 7, 8, 9, 10, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 35, 38, 40, 43, 49, 53, 57, 60, 65, 69, 74, 76, 80],
+    [31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 46, 50, 54, 70, 75, 77, 81],
+    [0, 1, 5, 9, 22, 26, 39, 41, 45, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90],
+    [2, 3, 4, 6, 7, 8, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 23, 24, 25, 27, 28, 29, 30, 66, 71],
+    [0, 1, 2, 5, 6, 8, 10, 14, 21, 22, 23, 26, 31, 35, 39, 41, 44, 46, 50, 54, 66, 71, 76, 80, 82, 86, 89],
+    [0, 3, 4, 7, 9, 11, 13, 15, 17, 20, 24, 25, 27, 32, 33, 37, 40, 42, 45, 47, 51, 55, 67, 70, 75, 77, 81, 83, 87, 88],
+    [1, 5, 6, 8, 12, 16, 18, 19, 28, 29, 30, 34, 36, 38, 43, 48, 49, 52, 53, 56, 57, 58, 59, 68, 72, 73, 74, 78, 79, 84, 85, 90],
+    [2, 9, 10, 14, 22, 26, 31, 35, 39, 60, 61, 62, 63, 64, 65, 69, 76, 80, 82, 86],
+    [0, 3, 7, 11, 15, 21, 23, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89],
+    [1, 4, 6, 13, 17, 20, 24, 25, 33, 37, 42, 45, 47, 51, 55, 67, 72, 78, 83, 87],
+    [5, 8, 12, 16, 18, 19, 27, 28, 29, 30, 34, 38, 41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90],
+    [2, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76, 80, 82, 86],
+    [0, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89],
+    [1, 4, 6, 13, 17, 20, 24, 25, 33, 37, 42, 45, 47, 51, 55, 67, 72, 78, 83, 87],
+    [5, 8, 12, 16, 18, 19, 27, 28, 29, 30, 34, 38, 41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90],
+    [0, 2, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76, 80, 82, 86],
+    [3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89],
+    [1, 4, 5, 6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72, 78, 83, 87],
+    [0, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90],
+    [1, 2, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76, 80, 82, 86],
+    [3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89],
+    [0, 4, 5, 6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72, 78, 83, 87],
+    [1, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90],
+    [2, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76, 80, 82, 86],
+    [0, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89],
+    [1, 4, 5, 6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72, 78, 83, 87],
+    [2, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90],
+    [0, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76, 80, 82, 86],
+    [1, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89],
+    [2, 4, 5, 6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72, 78, 83, 87],
+    [0, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90],
+    [1, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76, 80, 82, 86],
+    [2, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89],
+    [0, 4, 5, 6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72, 78, 83, 87],
+    [1, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90],
+    [2, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76, 80, 82, 86],
+    [0, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89],
+    [1, 4, 5, 6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72, 78, 83, 87],
+    [2, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90],
+    [0, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76, 80, 82, 86],
+    [1, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89],
+    [2, 4, 5, 6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72, 78, 83, 87],
+    [0, 1, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90],
+    [2, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76, 80, 82, 86],
+    [0, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89],
+    [1, 4, 5, 6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72, 78, 83, 87],
+    [2, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90],
+    [0, 1, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76, 80, 82, 86],
+    [2, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89],
+    [0, 4, 5, 6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72, 78, 83, 87],
+    [1, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90],
+    [2, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76, 80, 82, 86],
+    [0, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89],
+    [1, 4, 5, 6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72, 78, 83, 87],
+    [2, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90],
+    [0, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76, 80, 82, 86],
+    [1, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89],
+    [0, 2, 4, 5, 6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72, 78, 83, 87],
+    [1, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90],
+    [2, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76, 80, 82, 86],
+    [0, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89],
+    [1, 4, 5, 6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72, 78, 83, 87],
+    [2, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90],
+    [0, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76, 80, 82, 86],
+    [1, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89],
+    [2, 4, 5, 6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72, 78, 83, 87],
+    [0, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90],
+    [1, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76, 80, 82, 86],
+    [2, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89],
+    [0, 4, 5, 6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72, 78, 83, 87],
+    [1, 2, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90],
+    [0, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76, 80, 82, 86],
+    [1, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89],
+    [2, 4, 5, 6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72, 78, 83, 87],
+    [0, 1, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90],
+    [2, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76, 80, 82, 86],
+    [0, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89],
+    [1, 4, 5, 6, 8, 13, 16, 17, 18, 20, 24, 25, 27, 33, 37, 42, 45, 47, 51, 55, 67, 72, 78, 83, 87],
+    [2, 12, 19, 28, 29, 30, 34, 38, 41, 43, 46, 48, 49, 52, 53, 56, 68, 73, 74, 79, 84, 85, 88, 90],
+    [0, 1, 9, 10, 14, 22, 26, 35, 39, 57, 58, 59, 60, 61, 62, 63, 64, 65, 69, 76, 80, 82, 86],
+    [2, 3, 7, 11, 15, 21, 23, 31, 32, 36, 40, 44, 50, 54, 66, 70, 71, 75, 77, 81, 89],
+]
+
+
+def js8_p():
+    """Message bit c sits in checks c mod 83, (7c + 13) mod 83 and
+    (11c + 37) mod 83, each moved to the next free check when taken."""
+    rows = [[] for _ in range(M)]
+    for c in range(K):
+        r0 = c % M
+        r1 = (c * 7 + 13) % M
+        while r1 == r0:
+            r1 = (r1 + 1) % M
+        r2 = (c * 11 + 37) % M
+        while r2 in (r0, r1):
+            r2 = (r2 + 1) % M
+        for r in (r0, r1, r2):
+            rows[r].append(c)
+    return [sorted(r) for r in rows]
+
+
+def csr(p):
+    """Check-node and variable-node edge arrays of H = [P | I]."""
+    row_start, edge_col = [], []
+    for m, cols in enumerate(p):
+        row_start.append(len(edge_col))
+        edge_col += cols + [K + m]
+    row_start.append(len(edge_col))
+    assert len(edge_col) <= MAX_EDGES
+
+    col_start, col_edge = [], []
+    for n in range(N):
+        col_start.append(len(col_edge))
+        col_edge += [e for e, col in enumerate(edge_col) if col == n]
+    col_start.append(len(col_edge))
+    return row_start, edge_col, col_start, col_edge
+
+
+def array(values, per_line=16):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append("        " + ", ".join(str(v) for v in values[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def code(name, p):
+    row_start, edge_col, col_start, col_edge = csr(p)
+    return (
+        f"static const ft8_ldpc_code_t {name} = {{\n"
+        f"    .n_edges = {len(edge_col)},\n"
+        f"    .row_start = {{\n{array(row_start)}\n    }},\n"
+        f"    .edge_col = {{\n{array(edge_col)}\n    }},\n"
+        f"    .col_start = {{\n{array(col_start)}\n    }},\n"
+        f"    .col_edge = {{\n{array(col_edge)}\n    }},\n"
+        f"}};\n"
+    )
+
+
+def main():
+    with open(OUT, "w") as f:
+        f.write(
+            "/**\n"
+            " * ft8_ldpc_tables.h — FT8 and JS8 LDPC(174,91) Tanner graphs (generated)\n"
+            " *\n"
+            " * Generated by gen_ldpc_tables.py — do not edit. Included by\n"
+            " * ft8_ldpc.c only; use ft8_ldpc_ft8() / ft8_ldpc_js8().\n"
+            " */\n\n"
+            "#ifndef FT8_LDPC_TABLES_H\n"
+            "#define FT8_LDPC_TABLES_H\n\n"
+            "#include \"ft8_ldpc.h\"\n\n")
+        f.write(code("FT8_LDPC_CODE", FT8_P))
+        f.write("\n")
+        f.write(code("JS8_LDPC_CODE", js8_p()))
+        f.write("\n#endif /* FT8_LDPC_TABLES_H */\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,305 @@
+/**
+ * spectrum_engine.c — Paired-window STFT into a release-published row ring
+ */
+
+#include "spectrum_engine.h"
+#include "ft8_spectrogram.h"
+
+#include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct spectrum_engine_t {
+    spectrum_engine_config_t cfg;
+    ft8_spectrogram_t fft;
+    float  noise_gain;             /* 1 / Σ window²: white noise → σ² */
+
+    /* Producer: samples not yet fully used, from the next window's start */
+    float *audio;                  /* window + 2 · hop */
+    int    audio_cap;
+    int    n_audio;
+
+    float   *rows;                 /* capacity · n_bins */
+    uint64_t capacity;             /* Rows, power of two */
+    uint64_t mask;
+
+    _Atomic int      sample_rate;
+    _Atomic uint64_t samples;
+    _Atomic uint64_t written;      /* Rows complete */
+    _Atomic uint64_t reserved;     /* Rows complete or being written */
+};
+
+void spectrum_engine_config_init(spectrum_engine_config_t *cfg)
+{
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->sample_rate    = 12000;
+    cfg->window_samples = 1920;
+    cfg->hop_samples    = 480;
+    cfg->n_fft          = 3840;
+    cfg->n_bins         = 1920;
+    cfg->history_rows   = 256;
+}
+
+spectrum_engine_t *spectrum_engine_create(const spectrum_engine_config_t *cfg)
+{
+    spectrum_engine_t *eng = (spectrum_engine_t *)calloc(1, sizeof(spectrum_engine_t));
+    if (!eng) return NULL;
+
+    if (cfg) {
+        eng->cfg = *cfg;
+    } else {
+        spectrum_engine_config_init(&eng->cfg);
+    }
+    spectrum_engine_config_t *c = &eng->cfg;
+    if (c->hop_samples < 1 || c->hop_samples > c->window_samples) {
+        free(eng);
+        return NULL;
+    }
+    if (c->n_bins > c->n_fft / 2) c->n_bins = c->n_fft / 2;
+    if (c->n_bins > SPECTRUM_ENGINE_MAX_BINS) c->n_bins = SPECTRUM_ENGINE_MAX_BINS;
+    if (c->history_rows < 2) c->history_rows = 2;
+    if (c->sample_rate < 1) c->sample_rate = 12000;
+
+    if (ft8_spectrogram_init(&eng->fft, c->window_samples, c->n_fft, c->n_bins) != 0) {
+        spectrum_engine_destroy(eng);
+        return NULL;
+    }
+
+    double energy = 0.0;
+    for (int k = 0; k < c->window_samples; k++) energy += (double)eng->fft.window[k] * eng->fft.window[k];
+    eng->noise_gain = (float)(1.0 / energy);
+
+    uint64_t want = (uint64_t)c->history_rows + (uint64_t)c->history_rows / 4;
+    eng->capacity = 2;
+    while (eng->capacity < want) eng->capacity <<= 1;
+    eng->mask = eng->capacity - 1;
+
+    eng->audio_cap = c->window_samples + 2 * c->hop_samples;
+    eng->audio = (float *)calloc((size_t)eng->audio_cap, sizeof(float));
+    eng->rows = (float *)calloc((size_t)eng->capacity * c->n_bins, sizeof(float));
+    if (!eng->audio || !eng->rows) {
+        spectrum_engine_destroy(eng);
+        return NULL;
+    }
+
+    atomic_init(&eng->sample_rate, c->sample_rate);
+    atomic_init(&eng->samples, 0);
+    atomic_init(&eng->written, 0);
+    atomic_init(&eng->reserved, 0);
+    return eng;
+}
+
+int spectrum_engine_bins(const spectrum_engine_t *eng)      { return eng->cfg.n_bins; }
+int spectrum_engine_hop(const spectrum_engine_t *eng)       { return eng->cfg.hop_samples; }
+int spectrum_engine_window(const spectrum_engine_t *eng)    { return eng->cfg.window_samples; }
+int spectrum_engine_fft_size(const spectrum_engine_t *eng)  { return eng->cfg.n_fft; }
+
+int spectrum_engine_sample_rate(const spectrum_engine_t *eng)
+{
+    return atomic_load_explicit(&((spectrum_engine_t *)eng)->sample_rate, memory_order_relaxed);
+}
+
+void spectrum_engine_set_sample_rate(spectrum_engine_t *eng, int sample_rate)
+{
+    if (sample_rate < 1) return;
+    atomic_store_explicit(&eng->sample_rate, sample_rate, memory_order_relaxed);
+}
+
+/* ------------------------------------------------------------------ */
+/* Producer                                                            */
+/* ------------------------------------------------------------------ */
+
+static float *row_slot(const spectrum_engine_t *eng, uint64_t k)
+{
+    return eng->rows + (size_t)(k & eng->mask) * eng->cfg.n_bins;
+}
+
+/* Windows at audio[0] and audio[hop] → the next two rows */
+static void transform_pair(spectrum_engine_t *eng)
+{
+    const int hop = eng->cfg.hop_samples;
+    uint64_t w = atomic_load_explicit(&eng->written, memory_order_relaxed);
+
+    /* Claim the slots before touching them, so readers can tell */
+    atomic_store_explicit(&eng->reserved, w + 2, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    ft8_spectrogram_pair(&eng->fft, eng->audio, eng->audio + hop,
+                         row_slot(eng, w), row_slot(eng, w + 1));
+
+    atomic_store_explicit(&eng->written, w + 2, memory_order_release);
+
+    eng->n_audio -= 2 * hop;
+    memmove(eng->audio, eng->audio + 2 * hop, (size_t)eng->n_audio * sizeof(float));
+}
+
+void spectrum_engine_feed(spectrum_engine_t *eng, const float *audio, int n)
+{
+    if (!eng || !audio || n <= 0) return;
+
+    const int need = eng->cfg.window_samples + eng->cfg.hop_samples;
+    atomic_fetch_add_explicit(&eng->samples, (uint64_t)n, memory_order_relaxed);
+
+    while (n > 0) {
+        int take = eng->audio_cap - eng->n_audio;
+        if (take > n) take = n;
+        memcpy(eng->audio + eng->n_audio, audio, (size_t)take * sizeof(float));
+        eng->n_audio += take;
+        audio += take;
+        n -= take;
+
+        while (eng->n_audio >= need) transform_pair(eng);
+    }
+}
+
+uint64_t spectrum_engine_samples(const spectrum_engine_t *eng)
+{
+    return atomic_load_explicit(&((spectrum_engine_t *)eng)->samples, memory_order_relaxed);
+}
+
+uint64_t spectrum_engine_rows(const spectrum_engine_t *eng)
+{
+    return atomic_load_explicit(&((spectrum_engine_t *)eng)->written, memory_order_acquire);
+}
+
+/* ------------------------------------------------------------------ */
+/* Readers                                                             */
+/* ------------------------------------------------------------------ */
+
+/* True if rows from k on have not been reused, nor are being */
+static int rows_intact(const spectrum_engine_t *eng, uint64_t k)
+{
+    /* Order the caller's reads of the rows before the check */
+    atomic_thread_fence(memory_order_acquire);
+    uint64_t claimed = atomic_load_explicit(&((spectrum_engine_t *)eng)->reserved,
+                                            memory_order_relaxed);
+    return claimed - k <= eng->capacity;
+}
+
+/* Oldest row still kept when w rows are complete */
+static uint64_t oldest_row(const spectrum_engine_t *eng, uint64_t w)
+{
+    uint64_t h = (uint64_t)eng->cfg.history_rows;
+    return w > h ? w - h : 0;
+}
+
+int spectrum_engine_row(const spectrum_engine_t *eng, uint64_t k, int bin0, int n,
+                        float *dst)
+{
+    if (bin0 < 0 || n < 0 || bin0 + n > eng->cfg.n_bins) return -1;
+
+    uint64_t w = spectrum_engine_rows(eng);
+    if (k >= w) return 1;
+    if (k < oldest_row(eng, w)) return -1;
+
+    memcpy(dst, row_slot(eng, k) + bin0, (size_t)n * sizeof(float));
+    return rows_intact(eng, k) ? 0 : -1;
+}
+
+int spectrum_engine_view(const spectrum_engine_t *eng, uint64_t *next, int rows_per_line,
+                         int bins_per_cell, float *dst, int max_lines)
+{
+    if (!eng || !next || !dst || rows_per_line < 1 || bins_per_cell < 1) return 0;
+
+    const int n_cells = eng->cfg.n_bins / bins_per_cell;
+    const float scale = eng->noise_gain / ((float)rows_per_line * bins_per_cell);
+    uint64_t w = spectrum_engine_rows(eng);
+    uint64_t first = *next;
+    int lines = 0;
+
+    if (first > w) first = w;
+    while (lines < max_lines) {
+        if (first < oldest_row(eng, w)) first = oldest_row(eng, w);
+        if (w - first < (uint64_t)rows_per_line) break;
+
+        float *line = dst + (size_t)lines * n_cells;
+        memset(line, 0, (size_t)n_cells * sizeof(float));
+        for (int r = 0; r < rows_per_line; r++) {
+            const float *p = row_slot(eng, first + r);
+            for (int c = 0; c < n_cells; c++) {
+                const float *b = p + c * bins_per_cell;
+                float s = 0.0f;
+                for (int j = 0; j < bins_per_cell; j++) s += b[j];
+                line[c] += s;
+            }
+        }
+        if (!rows_intact(eng, first)) {
+            /* Overwritten under us: start again from what is kept now */
+            w = spectrum_engine_rows(eng);
+            continue;
+        }
+
+        for (int c = 0; c < n_cells; c++) line[c] = 10.0f * log10f(line[c] * scale);
+        first += rows_per_line;
+        lines++;
+    }
+    *next = first;
+    return lines;
+}
+
+int spectrum_engine_peaks(const spectrum_engine_t *eng, float span_s, float f_min,
+                          float f_max, float min_spacing, float *dst, int n_taken, int n)
+{
+    if (!eng || !dst || n_taken < 0) return 0;
+
+    const int rate = spectrum_engine_sample_rate(eng);
+    const float df = (float)rate / eng->cfg.n_fft;
+    int span = (int)lrintf(span_s * rate / eng->cfg.hop_samples);
+    if (span < 1) span = 1;
+    if (span > eng->cfg.history_rows) span = eng->cfg.history_rows;
+
+    int j0 = (int)ceilf(f_min / df);
+    int j1 = (int)floorf(f_max / df);
+    if (j0 < 0) j0 = 0;
+    if (j1 > eng->cfg.n_bins - 1) j1 = eng->cfg.n_bins - 1;
+    if (j1 < j0) return n_taken;
+    const int width = j1 - j0 + 1;
+
+    /* Band power, with a zero bin either side as STFFT has outside the band */
+    float band[SPECTRUM_ENGINE_MAX_BINS + 2];
+    int ok = 0;
+    for (int attempt = 0; attempt < 3 && !ok; attempt++) {
+        uint64_t w = spectrum_engine_rows(eng);
+        if (w == 0) return n_taken;
+        uint64_t first = w > (uint64_t)span ? w - (uint64_t)span : 0;
+
+        memset(band, 0, (size_t)(width + 2) * sizeof(float));
+        for (uint64_t k = first; k < w; k++) {
+            const float *p = row_slot(eng, k) + j0;
+            for (int j = 0; j < width; j++) band[j + 1] += p[j];
+        }
+        ok = rows_intact(eng, first);
+    }
+    if (!ok) return n_taken;
+
+    while (n_taken < n) {
+        float best = 0.0f, pitch = 0.0f;
+        for (int j = 1; j <= width; j++) {
+            float s = band[j];
+            if (s <= best || s < band[j - 1] || s < band[j + 1]) continue;
+
+            float f = (float)(j0 + j - 1) * df;
+            int free_pitch = 1;
+            for (int k = 0; k < n_taken; k++) {
+                if (fabsf(f - dst[k]) < min_spacing) free_pitch = 0;
+            }
+            if (!free_pitch) continue;
+
+            best = s;
+            pitch = f;
+        }
+        if (best <= 0.0f) break;
+        dst[n_taken++] = pitch;
+    }
+    return n_taken;
+}
+
+void spectrum_engine_destroy(spectrum_engine_t *eng)
+{
+    if (!eng) return;
+    ft8_spectrogram_free(&eng->fft);
+    free(eng->audio);
+    free(eng->rows);
+    free(eng);
+}
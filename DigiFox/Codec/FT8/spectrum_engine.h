@@ -0,0 +1,136 @@
+/**
+ * spectrum_engine.h — One shared STFT of the receive audio
+ *
+ * The input is transformed once, as it arrives, and every consumer
+ * reads the rows it needs instead of running its own FFT: the FT8
+ * decoder takes them as its waterfall windows, the display pulls
+ * averaged dB lines, and the CW decoder asks for the pitch peaks.
+ *
+ * Row k is the power spectrum of the window starting at stream sample
+ * k · hop (samples counted since creation). The defaults are the FT8
+ * waterfall's: 1920-sample Hann windows every 480 samples, zero-padded
+ * to 3840, so at 12 kHz a row is 3.125 Hz per bin from DC to Nyquist
+ * and one arrives every 40 ms. Windows go through ft8_spectrogram two
+ * at a time, so the newest row can lag its last sample by one hop.
+ *
+ * One producer feeds audio and never waits. Rows are kept in a ring of
+ * at least history_rows; the row count is published with release
+ * ordering after the rows, and readers on any thread check after
+ * copying that the producer has not reused the slots meanwhile, as in
+ * sample_ring. All memory is allocated in spectrum_engine_create().
+ */
+
+#ifndef SPECTRUM_ENGINE_H
+#define SPECTRUM_ENGINE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SPECTRUM_ENGINE_MAX_BINS  4096
+
+/* Opaque engine handle */
+typedef struct spectrum_engine_t spectrum_engine_t;
+
+typedef struct {
+    int sample_rate;      /* Hz, only for bin frequencies (12000) */
+    int window_samples;   /* Window length (1920) */
+    int hop_samples;      /* Window start spacing (480) */
+    int n_fft;            /* Zero-padded DFT length, factors 2, 3, 5 (3840) */
+    int n_bins;           /* Bins per row from DC (n_fft / 2) */
+    int history_rows;     /* Rows kept for readers (256, ~10 s) */
+} spectrum_engine_config_t;
+
+/**
+ * Initialize config with defaults.
+ */
+void spectrum_engine_config_init(spectrum_engine_config_t *cfg);
+
+/**
+ * Create an engine. NULL cfg = defaults; n_bins and history_rows are
+ * clamped to what the transform allows.
+ * Returns NULL on a bad window/FFT size or allocation failure.
+ */
+spectrum_engine_t *spectrum_engine_create(const spectrum_engine_config_t *cfg);
+
+/* Bins per row */
+int spectrum_engine_bins(const spectrum_engine_t *eng);
+
+/* Window start spacing in samples */
+int spectrum_engine_hop(const spectrum_engine_t *eng);
+
+/* Window length in samples */
+int spectrum_engine_window(const spectrum_engine_t *eng);
+
+/* Zero-padded DFT length */
+int spectrum_engine_fft_size(const spectrum_engine_t *eng);
+
+/**
+ * Sample rate the bin frequencies refer to. Set it when the input
+ * changes rate; rows already made keep their old spacing.
+ */
+int spectrum_engine_sample_rate(const spectrum_engine_t *eng);
+void spectrum_engine_set_sample_rate(spectrum_engine_t *eng, int sample_rate);
+
+/**
+ * Producer: append n samples and transform every window pair they
+ * complete. Never blocks.
+ */
+void spectrum_engine_feed(spectrum_engine_t *eng, const float *audio, int n);
+
+/**
+ * Samples fed since creation: the stream index the next feed starts at.
+ */
+uint64_t spectrum_engine_samples(const spectrum_engine_t *eng);
+
+/**
+ * Rows complete; row k covers samples k · hop .. k · hop + window.
+ */
+uint64_t spectrum_engine_rows(const spectrum_engine_t *eng);
+
+/**
+ * Copy bins bin0 .. bin0 + n of row k (power, window gain included).
+ *
+ * @return 0 on success, 1 if the row is not made yet, -1 if it has been
+ *         overwritten (or the bins are out of range); dst is only valid
+ *         on 0
+ */
+int spectrum_engine_row(const spectrum_engine_t *eng, uint64_t k, int bin0, int n,
+                        float *dst);
+
+/**
+ * Display lines: each averages rows_per_line rows and bins_per_cell
+ * adjacent bins into n_bins / bins_per_cell cells in dB, scaled so
+ * white noise reads its variance (10 · log10 σ²).
+ *
+ * @param next   In: first row not yet shown (0 = start). Out: past the
+ *               rows used. Rows already overwritten are skipped.
+ * @param dst    max_lines · (n_bins / bins_per_cell) floats
+ * @return Lines written, oldest first
+ */
+int spectrum_engine_view(const spectrum_engine_t *eng, uint64_t *next, int rows_per_line,
+                         int bins_per_cell, float *dst, int max_lines);
+
+/**
+ * Pitches over the newest span_s of rows: fills dst[n_taken .. n) with
+ * the strongest local peaks of the summed power between f_min and
+ * f_max, strongest first, each at least min_spacing Hz from every pitch
+ * already in dst (ggmorse's STFFT::pitches() contract).
+ *
+ * @return Number of pitches in dst
+ */
+int spectrum_engine_peaks(const spectrum_engine_t *eng, float span_s, float f_min,
+                          float f_max, float min_spacing, float *dst, int n_taken, int n);
+
+/**
+ * Destroy engine and free all resources.
+ */
+void spectrum_engine_destroy(spectrum_engine_t *eng);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPECTRUM_ENGINE_H */
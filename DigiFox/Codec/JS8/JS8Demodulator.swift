@@ -1,95 +1,196 @@
 import Foundation
 
-class JS8Demodulator {
-    private let ldpc = LDPCCodec()
-    private let fft: FFTProcessor
+/// JS8 Demodulator — RX chain for every submode at once.
+///
+/// Live audio is taken from the sample ring the audio thread writes
+/// (`start`) by `pump`, off the audio thread, into the native decoder's
+/// capture ring (`js8_decoder.h`), shared by all speeds; the audio thread
+/// never waits for the decoder. Each speed is due at the end of its own
+/// cycle on the UTC clock. `decodeDue` then searches every due speed's
+/// waterfall side by side on separate cores and decodes their candidates
+/// in one LDPC batch, so watching all five speeds costs about what one
+/// did. Only the 77 payload bits of each decode come back to Swift for
+/// unpacking.
+final class JS8Demodulator {
 
-    init(fftSize: Int = 4096) {
-        self.fft = FFTProcessor(size: fftSize)
+    /// Speeds decoded; the rest are not searched at all.
+    var speeds: Set<JS8Speed> = Set(JS8Speed.allCases) { didSet { rebuild() } }
+
+    /// Minimum Costas correlation score to consider a candidate.
+    var syncThreshold: Double = 4.0 { didSet { rebuild() } }
+
+    /// Candidates tried per speed and cycle.
+    var maxCandidates: Int = 20 { didSet { rebuild() } }
+
+    /// Searched base frequencies (Hz).
+    var frequencyRange: ClosedRange<Double> = 100...3000 { didSet { rebuild() } }
+
+    /// Threads sharing the search and LDPC work; 0 = one per performance core.
+    var decodeThreads: Int = 0 { didSet { rebuild() } }
+
+    /// Score the Costas search on the GPU, as `FT8Demodulator.gpuSync`.
+    var gpuSync: Bool = false { didSet { rebuild() } }
+
+    /// Native decoder, built in `init` and again when a setting changes.
+    private var decoder: OpaquePointer?
+    private var results = [js8_result_t](repeating: js8_result_t(), count: 64)
+    private var due: UInt32 = 0
+    private let lock = NSLock()
+
+    /// Live audio (`start`): the ring, the sample clock of its index 0
+    /// and the index receiving started at.
+    private var source: SampleRing?
+    private var clockBase: Int64 = 0
+    private var started: UInt64 = 0
+    /// Ring index of the next sample to hand to the decoder.
+    private var next: UInt64 = 0
+
+    init() {
+        rebuild()
+    }
+
+    deinit {
+        if let dec = decoder { js8_decoder_destroy(dec) }
+    }
+
+    // MARK: - Public API
+
+    /// Decode one buffer of one speed, starting at its cycle start.
+    func demodulate(samples: [Float], speed: JS8Speed) -> [DemodResult] {
+        samples.withUnsafeBufferPointer { demodulate(samples: $0, speed: speed) }
+    }
+
+    /// `demodulate` on audio in place, e.g. a window of `AudioEngine`'s buffer.
+    /// Live audio is taken from the ring again afterwards.
+    func demodulate(samples: UnsafeBufferPointer<Float>, speed: JS8Speed) -> [DemodResult] {
+        lock.lock()
+        defer { lock.unlock() }
+
+        guard let base = samples.baseAddress, !samples.isEmpty, speeds.contains(speed),
+              let dec = decoder else { return [] }
+
+        let n = results.withUnsafeMutableBufferPointer { out in
+            js8_decoder_decode(dec, base, Int32(samples.count), Int32(speed.rawValue),
+                               out.baseAddress, Int32(out.count))
+        }
+        restart(dec)
+        return messages(Int(n))
+    }
+
+    /// Receive live audio from `ring`, written by the audio thread; the
+    /// sample at index `ring.written` is taken as heard at `date`, which
+    /// places every speed's cycles on the UTC clock.
+    func start(ring: SampleRing?, at date: Date = Date()) {
+        lock.lock()
+        defer { lock.unlock() }
+
+        source = ring
+        let written = ring?.written ?? 0
+        clockBase = Self.clock(date) - Int64(written)
+        started = written
+        next = written
+        if let dec = decoder { js8_decoder_reset(dec, clockBase + Int64(next)) }
+        due = 0
     }
 
-    func demodulate(samples: [Float], speed: JS8Speed, freqRange: ClosedRange<Double> = 100...3000) -> [DemodResult] {
-        let nsps = speed.symbolSamples
-        let ts = JS8Protocol.toneSpacing(for: speed)
-        let nSymbols = samples.count / nsps
-        guard nSymbols >= JS8Protocol.symbolCount else { return [] }
-
-        // Compute spectrogram
-        var spectrogram = [[Float]]()
-        for i in 0..<nSymbols {
-            let start = i * nsps
-            let end = min(start + nsps, samples.count)
-            spectrogram.append(fft.magnitudeSpectrum(Array(samples[start..<end])))
+    /// Hand the decoder the live audio that arrived since the last call,
+    /// off the audio thread. Returns whether some speed's cycle has ended
+    /// and waits for `decodeDue`.
+    @discardableResult
+    func pump() -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+
+        guard let dec = decoder, let ring = source else { return due != 0 }
+        let (fed, end) = ring.withIndexedWindow(from: next) { buf, first -> UInt32? in
+            guard let base = buf.baseAddress, !buf.isEmpty else { return nil }
+            // Fell behind the ring's history: the gap starts a new capture
+            if first != next { js8_decoder_reset(dec, clockBase + Int64(first)) }
+            return js8_decoder_feed(dec, base, Int32(buf.count))
         }
+        if let fed { due = fed }
+        next = end
+        return due != 0
+    }
 
-        // Find signals via Costas correlation
-        let candidates = JS8CostasSync.correlate(spectrum: spectrogram, toneSpacing: ts, freqRange: freqRange)
+    /// Decode every speed whose cycle has ended since the last call.
+    func decodeDue() -> [DemodResult] {
+        lock.lock()
+        defer { lock.unlock() }
 
-        var results = [DemodResult]()
-        for c in candidates {
-            if let r = demodCandidate(spectrogram: spectrogram, t0: c.timeOffset, freq: c.freqOffset, ts: ts, nsps: nsps) {
-                results.append(r)
-            }
+        guard let dec = decoder, due != 0 else { return [] }
+        let n = results.withUnsafeMutableBufferPointer { out in
+            js8_decoder_decode_due(dec, out.baseAddress, Int32(out.count))
         }
-        return results
+        due = 0
+        return messages(Int(n))
     }
 
-    private func demodCandidate(spectrogram: [[Float]], t0: Int, freq: Double, ts: Double, nsps: Int) -> DemodResult? {
-        let binW = JS8Protocol.sampleRate / Double(fft.size)
-        let baseBin = Int(freq / binW)
-        let toneBins = max(1, Int(ts / binW))
-
-        // Extract soft symbols
-        var llr = [Double](repeating: 0, count: JS8Protocol.codewordBits)
-        for (si, pos) in JS8Protocol.dataPositions.enumerated() {
-            let idx = t0 + pos
-            guard idx < spectrogram.count else { return nil }
-            var energies = [Double](repeating: 0, count: 8)
-            for tone in 0..<8 {
-                let bin = baseBin + tone * toneBins
-                if bin >= 0 && bin < spectrogram[idx].count {
-                    energies[tone] = Double(spectrogram[idx][bin])
-                }
-            }
-            for bit in 0..<3 {
-                var p0: Double = 0, p1: Double = 0
-                for tone in 0..<8 {
-                    if (tone >> (2 - bit)) & 1 == 0 { p0 += energies[tone] } else { p1 += energies[tone] }
-                }
-                llr[si * 3 + bit] = log(max(p0, 1e-10) / max(p1, 1e-10))
-            }
+    /// Drop the capture and take the live audio since `start` again, as
+    /// much of it as the ring still has (cycles longer than the ring's
+    /// history start over).
+    private func restart(_ dec: OpaquePointer) {
+        due = 0
+        guard let ring = source else {
+            js8_decoder_reset(dec, Self.clock(Date()))
+            return
         }
+        let written = ring.written
+        let history = UInt64(ring.history)
+        next = max(started, written > history ? written - history : 0)
+        js8_decoder_reset(dec, clockBase + Int64(next))
+    }
 
-        guard let decoded = ldpc.decode(llr) else { return nil }
-        guard JS8CRC.validate(decoded) else { return nil }
+    private func messages(_ n: Int) -> [DemodResult] {
+        results.prefix(n).map { r in
+            let payload = withUnsafeBytes(of: r.payload) { Array($0) }
+            let message = PackMessage.unpack(payload)
+            // Calls heard here resolve FT8 hashed calls too
+            let directed = PackMessage.parseDirected(message)
+            if let from = directed.from { CallsignTable.shared.record(from) }
+            if let to = directed.to { CallsignTable.shared.record(to) }
 
-        let message = PackMessage.unpack(Array(decoded.prefix(JS8Protocol.payloadBits)))
-        let snr = estimateSNR(spectrogram: spectrogram, t0: t0, baseBin: baseBin, toneBins: toneBins)
+            return DemodResult(
+                frequency: Double(r.freq_hz),
+                snr: Double(r.snr),
+                deltaTime: Double(r.time_s),
+                bits: payload,
+                message: message,
+                speed: JS8Speed(rawValue: Int(r.submode)) ?? .normal
+            )
+        }
+    }
 
-        return DemodResult(
-            frequency: freq,
-            snr: snr,
-            deltaTime: Double(t0 * nsps) / JS8Protocol.sampleRate,
-            bits: decoded,
-            message: message
-        )
+    /// Samples since midnight UTC: every cycle divides 10 minutes, so
+    /// any whole-10-minute epoch puts the boundaries on the UTC grid.
+    private static func clock(_ date: Date) -> Int64 {
+        let seconds = date.timeIntervalSince1970.truncatingRemainder(dividingBy: 86_400)
+        return Int64(seconds * JS8Protocol.sampleRate)
     }
 
-    private func estimateSNR(spectrogram: [[Float]], t0: Int, baseBin: Int, toneBins: Int) -> Double {
-        var signal: Double = 0, noise: Double = 0, sc = 0, nc = 0
-        for i in 0..<7 {
-            let si = t0 + i
-            guard si < spectrogram.count else { continue }
-            let bin = baseBin + JS8Protocol.costas[i] * toneBins
-            if bin >= 0 && bin < spectrogram[si].count { signal += Double(spectrogram[si][bin]); sc += 1 }
-            for off in [-2, -1, 1, 2] {
-                let nb = bin + off * toneBins
-                if nb >= 0 && nb < spectrogram[si].count { noise += Double(spectrogram[si][nb]); nc += 1 }
-            }
+    // MARK: - Native Decoder
+
+    /// (Re)build the native decoder with the current settings, on the
+    /// caller's thread, and take the live audio from the ring again.
+    private func rebuild() {
+        var cfg = js8_config_t()
+        js8_config_init(&cfg)
+        cfg.min_freq = Float(frequencyRange.lowerBound)
+        cfg.max_freq = Float(frequencyRange.upperBound)
+        cfg.sync_threshold = Float(syncThreshold)
+        cfg.max_candidates = Int32(maxCandidates)
+        cfg.submodes = speeds.reduce(UInt32(0)) { $0 | (UInt32(1) << UInt32($1.rawValue)) }
+        cfg.threads = Int32(decodeThreads)
+        if gpuSync, let gpu = ft8_sync_metal_shared() {
+            cfg.sync_score = ft8_sync_metal_score
+            cfg.sync_ctx = UnsafeMutableRawPointer(gpu)
         }
-        guard sc > 0 && nc > 0 else { return 0 }
-        let avgN = noise / Double(nc)
-        guard avgN > 0 else { return 30 }
-        return 10 * log10((signal / Double(sc)) / avgN)
+        let built = js8_decoder_create(&cfg)
+
+        lock.lock()
+        defer { lock.unlock() }
+        if let dec = decoder { js8_decoder_destroy(dec) }
+        decoder = built
+        if let dec = decoder { restart(dec) }
     }
 }
@@ -3,7 +3,24 @@ import Foundation
 class JS8Modulator {
     private let ldpc = LDPCCodec()
 
+    /// One GFSK synthesizer per submode, built on first use.
+    private var synthesizers = [JS8Speed: ToneSynthesizer]()
+
     func modulate(message: String, frequency: Double, speed: JS8Speed) -> [Float] {
+        generateAudio(symbols: tones(for: message), frequency: frequency, speed: speed)
+    }
+
+    /// Stream a message: 12 kHz audio rendered block by block as the
+    /// output pulls it, from a synthesizer of its own.
+    func source(message: String, frequency: Double, speed: JS8Speed) -> TXAudioSource? {
+        guard let synth = makeSynthesizer(speed: speed),
+              synth.start(tones: tones(for: message), baseFrequency: frequency, amplitude: 1.0)
+        else { return nil }
+        return synth
+    }
+
+    /// Message → 79 channel tones.
+    func tones(for message: String) -> [Int] {
         let payload = PackMessage.pack(message)
         let withCRC = JS8CRC.append(to: payload)
         let codeword = ldpc.encode(withCRC)
@@ -24,34 +41,18 @@ class JS8Modulator {
             symbols[pos] = dataSymbols[di]
         }
 
-        return generateAudio(symbols: symbols, frequency: frequency, speed: speed)
+        return symbols
     }
 
+    /// Continuous-phase GFSK (BT = 2.0, as JS8Call sends it) with a 5 ms ramp.
     private func generateAudio(symbols: [Int], frequency: Double, speed: JS8Speed) -> [Float] {
-        let nsps = speed.symbolSamples
-        let ts = JS8Protocol.toneSpacing(for: speed)
-        let sr = JS8Protocol.sampleRate
-        let total = nsps * symbols.count
-        var audio = [Float](repeating: 0, count: total)
-        var phase: Double = 0
-
-        for (si, sym) in symbols.enumerated() {
-            let freq = frequency + Double(sym) * ts
-            let dphi = 2.0 * .pi * freq / sr
-            for j in 0..<nsps {
-                audio[si * nsps + j] = Float(sin(phase))
-                phase += dphi
-                if phase > 2.0 * .pi { phase -= 2.0 * .pi }
-            }
-        }
+        if synthesizers[speed] == nil { synthesizers[speed] = makeSynthesizer(speed: speed) }
+        guard let synth = synthesizers[speed] else { return [] }
+        return synth.renderFrame(tones: symbols, baseFrequency: frequency, amplitude: 1.0)
+    }
 
-        // Raised-cosine ramp (5ms)
-        let ramp = Int(0.005 * sr)
-        for i in 0..<min(ramp, total) {
-            let w = Float(0.5 * (1.0 - cos(.pi * Double(i) / Double(ramp))))
-            audio[i] *= w
-            audio[total - 1 - i] *= w
-        }
-        return audio
+    private func makeSynthesizer(speed: JS8Speed) -> ToneSynthesizer? {
+        ToneSynthesizer(sampleRate: JS8Protocol.sampleRate, symbolSamples: speed.symbolSamples,
+                        bt: 2.0, rampDuration: 0.005)
     }
 }
@@ -0,0 +1,252 @@
+/**
+ * js8_bench.c — Standalone benchmark for the C JS8 decoder core
+ *
+ * Synthesizes one continuous capture (default 120 s, one ultra cycle)
+ * holding N signals per cycle of every submode. Each submode gets its
+ * own slice of the band; a signal sends a random payload as JS8Modulator
+ * does (continuous-phase 8-FSK, bits as tone numbers) and starts 0.5 to
+ * 1.5 s into its cycle. White Gaussian noise is added at a given SNR in
+ * 2500 Hz. The capture is fed to the decoder in 0.1 s chunks, and
+ * js8_decoder_decode_due() runs whenever a submode is due, as the app
+ * would. Reports, per submode, how many of the sent messages came back,
+ * plus false decodes (payloads never sent). Also reports the longest
+ * single decode and the total decode time as a fraction of the audio.
+ *
+ * Not part of the app target; see bench/Makefile.
+ */
+
+#include "js8_decoder.h"
+#include "ft8_crc.h"
+#include "ft8_ldpc.h"
+#include "bench_synth.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_MAX_SIGNALS   2048
+#define BENCH_MAX_RESULTS   256
+#define BENCH_CHUNK_SAMPLES 1200      /* 0.1 s per feed */
+#define BENCH_BAND_LO       300.0
+#define BENCH_BAND_HI       2700.0
+
+static const char *k_names[JS8_SUBMODES] = { "normal", "fast", "turbo", "slow", "ultra" };
+
+typedef struct {
+    int      signals;      /* Per submode cycle */
+    float    snr_db;
+    int      seconds;
+    unsigned submodes;
+    int      max_candidates;
+    int      threads;      /* 0 = decoder default */
+} bench_opts_t;
+
+typedef struct {
+    uint8_t payload[JS8_PAYLOAD_BITS];
+    int     submode;
+    double  freq_hz;
+    long    start;         /* Samples into the capture */
+    int     found;
+} bench_signal_t;
+
+/* ------------------------------------------------------------------ */
+/* Signal synthesis                                                    */
+/* ------------------------------------------------------------------ */
+
+static const int k_costas[7] = { 3, 1, 4, 0, 6, 5, 2 };
+
+/* Payload → CRC → LDPC → data symbols (bits as tone) between Costas blocks */
+static void make_tones(const ft8_ldpc_code_t *code, const uint8_t *payload,
+                       uint8_t *tones)
+{
+    uint8_t message[FT8_LDPC_K];
+    uint8_t codeword[FT8_LDPC_N];
+
+    memcpy(message, payload, JS8_PAYLOAD_BITS);
+    ft8_crc_append(message, JS8_PAYLOAD_BITS);
+    ft8_ldpc_encode(code, message, codeword);
+
+    int d = 0;
+    for (int pos = 0; pos < JS8_SYMBOL_COUNT; pos++) {
+        if (pos % 36 < 7) {                 /* Costas at 0, 36, 72 */
+            tones[pos] = (uint8_t)k_costas[pos % 36];
+            continue;
+        }
+        const uint8_t *b = codeword + 3 * d++;
+        tones[pos] = (uint8_t)((b[0] << 2) | (b[1] << 1) | b[2]);
+    }
+}
+
+/* Every cycle of every submode that fits: signals spread over its slice */
+static int pick_signals(const bench_opts_t *o, long n_samples, bench_signal_t *sig)
+{
+    int n_sub = 0;
+    for (int m = 0; m < JS8_SUBMODES; m++) n_sub += (o->submodes >> m) & 1;
+    const double slice = (BENCH_BAND_HI - BENCH_BAND_LO) / n_sub;
+
+    int n = 0, k = 0;
+    for (int m = 0; m < JS8_SUBMODES; m++) {
+        if (!(o->submodes & (1u << m))) continue;
+        const int nsps = js8_submode_symbol_samples(m);
+        const int cycle = js8_submode_cycle_samples(m);
+        const double ts = (double)JS8_SAMPLE_RATE / nsps;
+        const double lo = BENCH_BAND_LO + slice * k++;
+        const double span = slice / o->signals;
+
+        for (long c = 0; c + cycle <= n_samples; c += cycle) {
+            for (int i = 0; i < o->signals && n < BENCH_MAX_SIGNALS; i++, n++) {
+                bench_signal_t *s = &sig[n];
+                for (int b = 0; b < JS8_PAYLOAD_BITS; b++) s->payload[b] = bench_uniform() < 0.5;
+                s->submode = m;
+                s->freq_hz = lo + span * i + bench_uniform() * (span - 9.0 * ts);
+                s->start = c + (long)((0.5 + bench_uniform()) * JS8_SAMPLE_RATE);
+                s->found = 0;
+            }
+        }
+    }
+    return n;
+}
+
+static void synth(const bench_opts_t *o, const ft8_ldpc_code_t *code,
+                  const bench_signal_t *sig, int n_sig, float *x, long n_samples)
+{
+    /* Unit-amplitude tones at snr_db: power 1/2 each */
+    memset(x, 0, (size_t)n_samples * sizeof(float));
+    bench_add_noise(x, n_samples, JS8_SAMPLE_RATE, 0.5, o->snr_db);
+
+    for (int s = 0; s < n_sig; s++) {
+        uint8_t tones[JS8_SYMBOL_COUNT];
+        make_tones(code, sig[s].payload, tones);
+
+        const int nsps = js8_submode_symbol_samples(sig[s].submode);
+        bench_add_fsk(x, n_samples, sig[s].start, tones, JS8_SYMBOL_COUNT, nsps,
+                      JS8_SAMPLE_RATE, sig[s].freq_hz, (double)JS8_SAMPLE_RATE / nsps, 0.0, 1.0);
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Timing                                                              */
+/* ------------------------------------------------------------------ */
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr,
+        "usage: %s [options]\n"
+        "  -m signals    signals per submode cycle (2)\n"
+        "  -s snr_db     SNR in 2500 Hz (-10)\n"
+        "  -d seconds    capture length (120)\n"
+        "  -u mask       submodes, bit per normal/fast/turbo/slow/ultra (31)\n"
+        "  -c count      max candidates per submode (decoder default)\n"
+        "  -t threads    workers (decoder default)\n",
+        argv0);
+}
+
+int main(int argc, char **argv)
+{
+    bench_opts_t o = {
+        .signals = 2, .snr_db = -10.0f, .seconds = 120, .submodes = JS8_ALL_SUBMODES,
+    };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "m:s:d:u:c:t:h")) != -1) {
+        switch (opt) {
+        case 'm': o.signals = atoi(optarg); break;
+        case 's': o.snr_db = (float)atof(optarg); break;
+        case 'd': o.seconds = atoi(optarg); break;
+        case 'u': o.submodes = (unsigned)strtoul(optarg, NULL, 0) & JS8_ALL_SUBMODES; break;
+        case 'c': o.max_candidates = atoi(optarg); break;
+        case 't': o.threads = atoi(optarg); break;
+        default: usage(argv[0]); return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (o.signals <= 0 || o.seconds <= 0 || !o.submodes) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    js8_config_t cfg;
+    js8_config_init(&cfg);
+    cfg.submodes = o.submodes;
+    if (o.max_candidates > 0) cfg.max_candidates = o.max_candidates;
+    if (o.threads > 0) cfg.threads = o.threads;
+
+    const long n_samples = (long)o.seconds * JS8_SAMPLE_RATE;
+    js8_decoder_t *dec = js8_decoder_create(&cfg);
+    float *x = (float *)malloc((size_t)n_samples * sizeof(float));
+    static bench_signal_t sig[BENCH_MAX_SIGNALS];
+    if (!dec || !x) return 1;
+
+    const ft8_ldpc_code_t *code = ft8_ldpc_js8();
+
+    int n_sig = pick_signals(&o, n_samples, sig);
+    synth(&o, code, sig, n_sig, x, n_samples);
+
+    char threads_desc[16] = "auto";
+    if (o.threads > 0) snprintf(threads_desc, sizeof(threads_desc), "%d", o.threads);
+    printf("JS8 decoder benchmark: %d s, %d signals per cycle, SNR %.1f dB, "
+           "submodes 0x%x, %d candidates, %s threads\n",
+           o.seconds, o.signals, o.snr_db, o.submodes, cfg.max_candidates, threads_desc);
+
+    static js8_result_t res[BENCH_MAX_RESULTS];
+    int false_dec[JS8_SUBMODES] = { 0 };
+    int decodes = 0;
+    double total = 0.0, longest = 0.0;
+
+    js8_decoder_reset(dec, 0);
+    for (long i = 0; i < n_samples; i += BENCH_CHUNK_SAMPLES) {
+        int len = n_samples - i < BENCH_CHUNK_SAMPLES ? (int)(n_samples - i) : BENCH_CHUNK_SAMPLES;
+        if (!js8_decoder_feed(dec, x + i, len)) continue;
+
+        double t0 = now_s();
+        int n = js8_decoder_decode_due(dec, res, BENCH_MAX_RESULTS);
+        double dt = now_s() - t0;
+        total += dt;
+        if (dt > longest) longest = dt;
+        decodes++;
+
+        for (int r = 0; r < n; r++) {
+            int hit = 0;
+            for (int s = 0; s < n_sig; s++) {
+                if (!sig[s].found && sig[s].submode == res[r].submode &&
+                    memcmp(res[r].payload, sig[s].payload, JS8_PAYLOAD_BITS) == 0) {
+                    sig[s].found = hit = 1;
+                    break;
+                }
+            }
+            if (!hit) false_dec[res[r].submode]++;
+        }
+    }
+
+    printf("%-8s  %7s  %5s\n", "submode", "decoded", "false");
+    int all_sent = 0, all_found = 0, all_false = 0;
+    for (int m = 0; m < JS8_SUBMODES; m++) {
+        if (!(o.submodes & (1u << m))) continue;
+        int sent = 0, found = 0;
+        for (int s = 0; s < n_sig; s++) {
+            if (sig[s].submode != m) continue;
+            sent++;
+            found += sig[s].found;
+        }
+        printf("%-8s  %3d/%-3d  %5d\n", k_names[m], found, sent, false_dec[m]);
+        all_sent += sent;
+        all_found += found;
+        all_false += false_dec[m];
+    }
+    printf("%-8s  %3d/%-3d  %5d\n", "all", all_found, all_sent, all_false);
+    printf("%d decodes, longest %.1f ms, total %.1f ms = %.2f%% of the audio\n",
+           decodes, longest * 1e3, total * 1e3, 100.0 * total / o.seconds);
+
+    free(x);
+    js8_decoder_destroy(dec);
+    return 0;
+}
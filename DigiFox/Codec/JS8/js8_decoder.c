@@ -0,0 +1,556 @@
+/**
+ * js8_decoder.c — JS8 pipeline: Capture ring → per-submode waterfall and
+ * Costas sync → Soft bits → LDPC → CRC
+ *
+ * No heap allocation during feed() or decode() — all state pre-allocated
+ * in create().
+ */
+
+#include "js8_decoder.h"
+#include "ft8_crc.h"
+#include "ft8_ldpc.h"
+#include "ft8_pool.h"
+#include "ft8_softbits.h"
+#include "ft8_sync.h"
+#include "ft8_waterfall.h"
+
+#include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define JS8_BITS_PER_SYMBOL  3
+#define JS8_COSTAS_LENGTH    7
+#define JS8_NUM_TONES        8
+
+/* Bins left and right of the 8 tones used as noise reference for SNR */
+#define JS8_SNR_GUARD        4
+
+#define JS8_MAX_CANDIDATES   200
+#define JS8_MAX_THREADS      16
+
+/*
+ * Frames start within this long of their cycle start; the window
+ * searched is the frame plus this, or the whole cycle if shorter.
+ */
+#define JS8_START_SLACK      (3 * JS8_SAMPLE_RATE)
+
+/* The ring also keeps this much beyond the longest window */
+#define JS8_RING_SLACK       (4 * JS8_SAMPLE_RATE)
+
+static const int k_symbol_samples[JS8_SUBMODES] = { 1920, 1280, 640, 3840, 7680 };
+static const int k_cycle_seconds[JS8_SUBMODES]  = { 15, 10, 6, 30, 120 };
+
+static const int k_costas[JS8_COSTAS_LENGTH] = { 3, 1, 4, 0, 6, 5, 2 };
+static const int k_sync_offsets[3] = { 0, 36, 72 };
+
+typedef struct {
+    int   symbol_samples;
+    int   cycle_samples;
+    int   window_samples;      /* Searched from each cycle start */
+    float tone_spacing;        /* Hz, one waterfall bin */
+
+    /* Base-bin search range [min_bin, max_bin) */
+    int min_bin, max_bin;
+    int n_bins;
+
+    ft8_waterfall_t  wf;
+    ft8_sync_t       sync;
+    ft8_candidate_t *cand;     /* max_candidates, best sync first */
+    int              n_cand;
+    int              first;    /* Its candidates' rows in the LDPC batch */
+
+    int64_t cycle_start;       /* Clock of the due cycle's start */
+} submode_t;
+
+struct js8_decoder_t {
+    js8_config_t cfg;
+
+    submode_t sub[JS8_SUBMODES];
+
+    /* Capture ring: sample at clock t lives at ring[t % ring_size] */
+    float   *ring;
+    int      ring_size;
+    int64_t  clock;            /* Clock of the next sample fed */
+    int64_t  clock_reset;      /* Nothing before this was fed */
+    unsigned due;
+
+    const ft8_ldpc_code_t *code;
+
+    /* Workers claim submodes, then LDPC chunks, off a shared counter */
+    ft8_pool_t       *pool;
+    int               n_workers;
+    ft8_ldpc_batch_t *ldpc;    /* n_workers */
+    int               chunk;   /* Candidates per LDPC claim */
+    _Atomic int       next;
+    int               running[JS8_SUBMODES];   /* Due submodes being decoded */
+    int               n_running;
+    unsigned          running_mask;
+    int               n_total;
+
+    /* Data symbol rows within the frame (all but the Costas blocks) */
+    int data_pos[JS8_SYMBOL_COUNT];
+    int n_data;
+
+    /* Per candidate of all running submodes, submode by submode */
+    float   *llr;              /* JS8_SUBMODES * max_candidates * FT8_LDPC_N */
+    uint8_t *message;          /* JS8_SUBMODES * max_candidates * FT8_LDPC_K */
+    int     *iterations;       /* JS8_SUBMODES * max_candidates */
+};
+
+/* ------------------------------------------------------------------ */
+/* Submodes and config                                                 */
+/* ------------------------------------------------------------------ */
+
+int js8_submode_symbol_samples(int submode)
+{
+    return submode >= 0 && submode < JS8_SUBMODES ? k_symbol_samples[submode] : 0;
+}
+
+int js8_submode_cycle_samples(int submode)
+{
+    return submode >= 0 && submode < JS8_SUBMODES
+               ? k_cycle_seconds[submode] * JS8_SAMPLE_RATE : 0;
+}
+
+void js8_config_init(js8_config_t *cfg)
+{
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->min_freq        = 100.0f;
+    cfg->max_freq        = 3000.0f;
+    cfg->sync_threshold  = 4.0f;
+    cfg->max_candidates  = 20;
+    cfg->ldpc_iterations = 50;
+    cfg->submodes        = JS8_ALL_SUBMODES;
+    cfg->threads         = 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* Create / destroy                                                    */
+/* ------------------------------------------------------------------ */
+
+static int submode_init(js8_decoder_t *dec, int m)
+{
+    submode_t *s = &dec->sub[m];
+    s->symbol_samples = k_symbol_samples[m];
+    s->cycle_samples = k_cycle_seconds[m] * JS8_SAMPLE_RATE;
+    s->window_samples = s->symbol_samples * JS8_SYMBOL_COUNT + JS8_START_SLACK;
+    if (s->window_samples > s->cycle_samples) s->window_samples = s->cycle_samples;
+    s->tone_spacing = (float)JS8_SAMPLE_RATE / s->symbol_samples;
+
+    /* Bins up to the top tone of the highest base, plus its SNR noise bins */
+    s->min_bin = (int)(dec->cfg.min_freq / s->tone_spacing);
+    if (s->min_bin < 0) s->min_bin = 0;
+    s->max_bin = (int)(dec->cfg.max_freq / s->tone_spacing);
+    s->n_bins = s->max_bin + JS8_NUM_TONES + JS8_SNR_GUARD;
+    if (s->n_bins > s->symbol_samples / 2) s->n_bins = s->symbol_samples / 2;
+    if (s->max_bin > s->n_bins - JS8_NUM_TONES) s->max_bin = s->n_bins - JS8_NUM_TONES;
+
+    if (ft8_waterfall_init(&s->wf, s->symbol_samples, s->window_samples, s->n_bins) != 0 ||
+        ft8_sync_init(&s->sync, &s->wf) != 0) {
+        return -1;
+    }
+    ft8_sync_set_backend(&s->sync, dec->cfg.sync_score, dec->cfg.sync_ctx);
+    s->cand = (ft8_candidate_t *)calloc((size_t)dec->cfg.max_candidates,
+                                        sizeof(ft8_candidate_t));
+    return s->cand ? 0 : -1;
+}
+
+js8_decoder_t *js8_decoder_create(const js8_config_t *cfg)
+{
+    js8_decoder_t *dec = (js8_decoder_t *)calloc(1, sizeof(js8_decoder_t));
+    if (!dec) return NULL;
+
+    if (cfg) {
+        dec->cfg = *cfg;
+    } else {
+        js8_config_init(&dec->cfg);
+    }
+    dec->cfg.submodes &= JS8_ALL_SUBMODES;
+    if (dec->cfg.max_candidates < 1) dec->cfg.max_candidates = 1;
+    if (dec->cfg.max_candidates > JS8_MAX_CANDIDATES) dec->cfg.max_candidates = JS8_MAX_CANDIDATES;
+    if (dec->cfg.ldpc_iterations < 1) dec->cfg.ldpc_iterations = 1;
+    if (dec->cfg.threads <= 0) dec->cfg.threads = ft8_pool_default_size();
+    if (dec->cfg.threads > JS8_MAX_THREADS) dec->cfg.threads = JS8_MAX_THREADS;
+    if (!dec->cfg.submodes) {
+        free(dec);
+        return NULL;
+    }
+
+    int longest = 0;
+    for (int m = 0; m < JS8_SUBMODES; m++) {
+        if (!(dec->cfg.submodes & (1u << m))) continue;
+        if (submode_init(dec, m) != 0) {
+            js8_decoder_destroy(dec);
+            return NULL;
+        }
+        if (dec->sub[m].window_samples > longest) longest = dec->sub[m].window_samples;
+    }
+
+    const size_t rows = (size_t)JS8_SUBMODES * dec->cfg.max_candidates;
+    dec->ring_size = longest + JS8_RING_SLACK;
+    dec->ring = (float *)calloc((size_t)dec->ring_size, sizeof(float));
+    dec->llr = (float *)calloc(rows * FT8_LDPC_N, sizeof(float));
+    dec->message = (uint8_t *)calloc(rows * FT8_LDPC_K, 1);
+    dec->iterations = (int *)calloc(rows, sizeof(int));
+    if (!dec->ring || !dec->llr || !dec->message || !dec->iterations) {
+        js8_decoder_destroy(dec);
+        return NULL;
+    }
+
+    dec->code = ft8_ldpc_js8();
+
+    /* Threads that fail to start leave the work on the calling thread */
+    dec->pool = dec->cfg.threads > 1 ? ft8_pool_create(dec->cfg.threads) : NULL;
+    dec->n_workers = ft8_pool_size(dec->pool);
+    dec->ldpc = (ft8_ldpc_batch_t *)calloc((size_t)dec->n_workers, sizeof(ft8_ldpc_batch_t));
+    if (!dec->ldpc) {
+        js8_decoder_destroy(dec);
+        return NULL;
+    }
+    dec->chunk = ft8_ldpc_batch_width();
+
+    for (int pos = 0; pos < JS8_SYMBOL_COUNT; pos++) {
+        int sync = 0;
+        for (int b = 0; b < 3; b++) {
+            int off = pos - k_sync_offsets[b];
+            if (off >= 0 && off < JS8_COSTAS_LENGTH) sync = 1;
+        }
+        if (!sync) dec->data_pos[dec->n_data++] = pos;
+    }
+
+    js8_decoder_reset(dec, 0);
+    return dec;
+}
+
+void js8_decoder_destroy(js8_decoder_t *dec)
+{
+    if (!dec) return;
+    for (int m = 0; m < JS8_SUBMODES; m++) {
+        ft8_waterfall_free(&dec->sub[m].wf);
+        ft8_sync_free(&dec->sub[m].sync);
+        free(dec->sub[m].cand);
+    }
+    ft8_pool_destroy(dec->pool);
+    free(dec->ldpc);
+    free(dec->ring);
+    free(dec->llr);
+    free(dec->message);
+    free(dec->iterations);
+    free(dec);
+}
+
+/* ------------------------------------------------------------------ */
+/* Capture ring                                                        */
+/* ------------------------------------------------------------------ */
+
+void js8_decoder_reset(js8_decoder_t *dec, int64_t clock)
+{
+    if (!dec) return;
+    dec->clock = clock;
+    dec->clock_reset = clock;
+    dec->due = 0;
+}
+
+static inline int ring_index(const js8_decoder_t *dec, int64_t t)
+{
+    int64_t i = t % dec->ring_size;
+    return (int)(i < 0 ? i + dec->ring_size : i);
+}
+
+/* Floor division, for clocks before the epoch too */
+static inline int64_t floor_div(int64_t a, int64_t b)
+{
+    return a / b - (a % b != 0 && (a < 0) != (b < 0));
+}
+
+unsigned js8_decoder_feed(js8_decoder_t *dec, const float *audio, int n)
+{
+    if (!dec) return 0;
+    if (!audio || n <= 0) return dec->due;
+
+    /* Only the newest ring_size samples can matter */
+    if (n > dec->ring_size) {
+        dec->clock += n - dec->ring_size;
+        audio += n - dec->ring_size;
+        n = dec->ring_size;
+    }
+    const int64_t from = dec->clock;
+    for (int done = 0; done < n;) {
+        int at = ring_index(dec, dec->clock);
+        int len = dec->ring_size - at;
+        if (len > n - done) len = n - done;
+        memcpy(dec->ring + at, audio + done, (size_t)len * sizeof(float));
+        done += len;
+        dec->clock += len;
+    }
+
+    /* A submode is due once its latest window's last sample is in */
+    for (int m = 0; m < JS8_SUBMODES; m++) {
+        if (!(dec->cfg.submodes & (1u << m))) continue;
+        submode_t *s = &dec->sub[m];
+        int64_t start = floor_div(dec->clock - s->window_samples, s->cycle_samples)
+                        * s->cycle_samples;
+        int64_t end = start + s->window_samples;
+        if (end > from && end <= dec->clock && end > dec->clock_reset) {
+            s->cycle_start = start;
+            dec->due |= 1u << m;
+        }
+    }
+    return dec->due;
+}
+
+/*
+ * The submode's window from the ring into its waterfall, zeros for
+ * samples never fed or already overwritten, then every spectrum at once.
+ */
+static void load_window(js8_decoder_t *dec, submode_t *s)
+{
+    int64_t oldest = dec->clock - dec->ring_size;
+    if (oldest < dec->clock_reset) oldest = dec->clock_reset;
+
+    float *a = s->wf.audio;
+    for (int i = 0; i < s->window_samples;) {
+        int64_t t = s->cycle_start + i;
+        if (t < oldest || t >= dec->clock) {
+            a[i++] = 0.0f;
+            continue;
+        }
+        int at = ring_index(dec, t);
+        int len = dec->ring_size - at;
+        if (len > s->window_samples - i) len = s->window_samples - i;
+        if (len > dec->clock - t) len = (int)(dec->clock - t);
+        memcpy(a + i, dec->ring + at, (size_t)len * sizeof(float));
+        i += len;
+    }
+    s->wf.n_audio = s->window_samples;
+    ft8_waterfall_rebuild(&s->wf);
+}
+
+/* ------------------------------------------------------------------ */
+/* Soft bits, SNR, frequency                                           */
+/* ------------------------------------------------------------------ */
+
+static const float *cand_grid(const submode_t *s, const ft8_candidate_t *c)
+{
+    return ft8_waterfall_grid(&s->wf, c->time_sub, c->freq_sub);
+}
+
+/* LLRs of the data symbols (ft8_softbits.h); JS8 sends the bits as the
+ * tone number itself */
+static void extract_llr(const js8_decoder_t *dec, const submode_t *s,
+                        const ft8_candidate_t *c, float *out)
+{
+    ft8_softbits_extract(cand_grid(s, c), s->n_bins, c->row, c->bin,
+                         dec->data_pos, dec->n_data, JS8_SYMBOL_COUNT,
+                         FT8_SOFTBITS_TONES, ft8_softbits_natural, out);
+}
+
+/* Mean tone-bin power over mean guard-bin power, referred to 2500 Hz */
+static float estimate_snr(const js8_decoder_t *dec, const submode_t *s,
+                          const ft8_candidate_t *c)
+{
+    const float *grid = cand_grid(s, c);
+    double signal = 0.0, noise = 0.0;
+    int n_signal = 0, n_noise = 0;
+
+    for (int d = 0; d < dec->n_data; d++) {
+        const float *p = grid + (long)(c->row + dec->data_pos[d]) * s->n_bins;
+
+        for (int t = 0; t < JS8_NUM_TONES; t++) {
+            signal += p[c->bin + t];
+            n_signal++;
+        }
+        for (int g = 1; g <= JS8_SNR_GUARD; g++) {
+            int lo = c->bin - g;
+            int hi = c->bin + JS8_NUM_TONES + g;
+            if (lo >= 0) { noise += p[lo]; n_noise++; }
+            if (hi < s->n_bins) { noise += p[hi]; n_noise++; }
+        }
+    }
+
+    double avg_signal = n_signal ? signal / n_signal : 1e-10;
+    double avg_noise = n_noise ? noise / n_noise : 1e-10;
+    return (float)(10.0 * log10(avg_signal / avg_noise)
+                   - 10.0 * log10(2500.0 / s->tone_spacing));
+}
+
+/* Parabolic interpolation around each Costas tone, averaged */
+static float refine_frequency(const submode_t *s, const ft8_candidate_t *c)
+{
+    const float *grid = cand_grid(s, c);
+    double sum = 0.0;
+    int count = 0;
+
+    if (c->bin > 0 && c->bin + JS8_NUM_TONES - 1 < s->n_bins) {
+        for (int b = 0; b < 3; b++) {
+            for (int i = 0; i < JS8_COSTAS_LENGTH; i++) {
+                int bin = c->bin + k_costas[i];
+                if (bin + 1 >= s->n_bins) continue;
+
+                const float *p = grid + (long)(c->row + k_sync_offsets[b] + i) * s->n_bins;
+                double left = p[bin - 1], center = p[bin], right = p[bin + 1];
+                double denom = 2.0 * (2.0 * center - left - right);
+                if (fabs(denom) > 1e-10) {
+                    sum += (right - left) / denom;
+                    count++;
+                }
+            }
+        }
+    }
+
+    double offset = count ? sum / count : 0.0;
+    return (float)((c->bin + (double)c->freq_sub / FT8_WF_FREQ_OSR + offset)
+                   * s->tone_spacing);
+}
+
+/* Frame start in samples after the cycle start */
+static int cand_start(const submode_t *s, const ft8_candidate_t *c)
+{
+    return c->row * s->symbol_samples + c->time_sub * s->wf.hop;
+}
+
+/* ------------------------------------------------------------------ */
+/* Decode                                                              */
+/* ------------------------------------------------------------------ */
+
+/*
+ * One submode per claim: waterfall from the ring, Costas search, soft
+ * bits into the submode's own rows of the LDPC batch.
+ */
+static void search_stage(void *ctx, int worker)
+{
+    js8_decoder_t *dec = (js8_decoder_t *)ctx;
+    (void)worker;
+
+    for (;;) {
+        int k = atomic_fetch_add_explicit(&dec->next, 1, memory_order_relaxed);
+        if (k >= dec->n_running) return;
+        const int m = dec->running[k];
+        submode_t *s = &dec->sub[m];
+
+        load_window(dec, s);
+        s->n_cand = ft8_sync_search(&s->sync, &s->wf, s->min_bin, s->max_bin,
+                                    dec->cfg.sync_threshold, FT8_SYNC_SYMBOLS,
+                                    s->cand, dec->cfg.max_candidates);
+
+        float *llr = dec->llr + (long)m * dec->cfg.max_candidates * FT8_LDPC_N;
+        for (int i = 0; i < s->n_cand; i++) {
+            extract_llr(dec, s, &s->cand[i], llr + (long)i * FT8_LDPC_N);
+        }
+    }
+}
+
+/* LDPC over every running submode's candidates, one chunk per claim */
+static void ldpc_stage(void *ctx, int worker)
+{
+    js8_decoder_t *dec = (js8_decoder_t *)ctx;
+
+    for (;;) {
+        int lo = atomic_fetch_add_explicit(&dec->next, 1, memory_order_relaxed) * dec->chunk;
+        if (lo >= dec->n_total) return;
+        int n = dec->n_total - lo < dec->chunk ? dec->n_total - lo : dec->chunk;
+
+        ft8_ldpc_decode_batch(dec->code, dec->llr + (long)lo * FT8_LDPC_N, n,
+                              dec->cfg.ldpc_iterations, &dec->ldpc[worker],
+                              dec->message + (long)lo * FT8_LDPC_K, dec->iterations + lo);
+    }
+}
+
+/* Same payload already reported for this submode */
+static int already_decoded(const js8_result_t *out, int first, int n_out,
+                           const uint8_t *payload)
+{
+    for (int i = first; i < n_out; i++) {
+        if (memcmp(out[i].payload, payload, JS8_PAYLOAD_BITS) == 0) return 1;
+    }
+    return 0;
+}
+
+int js8_decoder_decode_due(js8_decoder_t *dec, js8_result_t *out, int max_out)
+{
+    if (!dec || !out || max_out <= 0) return 0;
+
+    dec->n_running = 0;
+    for (int m = 0; m < JS8_SUBMODES; m++) {
+        if (dec->due & (1u << m)) dec->running[dec->n_running++] = m;
+    }
+    dec->running_mask = dec->due;
+    dec->due = 0;
+    if (!dec->n_running) return 0;
+
+    /* Longest window first, so the slowest search starts soonest */
+    for (int i = 1; i < dec->n_running; i++) {
+        int m = dec->running[i], j = i;
+        for (; j > 0 && dec->sub[dec->running[j - 1]].window_samples
+                        < dec->sub[m].window_samples; j--) {
+            dec->running[j] = dec->running[j - 1];
+        }
+        dec->running[j] = m;
+    }
+
+    atomic_store(&dec->next, 0);
+    ft8_pool_run(dec->pool, search_stage, dec);
+
+    /* Pack the submodes' LLR rows into one batch, submode order */
+    dec->n_total = 0;
+    for (int m = 0; m < JS8_SUBMODES; m++) {
+        if (!(dec->running_mask & (1u << m))) continue;
+        submode_t *s = &dec->sub[m];
+
+        s->first = dec->n_total;
+        memmove(dec->llr + (long)s->first * FT8_LDPC_N,
+                dec->llr + (long)m * dec->cfg.max_candidates * FT8_LDPC_N,
+                (size_t)s->n_cand * FT8_LDPC_N * sizeof(float));
+        dec->n_total += s->n_cand;
+    }
+
+    if (dec->n_total > 0) {
+        atomic_store(&dec->next, 0);
+        ft8_pool_run(dec->pool, ldpc_stage, dec);
+    }
+
+    /* Reduction: CRC and dedup per submode, best sync first */
+    int n_out = 0;
+    for (int m = 0; m < JS8_SUBMODES && n_out < max_out; m++) {
+        if (!(dec->running_mask & (1u << m))) continue;
+        submode_t *s = &dec->sub[m];
+
+        const int first = n_out;
+        for (int i = 0; i < s->n_cand && n_out < max_out; i++) {
+            const int row = s->first + i;
+            const uint8_t *message = dec->message + (long)row * FT8_LDPC_K;
+            const ft8_candidate_t *c = &s->cand[i];
+
+            if (dec->iterations[row] <= 0) continue;
+            if (!ft8_crc_check(message, JS8_PAYLOAD_BITS)) continue;
+            if (already_decoded(out, first, n_out, message)) continue;
+
+            js8_result_t *r = &out[n_out++];
+            memcpy(r->payload, message, JS8_PAYLOAD_BITS);
+            r->submode = m;
+            r->snr = estimate_snr(dec, s, c);
+            r->freq_hz = refine_frequency(s, c);
+            r->time_s = (float)cand_start(s, c) / JS8_SAMPLE_RATE;
+            r->score = c->score;
+            r->iterations = dec->iterations[row];
+        }
+    }
+    return n_out;
+}
+
+int js8_decoder_decode(js8_decoder_t *dec, const float *audio, int n, int submode,
+                       js8_result_t *out, int max_out)
+{
+    if (!dec || !audio || !out || max_out <= 0) return 0;
+    if (submode < 0 || submode >= JS8_SUBMODES ||
+        !(dec->cfg.submodes & (1u << submode))) {
+        return 0;
+    }
+
+    js8_decoder_reset(dec, 0);
+    js8_decoder_feed(dec, audio, n);
+    dec->sub[submode].cycle_start = 0;
+    dec->due = 1u << submode;
+    return js8_decoder_decode_due(dec, out, max_out);
+}
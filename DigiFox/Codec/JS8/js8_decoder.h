@@ -0,0 +1,168 @@
+/**
+ * js8_decoder.h — Public C API for the JS8 decoder, every submode at once
+ *
+ * Native counterpart of JS8Demodulator. Audio goes into one capture ring
+ * shared by all submodes. Each submode has its own cycle on the UTC
+ * clock and its own symbol length (JS8Speed). When a cycle's frame
+ * window is complete, that submode is due. ft8_pool workers take the
+ * due submodes one each. Each builds its waterfall from the ring, runs
+ * the Costas search and extracts soft bits, so submodes ending together
+ * are searched side by side on separate cores. Their candidates then go
+ * through one LDPC(174,91) batch on the JS8 code (ft8_ldpc.h), spread
+ * over the same workers, and are CRC-checked.
+ *
+ * The waterfall, sync search and LDPC are the FT8 core's (ft8_waterfall.h,
+ * ft8_sync.h, ft8_ldpc.h); only the symbol length and the tone mapping
+ * (natural binary, no Gray code) differ. All memory is allocated in
+ * js8_decoder_create(); feeding and decoding do no heap allocation.
+ *
+ * Usage, live:
+ *   js8_config_t cfg;
+ *   js8_config_init(&cfg);
+ *   js8_decoder_t *dec = js8_decoder_create(&cfg);
+ *
+ *   js8_decoder_reset(dec, clock);                // clock: see below
+ *   js8_decoder_feed(dec, chunk, chunk_len);      // as audio arrives
+ *   int n = js8_decoder_decode_due(dec, res, 64); // soon after feed reports due
+ *
+ * The clock counts samples on the UTC second grid. Any epoch that falls
+ * on a whole 10 minutes works, e.g. seconds since midnight UTC × 12000,
+ * because every submode's cycle divides 10 minutes.
+ */
+
+#ifndef JS8_DECODER_H
+#define JS8_DECODER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define JS8_SAMPLE_RATE   12000
+#define JS8_SYMBOL_COUNT  79
+#define JS8_PAYLOAD_BITS  77
+
+/* Submodes, numbered as JS8Speed */
+typedef enum {
+    JS8_SUBMODE_NORMAL = 0,   /* 1920 samples/symbol, 15 s cycle */
+    JS8_SUBMODE_FAST   = 1,   /* 1280, 10 s */
+    JS8_SUBMODE_TURBO  = 2,   /*  640,  6 s */
+    JS8_SUBMODE_SLOW   = 3,   /* 3840, 30 s */
+    JS8_SUBMODE_ULTRA  = 4,   /* 7680, 120 s */
+    JS8_SUBMODES       = 5
+} js8_submode_t;
+
+#define JS8_ALL_SUBMODES  ((1u << JS8_SUBMODES) - 1)
+
+typedef struct js8_decoder_t js8_decoder_t;
+
+/* One Costas search's scoring (ft8_sync.h) */
+struct ft8_sync_job_t;
+
+/* Configuration struct — all fields have sensible defaults via js8_config_init() */
+typedef struct js8_config_t {
+    float    min_freq;        /* Lowest base (tone 0) frequency in Hz (default: 100) */
+    float    max_freq;        /* Highest base frequency in Hz (default: 3000) */
+    float    sync_threshold;  /* Minimum Costas score for a candidate (default: 4.0) */
+    int      max_candidates;  /* Candidates tried per submode and cycle (default: 20) */
+    int      ldpc_iterations; /* Belief-propagation iteration cap (default: 50) */
+    unsigned submodes;        /* Bit per js8_submode_t to decode
+                                 (default: JS8_ALL_SUBMODES) */
+    int      threads;         /* Workers, the calling thread included;
+                                 0 = one per performance core (default: 0) */
+    int    (*sync_score)(void *ctx, const struct ft8_sync_job_t *job, float *map);
+                              /* Scores the Costas search elsewhere, as
+                                 ft8_config_t (default: NULL = the CPU) */
+    void    *sync_ctx;        /* Passed to sync_score */
+} js8_config_t;
+
+/* One decoded message */
+typedef struct {
+    uint8_t payload[JS8_PAYLOAD_BITS];  /* Message bits, 0/1, first bit first */
+    int     submode;                    /* js8_submode_t */
+    float   snr;                        /* Estimated SNR in dB (2500 Hz) */
+    float   freq_hz;                    /* Refined base frequency in Hz */
+    float   time_s;                     /* Frame start after the cycle start in s */
+    float   score;                      /* Costas sync score */
+    int     iterations;                 /* LDPC iterations to converge */
+} js8_result_t;
+
+/* Samples per symbol of a submode */
+int js8_submode_symbol_samples(int submode);
+
+/* Cycle (TX period) of a submode in samples */
+int js8_submode_cycle_samples(int submode);
+
+/**
+ * Initialize config with default values.
+ * Always call this before modifying individual fields.
+ */
+void js8_config_init(js8_config_t *cfg);
+
+/**
+ * Create a decoder instance.
+ * Returns NULL on allocation failure or if cfg.submodes is empty.
+ */
+js8_decoder_t *js8_decoder_create(const js8_config_t *cfg);
+
+/**
+ * Drop all audio and start the ring over.
+ *
+ * @param dec    Decoder handle
+ * @param clock  Sample clock of the next sample fed
+ */
+void js8_decoder_reset(js8_decoder_t *dec, int64_t clock);
+
+/**
+ * Append audio to the capture ring.
+ *
+ * @param dec    Decoder handle
+ * @param audio  Audio samples (mono, float, 12 kHz)
+ * @param n      Number of samples
+ * @return       Submodes due for decoding (bit per js8_submode_t), this
+ *               chunk's and any still waiting
+ */
+unsigned js8_decoder_feed(js8_decoder_t *dec, const float *audio, int n);
+
+/**
+ * Decode every due submode's latest cycle, concurrently. The ring keeps
+ * a few seconds beyond the longest window, so the call may come a little
+ * after feed() reports a submode due. A submode due again before its
+ * previous cycle was decoded only has the newer one decoded.
+ *
+ * Not safe to run alongside feed(); the caller serialises them.
+ *
+ * @param dec      Decoder handle
+ * @param out      Output array for decoded messages, by submode, best
+ *                 sync first within each
+ * @param max_out  Capacity of out
+ * @return         Number of messages written to out
+ */
+int js8_decoder_decode_due(js8_decoder_t *dec, js8_result_t *out, int max_out);
+
+/**
+ * Decode one buffer of one submode: the buffer starts at a cycle start.
+ * Resets the decoder.
+ *
+ * @param dec      Decoder handle
+ * @param audio    Audio samples (mono, float, 12 kHz)
+ * @param n        Number of samples
+ * @param submode  js8_submode_t, one of cfg.submodes
+ * @param out      Output array for decoded messages, best sync first
+ * @param max_out  Capacity of out
+ * @return         Number of messages written to out
+ */
+int js8_decoder_decode(js8_decoder_t *dec, const float *audio, int n, int submode,
+                       js8_result_t *out, int max_out);
+
+/**
+ * Destroy decoder and free all resources.
+ */
+void js8_decoder_destroy(js8_decoder_t *dec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JS8_DECODER_H */
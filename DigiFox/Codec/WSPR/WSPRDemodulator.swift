@@ -0,0 +1,116 @@
+import Foundation
+
+/// One decoded WSPR transmission.
+struct WSPRDecode {
+    let message: WSPRMessage
+    /// Lowest tone at mid-frame (Hz).
+    let frequency: Double
+    /// Frequency change over the frame (Hz).
+    let drift: Double
+    /// SNR in 2500 Hz (dB).
+    let snr: Double
+    /// Frame start after the even minute (s); nominally 1.
+    let deltaTime: Double
+}
+
+/// WSPR Demodulator — RX chain.
+///
+/// Pipeline: one 2-minute window of audio → native decoder
+/// (`wspr_decoder.h`): mixdown to 375 Hz, spectra, drift-compensated
+/// sync, soft symbols → Fano sequential decoding of the K=32 code →
+/// 50 message bits → `WSPRMessagePack.unpack`.
+///
+/// Each decoded signal is subtracted and the residual searched again,
+/// so strong stations do not hide weak ones next to them. A window
+/// decodes in well under a second, so the decode can start once the
+/// latest frame has ended (`decodeSamples` in) and still finish before
+/// the next even minute.
+final class WSPRDemodulator {
+
+    /// Audio needed from the even minute on to search every start time
+    /// (WSPR_DECODE_SAMPLES: 3 s of slack plus the 110.6 s frame).
+    static let decodeSamples = 3 * Int(WSPRProtocol.sampleRate) + WSPRProtocol.frameSamples
+
+    /// Searched base frequencies (Hz); at most 250 Hz wide.
+    var frequencyRange: ClosedRange<Double> = 1400...1600 { didSet { invalidate() } }
+
+    /// Largest drift searched, Hz over the frame either way.
+    var maxDrift: Double = 4.0 { didSet { invalidate() } }
+
+    /// Candidates tried per pass.
+    var maxCandidates: Int = 30 { didSet { invalidate() } }
+
+    /// Fano cycles allowed per decoded bit before a candidate is given up.
+    var fanoCycles: Int = 10_000 { didSet { invalidate() } }
+
+    /// Search passes; each after the first runs on what the ones before left.
+    var passes: Int = 2 { didSet { invalidate() } }
+
+    /// Threads sharing the candidates; 0 = one per performance core.
+    var decodeThreads: Int = 0 { didSet { invalidate() } }
+
+    /// Native decoder, created on first use with the current settings.
+    private var decoder: OpaquePointer?
+    private var results = [wspr_result_t](repeating: wspr_result_t(), count: 64)
+    private let lock = NSLock()
+
+    deinit {
+        if let dec = decoder { wspr_decoder_destroy(dec) }
+    }
+
+    // MARK: - Public API
+
+    /// Decode one window: `samples` are 12 kHz audio from the even minute on.
+    func demodulate(samples: [Float]) -> [WSPRDecode] {
+        samples.withUnsafeBufferPointer { demodulate(samples: $0) }
+    }
+
+    /// `demodulate` on audio in place, e.g. a window of `AudioEngine`'s buffer.
+    func demodulate(samples: UnsafeBufferPointer<Float>) -> [WSPRDecode] {
+        lock.lock()
+        defer { lock.unlock() }
+
+        guard let base = samples.baseAddress, !samples.isEmpty, let dec = nativeDecoder() else { return [] }
+
+        let n = results.withUnsafeMutableBufferPointer { out in
+            wspr_decoder_decode(dec, base, Int32(samples.count), out.baseAddress, Int32(out.count))
+        }
+
+        return results.prefix(Int(n)).map { r in
+            let bits = withUnsafeBytes(of: r.payload) { Array($0) }
+            return WSPRDecode(
+                message: WSPRMessagePack.unpack(bits),
+                frequency: Double(r.freq_hz),
+                drift: Double(r.drift_hz),
+                snr: Double(r.snr),
+                deltaTime: Double(r.time_s)
+            )
+        }
+    }
+
+    // MARK: - Native Decoder
+
+    private func nativeDecoder() -> OpaquePointer? {
+        if let dec = decoder { return dec }
+
+        var cfg = wspr_config_t()
+        wspr_config_init(&cfg)
+        cfg.min_freq = Float(frequencyRange.lowerBound)
+        cfg.max_freq = Float(frequencyRange.upperBound)
+        cfg.max_drift = Float(maxDrift)
+        cfg.max_candidates = Int32(maxCandidates)
+        cfg.fano_cycles = Int32(fanoCycles)
+        cfg.passes = Int32(passes)
+        cfg.threads = Int32(decodeThreads)
+        decoder = wspr_decoder_create(&cfg)
+        return decoder
+    }
+
+    /// Settings changed: rebuild the native decoder on the next call.
+    private func invalidate() {
+        lock.lock()
+        defer { lock.unlock() }
+        if let dec = decoder { wspr_decoder_destroy(dec) }
+        decoder = nil
+    }
+}
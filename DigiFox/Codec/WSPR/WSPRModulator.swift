@@ -6,7 +6,8 @@ import Accelerate
 /// Pipeline: WSPRMessage → pack (50 bits) → convolutional encode (162 bits)
 ///         → interleave → merge with sync vector → 4-FSK audio waveform.
 ///
-/// Reuses the same continuous-phase FSK synthesis approach as FT8Modulator.
+/// Synthesis goes through the same `ToneSynthesizer` as FT8Modulator, with
+/// plain (unshaped) continuous-phase FSK as WSPR specifies.
 final class WSPRModulator {
 
     /// Audio frequency of the lowest tone (Hz). WSPR signals are in 1400-1600 Hz range.
@@ -16,17 +17,33 @@ final class WSPRModulator {
     var amplitude: Double = 0.5
 
     /// Duration of raised-cosine ramp at start/end (seconds).
-    var rampDuration: Double = 0.005
+    var rampDuration: Double = 0.005 { didSet { synthesizer = nil } }
+
+    /// Built on first use with the current ramp.
+    private var synthesizer: ToneSynthesizer?
 
     // MARK: - Public API
 
     /// Modulate a WSPR message into audio samples at 12 kHz.
     func modulate(_ message: WSPRMessage) -> [Float] {
+        synthesize(tones(for: message))
+    }
+
+    /// Stream a WSPR message: 12 kHz audio rendered block by block as the
+    /// output pulls it, from a synthesizer of its own.
+    func source(for message: WSPRMessage) -> TXAudioSource? {
+        guard let synth = makeSynthesizer(),
+              synth.start(tones: tones(for: message), baseFrequency: baseFrequency, amplitude: amplitude)
+        else { return nil }
+        return synth
+    }
+
+    /// Message → 162 channel tones.
+    private func tones(for message: WSPRMessage) -> [Int] {
         let bits = WSPRMessagePack.pack(message)
         let encoded = convolutionalEncode(bits)
         let interleaved = interleave(encoded)
-        let symbols = mergeWithSync(interleaved)
-        return synthesize(symbols)
+        return mergeWithSync(interleaved)
     }
 
     // MARK: - Convolutional Encoding
@@ -103,43 +120,14 @@ final class WSPRModulator {
 
     /// Synthesize continuous-phase 4-FSK audio from 162 symbols.
     private func synthesize(_ symbols: [Int]) -> [Float] {
-        let sampleRate = WSPRProtocol.sampleRate
-        let symbolSamples = WSPRProtocol.symbolSamples
-        let totalSamples = WSPRProtocol.frameSamples
-        let rampSamples = Int(rampDuration * sampleRate)
-
-        var samples = [Float](repeating: 0, count: totalSamples)
-        var phase: Double = 0
-
-        for (symIdx, symbol) in symbols.enumerated() {
-            let freq = baseFrequency + Double(symbol) * WSPRProtocol.toneSpacing
-            let phaseIncrement = 2.0 * .pi * freq / sampleRate
-
-            for j in 0..<symbolSamples {
-                let sampleIdx = symIdx * symbolSamples + j
-                guard sampleIdx < totalSamples else { break }
-
-                let value = sin(phase) * amplitude
-                samples[sampleIdx] = Float(value)
-                phase += phaseIncrement
-
-                if phase >= 2.0 * .pi { phase -= 2.0 * .pi }
-            }
-        }
-
-        applyRamp(&samples, rampSamples: rampSamples)
-        return samples
+        if synthesizer == nil { synthesizer = makeSynthesizer() }
+        guard let synth = synthesizer else { return [] }
+        return synth.renderFrame(tones: symbols, baseFrequency: baseFrequency, amplitude: amplitude)
     }
 
-    /// Apply raised-cosine ramp to avoid click artifacts.
-    private func applyRamp(_ samples: inout [Float], rampSamples: Int) {
-        let count = samples.count
-        guard rampSamples > 0, count > 2 * rampSamples else { return }
-        for i in 0..<rampSamples {
-            let ramp = Float(0.5 * (1.0 - cos(.pi * Double(i) / Double(rampSamples))))
-            samples[i] *= ramp
-            samples[count - 1 - i] *= ramp
-        }
+    private func makeSynthesizer() -> ToneSynthesizer? {
+        ToneSynthesizer(sampleRate: WSPRProtocol.sampleRate, symbolSamples: WSPRProtocol.symbolSamples,
+                        bt: 0, rampDuration: rampDuration)
     }
 
     /// Duration of generated audio in seconds.
@@ -0,0 +1,257 @@
+/**
+ * wspr_bench.c — Standalone benchmark for the C WSPR decoder core
+ *
+ * Synthesizes 2-minute windows, each holding N signals spread over
+ * 1400–1600 Hz. A signal sends a random valid message as WSPRModulator
+ * does (convolutional code, bit-reversal interleave, sync vector,
+ * continuous-phase 4-FSK), starts 0.5 to 2 s into the window and drifts
+ * linearly by up to a given amount over the frame. Signal SNRs are
+ * spread evenly over a range above a base SNR, so strong signals sit
+ * next to weak ones. White Gaussian noise is added in 2500 Hz.
+ *
+ * Each window goes through wspr_decoder_decode() as the app would call
+ * it, 113.6 s in. Reports how many of the sent messages came back and
+ * in which pass, false decodes (payloads never sent), and decode time
+ * against the 6.4 s left before the next even minute.
+ *
+ * Not part of the app target; see bench/Makefile.
+ */
+
+#include "wspr_decoder.h"
+#include "wspr_fano.h"
+#include "bench_synth.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_MAX_SIGNALS   64
+#define BENCH_MAX_RESULTS   64
+#define BENCH_BAND_LO       1400.0
+#define BENCH_BAND_HI       1600.0
+#define BENCH_PASSES        4
+
+typedef struct {
+    int   signals;         /* Per window */
+    float snr_db;          /* Weakest signal */
+    float spread_db;       /* Strongest is this much above */
+    float drift_hz;        /* Largest drift either way */
+    int   windows;
+    int   max_candidates;  /* 0 = decoder default */
+    int   fano_cycles;
+    int   passes;
+    int   threads;
+} bench_opts_t;
+
+typedef struct {
+    uint8_t payload[WSPR_PAYLOAD_BITS];
+    double  freq_hz;       /* Tone 0 at mid-frame */
+    double  drift_hz;
+    double  snr_db;
+    long    start;         /* Samples into the window */
+    int     found;
+} bench_signal_t;
+
+static const int k_powers[] = { 0, 3, 7, 10, 13, 17, 20, 23, 27, 30, 33, 37, 40,
+                                43, 47, 50, 53, 57, 60 };
+
+/* WSPRProtocol.syncVector */
+static const uint8_t k_sync[WSPR_SYMBOL_COUNT] = {
+    1,1,0,0,0,0,0,0,1,0,0,0,1,1,1,0,0,0,1,0,
+    0,1,0,1,1,1,1,0,0,0,0,0,0,0,1,0,0,1,0,1,
+    0,0,0,0,0,0,1,0,1,1,0,0,1,1,0,1,0,0,0,1,
+    1,0,1,0,0,0,0,1,1,0,1,0,1,0,1,0,1,0,0,1,
+    0,0,1,0,1,1,0,0,0,1,1,0,1,0,1,0,0,0,1,0,
+    0,0,0,0,1,0,0,1,0,0,1,1,1,0,1,1,0,0,1,1,
+    0,1,0,0,0,1,1,1,0,0,0,0,0,1,0,1,0,0,1,1,
+    0,0,0,0,0,0,0,1,1,0,1,0,1,1,0,0,0,1,1,0,
+    0,0
+};
+
+/* ------------------------------------------------------------------ */
+/* Signal synthesis                                                    */
+/* ------------------------------------------------------------------ */
+
+/* Callsign word, then grid × 128 + power + 64, as WSPRMessagePack.pack() */
+static void random_payload(uint8_t *payload)
+{
+    uint32_t call = (uint32_t)(bench_uniform() * 262177560.0);
+    uint32_t grid = (uint32_t)(bench_uniform() * 32400.0);
+    uint32_t power = (uint32_t)k_powers[(int)(bench_uniform() * 19.0)];
+    uint32_t m1 = grid * 128 + power + 64;
+
+    for (int i = 0; i < 28; i++) payload[i] = (call >> (27 - i)) & 1;
+    for (int i = 0; i < 22; i++) payload[28 + i] = (m1 >> (21 - i)) & 1;
+}
+
+/* Payload → convolutional code → interleave → tones with the sync bit */
+static void make_tones(const uint8_t *payload, uint8_t *tones)
+{
+    uint8_t bits[WSPR_FANO_MAX_BITS] = { 0 };
+    uint8_t coded[2 * WSPR_FANO_MAX_BITS];
+    memcpy(bits, payload, WSPR_PAYLOAD_BITS);
+    wspr_fano_encode(bits, WSPR_FANO_MAX_BITS, coded);
+
+    uint8_t data[WSPR_SYMBOL_COUNT];
+    for (int i = 0, j = 0; i < 256; i++) {
+        int r = 0;
+        for (int b = 0; b < 8; b++) r |= ((i >> b) & 1) << (7 - b);
+        if (r < WSPR_SYMBOL_COUNT) data[r] = coded[j++];
+    }
+    for (int i = 0; i < WSPR_SYMBOL_COUNT; i++) tones[i] = (uint8_t)(k_sync[i] + 2 * data[i]);
+}
+
+static void pick_signals(const bench_opts_t *o, bench_signal_t *sig)
+{
+    const double span = (BENCH_BAND_HI - BENCH_BAND_LO) / o->signals;
+    for (int i = 0; i < o->signals; i++) {
+        bench_signal_t *s = &sig[i];
+        random_payload(s->payload);
+        s->freq_hz = BENCH_BAND_LO + span * i + bench_uniform() * (span - 8.0);
+        s->drift_hz = o->drift_hz * (2.0 * bench_uniform() - 1.0);
+        s->snr_db = o->snr_db + (o->signals > 1 ? o->spread_db * i / (o->signals - 1) : 0.0);
+        s->start = (long)((0.5 + 1.5 * bench_uniform()) * WSPR_SAMPLE_RATE);
+        s->found = 0;
+    }
+    /* Strengths in random order across the band */
+    for (int i = o->signals - 1; i > 0; i--) {
+        int j = (int)(bench_uniform() * (i + 1));
+        double t = sig[i].snr_db;
+        sig[i].snr_db = sig[j].snr_db;
+        sig[j].snr_db = t;
+    }
+}
+
+static void synth(const bench_signal_t *sig, int n_sig, float *x, long n_samples)
+{
+    /* Unit-variance noise; a tone at snr_db has power snr × noise in 2500 Hz */
+    const double noise_in_bw = BENCH_SNR_BW_HZ / (WSPR_SAMPLE_RATE / 2.0);
+    for (long i = 0; i < n_samples; i++) x[i] = (float)bench_gauss();
+
+    const double ts = (double)WSPR_SAMPLE_RATE / WSPR_SYMBOL_SAMPLES;
+    for (int s = 0; s < n_sig; s++) {
+        uint8_t tones[WSPR_SYMBOL_COUNT];
+        make_tones(sig[s].payload, tones);
+
+        const double amp = sqrt(2.0 * pow(10.0, sig[s].snr_db / 10.0) * noise_in_bw);
+        bench_add_fsk(x, n_samples, sig[s].start, tones, WSPR_SYMBOL_COUNT, WSPR_SYMBOL_SAMPLES,
+                      WSPR_SAMPLE_RATE, sig[s].freq_hz, ts, sig[s].drift_hz, amp);
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Timing                                                              */
+/* ------------------------------------------------------------------ */
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr,
+        "usage: %s [options]\n"
+        "  -m signals    signals per window (8)\n"
+        "  -s snr_db     weakest signal's SNR in 2500 Hz (-26)\n"
+        "  -w spread_db  strongest signal this much above (20)\n"
+        "  -r drift_hz   largest drift over the frame either way (1)\n"
+        "  -n windows    2-minute windows (3)\n"
+        "  -c count      max candidates per pass (decoder default)\n"
+        "  -f cycles     Fano cycles per bit (decoder default)\n"
+        "  -p passes     search passes (decoder default)\n"
+        "  -t threads    workers (decoder default)\n",
+        argv0);
+}
+
+int main(int argc, char **argv)
+{
+    bench_opts_t o = {
+        .signals = 8, .snr_db = -26.0f, .spread_db = 20.0f, .drift_hz = 1.0f, .windows = 3,
+    };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "m:s:w:r:n:c:f:p:t:h")) != -1) {
+        switch (opt) {
+        case 'm': o.signals = atoi(optarg); break;
+        case 's': o.snr_db = (float)atof(optarg); break;
+        case 'w': o.spread_db = (float)atof(optarg); break;
+        case 'r': o.drift_hz = (float)atof(optarg); break;
+        case 'n': o.windows = atoi(optarg); break;
+        case 'c': o.max_candidates = atoi(optarg); break;
+        case 'f': o.fano_cycles = atoi(optarg); break;
+        case 'p': o.passes = atoi(optarg); break;
+        case 't': o.threads = atoi(optarg); break;
+        default: usage(argv[0]); return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (o.signals <= 0 || o.signals > BENCH_MAX_SIGNALS || o.windows <= 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    wspr_config_t cfg;
+    wspr_config_init(&cfg);
+    if (o.max_candidates > 0) cfg.max_candidates = o.max_candidates;
+    if (o.fano_cycles > 0) cfg.fano_cycles = o.fano_cycles;
+    if (o.passes > 0) cfg.passes = o.passes;
+    if (o.threads > 0) cfg.threads = o.threads;
+
+    const long n_samples = WSPR_DECODE_SAMPLES;
+    wspr_decoder_t *dec = wspr_decoder_create(&cfg);
+    float *x = (float *)malloc((size_t)n_samples * sizeof(float));
+    if (!dec || !x) return 1;
+
+    char threads_desc[16] = "auto";
+    if (o.threads > 0) snprintf(threads_desc, sizeof(threads_desc), "%d", o.threads);
+    printf("WSPR decoder benchmark: %d windows, %d signals at %.1f to %.1f dB, "
+           "drift ±%.1f Hz, %d candidates, %d Fano cycles/bit, %d passes, %s threads\n",
+           o.windows, o.signals, o.snr_db, o.snr_db + o.spread_db, o.drift_hz,
+           cfg.max_candidates, cfg.fano_cycles, cfg.passes, threads_desc);
+
+    static bench_signal_t sig[BENCH_MAX_SIGNALS];
+    static wspr_result_t res[BENCH_MAX_RESULTS];
+    int sent = 0, found = 0, false_dec = 0, by_pass[BENCH_PASSES] = { 0 };
+    double total = 0.0, longest = 0.0, snr_err = 0.0;
+
+    for (int w = 0; w < o.windows; w++) {
+        pick_signals(&o, sig);
+        synth(sig, o.signals, x, n_samples);
+
+        double t0 = now_s();
+        int n = wspr_decoder_decode(dec, x, (int)n_samples, res, BENCH_MAX_RESULTS);
+        double dt = now_s() - t0;
+        total += dt;
+        if (dt > longest) longest = dt;
+
+        for (int r = 0; r < n; r++) {
+            int hit = 0;
+            for (int s = 0; s < o.signals; s++) {
+                if (!sig[s].found && memcmp(res[r].payload, sig[s].payload, WSPR_PAYLOAD_BITS) == 0) {
+                    sig[s].found = hit = 1;
+                    found++;
+                    snr_err += fabs(res[r].snr - sig[s].snr_db);
+                    if (res[r].pass < BENCH_PASSES) by_pass[res[r].pass]++;
+                    break;
+                }
+            }
+            if (!hit) false_dec++;
+        }
+        sent += o.signals;
+    }
+
+    printf("decoded %d/%d, false %d, by pass", found, sent, false_dec);
+    for (int p = 0; p < cfg.passes && p < BENCH_PASSES; p++) printf(" %d", by_pass[p]);
+    printf(", mean SNR error %.1f dB\n", found ? snr_err / found : 0.0);
+    printf("decode: mean %.0f ms, longest %.0f ms (6.4 s to the next window)\n",
+           total / o.windows * 1e3, longest * 1e3);
+
+    free(x);
+    wspr_decoder_destroy(dec);
+    return 0;
+}
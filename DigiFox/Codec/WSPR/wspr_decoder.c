@@ -0,0 +1,807 @@
+/**
+ * wspr_decoder.c — WSPR pipeline: Baseband → Half-symbol spectra →
+ * Candidates → Drift-compensated sync → Soft symbols → Fano → Subtract
+ *
+ * No heap allocation during decode() — all state pre-allocated in
+ * create().
+ */
+
+#include "wspr_decoder.h"
+#include "wspr_fano.h"
+#include "ft8_pool.h"
+
+#include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* Baseband: 12 kHz / 32 = 375 Hz complex, 256 samples per symbol */
+#define WSPR_DECIM           32
+#define WSPR_BB_RATE         ((double)WSPR_SAMPLE_RATE / WSPR_DECIM)
+#define WSPR_BB_SYMBOL       (WSPR_SYMBOL_SAMPLES / WSPR_DECIM)
+#define WSPR_BB_MAX          (WSPR_WINDOW_SAMPLES / WSPR_DECIM)
+#define WSPR_BB_FRAME        (WSPR_SYMBOL_COUNT * WSPR_BB_SYMBOL)
+
+/* Mixdown lowpass: flat to about ±130 Hz, stopband past ±210 Hz */
+#define WSPR_FIR_TAPS        768
+#define WSPR_FIR_CUTOFF_HZ   170.0
+#define WSPR_BB_CHUNK        1024      /* Baseband samples per claim */
+
+/* Spectra: Hann-windowed symbols every half symbol, padded to half-tone bins */
+#define WSPR_SPEC_HOP        (WSPR_BB_SYMBOL / 2)
+#define WSPR_SPEC_FFT        (2 * WSPR_BB_SYMBOL)
+#define WSPR_SPEC_BIN_HZ     (WSPR_BB_RATE / WSPR_SPEC_FFT)
+#define WSPR_SPEC_MAX_ROWS   ((WSPR_BB_MAX - WSPR_BB_SYMBOL) / WSPR_SPEC_HOP + 1)
+
+#define WSPR_NUM_TONES       4
+#define WSPR_TONE_HZ         (WSPR_BB_RATE / WSPR_BB_SYMBOL)   /* 1.4648 */
+#define WSPR_MAX_SPAN_HZ     250.0f
+
+/* Noise floor: this quantile of the averaged spectrum over the band */
+#define WSPR_NOISE_QUANTILE  0.3f
+
+/* Coarse sync: base bins either side of the peak, drift step */
+#define WSPR_COARSE_BINS     2
+#define WSPR_DRIFT_STEP_HZ   0.5f
+
+#define WSPR_MAX_CANDIDATES  100
+#define WSPR_MAX_PASSES      4
+#define WSPR_MAX_DECODES     100
+#define WSPR_MAX_THREADS     16
+
+/* Message field limits (WSPRMessagePack): 180 × 180 grid squares */
+#define WSPR_GRID_COUNT      32400
+
+/* WSPRProtocol.syncVector: each symbol's low bit */
+static const uint8_t k_sync[WSPR_SYMBOL_COUNT] = {
+    1,1,0,0,0,0,0,0,1,0,0,0,1,1,1,0,0,0,1,0,
+    0,1,0,1,1,1,1,0,0,0,0,0,0,0,1,0,0,1,0,1,
+    0,0,0,0,0,0,1,0,1,1,0,0,1,1,0,1,0,0,0,1,
+    1,0,1,0,0,0,0,1,1,0,1,0,1,0,1,0,1,0,0,1,
+    0,0,1,0,1,1,0,0,0,1,1,0,1,0,1,0,0,0,1,0,
+    0,0,0,0,1,0,0,1,0,0,1,1,1,0,1,1,0,0,1,1,
+    0,1,0,0,0,1,1,1,0,0,0,0,0,1,0,1,0,0,1,1,
+    0,0,0,0,0,0,0,1,1,0,1,0,1,1,0,0,0,1,1,0,
+    0,0
+};
+
+/* WSPRMessagePack.validPowers */
+static const int k_powers[] = { 0, 3, 7, 10, 13, 17, 20, 23, 27, 30, 33, 37, 40,
+                                43, 47, 50, 53, 57, 60 };
+
+typedef struct { float re, im; } cpx_t;
+
+typedef struct {
+    /* From the spectra */
+    int   bin;                  /* Peak base bin */
+    float peak;                 /* Peak over the noise floor */
+
+    /* From sync */
+    int   start;                /* Frame start in baseband samples */
+    float freq;                 /* Base frequency at mid-frame, baseband Hz */
+    float drift;                /* Hz over the frame */
+    float sync;
+
+    int           decoded;
+    wspr_result_t res;
+    uint8_t       tones[WSPR_SYMBOL_COUNT];
+} cand_t;
+
+/* Per-worker scratch */
+typedef struct {
+    wspr_fano_t fano;
+    float       power[WSPR_SYMBOL_COUNT][WSPR_NUM_TONES];
+    float       best[WSPR_SYMBOL_COUNT][WSPR_NUM_TONES];
+    uint8_t     soft[2 * WSPR_FANO_MAX_BITS];
+    uint8_t     coded[2 * WSPR_FANO_MAX_BITS];
+    uint8_t     bits[WSPR_FANO_MAX_BITS];
+} worker_t;
+
+struct wspr_decoder_t {
+    wspr_config_t cfg;
+
+    double center_hz;           /* Audio frequency of baseband 0 Hz */
+    int    min_bin, max_bin;    /* Base-bin search range, inclusive */
+
+    /* Mixdown taps: lowpass modulated by e^{-j w k} */
+    float fir_re[WSPR_FIR_TAPS];
+    float fir_im[WSPR_FIR_TAPS];
+
+    /* The window being decoded */
+    const float *audio;
+    int          n_audio;
+    cpx_t       *bb;            /* WSPR_BB_MAX */
+    int          n_bb;
+
+    /* Spectra: rows × WSPR_SPEC_FFT bins, 0 Hz at bin WSPR_SPEC_FFT / 2 */
+    float *spec;
+    int    n_rows;
+    float  avg[WSPR_SPEC_FFT];   /* Summed over rows */
+    float  noise;                /* Noise power per tone and symbol */
+    float  sorted[WSPR_SPEC_FFT];
+    cpx_t  fft[WSPR_SPEC_FFT];
+    float  window[WSPR_BB_SYMBOL];
+    float  window_power;         /* Mean square of the window */
+    cpx_t  twiddle[WSPR_SPEC_FFT / 2];
+    int    bitrev[WSPR_SPEC_FFT];
+
+    /* e^{-2 pi j n / 256}: tone k of a symbol correlates with twiddle k·n */
+    cpx_t  tone_tw[WSPR_BB_SYMBOL];
+
+    /* Channel position of each coded bit (the bit-reversal interleaver) */
+    uint8_t perm[WSPR_SYMBOL_COUNT];
+
+    cand_t *cand;               /* max_candidates */
+    int     n_cand;
+    int     pass;
+
+    /* Payloads already reported this window */
+    uint8_t found[WSPR_MAX_DECODES][WSPR_PAYLOAD_BITS];
+    int     n_found;
+
+    ft8_pool_t  *pool;
+    int          n_workers;
+    worker_t    *worker;        /* n_workers */
+    _Atomic int  next;
+};
+
+/* ------------------------------------------------------------------ */
+/* Config                                                              */
+/* ------------------------------------------------------------------ */
+
+void wspr_config_init(wspr_config_t *cfg)
+{
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->min_freq       = 1400.0f;
+    cfg->max_freq       = 1600.0f;
+    cfg->max_drift      = 4.0f;
+    cfg->min_snr        = 0.05f;
+    cfg->sync_threshold = 0.1f;
+    cfg->max_candidates = 30;
+    cfg->fano_cycles    = 10000;
+    cfg->passes         = 2;
+    cfg->threads        = 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* Create / destroy                                                    */
+/* ------------------------------------------------------------------ */
+
+static void init_tables(wspr_decoder_t *dec)
+{
+    /* Blackman-windowed sinc, unity gain at DC, shifted to center_hz */
+    const double w = 2.0 * M_PI * dec->center_hz / WSPR_SAMPLE_RATE;
+    const double fc = WSPR_FIR_CUTOFF_HZ / WSPR_SAMPLE_RATE;
+    const double mid = 0.5 * (WSPR_FIR_TAPS - 1);
+    double h[WSPR_FIR_TAPS], sum = 0.0;
+    for (int k = 0; k < WSPR_FIR_TAPS; k++) {
+        double x = k - mid;
+        double sinc = x == 0.0 ? 2.0 * fc : sin(2.0 * M_PI * fc * x) / (M_PI * x);
+        double a = 2.0 * M_PI * k / (WSPR_FIR_TAPS - 1);
+        h[k] = sinc * (0.42 - 0.5 * cos(a) + 0.08 * cos(2.0 * a));
+        sum += h[k];
+    }
+    for (int k = 0; k < WSPR_FIR_TAPS; k++) {
+        dec->fir_re[k] = (float)(h[k] / sum * cos(w * k));
+        dec->fir_im[k] = (float)(-h[k] / sum * sin(w * k));
+    }
+
+    for (int k = 0; k < WSPR_SPEC_FFT / 2; k++) {
+        double a = -2.0 * M_PI * k / WSPR_SPEC_FFT;
+        dec->twiddle[k] = (cpx_t){ (float)cos(a), (float)sin(a) };
+    }
+    /* Hann: keeps strong signals' leakage off the noise floor */
+    double w2 = 0.0;
+    for (int n = 0; n < WSPR_BB_SYMBOL; n++) {
+        dec->window[n] = (float)(0.5 - 0.5 * cos(2.0 * M_PI * (n + 0.5) / WSPR_BB_SYMBOL));
+        w2 += (double)dec->window[n] * dec->window[n];
+    }
+    dec->window_power = (float)(w2 / WSPR_BB_SYMBOL);
+
+    int bits = 0;
+    while ((1 << bits) < WSPR_SPEC_FFT) bits++;
+    for (int i = 0; i < WSPR_SPEC_FFT; i++) {
+        int r = 0;
+        for (int b = 0; b < bits; b++) r |= ((i >> b) & 1) << (bits - 1 - b);
+        dec->bitrev[i] = r;
+    }
+
+    for (int n = 0; n < WSPR_BB_SYMBOL; n++) {
+        double a = -2.0 * M_PI * n / WSPR_BB_SYMBOL;
+        dec->tone_tw[n] = (cpx_t){ (float)cos(a), (float)sin(a) };
+    }
+
+    /* Coded bit j goes to the j-th 8-bit reversal below 162 */
+    for (int i = 0, j = 0; i < 256; i++) {
+        int r = 0;
+        for (int b = 0; b < 8; b++) r |= ((i >> b) & 1) << (7 - b);
+        if (r < WSPR_SYMBOL_COUNT) dec->perm[j++] = (uint8_t)r;
+    }
+}
+
+wspr_decoder_t *wspr_decoder_create(const wspr_config_t *cfg)
+{
+    wspr_decoder_t *dec = (wspr_decoder_t *)calloc(1, sizeof(wspr_decoder_t));
+    if (!dec) return NULL;
+
+    if (cfg) {
+        dec->cfg = *cfg;
+    } else {
+        wspr_config_init(&dec->cfg);
+    }
+    wspr_config_t *c = &dec->cfg;
+    if (c->max_freq < c->min_freq) c->max_freq = c->min_freq;
+    if (c->max_freq - c->min_freq > WSPR_MAX_SPAN_HZ) c->max_freq = c->min_freq + WSPR_MAX_SPAN_HZ;
+    if (c->max_drift < 0.0f) c->max_drift = 0.0f;
+    if (c->max_drift > 8.0f) c->max_drift = 8.0f;
+    if (c->max_candidates < 1) c->max_candidates = 1;
+    if (c->max_candidates > WSPR_MAX_CANDIDATES) c->max_candidates = WSPR_MAX_CANDIDATES;
+    if (c->fano_cycles < 1) c->fano_cycles = 1;
+    if (c->passes < 1) c->passes = 1;
+    if (c->passes > WSPR_MAX_PASSES) c->passes = WSPR_MAX_PASSES;
+    if (c->threads <= 0) c->threads = ft8_pool_default_size();
+    if (c->threads > WSPR_MAX_THREADS) c->threads = WSPR_MAX_THREADS;
+
+    /* Baseband 0 Hz mid-way between the lowest and highest signal centres */
+    dec->center_hz = 0.5 * (c->min_freq + c->max_freq) + 1.5 * WSPR_TONE_HZ;
+    dec->min_bin = WSPR_SPEC_FFT / 2 + (int)floor((c->min_freq - dec->center_hz) / WSPR_SPEC_BIN_HZ);
+    dec->max_bin = WSPR_SPEC_FFT / 2 + (int)ceil((c->max_freq - dec->center_hz) / WSPR_SPEC_BIN_HZ);
+
+    init_tables(dec);
+
+    dec->bb = (cpx_t *)calloc(WSPR_BB_MAX, sizeof(cpx_t));
+    dec->spec = (float *)calloc((size_t)WSPR_SPEC_MAX_ROWS * WSPR_SPEC_FFT, sizeof(float));
+    dec->cand = (cand_t *)calloc((size_t)c->max_candidates, sizeof(cand_t));
+    if (!dec->bb || !dec->spec || !dec->cand) {
+        wspr_decoder_destroy(dec);
+        return NULL;
+    }
+
+    /* Threads that fail to start leave the work on the calling thread */
+    dec->pool = c->threads > 1 ? ft8_pool_create(c->threads) : NULL;
+    dec->n_workers = ft8_pool_size(dec->pool);
+    dec->worker = (worker_t *)calloc((size_t)dec->n_workers, sizeof(worker_t));
+    if (!dec->worker) {
+        wspr_decoder_destroy(dec);
+        return NULL;
+    }
+    for (int i = 0; i < dec->n_workers; i++) wspr_fano_init(&dec->worker[i].fano);
+
+    return dec;
+}
+
+void wspr_decoder_destroy(wspr_decoder_t *dec)
+{
+    if (!dec) return;
+    ft8_pool_destroy(dec->pool);
+    free(dec->worker);
+    free(dec->bb);
+    free(dec->spec);
+    free(dec->cand);
+    free(dec);
+}
+
+/* ------------------------------------------------------------------ */
+/* Baseband                                                            */
+/* ------------------------------------------------------------------ */
+
+/*
+ * Baseband sample m is the lowpass centred on audio sample 32m. The taps
+ * carry the mix relative to their first sample; the rest of the mix,
+ * e^{-j w n0}, is applied per output so the phase is continuous.
+ */
+static void baseband_stage(void *ctx, int worker)
+{
+    wspr_decoder_t *dec = (wspr_decoder_t *)ctx;
+    (void)worker;
+
+    const double w = 2.0 * M_PI * dec->center_hz / WSPR_SAMPLE_RATE;
+    const float *x = dec->audio;
+
+    for (;;) {
+        int lo = atomic_fetch_add_explicit(&dec->next, 1, memory_order_relaxed) * WSPR_BB_CHUNK;
+        if (lo >= dec->n_bb) return;
+        int hi = lo + WSPR_BB_CHUNK < dec->n_bb ? lo + WSPR_BB_CHUNK : dec->n_bb;
+
+        for (int m = lo; m < hi; m++) {
+            const long n0 = (long)m * WSPR_DECIM - WSPR_FIR_TAPS / 2;
+            float acc_re = 0.0f, acc_im = 0.0f;
+
+            if (n0 >= 0 && n0 + WSPR_FIR_TAPS <= dec->n_audio) {
+                const float *xs = x + n0;
+                for (int k = 0; k < WSPR_FIR_TAPS; k++) {
+                    acc_re += dec->fir_re[k] * xs[k];
+                    acc_im += dec->fir_im[k] * xs[k];
+                }
+            } else {
+                for (int k = 0; k < WSPR_FIR_TAPS; k++) {
+                    long n = n0 + k;
+                    if (n < 0 || n >= dec->n_audio) continue;
+                    acc_re += dec->fir_re[k] * x[n];
+                    acc_im += dec->fir_im[k] * x[n];
+                }
+            }
+
+            double a = fmod(w * (double)n0, 2.0 * M_PI);
+            float c = (float)cos(a), s = (float)-sin(a);
+            dec->bb[m].re = acc_re * c - acc_im * s;
+            dec->bb[m].im = acc_re * s + acc_im * c;
+        }
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Spectra and candidates                                              */
+/* ------------------------------------------------------------------ */
+
+/* In-place radix-2 transform of dec->fft */
+static void fft(wspr_decoder_t *dec)
+{
+    cpx_t *a = dec->fft;
+    for (int i = 0; i < WSPR_SPEC_FFT; i++) {
+        int j = dec->bitrev[i];
+        if (j > i) {
+            cpx_t t = a[i];
+            a[i] = a[j];
+            a[j] = t;
+        }
+    }
+    for (int len = 2; len <= WSPR_SPEC_FFT; len <<= 1) {
+        const int half = len >> 1, step = WSPR_SPEC_FFT / len;
+        for (int i = 0; i < WSPR_SPEC_FFT; i += len) {
+            for (int k = 0; k < half; k++) {
+                cpx_t w = dec->twiddle[k * step];
+                cpx_t *u = &a[i + k], *v = &a[i + k + half];
+                float tr = v->re * w.re - v->im * w.im;
+                float ti = v->re * w.im + v->im * w.re;
+                v->re = u->re - tr;
+                v->im = u->im - ti;
+                u->re += tr;
+                u->im += ti;
+            }
+        }
+    }
+}
+
+/* Symbol-length spectra every half symbol, and their average */
+static void build_spectra(wspr_decoder_t *dec)
+{
+    dec->n_rows = dec->n_bb >= WSPR_BB_SYMBOL
+                      ? (dec->n_bb - WSPR_BB_SYMBOL) / WSPR_SPEC_HOP + 1 : 0;
+    memset(dec->avg, 0, sizeof(dec->avg));
+
+    for (int r = 0; r < dec->n_rows; r++) {
+        const cpx_t *z = dec->bb + r * WSPR_SPEC_HOP;
+        for (int n = 0; n < WSPR_BB_SYMBOL; n++) {
+            dec->fft[n].re = z[n].re * dec->window[n];
+            dec->fft[n].im = z[n].im * dec->window[n];
+        }
+        memset(dec->fft + WSPR_BB_SYMBOL, 0, (WSPR_SPEC_FFT - WSPR_BB_SYMBOL) * sizeof(cpx_t));
+        fft(dec);
+
+        float *row = dec->spec + (long)r * WSPR_SPEC_FFT;
+        for (int b = 0; b < WSPR_SPEC_FFT; b++) {
+            const cpx_t v = dec->fft[(b + WSPR_SPEC_FFT / 2) % WSPR_SPEC_FFT];
+            row[b] = v.re * v.re + v.im * v.im;
+            dec->avg[b] += row[b];
+        }
+    }
+}
+
+static int cmp_float(const void *a, const void *b)
+{
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+/* Keep the strongest max_candidates peaks, strongest first */
+static void add_candidate(wspr_decoder_t *dec, int bin, float peak)
+{
+    const int max = dec->cfg.max_candidates;
+    int k = dec->n_cand;
+    if (k == max) {
+        if (dec->cand[max - 1].peak >= peak) return;
+        k = max - 1;
+    } else {
+        dec->n_cand++;
+    }
+    for (; k > 0 && dec->cand[k - 1].peak < peak; k--) dec->cand[k] = dec->cand[k - 1];
+
+    memset(&dec->cand[k], 0, sizeof(cand_t));
+    dec->cand[k].bin = bin;
+    dec->cand[k].peak = peak;
+}
+
+/*
+ * Local maxima of the averaged 4-tone sum over the noise floor. Signals
+ * already subtracted leave no peak, so later passes find new ones.
+ */
+static void find_candidates(wspr_decoder_t *dec)
+{
+    const int lo = dec->min_bin - WSPR_COARSE_BINS;
+    const int hi = dec->max_bin + WSPR_COARSE_BINS;
+    const int span = 2 * (WSPR_NUM_TONES - 1);
+    dec->n_cand = 0;
+
+    int n = 0;
+    for (int b = lo; b <= hi + span; b++) dec->sorted[n++] = dec->avg[b];
+    qsort(dec->sorted, (size_t)n, sizeof(float), cmp_float);
+    const float per_bin = dec->sorted[(int)(WSPR_NOISE_QUANTILE * n)] + 1e-20f;
+    const float floor4 = WSPR_NUM_TONES * per_bin;
+    /* Per unwindowed symbol, as the tone correlations measure it */
+    dec->noise = per_bin / ((dec->n_rows > 0 ? dec->n_rows : 1) * dec->window_power);
+
+    float s[3] = { 0.0f, 0.0f, 0.0f };   /* Bins b - 2, b - 1, b */
+    for (int b = lo - 1; b <= hi + 1; b++) {
+        s[0] = s[1];
+        s[1] = s[2];
+        s[2] = 0.0f;
+        for (int t = 0; t < WSPR_NUM_TONES; t++) s[2] += dec->avg[b + 2 * t];
+        s[2] = s[2] / floor4 - 1.0f;
+
+        if (b - 1 >= lo && s[1] > dec->cfg.min_snr && s[1] >= s[0] && s[1] > s[2]) {
+            add_candidate(dec, b - 1, s[1]);
+        }
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Sync                                                                */
+/* ------------------------------------------------------------------ */
+
+/* Frequency offset of symbol i under a drift over the whole frame */
+static inline float drift_at(float drift, int i)
+{
+    return drift * ((float)i / (WSPR_SYMBOL_COUNT - 1) - 0.5f);
+}
+
+/*
+ * Sync correlation: per symbol, the power in the two tones its sync bit
+ * allows less the other two, summed and taken over the total power. A
+ * clean, aligned signal scores 1, noise about 0.
+ */
+static inline void sync_term(int i, const float *p, double *ss, double *total)
+{
+    const float d = (p[1] + p[3]) - (p[0] + p[2]);
+    *ss += k_sync[i] ? d : -d;
+    *total += p[0] + p[1] + p[2] + p[3];
+}
+
+/* On the spectra: frame from spectrum row row0, base bin at mid-frame */
+static float coarse_sync(const wspr_decoder_t *dec, int row0, int bin, float drift)
+{
+    double ss = 0.0, total = 0.0;
+    for (int i = 0; i < WSPR_SYMBOL_COUNT; i++) {
+        const int b = bin + (int)lrintf(drift_at(drift, i) / (float)WSPR_SPEC_BIN_HZ);
+        const float *row = dec->spec + (long)(row0 + 2 * i) * WSPR_SPEC_FFT + b;
+        const float p[WSPR_NUM_TONES] = { row[0], row[2], row[4], row[6] };
+        sync_term(i, p, &ss, &total);
+    }
+    return total > 0.0 ? (float)(ss / total) : 0.0f;
+}
+
+/*
+ * Best start row, base bin near the peak and drift on the spectra.
+ * Frames must end within the baseband.
+ */
+static float search_sync(const wspr_decoder_t *dec, cand_t *c)
+{
+    int max_row = (dec->n_bb - WSPR_BB_FRAME) / WSPR_SPEC_HOP;
+    const int latest = (int)(WSPR_MAX_START_S * WSPR_BB_RATE) / WSPR_SPEC_HOP;
+    if (max_row > latest) max_row = latest;
+
+    const int n_drift = (int)(dec->cfg.max_drift / WSPR_DRIFT_STEP_HZ);
+    float best = -1.0f;
+    for (int row = 0; row <= max_row; row++) {
+        for (int db = -WSPR_COARSE_BINS; db <= WSPR_COARSE_BINS; db++) {
+            for (int k = -n_drift; k <= n_drift; k++) {
+                const float drift = k * WSPR_DRIFT_STEP_HZ;
+                const float s = coarse_sync(dec, row, c->bin + db, drift);
+                if (s <= best) continue;
+                best = s;
+                c->start = row * WSPR_SPEC_HOP;
+                c->freq = (float)((c->bin + db - WSPR_SPEC_FFT / 2) * WSPR_SPEC_BIN_HZ);
+                c->drift = drift;
+            }
+        }
+    }
+    c->sync = best;
+    return best;
+}
+
+/*
+ * Exact tone powers of every symbol from the baseband: the symbol mixed
+ * down by its tone-0 frequency, then DFT bins 0 to 3, which are the four
+ * tones. Samples outside the baseband count as zero. Returns the sync
+ * correlation on those powers.
+ */
+static float correlate(const wspr_decoder_t *dec, int start, float freq, float drift,
+                       float (*power)[WSPR_NUM_TONES])
+{
+    double ss = 0.0, total = 0.0;
+
+    for (int i = 0; i < WSPR_SYMBOL_COUNT; i++) {
+        const double a = -2.0 * M_PI * (freq + drift_at(drift, i)) / WSPR_BB_RATE;
+        const float step_re = (float)cos(a), step_im = (float)sin(a);
+        float ph_re = 1.0f, ph_im = 0.0f;
+        float c_re[WSPR_NUM_TONES] = { 0 }, c_im[WSPR_NUM_TONES] = { 0 };
+
+        const int s0 = start + i * WSPR_BB_SYMBOL;
+        for (int n = 0; n < WSPR_BB_SYMBOL; n++) {
+            const int m = s0 + n;
+            if (m >= 0 && m < dec->n_bb) {
+                const cpx_t z = dec->bb[m];
+                const float v_re = z.re * ph_re - z.im * ph_im;
+                const float v_im = z.re * ph_im + z.im * ph_re;
+                for (int k = 0; k < WSPR_NUM_TONES; k++) {
+                    const cpx_t w = dec->tone_tw[(k * n) & (WSPR_BB_SYMBOL - 1)];
+                    c_re[k] += v_re * w.re - v_im * w.im;
+                    c_im[k] += v_re * w.im + v_im * w.re;
+                }
+            }
+            const float t = ph_re * step_re - ph_im * step_im;
+            ph_im = ph_re * step_im + ph_im * step_re;
+            ph_re = t;
+        }
+
+        for (int k = 0; k < WSPR_NUM_TONES; k++) {
+            power[i][k] = c_re[k] * c_re[k] + c_im[k] * c_im[k];
+        }
+        sync_term(i, power[i], &ss, &total);
+    }
+    return total > 0.0 ? (float)(ss / total) : 0.0f;
+}
+
+/* Keep a move that improves the sync, with its symbol powers */
+static int try_move(const wspr_decoder_t *dec, worker_t *wk, cand_t *c, float *best,
+                    int start, float freq, float drift)
+{
+    const float s = correlate(dec, start, freq, drift, wk->power);
+    if (s <= *best) return 0;
+
+    *best = s;
+    c->start = start;
+    c->freq = freq;
+    c->drift = drift;
+    memcpy(wk->best, wk->power, sizeof(wk->best));
+    return 1;
+}
+
+/*
+ * Refine start, frequency and drift on the baseband by halving steps
+ * either way, from the spectra's half-symbol, half-tone and drift-step
+ * resolution down. Leaves the best symbol powers in wk->best.
+ */
+static float refine_sync(const wspr_decoder_t *dec, worker_t *wk, cand_t *c)
+{
+    float best = correlate(dec, c->start, c->freq, c->drift, wk->best);
+
+    for (int d = WSPR_SPEC_HOP / 4; d >= 1; d /= 2) {
+        if (!try_move(dec, wk, c, &best, c->start - d, c->freq, c->drift)) {
+            try_move(dec, wk, c, &best, c->start + d, c->freq, c->drift);
+        }
+    }
+    for (float d = 0.5f * WSPR_SPEC_BIN_HZ; d > 0.02f; d *= 0.5f) {
+        if (!try_move(dec, wk, c, &best, c->start, c->freq - d, c->drift)) {
+            try_move(dec, wk, c, &best, c->start, c->freq + d, c->drift);
+        }
+    }
+    for (float d = 0.5f * WSPR_DRIFT_STEP_HZ; d > 0.1f; d *= 0.5f) {
+        if (!try_move(dec, wk, c, &best, c->start, c->freq, c->drift - d)) {
+            try_move(dec, wk, c, &best, c->start, c->freq, c->drift + d);
+        }
+    }
+
+    c->sync = best;
+    return best;
+}
+
+/* ------------------------------------------------------------------ */
+/* Soft symbols, Fano, message check                                   */
+/* ------------------------------------------------------------------ */
+
+/*
+ * WSPRMessagePack.unpack() fields that a real message can carry: the
+ * 22-bit grid and power word, offset by 64, holds a grid square below
+ * 180 × 180 and one of the valid power levels. Noise the Fano decoder
+ * happens to complete rarely passes both.
+ */
+static int valid_payload(const uint8_t *bits)
+{
+    uint32_t m1 = 0;
+    for (int i = 28; i < WSPR_PAYLOAD_BITS; i++) m1 = (m1 << 1) | bits[i];
+    if (m1 < 64) return 0;
+
+    const uint32_t power = (m1 - 64) % 128, grid = (m1 - 64) / 128;
+    if (grid >= WSPR_GRID_COUNT) return 0;
+    for (size_t i = 0; i < sizeof(k_powers) / sizeof(k_powers[0]); i++) {
+        if ((uint32_t)k_powers[i] == power) return 1;
+    }
+    return 0;
+}
+
+/*
+ * Each symbol carries its data bit as tone sync + 2·bit, so the soft
+ * value is the amplitude of tone sync + 2 less that of tone sync.
+ * Scaled to unit RMS, deinterleaved into coded-bit order, and decoded.
+ */
+static int demodulate(const wspr_decoder_t *dec, worker_t *wk, cand_t *c)
+{
+    float x[WSPR_SYMBOL_COUNT];
+    double sum2 = 0.0;
+    for (int i = 0; i < WSPR_SYMBOL_COUNT; i++) {
+        const float *p = wk->best[i];
+        x[i] = sqrtf(p[k_sync[i] + 2]) - sqrtf(p[k_sync[i]]);
+        sum2 += (double)x[i] * x[i];
+    }
+    const float scale = WSPR_FANO_SOFT_SCALE / (float)sqrt(sum2 / WSPR_SYMBOL_COUNT + 1e-30);
+    for (int j = 0; j < WSPR_SYMBOL_COUNT; j++) {
+        float v = 128.0f + scale * x[dec->perm[j]];
+        wk->soft[j] = (uint8_t)(v < 0.0f ? 0.0f : v > 255.0f ? 255.0f : v + 0.5f);
+    }
+
+    unsigned cycles = 0;
+    if (wspr_fano_decode(&wk->fano, wk->soft, WSPR_FANO_MAX_BITS,
+                         (unsigned)dec->cfg.fano_cycles, wk->bits, NULL, &cycles) != 0 ||
+        !valid_payload(wk->bits)) {
+        return 0;
+    }
+
+    /* Channel symbols as sent, for the SNR and for subtraction */
+    memset(wk->bits + WSPR_PAYLOAD_BITS, 0, WSPR_FANO_TAIL);
+    wspr_fano_encode(wk->bits, WSPR_FANO_MAX_BITS, wk->coded);
+    for (int j = 0; j < WSPR_SYMBOL_COUNT; j++) {
+        const int i = dec->perm[j];
+        c->tones[i] = (uint8_t)(k_sync[i] + 2 * wk->coded[j]);
+    }
+
+    /*
+     * Sent tone's power over the spectra's noise floor. The other three
+     * tones are no noise reference for a strong signal: its own leakage
+     * into them would cap the SNR.
+     */
+    double signal = 0.0;
+    for (int i = 0; i < WSPR_SYMBOL_COUNT; i++) signal += wk->best[i][c->tones[i]];
+    signal = signal / WSPR_SYMBOL_COUNT - dec->noise;
+    if (signal < 1e-3 * dec->noise) signal = 1e-3 * dec->noise;
+
+    wspr_result_t *r = &c->res;
+    memcpy(r->payload, wk->bits, WSPR_PAYLOAD_BITS);
+    r->snr = (float)(10.0 * log10(signal / dec->noise)
+                     - 10.0 * log10(2500.0 / WSPR_TONE_HZ));
+    r->freq_hz = (float)(dec->center_hz + c->freq);
+    r->drift_hz = c->drift;
+    r->time_s = (float)c->start * WSPR_DECIM / WSPR_SAMPLE_RATE;
+    r->sync = c->sync;
+    r->cycles = cycles;
+    r->pass = dec->pass;
+    return 1;
+}
+
+/* ------------------------------------------------------------------ */
+/* Subtraction                                                         */
+/* ------------------------------------------------------------------ */
+
+/*
+ * Remove a decoded signal from the baseband: each symbol's tone as
+ * decoded, with the complex amplitude it has in the residual over that
+ * symbol, so fading and phase drift come out with it.
+ */
+static void subtract(wspr_decoder_t *dec, const cand_t *c)
+{
+    for (int i = 0; i < WSPR_SYMBOL_COUNT; i++) {
+        const int s0 = c->start + i * WSPR_BB_SYMBOL;
+        int lo = s0 < 0 ? 0 : s0;
+        int hi = s0 + WSPR_BB_SYMBOL < dec->n_bb ? s0 + WSPR_BB_SYMBOL : dec->n_bb;
+        if (hi <= lo) continue;
+
+        const double f = c->freq + drift_at(c->drift, i) + c->tones[i] * WSPR_TONE_HZ;
+        const double a = 2.0 * M_PI * f / WSPR_BB_RATE;
+        const float step_re = (float)cos(a), step_im = (float)sin(a);
+
+        /* Amplitude: correlation with e^{+j a n}, n from the symbol start */
+        const double a0 = a * (lo - s0);
+        float ph_re = (float)cos(a0), ph_im = (float)sin(a0);
+        float amp_re = 0.0f, amp_im = 0.0f;
+        for (int m = lo; m < hi; m++) {
+            const cpx_t z = dec->bb[m];
+            amp_re += z.re * ph_re + z.im * ph_im;
+            amp_im += z.im * ph_re - z.re * ph_im;
+            const float t = ph_re * step_re - ph_im * step_im;
+            ph_im = ph_re * step_im + ph_im * step_re;
+            ph_re = t;
+        }
+        amp_re /= (float)(hi - lo);
+        amp_im /= (float)(hi - lo);
+
+        ph_re = (float)cos(a0);
+        ph_im = (float)sin(a0);
+        for (int m = lo; m < hi; m++) {
+            dec->bb[m].re -= amp_re * ph_re - amp_im * ph_im;
+            dec->bb[m].im -= amp_re * ph_im + amp_im * ph_re;
+            const float t = ph_re * step_re - ph_im * step_im;
+            ph_im = ph_re * step_im + ph_im * step_re;
+            ph_re = t;
+        }
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Decode                                                              */
+/* ------------------------------------------------------------------ */
+
+/* One candidate per claim: sync on the spectra, refine, Fano */
+static void candidate_stage(void *ctx, int worker)
+{
+    wspr_decoder_t *dec = (wspr_decoder_t *)ctx;
+    worker_t *wk = &dec->worker[worker];
+
+    for (;;) {
+        int k = atomic_fetch_add_explicit(&dec->next, 1, memory_order_relaxed);
+        if (k >= dec->n_cand) return;
+        cand_t *c = &dec->cand[k];
+
+        /* Refining costs far more than the spectra search: skip the hopeless */
+        if (search_sync(dec, c) < 0.5f * dec->cfg.sync_threshold) continue;
+        if (refine_sync(dec, wk, c) < dec->cfg.sync_threshold) continue;
+        c->decoded = demodulate(dec, wk, c);
+    }
+}
+
+/* Same payload already reported in this window */
+static int already_decoded(const wspr_decoder_t *dec, const uint8_t *payload)
+{
+    for (int i = 0; i < dec->n_found; i++) {
+        if (memcmp(dec->found[i], payload, WSPR_PAYLOAD_BITS) == 0) return 1;
+    }
+    return 0;
+}
+
+int wspr_decoder_decode(wspr_decoder_t *dec, const float *audio, int n,
+                        wspr_result_t *out, int max_out)
+{
+    if (!dec || !audio || !out || max_out <= 0) return 0;
+    if (n > WSPR_WINDOW_SAMPLES) n = WSPR_WINDOW_SAMPLES;
+
+    dec->n_bb = n / WSPR_DECIM;
+    dec->n_found = 0;
+    if (dec->n_bb < WSPR_BB_FRAME) return 0;
+
+    dec->audio = audio;
+    dec->n_audio = n;
+    atomic_store(&dec->next, 0);
+    ft8_pool_run(dec->pool, baseband_stage, dec);
+    dec->audio = NULL;
+
+    int n_out = 0;
+    for (dec->pass = 0; dec->pass < dec->cfg.passes && n_out < max_out; dec->pass++) {
+        build_spectra(dec);
+        find_candidates(dec);
+        if (!dec->n_cand) break;
+
+        atomic_store(&dec->next, 0);
+        ft8_pool_run(dec->pool, candidate_stage, dec);
+
+        /* Reduction: dedup, report and subtract, strongest candidate first */
+        int fresh = 0;
+        for (int k = 0; k < dec->n_cand && n_out < max_out; k++) {
+            const cand_t *c = &dec->cand[k];
+            if (!c->decoded || already_decoded(dec, c->res.payload)) continue;
+
+            if (dec->n_found < WSPR_MAX_DECODES) {
+                memcpy(dec->found[dec->n_found++], c->res.payload, WSPR_PAYLOAD_BITS);
+            }
+            out[n_out++] = c->res;
+            subtract(dec, c);
+            fresh++;
+        }
+
+        /* Nothing subtracted: another pass would see the same spectra */
+        if (!fresh) break;
+    }
+    return n_out;
+}
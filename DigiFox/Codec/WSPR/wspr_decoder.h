@@ -0,0 +1,131 @@
+/**
+ * wspr_decoder.h — Public C API for the WSPR receive decoder
+ *
+ * Receive counterpart of WSPRModulator. WSPR sends one 110.6 s frame of
+ * 162 4-FSK symbols in each 2-minute window, starting about 1 s after an
+ * even UTC minute. Tones are 1.46 Hz apart, and each symbol's low bit is
+ * the sync vector (WSPRProtocol.syncVector).
+ *
+ * The audio of one window is mixed down around the search band and
+ * decimated to 375 Hz complex, so a symbol is 256 samples. Then:
+ *
+ *   1. Half-symbol spectra of the baseband, zero-padded to half-tone
+ *      bins, averaged over the window. Peaks over the noise floor are
+ *      the candidates.
+ *   2. Per candidate, the sync vector is correlated over start time,
+ *      frequency and linear drift on the spectra, then refined on the
+ *      baseband itself with exact per-symbol tone correlations.
+ *   3. Soft symbols from the two tones each symbol can carry,
+ *      deinterleaved, go through the Fano sequential decoder
+ *      (wspr_fano.h) with a cycle budget.
+ *   4. Each decoded signal is re-encoded and subtracted from the
+ *      baseband, and the residual is searched again, so weaker signals
+ *      masked by a strong one come through on the next pass.
+ *
+ * Candidates of a pass are spread over ft8_pool workers. All memory is
+ * allocated in wspr_decoder_create(); decoding does no heap allocation.
+ *
+ * Usage:
+ *   wspr_config_t cfg;
+ *   wspr_config_init(&cfg);
+ *   wspr_decoder_t *dec = wspr_decoder_create(&cfg);
+ *
+ *   // Audio from the even minute on, WSPR_DECODE_SAMPLES or more
+ *   int n = wspr_decoder_decode(dec, audio, n_samples, res, 32);
+ */
+
+#ifndef WSPR_DECODER_H
+#define WSPR_DECODER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WSPR_SAMPLE_RATE     12000
+#define WSPR_SYMBOL_COUNT    162
+#define WSPR_SYMBOL_SAMPLES  8192
+#define WSPR_PAYLOAD_BITS    50
+
+/* Frames are searched starting up to this long after the window start */
+#define WSPR_MAX_START_S     3
+
+/* Audio that holds a frame starting as late as WSPR_MAX_START_S (113.6 s) */
+#define WSPR_DECODE_SAMPLES  (WSPR_MAX_START_S * WSPR_SAMPLE_RATE \
+                              + WSPR_SYMBOL_COUNT * WSPR_SYMBOL_SAMPLES)
+
+/* Longest audio taken: the whole 2-minute window */
+#define WSPR_WINDOW_SAMPLES  (120 * WSPR_SAMPLE_RATE)
+
+typedef struct wspr_decoder_t wspr_decoder_t;
+
+/* Configuration struct — all fields have sensible defaults via wspr_config_init() */
+typedef struct wspr_config_t {
+    float min_freq;        /* Lowest base (tone 0) frequency in Hz (default: 1400) */
+    float max_freq;        /* Highest base frequency in Hz, at most 250 Hz
+                              above min_freq (default: 1600) */
+    float max_drift;       /* Largest frequency drift searched, Hz over the
+                              frame either way (default: 4) */
+    float min_snr;         /* Spectrum peak over the noise floor, as a
+                              ratio, to be a candidate (default: 0.05) */
+    float sync_threshold;  /* Minimum sync correlation, 0..1 (default: 0.1) */
+    int   max_candidates;  /* Candidates tried per pass (default: 30) */
+    int   fano_cycles;     /* Fano cycle budget per decoded bit (default: 10000) */
+    int   passes;          /* Search passes; each after the first runs on
+                              the residual of the ones before (default: 2) */
+    int   threads;         /* Workers, the calling thread included;
+                              0 = one per performance core (default: 0) */
+} wspr_config_t;
+
+/* One decoded message */
+typedef struct {
+    uint8_t  payload[WSPR_PAYLOAD_BITS];  /* Message bits, 0/1, first bit first */
+    float    snr;                         /* Estimated SNR in dB (2500 Hz) */
+    float    freq_hz;                     /* Base (tone 0) frequency at mid-frame, Hz */
+    float    drift_hz;                    /* Frequency change over the frame, Hz */
+    float    time_s;                      /* Frame start after the window start in s */
+    float    sync;                        /* Sync correlation, 0..1 */
+    unsigned cycles;                      /* Fano cycles spent */
+    int      pass;                        /* Search pass it was found in, from 0 */
+} wspr_result_t;
+
+/**
+ * Initialize config with default values.
+ * Always call this before modifying individual fields.
+ */
+void wspr_config_init(wspr_config_t *cfg);
+
+/**
+ * Create a decoder instance.
+ * Returns NULL on allocation failure.
+ */
+wspr_decoder_t *wspr_decoder_create(const wspr_config_t *cfg);
+
+/**
+ * Decode one 2-minute window.
+ *
+ * @param dec      Decoder handle
+ * @param audio    Audio samples (mono, float, 12 kHz) from the even
+ *                 minute on; frames must end within them, so pass at
+ *                 least WSPR_DECODE_SAMPLES to search every start time.
+ *                 Samples past WSPR_WINDOW_SAMPLES are ignored.
+ * @param n        Number of samples
+ * @param out      Output array for decoded messages, by pass, strongest
+ *                 candidate first within each
+ * @param max_out  Capacity of out
+ * @return         Number of messages written to out
+ */
+int wspr_decoder_decode(wspr_decoder_t *dec, const float *audio, int n,
+                        wspr_result_t *out, int max_out);
+
+/**
+ * Destroy decoder and free all resources.
+ */
+void wspr_decoder_destroy(wspr_decoder_t *dec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WSPR_DECODER_H */
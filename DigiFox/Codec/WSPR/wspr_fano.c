@@ -0,0 +1,155 @@
+/**
+ * wspr_fano.c — Fano algorithm over the K=32 rate 1/2 code tree
+ */
+
+#include "wspr_fano.h"
+
+#include <math.h>
+#include <string.h>
+
+/*
+ * Metric model: a unit-RMS soft value is ±FANO_MEAN plus Gaussian noise
+ * with the rest of the power. The decoder is not sensitive to the exact
+ * figure; this one is tuned on the bench near the decode threshold.
+ */
+#define FANO_MEAN     0.75
+#define FANO_BIAS     0.5     /* Code rate: bits per coded bit */
+#define FANO_UNITS    10.0    /* Metric units per bit of likelihood */
+#define FANO_DELTA    40      /* Threshold step, in metric units */
+
+static inline int parity32(uint32_t x)
+{
+    x ^= x >> 16;
+    x ^= x >> 8;
+    x ^= x >> 4;
+    x ^= x >> 2;
+    x ^= x >> 1;
+    return (int)(x & 1);
+}
+
+/* Output pair of a register state: first coded bit high, second low */
+static inline int encode_pair(uint32_t state)
+{
+    return (parity32(state & WSPR_FANO_POLY1) << 1) | parity32(state & WSPR_FANO_POLY2);
+}
+
+void wspr_fano_init(wspr_fano_t *f)
+{
+    memset(f, 0, sizeof(*f));
+
+    const double mean = FANO_MEAN;
+    const double var = 1.0 - mean * mean;
+    for (int s = 0; s < 256; s++) {
+        double x = (s - 128) / WSPR_FANO_SOFT_SCALE;
+        double p1 = exp(-(x - mean) * (x - mean) / (2.0 * var));
+        double p0 = exp(-(x + mean) * (x + mean) / (2.0 * var));
+        double avg = 0.5 * (p0 + p1) + 1e-300;
+        f->metric[0][s] = (int)lround(FANO_UNITS * (log2(p0 / avg + 1e-300) - FANO_BIAS));
+        f->metric[1][s] = (int)lround(FANO_UNITS * (log2(p1 / avg + 1e-300) - FANO_BIAS));
+    }
+    f->delta = FANO_DELTA;
+}
+
+void wspr_fano_encode(const uint8_t *bits, int n_bits, uint8_t *coded)
+{
+    uint32_t reg = 0;
+    for (int k = 0; k < n_bits; k++) {
+        reg = (reg << 1) | (bits[k] & 1);
+        int pair = encode_pair(reg);
+        coded[2 * k]     = (uint8_t)(pair >> 1);
+        coded[2 * k + 1] = (uint8_t)(pair & 1);
+    }
+}
+
+/*
+ * Order a node's branches best first. Both polynomials tap the newest
+ * bit, so the branch for a 1 sends the complement of the branch for a 0.
+ * Tail nodes have only the 0 branch.
+ */
+static inline void node_enter(wspr_fano_node_t *np, int tail)
+{
+    int pair = encode_pair(np->state);
+    int m0 = np->metric[pair];
+    int m1 = np->metric[pair ^ 3];
+
+    if (tail || m0 >= m1) {
+        np->tm[0] = m0;
+        np->tm[1] = m1;
+    } else {
+        np->tm[0] = m1;
+        np->tm[1] = m0;
+        np->state |= 1;
+    }
+    np->branch = 0;
+}
+
+int wspr_fano_decode(wspr_fano_t *f, const uint8_t *symbols, int n_bits,
+                     unsigned max_cycles, uint8_t *bits, int *metric,
+                     unsigned *cycles)
+{
+    if (n_bits <= WSPR_FANO_TAIL || n_bits > WSPR_FANO_MAX_BITS) return -1;
+
+    wspr_fano_node_t *const first = f->node;
+    wspr_fano_node_t *const tail = first + n_bits - WSPR_FANO_TAIL;
+    wspr_fano_node_t *const end = first + n_bits;
+
+    for (int k = 0; k < n_bits; k++) {
+        const int *b0 = f->metric[0], *b1 = f->metric[1];
+        const uint8_t s0 = symbols[2 * k], s1 = symbols[2 * k + 1];
+        first[k].metric[0] = b0[s0] + b0[s1];
+        first[k].metric[1] = b0[s0] + b1[s1];
+        first[k].metric[2] = b1[s0] + b0[s1];
+        first[k].metric[3] = b1[s0] + b1[s1];
+    }
+
+    wspr_fano_node_t *np = first;
+    np->state = 0;
+    np->gamma = 0;
+    node_enter(np, 0);
+
+    const int delta = f->delta;
+    const unsigned long budget = (unsigned long)max_cycles * (unsigned long)n_bits;
+    unsigned long cycle;
+    int t = 0;
+
+    for (cycle = 1; cycle <= budget; cycle++) {
+        int ngamma = np->gamma + np->tm[np->branch];
+
+        if (ngamma >= t) {
+            /* First visit to this node: tighten the threshold */
+            if (np->gamma < t + delta) {
+                while (ngamma >= t + delta) t += delta;
+            }
+            np[1].gamma = ngamma;
+            np[1].state = np->state << 1;
+            if (++np == end) break;
+            node_enter(np, np >= tail);
+            continue;
+        }
+
+        /* Below the threshold: back up to a node with an untried branch */
+        for (;;) {
+            if (np == first || np[-1].gamma < t) {
+                /* Nowhere to go: loosen and start over from the best branch */
+                t -= delta;
+                if (np->branch != 0) {
+                    np->branch = 0;
+                    np->state ^= 1;
+                }
+                break;
+            }
+            if (--np < tail && np->branch != 1) {
+                np->branch = 1;
+                np->state ^= 1;
+                break;
+            }
+        }
+    }
+
+    if (cycles) *cycles = (unsigned)(cycle > budget ? budget : cycle);
+    if (np != end) return -1;
+
+    for (int k = 0; k < n_bits - WSPR_FANO_TAIL; k++) bits[k] = (uint8_t)(first[k].state & 1);
+    if (metric) *metric = end->gamma;
+    return 0;
+}
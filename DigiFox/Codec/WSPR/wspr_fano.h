@@ -0,0 +1,77 @@
+/**
+ * wspr_fano.h — Fano sequential decoder for the WSPR convolutional code
+ *
+ * WSPR sends its 50 message bits, followed by 31 zero tail bits, through
+ * a K=32, rate 1/2 convolutional encoder (WSPRModulator). A code with a
+ * 32-bit register has far too many states for Viterbi decoding, so the
+ * code tree is searched sequentially instead. The Fano algorithm
+ * follows the best-looking branch while the path metric stays above a
+ * running threshold. When it drops below, the decoder backs up and tries
+ * the other branch, and the threshold is loosened only when no way
+ * forward is left. A clean signal decodes in about one cycle per bit;
+ * in noise the search can grow without limit, so it is cut off after a
+ * cycle budget. Running out of budget is how a candidate with no signal
+ * fails.
+ *
+ * Soft symbols are bytes: 128 is an erasure, and above 128 the coded bit
+ * is more likely 1. The branch metrics are integer log-likelihoods from
+ * a table built once in wspr_fano_init(). Decoding does no heap
+ * allocation; the code tree's nodes live in the wspr_fano_t.
+ */
+
+#ifndef WSPR_FANO_H
+#define WSPR_FANO_H
+
+#include <stdint.h>
+
+#define WSPR_FANO_POLY1     0xF2D05351u   /* WSPRProtocol.poly1 */
+#define WSPR_FANO_POLY2     0xE4613C47u   /* WSPRProtocol.poly2 */
+#define WSPR_FANO_TAIL      31            /* Zero bits flushing the register */
+#define WSPR_FANO_MAX_BITS  81            /* 50 message bits + tail */
+
+/* Soft symbol = 128 + WSPR_FANO_SOFT_SCALE × (soft value / its RMS) */
+#define WSPR_FANO_SOFT_SCALE  50.0f
+
+typedef struct {
+    uint32_t state;       /* Encoder register with this node's bit */
+    int      gamma;       /* Path metric up to this node */
+    int      metric[4];   /* Branch metrics of the 4 output pairs */
+    int      tm[2];       /* Metrics of the best and second branch */
+    int      branch;      /* Branch being tried: 0 best, 1 second */
+} wspr_fano_node_t;
+
+typedef struct {
+    int metric[2][256];   /* Metric of coded bit 0/1 given a soft symbol */
+    int delta;            /* Threshold step */
+    wspr_fano_node_t node[WSPR_FANO_MAX_BITS + 1];
+} wspr_fano_t;
+
+/**
+ * Build the metric table.
+ */
+void wspr_fano_init(wspr_fano_t *f);
+
+/**
+ * Encode n_bits bits (the tail included) into 2 · n_bits coded bits,
+ * as WSPRModulator.convolutionalEncode() does.
+ */
+void wspr_fano_encode(const uint8_t *bits, int n_bits, uint8_t *coded);
+
+/**
+ * Search the code tree for the message.
+ *
+ * @param f           From wspr_fano_init(); holds the search state
+ * @param symbols     2 · n_bits soft symbols, in encoder output order
+ * @param n_bits      Bits including the WSPR_FANO_TAIL tail
+ *                    (<= WSPR_FANO_MAX_BITS)
+ * @param max_cycles  Cycle budget per bit
+ * @param bits        Out: the n_bits - WSPR_FANO_TAIL message bits, 0/1
+ * @param metric      Out: path metric of the decoded message (may be NULL)
+ * @param cycles      Out: cycles used (may be NULL)
+ * @return 0 on success, -1 if the budget ran out or n_bits is bad
+ */
+int wspr_fano_decode(wspr_fano_t *f, const uint8_t *symbols, int n_bits,
+                     unsigned max_cycles, uint8_t *bits, int *metric,
+                     unsigned *cycles);
+
+#endif /* WSPR_FANO_H */
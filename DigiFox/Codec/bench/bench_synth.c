@@ -0,0 +1,55 @@
+/**
+ * bench_synth.c — Test signals shared by the benchmarks and the regression suite
+ */
+
+#include "bench_synth.h"
+
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static unsigned long long s_rng = 0x9E3779B97F4A7C15ull;
+
+void bench_seed(unsigned long long seed)
+{
+    s_rng = seed;
+}
+
+double bench_uniform(void)
+{
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 7;
+    s_rng ^= s_rng << 17;
+    return ((double)(s_rng >> 11) + 0.5) / 9007199254740992.0;
+}
+
+double bench_gauss(void)
+{
+    return sqrt(-2.0 * log(bench_uniform())) * cos(2.0 * M_PI * bench_uniform());
+}
+
+void bench_add_noise(float *x, long n, double fs, double power, double snr_db)
+{
+    double n0 = power / pow(10.0, snr_db / 10.0) / BENCH_SNR_BW_HZ;
+    double sigma = sqrt(n0 * fs / 2.0);
+    for (long i = 0; i < n; i++) x[i] += (float)(sigma * bench_gauss());
+}
+
+void bench_add_fsk(float *x, long n, long start, const uint8_t *tones, int n_sym, int nsps,
+                   double fs, double f0, double spacing, double drift_hz, double amp)
+{
+    const long len = (long)n_sym * nsps;
+    double phase = 2.0 * M_PI * bench_uniform();
+    for (int k = 0; k < n_sym; k++) {
+        for (int j = 0; j < nsps; j++) {
+            long i = (long)k * nsps + j;
+            double f = f0 + tones[k] * spacing;
+            if (drift_hz != 0.0) f += drift_hz * ((double)i / len - 0.5);
+            if (start + i < n) x[start + i] += (float)(amp * sin(phase));
+            phase += 2.0 * M_PI * f / fs;
+        }
+        phase = fmod(phase, 2.0 * M_PI);
+    }
+}
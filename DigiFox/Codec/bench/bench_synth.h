@@ -0,0 +1,68 @@
+/**
+ * bench_synth.h — Test signals shared by the benchmarks and the regression suite
+ *
+ * A seeded xorshift generator, white Gaussian noise at an SNR in 2500 Hz,
+ * and continuous-phase FSK frames keyed from a tone list (ft8_encode(),
+ * js8 / wspr tones). The same seed gives the same audio everywhere, so a
+ * bench and decoder_regress draw identical corpora.
+ *
+ * Not part of the app target; the bench and regress Makefiles build
+ * bench_synth.c with the decoder sources.
+ */
+
+#ifndef BENCH_SYNTH_H
+#define BENCH_SYNTH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BENCH_SNR_BW_HZ 2500.0    /* SNR reference bandwidth */
+
+/** Restart the generator at seed (never 0). */
+void bench_seed(unsigned long long seed);
+
+/** Uniform on (0, 1). */
+double bench_uniform(void);
+
+/** Standard normal (Box-Muller). */
+double bench_gauss(void);
+
+/**
+ * Add white Gaussian noise such that a signal of the given power sits at
+ * snr_db in BENCH_SNR_BW_HZ. A unit-amplitude tone has power 1/2.
+ *
+ * @param x        Audio, noise is added in place
+ * @param n        Samples
+ * @param fs       Sample rate, Hz
+ * @param power    Signal power the SNR refers to
+ * @param snr_db   SNR in 2500 Hz
+ */
+void bench_add_noise(float *x, long n, double fs, double power, double snr_db);
+
+/**
+ * Add a continuous-phase FSK frame starting at a random phase: symbol k
+ * at f0 + tones[k] × spacing, plus a linear drift of drift_hz across the
+ * frame (centred, so ±drift_hz/2 at the ends). Samples past n are dropped.
+ *
+ * @param x        Audio, the frame is added in place
+ * @param n        Samples in x
+ * @param start    First sample of the frame in x
+ * @param tones    n_sym tone indices
+ * @param nsps     Samples per symbol
+ * @param fs       Sample rate, Hz
+ * @param f0       Frequency of tone 0, Hz
+ * @param spacing  Tone spacing, Hz
+ * @param drift_hz Drift over the frame, Hz (0 = none)
+ * @param amp      Peak amplitude
+ */
+void bench_add_fsk(float *x, long n, long start, const uint8_t *tones, int n_sym, int nsps,
+                   double fs, double f0, double spacing, double drift_hz, double amp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_SYNTH_H */
@@ -0,0 +1,145 @@
+/**
+ * alloc_count.c — Counting wrappers around the C allocator
+ */
+
+#include "alloc_count.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#ifdef __APPLE__
+#include <malloc/malloc.h>
+#define usable_size(p) malloc_size(p)
+#else
+#include <malloc.h>
+#define usable_size(p) malloc_usable_size(p)
+#endif
+
+static atomic_long s_allocs;
+static atomic_long s_live;          /* Bytes */
+static atomic_long s_peak;
+
+static _Thread_local const char *t_stage;
+
+/* Site tally: only touched while tracking, so a lock is fine */
+static atomic_int s_tracking;
+static pthread_mutex_t s_sites_lock = PTHREAD_MUTEX_INITIALIZER;
+static alloc_site_t s_sites[ALLOC_COUNT_MAX_SITES];
+static int s_n_sites;
+
+static void tally(const char *file, int line)
+{
+    pthread_mutex_lock(&s_sites_lock);
+    int k = 0;
+    while (k < s_n_sites && !(s_sites[k].stage == t_stage && s_sites[k].file == file &&
+                              s_sites[k].line == line)) k++;
+    if (k == s_n_sites && s_n_sites < ALLOC_COUNT_MAX_SITES) {
+        s_sites[k] = (alloc_site_t){ t_stage, file, line, 0 };
+        s_n_sites++;
+    }
+    if (k < s_n_sites) s_sites[k].count++;
+    pthread_mutex_unlock(&s_sites_lock);
+}
+
+static void *note(void *p, const char *file, int line)
+{
+    if (!p) return NULL;
+    atomic_fetch_add_explicit(&s_allocs, 1, memory_order_relaxed);
+    long live = atomic_fetch_add_explicit(&s_live, (long)usable_size(p), memory_order_relaxed)
+              + (long)usable_size(p);
+    long peak = atomic_load_explicit(&s_peak, memory_order_relaxed);
+    while (live > peak &&
+           !atomic_compare_exchange_weak_explicit(&s_peak, &peak, live, memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+    }
+    if (atomic_load_explicit(&s_tracking, memory_order_relaxed)) tally(file, line);
+    return p;
+}
+
+static void forget(void *p)
+{
+    if (p) atomic_fetch_sub_explicit(&s_live, (long)usable_size(p), memory_order_relaxed);
+}
+
+void *alloc_count_malloc(size_t n, const char *file, int line)
+{
+    return note(malloc(n), file, line);
+}
+
+void *alloc_count_calloc(size_t n, size_t size, const char *file, int line)
+{
+    return note(calloc(n, size), file, line);
+}
+
+void *alloc_count_realloc(void *p, size_t n, const char *file, int line)
+{
+    forget(p);
+    void *q = realloc(p, n);
+    if (!q && p && n) {
+        /* Failed: p is still live */
+        atomic_fetch_add_explicit(&s_live, (long)usable_size(p), memory_order_relaxed);
+        return NULL;
+    }
+    return note(q, file, line);
+}
+
+void alloc_count_free(void *p)
+{
+    forget(p);
+    free(p);
+}
+
+long alloc_count_total(void)
+{
+    return atomic_load_explicit(&s_allocs, memory_order_relaxed);
+}
+
+long alloc_count_live(void)
+{
+    return atomic_load_explicit(&s_live, memory_order_relaxed);
+}
+
+long alloc_count_peak(void)
+{
+    return atomic_load_explicit(&s_peak, memory_order_relaxed);
+}
+
+void alloc_count_reset_peak(void)
+{
+    atomic_store_explicit(&s_peak, alloc_count_live(), memory_order_relaxed);
+}
+
+const char *alloc_count_stage(const char *stage)
+{
+    const char *prev = t_stage;
+    t_stage = stage;
+    return prev;
+}
+
+void alloc_count_track(int on)
+{
+    pthread_mutex_lock(&s_sites_lock);
+    if (on) s_n_sites = 0;
+    atomic_store_explicit(&s_tracking, on, memory_order_relaxed);
+    pthread_mutex_unlock(&s_sites_lock);
+}
+
+int alloc_count_sites(alloc_site_t *out, int max)
+{
+    pthread_mutex_lock(&s_sites_lock);
+    alloc_site_t all[ALLOC_COUNT_MAX_SITES];
+    int total = s_n_sites;
+    memcpy(all, s_sites, (size_t)total * sizeof(alloc_site_t));
+    pthread_mutex_unlock(&s_sites_lock);
+
+    /* The largest max, by selection */
+    int n = total < max ? total : max;
+    for (int i = 0; i < n; i++) {
+        int best = i;
+        for (int j = i + 1; j < total; j++)
+            if (all[j].count > all[best].count) best = j;
+        alloc_site_t t = all[i]; all[i] = all[best]; all[best] = t;
+        out[i] = all[i];
+    }
+    return n;
+}
@@ -0,0 +1,79 @@
+/**
+ * alloc_count.h — Heap allocation counter for the decoder regression suite
+ *
+ * The Makefile force-includes this header into every decoder source it
+ * builds, with ALLOC_COUNT_WRAP defined, so their malloc / calloc /
+ * realloc / free calls go through wrappers that count allocations and
+ * track the live and peak heap; the runner reads them around each
+ * stage, and its own allocations are not counted. C++ code (ggmorse)
+ * is covered by alloc_count_cxx.cpp, which replaces the global
+ * operator new and delete.
+ *
+ * Attribution: the wrappers get the call site (__FILE__, __LINE__; C++
+ * new has none), and the runner names the pipeline stage it is in per
+ * thread. While tracking is on, each allocation is tallied by stage and
+ * site, so a steady-state allocation points straight at its line.
+ */
+
+#ifndef ALLOC_COUNT_H
+#define ALLOC_COUNT_H
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ALLOC_COUNT_MAX_SITES  64
+
+typedef struct {
+    const char *stage;          /* Runner's stage, NULL outside one */
+    const char *file;           /* NULL for C++ new */
+    int         line;
+    long        count;
+} alloc_site_t;
+
+void *alloc_count_malloc(size_t n, const char *file, int line);
+void *alloc_count_calloc(size_t n, size_t size, const char *file, int line);
+void *alloc_count_realloc(void *p, size_t n, const char *file, int line);
+void  alloc_count_free(void *p);
+
+/* Allocations so far, all threads */
+long alloc_count_total(void);
+
+/* Bytes allocated and not freed (usable sizes, as the allocator rounds) */
+long alloc_count_live(void);
+
+/* Highest alloc_count_live() since the last reset */
+long alloc_count_peak(void);
+void alloc_count_reset_peak(void);
+
+/**
+ * Name the stage this thread is in (a string literal, NULL for none).
+ * @return The previous one, to restore
+ */
+const char *alloc_count_stage(const char *stage);
+
+/* Tally allocations by stage and site from now on (on != 0), or stop */
+void alloc_count_track(int on);
+
+/**
+ * The sites tallied since tracking was last turned on, most
+ * allocations first.
+ * @return Sites written
+ */
+int alloc_count_sites(alloc_site_t *out, int max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#if defined(ALLOC_COUNT_WRAP) && !defined(__cplusplus)
+#define malloc(n)      alloc_count_malloc(n, __FILE__, __LINE__)
+#define calloc(n, s)   alloc_count_calloc(n, s, __FILE__, __LINE__)
+#define realloc(p, n)  alloc_count_realloc(p, n, __FILE__, __LINE__)
+#define free(p)        alloc_count_free(p)
+#endif
+
+#endif /* ALLOC_COUNT_H */
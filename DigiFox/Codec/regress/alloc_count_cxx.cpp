@@ -0,0 +1,38 @@
+/**
+ * alloc_count_cxx.cpp — Global operator new / delete through the counters, for ggmorse
+ */
+
+#include "alloc_count.h"
+
+#include <new>
+
+void *operator new(std::size_t n)
+{
+    if (void *p = alloc_count_malloc(n ? n : 1, NULL, 0)) return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t n)
+{
+    return operator new(n);
+}
+
+void operator delete(void *p) noexcept
+{
+    alloc_count_free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    alloc_count_free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    alloc_count_free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+    alloc_count_free(p);
+}
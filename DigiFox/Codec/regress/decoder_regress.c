@@ -0,0 +1,862 @@
+/**
+ * decoder_regress.c — Decode-yield and throughput regression suite
+ *
+ * Replays a corpus of recordings (audio_archive.h, as AudioRecorder
+ * writes them) through every decoder and reports, per recording and
+ * decoder:
+ *
+ *   found      FT8: messages decoded. CW: characters right (reference
+ *              length less the edit distance), or decoded characters
+ *              when the manifest gives no reference text
+ *   ms/s       CPU time per second of audio (best of -n runs)
+ *   ms/slot    the same per 15 s slot
+ *   peak KB    the decoder's peak live heap (allocator-rounded sizes)
+ *   allocs     heap allocations in the whole run (create and destroy
+ *              included)
+ *   steady     allocations in steady state: in the decoder's calls
+ *              after a warm-up (the first second, or FT8's first slot);
+ *              max/call is the most any one call (one audio callback's
+ *              block, or a slot-end decode) made. The sites of steady
+ *              allocations are listed under the row, by stage
+ *              (process, feed, decode, ...) and source line
+ *
+ * cw_q15 is the CW decoder fed the audio as int16 (scaled to fit) through
+ * its fixed-point front end (CW_FILTER_Q15); cw_hmm classifies through
+ * the duration HMM (use_hmm).
+ *
+ * With -b the figures are checked against a stored baseline: fewer
+ * found, any steady-state allocation the baseline does not have (a
+ * decoder missing from it may not allocate at all), or CPU time or
+ * peak memory above the baseline by more than -T is a regression, and
+ * the exit status is 1. -u rewrites the baseline from this run instead.
+ * CPU times only compare on the machine that recorded them; run `make
+ * baseline` there first.
+ *
+ * Each recording runs in a forked child, so a crash or leak stays with
+ * it. FT8 runs single-threaded so the yield is deterministic; found,
+ * allocations and peak heap are then the same on every run.
+ *
+ * The corpus is listed in a manifest, one recording per line, paths
+ * relative to the manifest:
+ *
+ *   cw  <file.dfxa> <pitch Hz> [reference text]
+ *   ft8 <file.dfxa>
+ *
+ * Before the corpus, a few decoder behaviours are checked on synthetic
+ * audio (see Checks); a failed check counts as a regression.
+ *
+ * -g writes a synthetic corpus (fixed seeds, so the same bits every
+ * time) and its manifest; recordings from the app can be listed in a
+ * manifest of their own.
+ *
+ * Not part of the app target; see regress/Makefile.
+ */
+
+#include "audio_archive.h"
+#include "cw_decoder.h"
+#include "cw_tone.h"
+#include "morse_table.h"
+#include "ft8_decoder.h"
+#include "ft8_synth.h"
+#include "polyphase_resampler.h"
+#include "alloc_count.h"
+#include "bench_synth.h"
+#ifdef REGRESS_GGMORSE
+#include "ggmorse_c_api.h"
+#endif
+
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define REGRESS_MAX_ENTRIES  64
+#define REGRESS_MAX_RESULTS  128
+#define REGRESS_TEXT_LEN     8192
+#define REGRESS_BLOCK        512       /* CW samples per call */
+#define REGRESS_CHUNK_S      0.1       /* FT8 feed per call */
+#define REGRESS_PEAK_SLACK_KB 16       /* Allowed peak growth on top of -T */
+
+typedef enum { KIND_CW, KIND_FT8 } entry_kind_t;
+
+typedef struct {
+    entry_kind_t kind;
+    char   name[256];              /* File name without .dfxa */
+    char   path[512];
+    float  pitch;                  /* CW */
+    char  *reference;              /* CW, may be NULL */
+} entry_t;
+
+#define REGRESS_MAX_SITES    4
+
+typedef struct {
+    int    ok;
+    double audio_s;
+    long   found;
+    double cpu_ms;                 /* Whole recording, best run */
+    long   peak_kb;
+    long   allocs;
+    long   steady_allocs;
+    long   max_call;
+    int    n_sites;
+    char   sites[REGRESS_MAX_SITES][128];
+} run_t;
+
+/* Steady-state allocation tally over a run's decoder calls */
+typedef struct {
+    int    on;                     /* Past the warm-up */
+    long   allocs;
+    long   max_call;
+} steady_t;
+
+static void steady_begin(steady_t *st)
+{
+    if (st->on) return;
+    st->on = 1;
+    alloc_count_track(1);
+}
+
+static void steady_call(steady_t *st, long allocs)
+{
+    if (!st->on) return;
+    st->allocs += allocs;
+    if (allocs > st->max_call) st->max_call = allocs;
+}
+
+/* Run a decoder call as stage, tallying its allocations */
+#define STAGE_CALL(st, stage, call) do {                    \
+        long a0_ = alloc_count_total();                     \
+        const char *prev_ = alloc_count_stage(stage);       \
+        call;                                               \
+        alloc_count_stage(prev_);                           \
+        steady_call(st, alloc_count_total() - a0_);         \
+    } while (0)
+
+typedef struct {
+    char   entry[64];
+    char   decoder[16];
+    long   found;
+    double ms_per_s;
+    long   peak_kb;
+    long   steady_allocs;
+} baseline_t;
+
+static const char *k_decoders[] = {
+    "cw",
+    "cw_q15",
+    "cw_hmm",
+#ifdef REGRESS_GGMORSE
+    "ggmorse",
+#endif
+    "ft8",
+};
+#define N_DECODERS ((int)(sizeof(k_decoders) / sizeof(k_decoders[0])))
+
+/* ------------------------------------------------------------------ */
+/* Measurement                                                         */
+/* ------------------------------------------------------------------ */
+
+static double cpu_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+/*
+ * A recording, gaps as silence: from its first sample, or for FT8 from
+ * its first UTC slot boundary and at 12 kHz.
+ */
+static float *load(const entry_t *e, double *fs, int *n_out)
+{
+    audio_archive_t *a = audio_archive_open(e->path);
+    if (!a) return NULL;
+    const audio_archive_header_t *h = audio_archive_header(a);
+    uint64_t first = audio_archive_frames(a) > 0 ? audio_archive_frame(a, 0)->first_sample : 0;
+    if (e->kind == KIND_FT8) {
+        double t0 = h->start_utc + (double)first / h->sample_rate;
+        uint64_t slot = audio_archive_index_at(a, ceil(t0 / 15.0 - 1e-9) * 15.0);
+        if (slot > first) first = slot;
+    }
+    uint64_t end = audio_archive_end(a);
+    int n = end > first ? (int)(end - first) : 0;
+    float *x = (float *)malloc((size_t)(n ? n : 1) * sizeof(float));
+    if (x) audio_archive_read(a, first, x, n, NULL);
+    *fs = h->sample_rate;
+    *n_out = n;
+    audio_archive_close(a);
+
+    if (x && e->kind == KIND_FT8 && *fs != FT8_SAMPLE_RATE) {
+        polyphase_resampler_t *rs = polyphase_resampler_create(*fs, FT8_SAMPLE_RATE, 0);
+        float *y = rs ? (float *)malloc((size_t)polyphase_resampler_max_output(rs, n) * sizeof(float) + 1)
+                      : NULL;
+        if (y) {
+            *n_out = polyphase_resampler_process(rs, x, n, y);
+            *fs = FT8_SAMPLE_RATE;
+        }
+        polyphase_resampler_destroy(rs);
+        free(x);
+        x = y;
+    }
+    return x;
+}
+
+/* Upper-case, collapse whitespace, trim */
+static void normalize(const char *in, char *out, size_t out_len)
+{
+    size_t j = 0;
+    int space = 1;
+    for (const char *c = in; *c && j + 1 < out_len; c++) {
+        char ch = *c;
+        if (ch >= 'a' && ch <= 'z') ch = (char)(ch - 'a' + 'A');
+        if (ch == ' ' || ch == '\n' || ch == '\t') {
+            if (!space) out[j++] = ' ';
+            space = 1;
+        } else {
+            out[j++] = ch;
+            space = 0;
+        }
+    }
+    while (j > 0 && out[j - 1] == ' ') j--;
+    out[j] = '\0';
+}
+
+/* Characters right: reference length less the edit distance */
+static long chars_right(const char *ref_raw, const char *hyp_raw)
+{
+    static char ref[REGRESS_TEXT_LEN], hyp[REGRESS_TEXT_LEN];
+    normalize(hyp_raw, hyp, sizeof(hyp));
+    int m = (int)strlen(hyp);
+    if (!ref_raw) {
+        long k = 0;
+        for (int j = 0; j < m; j++) k += hyp[j] != ' ';
+        return k;
+    }
+    normalize(ref_raw, ref, sizeof(ref));
+    int n = (int)strlen(ref);
+
+    int *prev = (int *)malloc(sizeof(int) * (size_t)(m + 1));
+    int *cur = (int *)malloc(sizeof(int) * (size_t)(m + 1));
+    for (int j = 0; j <= m; j++) prev[j] = j;
+    for (int i = 1; i <= n; i++) {
+        cur[0] = i;
+        for (int j = 1; j <= m; j++) {
+            int d = prev[j - 1] + (ref[i - 1] != hyp[j - 1]);
+            if (prev[j] + 1 < d) d = prev[j] + 1;
+            if (cur[j - 1] + 1 < d) d = cur[j - 1] + 1;
+            cur[j] = d;
+        }
+        int *t = prev; prev = cur; cur = t;
+    }
+    long right = n - prev[m];
+    free(prev);
+    free(cur);
+    return right > 0 ? right : 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* Decoders                                                            */
+/* ------------------------------------------------------------------ */
+
+/* Each returns found and tallies its steady-state allocations in st */
+
+/* q15: the audio as int16 through the fixed-point front end; hmm: use_hmm */
+static long run_cw(const entry_t *e, double fs, const float *x, int n, int q15, int hmm,
+                   steady_t *st)
+{
+    static char text[REGRESS_TEXT_LEN];
+    cw_config_t cfg;
+    cw_config_init(&cfg);
+    cfg.sample_rate = (int)fs;
+    cfg.center_freq = e->pitch;
+    cfg.min_word_length = 1;
+    cfg.use_hmm = hmm;
+
+    int16_t *x16 = NULL;
+    if (q15) {
+        cfg.filter_precision = CW_FILTER_Q15;
+        x16 = (int16_t *)malloc((size_t)n * sizeof(int16_t));
+        if (!x16) return -1;
+        /* Scaled to fit, as an int16 source would deliver it */
+        float peak = 1.0f;
+        for (int i = 0; i < n; i++) peak = fmaxf(peak, fabsf(x[i]));
+        for (int i = 0; i < n; i++) x16[i] = (int16_t)lrintf(x[i] * (32767.0f / peak));
+    }
+
+    cw_decoder_t *dec = cw_decoder_create(&cfg);
+    if (!dec) {
+        free(x16);
+        return -1;
+    }
+    int w = 0;
+    for (int i = 0; i < n; i += REGRESS_BLOCK) {
+        int len = n - i < REGRESS_BLOCK ? n - i : REGRESS_BLOCK;
+        if (i >= (int)fs) steady_begin(st);
+        if (x16) {
+            STAGE_CALL(st, "process",
+                       w += cw_decoder_process_s16(dec, x16 + i, len, text + w,
+                                                   REGRESS_TEXT_LEN - 1 - w));
+        } else {
+            STAGE_CALL(st, "process",
+                       w += cw_decoder_process(dec, x + i, len, text + w, REGRESS_TEXT_LEN - 1 - w));
+        }
+    }
+    STAGE_CALL(st, "finalize", w += cw_decoder_finalize(dec, text + w, REGRESS_TEXT_LEN - 1 - w));
+    text[w] = '\0';
+    cw_decoder_destroy(dec);
+    free(x16);
+    return chars_right(e->reference, text);
+}
+
+#ifdef REGRESS_GGMORSE
+static long run_ggmorse(const entry_t *e, double fs, const float *x, int n, steady_t *st)
+{
+    static char text[REGRESS_TEXT_LEN];
+    ggmorse_wrapper *gm = ggmorse_wrapper_create((float)fs, 0);
+    if (!gm) return -1;
+    int w = 0;
+    for (int i = 0; i < n; i += REGRESS_BLOCK) {
+        int len = n - i < REGRESS_BLOCK ? n - i : REGRESS_BLOCK;
+        if (i >= (int)fs) steady_begin(st);
+        STAGE_CALL(st, "push",
+                   w += ggmorse_wrapper_process_push(gm, x + i, len, text + w,
+                                                     REGRESS_TEXT_LEN - 1 - w));
+    }
+    text[w] = '\0';
+    ggmorse_wrapper_destroy(gm);
+    return chars_right(e->reference, text);
+}
+#endif
+
+/* Every whole 15 s slot; load() has aligned and resampled the audio */
+static long run_ft8(const entry_t *e, double fs, const float *x, int n, steady_t *st)
+{
+    (void)e;
+    (void)fs;
+    static ft8_result_t res[REGRESS_MAX_RESULTS];
+    ft8_config_t cfg;
+    ft8_config_init(&cfg);
+    cfg.threads = 1;
+
+    ft8_decoder_t *dec = ft8_decoder_create(&cfg);
+    if (!dec) return -1;
+    const int slot = 15 * FT8_SAMPLE_RATE;
+    const int chunk = (int)(REGRESS_CHUNK_S * FT8_SAMPLE_RATE);
+    long found = 0;
+    for (int s = 0; s + slot <= n; s += slot) {
+        if (s > 0) steady_begin(st);
+        STAGE_CALL(st, "reset", ft8_decoder_reset(dec));
+        for (int i = 0; i < slot; i += chunk)
+            STAGE_CALL(st, "feed", ft8_decoder_feed(dec, x + s + i, chunk));
+        STAGE_CALL(st, "decode", found += ft8_decoder_decode_fed(dec, res, REGRESS_MAX_RESULTS));
+    }
+    ft8_decoder_destroy(dec);
+    return found;
+}
+
+static long run_decoder(int d, const entry_t *e, double fs, const float *x, int n, steady_t *st)
+{
+    const char *name = k_decoders[d];
+    if (strcmp(name, "ft8") == 0) return e->kind == KIND_FT8 ? run_ft8(e, fs, x, n, st) : -1;
+    if (e->kind != KIND_CW) return -1;
+#ifdef REGRESS_GGMORSE
+    if (strcmp(name, "ggmorse") == 0) return run_ggmorse(e, fs, x, n, st);
+#endif
+    return run_cw(e, fs, x, n, strcmp(name, "cw_q15") == 0, strcmp(name, "cw_hmm") == 0, st);
+}
+
+/* In a child: load, run repeats times, report through fd */
+static void child(int d, const entry_t *e, int repeats, int fd)
+{
+    run_t r;
+    memset(&r, 0, sizeof(r));
+    double fs;
+    int n;
+    float *x = load(e, &fs, &n);
+    if (x) {
+        r.audio_s = (double)n / fs;
+        r.cpu_ms = 1e30;
+        for (int rep = 0; rep < repeats; rep++) {
+            steady_t st = { 0 };
+            long a0 = alloc_count_total();
+            long live0 = alloc_count_live();
+            alloc_count_reset_peak();
+            double t0 = cpu_s();
+            long found = run_decoder(d, e, fs, x, n, &st);
+            double ms = (cpu_s() - t0) * 1e3;
+            alloc_count_track(0);
+            if (found < 0) break;
+            if (rep == 0) {
+                r.found = found;
+                r.allocs = alloc_count_total() - a0;
+                r.steady_allocs = st.allocs;
+                r.max_call = st.max_call;
+                r.peak_kb = (alloc_count_peak() - live0 + 1023) / 1024;
+                alloc_site_t sites[REGRESS_MAX_SITES];
+                r.n_sites = alloc_count_sites(sites, REGRESS_MAX_SITES);
+                for (int k = 0; k < r.n_sites; k++) {
+                    const char *file = sites[k].file ? strrchr(sites[k].file, '/') : NULL;
+                    snprintf(r.sites[k], sizeof(r.sites[k]), "%-8s %s:%d  %ld",
+                             sites[k].stage ? sites[k].stage : "-",
+                             file ? file + 1 : sites[k].file ? sites[k].file : "(C++ new)",
+                             sites[k].line, sites[k].count);
+                }
+            }
+            if (ms < r.cpu_ms) r.cpu_ms = ms;
+            r.ok = 1;
+        }
+        free(x);
+    }
+    ssize_t w = write(fd, &r, sizeof(r));
+    _exit(w == (ssize_t)sizeof(r) ? 0 : 1);
+}
+
+static int measure(int d, const entry_t *e, int repeats, run_t *r)
+{
+    int fds[2];
+    if (pipe(fds) != 0) return -1;
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) return -1;
+    if (pid == 0) {
+        close(fds[0]);
+        child(d, e, repeats, fds[1]);
+    }
+    close(fds[1]);
+    ssize_t got = read(fds[0], r, sizeof(*r));
+    close(fds[0]);
+    int status;
+    waitpid(pid, &status, 0);
+    return got == (ssize_t)sizeof(*r) && r->ok ? 0 : -1;
+}
+
+/* ------------------------------------------------------------------ */
+/* Manifest and baseline                                               */
+/* ------------------------------------------------------------------ */
+
+static int read_manifest(const char *path, entry_t *e, int max)
+{
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    char dir[512];
+    snprintf(dir, sizeof(dir), "%s", path);
+    char *slash = strrchr(dir, '/');
+    if (slash) slash[1] = '\0';
+    else dir[0] = '\0';
+
+    int n = 0;
+    char line[REGRESS_TEXT_LEN];
+    while (n < max && fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        char kind[8], file[256];
+        int used = 0;
+        if (line[0] == '#' || sscanf(line, "%7s %255s %n", kind, file, &used) < 2) continue;
+
+        entry_t *x = &e[n];
+        memset(x, 0, sizeof(*x));
+        if (strcmp(kind, "cw") == 0) {
+            x->kind = KIND_CW;
+            int more = 0;
+            if (sscanf(line + used, "%f %n", &x->pitch, &more) < 1) continue;
+            if (line[used + more]) x->reference = strdup(line + used + more);
+        } else if (strcmp(kind, "ft8") == 0) {
+            x->kind = KIND_FT8;
+        } else {
+            continue;
+        }
+        snprintf(x->path, sizeof(x->path), "%s%s", file[0] == '/' ? "" : dir, file);
+        const char *base = strrchr(file, '/');
+        snprintf(x->name, sizeof(x->name), "%s", base ? base + 1 : file);
+        char *dot = strstr(x->name, ".dfxa");
+        if (dot) *dot = '\0';
+        n++;
+    }
+    fclose(f);
+    return n;
+}
+
+static int read_baseline(const char *path, baseline_t *b, int max)
+{
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+    int n = 0;
+    char line[256];
+    while (n < max && fgets(line, sizeof(line), f)) {
+        if (line[0] == '#') continue;
+        if (sscanf(line, "%63s %15s %ld %lf %ld %ld", b[n].entry, b[n].decoder, &b[n].found,
+                   &b[n].ms_per_s, &b[n].peak_kb, &b[n].steady_allocs) == 6) n++;
+    }
+    fclose(f);
+    return n;
+}
+
+static const baseline_t *find_baseline(const baseline_t *b, int n, const char *entry,
+                                       const char *decoder)
+{
+    for (int i = 0; i < n; i++)
+        if (strcmp(b[i].entry, entry) == 0 && strcmp(b[i].decoder, decoder) == 0) return &b[i];
+    return NULL;
+}
+
+/* ------------------------------------------------------------------ */
+/* Synthetic corpus                                                    */
+/* ------------------------------------------------------------------ */
+
+static int write_archive(const char *dir, const char *name, double fs, const float *x, int n,
+                         double start_utc, uint64_t dial_hz)
+{
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s.dfxa", dir, name);
+    audio_archive_writer_t *w = audio_archive_writer_open(path, fs, AUDIO_ARCHIVE_F32, 0,
+                                                          start_utc, "regress");
+    if (!w) return -1;
+    int rc = audio_archive_write(w, x, n, 0, dial_hz);
+    return audio_archive_writer_close(w) != 0 ? -1 : rc;
+}
+
+static const char *k_cw_text =
+    "CQ CQ DE DL1ABC DL1ABC K DL1ABC DE W1AW GM UR RST 599 599 NAME JOHN "
+    "QTH BOSTON HW CPY 73 TU DE W1AW SK";
+
+/* Key the text through the decoder's own table, as cw_tone edges */
+static float *synth_cw(const char *text, double wpm, double fs, double pitch, int *n_out)
+{
+    double dit = 1.2 / wpm, t = 0.5;
+    int cap = (int)strlen(text) * 12 + 2, n = 0;
+    double *edges = (double *)malloc((size_t)cap * sizeof(double));
+    char pat[8];
+    for (const char *c = text; *c; c++) {
+        if (*c == ' ') {
+            t += 4.0 * dit;                 /* Word gap 7 = 3 + 4 */
+            continue;
+        }
+        /* Find the pattern by search: the table maps pattern → char */
+        int found = 0;
+        for (int len = 1; len <= 6 && !found; len++) {
+            for (int bits = 0; bits < (1 << len) && !found; bits++) {
+                for (int i = 0; i < len; i++) pat[i] = (bits >> i) & 1 ? '-' : '.';
+                pat[len] = '\0';
+                found = morse_lookup(pat) == *c;
+            }
+        }
+        for (const char *p = pat; found && *p; p++) {
+            edges[n++] = t;
+            t += (*p == '.' ? 1.0 : 3.0) * dit;
+            edges[n++] = t;
+            t += dit;
+        }
+        t += 2.0 * dit;                     /* Char gap 3 = 1 + 2 */
+    }
+
+    cw_tone_t *tone = cw_tone_create(edges, n, fs, pitch, 0.005, 0.5f);
+    free(edges);
+    if (!tone) return NULL;
+    int len = cw_tone_length(tone) + (int)fs;
+    float *x = (float *)calloc((size_t)len, sizeof(float));
+    if (x) cw_tone_render(tone, x + (int)(0.5 * fs), len - (int)(0.5 * fs));
+    cw_tone_destroy(tone);
+    *n_out = len;
+    return x;
+}
+
+/* slots of signals each, SNR spread over [snr_db, snr_db + 10] */
+static float *synth_ft8(int slots, int signals, double snr_db, int *n_out)
+{
+    const int slot = 15 * FT8_SAMPLE_RATE;
+    int n = slots * slot;
+    float *x = (float *)calloc((size_t)n, sizeof(float));
+    float *frame = (float *)malloc((size_t)FT8_SYMBOL_COUNT * FT8_SYMBOL_SAMPLES * sizeof(float));
+    ft8_synth_config_t scfg;
+    ft8_synth_config_init(&scfg);
+    ft8_synth_t *syn = ft8_synth_create(&scfg);
+    if (!x || !frame || !syn) {
+        free(x);
+        x = NULL;
+        goto done;
+    }
+
+    /* Noise for unit-power 0.125 (amplitude 0.5), then each signal at its SNR */
+    bench_add_noise(x, n, FT8_SAMPLE_RATE, 0.125, snr_db);
+    for (int s = 0; s < slots; s++) {
+        for (int k = 0; k < signals; k++) {
+            uint8_t payload[FT8_PAYLOAD_BITS], tones[FT8_SYMBOL_COUNT];
+            for (int b = 0; b < FT8_PAYLOAD_BITS; b++) payload[b] = bench_uniform() < 0.5;
+            ft8_encode(payload, tones);
+            double f = 300.0 + (2400.0 / signals) * k + bench_uniform() * FT8_TONE_SPACING;
+            double amp = 0.5 * pow(10.0, 10.0 * k / signals / 20.0);
+            int start = s * slot + (int)((0.5 + bench_uniform() * 1.5) * FT8_SAMPLE_RATE);
+            ft8_synth_start(syn, tones, FT8_SYMBOL_COUNT, (float)f, (float)amp);
+            int len = ft8_synth_render(syn, frame, FT8_SYMBOL_COUNT * FT8_SYMBOL_SAMPLES);
+            for (int i = 0; i < len && start + i < n; i++) x[start + i] += frame[i];
+        }
+    }
+    *n_out = n;
+done:
+    free(frame);
+    ft8_synth_destroy(syn);
+    return x;
+}
+
+static int generate(const char *dir)
+{
+    mkdir(dir, 0755);
+    char path[512];
+    snprintf(path, sizeof(path), "%s/manifest.txt", dir);
+    FILE *m = fopen(path, "w");
+    if (!m) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    fprintf(m, "# Synthetic corpus written by decoder_regress -g\n");
+
+    static const struct { const char *name; double wpm, fs, pitch, snr; } cw[] = {
+        { "cw_20wpm_12k_10db",   20.0, 12000.0, 700.0, 10.0 },
+        { "cw_28wpm_48k_3db",    28.0, 48000.0, 600.0,  3.0 },
+        { "cw_15wpm_7825_5db",   15.0,  7825.0, 700.0,  5.0 },
+    };
+    for (size_t i = 0; i < sizeof(cw) / sizeof(cw[0]); i++) {
+        bench_seed(0x9E3779B97F4A7C15ull + i);
+        int n;
+        float *x = synth_cw(k_cw_text, cw[i].wpm, cw[i].fs, cw[i].pitch, &n);
+        if (!x) return -1;
+        bench_add_noise(x, n, cw[i].fs, 0.125, cw[i].snr);
+        int rc = write_archive(dir, cw[i].name, cw[i].fs, x, n, 1760000000.0, 7030000);
+        free(x);
+        if (rc != 0) return -1;
+        fprintf(m, "cw  %s.dfxa %.0f %s\n", cw[i].name, cw[i].pitch, k_cw_text);
+    }
+
+    static const struct { const char *name; int slots, signals; double snr; } ft8[] = {
+        { "ft8_4slots_m14db", 4, 12, -14.0 },
+        { "ft8_2slots_m20db", 2, 12, -20.0 },
+    };
+    for (size_t i = 0; i < sizeof(ft8) / sizeof(ft8[0]); i++) {
+        bench_seed(0xD1B54A32D192ED03ull + i);
+        int n;
+        float *x = synth_ft8(ft8[i].slots, ft8[i].signals, ft8[i].snr, &n);
+        if (!x) return -1;
+        int rc = write_archive(dir, ft8[i].name, FT8_SAMPLE_RATE, x, n, 1760000010.0, 14074000);
+        free(x);
+        if (rc != 0) return -1;
+        fprintf(m, "ft8 %s.dfxa\n", ft8[i].name);
+    }
+    fclose(m);
+    printf("wrote %s\n", path);
+    return 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* Checks                                                              */
+/* ------------------------------------------------------------------ */
+
+/* Decode x through the fixed-point front end; reconfigured from `from` first if given */
+static int decode_q15(const cw_config_t *from, const cw_config_t *cfg, const int16_t *x, int n,
+                      char *text, int len)
+{
+    cw_decoder_t *dec = cw_decoder_create(from ? from : cfg);
+    if (!dec) return -1;
+    if (from && cw_decoder_reconfigure(dec, cfg) != 0) {
+        cw_decoder_destroy(dec);
+        return -1;
+    }
+    int w = 0;
+    for (int i = 0; i < n; i += REGRESS_BLOCK) {
+        int k = n - i < REGRESS_BLOCK ? n - i : REGRESS_BLOCK;
+        w += cw_decoder_process_s16(dec, x + i, k, text + w, len - 1 - w);
+    }
+    w += cw_decoder_finalize(dec, text + w, len - 1 - w);
+    text[w] = '\0';
+    cw_decoder_destroy(dec);
+    return w;
+}
+
+/*
+ * Q15 reconfigured from a bandpass to none: the keyed tone, far off the
+ * old centre, must decode as by a decoder created without the bandpass.
+ */
+static int check_reconfigure_q15(void)
+{
+    const double fs = 8000.0;
+    int n = 0;
+    float *x = synth_cw("CQ TEST DE W1AW", 20.0, fs, 1200.0, &n);
+    int16_t *x16 = x ? (int16_t *)malloc((size_t)n * sizeof(int16_t)) : NULL;
+    if (!x16) {
+        free(x);
+        return 1;
+    }
+    for (int i = 0; i < n; i++) x16[i] = (int16_t)lrintf(x[i] * 32767.0f);
+
+    cw_config_t before, after;
+    cw_config_init(&before);
+    before.sample_rate = (int)fs;
+    before.center_freq = 700.0f;
+    before.bandwidth = 100.0f;
+    before.min_word_length = 1;
+    before.filter_precision = CW_FILTER_Q15;
+    after = before;
+    after.bandwidth = 0.0f;
+
+    static char fresh[REGRESS_TEXT_LEN], reconf[REGRESS_TEXT_LEN];
+    int a = decode_q15(NULL, &after, x16, n, fresh, REGRESS_TEXT_LEN);
+    int b = decode_q15(&before, &after, x16, n, reconf, REGRESS_TEXT_LEN);
+    free(x16);
+    free(x);
+
+    int bad = a <= 0 || b != a || strcmp(fresh, reconf) != 0;
+    printf("check cw_q15 reconfigure bandwidth 100 -> 0: %s\n", bad ? "FAILED" : "ok");
+    if (bad) printf("    fresh \"%s\", reconfigured \"%s\"\n", fresh, reconf);
+    return bad;
+}
+
+/* ------------------------------------------------------------------ */
+/* Main                                                                */
+/* ------------------------------------------------------------------ */
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr,
+        "usage: %s [options] [manifest ...]\n"
+        "  -g dir        write the synthetic corpus to dir (and use it)\n"
+        "  -b file       check against this baseline\n"
+        "  -u            with -b: rewrite the baseline from this run\n"
+        "  -T fraction   CPU time / peak memory tolerance (0.25)\n"
+        "  -n repeats    best-of count for the CPU time (5)\n"
+        "manifest defaults to corpus/manifest.txt\n",
+        argv0);
+}
+
+int main(int argc, char **argv)
+{
+    const char *gen_dir = NULL, *baseline_path = NULL;
+    int update = 0, repeats = 5;
+    double tol = 0.25;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "g:b:uT:n:h")) != -1) {
+        switch (opt) {
+        case 'g': gen_dir = optarg; break;
+        case 'b': baseline_path = optarg; break;
+        case 'u': update = 1; break;
+        case 'T': tol = atof(optarg); break;
+        case 'n': repeats = atoi(optarg); break;
+        default: usage(argv[0]); return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (repeats <= 0 || tol < 0.0 || (update && !baseline_path)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    char gen_manifest[512];
+    if (gen_dir) {
+        if (generate(gen_dir) != 0) return 1;
+        snprintf(gen_manifest, sizeof(gen_manifest), "%s/manifest.txt", gen_dir);
+    }
+
+    static entry_t entries[REGRESS_MAX_ENTRIES];
+    int n_entries = 0;
+    if (optind == argc) {
+        const char *m = gen_dir ? gen_manifest : "corpus/manifest.txt";
+        int k = read_manifest(m, entries, REGRESS_MAX_ENTRIES);
+        if (k < 0) return 1;
+        n_entries = k;
+    }
+    for (int i = optind; i < argc; i++) {
+        int k = read_manifest(argv[i], entries + n_entries, REGRESS_MAX_ENTRIES - n_entries);
+        if (k < 0) return 1;
+        n_entries += k;
+    }
+
+    static baseline_t base[REGRESS_MAX_ENTRIES * N_DECODERS];
+    int n_base = 0;
+    if (baseline_path && !update) {
+        n_base = read_baseline(baseline_path, base, REGRESS_MAX_ENTRIES * N_DECODERS);
+        if (n_base < 0) {
+            fprintf(stderr, "%s: %s\n", baseline_path, strerror(errno));
+            return 1;
+        }
+    }
+    FILE *out = NULL;
+    if (update) {
+        out = fopen(baseline_path, "w");
+        if (!out) {
+            fprintf(stderr, "%s: %s\n", baseline_path, strerror(errno));
+            return 1;
+        }
+        fprintf(out, "# entry decoder found cpu_ms_per_s peak_kb steady_allocs\n");
+    }
+
+    int regressions = check_reconfigure_q15();
+    printf("%-22s %-8s %7s %7s %8s %9s %8s %7s %6s %8s  %s\n", "entry", "decoder", "audio s",
+           "found", "ms/s", "ms/slot", "peak KB", "allocs", "steady", "max/call", "vs baseline");
+    for (int i = 0; i < n_entries; i++) {
+        for (int d = 0; d < N_DECODERS; d++) {
+            const entry_t *e = &entries[i];
+            if ((e->kind == KIND_FT8) != (strcmp(k_decoders[d], "ft8") == 0)) continue;
+
+            run_t r;
+            if (measure(d, e, repeats, &r) != 0) {
+                printf("%-22s %-8s  failed\n", e->name, k_decoders[d]);
+                regressions++;
+                continue;
+            }
+            double ms_per_s = r.cpu_ms / r.audio_s;
+            printf("%-22s %-8s %7.1f %7ld %8.2f %9.1f %8ld %7ld %6ld %8ld", e->name, k_decoders[d],
+                   r.audio_s, r.found, ms_per_s, ms_per_s * 15.0, r.peak_kb, r.allocs,
+                   r.steady_allocs, r.max_call);
+
+            if (out) {
+                fprintf(out, "%s %s %ld %.3f %ld %ld\n", e->name, k_decoders[d], r.found,
+                        ms_per_s, r.peak_kb, r.steady_allocs);
+                printf("  recorded\n");
+            } else {
+                const baseline_t *b = baseline_path
+                    ? find_baseline(base, n_base, e->name, k_decoders[d]) : NULL;
+                if (!baseline_path) {
+                    printf("\n");
+                } else if (!b) {
+                    int bad = r.steady_allocs > 0;
+                    printf(bad ? "  new, ALLOCATES\n" : "  new\n");
+                    regressions += bad;
+                } else {
+                    int bad = 0;
+                    if (r.found < b->found) {
+                        printf("  YIELD %ld < %ld", r.found, b->found);
+                        bad = 1;
+                    }
+                    if (ms_per_s > b->ms_per_s * (1.0 + tol)) {
+                        printf("  SPEED %+.0f%%", 100.0 * (ms_per_s / b->ms_per_s - 1.0));
+                        bad = 1;
+                    }
+                    if (r.peak_kb > (long)(b->peak_kb * (1.0 + tol)) + REGRESS_PEAK_SLACK_KB) {
+                        printf("  MEMORY %ld KB > %ld KB", r.peak_kb, b->peak_kb);
+                        bad = 1;
+                    }
+                    if (r.steady_allocs > b->steady_allocs) {
+                        printf("  ALLOCATES %ld > %ld", r.steady_allocs, b->steady_allocs);
+                        bad = 1;
+                    }
+                    printf("%s\n", bad ? "" : "  ok");
+                    regressions += bad;
+                }
+            }
+            for (int k = 0; k < r.n_sites; k++) printf("    %s\n", r.sites[k]);
+        }
+    }
+
+    if (out) {
+        fclose(out);
+        printf("baseline written to %s\n", baseline_path);
+        return 0;
+    }
+    if (baseline_path) printf("%d regression%s\n", regressions, regressions == 1 ? "" : "s");
+    return regressions ? 1 : 0;
+}
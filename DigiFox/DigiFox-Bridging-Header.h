@@ -2,9 +2,28 @@
 #define DigiFox_Bridging_Header_h
 
 #import "IOKitUSBSerial.h"
+#include "cat_fsk.h"
+#include "rig_snapshot.h"
 #include <hamlib/rig.h>
 // Old CW decoder disabled — replaced by ggmorse
 // #include "cw_decoder.h"
 #include "ggmorse_c_api.h"
+#include "sample_ring.h"
+#include "line_ring.h"
+#include "ui_latch.h"
+#include "audio_archive.h"
+#include "alloc_tracker.h"
+#include "trace_signpost.h"
+#include "polyphase_resampler.h"
+#include "cw_tone.h"
+#include "trusdx_demux.h"
+#include "ft8_decoder.h"
+#include "ft8_ldpc.h"
+#include "ft8_calls.h"
+#include "ft8_synth.h"
+#include "ft8_sync_metal.h"
+#include "spectrum_engine.h"
+#include "js8_decoder.h"
+#include "wspr_decoder.h"
 
 #endif
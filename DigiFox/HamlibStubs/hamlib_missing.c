@@ -1,9 +1,12 @@
 // Missing hamlib symbols not included in the pre-built static library.
 // Provides FIFO, timing, snapshot, and backend caps stubs.
 
+#include <stdatomic.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <pthread.h>
+#include <time.h>
 #include <mach/mach_time.h>
 
 #include "hamlib/rig.h"
@@ -11,73 +14,113 @@
 // ============================================================
 // FIFO implementation (matches hamlib fifo.h FIFO_RIG struct)
 // ============================================================
+//
+// Lock-free single-producer / single-consumer: the morse sender pushes,
+// hamlib's morse thread peeks and pops. head is written by the producer
+// only and published with release ordering after the bytes; tail moves
+// by compare-and-swap, so resetFIFO() can drop the queue from either
+// side without a lock. Same layout as hamlib's struct: the atomics are
+// plain ints, and the mutex is kept (unused) so the size matches.
 
 #define HAMLIB_FIFO_SIZE 1024
 
 typedef struct FIFO_RIG_s {
     char data[HAMLIB_FIFO_SIZE];
-    int head;
-    int tail;
+    _Atomic int head;   // Next byte to write, 0 ..< HAMLIB_FIFO_SIZE
+    _Atomic int tail;   // Next byte to read; head == tail is empty
     int flush;
     pthread_mutex_t mutex;
 } FIFO_RIG;
 
+_Static_assert(sizeof(_Atomic int) == sizeof(int) && _Alignof(_Atomic int) == _Alignof(int),
+               "FIFO_RIG indices must keep hamlib's int layout");
+_Static_assert(offsetof(FIFO_RIG, tail) == HAMLIB_FIFO_SIZE + sizeof(int),
+               "FIFO_RIG layout must match hamlib fifo.h");
+
 void initFIFO(FIFO_RIG *fifo) {
     if (!fifo) return;
     memset(fifo, 0, sizeof(FIFO_RIG));
+    atomic_init(&fifo->head, 0);
+    atomic_init(&fifo->tail, 0);
     pthread_mutex_init(&fifo->mutex, NULL);
 }
 
 void resetFIFO(FIFO_RIG *fifo) {
     if (!fifo) return;
-    pthread_mutex_lock(&fifo->mutex);
-    fifo->head = 0;
-    fifo->tail = 0;
+    // Consume everything queued so far
+    int tail = atomic_load_explicit(&fifo->tail, memory_order_relaxed);
+    int head = atomic_load_explicit(&fifo->head, memory_order_acquire);
+    while (tail != head &&
+           !atomic_compare_exchange_weak_explicit(&fifo->tail, &tail, head,
+                                                  memory_order_release, memory_order_relaxed)) {
+        head = atomic_load_explicit(&fifo->head, memory_order_acquire);
+    }
     fifo->flush = 0;
-    pthread_mutex_unlock(&fifo->mutex);
 }
 
+// Queues as much of msg as fits; -1 if it did not all fit
 int hl_push(FIFO_RIG *fifo, const char *msg) {
     if (!fifo || !msg) return -1;
-    pthread_mutex_lock(&fifo->mutex);
-    while (*msg) {
-        int next = (fifo->head + 1) % HAMLIB_FIFO_SIZE;
-        if (next == fifo->tail) { pthread_mutex_unlock(&fifo->mutex); return -1; }
-        fifo->data[fifo->head] = *msg++;
-        fifo->head = next;
-    }
-    pthread_mutex_unlock(&fifo->mutex);
-    return 0;
+    size_t len = strlen(msg);
+    int head = atomic_load_explicit(&fifo->head, memory_order_relaxed);
+    int tail = atomic_load_explicit(&fifo->tail, memory_order_acquire);
+
+    // One slot stays empty so a full ring is not mistaken for an empty one
+    size_t room = (size_t)((tail - head - 1 + HAMLIB_FIFO_SIZE) % HAMLIB_FIFO_SIZE);
+    size_t n = len < room ? len : room;
+    size_t first = (size_t)(HAMLIB_FIFO_SIZE - head);
+    if (first > n) first = n;
+    memcpy(fifo->data + head, msg, first);
+    memcpy(fifo->data, msg + first, n - first);
+
+    atomic_store_explicit(&fifo->head, (int)((head + n) % HAMLIB_FIFO_SIZE), memory_order_release);
+    return n == len ? 0 : -1;
 }
 
 int hl_pop(FIFO_RIG *fifo) {
     if (!fifo) return -1;
-    pthread_mutex_lock(&fifo->mutex);
-    if (fifo->head == fifo->tail) { pthread_mutex_unlock(&fifo->mutex); return -1; }
-    int c = (unsigned char)fifo->data[fifo->tail];
-    fifo->tail = (fifo->tail + 1) % HAMLIB_FIFO_SIZE;
-    pthread_mutex_unlock(&fifo->mutex);
-    return c;
+    int tail = atomic_load_explicit(&fifo->tail, memory_order_relaxed);
+    for (;;) {
+        if (tail == atomic_load_explicit(&fifo->head, memory_order_acquire)) return -1;
+        int c = (unsigned char)fifo->data[tail];
+        // Fails only if resetFIFO() dropped the queue meanwhile
+        if (atomic_compare_exchange_weak_explicit(&fifo->tail, &tail, (tail + 1) % HAMLIB_FIFO_SIZE,
+                                                  memory_order_release, memory_order_relaxed)) {
+            return c;
+        }
+    }
 }
 
 int hl_peek(FIFO_RIG *fifo) {
     if (!fifo) return -1;
-    pthread_mutex_lock(&fifo->mutex);
-    if (fifo->head == fifo->tail) { pthread_mutex_unlock(&fifo->mutex); return -1; }
-    int c = (unsigned char)fifo->data[fifo->tail];
-    pthread_mutex_unlock(&fifo->mutex);
-    return c;
+    int tail = atomic_load_explicit(&fifo->tail, memory_order_relaxed);
+    if (tail == atomic_load_explicit(&fifo->head, memory_order_acquire)) return -1;
+    return (unsigned char)fifo->data[tail];
 }
 
 // ============================================================
 // monotonic_seconds (used by hl_usleep in sleep.c)
 // ============================================================
 
+// Called in hl_usleep's wait loops, so no per-call timebase lookup and no
+// integer ticks * numer product, which can overflow after long uptimes.
+
+static double timebase_scale;   // Seconds per mach_absolute_time() tick
+static pthread_once_t timebase_once = PTHREAD_ONCE_INIT;
+
+static void init_timebase_scale(void) {
+    mach_timebase_info_data_t info;
+    mach_timebase_info(&info);
+    timebase_scale = (double)info.numer / (double)info.denom * 1e-9;
+}
+
 double monotonic_seconds(void) {
-    static mach_timebase_info_data_t info = {0, 0};
-    if (info.denom == 0) mach_timebase_info(&info);
-    uint64_t t = mach_absolute_time();
-    return (double)(t * info.numer / info.denom) / 1e9;
+    // Same clock as mach_absolute_time(), converted to ns by the kernel
+    if (__builtin_available(iOS 10.0, macOS 10.12, *)) {
+        return (double)clock_gettime_nsec_np(CLOCK_UPTIME_RAW) * 1e-9;
+    }
+    pthread_once(&timebase_once, init_timebase_scale);
+    return (double)mach_absolute_time() * timebase_scale;
 }
 
 // ============================================================
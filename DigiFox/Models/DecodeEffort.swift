@@ -0,0 +1,50 @@
+import Foundation
+
+/// How hard the decoders and the waterfall work, chosen in Settings.
+/// `EffortGovernor` steps it down for a while when the device runs hot,
+/// is in Low Power Mode or the FT8 decode falls behind. `.full` is what
+/// the decoders do by default.
+enum DecodeEffort: String, CaseIterable, Identifiable {
+    case full
+    case balanced
+    case economy
+
+    var id: String { rawValue }
+
+    var name: String {
+        switch self {
+        case .full:     return "Full"
+        case .balanced: return "Balanced"
+        case .economy:  return "Economy"
+        }
+    }
+
+    /// FT8 slot decode: sync candidates tried, subtraction passes and the
+    /// OSD fallback.
+    var ft8: FT8Demodulator.Effort {
+        switch self {
+        case .full:     return .init(maxCandidates: 40, passes: 3, osdDepth: 2, osdTimeBudget: 0.25)
+        case .balanced: return .init(maxCandidates: 25, passes: 2, osdDepth: 1, osdTimeBudget: 0.1)
+        case .economy:  return .init(maxCandidates: 12, passes: 1, osdDepth: 0, osdTimeBudget: 0)
+        }
+    }
+
+    /// ggmorse fine speed/level search step (`GGMorseDecoder.searchStep`).
+    var cwSearchStep: Int { self == .full ? 1 : 2 }
+
+    /// Waterfall redraws per second.
+    var waterfallFPS: Int {
+        switch self {
+        case .full:     return 30
+        case .balanced: return 20
+        case .economy:  return 10
+        }
+    }
+
+    /// This effort `steps` levels lower, down to `.economy`.
+    func stepped(down steps: Int) -> DecodeEffort {
+        let all = Self.allCases
+        let i = all.firstIndex(of: self)! + max(steps, 0)
+        return all[min(i, all.count - 1)]
+    }
+}
@@ -0,0 +1,80 @@
+import Foundation
+
+/// Decoded FT8/JS8 messages of the session, in a ring of `capacity` so an
+/// all-day session stays bounded: the oldest drop off as new ones come.
+/// Each batch appended is announced as a `Change` the views apply to the
+/// rows they already have, and callsigns (sender and addressee) are
+/// indexed so a station can be kept while any message of it is held.
+/// Used on the main thread.
+final class DecodeStore {
+
+    /// What one `append` did.
+    struct Change {
+        /// New messages, oldest first.
+        let inserted: [RxMessage]
+        /// Messages pushed off the ring to make room, oldest first.
+        let evicted: [RxMessage]
+    }
+
+    let capacity: Int
+    /// Messages held, at most `capacity`.
+    var count: Int { Int(next - first) }
+    /// Called after each `append` that added anything.
+    var onChange: ((Change) -> Void)?
+
+    /// Message with sequence number s is at ring[s % capacity].
+    private var ring: [RxMessage?]
+    private var first: UInt64 = 0
+    private var next: UInt64 = 0
+
+    /// Number of messages held per callsign.
+    private var byCall = [String: Int]()
+
+    init(capacity: Int = 5000) {
+        self.capacity = max(capacity, 1)
+        ring = [RxMessage?](repeating: nil, count: self.capacity)
+    }
+
+    /// Add a batch (one decode pass), evicting the oldest as needed.
+    func append(_ messages: [RxMessage]) {
+        guard !messages.isEmpty else { return }
+        var evicted = [RxMessage]()
+        for msg in messages {
+            if count == capacity, let old = ring[Int(first % UInt64(capacity))] {
+                unindex(old)
+                evicted.append(old)
+                first += 1
+            }
+            let seq = next
+            ring[Int(seq % UInt64(capacity))] = msg
+            next += 1
+            for call in Self.calls(msg) { byCall[call, default: 0] += 1 }
+        }
+        onChange?(Change(inserted: messages, evicted: evicted))
+    }
+
+    // MARK: - Queries
+
+    /// Whether any message held was sent by or to `callsign`.
+    func contains(callsign: String) -> Bool {
+        byCall[callsign.uppercased()] != nil
+    }
+
+    // MARK: - Private
+
+    private static func calls(_ msg: RxMessage) -> Set<String> {
+        var calls = Set<String>()
+        for call in [msg.ft8Message?.from ?? msg.from, msg.ft8Message?.to ?? msg.to] {
+            guard let c = call?.uppercased(), !c.isEmpty, c != "CQ",
+                  c != CallsignTable.unresolved else { continue }
+            calls.insert(c)
+        }
+        return calls
+    }
+
+    private func unindex(_ msg: RxMessage) {
+        for call in Self.calls(msg) {
+            if let n = byCall[call], n > 1 { byCall[call] = n - 1 } else { byCall[call] = nil }
+        }
+    }
+}
@@ -35,6 +35,7 @@ struct DemodResult {
     let deltaTime: Double
     let bits: [UInt8]
     let message: String
+    let speed: JS8Speed
 }
 
 struct QSOLogEntry: Identifiable {
@@ -27,9 +27,15 @@ class AppSettings: ObservableObject {
     // Radio profile (Digirig vs TruSDX)
     @AppStorage("radioProfile") var radioProfileRaw: String = RadioProfile.digirig.rawValue
 
+    /// (tr)uSDX digital TX as carrier FSK by timed FA commands instead
+    /// of streamed audio
+    @AppStorage("trusdxCATFSK") var trusdxCATFSK = false
+
     // Rig control (default: Yaesu FT-817, 38400 baud)
     @AppStorage("rigModel") var rigModel: Int = 1020
     @AppStorage("rigSerialRate") var rigSerialRate: Int = 38400
+    /// Seconds between rig state polls (frequency, mode, PTT, S-meter)
+    @AppStorage("rigPollInterval") var rigPollInterval: Double = 0.5
 
     var radioProfile: RadioProfile {
         get { RadioProfile(rawValue: radioProfileRaw) ?? .digirig }
@@ -45,6 +51,18 @@ class AppSettings: ObservableObject {
     @AppStorage("speedRaw") var speedRaw = 0
     @AppStorage("audioOffset") var audioOffset = 1000.0
 
+    // CW TX
+    /// Key CW as a shaped audio tone with PTT held (AFSK CW), timed by the
+    /// audio clock, instead of toggling the key line per element
+    @AppStorage("cwAudioKeying") var cwAudioKeying = false
+    @AppStorage("cwTonePitch") var cwTonePitch = 700.0
+
+    // Decoding
+    @AppStorage("decodeEffort") var decodeEffortRaw = DecodeEffort.full.rawValue
+    /// Step the effort down while the device is hot, in Low Power Mode or
+    /// the decodes fall behind (`EffortGovernor`)
+    @AppStorage("adaptiveEffort") var adaptiveEffort = true
+
     init() {
         if UserDefaults.standard.object(forKey: "rigModel") as? Int == 0 {
             rigModel = 1020
@@ -67,5 +85,10 @@ class AppSettings: ObservableObject {
         set { speedRaw = newValue.rawValue }
     }
 
+    var decodeEffort: DecodeEffort {
+        get { DecodeEffort(rawValue: decodeEffortRaw) ?? .full }
+        set { decodeEffortRaw = newValue.rawValue }
+    }
+
     var useHamlib: Bool { rigModel > 0 }
 }
@@ -16,6 +16,7 @@ struct RadioState {
     var isTransmitting: Bool = false
     var isConnected: Bool = false
     var rigName: String = ""
+    var strength: Int?               // S-meter, dB relative to S9
 }
 
 /// CAT controller for radio communication using Hamlib
@@ -23,6 +24,14 @@ actor CATController {
     private var hamlibRig: HamlibRig?
     private(set) var state = RadioState()
 
+    /// Rig state as of the last poll or set, readable from any thread
+    /// without waiting for the actor.
+    nonisolated let snapshot = RigSnapshot()
+
+    private var pollTask: Task<Void, Never>?
+    private var pollsPTT = true
+    private var pollsStrength = false
+
     // MARK: - Connection
 
     /// Connect to a rig using Hamlib model ID
@@ -51,6 +60,8 @@ actor CATController {
 
     /// Disconnect from rig
     func disconnect() {
+        stopPolling()
+        snapshot.clear()
         hamlibRig?.close()
         hamlibRig = nil
         state.isConnected = false
@@ -70,12 +81,14 @@ actor CATController {
         guard let rig = hamlibRig else { throw CATError.notConnected }
         try rig.setPTT(true)
         state.isTransmitting = true
+        publishState()
     }
 
     func pttOff() throws {
         guard let rig = hamlibRig else { throw CATError.notConnected }
         try rig.setPTT(false)
         state.isTransmitting = false
+        publishState()
     }
 
     // MARK: - Frequency
@@ -84,6 +97,7 @@ actor CATController {
         guard let rig = hamlibRig else { throw CATError.notConnected }
         try rig.setFrequency(Double(hz))
         state.frequency = hz
+        publishState()
     }
 
     func getFrequency() throws -> UInt64 {
@@ -100,16 +114,84 @@ actor CATController {
         let hamlibMode = HamlibRig.modeFromString(mode)
         try rig.setMode(hamlibMode)
         state.mode = mode
+        publishState()
     }
 
     func getMode() throws -> String {
         guard let rig = hamlibRig else { throw CATError.notConnected }
         let (mode, _) = try rig.getMode()
-        let modeStr = modeToString(mode)
+        let modeStr = HamlibRig.modeString(mode)
         state.mode = modeStr
         return modeStr
     }
 
+    // MARK: - Polling
+
+    /// Read frequency, mode, PTT and S-meter every `interval` seconds into
+    /// `snapshot`. The reads run here on the actor, in turn with every
+    /// other command, never on the caller's thread. Hamlib's own cache
+    /// answers a read that follows a set within half an interval.
+    func startPolling(interval: TimeInterval) {
+        stopPolling()
+        guard let rig = hamlibRig else { return }
+        rig.setCacheTimeout(ms: Int(interval * 500))
+        pollsPTT = true
+        pollsStrength = rig.hasStrength
+        let nanos = UInt64(max(interval, 0.05) * 1e9)
+        pollTask = Task { [weak self] in
+            while !Task.isCancelled {
+                guard let self, await self.poll() else { break }
+                try? await Task.sleep(nanoseconds: nanos)
+            }
+        }
+    }
+
+    func stopPolling() {
+        pollTask?.cancel()
+        pollTask = nil
+    }
+
+    /// One round of reads. A frequency that cannot be read means the rig
+    /// is gone: that publishes an empty reading and ends the polling.
+    /// Optional reads that fail once are not tried again, so a backend
+    /// without them costs no timeouts.
+    private func poll() -> Bool {
+        guard let rig = hamlibRig, !Task.isCancelled else { return false }
+        guard let freq = try? rig.getFrequency() else {
+            snapshot.publish(frequency: nil, mode: nil, ptt: nil, strength: nil)
+            return false
+        }
+        state.frequency = UInt64(freq)
+
+        var mode: rmode_t?
+        if let m = try? rig.getMode().mode {
+            mode = m
+            state.mode = HamlibRig.modeString(m)
+        }
+        var ptt: Bool?
+        if pollsPTT {
+            ptt = try? rig.getPTT()
+            if let ptt { state.isTransmitting = ptt } else { pollsPTT = false }
+        }
+        var strength: Int?
+        if pollsStrength {
+            strength = try? rig.getStrength()
+            if strength == nil { pollsStrength = false }
+        }
+        state.strength = strength
+
+        snapshot.publish(frequency: state.frequency, mode: mode, ptt: ptt, strength: strength)
+        return true
+    }
+
+    /// Write-through after a set, so readers see it before the next poll.
+    private func publishState() {
+        snapshot.publish(frequency: state.frequency,
+                         mode: state.mode.isEmpty ? nil : HamlibRig.modeFromString(state.mode),
+                         ptt: state.isTransmitting,
+                         strength: state.strength)
+    }
+
     // MARK: - Morse / CW
 
     func sendMorse(_ text: String) throws {
@@ -121,18 +203,6 @@ actor CATController {
         guard let rig = hamlibRig else { throw CATError.notConnected }
         try rig.stopMorse()
     }
-
-    // MARK: - Helpers
-
-    private func modeToString(_ mode: rmode_t) -> String {
-        if mode == kRIG_MODE_USB { return "USB" }
-        if mode == kRIG_MODE_LSB { return "LSB" }
-        if mode == kRIG_MODE_CW  { return "CW" }
-        if mode == kRIG_MODE_AM  { return "AM" }
-        if mode == kRIG_MODE_FM  { return "FM" }
-        if mode == kRIG_MODE_PKTUSB { return "DATA" }
-        return "USB"
-    }
 }
 
 // MARK: - Errors
@@ -0,0 +1,52 @@
+//
+//  CATFSKTransmitter.swift
+//  DigiFox
+//
+//  FSK transmit by timed FA commands (cat_fsk.h), for a rig sending a
+//  plain carrier: the (tr)uSDX in CW tune follows each FA, so the
+//  carrier steps through the tones of an FT8/JS8/WSPR frame.
+//
+
+import Foundation
+
+final class CATFSKTransmitter {
+    private let lock = NSLock()
+    private var running: OpaquePointer?
+
+    /// Send `tones` as carrier frequencies `carrier + tone * spacing` Hz,
+    /// one per `symbolDuration`, writing straight to `fd` from a thread of
+    /// its own. Returns once the last symbol has had its full period, or
+    /// nil if the plan could not be made.
+    func transmit(tones: [Int], carrier: Double, spacing: Double, symbolDuration: Double,
+                  fd: Int32) async -> cat_fsk_stats_t? {
+        let plan: OpaquePointer? = tones.map(Int32.init).withUnsafeBufferPointer { buf in
+            cat_fsk_create(buf.baseAddress, Int32(buf.count), carrier, spacing, symbolDuration)
+        }
+        guard let plan else { return nil }
+        lock.lock(); running = plan; lock.unlock()
+
+        let stats = await withCheckedContinuation { (cont: CheckedContinuation<cat_fsk_stats_t, Never>) in
+            let thread = Thread {
+                var stats = cat_fsk_stats_t()
+                let result = cat_fsk_run(plan, fd, 0, &stats)
+                if result < 0 { print("[CAT-FSK] write error: \(String(cString: strerror(errno)))") }
+                cont.resume(returning: stats)
+            }
+            thread.name = "CAT FSK"
+            thread.qualityOfService = .userInteractive
+            thread.start()
+        }
+
+        lock.lock(); running = nil; lock.unlock()
+        cat_fsk_destroy(plan)
+        print("[CAT-FSK] \(stats.sent) FA sent, \(stats.coalesced) coalesced, "
+              + "late max \(String(format: "%.0f", stats.max_late_s * 1e6)) µs")
+        return stats
+    }
+
+    /// Stop a transmission in progress.
+    func cancel() {
+        lock.lock(); defer { lock.unlock() }
+        if let plan = running { cat_fsk_cancel(plan) }
+    }
+}
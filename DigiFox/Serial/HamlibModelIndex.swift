@@ -0,0 +1,57 @@
+//
+//  HamlibModelIndex.swift
+//  DigiFox
+//
+//  Persisted list of the Hamlib rig models for the picker, so listing them
+//  does not register and walk all ~400 backends on every launch.
+//
+
+import Foundation
+
+/// The rig model list, built once per app build and Hamlib version with
+/// `HamlibRig.listModels()` and then read back from Caches.
+enum HamlibModelIndex {
+
+    private struct Index: Codable {
+        let key: String
+        let models: [HamlibModelInfo]
+    }
+
+    private static let lock = NSLock()
+    private static var cached: [HamlibModelInfo]?
+
+    /// Changes with the Hamlib library or the app build (the backend caps
+    /// stubs in hamlib_missing.c are part of the app).
+    private static var key: String {
+        let build = Bundle.main.object(forInfoDictionaryKey: "CFBundleVersion") as? String ?? ""
+        return "\(String(cString: rig_version()))/\(build)"
+    }
+
+    private static var url: URL? {
+        FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask).first?
+            .appendingPathComponent("hamlib-models.json")
+    }
+
+    /// All rig models, sorted by display name. Blocks on the first call
+    /// after an install or update while the index is built; call it off
+    /// the main thread.
+    static func models() -> [HamlibModelInfo] {
+        lock.lock()
+        defer { lock.unlock() }
+        if let cached { return cached }
+
+        let key = key
+        if let url, let data = try? Data(contentsOf: url),
+           let index = try? JSONDecoder().decode(Index.self, from: data), index.key == key {
+            cached = index.models
+            return index.models
+        }
+
+        let models = HamlibRig.listModels()
+        if let url, let data = try? JSONEncoder().encode(Index(key: key, models: models)) {
+            try? data.write(to: url, options: .atomic)
+        }
+        cached = models
+        return models
+    }
+}
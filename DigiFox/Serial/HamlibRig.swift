@@ -16,11 +16,12 @@ let kRIG_MODE_USB: rmode_t  = 1 << 2
 let kRIG_MODE_LSB: rmode_t  = 1 << 3
 let kRIG_MODE_FM: rmode_t   = 1 << 5
 let kRIG_MODE_PKTUSB: rmode_t = 1 << 11
+let kRIG_LEVEL_STRENGTH: setting_t = 1 << 30
 
 // MARK: - Rig Model Info
 
 /// Information about a supported Hamlib rig model
-struct HamlibModelInfo: Identifiable, Hashable {
+struct HamlibModelInfo: Identifiable, Hashable, Codable {
     let id: Int          // rig_model_t
     let name: String     // model_name
     let manufacturer: String // mfg_name
@@ -36,16 +37,31 @@ final class HamlibRig {
     private var rig: UnsafeMutablePointer<s_rig>?
     let modelId: Int
 
-    private static var backendsLoaded = false
+    /// Hamlib's backend registry is not thread-safe
+    private static let backendLock = NSLock()
+    private static var allBackendsLoaded = false
 
-    /// Ensure all Hamlib backends are registered (call once)
+    /// Register every Hamlib backend (~400 models). Only needed to list
+    /// them all; opening a rig loads just its own backend.
     static func loadBackends() {
-        guard !backendsLoaded else { return }
+        backendLock.lock()
+        defer { backendLock.unlock() }
+        guard !allBackendsLoaded else { return }
         rig_load_all_backends()
-        backendsLoaded = true
+        allBackendsLoaded = true
     }
 
-    /// List all registered rig models
+    /// Register the one backend that drives `modelId`, if not yet loaded.
+    static func loadBackend(for modelId: Int) {
+        guard modelId > 0 else { return }
+        backendLock.lock()
+        defer { backendLock.unlock() }
+        guard !allBackendsLoaded else { return }
+        _ = rig_check_backend(rig_model_t(modelId))
+    }
+
+    /// List all rig models by walking every backend. Slow; the picker
+    /// uses `HamlibModelIndex`, which only does this once per build.
     static func listModels() -> [HamlibModelInfo] {
         loadBackends()
 
@@ -90,7 +106,7 @@ final class HamlibRig {
 
     /// Initialize with a Hamlib model ID
     init?(modelId: Int) {
-        Self.loadBackends()
+        Self.loadBackend(for: modelId)
         guard let r = rig_init(rig_model_t(modelId)) else { return nil }
         self.rig = r
         self.modelId = modelId
@@ -207,6 +223,35 @@ final class HamlibRig {
         return ptt != RIG_PTT_OFF
     }
 
+    // MARK: - Levels
+
+    /// Whether the backend can read the S-meter
+    var hasStrength: Bool {
+        guard let rig else { return false }
+        return rig_has_get_level(rig, kRIG_LEVEL_STRENGTH) != 0
+    }
+
+    /// S-meter in dB relative to S9
+    func getStrength(vfo: vfo_t = kRIG_VFO_CURR) throws -> Int {
+        guard let rig else { throw HamlibError.notInitialized }
+        var value = value_t()
+        let result = rig_get_level(rig, vfo, kRIG_LEVEL_STRENGTH, &value)
+        guard result == Int32(RIG_OK.rawValue) else {
+            throw HamlibError.hamlibError(code: Int(result))
+        }
+        return Int(value.i)
+    }
+
+    // MARK: - Cache
+
+    /// How long Hamlib answers get_freq / get_mode / get_ptt from its own
+    /// cache instead of asking the rig (0 = always ask). A set updates
+    /// the cache, so reads right after one cost nothing.
+    func setCacheTimeout(ms: Int) {
+        guard let rig else { return }
+        rig_set_cache_timeout_ms(rig, HAMLIB_CACHE_ALL, Int32(ms))
+    }
+
     // MARK: - Morse / CW
 
     /// Send Morse code text — the rig keys CW automatically
@@ -264,6 +309,17 @@ extension HamlibRig {
         default:     return kRIG_MODE_USB
         }
     }
+
+    /// Convert Hamlib rmode_t to mode string
+    static func modeString(_ mode: rmode_t) -> String {
+        if mode == kRIG_MODE_USB { return "USB" }
+        if mode == kRIG_MODE_LSB { return "LSB" }
+        if mode == kRIG_MODE_CW  { return "CW" }
+        if mode == kRIG_MODE_AM  { return "AM" }
+        if mode == kRIG_MODE_FM  { return "FM" }
+        if mode == kRIG_MODE_PKTUSB { return "DATA" }
+        return "USB"
+    }
 }
 
 // MARK: - Errors
@@ -8,6 +8,7 @@
 //
 
 #import <Foundation/Foundation.h>
+#include "serial_ring.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -63,6 +64,26 @@ NS_ASSUME_NONNULL_BEGIN
                                    timeout:(NSTimeInterval)timeout
                                      error:(NSError **)error;
 
+/// Start an event-driven read stream instead of polling: a dispatch read
+/// source on the port's descriptor reads each arrival straight into
+/// `ring` (no allocation) and then calls `handler` on `queue` with the
+/// bytes now queued there. Replaces any earlier stream; it ends with
+/// stopReadStream, close, or when the device goes away.
+/// @param ring Caller-owned ring; must outlive the stream
+/// @param queue Serial queue for the reads and the handler
+/// @param handler Consumer side of `ring`, called after each read
+- (BOOL)startReadStreamIntoRing:(serial_ring_t *)ring
+                          queue:(dispatch_queue_t)queue
+                        handler:(void (^)(size_t available))handler
+                          error:(NSError **)error;
+
+/// Stop the read stream. Returns once the handler can no longer run, so
+/// the ring may be freed; do not call it from the stream's queue.
+- (void)stopReadStream;
+
+/// Whether a read stream is running
+@property (nonatomic, readonly) BOOL isStreaming;
+
 /// Set RTS (Request To Send) line state — used for PTT on Digirig
 - (BOOL)setRTS:(BOOL)enabled error:(NSError **)error;
 
@@ -168,6 +168,8 @@ static speed_t _baudRateToSpeed(NSUInteger baudRate) {
 @implementation IOKitUSBSerial {
     int _fd;
     struct termios _originalTermios;
+    dispatch_source_t _readSource;
+    dispatch_semaphore_t _readSourceDone;
 }
 
 + (BOOL)isAvailable {
@@ -291,6 +293,7 @@ static speed_t _baudRateToSpeed(NSUInteger baudRate) {
 }
 
 - (void)close {
+    [self stopReadStream];
     if (_fd >= 0) {
         // Restore original termios
         tcsetattr(_fd, TCSANOW, &_originalTermios);
@@ -411,6 +414,67 @@ static speed_t _baudRateToSpeed(NSUInteger baudRate) {
     return [self readDataWithMaxLength:maxLength error:error];
 }
 
+- (BOOL)startReadStreamIntoRing:(serial_ring_t *)ring
+                          queue:(dispatch_queue_t)queue
+                        handler:(void (^)(size_t available))handler
+                          error:(NSError **)error {
+    if (_fd < 0) {
+        if (error) {
+            *error = [NSError errorWithDomain:kIOKitUSBSerialErrorDomain
+                                         code:-1
+                                     userInfo:@{NSLocalizedDescriptionKey: @"Port not open"}];
+        }
+        return NO;
+    }
+    [self stopReadStream];
+
+    dispatch_source_t source = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, (uintptr_t)_fd, 0, queue);
+    if (!source) {
+        if (error) {
+            *error = [NSError errorWithDomain:kIOKitUSBSerialErrorDomain
+                                         code:-1
+                                     userInfo:@{NSLocalizedDescriptionKey: @"Cannot create read source"}];
+        }
+        return NO;
+    }
+
+    int fd = _fd;
+    dispatch_semaphore_t done = dispatch_semaphore_create(0);
+    __weak dispatch_source_t weakSource = source;
+    dispatch_source_set_event_handler(source, ^{
+        // The source fires while bytes are waiting, so the blocking fd
+        // returns at once with what has arrived
+        ssize_t n = serial_ring_fill(ring, fd);
+        if (n < 0 || (n == 0 && dispatch_source_get_data(weakSource) == 0)) {
+            // Read error, or readable with nothing to read: device gone
+            NSLog(@"IOKitUSBSerial: read stream ended: %s", n < 0 ? strerror(errno) : "end of file");
+            dispatch_source_cancel(weakSource);
+            return;
+        }
+        if (n > 0) handler(serial_ring_count(ring));
+    });
+    dispatch_source_set_cancel_handler(source, ^{
+        dispatch_semaphore_signal(done);
+    });
+
+    _readSource = source;
+    _readSourceDone = done;
+    dispatch_resume(source);
+    return YES;
+}
+
+- (void)stopReadStream {
+    if (!_readSource) return;
+    dispatch_source_cancel(_readSource);
+    dispatch_semaphore_wait(_readSourceDone, DISPATCH_TIME_FOREVER);
+    _readSource = nil;
+    _readSourceDone = nil;
+}
+
+- (BOOL)isStreaming {
+    return _readSource != nil && !dispatch_source_testcancel(_readSource);
+}
+
 - (BOOL)setRTS:(BOOL)enabled error:(NSError **)error {
     if (_fd < 0) {
         if (error) {
@@ -36,14 +36,10 @@ class MorseKeyer {
     init() { stopFlag.pointee = 0 }
     deinit { stopFlag.deallocate() }
 
-    /// Pre-compute all timed events, then execute them with absolute timing.
-    func key(text: String, wpm: Int, keyDown: @escaping () -> Void, keyUp: @escaping () -> Void, completion: @escaping () -> Void) {
-        guard thread == nil else { return }
-
-        // Reset stop flag from any previous state (-1 after stop)
-        stopFlag.pointee = 0
-
-        // Pre-compute event schedule: [(relativeTime, isKeyDown)]
+    /// Key event schedule for `text`: (seconds from start, isKeyDown),
+    /// alternating down and up. Played by `key(...)` on the serial lines,
+    /// or rendered to audio by `CWToneSource`.
+    static func events(text: String, wpm: Int) -> [(Double, Bool)] {
         let dot = 1.2 / Double(max(wpm, 5))
         var events = [(Double, Bool)]()
         var t = 0.0
@@ -82,6 +78,18 @@ class MorseKeyer {
             }
         }
 
+        return events
+    }
+
+    /// Pre-compute all timed events, then execute them with absolute timing.
+    func key(text: String, wpm: Int, keyDown: @escaping () -> Void, keyUp: @escaping () -> Void, completion: @escaping () -> Void) {
+        guard thread == nil else { return }
+
+        // Reset stop flag from any previous state (-1 after stop)
+        stopFlag.pointee = 0
+
+        let events = Self.events(text: text, wpm: wpm)
+
         OSAtomicCompareAndSwap32(0, 1, stopFlag) // set running
 
         let sf = stopFlag
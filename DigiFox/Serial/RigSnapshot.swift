@@ -0,0 +1,68 @@
+//
+//  RigSnapshot.swift
+//  DigiFox
+//
+//  Last polled rig state (rig_snapshot.h). CATController's poller is the
+//  only writer; UI and decoders read it from any thread without waiting
+//  on the actor or the serial port.
+//
+
+import Foundation
+
+/// One poll's worth of rig state
+struct RigReading {
+    var frequency: UInt64?
+    var mode: String?
+    var isTransmitting: Bool?
+    var strength: Int?           // dB relative to S9
+    let generation: UInt32
+    let time: Double             // rig_snapshot_now() seconds
+
+    /// The poll could not even read the frequency: the rig is gone.
+    var isLost: Bool { frequency == nil }
+}
+
+final class RigSnapshot: @unchecked Sendable {
+    private let store: OpaquePointer
+
+    init() {
+        store = rig_snapshot_store_create()
+    }
+
+    deinit {
+        rig_snapshot_store_destroy(store)
+    }
+
+    /// Generation of the latest reading; 0 before the first poll.
+    var generation: UInt32 { rig_snapshot_generation(store) }
+
+    /// Latest reading, nil before the first poll. Lock-free.
+    func read() -> RigReading? {
+        var s = rig_snapshot_t()
+        guard rig_snapshot_read(store, &s) != 0 else { return nil }
+        let valid = s.valid
+        return RigReading(
+            frequency: valid & RIG_SNAPSHOT_FREQ != 0 ? s.freq_hz : nil,
+            mode: valid & RIG_SNAPSHOT_MODE != 0 ? HamlibRig.modeString(rmode_t(s.mode)) : nil,
+            isTransmitting: valid & RIG_SNAPSHOT_PTT != 0 ? s.ptt != 0 : nil,
+            strength: valid & RIG_SNAPSHOT_STRENGTH != 0 ? Int(s.strength_db) : nil,
+            generation: s.generation,
+            time: s.updated_s
+        )
+    }
+
+    // MARK: - Writer side (CATController only)
+
+    func publish(frequency: UInt64?, mode: rmode_t?, ptt: Bool?, strength: Int?) {
+        var s = rig_snapshot_t()
+        if let frequency { s.freq_hz = frequency; s.valid |= RIG_SNAPSHOT_FREQ }
+        if let mode { s.mode = UInt64(mode); s.valid |= RIG_SNAPSHOT_MODE }
+        if let ptt { s.ptt = ptt ? 1 : 0; s.valid |= RIG_SNAPSHOT_PTT }
+        if let strength { s.strength_db = Int32(strength); s.valid |= RIG_SNAPSHOT_STRENGTH }
+        rig_snapshot_publish(store, &s)
+    }
+
+    func clear() {
+        rig_snapshot_clear(store)
+    }
+}
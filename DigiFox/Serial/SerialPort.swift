@@ -59,6 +59,9 @@ actor SerialPort {
     private var port: IOKitUSBSerial?
     private let queue = DispatchQueue(label: "serial.port.io", qos: .userInitiated)
 
+    /// Ring the read stream fills, freed when the stream stops
+    private var streamRing: OpaquePointer?
+
     /// Stored fd for nonisolated access (CW keying). Updated on open/close.
     nonisolated(unsafe) private(set) var rawFD: Int32 = -1
 
@@ -161,6 +164,7 @@ actor SerialPort {
 
     /// Close the port
     func close() {
+        stopReadStream()
         port?.close()
         port = nil
         rawFD = -1
@@ -194,6 +198,53 @@ actor SerialPort {
         return try port.readData(withMaxLength: maxLength, timeout: timeout)
     }
 
+    // MARK: - Read Stream
+
+    /// Whether a read stream is delivering bytes
+    var isStreaming: Bool {
+        port?.isStreaming ?? false
+    }
+
+    /// Deliver received bytes as they arrive instead of polling `read`:
+    /// a read source on the port reads each arrival straight into a ring
+    /// (`serial_ring.h`) and `onBytes` gets the queued bytes in place on
+    /// the port's I/O queue, valid only during the call. Replaces any
+    /// earlier stream; `read` must not be used while one runs.
+    func startReadStream(capacity: Int = 16384,
+                         onBytes: @escaping (UnsafeBufferPointer<UInt8>) -> Void) throws {
+        guard let port, port.isOpen else { throw SerialPortError.notOpen }
+        stopReadStream()
+        guard let ring = serial_ring_create(capacity) else {
+            throw SerialPortError.readFailed("Cannot allocate read ring")
+        }
+        do {
+            try port.startReadStream(into: ring, queue: queue) { _ in
+                var bytes: UnsafePointer<UInt8>?
+                while true {
+                    let n = serial_ring_peek(ring, &bytes)
+                    guard n > 0, let bytes else { break }
+                    onBytes(UnsafeBufferPointer(start: bytes, count: n))
+                    serial_ring_consume(ring, n)
+                }
+            }
+        } catch {
+            serial_ring_destroy(ring)
+            throw SerialPortError.readFailed(error.localizedDescription)
+        }
+        streamRing = ring
+    }
+
+    /// Stop the read stream; `onBytes` is not called after this returns.
+    func stopReadStream() {
+        port?.stopReadStream()
+        if let ring = streamRing {
+            let dropped = serial_ring_dropped(ring)
+            if dropped > 0 { print("[SerialPort] read stream dropped \(dropped) bytes (ring full)") }
+            serial_ring_destroy(ring)
+            streamRing = nil
+        }
+    }
+
     /// Send a command and read the response
     func sendCommand(_ command: String, timeout: TimeInterval = 1.0) throws -> String {
         try write(command)
@@ -0,0 +1,172 @@
+/**
+ * cat_fsk.c — Preformatted FA commands written at absolute deadlines
+ */
+
+#include "cat_fsk.h"
+
+#include <errno.h>
+#include <math.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Sleep until this long before a deadline (above the usual wakeup
+   latency), then spin on the clock */
+#define CAT_FSK_SPIN_S   0.001
+
+/* Longest single sleep, so cancel is noticed */
+#define CAT_FSK_SLICE_S  0.050
+
+struct cat_fsk_t {
+    int     n;
+    double  symbol_s;
+    long long *hz;                 /* Per symbol */
+    char   *commands;              /* n · CAT_FSK_COMMAND_LEN */
+    _Atomic int cancelled;
+};
+
+cat_fsk_t *cat_fsk_create(const int *tones, int n, double f0_hz, double spacing_hz,
+                          double symbol_s)
+{
+    if (!tones || n <= 0 || !(symbol_s > 0.0) || !(f0_hz > 0.0)) return NULL;
+
+    cat_fsk_t *p = (cat_fsk_t *)calloc(1, sizeof(cat_fsk_t));
+    if (!p) return NULL;
+    p->n = n;
+    p->symbol_s = symbol_s;
+    p->hz = (long long *)malloc((size_t)n * sizeof(long long));
+    p->commands = (char *)malloc((size_t)n * CAT_FSK_COMMAND_LEN + 1);
+    if (!p->hz || !p->commands) {
+        cat_fsk_destroy(p);
+        return NULL;
+    }
+
+    for (int k = 0; k < n; k++) {
+        long long hz = llround(f0_hz + tones[k] * spacing_hz);
+        if (hz < 0 || hz > 99999999999LL) {
+            cat_fsk_destroy(p);
+            return NULL;
+        }
+        p->hz[k] = hz;
+        /* The NUL lands on the next command's first byte, or the spare one */
+        snprintf(p->commands + (size_t)k * CAT_FSK_COMMAND_LEN, CAT_FSK_COMMAND_LEN + 1,
+                 "FA%011lld;", hz);
+    }
+    atomic_init(&p->cancelled, 0);
+    return p;
+}
+
+int cat_fsk_symbols(const cat_fsk_t *p)
+{
+    return p->n;
+}
+
+const char *cat_fsk_command(const cat_fsk_t *p, int k)
+{
+    return p->commands + (size_t)k * CAT_FSK_COMMAND_LEN;
+}
+
+double cat_fsk_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+void cat_fsk_cancel(cat_fsk_t *p)
+{
+    atomic_store_explicit(&p->cancelled, 1, memory_order_relaxed);
+}
+
+static int is_cancelled(cat_fsk_t *p)
+{
+    return atomic_load_explicit(&p->cancelled, memory_order_relaxed);
+}
+
+/* Sleep, then spin, until deadline; 1 if cancelled meanwhile */
+static int wait_until(cat_fsk_t *p, double deadline)
+{
+    for (;;) {
+        if (is_cancelled(p)) return 1;
+        double left = deadline - cat_fsk_now();
+        if (left <= 0.0) return 0;
+        if (left > CAT_FSK_SPIN_S) {
+            double s = left - CAT_FSK_SPIN_S;
+            if (s > CAT_FSK_SLICE_S) s = CAT_FSK_SLICE_S;
+            struct timespec ts = { (time_t)s, (long)((s - (double)(time_t)s) * 1e9) };
+            nanosleep(&ts, NULL);
+        }
+    }
+}
+
+static int write_all(int fd, const char *buf, size_t n)
+{
+    while (n > 0) {
+        ssize_t w = write(fd, buf, n);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        buf += w;
+        n -= (size_t)w;
+    }
+    return 0;
+}
+
+int cat_fsk_run(cat_fsk_t *p, int fd, double start, cat_fsk_stats_t *stats)
+{
+    cat_fsk_stats_t st;
+    memset(&st, 0, sizeof(st));
+    if (start <= 0.0) start = cat_fsk_now();
+
+    double late_sum = 0.0;
+    long long last_hz = -1;
+    int result = 0;
+
+    for (int k = 0; k < p->n && result == 0; k++) {
+        /* Behind: skip to the newest symbol already due */
+        double now = cat_fsk_now();
+        while (k + 1 < p->n && now >= start + (k + 1) * p->symbol_s) {
+            k++;
+            st.coalesced++;
+        }
+
+        if (p->hz[k] == last_hz) {
+            st.unchanged++;
+            continue;
+        }
+
+        double deadline = start + k * p->symbol_s;
+        if (wait_until(p, deadline)) {
+            result = 1;
+            break;
+        }
+        double late = cat_fsk_now() - deadline;
+        if (write_all(fd, cat_fsk_command(p, k), CAT_FSK_COMMAND_LEN) != 0) {
+            result = -1;
+            break;
+        }
+        last_hz = p->hz[k];
+        st.sent++;
+        late_sum += late;
+        if (late > st.max_late_s) st.max_late_s = late;
+    }
+
+    /* The last symbol lasts its full period */
+    if (result == 0 && wait_until(p, start + p->n * p->symbol_s)) result = 1;
+
+    if (st.sent > 0) st.mean_late_s = late_sum / st.sent;
+    if (stats) *stats = st;
+    return result;
+}
+
+void cat_fsk_destroy(cat_fsk_t *p)
+{
+    if (!p) return;
+    free(p->hz);
+    free(p->commands);
+    free(p);
+}
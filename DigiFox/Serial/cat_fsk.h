@@ -0,0 +1,83 @@
+/**
+ * cat_fsk.h — FSK transmit by timed FA commands
+ *
+ * Sends an FT8 / JS8 / WSPR symbol stream as carrier frequency steps on
+ * a rig that transmits a plain carrier (the (tr)uSDX in CW tune): every
+ * symbol's "FAnnnnnnnnnnn;" is formatted up front, and the run writes
+ * each one straight to the serial descriptor at its deadline, start +
+ * k · symbol period, on a clock that does not drift with call latency.
+ *
+ * Waiting sleeps until shortly before a deadline and spins the rest, so
+ * commands leave within a few tens of microseconds of it. If the writer
+ * falls behind (a stalled write, a preempted thread), the symbols
+ * already overdue are coalesced: only the newest due one is written,
+ * and the rest of the stream keeps its original deadlines. A symbol on
+ * the same frequency as the one before sends nothing.
+ *
+ * FA takes whole hertz, so tone frequencies are rounded: FT8's 6.25 Hz
+ * steps come out within 0.5 Hz.
+ */
+
+#ifndef CAT_FSK_H
+#define CAT_FSK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* "FA" + 11 digits + ';' */
+#define CAT_FSK_COMMAND_LEN  14
+
+/* Opaque plan handle */
+typedef struct cat_fsk_t cat_fsk_t;
+
+typedef struct {
+    int    sent;           /* FA commands written */
+    int    coalesced;      /* Overdue symbols replaced by a later one */
+    int    unchanged;      /* Symbols on the previous frequency */
+    double max_late_s;     /* Worst write start past its deadline */
+    double mean_late_s;
+} cat_fsk_stats_t;
+
+/**
+ * Plan a stream: symbol k is sent on f0_hz + tones[k] · spacing_hz for
+ * symbol_s seconds.
+ * Returns NULL on bad arguments or allocation failure.
+ */
+cat_fsk_t *cat_fsk_create(const int *tones, int n, double f0_hz, double spacing_hz,
+                          double symbol_s);
+
+/* Symbols in the plan */
+int cat_fsk_symbols(const cat_fsk_t *p);
+
+/* Symbol k's command, CAT_FSK_COMMAND_LEN bytes, not NUL-terminated */
+const char *cat_fsk_command(const cat_fsk_t *p, int k);
+
+/* Monotonic seconds, the clock deadlines are on */
+double cat_fsk_now(void);
+
+/**
+ * Send the stream on fd, blocking until the last symbol has had its
+ * full period. Symbol 0 is due at start (cat_fsk_now() units; 0 = now).
+ *
+ * @param stats  Optional, filled on return
+ * @return 0 when done, 1 if cancelled, -1 on a write error (errno set)
+ */
+int cat_fsk_run(cat_fsk_t *p, int fd, double start, cat_fsk_stats_t *stats);
+
+/**
+ * Stop a run from another thread, or the next one if none is going:
+ * it returns within one sleep slice and the plan stays cancelled.
+ */
+void cat_fsk_cancel(cat_fsk_t *p);
+
+/**
+ * Destroy plan. Not while it runs.
+ */
+void cat_fsk_destroy(cat_fsk_t *p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CAT_FSK_H */
@@ -0,0 +1,107 @@
+/**
+ * rig_snapshot.c — Sequence-counted rig state for lock-free readers
+ */
+
+#include "rig_snapshot.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+struct rig_snapshot_store_t {
+    _Atomic uint32_t seq;           /* Odd while a publish is in progress */
+    _Atomic uint32_t generation;
+    _Atomic uint64_t freq_hz;
+    _Atomic uint64_t mode;
+    _Atomic int32_t  ptt;
+    _Atomic int32_t  strength_db;
+    _Atomic int32_t  valid;
+    _Atomic uint64_t updated_bits;  /* double, by bit pattern */
+};
+
+rig_snapshot_store_t *rig_snapshot_store_create(void)
+{
+    rig_snapshot_store_t *s = (rig_snapshot_store_t *)calloc(1, sizeof(rig_snapshot_store_t));
+    if (!s) return NULL;
+    rig_snapshot_clear(s);
+    return s;
+}
+
+double rig_snapshot_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void store_fields(rig_snapshot_store_t *s, const rig_snapshot_t *snap, uint32_t generation)
+{
+    uint32_t seq = atomic_load_explicit(&s->seq, memory_order_relaxed);
+    atomic_store_explicit(&s->seq, seq + 1, memory_order_relaxed);
+    /* Field stores may not move above the odd count */
+    atomic_thread_fence(memory_order_release);
+
+    uint64_t bits;
+    memcpy(&bits, &snap->updated_s, sizeof(bits));
+    atomic_store_explicit(&s->freq_hz, snap->freq_hz, memory_order_relaxed);
+    atomic_store_explicit(&s->mode, snap->mode, memory_order_relaxed);
+    atomic_store_explicit(&s->ptt, snap->ptt, memory_order_relaxed);
+    atomic_store_explicit(&s->strength_db, snap->strength_db, memory_order_relaxed);
+    atomic_store_explicit(&s->valid, snap->valid, memory_order_relaxed);
+    atomic_store_explicit(&s->updated_bits, bits, memory_order_relaxed);
+    atomic_store_explicit(&s->generation, generation, memory_order_relaxed);
+
+    atomic_store_explicit(&s->seq, seq + 2, memory_order_release);
+}
+
+void rig_snapshot_publish(rig_snapshot_store_t *s, const rig_snapshot_t *snap)
+{
+    rig_snapshot_t copy = *snap;
+    if (copy.updated_s == 0.0) copy.updated_s = rig_snapshot_now();
+    uint32_t generation = atomic_load_explicit(&s->generation, memory_order_relaxed) + 1;
+    if (generation == 0) generation = 1;
+    store_fields(s, &copy, generation);
+}
+
+uint32_t rig_snapshot_read(const rig_snapshot_store_t *cs, rig_snapshot_t *out)
+{
+    rig_snapshot_store_t *s = (rig_snapshot_store_t *)cs;
+    rig_snapshot_t snap;
+    uint32_t before, after;
+    do {
+        before = atomic_load_explicit(&s->seq, memory_order_acquire);
+        snap.freq_hz     = atomic_load_explicit(&s->freq_hz, memory_order_relaxed);
+        snap.mode        = atomic_load_explicit(&s->mode, memory_order_relaxed);
+        snap.ptt         = atomic_load_explicit(&s->ptt, memory_order_relaxed);
+        snap.strength_db = atomic_load_explicit(&s->strength_db, memory_order_relaxed);
+        snap.valid       = atomic_load_explicit(&s->valid, memory_order_relaxed);
+        snap.generation  = atomic_load_explicit(&s->generation, memory_order_relaxed);
+        uint64_t bits    = atomic_load_explicit(&s->updated_bits, memory_order_relaxed);
+        memcpy(&snap.updated_s, &bits, sizeof(bits));
+        /* Field loads may not move below the second count */
+        atomic_thread_fence(memory_order_acquire);
+        after = atomic_load_explicit(&s->seq, memory_order_relaxed);
+    } while ((before & 1u) || before != after);
+
+    if (out) *out = snap;
+    return snap.generation;
+}
+
+uint32_t rig_snapshot_generation(const rig_snapshot_store_t *cs)
+{
+    rig_snapshot_store_t *s = (rig_snapshot_store_t *)cs;
+    return atomic_load_explicit(&s->generation, memory_order_acquire);
+}
+
+void rig_snapshot_clear(rig_snapshot_store_t *s)
+{
+    rig_snapshot_t empty;
+    memset(&empty, 0, sizeof(empty));
+    store_fields(s, &empty, 0);
+}
+
+void rig_snapshot_store_destroy(rig_snapshot_store_t *s)
+{
+    free(s);
+}
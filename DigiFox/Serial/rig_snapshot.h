@@ -0,0 +1,77 @@
+/**
+ * rig_snapshot.h — Last known rig state, published by the poller
+ *
+ * One writer (the rig poller, which owns all CAT traffic) publishes
+ * frequency, mode, PTT and S-meter after every poll; any number of
+ * readers (UI, decoders, TX scheduling) copy it out without locking
+ * and without touching the serial port.
+ *
+ * The fields are guarded by a sequence count: the writer makes it odd,
+ * stores the fields, and makes it even again; a reader that sees the
+ * count change under it, or odd, copies again. Every field is itself an
+ * atomic, so a torn copy is never used and never a data race. The
+ * writer never waits, and a reader retries only when it overlaps a
+ * publish, which happens a few times a second at most.
+ */
+
+#ifndef RIG_SNAPSHOT_H
+#define RIG_SNAPSHOT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Which fields of a snapshot hold a reading */
+#define RIG_SNAPSHOT_FREQ      (1 << 0)
+#define RIG_SNAPSHOT_MODE      (1 << 1)
+#define RIG_SNAPSHOT_PTT       (1 << 2)
+#define RIG_SNAPSHOT_STRENGTH  (1 << 3)
+
+typedef struct {
+    uint64_t freq_hz;
+    uint64_t mode;          /* Hamlib rmode_t */
+    int32_t  ptt;           /* 0 = receive */
+    int32_t  strength_db;   /* S-meter relative to S9 (S9 = 0, S0 = -54) */
+    int32_t  valid;         /* RIG_SNAPSHOT_* bits; 0 = the poll failed */
+    uint32_t generation;    /* Publishes so far; 0 = none yet */
+    double   updated_s;     /* Monotonic seconds of the poll */
+} rig_snapshot_t;
+
+/* Opaque store handle */
+typedef struct rig_snapshot_store_t rig_snapshot_store_t;
+
+/* Returns NULL on allocation failure. Starts empty (generation 0). */
+rig_snapshot_store_t *rig_snapshot_store_create(void);
+
+/**
+ * Publish a snapshot (single writer). The generation and, if zero,
+ * updated_s are filled in by the store.
+ */
+void rig_snapshot_publish(rig_snapshot_store_t *s, const rig_snapshot_t *snap);
+
+/**
+ * Copy the latest snapshot out. Lock-free, any thread.
+ *
+ * @return Its generation; 0 if nothing has been published
+ */
+uint32_t rig_snapshot_read(const rig_snapshot_store_t *s, rig_snapshot_t *out);
+
+/* Generation of the latest snapshot, for a cheap "anything new?" */
+uint32_t rig_snapshot_generation(const rig_snapshot_store_t *s);
+
+/* Back to empty, e.g. on disconnect (writer side) */
+void rig_snapshot_clear(rig_snapshot_store_t *s);
+
+/* Monotonic seconds, the clock updated_s is on */
+double rig_snapshot_now(void);
+
+/* Destroy store */
+void rig_snapshot_store_destroy(rig_snapshot_store_t *s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RIG_SNAPSHOT_H */
@@ -0,0 +1,166 @@
+/**
+ * serial_ring.c — readv() into the free space, peek / consume in place
+ */
+
+#include "serial_ring.h"
+
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+/* Covers the 128-byte lines of Apple silicon as well as 64-byte x86 */
+#define SERIAL_RING_LINE 128
+
+struct serial_ring_t {
+    uint8_t *buf;
+    size_t   capacity;             /* Bytes, power of two */
+    size_t   mask;
+
+    /* Producer side */
+    _Atomic size_t   head;         /* Next byte to write (monotonic) */
+    _Atomic uint64_t dropped;
+    char pad0[SERIAL_RING_LINE - sizeof(size_t) - sizeof(uint64_t)];
+
+    /* Consumer side */
+    _Atomic size_t tail;           /* Next byte to read (monotonic) */
+    char pad1[SERIAL_RING_LINE - sizeof(size_t)];
+};
+
+serial_ring_t *serial_ring_create(size_t min_capacity)
+{
+    serial_ring_t *r = (serial_ring_t *)calloc(1, sizeof(serial_ring_t));
+    if (!r) return NULL;
+
+    r->capacity = 64;
+    while (r->capacity < min_capacity) r->capacity <<= 1;
+    r->mask = r->capacity - 1;
+    r->buf = (uint8_t *)malloc(r->capacity);
+    if (!r->buf) {
+        free(r);
+        return NULL;
+    }
+
+    atomic_init(&r->head, 0);
+    atomic_init(&r->tail, 0);
+    atomic_init(&r->dropped, 0);
+    return r;
+}
+
+size_t serial_ring_capacity(const serial_ring_t *r)
+{
+    return r->capacity;
+}
+
+/* ------------------------------------------------------------------ */
+/* Producer                                                            */
+/* ------------------------------------------------------------------ */
+
+/* Free space from head as up to two regions; returns how many */
+static int free_regions(serial_ring_t *r, size_t head, struct iovec iov[2])
+{
+    size_t tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+    size_t room = r->capacity - (head - tail);
+    if (room == 0) return 0;
+
+    size_t at = head & r->mask;
+    size_t first = r->capacity - at;
+    if (first > room) first = room;
+    iov[0].iov_base = r->buf + at;
+    iov[0].iov_len = first;
+    if (first == room) return 1;
+    iov[1].iov_base = r->buf;
+    iov[1].iov_len = room - first;
+    return 2;
+}
+
+ssize_t serial_ring_fill(serial_ring_t *r, int fd)
+{
+    size_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    struct iovec iov[2];
+    int n_iov = free_regions(r, head, iov);
+
+    if (n_iov == 0) {
+        /* Full: take the bytes off the port anyway so it stops signalling */
+        uint8_t scratch[256];
+        ssize_t n = read(fd, scratch, sizeof(scratch));
+        if (n > 0) {
+            atomic_fetch_add_explicit(&r->dropped, (uint64_t)n, memory_order_relaxed);
+            return 0;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EINTR)) return 0;
+        return n;
+    }
+
+    ssize_t n = readv(fd, iov, n_iov);
+    if (n < 0) return (errno == EAGAIN || errno == EINTR) ? 0 : -1;
+    atomic_store_explicit(&r->head, head + (size_t)n, memory_order_release);
+    return n;
+}
+
+size_t serial_ring_push(serial_ring_t *r, const uint8_t *src, size_t n)
+{
+    size_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    struct iovec iov[2];
+    int n_iov = free_regions(r, head, iov);
+
+    size_t done = 0;
+    for (int k = 0; k < n_iov && done < n; k++) {
+        size_t take = iov[k].iov_len;
+        if (take > n - done) take = n - done;
+        memcpy(iov[k].iov_base, src + done, take);
+        done += take;
+    }
+    atomic_store_explicit(&r->head, head + done, memory_order_release);
+    return done;
+}
+
+/* ------------------------------------------------------------------ */
+/* Consumer                                                            */
+/* ------------------------------------------------------------------ */
+
+size_t serial_ring_peek(serial_ring_t *r, const uint8_t **bytes)
+{
+    size_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+    size_t count = head - tail;
+    size_t at = tail & r->mask;
+
+    if (count > r->capacity - at) count = r->capacity - at;
+    *bytes = r->buf + at;
+    return count;
+}
+
+void serial_ring_consume(serial_ring_t *r, size_t n)
+{
+    size_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    atomic_store_explicit(&r->tail, tail + n, memory_order_release);
+}
+
+size_t serial_ring_count(const serial_ring_t *r)
+{
+    serial_ring_t *m = (serial_ring_t *)r;
+    size_t tail = atomic_load_explicit(&m->tail, memory_order_acquire);
+    size_t head = atomic_load_explicit(&m->head, memory_order_acquire);
+    return head - tail;
+}
+
+uint64_t serial_ring_dropped(const serial_ring_t *r)
+{
+    return atomic_load_explicit(&((serial_ring_t *)r)->dropped, memory_order_relaxed);
+}
+
+void serial_ring_reset(serial_ring_t *r)
+{
+    atomic_store_explicit(&r->head, 0, memory_order_relaxed);
+    atomic_store_explicit(&r->tail, 0, memory_order_relaxed);
+}
+
+void serial_ring_destroy(serial_ring_t *r)
+{
+    if (!r) return;
+    free(r->buf);
+    free(r);
+}
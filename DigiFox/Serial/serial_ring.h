@@ -0,0 +1,92 @@
+/**
+ * serial_ring.h — Byte ring filled straight from a serial descriptor
+ *
+ * The receive side of an event-driven serial stream: when the port has
+ * data, the producer read()s it directly into the ring's free space
+ * (one readv() across the wrap), and the consumer demuxes it in place
+ * from the ring's memory. Neither side allocates or copies.
+ *
+ * One producer and one consumer may run on different threads; each
+ * index is written by one side only and published with release /
+ * acquire ordering, as in spsc_ring. The handle is opaque so Swift and
+ * Objective-C can hold it without seeing the atomics.
+ *
+ * When the ring is full the newest bytes are read and dropped, so a
+ * level-triggered read source cannot spin on a stalled consumer; they
+ * are counted in serial_ring_dropped().
+ */
+
+#ifndef SERIAL_RING_H
+#define SERIAL_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Opaque ring handle */
+typedef struct serial_ring_t serial_ring_t;
+
+/**
+ * Create a ring holding at least min_capacity bytes (rounded up to a
+ * power of two). Returns NULL on allocation failure.
+ */
+serial_ring_t *serial_ring_create(size_t min_capacity);
+
+/* Capacity in bytes */
+size_t serial_ring_capacity(const serial_ring_t *r);
+
+/**
+ * Producer: read what fd has ready into the free space.
+ *
+ * @return Bytes queued (0 if the ring was full and they were dropped),
+ *         0 at end of file as read() returns it, -1 on error with errno
+ *         set (EAGAIN / EINTR are not errors: they return 0)
+ */
+ssize_t serial_ring_fill(serial_ring_t *r, int fd);
+
+/**
+ * Producer: queue up to n bytes from memory.
+ *
+ * @return Bytes queued (less than n if the ring is full)
+ */
+size_t serial_ring_push(serial_ring_t *r, const uint8_t *src, size_t n);
+
+/**
+ * Consumer: the oldest queued bytes that are contiguous in memory. Call
+ * serial_ring_consume() when done with them, then peek again for the
+ * part past the wrap.
+ *
+ * @return Bytes at *bytes (0 if the ring is empty)
+ */
+size_t serial_ring_peek(serial_ring_t *r, const uint8_t **bytes);
+
+/**
+ * Consumer: release n bytes returned by serial_ring_peek().
+ */
+void serial_ring_consume(serial_ring_t *r, size_t n);
+
+/* Bytes queued, as seen from either side */
+size_t serial_ring_count(const serial_ring_t *r);
+
+/* Bytes dropped because the ring was full, since creation */
+uint64_t serial_ring_dropped(const serial_ring_t *r);
+
+/**
+ * Empty the ring. Only while neither side is running.
+ */
+void serial_ring_reset(serial_ring_t *r);
+
+/**
+ * Destroy ring and free its memory.
+ */
+void serial_ring_destroy(serial_ring_t *r);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SERIAL_RING_H */
@@ -9,10 +9,11 @@ struct CWView: View {
             VStack(spacing: 0) {
                 // CW Waterfall (horizontal, monochrome, bandwidth-adapted)
                 CWWaterfallView(
-                    data: appState.waterfallData,
+                    history: appState.waterfall,
                     sampleRate: appState.audioEngine.effectiveSampleRate,
                     centerFreq: 700,
-                    displayBandwidth: 800
+                    displayBandwidth: 800,
+                    framesPerSecond: appState.decodeEffort.waterfallFPS
                 )
                 .frame(height: 100)
 
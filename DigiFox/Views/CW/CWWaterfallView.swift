@@ -2,53 +2,36 @@ import SwiftUI
 
 /// Horizontal CW waterfall: time flows left→right, frequency bottom→top.
 /// Monochrome (black/white). Zoomed to the audible CW bandwidth.
-/// Adaptive noise floor for clear signal visibility.
+/// The lines are drawn by `MetalWaterfall`; only the frequency scale is a
+/// Canvas, and it changes with the band, not with every line.
 struct CWWaterfallView: View {
-    let data: [[Float]]
+    let history: WaterfallHistory
     let sampleRate: Double
     var centerFreq: Double = 700
     var displayBandwidth: Double = 800
+    var framesPerSecond = 30
 
-    var body: some View {
-        Canvas { context, size in
-            context.fill(Path(CGRect(origin: .zero, size: size)), with: .color(.black))
-            guard !data.isEmpty, let bins = data.first?.count, bins > 0, sampleRate > 0 else { return }
-
-            let binHz = sampleRate / Double(bins * 2)
-            let loFreq = max(0, centerFreq - displayBandwidth / 2)
-            let hiFreq = min(sampleRate / 2, centerFreq + displayBandwidth / 2)
-            let loBin = max(0, Int(loFreq / binHz))
-            let hiBin = min(bins - 1, Int(hiFreq / binHz))
-            let numBins = hiBin - loBin + 1
-            guard numBins > 0 else { return }
-
-            // Fixed noise floor (adaptive was hiding signals)
-            let noiseFloor: Float = -60
-            let dynRange: Float = 60
-
-            let rows = data.count
-            let cellW = size.width / CGFloat(rows)
-            let cellH = size.height / CGFloat(numBins)
+    private var loFreq: Double { max(0, centerFreq - displayBandwidth / 2) }
+    private var hiFreq: Double { min(sampleRate / 2, centerFreq + displayBandwidth / 2) }
 
-            for col in 0..<rows {
-                let spectrum = data[col]
-                for bin in 0..<numBins {
-                    let srcBin = loBin + bin
-                    guard srcBin < spectrum.count else { continue }
-                    let val = spectrum[srcBin]
-                    let norm = max(0, min(1, (val - noiseFloor) / dynRange))
-                    let x = CGFloat(col) * cellW
-                    let y = size.height - CGFloat(bin + 1) * cellH
-                    let rect = CGRect(x: x, y: y, width: cellW + 1, height: cellH + 1)
-                    context.fill(Path(rect), with: .color(Color(white: Double(norm))))
-                }
+    var body: some View {
+        ZStack {
+            MetalWaterfall(history: history, display: display, framesPerSecond: framesPerSecond)
+            Canvas { context, size in
+                drawFreqScale(context: context, size: size, loFreq: loFreq, hiFreq: hiFreq)
             }
-
-            drawFreqScale(context: context, size: size, loFreq: loFreq, hiFreq: hiFreq)
         }
         .background(.black)
     }
 
+    private var display: WaterfallRenderer.Display {
+        let nyquist = sampleRate / 2.0
+        guard nyquist > 0, hiFreq > loFreq else { return WaterfallRenderer.Display(horizontal: true, mono: true) }
+        // Fixed noise floor (adaptive was hiding signals)
+        return WaterfallRenderer.Display(binRange: (loFreq / nyquist)...(hiFreq / nyquist),
+                                         floorDb: -60, rangeDb: 60, horizontal: true, mono: true)
+    }
+
     private func drawFreqScale(context: GraphicsContext, size: CGSize, loFreq: Double, hiFreq: Double) {
         let range = hiFreq - loFreq
         guard range > 0 else { return }
@@ -16,7 +16,7 @@ struct BandActivityView: View {
             .padding(.vertical, 4)
 
             List {
-                ForEach(appState.stations.sorted { $0.lastHeard > $1.lastHeard }) { station in
+                ForEach(appState.stations) { station in
                     HStack {
                         Text(station.callsign)
                             .font(.system(.subheadline, design: .monospaced))
@@ -5,13 +5,13 @@ struct FT8MessageListView: View {
 
     var body: some View {
         List {
-            if appState.rxMessages.isEmpty {
+            if appState.ft8Messages.isEmpty {
                 Text("Keine Nachrichten empfangen")
                     .foregroundStyle(.secondary)
                     .frame(maxWidth: .infinity, alignment: .center)
                     .listRowBackground(Color.clear)
             } else {
-                ForEach(appState.rxMessages.filter { $0.mode == .ft8 }) { msg in
+                ForEach(appState.ft8Messages) { msg in
                     HStack(spacing: 0) {
                         Text(msg.timestamp, format: .dateTime.hour().minute().second())
                             .font(.system(.caption2, design: .monospaced))
@@ -5,13 +5,13 @@ struct JS8MessageListView: View {
 
     var body: some View {
         List {
-            if appState.rxMessages.isEmpty {
+            if appState.js8Messages.isEmpty {
                 Text("Keine Nachrichten empfangen")
                     .foregroundStyle(.secondary)
                     .frame(maxWidth: .infinity, alignment: .center)
                     .listRowBackground(Color.clear)
             } else {
-                ForEach(appState.rxMessages.filter { $0.mode == .js8 }) { msg in
+                ForEach(appState.js8Messages) { msg in
                     VStack(alignment: .leading, spacing: 4) {
                         HStack {
                             Text(msg.timestamp, style: .time).font(.caption2).foregroundStyle(.secondary)
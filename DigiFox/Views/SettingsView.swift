@@ -123,6 +123,7 @@ struct SettingsView: View {
                             Text("Baud rate auto-set to 115200 for CAT_STREAMING")
                                 .font(.caption).foregroundStyle(.secondary)
                         }
+                        Toggle("TX via FA commands (FSK)", isOn: $settings.trusdxCATFSK)
                     }
                 }
 
@@ -141,6 +142,24 @@ struct SettingsView: View {
                             .multilineTextAlignment(.trailing).keyboardType(.numberPad)
                     }
                     .disabled(settings.radioProfile == .trusdx)
+                    Picker("Poll Interval", selection: $settings.rigPollInterval) {
+                        Text("0.25 s").tag(0.25)
+                        Text("0.5 s").tag(0.5)
+                        Text("1 s").tag(1.0)
+                        Text("2 s").tag(2.0)
+                    }
+                    .disabled(settings.radioProfile == .trusdx)
+                }
+
+                Section {
+                    Toggle("Key via audio tone", isOn: $settings.cwAudioKeying)
+                    if settings.cwAudioKeying {
+                        Stepper("Pitch \(Int(settings.cwTonePitch)) Hz", value: $settings.cwTonePitch, in: 400...1000, step: 50)
+                    }
+                } header: {
+                    Text("CW TX")
+                } footer: {
+                    Text("Sends CW as a keyed tone in SSB with PTT held for the message. The audio clock times every element.")
                 }
 
                 Section {
@@ -205,8 +224,33 @@ struct SettingsView: View {
                     Text("Frequenz wird automatisch für FT8/JS8Call gesetzt und per CAT an das Radio gesendet.")
                 }
 
-                Section("Audio") {
+                Section {
+                    Picker("Effort", selection: $settings.decodeEffortRaw) {
+                        ForEach(DecodeEffort.allCases) { e in Text(e.name).tag(e.rawValue) }
+                    }
+                    Toggle("Ease off when hot or on low power", isOn: $settings.adaptiveEffort)
+                    if let note = appState.effortNote {
+                        HStack {
+                            Text("Now"); Spacer()
+                            Text("\(appState.decodeEffort.name) (\(note))").foregroundStyle(.secondary)
+                        }
+                    }
+                } header: {
+                    Text("Decoding")
+                } footer: {
+                    Text("Lower effort tries fewer FT8 candidates and passes, searches CW speeds more coarsely and redraws the waterfall less often, for less heat and battery drain.")
+                }
+
+                Section {
                     HStack { Text("TX Leistung"); Slider(value: $settings.txPower, in: 0...1) }
+                    Toggle("Record RX audio", isOn: Binding(
+                        get: { appState.isRecording },
+                        set: { $0 ? appState.startRecording() : appState.stopRecording() }
+                    ))
+                } header: {
+                    Text("Audio")
+                } footer: {
+                    Text("Recordings go to Documents/Recordings and can be replayed through the decoders with the benches' -A option.")
                 }
 
                 Section("Info") {
@@ -226,7 +270,7 @@ struct SettingsView: View {
             .navigationTitle("Settings")
             .task {
                 if rigModels.isEmpty {
-                    let models = await Task.detached { HamlibRig.listModels() }.value
+                    let models = await Task.detached { HamlibModelIndex.models() }.value
                     rigModels = models
                 }
             }
@@ -0,0 +1,70 @@
+/**
+ * Waterfall.metal — Scrolling waterfall from a ring texture (WaterfallRenderer.swift)
+ *
+ * Each texture row is one waterfall line of dB codes (unorm bytes, see
+ * WaterfallHistory), written once into the ring slot after the newest. Scrolling is only a change of `head`: the
+ * fragment shader turns its position into a line age, the age into a
+ * ring slot, and maps the dB value through the colormap itself.
+ */
+
+#include <metal_stdlib>
+using namespace metal;
+
+/* As WaterfallRenderer.Uniforms in WaterfallRenderer.swift */
+struct waterfall_uniforms {
+    float u0;          /* Displayed bins: [u0, u1) of the line, 0-1 */
+    float u1;
+    float floor_db;    /* Black below */
+    float range_db;    /* Full scale above floor_db */
+    float code_floor_db;   /* dB of texel 0.0 */
+    float code_span_db;    /* dB from texel 0.0 to 1.0 */
+    int   head;        /* Ring slot of the newest line */
+    int   rows;        /* Ring slots */
+    int   filled;      /* Lines written so far, up to rows */
+    int   horizontal;  /* Time left → right, frequency bottom → top */
+    int   mono;        /* Grey scale instead of the colour map */
+};
+
+struct waterfall_vertex_out {
+    float4 position [[position]];
+    float2 uv;         /* 0-1, origin top left */
+};
+
+vertex waterfall_vertex_out waterfall_vertex(uint vid [[vertex_id]])
+{
+    /* Full-view quad as a triangle strip */
+    const float2 uv = float2(float(vid & 1), float(vid >> 1));
+    waterfall_vertex_out out;
+    out.position = float4(uv.x * 2.0 - 1.0, 1.0 - uv.y * 2.0, 0.0, 1.0);
+    out.uv = uv;
+    return out;
+}
+
+/* Black → blue → cyan → yellow → red, as the Canvas waterfall had it */
+static float3 colormap(float v)
+{
+    if (v < 0.25) return float3(0.0, 0.0, v * 4.0);
+    if (v < 0.5)  return float3(0.0, (v - 0.25) * 4.0, 1.0);
+    if (v < 0.75) return float3((v - 0.5) * 4.0, 1.0, 1.0 - (v - 0.5) * 4.0);
+    return float3(1.0, 1.0 - (v - 0.75) * 4.0, 0.0);
+}
+
+fragment float4 waterfall_fragment(waterfall_vertex_out in               [[stage_in]],
+                                   texture2d<float, access::read> lines  [[texture(0)]],
+                                   constant waterfall_uniforms &u        [[buffer(0)]])
+{
+    /* Newest line at the top, or at the right edge */
+    const float age_frac = u.horizontal ? 1.0 - in.uv.x : in.uv.y;
+    const float freq_frac = u.horizontal ? 1.0 - in.uv.y : in.uv.x;
+
+    const int age = min(int(age_frac * float(u.rows)), u.rows - 1);
+    if (age >= u.filled) return float4(0.0, 0.0, 0.0, 1.0);
+    const int slot = (u.head - age + u.rows) % u.rows;
+
+    const int width = int(lines.get_width());
+    const int bin = clamp(int(mix(u.u0, u.u1, freq_frac) * float(width)), 0, width - 1);
+    const float db = u.code_floor_db + lines.read(uint2(bin, slot)).r * u.code_span_db;
+    const float v = saturate((db - u.floor_db) / u.range_db);
+
+    return float4(u.mono ? float3(v) : colormap(v), 1.0);
+}
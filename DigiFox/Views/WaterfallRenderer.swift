@@ -0,0 +1,231 @@
+import SwiftUI
+import MetalKit
+
+/// Recent waterfall lines in a fixed ring (`line_ring.h`), written from
+/// the audio thread as `SpectrumEngine` completes them and read by the
+/// renderers at draw time. Nothing is published to SwiftUI per line, and
+/// neither side ever waits for the other. Only ever displayed, so a bin
+/// is kept as a byte: dB in `codeStepDb` steps from `codeFloorDb`.
+final class WaterfallHistory {
+
+    /// Lines kept (200 × 0.16 s = 32 s).
+    let capacity: Int
+
+    /// dB of code 0, and per code step (255 → +27.5 dB)
+    static let codeFloorDb: Float = -100
+    static let codeStepDb: Float = 0.5
+
+    private let ring: OpaquePointer
+
+    /// Lines wider than `maxBins` are dropped.
+    init(capacity: Int = 200, maxBins: Int = 2048) {
+        self.capacity = capacity
+        ring = line_ring_create(Int32(capacity), Int32(maxBins))!
+    }
+
+    deinit {
+        line_ring_destroy(ring)
+    }
+
+    /// Append one line (dB per bin, plus `gainDb`). A line of another
+    /// width starts over. Producer (audio thread) only.
+    func push(_ line: UnsafeBufferPointer<Float>, gainDb: Float = 0) {
+        guard !line.isEmpty, let row = line_ring_begin(ring, Int32(line.count)) else { return }
+        let scale = 1 / Self.codeStepDb
+        let floor = Self.codeFloorDb - gainDb
+        for (i, db) in line.enumerated() {
+            // Written so that NaN / -inf (silence) land on 0
+            let c = ((db - floor) * scale).rounded()
+            row[i] = c >= 255 ? 255 : (c > 0 ? UInt8(c) : 0)
+        }
+        line_ring_commit(ring)
+    }
+
+    /// Forget every line, e.g. when the input changes. From the producer,
+    /// or while it is idle.
+    func clear() {
+        line_ring_clear(ring)
+    }
+
+    /// The ring as a reader last saw it.
+    struct Cursor {
+        var start = UInt64.max      // First line of the layout seen
+        var bins = 0
+        var written: UInt64 = 0
+    }
+
+    /// Hand `body` each line written since `cursor` (at most a ring's worth)
+    /// with its slot, and advance the cursor. After a width change or a
+    /// clear, `reset` is called first with the new width. If the writer
+    /// overtook the lines being read, the cursor stays put and the next
+    /// call hands them over again, as they are by then.
+    func read(since cursor: inout Cursor, reset: (_ bins: Int) -> Void,
+              _ body: (_ slot: Int, _ line: UnsafeBufferPointer<UInt8>) -> Void) {
+        var view = line_ring_view_t()
+        line_ring_view(ring, &view)
+        let bins = Int(view.bins)
+
+        if cursor.start != view.start || cursor.bins != bins {
+            cursor = Cursor(start: view.start, bins: bins, written: view.start)
+            reset(bins)
+        }
+        guard bins > 0, view.written > cursor.written else { return }
+
+        let cap = UInt64(capacity)
+        let first = max(cursor.written, view.written > cap ? view.written - cap : 0)
+        for n in first..<view.written {
+            body(Int(n % cap), UnsafeBufferPointer(start: line_ring_row(ring, n), count: bins))
+        }
+        if line_ring_intact(ring, &view, first) != 0 {
+            cursor.written = view.written
+        }
+    }
+}
+
+/// Draws a `WaterfallHistory` with Metal: each new line is written once
+/// into its row of a ring texture, and the fragment shader
+/// (`Waterfall.metal`) scrolls by offsetting rows and applies the colour
+/// map. A frame costs the same however long the history is, and nothing
+/// runs on the main thread between frames but the draw call.
+final class WaterfallRenderer: NSObject, MTKViewDelegate {
+
+    /// What the view shows of the lines.
+    struct Display: Equatable {
+        var binRange: ClosedRange<Double> = 0...1   // Fractions of a line
+        var floorDb: Float = -60
+        var rangeDb: Float = 60
+        var horizontal = false                       // CW: time left → right
+        var mono = false
+    }
+
+    /// As waterfall_uniforms in Waterfall.metal.
+    private struct Uniforms {
+        var u0: Float, u1: Float
+        var floorDb: Float, rangeDb: Float
+        var codeFloorDb: Float, codeSpanDb: Float
+        var head: Int32, rows: Int32, filled: Int32
+        var horizontal: Int32, mono: Int32
+    }
+
+    let device: MTLDevice?
+    var display = Display() { didSet { if display != oldValue { dirty = true } } }
+
+    private let history: WaterfallHistory
+    private let queue: MTLCommandQueue?
+    private let pipeline: MTLRenderPipelineState?
+    private var texture: MTLTexture?
+    private var cursor = WaterfallHistory.Cursor()
+    private var head = 0
+    private var filled = 0
+    private var dirty = true
+    /// Taken while a frame's commands may still read the texture
+    private let gpuIdle = DispatchSemaphore(value: 1)
+
+    init(history: WaterfallHistory) {
+        self.history = history
+        let device = MTLCreateSystemDefaultDevice()
+        self.device = device
+        self.queue = device?.makeCommandQueue()
+
+        var pipeline: MTLRenderPipelineState?
+        if let device, let library = device.makeDefaultLibrary() {
+            let desc = MTLRenderPipelineDescriptor()
+            desc.vertexFunction = library.makeFunction(name: "waterfall_vertex")
+            desc.fragmentFunction = library.makeFunction(name: "waterfall_fragment")
+            desc.colorAttachments[0].pixelFormat = .bgra8Unorm
+            pipeline = try? device.makeRenderPipelineState(descriptor: desc)
+        }
+        self.pipeline = pipeline
+        super.init()
+    }
+
+    /// Upload the lines written since the last frame into their texture rows.
+    private func upload() {
+        guard let device else { return }
+        let rows = history.capacity
+
+        history.read(since: &cursor, reset: { bins in
+            texture = nil
+            dirty = true
+            guard bins > 0 else { return }
+            let desc = MTLTextureDescriptor.texture2DDescriptor(pixelFormat: .r8Unorm, width: bins,
+                                                                height: rows, mipmapped: false)
+            desc.usage = .shaderRead
+            desc.storageMode = .shared
+            texture = device.makeTexture(descriptor: desc)
+        }) { slot, line in
+            texture?.replace(region: MTLRegionMake2D(0, slot, line.count, 1), mipmapLevel: 0,
+                             withBytes: line.baseAddress!, bytesPerRow: line.count)
+            dirty = true
+        }
+        // From the cursor, so lines handed over again are not counted twice
+        let lines = Int(min(cursor.written - cursor.start, UInt64(rows)))
+        filled = lines
+        head = lines > 0 ? Int((cursor.written - 1) % UInt64(rows)) : 0
+    }
+
+    func mtkView(_ view: MTKView, drawableSizeWillChange size: CGSize) {
+        dirty = true
+    }
+
+    func draw(in view: MTKView) {
+        // While the last frame may still be reading the texture, skip this
+        // one rather than wait: the new lines stay in the history until then
+        guard gpuIdle.wait(timeout: .now()) == .success else { return }
+        upload()
+        guard dirty, let pipeline, let queue,
+              let pass = view.currentRenderPassDescriptor, let drawable = view.currentDrawable,
+              let cmd = queue.makeCommandBuffer(),
+              let enc = cmd.makeRenderCommandEncoder(descriptor: pass) else {
+            gpuIdle.signal()
+            return
+        }
+
+        if let texture {
+            var u = Uniforms(u0: Float(display.binRange.lowerBound), u1: Float(display.binRange.upperBound),
+                             floorDb: display.floorDb, rangeDb: max(display.rangeDb, 1),
+                             codeFloorDb: WaterfallHistory.codeFloorDb,
+                             codeSpanDb: 255 * WaterfallHistory.codeStepDb,
+                             head: Int32(head), rows: Int32(history.capacity), filled: Int32(filled),
+                             horizontal: display.horizontal ? 1 : 0, mono: display.mono ? 1 : 0)
+            enc.setRenderPipelineState(pipeline)
+            enc.setFragmentTexture(texture, index: 0)
+            enc.setFragmentBytes(&u, length: MemoryLayout<Uniforms>.stride, index: 0)
+            enc.drawPrimitives(type: .triangleStrip, vertexStart: 0, vertexCount: 4)
+        }
+        enc.endEncoding()
+        cmd.present(drawable)
+        cmd.addCompletedHandler { [gpuIdle] _ in gpuIdle.signal() }
+        cmd.commit()
+        dirty = false
+    }
+}
+
+/// SwiftUI host of a `WaterfallRenderer`. Redraws at most `framesPerSecond`
+/// times a second, and only when a line arrived or the display changed.
+struct MetalWaterfall: UIViewRepresentable {
+    let history: WaterfallHistory
+    var display = WaterfallRenderer.Display()
+    var framesPerSecond = 30
+
+    func makeCoordinator() -> WaterfallRenderer {
+        WaterfallRenderer(history: history)
+    }
+
+    func makeUIView(context: Context) -> MTKView {
+        let view = MTKView(frame: .zero, device: context.coordinator.device)
+        view.colorPixelFormat = .bgra8Unorm
+        view.clearColor = MTLClearColor(red: 0, green: 0, blue: 0, alpha: 1)
+        view.framebufferOnly = true
+        view.preferredFramesPerSecond = framesPerSecond
+        view.backgroundColor = .black
+        view.delegate = context.coordinator
+        context.coordinator.display = display
+        return view
+    }
+
+    func updateUIView(_ view: MTKView, context: Context) {
+        view.preferredFramesPerSecond = framesPerSecond
+        context.coordinator.display = display
+    }
+}
@@ -0,0 +1,232 @@
+import XCTest
+@testable import DigiFox
+
+/// Decode yield and speed of every decoder over a fixed synthetic corpus.
+///
+/// The audio is built from fixed seeds, so each test decodes the same
+/// bits every run: the yield assertions catch sensitivity regressions,
+/// and the `measure` blocks report CPU time, peak memory and wall clock.
+/// Like the rest of DigiFoxTests, this has no target in
+/// `generate_project.py` yet, so nothing builds or runs it; the gate
+/// that does run, with allocation sites and recorded corpora, is
+/// `Codec/regress` (`make check`).
+final class DecoderBenchmarkTests: XCTestCase {
+
+    /// Fewest decodes each corpus must give; raise when a change improves them.
+    private enum Baseline {
+        static let ft8Messages = 9          // of 10 per slot
+        static let cwCharactersRight = 0.95 // of the reference
+    }
+
+    private static let sampleRate = 12000
+    private static let cwText = "CQ CQ DE DL1ABC DL1ABC K DL1ABC DE W1AW GM UR RST 599 599 NAME JOHN QTH BOSTON HW CPY 73"
+
+    private var metrics: [XCTMetric] { [XCTCPUMetric(), XCTMemoryMetric(), XCTClockMetric()] }
+
+    // MARK: - FT8
+
+    func testFT8SlotYieldAndThroughput() {
+        let slot = Self.ft8Slot(signals: 10, snr: -14, seed: 1)
+        let demod = FT8Demodulator()
+        demod.decodeThreads = 1             // Deterministic yield
+
+        let found = demod.demodulate(slot).count
+        XCTAssertGreaterThanOrEqual(found, Baseline.ft8Messages, "FT8 yield regressed")
+
+        measure(metrics: metrics) {
+            _ = demod.demodulate(slot)
+        }
+    }
+
+    func testFT8StreamedSlotMatchesWhole() {
+        let slot = Self.ft8Slot(signals: 10, snr: -14, seed: 2)
+        let demod = FT8Demodulator()
+        demod.decodeThreads = 1
+        let whole = Set(demod.demodulate(slot).map { Int($0.frequency.rounded()) })
+
+        // The live path: the audio thread fills the ring, the decoder is
+        // pumped about once a second and decodes at the slot's end
+        guard let ring = SampleRing(history: slot.count + Self.sampleRate) else {
+            return XCTFail("No ring")
+        }
+        demod.start(ring: ring, spectrum: nil, at: Date(timeIntervalSince1970: 0))
+        slot.withUnsafeBufferPointer { buf in
+            for start in stride(from: 0, to: buf.count, by: 1200) {
+                ring.write(buf.baseAddress! + start, count: min(1200, buf.count - start))
+                if (start / 1200) % 10 == 9 { demod.pump() }
+            }
+        }
+        let streamed = Set(demod.decodeSlot().map { Int($0.frequency.rounded()) })
+        XCTAssertEqual(streamed, whole, "Streaming should decode what the whole buffer does")
+    }
+
+    // MARK: - CW
+
+    func testCWDecoderYieldAndThroughput() {
+        let audio = Self.cwAudio(wpm: 20, snr: 6, seed: 3)
+        let decode = { () -> String in
+            let decoder = CWDecoder(sampleRate: Self.sampleRate, centerFreq: 700)
+            var text = ""
+            for start in stride(from: 0, to: audio.count, by: 512) {
+                text += decoder.process(samples: Array(audio[start..<min(start + 512, audio.count)]))
+            }
+            return text + decoder.finalize()
+        }
+
+        XCTAssertGreaterThanOrEqual(Self.charactersRight(decode()), Baseline.cwCharactersRight,
+                                    "CW yield regressed")
+        measure(metrics: metrics) {
+            _ = decode()
+        }
+    }
+
+    func testGGMorseYieldAndThroughput() {
+        let audio = Self.cwAudio(wpm: 20, snr: 6, seed: 4)
+        let decode = { () -> String in
+            let decoder = GGMorseDecoder(sampleRate: Float(Self.sampleRate))
+            var text = ""
+            audio.withUnsafeBufferPointer { buf in
+                for start in stride(from: 0, to: buf.count, by: 512) {
+                    let n = min(512, buf.count - start)
+                    text += decoder.process(samples: UnsafeBufferPointer(rebasing: buf[start..<start + n]))
+                }
+            }
+            return text
+        }
+
+        XCTAssertGreaterThanOrEqual(Self.charactersRight(decode()), Baseline.cwCharactersRight,
+                                    "ggmorse yield regressed")
+        measure(metrics: metrics) {
+            _ = decode()
+        }
+    }
+
+    // MARK: - Steady state
+
+    /// Once warmed up (a second of audio, or FT8's first slot), feeding
+    /// and decoding must not touch the heap: it runs on the audio thread.
+    func testDecodersDoNotAllocateInSteadyState() throws {
+        guard alloc_tracker_install() == 0 else { throw XCTSkip("Allocation hooks need a DEBUG build") }
+
+        let cw = Self.cwAudio(wpm: 20, snr: 6, seed: 5)
+        let gm = ggmorse_wrapper_create(Float(Self.sampleRate), 0)
+        defer { ggmorse_wrapper_destroy(gm) }
+        var text = [CChar](repeating: 0, count: 256)
+        let ggmorseAllocs = cw.withUnsafeBufferPointer { audio in
+            text.withUnsafeMutableBufferPointer { out in
+                Self.steadyAllocs(blocks: Array(stride(from: 0, to: audio.count - 512, by: 512)),
+                                  warmUp: Self.sampleRate / 512) { start in
+                    _ = ggmorse_wrapper_process_push(gm, audio.baseAddress! + start, 512,
+                                                     out.baseAddress, Int32(out.count))
+                }
+            }
+        }
+        XCTAssertEqual(ggmorseAllocs, 0, "ggmorse allocated in steady state")
+
+        var cfg = ft8_config_t()
+        ft8_config_init(&cfg)
+        cfg.threads = 1
+        let ft8 = ft8_decoder_create(&cfg)
+        defer { ft8_decoder_destroy(ft8) }
+        let slot = Self.ft8Slot(signals: 10, snr: -14, seed: 6)
+        var results = [ft8_result_t](repeating: ft8_result_t(), count: 64)
+        let ft8Allocs = slot.withUnsafeBufferPointer { audio in
+            results.withUnsafeMutableBufferPointer { res in
+                Self.steadyAllocs(blocks: Array(0..<2), warmUp: 1) { _ in
+                    ft8_decoder_reset(ft8)
+                    for start in stride(from: 0, to: audio.count, by: 1200) {
+                        _ = ft8_decoder_feed(ft8, audio.baseAddress! + start, Int32(min(1200, audio.count - start)))
+                    }
+                    _ = ft8_decoder_decode_fed(ft8, res.baseAddress, Int32(res.count))
+                }
+            }
+        }
+        XCTAssertEqual(ft8Allocs, 0, "FT8 allocated in steady state")
+    }
+
+    /// Allocations `body` makes for the blocks after the first `warmUp`.
+    private static func steadyAllocs(blocks: [Int], warmUp: Int, _ body: (Int) -> Void) -> Int {
+        for block in blocks.prefix(warmUp) { body(block) }
+        let stage: StaticString = "steady"
+        let previous = alloc_tracker_stage(UnsafeRawPointer(stage.utf8Start).assumingMemoryBound(to: CChar.self))
+        let before = alloc_tracker_thread_allocs()
+        for block in blocks.dropFirst(warmUp) { body(block) }
+        let allocs = alloc_tracker_thread_allocs() - before
+        _ = alloc_tracker_stage(previous)
+        return allocs
+    }
+
+    // MARK: - Corpus
+
+    /// SplitMix64: the same stream on every platform.
+    private struct Random {
+        var state: UInt64
+        mutating func next() -> UInt64 {
+            state &+= 0x9E37_79B9_7F4A_7C15
+            var z = state
+            z = (z ^ (z >> 30)) &* 0xBF58_476D_1CE4_E5B9
+            z = (z ^ (z >> 27)) &* 0x94D0_49BB_1331_11EB
+            return z ^ (z >> 31)
+        }
+        mutating func uniform() -> Double { (Double(next() >> 11) + 0.5) / 9_007_199_254_740_992.0 }
+        mutating func gauss() -> Double { sqrt(-2 * log(uniform())) * cos(2 * .pi * uniform()) }
+    }
+
+    /// White noise for a signal of `power` at `snr` dB in 2500 Hz.
+    private static func addNoise(_ x: inout [Float], power: Double, snr: Double, rng: inout Random) {
+        let n0 = power / pow(10, snr / 10) / 2500
+        let sigma = sqrt(n0 * Double(sampleRate) / 2)
+        for i in x.indices { x[i] += Float(sigma * rng.gauss()) }
+    }
+
+    /// One 15 s slot: random payloads spread over the band, each up to
+    /// 10 dB above `snr`, starting 0.5 – 2 s in.
+    private static func ft8Slot(signals: Int, snr: Double, seed: UInt64) -> [Float] {
+        var rng = Random(state: seed)
+        var slot = [Float](repeating: 0, count: 15 * sampleRate)
+        addNoise(&slot, power: 0.125, snr: snr, rng: &rng)
+
+        let modulator = FT8Modulator()
+        for k in 0..<signals {
+            let payload = (0..<77).map { _ in UInt8(rng.next() & 1) }
+            modulator.baseFrequency = 300 + 2400 / Double(signals) * Double(k) + rng.uniform() * 6.25
+            modulator.amplitude = 0.5 * pow(10, 10 * Double(k) / Double(signals) / 20)
+            let start = Int((0.5 + rng.uniform() * 1.5) * Double(sampleRate))
+            for (i, v) in modulator.modulatePayload(payload).enumerated() where start + i < slot.count {
+                slot[start + i] += v
+            }
+        }
+        return slot
+    }
+
+    /// cwText keyed at 700 Hz with shaped edges, half a second of quiet
+    /// either side.
+    private static func cwAudio(wpm: Int, snr: Double, seed: UInt64) -> [Float] {
+        guard let tone = CWToneSource(text: cwText, wpm: wpm, pitch: 700, amplitude: 0.5,
+                                      sampleRate: Double(sampleRate)) else { return [] }
+        let lead = sampleRate / 2
+        var audio = [Float](repeating: 0, count: tone.remaining + 2 * lead)
+        audio.withUnsafeMutableBufferPointer { buf in
+            _ = tone.render(into: UnsafeMutableBufferPointer(rebasing: buf[lead...]))
+        }
+        var rng = Random(state: seed)
+        addNoise(&audio, power: 0.125, snr: snr, rng: &rng)
+        return audio
+    }
+
+    /// Share of cwText right: 1 - edit distance / length, case and
+    /// spacing ignored.
+    private static func charactersRight(_ decoded: String) -> Double {
+        let norm = { (s: String) in Array(s.uppercased().split(whereSeparator: \.isWhitespace).joined(separator: " ")) }
+        let ref = norm(cwText), hyp = norm(decoded)
+        var prev = Array(0...hyp.count)
+        for i in 1...ref.count {
+            var cur = [i] + [Int](repeating: 0, count: hyp.count)
+            for j in stride(from: 1, through: hyp.count, by: 1) {
+                cur[j] = min(prev[j - 1] + (ref[i - 1] == hyp[j - 1] ? 0 : 1), prev[j] + 1, cur[j - 1] + 1)
+            }
+            prev = cur
+        }
+        return 1 - Double(prev[hyp.count]) / Double(ref.count)
+    }
+}
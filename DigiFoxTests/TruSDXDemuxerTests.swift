@@ -308,41 +308,65 @@ final class TruSDXDemuxerTests: XCTestCase {
 
     // MARK: - Resampling
 
-    func testUpsampleRatio() {
-        let input: [Float] = [0.0, 0.5, -0.5, 1.0]
-        let output = TruSDXSerialAudio.upsample(input, from: 7812.5, to: 48000)
-        let expectedCount = Int(Double(input.count) * (48000.0 / 7812.5))
-        XCTAssertEqual(output.count, expectedCount)
+    /// Outputs lag the input by the filter's half length
+    private func expectedCount(_ n: Int, _ r: StreamingResampler) -> Double {
+        Double(n - Int(POLYPHASE_HALF_TAPS)) / r.step
     }
 
-    func testDownsampleRatio() {
-        let input = [Float](repeating: 0.5, count: 48000)
-        let output = TruSDXSerialAudio.downsample(input, from: 48000, to: 7812.5)
-        let expectedCount = Int(48000.0 / (48000.0 / 7812.5))
-        XCTAssertEqual(output.count, expectedCount)
+    func testUpsampleRatio() throws {
+        let r = try XCTUnwrap(StreamingResampler(from: TruSDXSerialAudio.rxSampleRate, to: 12000))
+        let output = r.process([Float](repeating: 0.5, count: 7825))
+        XCTAssertEqual(Double(output.count), expectedCount(7825, r), accuracy: 1)
     }
 
-    func testUpsamplePreservesConstant() {
-        let input: [Float] = [Float](repeating: 0.75, count: 100)
-        let output = TruSDXSerialAudio.upsample(input, from: 7812.5, to: 48000)
-        for sample in output {
+    func testDownsampleRatio() throws {
+        let r = try XCTUnwrap(StreamingResampler(from: 12000, to: TruSDXSerialAudio.txSampleRate))
+        let output = r.process([Float](repeating: 0.5, count: 12000))
+        XCTAssertEqual(Double(output.count), expectedCount(12000, r), accuracy: 1)
+    }
+
+    func testUpsamplePreservesConstant() throws {
+        let r = try XCTUnwrap(StreamingResampler(from: TruSDXSerialAudio.rxSampleRate, to: 12000))
+        let output = r.process([Float](repeating: 0.75, count: 1000))
+        // Past the first filter length, which still sees the silence before the stream
+        for sample in output.dropFirst(64) {
             XCTAssertEqual(sample, 0.75, accuracy: 0.01)
         }
     }
 
-    func testDownsamplePreservesConstant() {
-        let input = [Float](repeating: -0.25, count: 4800)
-        let output = TruSDXSerialAudio.downsample(input, from: 48000, to: 7812.5)
-        for sample in output {
+    func testDownsamplePreservesConstant() throws {
+        let r = try XCTUnwrap(StreamingResampler(from: 12000, to: TruSDXSerialAudio.txSampleRate))
+        let output = r.process([Float](repeating: -0.25, count: 4800))
+        for sample in output.dropFirst(64) {
             XCTAssertEqual(sample, -0.25, accuracy: 0.01)
         }
     }
 
-    func testEmptyResample() {
-        let up = TruSDXSerialAudio.upsample([], from: 7812.5, to: 48000)
-        let down = TruSDXSerialAudio.downsample([], from: 48000, to: 7812.5)
-        XCTAssertTrue(up.isEmpty)
-        XCTAssertTrue(down.isEmpty)
+    func testEmptyResample() throws {
+        let up = try XCTUnwrap(StreamingResampler(from: TruSDXSerialAudio.rxSampleRate, to: 12000))
+        let down = try XCTUnwrap(StreamingResampler(from: 12000, to: TruSDXSerialAudio.txSampleRate))
+        XCTAssertTrue(up.process([]).isEmpty)
+        XCTAssertTrue(down.process([]).isEmpty)
+    }
+
+    /// History and phase carry over: uneven blocks give exactly the whole-signal output
+    func testBlocksMatchWhole() throws {
+        let input = (0..<7825).map { Float(sin(Double($0) * 0.37) * 0.8) }
+        let whole = try XCTUnwrap(StreamingResampler(from: TruSDXSerialAudio.rxSampleRate, to: 12000))
+        let blocks = try XCTUnwrap(StreamingResampler(from: TruSDXSerialAudio.rxSampleRate, to: 12000))
+
+        let expected = whole.process(input)
+        var output = [Float]()
+        let sizes = [1, 7, 64, 313, 1000, 17]
+        var start = 0
+        var i = 0
+        while start < input.count {
+            let end = min(start + sizes[i % sizes.count], input.count)
+            input[start..<end].withUnsafeBufferPointer { blocks.process($0, into: &output) }
+            start = end
+            i += 1
+        }
+        XCTAssertEqual(output, expected)
     }
 
     // MARK: - Realistic Firmware Stream Simulation
@@ -416,6 +440,25 @@ final class TruSDXDemuxerTests: XCTestCase {
         XCTAssertEqual(r3.audioSamples.count, 15)
     }
 
+    // MARK: - Raw Byte Runs
+
+    /// processBytes hands out the audio bytes unconverted, all of a
+    /// chunk's audio in one call even when CAT splits it, and the same CAT
+    /// responses as process
+    func testProcessBytesRuns() {
+        var runs = [[UInt8]]()
+        let chunk1 = Data([0x3B, UInt8(ascii: "U"), UInt8(ascii: "S"), 0x80, 0x81])
+        let chunk2 = Data([0x82, 0x3B] + Array("FA00007074000;".utf8)
+            + [UInt8(ascii: "U"), UInt8(ascii: "S"), 0x83, 0x3B])
+
+        let cat1 = demuxer.processBytes(chunk1) { runs.append(Array($0)) }
+        let cat2 = demuxer.processBytes(chunk2) { runs.append(Array($0)) }
+
+        XCTAssertTrue(cat1.isEmpty)
+        XCTAssertEqual(cat2, ["FA00007074000;"])
+        XCTAssertEqual(runs, [[0x80, 0x81], [0x82, 0x83]])
+    }
+
     // MARK: - RadioProfile
 
     func testTruSDXProfile() {
@@ -22,9 +22,13 @@ PROJECT_NAME = "DigiFox"
 BUNDLE_ID = "com.digifox.ios"
 TEAM_ID = ""  # set your team ID here or leave empty
 
+# Host-side tools next to the sources (own main(), not part of the app)
+EXCLUDED_DIRS = {"bench"}
+
 def scan_sources(root):
     swift, objc_m, objc_h, c_files, assets = [], [], [], [], []
-    for dirpath, _, filenames in os.walk(root):
+    for dirpath, dirs, filenames in os.walk(root):
+        dirs[:] = [d for d in dirs if d not in EXCLUDED_DIRS]
         for f in filenames:
             full = os.path.join(dirpath, f)
             rel = os.path.relpath(full, ".")